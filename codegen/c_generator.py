@@ -11,9 +11,11 @@ For each table, generates:
 - {Table}StatusSlot (for owner's per-device status)
 - {Table}OwnerTable (for OWNER role)
 - Serialization/deserialization functions
+- {table}_set_{section}_{field}() setters for dirty tracking
+- SdsAggregateMeta descriptors for tables with @source
 """
 
-from typing import TextIO, List
+from typing import TextIO, List, Optional
 from .parser import Schema, Table, Field, SectionType
 
 # Type mapping: SDS type -> C type
@@ -68,6 +70,17 @@ FIELD_TYPE_MAP = {
     'string': 'SDS_FIELD_STRING',
 }
 
+# @aggregate operation -> SdsAggregateOp enum mapping
+AGGREGATE_OP_MAP = {
+    'count': 'SDS_AGG_COUNT',
+    'count_online': 'SDS_AGG_COUNT_ONLINE',
+    'min': 'SDS_AGG_MIN',
+    'max': 'SDS_AGG_MAX',
+    'sum': 'SDS_AGG_SUM',
+    'mean': 'SDS_AGG_MEAN',
+    'percentile': 'SDS_AGG_PERCENTILE',
+}
+
 DEFAULT_STRING_SIZE = 32
 DEFAULT_MAX_NODES = 16
 
@@ -85,6 +98,28 @@ def _field_to_c(field: Field) -> str:
         return f"{c_type} {field.name}"
 
 
+def _slot_count_type(max_nodes: int) -> str:
+    """Smallest unsigned C type that can hold a status_count of max_nodes."""
+    if max_nodes <= 0xFF:
+        return 'uint8_t'
+    if max_nodes <= 0xFFFF:
+        return 'uint16_t'
+    return 'uint32_t'
+
+
+def _slot_index_size(max_nodes: int) -> int:
+    """Hash index buckets for max_nodes slots (power of two, load <= 3/4)."""
+    size = 2
+    while size * 3 < max_nodes * 4:
+        size *= 2
+    return size
+
+
+def _max_nodes_expr(table: Table, upper_name: str) -> str:
+    """C expression for the table's owner status slot count."""
+    return f"SDS_{upper_name}_MAX_NODES" if table.max_nodes else "SDS_GENERATED_MAX_NODES"
+
+
 def _to_upper_snake(name: str) -> str:
     """Convert CamelCase to UPPER_SNAKE_CASE."""
     result = []
@@ -124,6 +159,7 @@ def generate_header(schema: Schema, output: TextIO):
     output.write("#include <stdint.h>\n")
     output.write("#include <stdbool.h>\n")
     output.write("#include <stddef.h>\n")
+    output.write("#include <string.h>\n")
     output.write('#include "sds.h"\n')
     output.write('#include "sds_json.h"\n\n')
     
@@ -132,7 +168,7 @@ def generate_header(schema: Schema, output: TextIO):
     
     # Generate each table
     for name, table in schema.tables.items():
-        _generate_table(output, name, table)
+        _generate_table(output, name, table, schema)
     
     # Generate max section size macro (for shadow buffer sizing)
     _generate_max_section_size(output, schema)
@@ -143,7 +179,12 @@ def generate_header(schema: Schema, output: TextIO):
     output.write("#endif /* SDS_TYPES_H */\n")
 
 
-def _generate_table(output: TextIO, name: str, table: Table):
+def _aggregate_fields(table: Table) -> List[Field]:
+    """State and status fields computed by @aggregate, in section order."""
+    return [f for f in table.state_fields + table.status_fields if f.aggregate]
+
+
+def _generate_table(output: TextIO, name: str, table: Table, schema: Schema):
     """Generate structures and functions for a table."""
     upper_name = _to_upper_snake(name)
     lower_name = _to_lower_snake(name)
@@ -152,6 +193,9 @@ def _generate_table(output: TextIO, name: str, table: Table):
     output.write(f"#define SDS_{upper_name}_SYNC_INTERVAL_MS {table.sync_interval_ms}\n")
     output.write(f"#define SDS_{upper_name}_LIVENESS_INTERVAL_MS {table.liveness_interval_ms}\n")
     # Note: eviction_grace_ms is now configured globally in SdsConfig, not per-table
+    if table.max_nodes:
+        output.write(f"#define SDS_{upper_name}_MAX_NODES {table.max_nodes}\n")
+        output.write(f"#define SDS_{upper_name}_SLOT_INDEX_SIZE {_slot_index_size(table.max_nodes)}\n")
     output.write("\n")
     
     # Config struct
@@ -187,6 +231,14 @@ def _generate_table(output: TextIO, name: str, table: Table):
         output.write(f"    {name}State state;\n")
     if table.status_fields:
         output.write(f"    {name}Status status;\n")
+    if table.source:
+        source = schema.tables[table.source]
+        aggregates = _aggregate_fields(table)
+        slots = 0
+        if any(f.aggregate == 'percentile' for f in aggregates):
+            slots = _max_nodes_expr(source, _to_upper_snake(source.name))
+        output.write(f"    uint64_t aggregate_storage[SDS_AGGREGATE_BYTES({len(aggregates)}, {slots}) / 8];"
+                     f"  /* Aggregates of {source.name} */\n")
     output.write(f"}} {name}Table;\n\n")
     
     # Status Slot (for owner's per-device tracking)
@@ -199,6 +251,7 @@ def _generate_table(output: TextIO, name: str, table: Table):
         output.write(f"    bool eviction_pending;   /* true if awaiting grace period after LWT */\n")
         output.write(f"    uint32_t last_seen_ms;   /* Timestamp of last received status */\n")
         output.write(f"    uint32_t eviction_deadline; /* When to evict if device doesn't return */\n")
+        output.write(f"    uint32_t status_seq;     /* Sequence of the last applied status (delta sync) */\n")
         output.write(f"    {name}Status status;\n")
         output.write(f"}} {name}StatusSlot;\n\n")
     
@@ -210,18 +263,46 @@ def _generate_table(output: TextIO, name: str, table: Table):
     if table.state_fields:
         output.write(f"    {name}State state;  /* Merged from all devices */\n")
     if table.status_fields:
-        output.write(f"    {name}StatusSlot status_slots[SDS_GENERATED_MAX_NODES];\n")
-        output.write(f"    uint8_t status_count;\n")
+        max_nodes = _max_nodes_expr(table, upper_name)
+        count_type = _slot_count_type(table.max_nodes or DEFAULT_MAX_NODES)
+        if table.slot_storage == 'external':
+            output.write(f"    {name}StatusSlot* status_slots;  /* Caller-allocated, {max_nodes} entries */\n")
+        else:
+            output.write(f"    {name}StatusSlot status_slots[{max_nodes}];\n")
+        output.write(f"    {count_type} status_count;\n")
+        if table.history:
+            output.write(f"    uint32_t status_history[SDS_STATUS_HISTORY_BYTES(sizeof({name}Status), "
+                         f"{max_nodes}, {table.history}) / 4];  /* {table.history} samples per device */\n")
     output.write(f"}} {name}OwnerTable;\n\n")
     
-    # Serialization functions
-    _generate_serialize_functions(output, name, table)
-    
-    # Deserialization functions
-    _generate_deserialize_functions(output, name, table)
+    # Serialization functions (schema tables are serialized by the core from SdsFieldMeta)
+    if table.serializer == 'callbacks':
+        _generate_serialize_functions(output, name, table)
+        _generate_deserialize_functions(output, name, table)
     
     # Field descriptors for delta sync
     _generate_field_descriptors(output, name, table)
+    
+    # Setters that mark fields for dirty tracking
+    _generate_field_setters(output, name, table)
+    
+    # Aggregate descriptors (summary tables)
+    if table.source:
+        _generate_aggregates(output, name, table)
+
+
+def _generate_aggregates(output: TextIO, name: str, table: Table):
+    """Generate the SdsAggregateMeta array of a table with @source."""
+    upper_name = _to_upper_snake(name)
+    aggregates = _aggregate_fields(table)
+    output.write(f"/* Aggregates computed from {table.source} status slots */\n")
+    output.write(f"static const SdsAggregateMeta SDS_{upper_name}_AGGREGATES[] = {{\n")
+    for field in aggregates:
+        source = f'"{field.aggregate_field}"' if field.aggregate_field else "NULL"
+        output.write(f'    {{ "{field.name}", {AGGREGATE_OP_MAP[field.aggregate]}, {source}, '
+                     f'{field.aggregate_percentile} }},\n')
+    output.write("};\n")
+    output.write(f"#define SDS_{upper_name}_AGGREGATE_COUNT {len(aggregates)}\n\n")
 
 
 def _generate_serialize_functions(output: TextIO, name: str, table: Table):
@@ -261,33 +342,106 @@ def _generate_deserialize_functions(output: TextIO, name: str, table: Table):
     if table.config_fields:
         output.write(f"static void {lower_name}_deserialize_config(void* section, SdsJsonReader* r) {{\n")
         output.write(f"    {name}Config* cfg = ({name}Config*)section;\n")
-        for field in table.config_fields:
-            _write_deserialize_field(output, field, 'cfg')
+        _write_member_dispatch(output, table.config_fields, 'cfg')
         output.write(f"}}\n\n")
     
     # State deserialize
     if table.state_fields:
         output.write(f"static void {lower_name}_deserialize_state(void* section, SdsJsonReader* r) {{\n")
         output.write(f"    {name}State* st = ({name}State*)section;\n")
-        for field in table.state_fields:
-            _write_deserialize_field(output, field, 'st')
+        _write_member_dispatch(output, table.state_fields, 'st')
         output.write(f"}}\n\n")
     
     # Status deserialize
     if table.status_fields:
         output.write(f"static void {lower_name}_deserialize_status(void* section, SdsJsonReader* r) {{\n")
         output.write(f"    {name}Status* st = ({name}Status*)section;\n")
-        for field in table.status_fields:
-            _write_deserialize_field(output, field, 'st')
+        _write_member_dispatch(output, table.status_fields, 'st')
         output.write(f"}}\n\n")
 
 
+def _key_dispatch_position(names: List[str]) -> Optional[int]:
+    """First character position that tells all same-length keys apart, if any."""
+    for pos in range(len(names[0])):
+        if len({n[pos] for n in names}) == len(names):
+            return pos
+    return None
+
+
+def _write_member_dispatch(output: TextIO, fields: List[Field], ptr_name: str):
+    """
+    Write a single pass over the payload's members.
+    
+    Each key is resolved at build time: a switch on its length, then on a
+    character position that is unique among the fields of that length, and
+    one memcmp to reject keys that are not fields (ts, node, ...).
+    """
+    by_length = {}
+    for field in fields:
+        by_length.setdefault(len(field.name), []).append(field)
+    
+    output.write("    SdsJsonIter it;\n")
+    output.write("    SdsJsonMember m;\n")
+    output.write("    sds_json_iter_init(&it, r);\n")
+    output.write("    while (sds_json_iter_next(&it, &m)) {\n")
+    output.write("        switch (m.key_len) {\n")
+    for length in sorted(by_length):
+        group = by_length[length]
+        output.write(f"        case {length}:\n")
+        pos = _key_dispatch_position([f.name for f in group]) if len(group) > 1 else None
+        if pos is None:
+            # One field, or no telling character: compare in turn
+            for i, field in enumerate(group):
+                keyword = "if" if i == 0 else "} else if"
+                output.write(f'            {keyword} (memcmp(m.key, "{field.name}", {length}) == 0) {{\n')
+                _write_parse_member(output, field, ptr_name, "                ")
+            output.write("            }\n")
+        else:
+            output.write(f"            switch (m.key[{pos}]) {{\n")
+            for field in group:
+                output.write(f"            case '{field.name[pos]}':\n")
+                output.write(f'                if (memcmp(m.key, "{field.name}", {length}) == 0) {{\n')
+                _write_parse_member(output, field, ptr_name, "                    ")
+                output.write("                }\n")
+                output.write("                break;\n")
+            output.write("            }\n")
+        output.write("            break;\n")
+    output.write("        }\n")
+    output.write("    }\n")
+
+
+def _write_parse_member(output: TextIO, field: Field, ptr_name: str, indent: str):
+    """Write code that parses m.value into one field."""
+    target = f"{ptr_name}->{field.name}"
+    if field.type == 'string':
+        size = field.array_size if field.array_size else DEFAULT_STRING_SIZE
+        output.write(f"{indent}sds_json_parse_string_in(r, m.value, {target}, {size});\n")
+    elif field.type == 'bool':
+        output.write(f"{indent}bool tmp;\n")
+        output.write(f"{indent}if (sds_json_parse_bool(m.value, &tmp)) {target} = tmp;\n")
+    elif field.type == 'float':
+        output.write(f"{indent}sds_json_parse_float(m.value, &{target});\n")
+    elif field.type == 'uint8':
+        output.write(f"{indent}uint32_t tmp;\n")
+        output.write(f"{indent}if (sds_json_parse_uint(m.value, &tmp) && tmp <= UINT8_MAX) {target} = (uint8_t)tmp;\n")
+    elif field.type in ('int8', 'int16', 'int32'):
+        output.write(f"{indent}int32_t tmp;\n")
+        output.write(f"{indent}if (sds_json_parse_int(m.value, &tmp)) {target} = ({field.type}_t)tmp;\n")
+    elif field.type in ('uint16', 'uint32'):
+        output.write(f"{indent}uint32_t tmp;\n")
+        output.write(f"{indent}if (sds_json_parse_uint(m.value, &tmp)) {target} = ({field.type}_t)tmp;\n")
+    else:
+        output.write(f"{indent}sds_json_parse_uint(m.value, &{target});\n")
+
+
 def _write_serialize_field(output: TextIO, field: Field, ptr_name: str = 'cfg'):
     """Write serialization code for a single field."""
     if field.type == 'string':
         output.write(f'    sds_json_add_string(w, "{field.name}", {ptr_name}->{field.name});\n')
     elif field.type == 'bool':
         output.write(f'    sds_json_add_bool(w, "{field.name}", {ptr_name}->{field.name});\n')
+    elif field.type == 'float' and field.precision:
+        output.write(f'    sds_json_add_float_fixed(w, "{field.name}", {ptr_name}->{field.name}, {field.precision});\n')
     elif field.type == 'float':
         output.write(f'    sds_json_add_float(w, "{field.name}", {ptr_name}->{field.name});\n')
     elif field.type.startswith('int'):
@@ -296,79 +450,84 @@ def _write_serialize_field(output: TextIO, field: Field, ptr_name: str = 'cfg'):
         output.write(f'    sds_json_add_uint(w, "{field.name}", {ptr_name}->{field.name});\n')
 
 
-def _write_deserialize_field(output: TextIO, field: Field, ptr_name: str):
-    """Write deserialization code for a single field."""
+def _c_float(value: float) -> str:
+    """Format a float as a C literal."""
+    return f"{float(value)!r}f"
+
+
+def _field_descriptor(name: str, section: str, field) -> str:
+    """One SdsFieldMeta initializer; filters and precision only when set."""
+    field_type = FIELD_TYPE_MAP.get(field.type, 'SDS_FIELD_UINT8')
     if field.type == 'string':
         size = field.array_size if field.array_size else DEFAULT_STRING_SIZE
-        output.write(f'    sds_json_get_string_field(r, "{field.name}", {ptr_name}->{field.name}, {size});\n')
-    elif field.type == 'uint8':
-        output.write(f'    sds_json_get_uint8_field(r, "{field.name}", &{ptr_name}->{field.name});\n')
-    elif field.type == 'bool':
-        output.write(f'    {{ bool tmp; if (sds_json_get_bool_field(r, "{field.name}", &tmp)) {ptr_name}->{field.name} = tmp; }}\n')
-    elif field.type == 'float':
-        output.write(f'    sds_json_get_float_field(r, "{field.name}", &{ptr_name}->{field.name});\n')
-    elif field.type in ('int8', 'int16', 'int32'):
-        output.write(f'    {{ int32_t tmp; if (sds_json_get_int_field(r, "{field.name}", &tmp)) {ptr_name}->{field.name} = tmp; }}\n')
-    elif field.type in ('uint16', 'uint32'):
-        output.write(f'    {{ uint32_t tmp; if (sds_json_get_uint_field(r, "{field.name}", &tmp)) {ptr_name}->{field.name} = tmp; }}\n')
     else:
-        output.write(f'    sds_json_get_uint_field(r, "{field.name}", &{ptr_name}->{field.name});\n')
+        size = f'sizeof((({name}{section}*)0)->{field.name})'
+    members = [f'.name = "{field.name}"', f'.type = {field_type}',
+               f'.offset = offsetof({name}{section}, {field.name})', f'.size = {size}']
+    if field.deadband:
+        members.append(f'.deadband = {_c_float(field.deadband)}')
+    if field.hysteresis:
+        members.append(f'.hysteresis = {_c_float(field.hysteresis)}')
+    if field.min_interval_ms:
+        members.append(f'.min_interval_ms = {field.min_interval_ms}')
+    if field.precision:
+        members.append(f'.precision = {field.precision}')
+    return f'    {{ {", ".join(members)} }},\n'
 
 
 def _generate_field_descriptors(output: TextIO, name: str, table: Table):
     """Generate field descriptor arrays for delta serialization."""
     upper_name = _to_upper_snake(name)
     
-    # Config field descriptors
-    if table.config_fields:
-        output.write(f"/* Config field descriptors for delta sync */\n")
-        output.write(f"static const SdsFieldMeta SDS_{upper_name}_CONFIG_FIELDS[] = {{\n")
-        for field in table.config_fields:
-            field_type = FIELD_TYPE_MAP.get(field.type, 'SDS_FIELD_UINT8')
-            if field.type == 'string':
-                size = field.array_size if field.array_size else DEFAULT_STRING_SIZE
-                output.write(f'    {{ "{field.name}", {field_type}, '
-                           f'offsetof({name}Config, {field.name}), {size} }},\n')
-            else:
-                output.write(f'    {{ "{field.name}", {field_type}, '
-                           f'offsetof({name}Config, {field.name}), '
-                           f'sizeof((({name}Config*)0)->{field.name}) }},\n')
-        output.write("};\n")
-        output.write(f"#define SDS_{upper_name}_CONFIG_FIELD_COUNT {len(table.config_fields)}\n\n")
-    
-    # State field descriptors
-    if table.state_fields:
-        output.write(f"/* State field descriptors for delta sync */\n")
-        output.write(f"static const SdsFieldMeta SDS_{upper_name}_STATE_FIELDS[] = {{\n")
-        for field in table.state_fields:
-            field_type = FIELD_TYPE_MAP.get(field.type, 'SDS_FIELD_UINT8')
-            if field.type == 'string':
-                size = field.array_size if field.array_size else DEFAULT_STRING_SIZE
-                output.write(f'    {{ "{field.name}", {field_type}, '
-                           f'offsetof({name}State, {field.name}), {size} }},\n')
-            else:
-                output.write(f'    {{ "{field.name}", {field_type}, '
-                           f'offsetof({name}State, {field.name}), '
-                           f'sizeof((({name}State*)0)->{field.name}) }},\n')
+    sections = (
+        ('Config', 'CONFIG', table.config_fields),
+        ('State', 'STATE', table.state_fields),
+        ('Status', 'STATUS', table.status_fields),
+    )
+    for section, upper_section, fields in sections:
+        if not fields:
+            continue
+        output.write(f"/* {section} field descriptors for delta sync */\n")
+        output.write(f"static const SdsFieldMeta SDS_{upper_name}_{upper_section}_FIELDS[] = {{\n")
+        for field in fields:
+            output.write(_field_descriptor(name, section, field))
         output.write("};\n")
-        output.write(f"#define SDS_{upper_name}_STATE_FIELD_COUNT {len(table.state_fields)}\n\n")
-    
-    # Status field descriptors
-    if table.status_fields:
-        output.write(f"/* Status field descriptors for delta sync */\n")
-        output.write(f"static const SdsFieldMeta SDS_{upper_name}_STATUS_FIELDS[] = {{\n")
-        for field in table.status_fields:
-            field_type = FIELD_TYPE_MAP.get(field.type, 'SDS_FIELD_UINT8')
+        output.write(f"#define SDS_{upper_name}_{upper_section}_FIELD_COUNT {len(fields)}\n\n")
+
+
+def _generate_field_setters(output: TextIO, name: str, table: Table):
+    """Generate {table}_set_{section}_{field}() setters for dirty tracking."""
+    lower_name = _to_lower_snake(name)
+    sections = (
+        ('config', 'Config', 'SDS_SECTION_CONFIG', table.config_fields),
+        ('state', 'State', 'SDS_SECTION_STATE', table.state_fields),
+        ('status', 'Status', 'SDS_SECTION_STATUS', table.status_fields),
+    )
+    
+    for section, struct_suffix, section_enum, fields in sections:
+        if not fields:
+            continue
+        output.write(f"/* {struct_suffix} setters: assign and mark the field for dirty tracking */\n")
+        for idx, field in enumerate(fields):
+            func = f"{lower_name}_set_{section}_{field.name}"
+            struct = f"{name}{struct_suffix}"
+            mark = f'sds_mark_dirty("{name}", {section_enum}, {idx});'
             if field.type == 'string':
                 size = field.array_size if field.array_size else DEFAULT_STRING_SIZE
-                output.write(f'    {{ "{field.name}", {field_type}, '
-                           f'offsetof({name}Status, {field.name}), {size} }},\n')
+                output.write(f"static inline void {func}({struct}* s, const char* value) {{\n")
+                output.write(f"    if (strncmp(s->{field.name}, value, {size}) == 0) return;\n")
+                output.write(f"    strncpy(s->{field.name}, value, {size - 1});\n")
+                output.write(f"    s->{field.name}[{size - 1}] = '\\0';\n")
+            elif field.array_size:
+                continue
             else:
-                output.write(f'    {{ "{field.name}", {field_type}, '
-                           f'offsetof({name}Status, {field.name}), '
-                           f'sizeof((({name}Status*)0)->{field.name}) }},\n')
-        output.write("};\n")
-        output.write(f"#define SDS_{upper_name}_STATUS_FIELD_COUNT {len(table.status_fields)}\n\n")
+                c_type = TYPE_MAP.get(field.type, 'uint8_t')
+                output.write(f"static inline void {func}({struct}* s, {c_type} value) {{\n")
+                output.write(f"    if (s->{field.name} == value) return;\n")
+                output.write(f"    s->{field.name} = value;\n")
+            output.write(f"    {mark}\n")
+            output.write("}\n")
+        output.write("\n")
 
 
 def _generate_max_section_size(output: TextIO, schema: Schema):
@@ -481,7 +640,18 @@ def _generate_table_registry(output: TextIO, schema: Schema):
             output.write(f"        .slot_last_seen_offset = offsetof({name}StatusSlot, last_seen_ms),\n")
             output.write(f"        .slot_eviction_deadline_offset = offsetof({name}StatusSlot, eviction_deadline),\n")
             output.write(f"        .slot_status_offset = offsetof({name}StatusSlot, status),\n")
-            output.write("        .own_max_status_slots = SDS_GENERATED_MAX_NODES,\n")
+            count_type = _slot_count_type(table.max_nodes or DEFAULT_MAX_NODES)
+            external = 1 if table.slot_storage == 'external' else 0
+            output.write(f"        .own_max_status_slots = {_max_nodes_expr(table, upper_name)},\n")
+            output.write(f"        .own_status_count_size = sizeof({count_type}),\n")
+            output.write(f"        .own_status_slots_external = {external},\n")
+            if table.history:
+                output.write(f"        .own_status_history_offset = offsetof({name}OwnerTable, status_history),\n")
+                output.write(f"        .own_status_history_depth = {table.history},\n")
+            else:
+                output.write("        .own_status_history_offset = 0,\n")
+                output.write("        .own_status_history_depth = 0,\n")
+            output.write(f"        .slot_seq_offset = offsetof({name}StatusSlot, status_seq),\n")
         else:
             output.write("        .own_status_slots_offset = 0,\n")
             output.write("        .own_status_slot_size = 0,\n")
@@ -493,35 +663,41 @@ def _generate_table_registry(output: TextIO, schema: Schema):
             output.write("        .slot_eviction_deadline_offset = 0,\n")
             output.write("        .slot_status_offset = 0,\n")
             output.write("        .own_max_status_slots = 0,\n")
+            output.write("        .own_status_count_size = 0,\n")
+            output.write("        .own_status_slots_external = 0,\n")
+            output.write("        .own_status_history_offset = 0,\n")
+            output.write("        .own_status_history_depth = 0,\n")
+            output.write("        .slot_seq_offset = 0,\n")
         
         # Serialization callbacks
-        if table.config_fields:
+        callbacks = table.serializer == 'callbacks'
+        if table.config_fields and callbacks:
             output.write(f"        .serialize_config = {lower_name}_serialize_config,\n")
         else:
             output.write("        .serialize_config = NULL,\n")
         
-        if table.state_fields:
+        if table.state_fields and callbacks:
             output.write(f"        .serialize_state = {lower_name}_serialize_state,\n")
         else:
             output.write("        .serialize_state = NULL,\n")
         
-        if table.status_fields:
+        if table.status_fields and callbacks:
             output.write(f"        .serialize_status = {lower_name}_serialize_status,\n")
         else:
             output.write("        .serialize_status = NULL,\n")
         
         # Deserialization callbacks
-        if table.config_fields:
+        if table.config_fields and callbacks:
             output.write(f"        .deserialize_config = {lower_name}_deserialize_config,\n")
         else:
             output.write("        .deserialize_config = NULL,\n")
         
-        if table.state_fields:
+        if table.state_fields and callbacks:
             output.write(f"        .deserialize_state = {lower_name}_deserialize_state,\n")
         else:
             output.write("        .deserialize_state = NULL,\n")
         
-        if table.status_fields:
+        if table.status_fields and callbacks:
             output.write(f"        .deserialize_status = {lower_name}_deserialize_status,\n")
         else:
             output.write("        .deserialize_status = NULL,\n")
@@ -548,6 +724,20 @@ def _generate_table_registry(output: TextIO, schema: Schema):
             output.write("        .status_fields = NULL,\n")
             output.write("        .status_field_count = 0,\n")
         
+        # Aggregates of a summary table
+        if table.source:
+            output.write(f'        .aggregate_source = "{table.source}",\n')
+            output.write(f"        .aggregates = SDS_{upper_name}_AGGREGATES,\n")
+            output.write(f"        .aggregate_count = SDS_{upper_name}_AGGREGATE_COUNT,\n")
+            output.write(f"        .aggregate_storage_offset = offsetof({name}Table, aggregate_storage),\n")
+            output.write(f"        .aggregate_storage_size = sizeof((({name}Table*)0)->aggregate_storage),\n")
+        else:
+            output.write("        .aggregate_source = NULL,\n")
+            output.write("        .aggregates = NULL,\n")
+            output.write("        .aggregate_count = 0,\n")
+            output.write("        .aggregate_storage_offset = 0,\n")
+            output.write("        .aggregate_storage_size = 0,\n")
+        
         output.write("    },\n")
     
     output.write("};\n\n")
@@ -11,12 +11,23 @@ Grammar:
     table           = 'table' IDENT '{' table_body '}'
     table_body      = annotation* (config_section | state_section | status_section)*
     
-    config_section  = 'config' '{' field* '}'
-    state_section   = 'state' '{' field* '}'
-    status_section  = 'status' '{' field* '}'
+    config_section  = 'config' '{' (annotation* field)* '}'
+    state_section   = 'state' '{' (annotation* field)* '}'
+    status_section  = 'status' '{' (annotation* field)* '}'
     
     annotation      = '@' IDENT '=' VALUE
     field           = TYPE IDENT ('=' DEFAULT)? ';'
+
+Field annotations apply to the field that follows (filters: state/status only):
+    @deadband = X       ignore changes up to X from the last published value
+    @hysteresis = X     extra change needed to reverse the last published move
+    @min_interval = MS  shortest time between publishes of the field
+    @precision = N      float fields, any section: write N decimals (1-9)
+                        instead of the shortest round-trip form
+    @aggregate = OP     state/status of a table with @source: computed from
+                        the source's status slots; OP is count, count_online,
+                        min(f), max(f), sum(f), mean(f) or pNN(f) (NN 1-99)
+                        over source status field f
     TYPE            = BASE_TYPE ('[' NUMBER ']')?
     BASE_TYPE       = 'bool' | 'uint8' | 'int8' | 'uint16' | 'int16' 
                     | 'uint32' | 'int32' | 'float' | 'string'
@@ -43,6 +54,13 @@ class Field:
     default: Optional[Any] = None
     section: SectionType = SectionType.STATE
     comment: Optional[str] = None
+    deadband: float = 0.0               # Significance filters (0 = off)
+    hysteresis: float = 0.0
+    min_interval_ms: int = 0
+    precision: int = 0                  # Float decimals written (0 = shortest round-trip)
+    aggregate: Optional[str] = None     # count, count_online, min, max, sum, mean or percentile
+    aggregate_field: Optional[str] = None  # Source status field (None for the counts)
+    aggregate_percentile: int = 0       # 1-99 for percentile
 
 
 @dataclass
@@ -52,6 +70,11 @@ class Table:
     sync_interval_ms: int = 1000
     liveness_interval_ms: int = 30000  # Default 30s heartbeat
     # Note: eviction_grace_ms is now configured in SdsConfig, not per-table
+    max_nodes: Optional[int] = None     # None = SDS_GENERATED_MAX_NODES
+    slot_storage: str = "inline"        # "inline" or "external" (owner status slots)
+    history: int = 0                    # Status samples kept per device at the owner (0 = none)
+    source: Optional[str] = None        # Table whose status slots feed the @aggregate fields
+    serializer: str = "callbacks"       # "callbacks" (generated functions) or "schema" (core, from SdsFieldMeta)
     config_fields: List[Field] = dataclass_field(default_factory=list)
     state_fields: List[Field] = dataclass_field(default_factory=list)
     status_fields: List[Field] = dataclass_field(default_factory=list)
@@ -87,6 +110,8 @@ class Tokenizer:
         ('RBRACE', r'\}'),
         ('LBRACKET', r'\['),
         ('RBRACKET', r'\]'),
+        ('LPAREN', r'\('),
+        ('RPAREN', r'\)'),
         ('EQUALS', r'='),
         ('SEMICOLON', r';'),
         ('COMMA', r','),
@@ -135,11 +160,14 @@ class Parser:
     """Recursive descent parser for .sds schema files."""
     
     TYPES = {'bool', 'uint8', 'int8', 'uint16', 'int16', 'uint32', 'int32', 'float', 'string'}
+    FIELD_ANNOTATIONS = {'deadband', 'hysteresis', 'min_interval', 'precision', 'aggregate'}
+    AGGREGATE_OPS = {'count', 'count_online', 'min', 'max', 'sum', 'mean'}
     
     def __init__(self, tokens: List[tuple]):
         self.tokens = tokens
         self.pos = 0
         self.current_section = SectionType.STATE
+        self.table_tokens: Dict[str, tuple] = {}
     
     def current(self) -> tuple:
         return self.tokens[self.pos] if self.pos < len(self.tokens) else ('EOF', '', 0, 0)
@@ -178,8 +206,42 @@ class Parser:
             else:
                 raise ParseError(f"Expected 'table', got '{token[1]}'", token[2], token[3])
         
+        for table in schema.tables.values():
+            self._check_aggregates(schema, table)
+        
         return schema
     
+    def _check_aggregates(self, schema: Schema, table: Table):
+        """Check @source and @aggregate once every table is known."""
+        token = self.table_tokens[table.name]
+        aggregates = [f for f in table.state_fields + table.status_fields if f.aggregate]
+        if not table.source:
+            if aggregates:
+                raise ParseError(f"@aggregate on '{aggregates[0].name}' needs @source in table '{table.name}'",
+                                 token[2], token[3])
+            return
+        if not aggregates:
+            raise ParseError(f"@source needs @aggregate fields in table '{table.name}'", token[2], token[3])
+        
+        names = list(schema.tables)
+        source = schema.tables.get(table.source)
+        if source is None or source is table or names.index(table.source) > names.index(table.name):
+            raise ParseError(f"@source of '{table.name}' must name a table declared before it, "
+                             f"got {table.source!r}", token[2], token[3])
+        if not source.status_fields:
+            raise ParseError(f"@source table '{source.name}' has no status section", token[2], token[3])
+        if source.source:
+            raise ParseError(f"@source table '{source.name}' is itself a summary", token[2], token[3])
+        
+        status = {f.name: f for f in source.status_fields}
+        for field in aggregates:
+            if field.aggregate_field is None:
+                continue
+            src = status.get(field.aggregate_field)
+            if src is None or src.type in ('bool', 'string') or src.array_size is not None:
+                raise ParseError(f"@aggregate of '{field.name}' needs a numeric status field of "
+                                 f"'{source.name}', got {field.aggregate_field!r}", token[2], token[3])
+    
     def _parse_annotation(self) -> tuple:
         """Parse @name = value"""
         token = self.expect('ANNOTATION')
@@ -215,6 +277,7 @@ class Parser:
         self.expect('KEYWORD', 'table')
         name_token = self.expect('IDENT')
         table = Table(name=name_token[1])
+        self.table_tokens[table.name] = name_token
         
         self.expect('LBRACE')
         
@@ -225,6 +288,31 @@ class Parser:
                 table.sync_interval_ms = ann_value
             elif ann_name == 'liveness':
                 table.liveness_interval_ms = ann_value
+            elif ann_name == 'max_nodes':
+                if not isinstance(ann_value, int) or ann_value < 1 or ann_value > 0xFFFFFFFF:
+                    raise ParseError(f"@max_nodes must be a positive integer, got {ann_value!r}",
+                                     name_token[2], name_token[3])
+                table.max_nodes = ann_value
+            elif ann_name == 'slot_storage':
+                if ann_value not in ('inline', 'external'):
+                    raise ParseError(f"@slot_storage must be 'inline' or 'external', got {ann_value!r}",
+                                     name_token[2], name_token[3])
+                table.slot_storage = ann_value
+            elif ann_name == 'history':
+                if not isinstance(ann_value, int) or ann_value < 1 or ann_value > 0xFFFF:
+                    raise ParseError(f"@history must be an integer from 1 to 65535, got {ann_value!r}",
+                                     name_token[2], name_token[3])
+                table.history = ann_value
+            elif ann_name == 'source':
+                if not isinstance(ann_value, str):
+                    raise ParseError(f"@source must be a table name, got {ann_value!r}",
+                                     name_token[2], name_token[3])
+                table.source = ann_value
+            elif ann_name == 'serializer':
+                if ann_value not in ('callbacks', 'schema'):
+                    raise ParseError(f"@serializer must be 'callbacks' or 'schema', got {ann_value!r}",
+                                     name_token[2], name_token[3])
+                table.serializer = ann_value
             elif ann_name == 'eviction_grace':
                 # Deprecated: eviction_grace is now configured globally in SdsConfig
                 import sys
@@ -252,6 +340,10 @@ class Parser:
             else:
                 raise ParseError(f"Expected 'config', 'state', or 'status', got '{token[1]}'", token[2], token[3])
         
+        if table.history and not table.status_fields:
+            raise ParseError(f"@history needs a status section in table '{table.name}'",
+                             name_token[2], name_token[3])
+        
         self.expect('RBRACE')
         return table
     
@@ -261,17 +353,100 @@ class Parser:
         self.expect('LBRACE')
         
         fields = []
+        filters = {}
         while self.current()[0] != 'RBRACE':
             token = self.current()
-            if token[0] == 'KEYWORD' and token[1] in self.TYPES:
+            if token[0] == 'ANNOTATION':
+                name, value = self._parse_field_annotation(section_name, token)
+                filters[name] = value
+            elif token[0] == 'KEYWORD' and token[1] in self.TYPES:
                 field = self._parse_field()
+                self._apply_field_filters(field, filters, token)
+                filters = {}
                 fields.append(field)
             else:
                 raise ParseError(f"Expected type, got '{token[1]}'", token[2], token[3])
         
+        if filters:
+            token = self.current()
+            raise ParseError(f"Field annotation without a field: @{next(iter(filters))}",
+                             token[2], token[3])
+        
         self.expect('RBRACE')
         return fields
     
+    def _parse_field_annotation(self, section_name: str, token: tuple) -> tuple:
+        """Parse a significance filter, @precision or @aggregate annotation preceding a field."""
+        name, value = self._parse_annotation()
+        if name not in self.FIELD_ANNOTATIONS:
+            raise ParseError(f"Unknown field annotation @{name}", token[2], token[3])
+        if name == 'aggregate':
+            return name, self._parse_aggregate(section_name, value, token)
+        if name == 'precision':
+            if isinstance(value, bool) or not isinstance(value, int) or not 1 <= value <= 9:
+                raise ParseError(f"@precision must be an integer from 1 to 9, got {value!r}",
+                                 token[2], token[3])
+            return name, value
+        if section_name == 'config':
+            raise ParseError(f"@{name} is only supported on state and status fields",
+                             token[2], token[3])
+        if isinstance(value, bool) or not isinstance(value, (int, float)) or value < 0:
+            raise ParseError(f"@{name} must be a non-negative number, got {value!r}",
+                             token[2], token[3])
+        if name == 'min_interval' and (not isinstance(value, int) or value > 0xFFFFFFFF):
+            raise ParseError(f"@min_interval must be an integer number of ms, got {value!r}",
+                             token[2], token[3])
+        return name, value
+    
+    def _parse_aggregate(self, section_name: str, op: Any, token: tuple) -> tuple:
+        """Parse the rest of @aggregate = op or op(field); returns (op, field, percentile)."""
+        if section_name == 'config':
+            raise ParseError("@aggregate is only supported on state and status fields",
+                             token[2], token[3])
+        percentile = 0
+        label = op
+        match = re.fullmatch(r'p(\d{1,2})', op) if isinstance(op, str) else None
+        if match:
+            percentile = int(match.group(1))
+            if not 1 <= percentile <= 99:
+                raise ParseError(f"@aggregate percentile must be p1 to p99, got {op!r}",
+                                 token[2], token[3])
+            op = 'percentile'
+        elif op not in self.AGGREGATE_OPS:
+            raise ParseError(f"Unknown @aggregate operation {op!r}", token[2], token[3])
+        
+        source_field = None
+        if self.current()[0] == 'LPAREN':
+            self.advance()
+            source_field = self.expect('IDENT')[1]
+            self.expect('RPAREN')
+        if op in ('count', 'count_online') and source_field is not None:
+            raise ParseError(f"@aggregate = {op} takes no field", token[2], token[3])
+        if op not in ('count', 'count_online') and source_field is None:
+            raise ParseError(f"@aggregate = {label} needs a field, e.g. {label}(temperature)",
+                             token[2], token[3])
+        return op, source_field, percentile
+    
+    def _apply_field_filters(self, field: Field, filters: Dict[str, Any], token: tuple):
+        """Attach parsed filter annotations to a field."""
+        numeric = field.type not in ('bool', 'string') and field.array_size is None
+        for name in ('deadband', 'hysteresis'):
+            if name in filters and not numeric:
+                raise ParseError(f"@{name} needs a numeric field, '{field.name}' is {field.type}",
+                                 token[2], token[3])
+        field.deadband = float(filters.get('deadband', 0.0))
+        field.hysteresis = float(filters.get('hysteresis', 0.0))
+        field.min_interval_ms = int(filters.get('min_interval', 0))
+        if 'precision' in filters and (field.type != 'float' or field.array_size is not None):
+            raise ParseError(f"@precision needs a float field, '{field.name}' is {field.type}",
+                             token[2], token[3])
+        field.precision = int(filters.get('precision', 0))
+        if 'aggregate' in filters:
+            if field.type in ('bool', 'string') or field.array_size is not None:
+                raise ParseError(f"@aggregate needs a numeric field, '{field.name}' is {field.type}",
+                                 token[2], token[3])
+            field.aggregate, field.aggregate_field, field.aggregate_percentile = filters['aggregate']
+    
     def _parse_field(self) -> Field:
         """Parse field: TYPE[N]? NAME (= DEFAULT)? ;"""
         type_token = self.advance()
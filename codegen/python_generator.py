@@ -101,8 +101,45 @@ class PythonGenerator:
             else:
                 lines.append(f"    {f.name}: {self._get_python_type(f)} = Field(default={default})")
         
+        lines.extend(self._generate_layout(fields))
         return lines
     
+    def _generate_layout(self, fields: List[Field]) -> List[str]:
+        """
+        Generate the section's precompiled buffer layout.
+        
+        One (name, type, offset, size, string_len, deadband, hysteresis,
+        min_interval_ms, precision) entry per field, the layout
+        sds.tables.analyze_dataclass() would otherwise derive at registration.
+        """
+        lines = ["", "    __sds_layout__ = ("]
+        offset = 0
+        for f in fields:
+            kind, size = self._LAYOUT_TYPES.get(f.type, ("int32", 4))
+            string_len = None
+            if f.type == "string":
+                string_len = size = f.array_size or 32
+            lines.append(f"        ({f.name!r}, {kind!r}, {offset}, {size}, {string_len}, "
+                         f"{float(f.deadband or 0)!r}, {float(f.hysteresis or 0)!r}, "
+                         f"{f.min_interval_ms or 0}, {f.precision or 0}),")
+            offset += size
+        lines.append("    )")
+        lines.append(f"    __sds_size__ = {offset}")
+        return lines
+    
+    # Schema type -> (sds.tables.FieldType value, size in the section buffer)
+    _LAYOUT_TYPES = {
+        "uint8": ("uint8", 1),
+        "int8": ("int8", 1),
+        "uint16": ("uint16", 2),
+        "int16": ("int16", 2),
+        "uint32": ("uint32", 4),
+        "int32": ("int32", 4),
+        "float": ("float32", 4),
+        "bool": ("bool", 1),
+        "string": ("string", 32),
+    }
+    
     def _get_python_type(self, f: Field) -> str:
         """Get Python type annotation for a field."""
         if f.type in ("uint8", "uint16", "uint32", "int8", "int16", "int32"):
@@ -128,7 +165,16 @@ class PythonGenerator:
             "bool": "",
             "string": f"string_len={f.array_size or 32}",
         }
-        return mapping.get(f.type, "")
+        args = [mapping.get(f.type, "")] if mapping.get(f.type) else []
+        if f.deadband:
+            args.append(f"deadband={f.deadband!r}")
+        if f.hysteresis:
+            args.append(f"hysteresis={f.hysteresis!r}")
+        if f.min_interval_ms:
+            args.append(f"min_interval_ms={f.min_interval_ms}")
+        if f.precision:
+            args.append(f"precision={f.precision}")
+        return ", ".join(args)
     
     def _get_default(self, f: Field) -> str:
         """Get default value for a field."""
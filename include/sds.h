@@ -62,11 +62,18 @@ extern "C" {
  * @{
  */
 
-/** @brief Maximum number of tables per node */
+/** @brief Default table capacity (SdsConfig.max_tables = 0) */
 #define SDS_MAX_TABLES           8
 
-/** @brief Maximum number of raw MQTT subscriptions */
+/** @brief Raw MQTT subscriptions in the built-in storage (see sds_set_raw_subscription_storage()) */
+#ifndef SDS_MAX_RAW_SUBSCRIPTIONS
 #define SDS_MAX_RAW_SUBSCRIPTIONS 8
+#endif
+
+/** @brief Topic trie nodes budgeted per raw subscription (shared levels count once) */
+#ifndef SDS_RAW_TRIE_NODES_PER_SUB
+#define SDS_RAW_TRIE_NODES_PER_SUB 4
+#endif
 
 /** @brief Maximum length of node ID string (including null terminator) */
 #define SDS_MAX_NODE_ID_LEN      32
@@ -74,6 +81,9 @@ extern "C" {
 /** @brief Maximum length of table type name (including null terminator) */
 #define SDS_MAX_TABLE_TYPE_LEN   32
 
+/** @brief Maximum length of SdsConfig.cluster_group (including null terminator) */
+#define SDS_MAX_CLUSTER_GROUP_LEN 32
+
 /** @brief Default MQTT broker port */
 #define SDS_DEFAULT_MQTT_PORT    1883
 
@@ -91,6 +101,105 @@ extern "C" {
 #define SDS_MSG_BUFFER_SIZE      2048
 #endif
 
+/**
+ * @brief Buckets in each owner table's built-in node_id -> slot hash index
+ *
+ * Must be a power of two. The built-in index covers tables with at most
+ * 3/4 of this many slots; larger tables should supply their own buckets
+ * with sds_set_owner_slot_index() or fall back to a linear scan. The
+ * buckets are carved from the table arena for owner tables that use them.
+ */
+#ifndef SDS_SLOT_INDEX_SIZE
+#define SDS_SLOT_INDEX_SIZE      256
+#endif
+
+/**
+ * @brief Longest round trip accepted for a clock offset sample (ms)
+ *
+ * Clock exchanges whose round trip exceeds this (typically a retained config
+ * delivered long after it was published) are ignored; see
+ * SdsConfig.enable_latency_tracking.
+ */
+#ifndef SDS_CLOCK_MAX_RTT_MS
+#define SDS_CLOCK_MAX_RTT_MS     5000
+#endif
+
+/**
+ * @brief Bytes per table for pre-escaped field key fragments
+ *
+ * Schema-driven serialization renders each field's `"name":` once at
+ * registration, into a block of the table arena sized for the table's
+ * fields (name length + 4 bytes each, plus 1). Sections that do not fit
+ * this limit, or an arena without room, fall back to per-message key
+ * formatting.
+ */
+#ifndef SDS_FIELD_KEY_CACHE_SIZE
+#define SDS_FIELD_KEY_CACHE_SIZE 512
+#endif
+
+/**
+ * @brief Fields per table that can use hysteresis or a minimum interval
+ *
+ * Each state/status field with SdsFieldMeta.hysteresis or min_interval_ms
+ * set takes one of these slots to remember its last publish. Slots are
+ * carved from the table arena when the metadata is attached, only as many
+ * as the table uses. Fields beyond the limit keep their deadband but
+ * publish without the other two.
+ */
+#ifndef SDS_MAX_TRACKED_FIELDS
+#define SDS_MAX_TRACKED_FIELDS   8
+#endif
+
+/**
+ * @brief Maximum depth of the outbound message queue
+ *
+ * Upper bound for SdsConfig.outbound_queue_depth (at most 255). Each slot
+ * holds one serialized message, SDS_TOPIC_BUFFER_SIZE + SDS_MSG_BUFFER_SIZE
+ * bytes carved from the table arena at sds_init(); depth 0 takes none.
+ */
+#ifndef SDS_OUTBOUND_QUEUE_MAX
+#define SDS_OUTBOUND_QUEUE_MAX   4
+#endif
+
+/**
+ * @brief Maximum depth of the inbound message queue
+ *
+ * Upper bound for SdsConfig.inbound_queue_depth (at most 254). Each slot
+ * holds one received message, SDS_TOPIC_BUFFER_SIZE + SDS_MSG_BUFFER_SIZE
+ * bytes carved from the table arena at sds_init(); depth 0 takes none.
+ */
+#ifndef SDS_INBOUND_QUEUE_MAX
+#define SDS_INBOUND_QUEUE_MAX    8
+#endif
+
+/**
+ * @brief Topics per SUBSCRIBE request when (re)subscribing
+ *
+ * Table and raw subscriptions are sent with
+ * sds_platform_mqtt_subscribe_many() in groups of up to this many topics.
+ * The batch is built on the stack of the subscribing call and takes
+ * SDS_TOPIC_BUFFER_SIZE bytes per topic.
+ */
+#ifndef SDS_SUBSCRIBE_BATCH
+#define SDS_SUBSCRIBE_BATCH      8
+#endif
+
+/**
+ * @brief Status (or config) messages per keyframe (baseline) under delta sync
+ *
+ * Used when SdsConfig.keyframe_interval is 0.
+ */
+#ifndef SDS_DEFAULT_KEYFRAME_INTERVAL
+#define SDS_DEFAULT_KEYFRAME_INTERVAL 10
+#endif
+
+/**
+ * @brief Resync requests an owner can hold until the next sds_loop()
+ */
+#ifndef SDS_RESYNC_QUEUE_MAX
+#define SDS_RESYNC_QUEUE_MAX     8
+#endif
+
 /** @} */ // end of config group
 
 /**
@@ -111,12 +220,132 @@ typedef enum {
     SDS_ROLE_DEVICE     /**< Device: receives config, publishes state/status */
 } SdsRole;
 
+/**
+ * @brief What happens to a sync message when the outbound queue is full.
+ * 
+ * See SdsConfig.outbound_queue_depth.
+ */
+typedef enum {
+    SDS_OUTBOUND_COALESCE = 0,    /**< A full section replaces the queued message for its topic; otherwise drop oldest (default) */
+    SDS_OUTBOUND_DROP_OLDEST = 1, /**< Discard the oldest queued message */
+    SDS_OUTBOUND_DROP_NEWEST = 2  /**< Discard the new message; the change is retried on the next sync */
+} SdsOutboundPolicy;
+
+/**
+ * @brief Where config/state/status callbacks run when ingest workers apply messages.
+ * 
+ * See SdsConfig.ingest_workers.
+ */
+typedef enum {
+    SDS_CALLBACKS_WORKER = 0,   /**< On the worker that applied the message, with the table locked (default) */
+    SDS_CALLBACKS_LOOP = 1      /**< From the next sds_loop(), on the application thread */
+} SdsCallbackExecutor;
+
 /**
  * @brief Configuration for SDS initialization.
  * 
  * This structure is passed to sds_init() to configure the SDS library.
  * All string fields are copied internally, so they can be stack-allocated.
  * 
+ * With outbound_queue_depth > 0, table syncs copy their messages into a
+ * bounded queue instead of publishing inline. Platforms with an async
+ * sender (POSIX thread, ESP32 task) publish from it, so a slow broker no
+ * longer stalls sds_loop(); elsewhere sds_loop() drains the queue after
+ * its syncs.
+ * 
+ * With inbound_queue_depth > 0, received table messages are copied into a
+ * bounded pool and queued per table instead of being applied on the MQTT
+ * receive path. Up to ingest_workers platform threads (POSIX) apply them,
+ * one message per table at a time and different tables in parallel;
+ * elsewhere sds_loop() applies them. LWT messages are always applied by
+ * sds_loop(), after the messages that arrived before them. While workers
+ * run, hold sds_lock_table() to read or reconfigure an owner table.
+ * 
+ * With batch_max_bytes > 0, state and status messages are appended to one
+ * envelope per node, published on sds/batch/{node_id} when the next message
+ * would not fit or batch_flush_ms after its first message (at the end of
+ * the sds_loop() that filled it when 0). Owners with batching enabled
+ * subscribe to sds/batch/+ and apply each message of an envelope as if it
+ * had arrived on its own topic, so every owner should enable it when any
+ * device does. Config stays retained on its own topic. The envelope buffer
+ * (batch_max_bytes) is carved from the table arena at sds_init().
+ * 
+ * With enable_instrumentation, each table counts its messages, bytes,
+ * delta vs. full syncs and drops, and sds_loop() and each table keep
+ * latency histograms (sds_platform_micros()). See sds_get_table_stats().
+ * Each table's stats are carved from the table arena at registration.
+ * 
+ * With enable_latency_tracking, devices echo the "ts" of the last config
+ * they applied, and their own receive time, in full status messages
+ * (heartbeats). Owners combine that with the heartbeat's own "ts" to
+ * estimate each device's clock offset NTP-style, then record how long each
+ * status took from the device's publish to being applied (the
+ * propagation_ms histogram in SdsTableStats, and per device with
+ * sds_set_owner_latency_slots()). Until a device has echoed a config, its
+ * offset is bounded from its fastest delivery, so latencies read relative
+ * to that. Enable it on owners and devices alike.
+ * 
+ * With enable_config_cache, devices save every config they apply with
+ * sds_platform_storage_save() (NVS on ESP32, files under SDS_STORAGE_DIR
+ * on POSIX) and apply the saved one when the table is registered, before
+ * the broker delivers the retained config. A config message identical to
+ * the applied one is then skipped without parsing; the first one after a
+ * restore still runs the config callback. The cache is keyed by node_id
+ * and table type, so give devices a fixed node_id.
+ * 
+ * Owners can be scaled out as a cluster in one of two ways; each device is
+ * then tracked (status slot, LWT, eviction) by exactly one member:
+ * - cluster_members > 1: every member subscribes as usual and keeps only
+ *   the devices that rendezvous hashing of node_id assigns to its
+ *   cluster_member index (sds_cluster_member_for()). Status, batch and LWT
+ *   messages for other members are dropped by topic before parsing, state
+ *   messages once their node is known. Works with any broker; a resize
+ *   (sds_set_cluster_membership()) moves only the devices whose member
+ *   changed. Slot memory and apply cost are divided between members,
+ *   inbound traffic is not.
+ * - cluster_group: owner subscriptions use MQTT shared subscriptions
+ *   ($share/{group}/...), so the broker delivers each message to one member
+ *   and inbound traffic is divided as well. The broker must keep a
+ *   publisher on one member (e.g. EMQX shared_subscription_strategy =
+ *   hash_clientid); round-robin strategies spread a device over every
+ *   member.
+ * Members publish config like any owner, so write it from one member or
+ * write the same values from all.
+ * 
+ * With persistent_session, the node connects with cleansession=0 under its
+ * node_id, so the broker keeps its subscriptions (and queues nothing: SDS
+ * subscribes at QoS 0) while it is away. After a reconnect that resumes the
+ * session, subscriptions are not sent again; otherwise every table and raw
+ * subscription is restored in SDS_SUBSCRIBE_BATCH-topic SUBSCRIBE requests.
+ * The session outlives sds_shutdown(), so give the node a fixed node_id.
+ * 
+ * With enable_delta_sync, status messages carry a sequence number that
+ * advances with every message carrying fields. Every keyframe_interval-th
+ * status message is sent in full (a keyframe); the others carry only the
+ * changed fields, and idle heartbeats carry none, just the sequence number
+ * of the last message. Owners whose slots have a sequence field
+ * (StatusSlot.status_seq, sds_set_owner_seq_offset()) detect a lost message
+ * from the next one and publish a resync request on
+ * sds/{table_type}/resync/{node_id}; the device answers with a keyframe at
+ * its next sync.
+ * 
+ * Delta sync also applies to owner config with field metadata: the full
+ * section stays retained on sds/{table_type}/config as a baseline, and
+ * changes go to sds/{table_type}/config/delta (also retained) carrying every
+ * field changed since that baseline. Every keyframe_interval-th config
+ * message is a new baseline. Devices apply deltas in place, and a config
+ * that changes nothing does not invoke the config callback.
+ * 
+ * Table contexts and their shadow copies are carved from table_arena, at
+ * the exact section sizes, when given; otherwise from a built-in arena sized
+ * for SDS_MAX_TABLES tables with full-size shadows. The outbound queue
+ * ring, the inbound message pool and the batch buffer come from the same
+ * arena when enabled, and so do per-table stats with instrumentation or
+ * latency tracking, the field key cache and filter history of tables
+ * with field metadata, and the advertised liveness of owner slots. Use sds_config_arena_size() (or
+ * sds_table_arena_size() without them) to size it. The arena must
+ * stay valid until sds_shutdown().
+ * 
  * @note The mqtt_broker field is required; all others have defaults.
  */
 typedef struct {
@@ -128,18 +357,81 @@ typedef struct {
     uint32_t eviction_grace_ms; /**< Grace period before evicting offline devices (0 = disabled) */
     bool enable_delta_sync;     /**< Enable delta updates - only changed fields (default: false) */
     float delta_float_tolerance; /**< Float comparison tolerance for delta sync (default: 0.001) */
+    uint8_t outbound_queue_depth; /**< Queued sync messages, max SDS_OUTBOUND_QUEUE_MAX (0 = publish immediately, default) */
+    SdsOutboundPolicy outbound_policy; /**< Full-queue policy (default: SDS_OUTBOUND_COALESCE) */
+    void* table_arena;          /**< Memory for table contexts and shadows (NULL = built-in arena) */
+    size_t table_arena_size;    /**< Size of table_arena in bytes */
+    uint8_t max_tables;         /**< Table capacity (default: SDS_MAX_TABLES) */
+    uint8_t inbound_queue_depth; /**< Queued received messages, max SDS_INBOUND_QUEUE_MAX (0 = apply on receive, default) */
+    uint8_t ingest_workers;     /**< Threads applying queued messages (0 = sds_loop() applies them, default) */
+    SdsCallbackExecutor callback_executor; /**< Where callbacks for worker-applied messages run (default: SDS_CALLBACKS_WORKER) */
+    uint16_t batch_max_bytes;   /**< Batch envelope size, max SDS_MSG_BUFFER_SIZE (0 = publish each message, default) */
+    uint32_t batch_flush_ms;    /**< Longest a message waits in the envelope (0 = until the end of sds_loop(), default) */
+    bool enable_instrumentation; /**< Per-table counters and latency histograms (default: false) */
+    bool enable_latency_tracking; /**< Clock offset and publish-to-apply latency per device (default: false) */
+    bool enable_config_cache;   /**< Device: persist the applied config and start from it (default: false) */
+    const char* cluster_group;  /**< Owner: shared subscription group, max SDS_MAX_CLUSTER_GROUP_LEN - 1 chars (NULL = off) */
+    uint8_t cluster_members;    /**< Owner: members partitioning devices by node_id (0 or 1 = off) */
+    uint8_t cluster_member;     /**< Owner: this member's index, 0 to cluster_members - 1 */
+    bool persistent_session;    /**< Keep the MQTT session across reconnects (cleansession=0, default: false) */
+    uint16_t keyframe_interval; /**< Delta sync: status/config messages per full one (0 = SDS_DEFAULT_KEYFRAME_INTERVAL) */
 } SdsConfig;
 
+/**
+ * @brief Encoding used when publishing a table's sections.
+ * 
+ * Receivers detect the encoding from the first payload byte, so nodes
+ * using different formats can share a table. SDS_WIRE_BINARY requires
+ * field metadata (generated tables, or sds_set_table_fields()); sections
+ * without it are still published as JSON.
+ */
+typedef enum {
+    SDS_WIRE_JSON = 0,    /**< JSON text (default, readable by every SDS version) */
+    SDS_WIRE_BINARY = 1   /**< Compact binary: field indices, little-endian fixed-width values */
+} SdsWireFormat;
+
 /**
  * @brief Options for table registration.
  * 
  * Optional parameters that can be passed to sds_register_table().
  * Pass NULL to use defaults.
+ * 
+ * With sync_interval_max_ms > 0 the sync interval adapts between
+ * sync_interval_min_ms and sync_interval_max_ms, starting from
+ * sync_interval_ms: it halves after a sync that published a change and
+ * grows by half after one that found nothing to send or that started with
+ * the outbound queue more than half full.
+ * 
+ * With liveness_max_ms above the schema's liveness interval, a device
+ * doubles the gap after each heartbeat that had nothing new to report, up
+ * to liveness_max_ms, and returns to the schema interval on the next change.
+ * Any state or status publish already counts as a heartbeat. Devices
+ * advertise liveness_max_ms in their status. Owners keep each device's
+ * value with its status slot: sds_is_device_online() judges a device by
+ * its own advertised gap, and sds_get_liveness_interval() returns the
+ * widest gap of the devices now in a slot.
  */
 typedef struct {
     uint32_t sync_interval_ms;  /**< Sync check frequency in ms (default: 1000) */
+    SdsWireFormat wire_format;  /**< Outbound encoding (default: SDS_WIRE_JSON) */
+    bool dirty_tracking;        /**< Sync only fields marked with sds_mark_dirty() (default: false, compare with shadow) */
+    uint32_t sync_interval_min_ms; /**< Adaptive sync: shortest interval (0 = sync_interval_ms) */
+    uint32_t sync_interval_max_ms; /**< Adaptive sync: longest interval (0 = fixed interval, default) */
+    uint32_t liveness_max_ms;   /**< Device: longest heartbeat gap while idle (0 = fixed liveness, default) */
 } SdsTableOptions;
 
+/**
+ * @brief Table sections, for APIs that address one of them.
+ */
+typedef enum {
+    SDS_SECTION_CONFIG = 0,
+    SDS_SECTION_STATE = 1,
+    SDS_SECTION_STATUS = 2
+} SdsSection;
+
+/** Field index for sds_mark_dirty() that marks every field of a section */
+#define SDS_ALL_FIELDS 0xFF
+
 /**
  * @brief Runtime statistics.
  * 
@@ -151,8 +443,84 @@ typedef struct {
     uint32_t messages_received; /**< Total MQTT messages received */
     uint32_t reconnect_count;   /**< Number of MQTT reconnection attempts */
     uint32_t errors;            /**< Total error count */
+    uint32_t outbound_queued;   /**< Messages currently waiting in the outbound queue */
+    uint32_t outbound_high_water; /**< Deepest the outbound queue has been */
+    uint32_t outbound_dropped;  /**< Messages dropped because the outbound queue was full */
+    uint32_t outbound_coalesced; /**< Queued messages replaced by a newer one for the same topic */
+    uint32_t inbound_queued;    /**< Received messages waiting to be applied */
+    uint32_t inbound_high_water; /**< Deepest the inbound queue has been */
+    uint32_t inbound_dropped;   /**< Received messages dropped because the inbound queue was full */
+    uint32_t batches_sent;      /**< Batch envelopes published (or queued for the sender) */
+    uint32_t batched_messages;  /**< State/status messages carried by those envelopes */
+    uint32_t config_cache_restored; /**< Device: configs applied from the cache at registration */
+    uint32_t config_unchanged;  /**< Device: config messages that left the applied config unchanged */
+    uint32_t cluster_skipped;   /**< Owner: messages dropped as belonging to another cluster member */
+    uint32_t sessions_resumed;  /**< Reconnects that resumed the persistent session without resubscribing */
+    uint32_t seq_gaps;          /**< Owner: status sequence gaps detected (each requests a resync) */
+    uint32_t resync_keyframes;  /**< Device: keyframes sent for an owner's resync request */
 } SdsStats;
 
+/** Buckets per SdsLatencyHistogram */
+#define SDS_LATENCY_BUCKETS 20
+
+/**
+ * @brief Log-bucketed latency histogram in microseconds.
+ * 
+ * Bucket i counts samples in [2^i, 2^(i+1)) us; bucket 0 also counts 0 us
+ * and the last bucket everything from 2^(SDS_LATENCY_BUCKETS-1) us (~0.5 s).
+ */
+typedef struct {
+    uint32_t count;             /**< Samples recorded */
+    uint32_t total_us;          /**< Sum of all samples (wraps) */
+    uint32_t max_us;            /**< Largest sample */
+    uint32_t buckets[SDS_LATENCY_BUCKETS];
+} SdsLatencyHistogram;
+
+/**
+ * @brief Per-table counters (SdsConfig.enable_instrumentation).
+ * 
+ * Use sds_get_table_stats() to take a consistent copy.
+ */
+typedef struct {
+    uint32_t messages_sent;     /**< Config/state/status messages published (or queued) */
+    uint32_t bytes_sent;        /**< Payload bytes of those messages */
+    uint32_t messages_received; /**< Table messages applied (or dropped while applying) */
+    uint32_t bytes_received;    /**< Payload bytes of those messages */
+    uint32_t full_syncs;        /**< Messages carrying a full section */
+    uint32_t delta_syncs;       /**< Messages carrying only changed fields */
+    uint32_t buffer_full;       /**< Sections too large for SDS_MSG_BUFFER_SIZE */
+    uint32_t slots_full;        /**< Status messages from new devices with no free slot */
+    uint32_t decode_errors;     /**< Received messages that could not be decoded */
+    SdsLatencyHistogram serialize_us; /**< Encoding one outbound section */
+    SdsLatencyHistogram parse_us;     /**< Decoding and applying one received message */
+    SdsLatencyHistogram callback_us;  /**< Running one config/state/status callback */
+    SdsLatencyHistogram propagation_ms; /**< Device publish to owner apply, in ms (enable_latency_tracking) */
+} SdsTableStats;
+
+/**
+ * @brief One device's clock estimate and latest latency, kept by an owner.
+ * 
+ * @see sds_set_owner_latency_slots, sds_get_node_latency
+ */
+typedef struct {
+    int32_t clock_offset_ms;    /**< Device clock minus owner clock */
+    uint32_t rtt_ms;            /**< Round trip of the exchange behind the offset (0 if not synced) */
+    uint32_t ref_ts;            /**< Owner config "ts" that exchange echoed */
+    uint32_t last_latency_ms;   /**< Latest publish-to-apply latency */
+    uint32_t samples;           /**< Latency samples since the device (re)appeared */
+    bool synced;                /**< Offset comes from a clock exchange, not the one-way bound */
+} SdsNodeLatency;
+
+/**
+ * @brief Where sds_loop() spends its time (SdsConfig.enable_instrumentation).
+ */
+typedef struct {
+    SdsLatencyHistogram loop_us;      /**< Whole sds_loop() call while connected */
+    SdsLatencyHistogram mqtt_us;      /**< sds_platform_mqtt_loop() (receive path, inline ingest) */
+    SdsLatencyHistogram sync_us;      /**< One table sync */
+    SdsLatencyHistogram eviction_us;  /**< One eviction sweep of an owner table */
+} SdsLoopStats;
+
 /** @} */ // end of types group
 
 /**
@@ -241,6 +609,19 @@ typedef void (*SdsNodeIterator)(const char* node_id, const void* status, void* u
  */
 typedef void (*SdsErrorCallback)(SdsError error, const char* context);
 
+/**
+ * @brief Callback run when a message has been received.
+ * 
+ * Runs on the thread that received the message (the MQTT client's thread
+ * on POSIX), after the message was applied or queued. It must not block or
+ * call into SDS; use it to wake an event loop that then calls sds_loop().
+ * 
+ * @param user_data User-provided context from sds_on_wake()
+ * 
+ * @see sds_on_wake
+ */
+typedef void (*SdsWakeCallback)(void* user_data);
+
 /**
  * @brief Callback for schema version mismatch detection (owner role only).
  * 
@@ -326,14 +707,58 @@ typedef enum {
  * Used for per-field change detection and selective JSON serialization.
  * 
  * The code generator creates arrays of these descriptors for each section.
+ * 
+ * State and status fields may also carry significance filters
+ * (@deadband, @hysteresis and @min_interval in the schema). A change is
+ * only published once it moves the field more than deadband away from the
+ * value last published; moving back the other way needs deadband +
+ * hysteresis more. A field that passes is held until min_interval_ms after
+ * its previous publish. Zero disables each filter; without a deadband,
+ * floats use SdsConfig.delta_float_tolerance and other types publish on
+ * any change. Deadband and hysteresis only apply to numeric fields.
+ * 
+ * Float fields of any section are written with `precision` decimals
+ * (@precision in the schema), or in the shortest form that reads back
+ * as the same float when it is 0.
  */
 typedef struct {
     const char* name;     /**< Field name in JSON */
     SdsFieldType type;    /**< Field data type */
     uint16_t offset;      /**< Offset within section struct */
     uint16_t size;        /**< Size in bytes (for strings: buffer size) */
+    float deadband;       /**< Ignore changes up to this size from the last published value (0 = off) */
+    float hysteresis;     /**< Extra change needed to reverse the last published direction (0 = off) */
+    uint32_t min_interval_ms; /**< Shortest time between publishes of this field (0 = off) */
+    uint8_t precision;    /**< Float decimals written, up to SDS_JSON_MAX_DECIMALS (0 = shortest round-trip) */
 } SdsFieldMeta;
 
+/**
+ * @brief Reduction computed by an aggregate (see sds_set_table_aggregates()).
+ */
+typedef enum {
+    SDS_AGG_COUNT = 0,     /**< Devices with a status slot */
+    SDS_AGG_COUNT_ONLINE,  /**< Of those, devices online */
+    SDS_AGG_MIN,           /**< Smallest value of a status field over online devices */
+    SDS_AGG_MAX,           /**< Largest value */
+    SDS_AGG_SUM,           /**< Sum of the values */
+    SDS_AGG_MEAN,          /**< Mean of the values */
+    SDS_AGG_PERCENTILE,    /**< Nearest-rank percentile of the values */
+} SdsAggregateOp;
+
+/**
+ * @brief One summary field computed from a source table's status slots.
+ *
+ * The code generator creates these from @aggregate annotations; target
+ * names a state or status field of the summary table and source a status
+ * field of the source table (NULL for the counts).
+ */
+typedef struct {
+    const char* target;   /**< Summary field written */
+    SdsAggregateOp op;    /**< Reduction */
+    const char* source;   /**< Source status field (NULL for SDS_AGG_COUNT and SDS_AGG_COUNT_ONLINE) */
+    uint8_t percentile;   /**< 1-99 for SDS_AGG_PERCENTILE */
+} SdsAggregateMeta;
+
 /**
  * @brief Complete metadata for a table type.
  * 
@@ -382,9 +807,14 @@ typedef struct {
     size_t slot_last_seen_offset;       /**< offsetof(StatusSlot, last_seen_ms) */
     size_t slot_eviction_deadline_offset; /**< offsetof(StatusSlot, eviction_deadline) */
     size_t slot_status_offset;          /**< offsetof(StatusSlot, status) */
-    uint8_t own_max_status_slots;       /**< Maximum device slots (SDS_GENERATED_MAX_NODES) */
+    uint32_t own_max_status_slots;      /**< Maximum device slots (SDS_GENERATED_MAX_NODES) */
+    uint8_t own_status_count_size;      /**< sizeof(OwnerTable.status_count): 1, 2 or 4 (0 = 1) */
+    uint8_t own_status_slots_external;  /**< status_slots is a pointer (SDS_SLOTS_EXTERNAL) */
+    size_t own_status_history_offset;   /**< offsetof(OwnerTable, status_history), 0 = none */
+    uint16_t own_status_history_depth;  /**< Samples per device in status_history (@history) */
+    size_t slot_seq_offset;             /**< offsetof(StatusSlot, status_seq), 0 = no gap detection */
     
-    /* Serialization callbacks */
+    /* Serialization callbacks (NULL: serialize from the field metadata below) */
     SdsSerializeFunc serialize_config;   /**< Config section serializer (owner) */
     SdsSerializeFunc serialize_state;    /**< State section serializer (device) */
     SdsSerializeFunc serialize_status;   /**< Status section serializer (device) */
@@ -394,13 +824,20 @@ typedef struct {
     SdsDeserializeFunc deserialize_state;  /**< State section deserializer (owner) */
     SdsDeserializeFunc deserialize_status; /**< Status section deserializer (owner) */
     
-    /* Field metadata for delta serialization (optional, NULL if not available) */
+    /* Field metadata for delta and schema serialization (optional, NULL if not available) */
     const SdsFieldMeta* config_fields;     /**< Config field descriptors */
     uint8_t config_field_count;            /**< Number of config fields */
     const SdsFieldMeta* state_fields;      /**< State field descriptors */
     uint8_t state_field_count;             /**< Number of state fields */
     const SdsFieldMeta* status_fields;     /**< Status field descriptors */
     uint8_t status_field_count;            /**< Number of status fields */
+
+    /* Aggregates of a summary table (@source and @aggregate, NULL if none) */
+    const char* aggregate_source;          /**< Source table type */
+    const SdsAggregateMeta* aggregates;    /**< Aggregate descriptors */
+    uint8_t aggregate_count;               /**< Number of aggregates */
+    size_t aggregate_storage_offset;       /**< offsetof(DeviceTable, aggregate_storage) */
+    size_t aggregate_storage_size;         /**< sizeof(DeviceTable.aggregate_storage) */
 } SdsTableMeta;
 
 /**
@@ -447,6 +884,48 @@ void sds_set_table_registry(const SdsTableMeta* registry, size_t count);
  */
 SdsError sds_init(const SdsConfig* config);
 
+/**
+ * @brief Bytes of table arena needed for a table capacity.
+ * 
+ * @param max_tables Table capacity (0 = SDS_MAX_TABLES)
+ * @param section_bytes Total size of all sections of all tables that will
+ *        be registered, plus SDS_SLOT_INDEX_SIZE * 4 per owner table with a
+ *        built-in slot index, the field key cache of each table with
+ *        field metadata (see SDS_FIELD_KEY_CACHE_SIZE), 16 bytes per
+ *        field with hysteresis or min_interval_ms and 4 bytes per owner
+ *        status slot (0 = worst case, every section at the maximum size,
+ *        every table an owner with stats, a full key cache,
+ *        SDS_MAX_TRACKED_FIELDS tracked fields and up to
+ *        SDS_SLOT_INDEX_SIZE status slots)
+ * @return Minimum SdsConfig.table_arena_size
+ * 
+ * Example:
+ * @code
+ * static uint8_t arena[1024];   // checked against sds_table_arena_size()
+ * SdsConfig config = {
+ *     .mqtt_broker = "192.168.1.100",
+ *     .table_arena = arena,
+ *     .table_arena_size = sizeof(arena),
+ *     .max_tables = 2,
+ * };
+ * @endcode
+ */
+size_t sds_table_arena_size(uint8_t max_tables, size_t section_bytes);
+
+/**
+ * @brief Bytes of table arena needed for a configuration.
+ * 
+ * sds_table_arena_size() for config->max_tables plus the message queues
+ * config enables (outbound_queue_depth and inbound_queue_depth slots), its
+ * batch buffer (batch_max_bytes) and, with enable_instrumentation or
+ * enable_latency_tracking, one SdsTableStats per table.
+ * 
+ * @param config Configuration that will be passed to sds_init()
+ * @param section_bytes As for sds_table_arena_size()
+ * @return Minimum SdsConfig.table_arena_size
+ */
+size_t sds_config_arena_size(const SdsConfig* config, size_t section_bytes);
+
 /**
  * @brief Process SDS events.
  * 
@@ -463,6 +942,33 @@ SdsError sds_init(const SdsConfig* config);
  */
 void sds_loop(void);
 
+/**
+ * @brief Get the time until sds_loop() next has scheduled work.
+ * 
+ * Reports the nearest pending deadline: a table sync (change detection and
+ * liveness heartbeat), a device eviction grace period, or, while
+ * disconnected, the next reconnect attempt. Lets the application sleep
+ * exactly that long instead of polling.
+ * 
+ * @return Milliseconds until the next deadline, 0 if work is due now,
+ *         or UINT32_MAX if nothing is scheduled (or not initialized)
+ * 
+ * @note Incoming MQTT messages are only dispatched from sds_loop(), so cap
+ *       the sleep at your acceptable message latency.
+ * 
+ * Example:
+ * @code
+ * for (;;) {
+ *     sds_loop();
+ *     uint32_t wait = sds_next_deadline_ms();
+ *     sleep_ms(wait < 50 ? wait : 50);
+ * }
+ * @endcode
+ * 
+ * @see sds_loop
+ */
+uint32_t sds_next_deadline_ms(void);
+
 /**
  * @brief Shutdown SDS and disconnect from MQTT broker.
  * 
@@ -563,17 +1069,25 @@ typedef void (*SdsRawMessageCallback)(
  * sds_subscribe_raw("log/+", on_log, NULL);
  * @endcode
  * 
+ * Patterns are indexed by a topic trie, so matching a message costs one
+ * lookup per topic level however many patterns are subscribed. A message
+ * matching several patterns is delivered once per pattern. As in MQTT,
+ * "a/#" also matches "a", and a leading wildcard does not match topics
+ * starting with '$'. Callbacks may subscribe and unsubscribe.
+ * 
  * @param topic MQTT topic pattern (supports + and # wildcards)
  * @param callback Function to call when message arrives
  * @param user_data User context passed to callback
  * @return SDS_OK on success, error code otherwise
  *         - SDS_ERR_NOT_INITIALIZED: SDS not initialized
- *         - SDS_ERR_INVALID_CONFIG: Topic starts with "sds/" (reserved)
- *         - SDS_ERR_MAX_TABLES_REACHED: Too many raw subscriptions
+ *         - SDS_ERR_INVALID_CONFIG: Topic starts with "sds/" (reserved), or
+ *           a wildcard does not fill its level ("a+", "#/a")
+ *         - SDS_ERR_MAX_TABLES_REACHED: Subscription storage full
  *         - SDS_ERR_PLATFORM_ERROR: Subscribe failed
  * 
  * @note Topics starting with "sds/" are reserved and will be rejected.
- * @note Maximum of SDS_MAX_RAW_SUBSCRIPTIONS (8) concurrent subscriptions.
+ * @note The built-in storage holds SDS_MAX_RAW_SUBSCRIPTIONS (8)
+ *       subscriptions; supply more with sds_set_raw_subscription_storage().
  * 
  * @see sds_unsubscribe_raw, sds_publish_raw
  */
@@ -593,6 +1107,82 @@ SdsError sds_subscribe_raw(
  */
 SdsError sds_unsubscribe_raw(const char* topic);
 
+/**
+ * @brief Bytes of storage needed for a number of raw subscriptions.
+ * 
+ * Covers the subscriptions, SDS_RAW_TRIE_NODES_PER_SUB trie nodes for each
+ * and the trie's hash buckets.
+ * 
+ * @param max_subscriptions Subscription capacity (0 = SDS_MAX_RAW_SUBSCRIPTIONS)
+ * @return Size in bytes
+ */
+size_t sds_raw_subscription_storage_size(uint16_t max_subscriptions);
+
+/**
+ * @brief Hold raw subscriptions in caller memory.
+ * 
+ * Active subscriptions are moved into storage, which must hold at least
+ * sds_raw_subscription_storage_size(max_subscriptions) bytes and stay
+ * valid until it is replaced or sds_shutdown() (which returns to the
+ * built-in storage). Growing it when sds_subscribe_raw() reports
+ * SDS_ERR_MAX_TABLES_REACHED keeps every existing subscription.
+ * 
+ * @code{.c}
+ * static uint8_t raw_storage[32768];
+ * uint16_t n = 200;
+ * if (sds_raw_subscription_storage_size(n) <= sizeof(raw_storage)) {
+ *     sds_set_raw_subscription_storage(raw_storage, n);
+ * }
+ * @endcode
+ * 
+ * @param storage Memory for the subscriptions (NULL = built-in storage)
+ * @param max_subscriptions Subscription capacity of storage
+ * @return SDS_OK, SDS_ERR_NOT_INITIALIZED, or SDS_ERR_INVALID_CONFIG if
+ *         more subscriptions are active than fit, the capacity exceeds the
+ *         trie's 16-bit node index, or a raw callback is running
+ * 
+ * @see sds_subscribe_raw
+ */
+SdsError sds_set_raw_subscription_storage(void* storage, uint16_t max_subscriptions);
+
+/**
+ * @brief Publish a state or status message through the batch envelope.
+ * 
+ * For gateways and bridges that relay messages on behalf of other nodes:
+ * the message joins this node's sds/batch/{node_id} envelope next to its
+ * own table syncs, and owners apply it as if it had been published on
+ * topic. Without batching (SdsConfig.batch_max_bytes = 0) it is published
+ * on topic directly.
+ * 
+ * @code{.c}
+ * // Relay a leaf device's status, already serialized by the gateway
+ * sds_publish_batched("sds/SensorData/status/leaf_07", json, json_len);
+ * @endcode
+ * 
+ * @param topic "sds/{table_type}/state" or "sds/{table_type}/status/{node_id}"
+ * @param payload Message payload, JSON or binary wire format
+ * @param payload_len Length of payload in bytes
+ * @return SDS_OK on success, error code otherwise
+ *         - SDS_ERR_NOT_INITIALIZED: SDS not initialized
+ *         - SDS_ERR_INVALID_CONFIG: Not a state or status topic, or NULL payload
+ *         - SDS_ERR_BUFFER_FULL: Payload larger than SDS_MSG_BUFFER_SIZE, or
+ *           dropped by a full outbound queue
+ * 
+ * @see sds_flush_batch, SdsConfig
+ */
+SdsError sds_publish_batched(const char* topic, const void* payload, size_t payload_len);
+
+/**
+ * @brief Publish the pending batch envelope now.
+ * 
+ * Does nothing when the envelope is empty or batching is disabled.
+ * 
+ * @return SDS_OK, or SDS_ERR_NOT_INITIALIZED
+ * 
+ * @see sds_publish_batched
+ */
+SdsError sds_flush_batch(void);
+
 /**
  * @brief Get the node ID.
  * 
@@ -617,6 +1207,46 @@ const char* sds_get_node_id(void);
  */
 const SdsStats* sds_get_stats(void);
 
+/**
+ * @brief Copy one table's counters and histograms.
+ * 
+ * Taken under the table lock, so the copy is consistent even while ingest
+ * workers run. All zero unless SdsConfig.enable_instrumentation is set
+ * (propagation_ms: enable_latency_tracking).
+ * 
+ * @param table_type Registered table type
+ * @param out Receives the counters
+ * @return SDS_OK, SDS_ERR_NOT_INITIALIZED, SDS_ERR_INVALID_CONFIG (NULL
+ *         argument) or SDS_ERR_TABLE_NOT_FOUND
+ */
+SdsError sds_get_table_stats(const char* table_type, SdsTableStats* out);
+
+/**
+ * @brief Copy the sds_loop() stage histograms.
+ * 
+ * @param out Receives the histograms (all zero unless instrumentation is enabled)
+ */
+void sds_get_loop_stats(SdsLoopStats* out);
+
+/**
+ * @brief Reset counters, table stats and loop histograms to zero.
+ * 
+ * Gauges (outbound_queued, inbound_queued) keep their current values.
+ */
+void sds_reset_stats(void);
+
+/**
+ * @brief Latency below which a given share of a histogram's samples fall.
+ * 
+ * Resolved to bucket granularity: returns the upper edge of the bucket
+ * holding the percentile, capped at the largest sample.
+ * 
+ * @param h Histogram
+ * @param percent 0-100 (e.g. 50, 99)
+ * @return Latency in the histogram's unit, or 0 if it has no samples
+ */
+uint32_t sds_latency_percentile(const SdsLatencyHistogram* h, uint8_t percent);
+
 /** @} */ // end of init group
 
 /**
@@ -644,7 +1274,9 @@ const SdsStats* sds_get_stats(void);
  * @param table_type Name of table type (must match schema.sds)
  * @param role SDS_ROLE_OWNER or SDS_ROLE_DEVICE
  * @param options Optional parameters (NULL for defaults)
- * @return SDS_OK on success, error code otherwise
+ * @return SDS_OK on success, error code otherwise. A summary table whose
+ *         registry aggregates are rejected by sds_set_table_aggregates()
+ *         is not left registered; its error is returned.
  * 
  * @see sds_unregister_table, SdsRole, SdsTableOptions
  */
@@ -661,6 +1293,10 @@ SdsError sds_register_table(
  * This is the extended registration that provides automatic serialization.
  * The generated helper functions (sds_register_{table}_device/owner) call this.
  * 
+ * Any callback may be NULL when the section is described by field metadata
+ * (see sds_set_table_fields()); the core then serializes it directly from
+ * the SdsFieldMeta array.
+ * 
  * @param table Pointer to table structure
  * @param table_type Name of table type (must match schema)
  * @param role SDS_ROLE_OWNER or SDS_ROLE_DEVICE
@@ -695,6 +1331,56 @@ SdsError sds_register_table_ex(
     SdsDeserializeFunc deserialize_status
 );
 
+/**
+ * @brief Attach field metadata to a table registered with sds_register_table_ex().
+ * 
+ * Field descriptors enable delta sync and the binary wire format for
+ * tables that are not described by the generated registry, and stand in
+ * for NULL serialize/deserialize callbacks. Key fragments are prepared
+ * here, once. Pass NULL/0 for sections without metadata. The arrays
+ * (including field names) must outlive the registration.
+ * 
+ * @note Not needed with sds_register_table(); the registry provides them.
+ * 
+ * @param table_type Table type name
+ * @param config_fields Config field descriptors (or NULL)
+ * @param config_field_count Number of config fields
+ * @param state_fields State field descriptors (or NULL)
+ * @param state_field_count Number of state fields
+ * @param status_fields Status field descriptors (or NULL)
+ * @param status_field_count Number of status fields
+ * @return SDS_OK, SDS_ERR_NOT_INITIALIZED or SDS_ERR_TABLE_NOT_FOUND
+ * 
+ * @see sds_register_table_ex, SdsFieldMeta
+ */
+SdsError sds_set_table_fields(
+    const char* table_type,
+    const SdsFieldMeta* config_fields, uint8_t config_field_count,
+    const SdsFieldMeta* state_fields, uint8_t state_field_count,
+    const SdsFieldMeta* status_fields, uint8_t status_field_count
+);
+
+/**
+ * @brief Mark a field as changed on a table registered with dirty tracking.
+ * 
+ * With SdsTableOptions.dirty_tracking set, sds_loop() no longer compares
+ * sections against their shadow copies: a section is published only when
+ * fields were marked here, and delta sync sends exactly the marked fields.
+ * Generated tables provide {table}_set_{section}_{field}() setters that
+ * assign and mark in one call. Tables without dirty tracking ignore marks.
+ * 
+ * The first sync after registration sends every field.
+ * 
+ * @param table_type Table type name
+ * @param section Section containing the field
+ * @param field_idx Index into the section's SdsFieldMeta array, or SDS_ALL_FIELDS
+ * @return SDS_OK, SDS_ERR_NOT_INITIALIZED, SDS_ERR_TABLE_NOT_FOUND, or
+ *         SDS_ERR_INVALID_CONFIG (unknown section or field index)
+ * 
+ * @see SdsTableOptions
+ */
+SdsError sds_mark_dirty(const char* table_type, SdsSection section, uint8_t field_idx);
+
 /**
  * @brief Unregister a table.
  * 
@@ -711,10 +1397,41 @@ SdsError sds_unregister_table(const char* table_type);
 /**
  * @brief Get the number of registered tables.
  * 
- * @return Number of currently active tables (0 to SDS_MAX_TABLES)
+ * @return Number of currently active tables (0 to SdsConfig.max_tables)
  */
 uint8_t sds_get_table_count(void);
 
+/**
+ * @brief Lock a table against the ingest workers.
+ * 
+ * With SdsConfig.ingest_workers > 0, received messages are written into
+ * table sections and status slots from worker threads. Hold this lock
+ * while reading them (sds_find_node_status(), sds_foreach_node(), direct
+ * struct access) or changing the table's slot setup from another thread.
+ * Without workers it does nothing. Callbacks that run on a worker
+ * already hold the lock.
+ * 
+ * @code{.c}
+ * sds_lock_table("SensorData");
+ * sds_foreach_node(&owner_table, "SensorData", print_node, NULL);
+ * sds_unlock_table("SensorData");
+ * @endcode
+ * 
+ * @param table_type Table type name
+ * @return SDS_OK, SDS_ERR_NOT_INITIALIZED, or SDS_ERR_TABLE_NOT_FOUND
+ * 
+ * @see sds_unlock_table
+ */
+SdsError sds_lock_table(const char* table_type);
+
+/**
+ * @brief Release a lock taken with sds_lock_table().
+ * 
+ * @param table_type Table type name
+ * @return SDS_OK, SDS_ERR_NOT_INITIALIZED, or SDS_ERR_TABLE_NOT_FOUND
+ */
+SdsError sds_unlock_table(const char* table_type);
+
 /** @} */ // end of registration group
 
 /**
@@ -774,6 +1491,19 @@ void sds_on_status_update(const char* table_type, SdsStatusCallback callback, vo
  */
 void sds_on_error(SdsErrorCallback callback);
 
+/**
+ * @brief Set a callback that wakes the application when a message arrives.
+ * 
+ * Lets an event loop sleep until sds_next_deadline_ms() or the next
+ * message, instead of polling sds_loop(). Reset by sds_init().
+ * 
+ * @param callback Function to call after each received message (NULL to disable)
+ * @param user_data User context passed to callback
+ * 
+ * @see SdsWakeCallback, sds_next_deadline_ms
+ */
+void sds_on_wake(SdsWakeCallback callback, void* user_data);
+
 /**
  * @brief Set callback for schema version mismatch detection (owner role only).
  * 
@@ -871,6 +1601,534 @@ void sds_foreach_node(
     void* user_data
 );
 
+/**
+ * @brief Layout of a status snapshot. See sds_snapshot_status().
+ */
+typedef enum {
+    SDS_SNAPSHOT_ROWS = 0,      /**< One row per device: SdsSnapshotRow, then the status section */
+    SDS_SNAPSHOT_COLUMNS = 1    /**< One array per column (needs status field metadata) */
+} SdsSnapshotLayout;
+
+/**
+ * @brief Per-device header of a row snapshot.
+ * 
+ * Each row is this header followed by the device's status section at
+ * SDS_SNAPSHOT_STATUS_OFFSET. In a column snapshot these members are
+ * columns SDS_SNAPSHOT_COL_NODE_ID to SDS_SNAPSHOT_COL_EVICTION_PENDING.
+ */
+typedef struct {
+    char node_id[SDS_MAX_NODE_ID_LEN];
+    uint32_t last_seen_ms;
+    bool online;
+    bool eviction_pending;
+} SdsSnapshotRow;
+
+/** Offset of the status section within a snapshot row */
+#define SDS_SNAPSHOT_STATUS_OFFSET ((sizeof(SdsSnapshotRow) + 7) & ~(size_t)7)
+
+/** Column indices for sds_snapshot_column(); status field i is SDS_SNAPSHOT_COL_FIELDS + i */
+#define SDS_SNAPSHOT_COL_NODE_ID          0
+#define SDS_SNAPSHOT_COL_LAST_SEEN        1
+#define SDS_SNAPSHOT_COL_ONLINE           2
+#define SDS_SNAPSHOT_COL_EVICTION_PENDING 3
+#define SDS_SNAPSHOT_COL_FIELDS           4
+
+/**
+ * @brief Result of sds_snapshot_status().
+ */
+typedef struct {
+    uint32_t rows;      /**< Devices copied */
+    size_t row_size;    /**< SDS_SNAPSHOT_ROWS: bytes from one row to the next */
+} SdsSnapshotInfo;
+
+/**
+ * @brief Buffer size needed by sds_snapshot_status() (owner role only).
+ * 
+ * Covers every status slot of the table, so one buffer fits any snapshot
+ * of it until its slot layout changes.
+ * 
+ * @param table_type Table type name
+ * @param layout SDS_SNAPSHOT_ROWS or SDS_SNAPSHOT_COLUMNS
+ * @return Bytes needed, or 0 if the table has no status slots (or, for
+ *         columns, no status field metadata)
+ */
+size_t sds_snapshot_size(const char* table_type, SdsSnapshotLayout layout);
+
+/**
+ * @brief Copy every known device of an owner table into a buffer.
+ * 
+ * One pass over the status slots, under the table lock, so the copy is
+ * consistent even while ingest workers apply messages. Dashboards and
+ * analytics can then read it without a callback or lookup per device.
+ * 
+ * Rows are packed: row i starts at i * info.row_size and holds an
+ * SdsSnapshotRow followed by the status section. Columns are arrays sized
+ * for every slot of the table, each starting 8-byte aligned: node_id,
+ * last_seen_ms, online, eviction_pending, then each status field in field
+ * metadata order at its declared size. Use sds_snapshot_column() to find
+ * them; their first info.rows entries are valid.
+ * 
+ * @code{.c}
+ * static uint8_t buf[8192];
+ * SdsSnapshotInfo info;
+ * if (sds_snapshot_status(&owner_table, "SensorData", SDS_SNAPSHOT_COLUMNS,
+ *                         buf, sizeof(buf), &info) == SDS_OK) {
+ *     const uint8_t* battery = sds_snapshot_column(buf, "SensorData", SDS_SNAPSHOT_COL_FIELDS + 1);
+ *     for (uint32_t i = 0; i < info.rows; i++) total += battery[i];
+ * }
+ * @endcode
+ * 
+ * @param owner_table Pointer to owner table structure
+ * @param table_type Table type name
+ * @param layout SDS_SNAPSHOT_ROWS or SDS_SNAPSHOT_COLUMNS
+ * @param buffer Destination, at least sds_snapshot_size() bytes
+ * @param buffer_size Size of buffer in bytes
+ * @param info Receives the row count and row size (may be NULL)
+ * @return SDS_OK on success, error code otherwise
+ *         - SDS_ERR_INVALID_CONFIG: NULL argument
+ *         - SDS_ERR_TABLE_NOT_FOUND: Not a registered owner table
+ *         - SDS_ERR_INVALID_TABLE: No status slots, or columns without field metadata
+ *         - SDS_ERR_BUFFER_FULL: buffer_size below sds_snapshot_size()
+ * 
+ * @see sds_snapshot_size, sds_snapshot_column, sds_foreach_node
+ */
+SdsError sds_snapshot_status(
+    const void* owner_table,
+    const char* table_type,
+    SdsSnapshotLayout layout,
+    void* buffer,
+    size_t buffer_size,
+    SdsSnapshotInfo* info
+);
+
+/**
+ * @brief Find a column in a column snapshot.
+ * 
+ * @param buffer Buffer filled by sds_snapshot_status() with SDS_SNAPSHOT_COLUMNS
+ * @param table_type Table type name
+ * @param column SDS_SNAPSHOT_COL_* index
+ * @return Start of the column, or NULL if the table has no such column
+ */
+const void* sds_snapshot_column(const void* buffer, const char* table_type, uint16_t column);
+
+/*
+ * Lock-free device reads. The receive path writes status slots in place;
+ * every slot write is bracketed by a sequence counter (a seqlock), so a
+ * reader on any thread can copy a slot and retry if a write overlapped.
+ * Readers never block ingest and ingest never waits for readers. Without
+ * per-slot counters (sds_set_owner_slot_seqlocks()) one table-wide counter
+ * covers every slot, and a write to any device retries concurrent copies.
+ */
+
+/** Sequence counter storage for sds_set_owner_slot_seqlocks() */
+typedef uint32_t SdsSeqlock;
+
+/**
+ * @brief Supply per-slot sequence counters for an owner table.
+ * 
+ * With one counter per status slot, lock-free readers only retry when the
+ * device they copy was written. Call before readers start; slots at or
+ * beyond count share the table-wide counter. Pass NULL to return to it.
+ * 
+ * @param table_type Table type name
+ * @param counters Caller-owned array, 4-byte aligned (must outlive the registration)
+ * @param count Number of counters (normally the table's max slots)
+ * @return SDS_OK, SDS_ERR_TABLE_NOT_FOUND, or SDS_ERR_INVALID_CONFIG
+ */
+SdsError sds_set_owner_slot_seqlocks(
+    const char* table_type,
+    SdsSeqlock* counters,
+    uint32_t count
+);
+
+/**
+ * @brief Copy one device's status and slot metadata without locking.
+ * 
+ * @code{.c}
+ * SensorDataStatus st;
+ * SdsSnapshotRow node;
+ * if (sds_read_node_status(&owner_table, "SensorData", "sensor_01",
+ *                          &st, sizeof(st), &node) && node.online) {
+ *     printf("battery %u\n", st.battery_percent);
+ * }
+ * @endcode
+ * 
+ * @param owner_table Pointer to owner table structure
+ * @param table_type Table type name
+ * @param node_id Node ID to read
+ * @param status_out Receives up to status_size bytes of the status section (may be NULL)
+ * @param status_size Size of status_out in bytes
+ * @param node_out Receives node_id, last_seen_ms, online and eviction_pending (may be NULL)
+ * @return true if the device is known and the copy is consistent
+ * 
+ * @see sds_find_node_status, sds_foreach_node_copy
+ */
+bool sds_read_node_status(
+    const void* owner_table,
+    const char* table_type,
+    const char* node_id,
+    void* status_out,
+    size_t status_size,
+    SdsSnapshotRow* node_out
+);
+
+/**
+ * @brief Callback for sds_foreach_node_copy().
+ * 
+ * @param node Slot metadata of the device
+ * @param status Consistent copy of its status section (valid during the call)
+ * @param user_data User-provided context
+ */
+typedef void (*SdsNodeCopyIterator)(const SdsSnapshotRow* node, const void* status, void* user_data);
+
+/**
+ * @brief Iterate over consistent copies of every known device, without locking.
+ * 
+ * Like sds_foreach_node(), but each callback gets a private copy taken
+ * under the slot's seqlock instead of a pointer into the live slot.
+ * 
+ * @param owner_table Pointer to owner table structure
+ * @param table_type Table type name
+ * @param callback Function called once per device
+ * @param user_data Passed to callback
+ * @return Number of devices visited
+ * 
+ * @see sds_foreach_node, sds_read_node_status
+ */
+uint32_t sds_foreach_node_copy(
+    const void* owner_table,
+    const char* table_type,
+    SdsNodeCopyIterator callback,
+    void* user_data
+);
+
+/*
+ * Shared-memory export. An owner can place a table's status slots in a
+ * named shared-memory segment, so other processes on the host read the
+ * fleet from one ingest pipeline instead of each subscribing themselves.
+ * The segment is self-describing:
+ *
+ *   SdsShmHeader | SdsShmField[field_count] | SdsSeqlock[max_slots] | slots
+ *
+ * The slots keep the owner's StatusSlot layout; every slot has its own
+ * seqlock, so attached readers copy devices exactly like
+ * sds_read_node_status() does in process.
+ */
+
+#define SDS_SHM_MAGIC   0x4D534453u    /**< "SDSM" */
+#define SDS_SHM_VERSION 1
+#define SDS_SHM_FIELD_NAME_LEN 32
+
+/** SdsShmHeader.state */
+#define SDS_SHM_LIVE    1u             /**< The owner is writing the segment */
+#define SDS_SHM_CLOSED  2u             /**< The owner unexported the table or shut down */
+
+/** Status field descriptor in an exported segment (from SdsTableMeta) */
+typedef struct {
+    char name[SDS_SHM_FIELD_NAME_LEN];
+    uint8_t type;                      /**< SdsFieldType */
+    uint8_t reserved;
+    uint16_t offset;                   /**< Offset within the status section */
+    uint16_t size;                     /**< Size in bytes */
+    uint16_t reserved2;
+} SdsShmField;
+
+/** Header at the start of an exported segment; offsets are from the segment start */
+typedef struct {
+    uint32_t magic;                    /**< SDS_SHM_MAGIC */
+    uint16_t version;                  /**< SDS_SHM_VERSION */
+    uint16_t header_size;              /**< sizeof(SdsShmHeader) */
+    uint32_t segment_size;
+    uint32_t state;                    /**< SDS_SHM_LIVE or SDS_SHM_CLOSED */
+    uint32_t clock_ms;                 /**< Owner clock (last_seen_ms base), refreshed by sds_loop() */
+    char table_type[SDS_MAX_TABLE_TYPE_LEN];
+    char schema_version[32];
+    char owner_node_id[SDS_MAX_NODE_ID_LEN];
+    uint32_t max_slots;
+    uint32_t slot_size;
+    uint32_t slot_valid_offset;
+    uint32_t slot_online_offset;       /**< 0 = not tracked */
+    uint32_t slot_last_seen_offset;    /**< 0 = not tracked */
+    uint32_t slot_eviction_pending_offset; /**< 0 = not tracked */
+    uint32_t slot_status_offset;
+    uint32_t status_size;              /**< Bytes from slot_status_offset to the slot end */
+    uint32_t field_count;
+    uint32_t fields_offset;            /**< SdsShmField[field_count] */
+    uint32_t seqlocks_offset;          /**< SdsSeqlock[max_slots] */
+    uint32_t slots_offset;             /**< max_slots * slot_size bytes */
+} SdsShmHeader;
+
+/**
+ * @brief Move an owner table's status slots into a named shared-memory segment.
+ * 
+ * The table must use external slot storage (@slot_storage = external, or
+ * sds_set_owner_status_slots_wide() with SDS_SLOTS_EXTERNAL) and have status
+ * field metadata. Known devices are copied into the segment and the table's
+ * slot pointer is pointed at it; ingest then writes the segment directly.
+ * sds_unexport_owner_table(), sds_unregister_table() and sds_shutdown()
+ * copy the slots back, mark the segment closed and remove its name.
+ * 
+ * @code{.c}
+ * sds_export_owner_table("SensorData", "/sds.SensorData");
+ * @endcode
+ * 
+ * @param table_type Table type name
+ * @param name Segment name: one leading '/', no other '/' (macOS allows 31 characters)
+ * @return SDS_OK, SDS_ERR_TABLE_NOT_FOUND, SDS_ERR_INVALID_TABLE (inline slots
+ *         or no status fields), SDS_ERR_INVALID_CONFIG (bad name), or
+ *         SDS_ERR_PLATFORM_ERROR (the segment could not be created)
+ */
+SdsError sds_export_owner_table(const char* table_type, const char* name);
+
+/**
+ * @brief Stop exporting a table started with sds_export_owner_table().
+ * 
+ * @param table_type Table type name
+ * @return SDS_OK, or SDS_ERR_TABLE_NOT_FOUND if the table is not exported
+ */
+SdsError sds_unexport_owner_table(const char* table_type);
+
+/** Read-only view of an exported segment (sds_shared_table_attach()) */
+typedef struct {
+    const SdsShmHeader* header;        /**< NULL when not attached */
+    const SdsShmField* fields;
+    const uint8_t* slots;
+    size_t size;
+} SdsSharedTable;
+
+/**
+ * @brief Attach to a segment exported by an owner process, read-only.
+ * 
+ * Does not need sds_init(). The header is validated (magic, version and
+ * that every region lies inside the segment) before it is used.
+ * 
+ * @param name Segment name passed to sds_export_owner_table()
+ * @param table Receives the view
+ * @return SDS_OK, SDS_ERR_TABLE_NOT_FOUND (no such segment), or
+ *         SDS_ERR_INVALID_TABLE (not an SDS segment of this version)
+ */
+SdsError sds_shared_table_attach(const char* name, SdsSharedTable* table);
+
+/**
+ * @brief Detach a view from sds_shared_table_attach().
+ */
+void sds_shared_table_detach(SdsSharedTable* table);
+
+/**
+ * @brief Copy one device from an attached segment.
+ * 
+ * @param table Attached view
+ * @param node_id Node ID to read
+ * @param status_out Receives up to status_size bytes of the status section (may be NULL)
+ * @param status_size Size of status_out in bytes
+ * @param node_out Receives the slot metadata (may be NULL)
+ * @return true if the device is known and the copy is consistent
+ */
+bool sds_shared_table_read(
+    const SdsSharedTable* table,
+    const char* node_id,
+    void* status_out,
+    size_t status_size,
+    SdsSnapshotRow* node_out
+);
+
+/**
+ * @brief Visit consistent copies of every device in an attached segment.
+ * 
+ * @return Number of devices visited
+ */
+uint32_t sds_shared_table_foreach(
+    const SdsSharedTable* table,
+    SdsNodeCopyIterator callback,
+    void* user_data
+);
+
+/*
+ * Status history. With history storage attached, an owner keeps the last
+ * `depth` status messages of every slot in a ring: the owner time the
+ * message was applied and a copy of the status section. Storage is
+ * caller-owned and sized up front, so memory use is fixed and ingest
+ * never allocates. A device taking a free slot starts an empty ring;
+ * going offline keeps it.
+ */
+
+/** Bytes per history sample: timestamp plus the status section, 4-byte aligned */
+#define SDS_STATUS_HISTORY_ENTRY_BYTES(status_size) \
+    (4 + (((size_t)(status_size) + 3) & ~(size_t)3))
+
+/** History storage for `slots` status slots of `depth` samples each */
+#define SDS_STATUS_HISTORY_BYTES(status_size, slots, depth) \
+    ((size_t)(slots) * (4 + (size_t)(depth) * SDS_STATUS_HISTORY_ENTRY_BYTES(status_size)))
+
+/** Column indices for sds_status_history_column(); status field i is SDS_HISTORY_COL_FIELDS + i */
+#define SDS_HISTORY_COL_TIMESTAMP 0
+#define SDS_HISTORY_COL_FIELDS    1
+
+/**
+ * @brief Iterator callback for sds_foreach_status_sample().
+ * 
+ * @param timestamp_ms Owner time (sds_platform_millis) the status was applied
+ * @param status The status section as it was then
+ * @param user_data User-provided context
+ */
+typedef void (*SdsStatusSampleIterator)(uint32_t timestamp_ms, const void* status, void* user_data);
+
+/**
+ * @brief History storage needed by an owner table (registered, with status slots).
+ * 
+ * @param table_type Table type name
+ * @param depth Samples kept per device
+ * @return Bytes needed, or 0 if the table has no status slots or depth is 0
+ */
+size_t sds_status_history_size(const char* table_type, uint16_t depth);
+
+/**
+ * @brief Attach status history storage to an owner table.
+ * 
+ * Generated tables with `@history = N` attach storage embedded in the owner
+ * table at registration. Storage is cleared here and must be 4-byte
+ * aligned and outlive the registration; reconfiguring the status slots
+ * detaches it. Pass NULL to stop recording.
+ * 
+ * @code{.c}
+ * static uint32_t history[SDS_STATUS_HISTORY_BYTES(sizeof(SensorDataStatus), 16, 60) / 4];
+ * sds_set_owner_status_history("SensorData", history, sizeof(history), 60);
+ * @endcode
+ * 
+ * @param table_type Table type name
+ * @param storage History storage, or NULL
+ * @param storage_size Size of storage in bytes
+ * @param depth Samples kept per device
+ * @return SDS_OK on success, error code otherwise
+ *         - SDS_ERR_TABLE_NOT_FOUND: Not a registered owner table
+ *         - SDS_ERR_INVALID_CONFIG: No status slots, depth 0, or misaligned storage
+ *         - SDS_ERR_BUFFER_FULL: storage_size below sds_status_history_size()
+ */
+SdsError sds_set_owner_status_history(const char* table_type, void* storage,
+                                      size_t storage_size, uint16_t depth);
+
+/**
+ * @brief Visit a device's status history, oldest first.
+ * 
+ * Runs under the table lock: the callback must not block or call into
+ * SDS for this table.
+ * 
+ * @param table_type Table type name
+ * @param node_id Device node ID
+ * @param max_age_ms Only samples at most this old (0 = all)
+ * @param callback Called for each sample
+ * @param user_data Passed to the callback
+ * @return Number of samples visited (0 if the device or history is unknown)
+ */
+uint32_t sds_foreach_status_sample(const char* table_type, const char* node_id, uint32_t max_age_ms,
+                                   SdsStatusSampleIterator callback, void* user_data);
+
+/**
+ * @brief Buffer size needed by sds_status_history_columns().
+ * 
+ * @param table_type Table type name
+ * @return Bytes for a full ring, or 0 without history or status field metadata
+ */
+size_t sds_status_history_columns_size(const char* table_type);
+
+/**
+ * @brief Copy a device's status history into columns, oldest first.
+ * 
+ * Like a column snapshot: one array of timestamps, then one per status
+ * field at its declared size, each 8-byte aligned and sized for the full
+ * ring. Use sds_status_history_column() to find them; their first
+ * *count entries are valid.
+ * 
+ * @param table_type Table type name
+ * @param node_id Device node ID
+ * @param max_age_ms Only samples at most this old (0 = all)
+ * @param buffer Destination, at least sds_status_history_columns_size() bytes
+ * @param buffer_size Size of buffer in bytes
+ * @param count Receives the number of samples (0 for an unknown device)
+ * @return SDS_OK on success, error code otherwise
+ *         - SDS_ERR_INVALID_CONFIG: NULL argument
+ *         - SDS_ERR_TABLE_NOT_FOUND: Not a registered owner table
+ *         - SDS_ERR_INVALID_TABLE: No history storage or status field metadata
+ *         - SDS_ERR_BUFFER_FULL: buffer_size below sds_status_history_columns_size()
+ */
+SdsError sds_status_history_columns(const char* table_type, const char* node_id, uint32_t max_age_ms,
+                                    void* buffer, size_t buffer_size, uint32_t* count);
+
+/**
+ * @brief Find a column in a history buffer.
+ * 
+ * @param buffer Buffer filled by sds_status_history_columns()
+ * @param table_type Table type name
+ * @param column SDS_HISTORY_COL_* index
+ * @return Start of the column, or NULL if the table has no such column
+ */
+const void* sds_status_history_column(const void* buffer, const char* table_type, uint16_t column);
+
+/*
+ * Aggregates. A bridge node owns a source table and registers a summary
+ * table as a device; the summary's fields are reductions of the source's
+ * status slots (devices counted, min/max/sum/mean or a percentile of a
+ * status field), so an upstream owner follows one summary per site
+ * instead of every device. Counts, sums and extremes are kept up to date
+ * as status messages, LWTs and evictions change the slots; the summary is
+ * written just before each of its syncs and published like any device
+ * table, on its own interval. Value aggregates cover online devices.
+ */
+
+/** Bytes of aggregate state per aggregate */
+#define SDS_AGGREGATE_STATE_BYTES 64
+
+/** Aggregate storage for `aggregates` aggregates; with a percentile, scratch for `slots` source slots */
+#define SDS_AGGREGATE_BYTES(aggregates, slots) \
+    ((size_t)(aggregates) * SDS_AGGREGATE_STATE_BYTES + (size_t)(slots) * sizeof(double))
+
+/**
+ * @brief Aggregate storage needed by a summary table.
+ *
+ * @param source_type Source table type (registered, for percentiles)
+ * @param aggregates Aggregate descriptors
+ * @param count Number of aggregates
+ * @return Bytes needed, or 0 if a percentile is requested and the source is not a registered owner
+ */
+size_t sds_aggregate_storage_size(const char* source_type, const SdsAggregateMeta* aggregates, uint8_t count);
+
+/**
+ * @brief Compute a device table's fields from an owner table's status slots.
+ *
+ * Generated tables with `@source = Table` attach storage embedded in the
+ * device table at registration. Targets are state or status fields of
+ * the summary (numeric, with field metadata registered); sources are
+ * numeric status fields of the source. The source may be registered
+ * before or after the summary and is linked once it has status slots;
+ * until then the summary fields are left alone. A source feeds at most
+ * one summary. Storage is cleared here and must be 8-byte aligned and
+ * outlive the registration. Pass NULL aggregates to stop.
+ *
+ * @code{.c}
+ * static const SdsAggregateMeta aggs[] = {
+ *     { "online_count", SDS_AGG_COUNT_ONLINE, NULL, 0 },
+ *     { "temp_max", SDS_AGG_MAX, "temperature", 0 },
+ * };
+ * static uint64_t storage[SDS_AGGREGATE_BYTES(2, 0) / 8];
+ * sds_set_table_aggregates("SiteSummary", "SensorData", aggs, 2, storage, sizeof(storage));
+ * @endcode
+ *
+ * @param summary_type Summary table type (registered as device)
+ * @param source_type Source table type
+ * @param aggregates Aggregate descriptors, or NULL
+ * @param count Number of aggregates
+ * @param storage Aggregate storage
+ * @param storage_size Size of storage in bytes
+ * @return SDS_OK on success, error code otherwise
+ *         - SDS_ERR_TABLE_NOT_FOUND: Not a registered device table
+ *         - SDS_ERR_INVALID_CONFIG: Unknown or non-numeric field, bad percentile,
+ *           misaligned storage, or the source already feeds another summary
+ *         - SDS_ERR_BUFFER_FULL: storage_size below sds_aggregate_storage_size()
+ */
+SdsError sds_set_table_aggregates(const char* summary_type, const char* source_type,
+                                  const SdsAggregateMeta* aggregates, uint8_t count,
+                                  void* storage, size_t storage_size);
+
 /**
  * @brief Configure status slot metadata for manual table registration.
  * 
@@ -894,7 +2152,119 @@ void sds_set_owner_status_slots(
     size_t slot_size,
     size_t slot_status_offset,
     size_t count_offset,
-    uint8_t max_slots
+    uint32_t max_slots
+);
+
+/**
+ * @brief Where an owner table keeps its status slot array.
+ */
+typedef enum {
+    SDS_SLOTS_INLINE = 0,   /**< Array embedded in the owner table (slots_offset = offsetof array) */
+    SDS_SLOTS_EXTERNAL = 1  /**< Owner table holds a pointer to a caller-allocated array */
+} SdsSlotStorage;
+
+/**
+ * @brief Configure status slots with a wide count and optional external storage.
+ * 
+ * Use this for owners tracking more than 255 devices. With SDS_SLOTS_EXTERNAL
+ * the owner table holds a `StatusSlot*` at slots_offset, so large slot arrays
+ * can live on the heap (or in PSRAM) instead of a giant static table struct.
+ * The pointer must be set before this call (and before sds_register_table()
+ * for generated tables); it is not re-read for index maintenance until the
+ * slot layout is configured again.
+ * 
+ * @code{.c}
+ * typedef struct {
+ *     SensorDataConfig config;
+ *     SensorDataState state;
+ *     SensorDataStatusSlot* status_slots;
+ *     uint16_t status_count;
+ * } BigOwnerTable;
+ * 
+ * table.status_slots = calloc(5000, sizeof(SensorDataStatusSlot));
+ * sds_set_owner_status_slots_wide("SensorData", SDS_SLOTS_EXTERNAL,
+ *     offsetof(BigOwnerTable, status_slots), sizeof(SensorDataStatusSlot),
+ *     offsetof(SensorDataStatusSlot, status),
+ *     offsetof(BigOwnerTable, status_count), sizeof(uint16_t), 5000);
+ * @endcode
+ * 
+ * @param table_type Table type name
+ * @param storage SDS_SLOTS_INLINE or SDS_SLOTS_EXTERNAL
+ * @param slots_offset offsetof(OwnerTable, status_slots) (array or pointer)
+ * @param slot_size sizeof(StatusSlot)
+ * @param slot_status_offset offsetof(StatusSlot, status)
+ * @param count_offset offsetof(OwnerTable, status_count), or 0 for none
+ * @param count_size sizeof(OwnerTable.status_count): 1, 2 or 4
+ * @param max_slots Number of slots in the array
+ * @return SDS_OK, SDS_ERR_TABLE_NOT_FOUND, or SDS_ERR_INVALID_CONFIG
+ * 
+ * @see sds_set_owner_slot_index
+ */
+SdsError sds_set_owner_status_slots_wide(
+    const char* table_type,
+    SdsSlotStorage storage,
+    size_t slots_offset,
+    size_t slot_size,
+    size_t slot_status_offset,
+    size_t count_offset,
+    uint8_t count_size,
+    uint32_t max_slots
+);
+
+/**
+ * @brief Supply hash index buckets for a large owner table.
+ * 
+ * The built-in index (SDS_SLOT_INDEX_SIZE buckets) only covers small tables.
+ * For larger tables provide bucket storage of at least 4/3 x max_slots
+ * entries, rounded up to a power of two. The index is rebuilt immediately.
+ * Pass NULL to return to the built-in index.
+ * 
+ * @param table_type Table type name
+ * @param buckets Caller-owned bucket array (must outlive the registration)
+ * @param bucket_count Number of buckets (power of two)
+ * @return SDS_OK, SDS_ERR_TABLE_NOT_FOUND, or SDS_ERR_INVALID_CONFIG
+ */
+SdsError sds_set_owner_slot_index(
+    const char* table_type,
+    uint32_t* buckets,
+    uint32_t bucket_count
+);
+
+/**
+ * @brief Supply per-device latency records for an owner table.
+ * 
+ * With SdsConfig.enable_latency_tracking, record i follows status slot i:
+ * its clock offset estimate and latest publish-to-apply latency. Records
+ * are reset when a device takes a slot or goes offline (LWT). Slots at or
+ * beyond count are not tracked. Pass NULL to stop tracking.
+ * 
+ * @param table_type Table type name
+ * @param nodes Caller-owned records (must outlive the registration)
+ * @param count Number of records, normally the table's max slots
+ * @return SDS_OK or SDS_ERR_TABLE_NOT_FOUND
+ * 
+ * @see sds_get_node_latency
+ */
+SdsError sds_set_owner_latency_slots(
+    const char* table_type,
+    SdsNodeLatency* nodes,
+    uint32_t count
+);
+
+/**
+ * @brief Copy one device's latency record.
+ * 
+ * Taken under the table lock.
+ * 
+ * @param table_type Owner table type
+ * @param node_id Device node ID
+ * @param out Receives the record
+ * @return true if the device has a slot with a latency record
+ */
+bool sds_get_node_latency(
+    const char* table_type,
+    const char* node_id,
+    SdsNodeLatency* out
 );
 
 /**
@@ -958,6 +2328,25 @@ void sds_set_owner_eviction_offsets(
     size_t eviction_deadline_offset
 );
 
+/**
+ * @brief Configure the status sequence slot offset for an owner table.
+ *
+ * Each slot keeps the sequence number of the last status message applied
+ * from its device (a uint32_t, 0 until a keyframe arrives). With it, a gap
+ * in a device's delta stream triggers a resync request. Generated tables
+ * set it from the registry.
+ *
+ * @code{.c}
+ * sds_set_owner_seq_offset("SensorData", offsetof(SensorDataStatusSlot, status_seq));
+ * @endcode
+ *
+ * @param table_type Table type name
+ * @param seq_offset offsetof(StatusSlot, status_seq), or 0 to turn gap detection off
+ *
+ * @see SdsConfig::enable_delta_sync
+ */
+void sds_set_owner_seq_offset(const char* table_type, size_t seq_offset);
+
 /**
  * @brief Check if a device is currently online (owner role only).
  * 
@@ -976,7 +2365,9 @@ void sds_set_owner_eviction_offsets(
  * @param owner_table Pointer to owner table structure
  * @param table_type Table type name
  * @param node_id Device node ID to check
- * @param timeout_ms Liveness timeout (typically 1.5x the liveness interval)
+ * @param timeout_ms Liveness timeout (typically 1.5x the liveness interval;
+ *                   0 = 1.5x the liveness interval, or of the gap this
+ *                   device advertised when that is wider)
  * @return true if device is online
  * 
  * @see sds_get_liveness_interval
@@ -994,6 +2385,10 @@ bool sds_is_device_online(
  * Returns the liveness interval (from \@liveness in schema) for the given table.
  * This is useful for calculating timeout values for sds_is_device_online().
  * 
+ * Adaptive liveness (SdsTableOptions.liveness_max_ms) widens it: a device
+ * returns its own liveness_max_ms, an owner the largest one advertised by
+ * the devices now in its status slots.
+ * 
  * @param table_type Table type name
  * @return Liveness interval in milliseconds, or 0 if not found
  * 
@@ -1040,6 +2435,36 @@ uint32_t sds_get_eviction_grace(const char* table_type);
  */
 void sds_on_device_evicted(const char* table_type, SdsDeviceEvictedCallback callback, void* user_data);
 
+/**
+ * @brief Get the cluster member that tracks a device.
+ * 
+ * Rendezvous hashing of node_id over SdsConfig.cluster_members: every
+ * member computes the same answer, and adding or removing a member moves
+ * only the devices that it gains or loses.
+ * 
+ * @param node_id Device node ID
+ * @return Member index, or 0 when partitioning is off
+ * 
+ * @see SdsConfig::cluster_members, sds_set_cluster_membership
+ */
+uint8_t sds_cluster_member_for(const char* node_id);
+
+/**
+ * @brief Change the cluster size or this member's index at runtime.
+ * 
+ * Devices that now belong to another member are evicted from every owner
+ * table (the eviction callback runs for each), and later messages for them
+ * are dropped. Devices gained from another member are picked up from their
+ * next status message. Not available with SdsConfig.cluster_group.
+ * 
+ * @param members Cluster size (0 or 1 = track every device)
+ * @param member This member's index (below members)
+ * @return SDS_OK, SDS_ERR_NOT_INITIALIZED, or SDS_ERR_INVALID_CONFIG
+ * 
+ * @see sds_cluster_member_for
+ */
+SdsError sds_set_cluster_membership(uint8_t members, uint8_t member);
+
 /** @} */ // end of owner_helpers group
 
 #ifdef __cplusplus
@@ -1125,6 +2550,9 @@ public:
     /** @brief Process SDS events. Call in loop(). */
     void loop() { sds_loop(); }
     
+    /** @brief Milliseconds until loop() next has scheduled work. */
+    uint32_t nextDeadlineMs() { return sds_next_deadline_ms(); }
+    
     /** @brief Shutdown SDS and disconnect. */
     void end() { sds_shutdown(); }
     
@@ -1137,6 +2565,22 @@ public:
     /** @brief Get runtime statistics. */
     const SdsStats* getStats() { return sds_get_stats(); }
     
+    /** @brief Copy one table's counters and histograms (instrumentation only). */
+    SdsError getTableStats(const char* table_type, SdsTableStats* out) {
+        return sds_get_table_stats(table_type, out);
+    }
+    
+    /** @brief Copy the sds_loop() stage histograms (instrumentation only). */
+    void getLoopStats(SdsLoopStats* out) { sds_get_loop_stats(out); }
+    
+    /** @brief Reset statistics to zero. */
+    void resetStats() { sds_reset_stats(); }
+    
+    /** @brief Latency in the histogram's unit below which percent of samples fall. */
+    static uint32_t latencyPercentile(const SdsLatencyHistogram* h, uint8_t percent) {
+        return sds_latency_percentile(h, percent);
+    }
+    
     /** @brief Convert error code to string. */
     static const char* errorString(SdsError err) {
         return sds_error_string(err);
@@ -32,13 +32,40 @@ void sds_json_writer_init(SdsJsonWriter* w, char* buffer, size_t size);
 void sds_json_start_object(SdsJsonWriter* w);
 void sds_json_end_object(SdsJsonWriter* w);
 
+/*
+ * Floats are written in the shortest form that reads back as the same
+ * float ("23.5", "0.1", "1.5e-7"). The _fixed variants round to at most
+ * `decimals` places (up to SDS_JSON_MAX_DECIMALS) and drop trailing
+ * zeros. NaN and infinities are written as null.
+ */
+#define SDS_JSON_MAX_DECIMALS 9
+
 /* Add fields */
 void sds_json_add_string(SdsJsonWriter* w, const char* key, const char* value);
 void sds_json_add_int(SdsJsonWriter* w, const char* key, int32_t value);
 void sds_json_add_uint(SdsJsonWriter* w, const char* key, uint32_t value);
 void sds_json_add_float(SdsJsonWriter* w, const char* key, float value);
+void sds_json_add_float_fixed(SdsJsonWriter* w, const char* key, float value, uint8_t decimals);
 void sds_json_add_bool(SdsJsonWriter* w, const char* key, bool value);
 
+/*
+ * Pre-escaped keys (schema-driven serializers).
+ *
+ * sds_json_key_fragment() renders `"key":` once, with the key escaped, so
+ * hot paths can emit it with sds_json_add_key() and a sds_json_write_*()
+ * value instead of re-measuring and re-quoting the key on every message.
+ *
+ * @return Fragment length (excluding the NUL), or 0 if out_size is too small
+ */
+size_t sds_json_key_fragment(const char* key, char* out, size_t out_size);
+void sds_json_add_key(SdsJsonWriter* w, const char* fragment, size_t fragment_len);
+void sds_json_write_string(SdsJsonWriter* w, const char* value);
+void sds_json_write_int(SdsJsonWriter* w, int32_t value);
+void sds_json_write_uint(SdsJsonWriter* w, uint32_t value);
+void sds_json_write_float(SdsJsonWriter* w, float value);
+void sds_json_write_float_fixed(SdsJsonWriter* w, float value, uint8_t decimals);
+void sds_json_write_bool(SdsJsonWriter* w, bool value);
+
 /* Get result */
 const char* sds_json_get_string(SdsJsonWriter* w);
 size_t sds_json_get_length(SdsJsonWriter* w);
@@ -46,18 +73,88 @@ bool sds_json_has_error(SdsJsonWriter* w);
 
 /* ============== JSON Reader ============== */
 
+/*
+ * Span count the library's own indexed readers use (the inbound
+ * dispatcher). Objects with more keys are still readable; lookups that
+ * miss the index fall back to a linear scan.
+ */
+#ifndef SDS_JSON_MAX_INDEX_FIELDS
+#define SDS_JSON_MAX_INDEX_FIELDS 64
+#endif
+
+/* Key/value span of one top-level field (offsets into the JSON buffer) */
+typedef struct {
+    uint16_t key;           /* Offset of first key character (after quote) */
+    uint16_t key_len;       /* Key length in bytes */
+    uint16_t value;         /* Offset of first value character */
+} SdsJsonSpan;
+
+typedef enum {
+    SDS_JSON_INDEX_NONE = 0,    /* Not indexed: every lookup scans the payload */
+    SDS_JSON_INDEX_COMPLETE,    /* Every top-level key is in the index */
+    SDS_JSON_INDEX_TRUNCATED    /* Index full: misses fall back to a scan */
+} SdsJsonIndexState;
+
 typedef struct {
     const char* json;
     size_t len;
-    size_t pos;
+    size_t pos;             /* Indexed mode: next span to try (lookup hint) */
+    SdsJsonSpan* index;     /* Caller's spans (indexed mode only) */
+    uint16_t index_cap;
+    uint16_t index_count;
+    uint8_t index_state;    /* SdsJsonIndexState */
 } SdsJsonReader;
 
-/* Initialize a JSON reader */
+/* Initialize a JSON reader (linear scan per lookup) */
 void sds_json_reader_init(SdsJsonReader* r, const char* json, size_t len);
 
+/*
+ * Initialize a JSON reader and tokenize the top-level object once into
+ * spans (span_count entries, caller-owned, used until the reader is done).
+ *
+ * Subsequent sds_json_find_field / sds_json_get_*_field calls are served
+ * from the key/value index instead of rescanning the payload. Lookups in
+ * the order the fields appear in the payload are O(1). A key that appears
+ * more than once is indexed at its first occurrence, as a scan finds it.
+ * Malformed input or payloads over 64KB leave the reader in plain
+ * scanning mode.
+ *
+ * @return true if the payload was indexed
+ */
+bool sds_json_reader_init_indexed(SdsJsonReader* r, const char* json, size_t len,
+                                  SdsJsonSpan* spans, uint16_t span_count);
+
 /* Find a field value (returns pointer to value start, or NULL) */
 const char* sds_json_find_field(SdsJsonReader* r, const char* key);
 
+/* Same as sds_json_find_field() for a key of known length (as it appears in the payload) */
+const char* sds_json_find_field_n(SdsJsonReader* r, const char* key, size_t key_len);
+
+/* One top-level member of the object being read */
+typedef struct {
+    const char* key;        /* Key as it appears in the payload (not terminated) */
+    size_t key_len;
+    const char* value;      /* First value character */
+} SdsJsonMember;
+
+/* Cursor for sds_json_iter_next() */
+typedef struct {
+    SdsJsonReader* r;
+    uint16_t span;          /* Next index span */
+    const char* p;          /* Scan position past the index (NULL = not started) */
+} SdsJsonIter;
+
+/*
+ * Walk the top-level members in payload order, in one pass. Indexed
+ * readers are served from the index (and scanned past a truncated one);
+ * others are tokenized as the walk goes. Generated deserializers use this
+ * to dispatch each key once instead of looking fields up by name.
+ */
+void sds_json_iter_init(SdsJsonIter* it, SdsJsonReader* r);
+
+/* Next member; false at the end of the object or on malformed input */
+bool sds_json_iter_next(SdsJsonIter* it, SdsJsonMember* m);
+
 /* Parse values (call after find_field) */
 bool sds_json_parse_string(const char* value, char* out, size_t out_size);
 bool sds_json_parse_int(const char* value, int32_t* out);
@@ -65,6 +162,9 @@ bool sds_json_parse_uint(const char* value, uint32_t* out);
 bool sds_json_parse_float(const char* value, float* out);
 bool sds_json_parse_bool(const char* value, bool* out);
 
+/* Parse a string value returned by a find on r, bounded by the payload length */
+bool sds_json_parse_string_in(SdsJsonReader* r, const char* value, char* out, size_t out_size);
+
 /* Helper: get field value directly */
 bool sds_json_get_string_field(SdsJsonReader* r, const char* key, char* out, size_t out_size);
 bool sds_json_get_int_field(SdsJsonReader* r, const char* key, int32_t* out);
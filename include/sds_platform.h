@@ -118,6 +118,28 @@ bool sds_platform_mqtt_connect_with_auth(
     bool will_retain
 );
 
+/**
+ * Select the session kind for the following connects.
+ * 
+ * With persistent sessions the platform connects with cleansession=0, so
+ * the broker keeps the client's subscriptions across disconnects, and
+ * reuses its client object across reconnects. Called from sds_init()
+ * before the first connect. Default: clean sessions.
+ * 
+ * @param persistent true for cleansession=0
+ */
+void sds_platform_mqtt_set_persistent_session(bool persistent);
+
+/**
+ * Check whether the broker resumed a stored session on the last connect.
+ * 
+ * Reports the CONNACK session-present flag. Platforms whose MQTT client
+ * does not expose it return false, so subscriptions are always restored.
+ * 
+ * @return true if the subscriptions of the previous session still apply
+ */
+bool sds_platform_mqtt_session_present(void);
+
 /**
  * Disconnect from MQTT broker.
  */
@@ -154,6 +176,18 @@ bool sds_platform_mqtt_publish(
  */
 bool sds_platform_mqtt_subscribe(const char* topic);
 
+/**
+ * Subscribe to several topics in one SUBSCRIBE request.
+ * 
+ * Platforms whose MQTT client has no multi-topic subscribe send them one
+ * at a time.
+ * 
+ * @param topics Topic patterns
+ * @param count Number of topics
+ * @return true if every subscription was granted
+ */
+bool sds_platform_mqtt_subscribe_many(const char* const* topics, size_t count);
+
 /**
  * Unsubscribe from a topic.
  * 
@@ -176,6 +210,180 @@ void sds_platform_mqtt_loop(void);
  */
 void sds_platform_mqtt_set_callback(SdsMqttMessageCallback callback);
 
+/* ============== Outbound Sender ============== */
+
+/**
+ * Publishes queued outbound messages.
+ * Returns when the queue is empty or the connection is down.
+ */
+typedef void (*SdsOutboundDrainFunc)(void);
+
+/**
+ * Start an asynchronous sender for the outbound queue.
+ * Called from sds_init() when SdsConfig.outbound_queue_depth > 0.
+ *
+ * The platform runs drain on its own thread or task each time
+ * sds_platform_outbound_notify() is called. Platforms without one
+ * return false and sds_loop() drains the queue itself.
+ *
+ * @param drain Function that publishes queued messages
+ * @return true if a sender was started
+ */
+bool sds_platform_outbound_start(SdsOutboundDrainFunc drain);
+
+/**
+ * Wake the sender after messages were queued.
+ * Must not block on the network.
+ */
+void sds_platform_outbound_notify(void);
+
+/**
+ * Stop the sender.
+ * Returns once any drain in progress has finished.
+ */
+void sds_platform_outbound_stop(void);
+
+/**
+ * Lock the outbound queue against the sender.
+ * Held only around queue updates, never across a publish.
+ */
+void sds_platform_outbound_lock(void);
+
+/**
+ * Unlock the outbound queue.
+ */
+void sds_platform_outbound_unlock(void);
+
+/* ============== Ingest Workers ============== */
+
+/**
+ * Applies one queued inbound message.
+ * Safe to call from several threads at once.
+ *
+ * @return false if no table had a message ready for this worker
+ */
+typedef bool (*SdsIngestWorkFunc)(void);
+
+/**
+ * Start worker threads that apply queued inbound messages.
+ * Called from sds_init() when SdsConfig.inbound_queue_depth and
+ * SdsConfig.ingest_workers are both > 0.
+ *
+ * Each worker calls work until it returns false, then waits for
+ * sds_platform_ingest_notify(). Platforms without threads return false
+ * and sds_loop() applies the queue itself.
+ *
+ * @param work Function that applies one message
+ * @param workers Number of threads requested
+ * @return true if workers were started
+ */
+bool sds_platform_ingest_start(SdsIngestWorkFunc work, uint8_t workers);
+
+/**
+ * Wake a worker after a message was queued.
+ * Called from the MQTT receive callback; must not block.
+ */
+void sds_platform_ingest_notify(void);
+
+/**
+ * Stop the workers.
+ * Returns once every message in progress has been applied.
+ */
+void sds_platform_ingest_stop(void);
+
+/**
+ * Lock the inbound queue.
+ * Held only around queue updates, never while a message is applied.
+ */
+void sds_platform_ingest_lock(void);
+
+/**
+ * Unlock the inbound queue.
+ */
+void sds_platform_ingest_unlock(void);
+
+/**
+ * Lock one table against the workers and sds_loop().
+ * Only used while workers are running. Tables may share a lock, so it
+ * must be recursive.
+ *
+ * @param table Table index (0 to SdsConfig.max_tables - 1)
+ */
+void sds_platform_table_lock(uint8_t table);
+
+/**
+ * Unlock a table locked with sds_platform_table_lock().
+ *
+ * @param table Table index
+ */
+void sds_platform_table_unlock(uint8_t table);
+
+/* ============== Persistent Storage ============== */
+
+/**
+ * Load a record saved with sds_platform_storage_save().
+ * Only used with SdsConfig.enable_config_cache. Platforms without
+ * persistent storage return 0.
+ *
+ * @param key Record name ("{node_id}/{table_type}")
+ * @param buf Destination buffer
+ * @param size Size of buf in bytes
+ * @return Record length, or 0 if none is stored or it does not fit in buf
+ */
+size_t sds_platform_storage_load(const char* key, uint8_t* buf, size_t size);
+
+/**
+ * Save a record, replacing any previous one with the same key.
+ * The write should be atomic: after a power loss, load returns either the
+ * old record or the new one.
+ *
+ * @param key Record name
+ * @param data Record bytes
+ * @param len Length of data
+ * @return true if the record was stored
+ */
+bool sds_platform_storage_save(const char* key, const uint8_t* data, size_t len);
+
+/* ============== Shared Memory ============== */
+
+/**
+ * Create a named shared-memory segment and map it read-write.
+ * Only used by sds_export_owner_table(). A segment left behind under the
+ * same name is replaced. Platforms without shared memory return NULL.
+ *
+ * @param name Segment name ("/name", see sds_export_owner_table())
+ * @param size Segment size in bytes; the segment starts zero-filled
+ * @return Mapping of the whole segment, or NULL on failure
+ */
+void* sds_platform_shm_create(const char* name, size_t size);
+
+/**
+ * Unmap a segment from sds_platform_shm_create() and remove its name.
+ * Processes that still have it attached keep their mapping.
+ *
+ * @param name Segment name
+ * @param addr Mapping returned by sds_platform_shm_create()
+ * @param size Segment size in bytes
+ */
+void sds_platform_shm_remove(const char* name, void* addr, size_t size);
+
+/**
+ * Map an existing segment read-only (sds_shared_table_attach()).
+ *
+ * @param name Segment name
+ * @param size Receives the segment size in bytes
+ * @return Mapping of the whole segment, or NULL if there is none
+ */
+const void* sds_platform_shm_attach(const char* name, size_t* size);
+
+/**
+ * Unmap a segment from sds_platform_shm_attach().
+ *
+ * @param addr Mapping returned by sds_platform_shm_attach()
+ * @param size Segment size in bytes
+ */
+void sds_platform_shm_detach(const void* addr, size_t size);
+
 /* ============== Timing ============== */
 
 /**
@@ -185,6 +393,14 @@ void sds_platform_mqtt_set_callback(SdsMqttMessageCallback callback);
  */
 uint32_t sds_platform_millis(void);
 
+/**
+ * Get microseconds since startup.
+ * Only used for SdsConfig.enable_instrumentation latency histograms.
+ * 
+ * @return Microseconds (wraps at ~71 minutes)
+ */
+uint32_t sds_platform_micros(void);
+
 /**
  * Delay for specified milliseconds.
  * 
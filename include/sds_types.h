@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 #include "sds.h"
 #include "sds_json.h"
 
@@ -57,6 +58,7 @@ typedef struct {
     bool eviction_pending;   /* true if awaiting grace period after LWT */
     uint32_t last_seen_ms;   /* Timestamp of last received status */
     uint32_t eviction_deadline; /* When to evict if device doesn't return */
+    uint32_t status_seq;     /* Sequence of the last applied status (delta sync) */
     SensorDataStatus status;
 } SensorDataStatusSlot;
 
@@ -89,45 +91,139 @@ static void sensor_data_serialize_status(void* section, SdsJsonWriter* w) {
 
 static void sensor_data_deserialize_config(void* section, SdsJsonReader* r) {
     SensorDataConfig* cfg = (SensorDataConfig*)section;
-    sds_json_get_uint8_field(r, "command", &cfg->command);
-    sds_json_get_float_field(r, "threshold", &cfg->threshold);
+    SdsJsonIter it;
+    SdsJsonMember m;
+    sds_json_iter_init(&it, r);
+    while (sds_json_iter_next(&it, &m)) {
+        switch (m.key_len) {
+        case 7:
+            if (memcmp(m.key, "command", 7) == 0) {
+                uint32_t tmp;
+                if (sds_json_parse_uint(m.value, &tmp) && tmp <= UINT8_MAX) cfg->command = (uint8_t)tmp;
+            }
+            break;
+        case 9:
+            if (memcmp(m.key, "threshold", 9) == 0) {
+                sds_json_parse_float(m.value, &cfg->threshold);
+            }
+            break;
+        }
+    }
 }
 
 static void sensor_data_deserialize_state(void* section, SdsJsonReader* r) {
     SensorDataState* st = (SensorDataState*)section;
-    sds_json_get_float_field(r, "temperature", &st->temperature);
-    sds_json_get_float_field(r, "humidity", &st->humidity);
+    SdsJsonIter it;
+    SdsJsonMember m;
+    sds_json_iter_init(&it, r);
+    while (sds_json_iter_next(&it, &m)) {
+        switch (m.key_len) {
+        case 8:
+            if (memcmp(m.key, "humidity", 8) == 0) {
+                sds_json_parse_float(m.value, &st->humidity);
+            }
+            break;
+        case 11:
+            if (memcmp(m.key, "temperature", 11) == 0) {
+                sds_json_parse_float(m.value, &st->temperature);
+            }
+            break;
+        }
+    }
 }
 
 static void sensor_data_deserialize_status(void* section, SdsJsonReader* r) {
     SensorDataStatus* st = (SensorDataStatus*)section;
-    sds_json_get_uint8_field(r, "error_code", &st->error_code);
-    sds_json_get_uint8_field(r, "battery_percent", &st->battery_percent);
-    { uint32_t tmp; if (sds_json_get_uint_field(r, "uptime_seconds", &tmp)) st->uptime_seconds = tmp; }
+    SdsJsonIter it;
+    SdsJsonMember m;
+    sds_json_iter_init(&it, r);
+    while (sds_json_iter_next(&it, &m)) {
+        switch (m.key_len) {
+        case 10:
+            if (memcmp(m.key, "error_code", 10) == 0) {
+                uint32_t tmp;
+                if (sds_json_parse_uint(m.value, &tmp) && tmp <= UINT8_MAX) st->error_code = (uint8_t)tmp;
+            }
+            break;
+        case 14:
+            if (memcmp(m.key, "uptime_seconds", 14) == 0) {
+                uint32_t tmp;
+                if (sds_json_parse_uint(m.value, &tmp)) st->uptime_seconds = (uint32_t)tmp;
+            }
+            break;
+        case 15:
+            if (memcmp(m.key, "battery_percent", 15) == 0) {
+                uint32_t tmp;
+                if (sds_json_parse_uint(m.value, &tmp) && tmp <= UINT8_MAX) st->battery_percent = (uint8_t)tmp;
+            }
+            break;
+        }
+    }
 }
 
 /* Config field descriptors for delta sync */
 static const SdsFieldMeta SDS_SENSOR_DATA_CONFIG_FIELDS[] = {
-    { "command", SDS_FIELD_UINT8, offsetof(SensorDataConfig, command), sizeof(((SensorDataConfig*)0)->command) },
-    { "threshold", SDS_FIELD_FLOAT, offsetof(SensorDataConfig, threshold), sizeof(((SensorDataConfig*)0)->threshold) },
+    { .name = "command", .type = SDS_FIELD_UINT8, .offset = offsetof(SensorDataConfig, command), .size = sizeof(((SensorDataConfig*)0)->command) },
+    { .name = "threshold", .type = SDS_FIELD_FLOAT, .offset = offsetof(SensorDataConfig, threshold), .size = sizeof(((SensorDataConfig*)0)->threshold) },
 };
 #define SDS_SENSOR_DATA_CONFIG_FIELD_COUNT 2
 
 /* State field descriptors for delta sync */
 static const SdsFieldMeta SDS_SENSOR_DATA_STATE_FIELDS[] = {
-    { "temperature", SDS_FIELD_FLOAT, offsetof(SensorDataState, temperature), sizeof(((SensorDataState*)0)->temperature) },
-    { "humidity", SDS_FIELD_FLOAT, offsetof(SensorDataState, humidity), sizeof(((SensorDataState*)0)->humidity) },
+    { .name = "temperature", .type = SDS_FIELD_FLOAT, .offset = offsetof(SensorDataState, temperature), .size = sizeof(((SensorDataState*)0)->temperature) },
+    { .name = "humidity", .type = SDS_FIELD_FLOAT, .offset = offsetof(SensorDataState, humidity), .size = sizeof(((SensorDataState*)0)->humidity) },
 };
 #define SDS_SENSOR_DATA_STATE_FIELD_COUNT 2
 
 /* Status field descriptors for delta sync */
 static const SdsFieldMeta SDS_SENSOR_DATA_STATUS_FIELDS[] = {
-    { "error_code", SDS_FIELD_UINT8, offsetof(SensorDataStatus, error_code), sizeof(((SensorDataStatus*)0)->error_code) },
-    { "battery_percent", SDS_FIELD_UINT8, offsetof(SensorDataStatus, battery_percent), sizeof(((SensorDataStatus*)0)->battery_percent) },
-    { "uptime_seconds", SDS_FIELD_UINT32, offsetof(SensorDataStatus, uptime_seconds), sizeof(((SensorDataStatus*)0)->uptime_seconds) },
+    { .name = "error_code", .type = SDS_FIELD_UINT8, .offset = offsetof(SensorDataStatus, error_code), .size = sizeof(((SensorDataStatus*)0)->error_code) },
+    { .name = "battery_percent", .type = SDS_FIELD_UINT8, .offset = offsetof(SensorDataStatus, battery_percent), .size = sizeof(((SensorDataStatus*)0)->battery_percent) },
+    { .name = "uptime_seconds", .type = SDS_FIELD_UINT32, .offset = offsetof(SensorDataStatus, uptime_seconds), .size = sizeof(((SensorDataStatus*)0)->uptime_seconds) },
 };
 #define SDS_SENSOR_DATA_STATUS_FIELD_COUNT 3
 
+/* Config setters: assign and mark the field for dirty tracking */
+static inline void sensor_data_set_config_command(SensorDataConfig* s, uint8_t value) {
+    if (s->command == value) return;
+    s->command = value;
+    sds_mark_dirty("SensorData", SDS_SECTION_CONFIG, 0);
+}
+static inline void sensor_data_set_config_threshold(SensorDataConfig* s, float value) {
+    if (s->threshold == value) return;
+    s->threshold = value;
+    sds_mark_dirty("SensorData", SDS_SECTION_CONFIG, 1);
+}
+
+/* State setters: assign and mark the field for dirty tracking */
+static inline void sensor_data_set_state_temperature(SensorDataState* s, float value) {
+    if (s->temperature == value) return;
+    s->temperature = value;
+    sds_mark_dirty("SensorData", SDS_SECTION_STATE, 0);
+}
+static inline void sensor_data_set_state_humidity(SensorDataState* s, float value) {
+    if (s->humidity == value) return;
+    s->humidity = value;
+    sds_mark_dirty("SensorData", SDS_SECTION_STATE, 1);
+}
+
+/* Status setters: assign and mark the field for dirty tracking */
+static inline void sensor_data_set_status_error_code(SensorDataStatus* s, uint8_t value) {
+    if (s->error_code == value) return;
+    s->error_code = value;
+    sds_mark_dirty("SensorData", SDS_SECTION_STATUS, 0);
+}
+static inline void sensor_data_set_status_battery_percent(SensorDataStatus* s, uint8_t value) {
+    if (s->battery_percent == value) return;
+    s->battery_percent = value;
+    sds_mark_dirty("SensorData", SDS_SECTION_STATUS, 1);
+}
+static inline void sensor_data_set_status_uptime_seconds(SensorDataStatus* s, uint32_t value) {
+    if (s->uptime_seconds == value) return;
+    s->uptime_seconds = value;
+    sds_mark_dirty("SensorData", SDS_SECTION_STATUS, 2);
+}
+
 /* ============== Table: ActuatorData ============== */
 
 #define SDS_ACTUATOR_DATA_SYNC_INTERVAL_MS 100
@@ -165,6 +261,7 @@ typedef struct {
     bool eviction_pending;   /* true if awaiting grace period after LWT */
     uint32_t last_seen_ms;   /* Timestamp of last received status */
     uint32_t eviction_deadline; /* When to evict if device doesn't return */
+    uint32_t status_seq;     /* Sequence of the last applied status (delta sync) */
     ActuatorDataStatus status;
 } ActuatorDataStatusSlot;
 
@@ -195,41 +292,118 @@ static void actuator_data_serialize_status(void* section, SdsJsonWriter* w) {
 
 static void actuator_data_deserialize_config(void* section, SdsJsonReader* r) {
     ActuatorDataConfig* cfg = (ActuatorDataConfig*)section;
-    sds_json_get_uint8_field(r, "target_position", &cfg->target_position);
-    sds_json_get_uint8_field(r, "speed", &cfg->speed);
+    SdsJsonIter it;
+    SdsJsonMember m;
+    sds_json_iter_init(&it, r);
+    while (sds_json_iter_next(&it, &m)) {
+        switch (m.key_len) {
+        case 5:
+            if (memcmp(m.key, "speed", 5) == 0) {
+                uint32_t tmp;
+                if (sds_json_parse_uint(m.value, &tmp) && tmp <= UINT8_MAX) cfg->speed = (uint8_t)tmp;
+            }
+            break;
+        case 15:
+            if (memcmp(m.key, "target_position", 15) == 0) {
+                uint32_t tmp;
+                if (sds_json_parse_uint(m.value, &tmp) && tmp <= UINT8_MAX) cfg->target_position = (uint8_t)tmp;
+            }
+            break;
+        }
+    }
 }
 
 static void actuator_data_deserialize_state(void* section, SdsJsonReader* r) {
     ActuatorDataState* st = (ActuatorDataState*)section;
-    sds_json_get_uint8_field(r, "current_position", &st->current_position);
+    SdsJsonIter it;
+    SdsJsonMember m;
+    sds_json_iter_init(&it, r);
+    while (sds_json_iter_next(&it, &m)) {
+        switch (m.key_len) {
+        case 16:
+            if (memcmp(m.key, "current_position", 16) == 0) {
+                uint32_t tmp;
+                if (sds_json_parse_uint(m.value, &tmp) && tmp <= UINT8_MAX) st->current_position = (uint8_t)tmp;
+            }
+            break;
+        }
+    }
 }
 
 static void actuator_data_deserialize_status(void* section, SdsJsonReader* r) {
     ActuatorDataStatus* st = (ActuatorDataStatus*)section;
-    sds_json_get_uint8_field(r, "motor_status", &st->motor_status);
-    { uint32_t tmp; if (sds_json_get_uint_field(r, "error_code", &tmp)) st->error_code = tmp; }
+    SdsJsonIter it;
+    SdsJsonMember m;
+    sds_json_iter_init(&it, r);
+    while (sds_json_iter_next(&it, &m)) {
+        switch (m.key_len) {
+        case 10:
+            if (memcmp(m.key, "error_code", 10) == 0) {
+                uint32_t tmp;
+                if (sds_json_parse_uint(m.value, &tmp)) st->error_code = (uint16_t)tmp;
+            }
+            break;
+        case 12:
+            if (memcmp(m.key, "motor_status", 12) == 0) {
+                uint32_t tmp;
+                if (sds_json_parse_uint(m.value, &tmp) && tmp <= UINT8_MAX) st->motor_status = (uint8_t)tmp;
+            }
+            break;
+        }
+    }
 }
 
 /* Config field descriptors for delta sync */
 static const SdsFieldMeta SDS_ACTUATOR_DATA_CONFIG_FIELDS[] = {
-    { "target_position", SDS_FIELD_UINT8, offsetof(ActuatorDataConfig, target_position), sizeof(((ActuatorDataConfig*)0)->target_position) },
-    { "speed", SDS_FIELD_UINT8, offsetof(ActuatorDataConfig, speed), sizeof(((ActuatorDataConfig*)0)->speed) },
+    { .name = "target_position", .type = SDS_FIELD_UINT8, .offset = offsetof(ActuatorDataConfig, target_position), .size = sizeof(((ActuatorDataConfig*)0)->target_position) },
+    { .name = "speed", .type = SDS_FIELD_UINT8, .offset = offsetof(ActuatorDataConfig, speed), .size = sizeof(((ActuatorDataConfig*)0)->speed) },
 };
 #define SDS_ACTUATOR_DATA_CONFIG_FIELD_COUNT 2
 
 /* State field descriptors for delta sync */
 static const SdsFieldMeta SDS_ACTUATOR_DATA_STATE_FIELDS[] = {
-    { "current_position", SDS_FIELD_UINT8, offsetof(ActuatorDataState, current_position), sizeof(((ActuatorDataState*)0)->current_position) },
+    { .name = "current_position", .type = SDS_FIELD_UINT8, .offset = offsetof(ActuatorDataState, current_position), .size = sizeof(((ActuatorDataState*)0)->current_position) },
 };
 #define SDS_ACTUATOR_DATA_STATE_FIELD_COUNT 1
 
 /* Status field descriptors for delta sync */
 static const SdsFieldMeta SDS_ACTUATOR_DATA_STATUS_FIELDS[] = {
-    { "motor_status", SDS_FIELD_UINT8, offsetof(ActuatorDataStatus, motor_status), sizeof(((ActuatorDataStatus*)0)->motor_status) },
-    { "error_code", SDS_FIELD_UINT16, offsetof(ActuatorDataStatus, error_code), sizeof(((ActuatorDataStatus*)0)->error_code) },
+    { .name = "motor_status", .type = SDS_FIELD_UINT8, .offset = offsetof(ActuatorDataStatus, motor_status), .size = sizeof(((ActuatorDataStatus*)0)->motor_status) },
+    { .name = "error_code", .type = SDS_FIELD_UINT16, .offset = offsetof(ActuatorDataStatus, error_code), .size = sizeof(((ActuatorDataStatus*)0)->error_code) },
 };
 #define SDS_ACTUATOR_DATA_STATUS_FIELD_COUNT 2
 
+/* Config setters: assign and mark the field for dirty tracking */
+static inline void actuator_data_set_config_target_position(ActuatorDataConfig* s, uint8_t value) {
+    if (s->target_position == value) return;
+    s->target_position = value;
+    sds_mark_dirty("ActuatorData", SDS_SECTION_CONFIG, 0);
+}
+static inline void actuator_data_set_config_speed(ActuatorDataConfig* s, uint8_t value) {
+    if (s->speed == value) return;
+    s->speed = value;
+    sds_mark_dirty("ActuatorData", SDS_SECTION_CONFIG, 1);
+}
+
+/* State setters: assign and mark the field for dirty tracking */
+static inline void actuator_data_set_state_current_position(ActuatorDataState* s, uint8_t value) {
+    if (s->current_position == value) return;
+    s->current_position = value;
+    sds_mark_dirty("ActuatorData", SDS_SECTION_STATE, 0);
+}
+
+/* Status setters: assign and mark the field for dirty tracking */
+static inline void actuator_data_set_status_motor_status(ActuatorDataStatus* s, uint8_t value) {
+    if (s->motor_status == value) return;
+    s->motor_status = value;
+    sds_mark_dirty("ActuatorData", SDS_SECTION_STATUS, 0);
+}
+static inline void actuator_data_set_status_error_code(ActuatorDataStatus* s, uint16_t value) {
+    if (s->error_code == value) return;
+    s->error_code = value;
+    sds_mark_dirty("ActuatorData", SDS_SECTION_STATUS, 1);
+}
+
 /* ============== Max Section Size (for shadow buffers) ============== */
 
 /* Helper macros for compile-time max calculation */
@@ -273,6 +447,11 @@ static const SdsTableMeta SDS_TABLE_REGISTRY[] = {
         .slot_eviction_deadline_offset = offsetof(SensorDataStatusSlot, eviction_deadline),
         .slot_status_offset = offsetof(SensorDataStatusSlot, status),
         .own_max_status_slots = SDS_GENERATED_MAX_NODES,
+        .own_status_count_size = sizeof(uint8_t),
+        .own_status_slots_external = 0,
+        .own_status_history_offset = 0,
+        .own_status_history_depth = 0,
+        .slot_seq_offset = offsetof(SensorDataStatusSlot, status_seq),
         .serialize_config = sensor_data_serialize_config,
         .serialize_state = sensor_data_serialize_state,
         .serialize_status = sensor_data_serialize_status,
@@ -285,6 +464,11 @@ static const SdsTableMeta SDS_TABLE_REGISTRY[] = {
         .state_field_count = SDS_SENSOR_DATA_STATE_FIELD_COUNT,
         .status_fields = SDS_SENSOR_DATA_STATUS_FIELDS,
         .status_field_count = SDS_SENSOR_DATA_STATUS_FIELD_COUNT,
+        .aggregate_source = NULL,
+        .aggregates = NULL,
+        .aggregate_count = 0,
+        .aggregate_storage_offset = 0,
+        .aggregate_storage_size = 0,
     },
     /* ActuatorData */
     {
@@ -313,6 +497,11 @@ static const SdsTableMeta SDS_TABLE_REGISTRY[] = {
         .slot_eviction_deadline_offset = offsetof(ActuatorDataStatusSlot, eviction_deadline),
         .slot_status_offset = offsetof(ActuatorDataStatusSlot, status),
         .own_max_status_slots = SDS_GENERATED_MAX_NODES,
+        .own_status_count_size = sizeof(uint8_t),
+        .own_status_slots_external = 0,
+        .own_status_history_offset = 0,
+        .own_status_history_depth = 0,
+        .slot_seq_offset = offsetof(ActuatorDataStatusSlot, status_seq),
         .serialize_config = actuator_data_serialize_config,
         .serialize_state = actuator_data_serialize_state,
         .serialize_status = actuator_data_serialize_status,
@@ -325,6 +514,11 @@ static const SdsTableMeta SDS_TABLE_REGISTRY[] = {
         .state_field_count = SDS_ACTUATOR_DATA_STATE_FIELD_COUNT,
         .status_fields = SDS_ACTUATOR_DATA_STATUS_FIELDS,
         .status_field_count = SDS_ACTUATOR_DATA_STATUS_FIELD_COUNT,
+        .aggregate_source = NULL,
+        .aggregates = NULL,
+        .aggregate_count = 0,
+        .aggregate_storage_offset = 0,
+        .aggregate_storage_size = 0,
     },
 };
 
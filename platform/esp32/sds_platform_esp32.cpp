@@ -6,6 +6,13 @@
  * Dependencies (PlatformIO lib_deps):
  *   - knolleary/PubSubClient
  *   - WiFi (built-in for ESP32/ESP8266)
+ * 
+ * On ESP32 the outbound queue is drained by a FreeRTOS task. PubSubClient
+ * is not thread-safe, so every client call takes a recursive mutex.
+ * ESP8266 has no sender task; sds_loop() drains the queue itself.
+ * 
+ * The config cache is stored in NVS (Preferences) on ESP32; ESP8266 has
+ * no persistent storage hook and never restores a cached config.
  */
 
 #include "sds_platform.h"
@@ -14,6 +21,7 @@
 
 #if defined(ESP32)
   #include <WiFi.h>
+  #include <Preferences.h>
   #define SDS_PLATFORM_NAME "ESP32"
 #elif defined(ESP8266)
   #include <ESP8266WiFi.h>
@@ -30,6 +38,13 @@
 #define SDS_MQTT_KEEPALIVE      60
 #define SDS_RECONNECT_DELAY_MS  5000
 
+#ifndef SDS_SENDER_TASK_STACK
+#define SDS_SENDER_TASK_STACK   4096
+#endif
+#ifndef SDS_SENDER_TASK_PRIORITY
+#define SDS_SENDER_TASK_PRIORITY 1
+#endif
+
 /* ============== Internal State ============== */
 
 static WiFiClient _wifi_client;
@@ -39,9 +54,28 @@ static bool _initialized = false;
 static char _client_id[64] = "";
 static char _broker[128] = "";
 static uint16_t _port = 1883;
+static bool _persistent_session = false;
 
 static SdsMqttMessageCallback _message_callback = nullptr;
 
+#if defined(ESP32)
+/* Serializes PubSubClient between the sds_loop() task and the sender task */
+static SemaphoreHandle_t _client_mutex = nullptr;
+static SemaphoreHandle_t _outbound_mutex = nullptr;
+static TaskHandle_t _sender_task = nullptr;
+static volatile bool _sender_running = false;
+static SdsOutboundDrainFunc _sender_drain = nullptr;
+
+struct ClientLock {
+    ClientLock() { if (_client_mutex) xSemaphoreTakeRecursive(_client_mutex, portMAX_DELAY); }
+    ~ClientLock() { if (_client_mutex) xSemaphoreGiveRecursive(_client_mutex); }
+};
+#else
+struct ClientLock {
+    ClientLock() {}
+};
+#endif
+
 /* ============== MQTT Callback ============== */
 
 static void mqtt_callback(char* topic, uint8_t* payload, unsigned int length) {
@@ -57,6 +91,13 @@ extern "C" bool sds_platform_init(void) {
         return true;
     }
     
+#if defined(ESP32)
+    if (!_client_mutex) {
+        _client_mutex = xSemaphoreCreateRecursiveMutex();
+        _outbound_mutex = xSemaphoreCreateMutex();
+    }
+#endif
+    
     _mqtt_client.setBufferSize(SDS_MQTT_BUFFER_SIZE);
     _mqtt_client.setKeepAlive(SDS_MQTT_KEEPALIVE);
     _mqtt_client.setCallback(mqtt_callback);
@@ -71,8 +112,11 @@ extern "C" void sds_platform_shutdown(void) {
         return;
     }
     
-    if (_mqtt_client.connected()) {
-        _mqtt_client.disconnect();
+    {
+        ClientLock lock;
+        if (_mqtt_client.connected()) {
+            _mqtt_client.disconnect();
+        }
     }
     
     _initialized = false;
@@ -101,9 +145,11 @@ extern "C" bool sds_platform_mqtt_connect(const char* broker, uint16_t port, con
     _port = port;
     
     /* Configure and connect */
+    ClientLock lock;
     _mqtt_client.setServer(_broker, _port);
     
-    if (!_mqtt_client.connect(_client_id)) {
+    if (!_mqtt_client.connect(_client_id, NULL, NULL, NULL, 0, false, NULL,
+                              !_persistent_session)) {
         SDS_LOG_E("Failed to connect to MQTT broker %s:%u", _broker, _port);
         return false;
     }
@@ -140,6 +186,7 @@ extern "C" bool sds_platform_mqtt_connect_with_lwt(
     _port = port;
     
     /* Configure and connect with LWT */
+    ClientLock lock;
     _mqtt_client.setServer(_broker, _port);
     
     bool success;
@@ -152,13 +199,15 @@ extern "C" bool sds_platform_mqtt_connect_with_lwt(
             will_topic,     /* willTopic */
             1,              /* willQoS (QoS 1 for reliability) */
             will_retain,    /* willRetain */
-            (const char*)will_payload  /* willMessage */
+            (const char*)will_payload, /* willMessage */
+            !_persistent_session       /* cleanSession */
         );
         if (success) {
             SDS_LOG_D("LWT configured: topic=%s", will_topic);
         }
     } else {
-        success = _mqtt_client.connect(_client_id);
+        success = _mqtt_client.connect(_client_id, NULL, NULL, NULL, 0, false, NULL,
+                                       !_persistent_session);
     }
     
     if (!success) {
@@ -200,6 +249,7 @@ extern "C" bool sds_platform_mqtt_connect_with_auth(
     _port = port;
     
     /* Configure and connect with auth and LWT */
+    ClientLock lock;
     _mqtt_client.setServer(_broker, _port);
     
     bool success;
@@ -212,14 +262,16 @@ extern "C" bool sds_platform_mqtt_connect_with_auth(
             will_topic,     /* willTopic */
             1,              /* willQoS (QoS 1 for reliability) */
             will_retain,    /* willRetain */
-            (const char*)will_payload  /* willMessage */
+            (const char*)will_payload, /* willMessage */
+            !_persistent_session       /* cleanSession */
         );
         if (success) {
             SDS_LOG_D("LWT configured: topic=%s", will_topic);
         }
     } else {
         /* Connect with just authentication */
-        success = _mqtt_client.connect(_client_id, username, password);
+        success = _mqtt_client.connect(_client_id, username, password, NULL, 0, false, NULL,
+                                       !_persistent_session);
     }
     
     if (!success) {
@@ -235,7 +287,18 @@ extern "C" bool sds_platform_mqtt_connect_with_auth(
     return true;
 }
 
+extern "C" void sds_platform_mqtt_set_persistent_session(bool persistent) {
+    _persistent_session = persistent;
+}
+
+extern "C" bool sds_platform_mqtt_session_present(void) {
+    /* PubSubClient does not expose the CONNACK session-present flag, so
+     * report a fresh session and let the core resubscribe. */
+    return false;
+}
+
 extern "C" void sds_platform_mqtt_disconnect(void) {
+    ClientLock lock;
     if (_mqtt_client.connected()) {
         _mqtt_client.disconnect();
         SDS_LOG_I("Disconnected from MQTT broker");
@@ -243,6 +306,7 @@ extern "C" void sds_platform_mqtt_disconnect(void) {
 }
 
 extern "C" bool sds_platform_mqtt_connected(void) {
+    ClientLock lock;
     return _mqtt_client.connected();
 }
 
@@ -252,6 +316,7 @@ extern "C" bool sds_platform_mqtt_publish(
     size_t payload_len,
     bool retained
 ) {
+    ClientLock lock;
     if (!_mqtt_client.connected()) {
         return false;
     }
@@ -264,6 +329,7 @@ extern "C" bool sds_platform_mqtt_publish(
 }
 
 extern "C" bool sds_platform_mqtt_subscribe(const char* topic) {
+    ClientLock lock;
     if (!_mqtt_client.connected()) {
         return false;
     }
@@ -277,7 +343,20 @@ extern "C" bool sds_platform_mqtt_subscribe(const char* topic) {
     return success;
 }
 
+extern "C" bool sds_platform_mqtt_subscribe_many(const char* const* topics, size_t count) {
+    /* PubSubClient sends one topic per SUBSCRIBE packet */
+    ClientLock lock;
+    bool success = true;
+    for (size_t i = 0; i < count; i++) {
+        if (!sds_platform_mqtt_subscribe(topics[i])) {
+            success = false;
+        }
+    }
+    return success;
+}
+
 extern "C" bool sds_platform_mqtt_unsubscribe(const char* topic) {
+    ClientLock lock;
     if (!_mqtt_client.connected()) {
         return false;
     }
@@ -292,6 +371,7 @@ extern "C" bool sds_platform_mqtt_unsubscribe(const char* topic) {
 }
 
 extern "C" void sds_platform_mqtt_loop(void) {
+    ClientLock lock;
     _mqtt_client.loop();
 }
 
@@ -299,12 +379,235 @@ extern "C" void sds_platform_mqtt_set_callback(SdsMqttMessageCallback callback)
     _message_callback = callback;
 }
 
+/* ============== Outbound Sender ============== */
+
+#if defined(ESP32)
+
+static void sender_task_main(void* arg) {
+    (void)arg;
+    
+    while (_sender_running) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!_sender_running) break;
+        _sender_drain();
+    }
+    
+    _sender_task = nullptr;
+    vTaskDelete(nullptr);
+}
+
+extern "C" bool sds_platform_outbound_start(SdsOutboundDrainFunc drain) {
+    if (_sender_task || !drain || !_client_mutex || !_outbound_mutex) {
+        return _sender_task != nullptr;
+    }
+    
+    _sender_drain = drain;
+    _sender_running = true;
+    
+    if (xTaskCreate(sender_task_main, "sds_sender", SDS_SENDER_TASK_STACK, nullptr,
+                    SDS_SENDER_TASK_PRIORITY, &_sender_task) != pdPASS) {
+        SDS_LOG_W("Failed to start outbound sender task");
+        _sender_running = false;
+        _sender_task = nullptr;
+        return false;
+    }
+    
+    SDS_LOG_D("Outbound sender task started");
+    return true;
+}
+
+extern "C" void sds_platform_outbound_notify(void) {
+    if (_sender_task) {
+        xTaskNotifyGive(_sender_task);
+    }
+}
+
+extern "C" void sds_platform_outbound_stop(void) {
+    if (!_sender_task) {
+        return;
+    }
+    
+    _sender_running = false;
+    xTaskNotifyGive(_sender_task);
+    
+    /* The task clears its handle once the current drain has returned */
+    while (_sender_task) {
+        vTaskDelay(1);
+    }
+    _sender_drain = nullptr;
+    SDS_LOG_D("Outbound sender task stopped");
+}
+
+extern "C" void sds_platform_outbound_lock(void) {
+    if (_outbound_mutex) {
+        xSemaphoreTake(_outbound_mutex, portMAX_DELAY);
+    }
+}
+
+extern "C" void sds_platform_outbound_unlock(void) {
+    if (_outbound_mutex) {
+        xSemaphoreGive(_outbound_mutex);
+    }
+}
+
+#else
+
+/* No sender task: sds_loop() drains the queue on the calling thread */
+extern "C" bool sds_platform_outbound_start(SdsOutboundDrainFunc drain) {
+    (void)drain;
+    return false;
+}
+
+extern "C" void sds_platform_outbound_notify(void) {
+}
+
+extern "C" void sds_platform_outbound_stop(void) {
+}
+
+extern "C" void sds_platform_outbound_lock(void) {
+}
+
+extern "C" void sds_platform_outbound_unlock(void) {
+}
+
+#endif
+
+/* ============== Ingest Workers ============== */
+
+/*
+ * PubSubClient delivers messages from client.loop(), inside sds_loop(), so
+ * there is no receive thread to hand off from: sds_loop() applies the
+ * inbound queue itself and the locks are never contended.
+ */
+extern "C" bool sds_platform_ingest_start(SdsIngestWorkFunc work, uint8_t workers) {
+    (void)work;
+    (void)workers;
+    return false;
+}
+
+extern "C" void sds_platform_ingest_notify(void) {
+}
+
+extern "C" void sds_platform_ingest_stop(void) {
+}
+
+extern "C" void sds_platform_ingest_lock(void) {
+}
+
+extern "C" void sds_platform_ingest_unlock(void) {
+}
+
+extern "C" void sds_platform_table_lock(uint8_t table) {
+    (void)table;
+}
+
+extern "C" void sds_platform_table_unlock(uint8_t table) {
+    (void)table;
+}
+
+/* ============== Persistent Storage ============== */
+
+#if defined(ESP32)
+
+#define SDS_NVS_NAMESPACE "sds"
+
+/* NVS keys are limited to 15 characters: use "c" + FNV-1a of the key */
+static void nvs_key(const char* key, char* out, size_t size) {
+    uint32_t h = 2166136261u;
+    while (*key) {
+        h ^= (uint8_t)*key++;
+        h *= 16777619u;
+    }
+    snprintf(out, size, "c%08lx", (unsigned long)h);
+}
+
+extern "C" size_t sds_platform_storage_load(const char* key, uint8_t* buf, size_t size) {
+    char name[16];
+    nvs_key(key, name, sizeof(name));
+    
+    Preferences prefs;
+    if (!prefs.begin(SDS_NVS_NAMESPACE, true)) {
+        return 0;
+    }
+    size_t len = prefs.getBytesLength(name);
+    if (len == 0 || len > size) {
+        prefs.end();
+        return 0;
+    }
+    len = prefs.getBytes(name, buf, len);
+    prefs.end();
+    return len;
+}
+
+extern "C" bool sds_platform_storage_save(const char* key, const uint8_t* data, size_t len) {
+    char name[16];
+    nvs_key(key, name, sizeof(name));
+    
+    /* NVS commits each blob atomically */
+    Preferences prefs;
+    if (!prefs.begin(SDS_NVS_NAMESPACE, false)) {
+        return false;
+    }
+    bool ok = prefs.putBytes(name, data, len) == len;
+    prefs.end();
+    return ok;
+}
+
+#else
+
+extern "C" size_t sds_platform_storage_load(const char* key, uint8_t* buf, size_t size) {
+    (void)key;
+    (void)buf;
+    (void)size;
+    return 0;
+}
+
+extern "C" bool sds_platform_storage_save(const char* key, const uint8_t* data, size_t len) {
+    (void)key;
+    (void)data;
+    (void)len;
+    return false;
+}
+
+#endif
+
+/* ============== Shared Memory ============== */
+
+/* Single-process target: owner tables are not exported */
+
+extern "C" void* sds_platform_shm_create(const char* name, size_t size) {
+    (void)name;
+    (void)size;
+    return NULL;
+}
+
+extern "C" void sds_platform_shm_remove(const char* name, void* addr, size_t size) {
+    (void)name;
+    (void)addr;
+    (void)size;
+}
+
+extern "C" const void* sds_platform_shm_attach(const char* name, size_t* size) {
+    (void)name;
+    (void)size;
+    return NULL;
+}
+
+extern "C" void sds_platform_shm_detach(const void* addr, size_t size) {
+    (void)addr;
+    (void)size;
+}
+
 /* ============== Timing ============== */
 
 extern "C" uint32_t sds_platform_millis(void) {
     return millis();
 }
 
+extern "C" uint32_t sds_platform_micros(void) {
+    return micros();
+}
+
 extern "C" void sds_platform_delay_ms(uint32_t ms) {
     delay(ms);
 }
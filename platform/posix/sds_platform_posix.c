@@ -5,6 +5,7 @@
  * 
  * Dependencies:
  *   - paho-mqtt3c (Paho MQTT C client, synchronous API)
+ *   - pthreads (outbound sender thread, ingest workers)
  *   
  * Install on macOS: brew install eclipse-paho-mqtt-c
  * Install on Ubuntu: apt-get install libpaho-mqtt-dev
@@ -18,6 +19,11 @@
 #include <stdarg.h>
 #include <time.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 
 #include <MQTTClient.h>
 
@@ -26,15 +32,60 @@
 #define MQTT_QOS            0
 #define MQTT_TIMEOUT_MS     10000
 #define MQTT_KEEPALIVE_SEC  60
+#define MQTT_SUBSCRIBE_MANY_MAX 32       /* Topics per SUBSCRIBE packet */
+
+#ifndef SDS_INGEST_MAX_WORKERS
+#define SDS_INGEST_MAX_WORKERS 8
+#endif
+#define SDS_TABLE_LOCK_STRIPES 16
+
+/* Directory for sds_platform_storage_*(); SDS_STORAGE_DIR overrides it */
+#ifndef SDS_POSIX_STORAGE_DIR
+#define SDS_POSIX_STORAGE_DIR ".sds"
+#endif
 
 /* ============== Internal State ============== */
 
 static MQTTClient _mqtt_client = NULL;
 static bool _initialized = false;
-static bool _connected = false;
+static atomic_bool _connected = false;  /* Read by the sender thread */
 static SdsMqttMessageCallback _message_callback = NULL;
 static struct timespec _start_time;
 
+/* Client reuse and persistent sessions */
+static char _client_address[256] = "";
+static char _client_id[128] = "";
+static bool _persistent_session = false;
+static bool _session_present = false;
+
+/*
+ * Keeps the _mqtt_client handle alive while it is in use: connected() and
+ * publish() take it shared (Paho serializes the calls itself), destroying
+ * the client takes it exclusively.
+ */
+static pthread_rwlock_t _client_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+/* Outbound sender thread */
+static pthread_mutex_t _outbound_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t _sender_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _sender_wake = PTHREAD_COND_INITIALIZER;
+static pthread_t _sender_thread;
+static bool _sender_running = false;
+static bool _sender_pending = false;
+static SdsOutboundDrainFunc _sender_drain = NULL;
+
+/* Ingest worker pool; tables share SDS_TABLE_LOCK_STRIPES recursive locks */
+static pthread_mutex_t _ingest_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t _worker_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _worker_wake = PTHREAD_COND_INITIALIZER;
+static pthread_t _workers[SDS_INGEST_MAX_WORKERS];
+static uint8_t _worker_count = 0;
+static bool _workers_running = false;
+static uint8_t _workers_pending = 0;    /* Wakeups not yet taken, at most _worker_count */
+static SdsIngestWorkFunc _ingest_work = NULL;
+static pthread_mutex_t _table_locks[SDS_TABLE_LOCK_STRIPES];
+static pthread_once_t _table_locks_once = PTHREAD_ONCE_INIT;
+
 /* ============== MQTT Message Handler ============== */
 
 static int mqtt_message_arrived(void* context, char* topic, int topic_len, MQTTClient_message* message) {
@@ -56,6 +107,16 @@ static void mqtt_connection_lost(void* context, char* cause) {
     _connected = false;
 }
 
+static void destroy_client(void) {
+    pthread_rwlock_wrlock(&_client_lock);
+    if (_mqtt_client) {
+        MQTTClient_destroy(&_mqtt_client);
+        _mqtt_client = NULL;
+    }
+    _connected = false;
+    pthread_rwlock_unlock(&_client_lock);
+}
+
 /* ============== Platform Init/Shutdown ============== */
 
 bool sds_platform_init(void) {
@@ -78,8 +139,7 @@ void sds_platform_shutdown(void) {
     
     if (_mqtt_client) {
         sds_platform_mqtt_disconnect();
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
+        destroy_client();
     }
     
     _initialized = false;
@@ -88,67 +148,16 @@ void sds_platform_shutdown(void) {
 
 /* ============== MQTT Operations ============== */
 
-bool sds_platform_mqtt_connect(const char* broker, uint16_t port, const char* client_id) {
-    if (!_initialized) {
-        SDS_LOG_E("Platform not initialized");
-        return false;
-    }
-    
-    if (_mqtt_client) {
-        sds_platform_mqtt_disconnect();
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
-    }
-    
-    /* Build connection string: tcp://host:port */
-    char address[256];
-    snprintf(address, sizeof(address), "tcp://%s:%u", broker, port);
-    
-    /* Create client */
-    int rc = MQTTClient_create(
-        &_mqtt_client,
-        address,
-        client_id,
-        MQTTCLIENT_PERSISTENCE_NONE,
-        NULL
-    );
-    
-    if (rc != MQTTCLIENT_SUCCESS) {
-        SDS_LOG_E("Failed to create MQTT client: %d", rc);
-        return false;
-    }
-    
-    /* Set callbacks */
-    rc = MQTTClient_setCallbacks(_mqtt_client, NULL, mqtt_connection_lost, mqtt_message_arrived, NULL);
-    if (rc != MQTTCLIENT_SUCCESS) {
-        SDS_LOG_E("Failed to set MQTT callbacks: %d", rc);
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
-        return false;
-    }
-    
-    /* Connect */
-    MQTTClient_connectOptions conn_opts = MQTTClient_connectOptions_initializer;
-    conn_opts.keepAliveInterval = MQTT_KEEPALIVE_SEC;
-    conn_opts.cleansession = 1;
-    
-    rc = MQTTClient_connect(_mqtt_client, &conn_opts);
-    if (rc != MQTTCLIENT_SUCCESS) {
-        SDS_LOG_E("Failed to connect to MQTT broker %s: %d", address, rc);
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
-        return false;
-    }
-    
-    _connected = true;
-    SDS_LOG_I("Connected to MQTT broker: %s", address);
-    return true;
-}
-
-bool sds_platform_mqtt_connect_with_lwt(
+/*
+ * Connect, reusing the client object when the broker address and client id
+ * are unchanged (Paho clients can reconnect after a lost connection).
+ */
+static bool mqtt_connect(
     const char* broker,
     uint16_t port,
     const char* client_id,
+    const char* username,
+    const char* password,
     const char* will_topic,
     const uint8_t* will_payload,
     size_t will_payload_len,
@@ -159,43 +168,58 @@ bool sds_platform_mqtt_connect_with_lwt(
         return false;
     }
     
-    if (_mqtt_client) {
-        sds_platform_mqtt_disconnect();
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
-    }
-    
     /* Build connection string: tcp://host:port */
     char address[256];
     snprintf(address, sizeof(address), "tcp://%s:%u", broker, port);
     
-    /* Create client */
-    int rc = MQTTClient_create(
-        &_mqtt_client,
-        address,
-        client_id,
-        MQTTCLIENT_PERSISTENCE_NONE,
-        NULL
-    );
-    
-    if (rc != MQTTCLIENT_SUCCESS) {
-        SDS_LOG_E("Failed to create MQTT client: %d", rc);
-        return false;
-    }
-    
-    /* Set callbacks */
-    rc = MQTTClient_setCallbacks(_mqtt_client, NULL, mqtt_connection_lost, mqtt_message_arrived, NULL);
-    if (rc != MQTTCLIENT_SUCCESS) {
-        SDS_LOG_E("Failed to set MQTT callbacks: %d", rc);
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
-        return false;
+    bool reuse = _mqtt_client && strcmp(address, _client_address) == 0 &&
+                 strcmp(client_id, _client_id) == 0;
+    if (_mqtt_client) {
+        sds_platform_mqtt_disconnect();
+        if (!reuse) {
+            destroy_client();
+        }
+    }
+    
+    int rc;
+    if (!reuse) {
+        /* Create client */
+        rc = MQTTClient_create(
+            &_mqtt_client,
+            address,
+            client_id,
+            MQTTCLIENT_PERSISTENCE_NONE,
+            NULL
+        );
+        
+        if (rc != MQTTCLIENT_SUCCESS) {
+            SDS_LOG_E("Failed to create MQTT client: %d", rc);
+            _mqtt_client = NULL;
+            return false;
+        }
+        
+        /* Set callbacks */
+        rc = MQTTClient_setCallbacks(_mqtt_client, NULL, mqtt_connection_lost, mqtt_message_arrived, NULL);
+        if (rc != MQTTCLIENT_SUCCESS) {
+            SDS_LOG_E("Failed to set MQTT callbacks: %d", rc);
+            destroy_client();
+            return false;
+        }
+        
+        snprintf(_client_address, sizeof(_client_address), "%s", address);
+        snprintf(_client_id, sizeof(_client_id), "%s", client_id);
     }
     
-    /* Connect with LWT */
     MQTTClient_connectOptions conn_opts = MQTTClient_connectOptions_initializer;
     conn_opts.keepAliveInterval = MQTT_KEEPALIVE_SEC;
-    conn_opts.cleansession = 1;
+    conn_opts.cleansession = _persistent_session ? 0 : 1;
+    
+    /* Configure authentication if provided */
+    if (username && username[0] != '\0') {
+        conn_opts.username = username;
+        conn_opts.password = password;
+        SDS_LOG_D("MQTT auth configured for user: %s", username);
+    }
     
     /* Configure LWT if topic is provided */
     MQTTClient_willOptions will_opts = MQTTClient_willOptions_initializer;
@@ -211,16 +235,40 @@ bool sds_platform_mqtt_connect_with_lwt(
     rc = MQTTClient_connect(_mqtt_client, &conn_opts);
     if (rc != MQTTCLIENT_SUCCESS) {
         SDS_LOG_E("Failed to connect to MQTT broker %s: %d", address, rc);
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
+        /* A reused client stays for the next attempt */
+        if (!reuse) {
+            destroy_client();
+        }
+        _session_present = false;
         return false;
     }
     
+    _session_present = _persistent_session && conn_opts.returned.sessionPresent;
     _connected = true;
-    SDS_LOG_I("Connected to MQTT broker: %s (with LWT)", address);
+    SDS_LOG_I("Connected to MQTT broker: %s%s%s%s", address,
+              (username && username[0] != '\0') ? " (with auth)" : "",
+              conn_opts.will ? " (with LWT)" : "",
+              _session_present ? " (session resumed)" : "");
     return true;
 }
 
+bool sds_platform_mqtt_connect(const char* broker, uint16_t port, const char* client_id) {
+    return mqtt_connect(broker, port, client_id, NULL, NULL, NULL, NULL, 0, false);
+}
+
+bool sds_platform_mqtt_connect_with_lwt(
+    const char* broker,
+    uint16_t port,
+    const char* client_id,
+    const char* will_topic,
+    const uint8_t* will_payload,
+    size_t will_payload_len,
+    bool will_retain
+) {
+    return mqtt_connect(broker, port, client_id, NULL, NULL,
+                        will_topic, will_payload, will_payload_len, will_retain);
+}
+
 bool sds_platform_mqtt_connect_with_auth(
     const char* broker,
     uint16_t port,
@@ -232,78 +280,16 @@ bool sds_platform_mqtt_connect_with_auth(
     size_t will_payload_len,
     bool will_retain
 ) {
-    if (!_initialized) {
-        SDS_LOG_E("Platform not initialized");
-        return false;
-    }
-    
-    if (_mqtt_client) {
-        sds_platform_mqtt_disconnect();
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
-    }
-    
-    /* Build connection string: tcp://host:port */
-    char address[256];
-    snprintf(address, sizeof(address), "tcp://%s:%u", broker, port);
-    
-    /* Create client */
-    int rc = MQTTClient_create(
-        &_mqtt_client,
-        address,
-        client_id,
-        MQTTCLIENT_PERSISTENCE_NONE,
-        NULL
-    );
-    
-    if (rc != MQTTCLIENT_SUCCESS) {
-        SDS_LOG_E("Failed to create MQTT client: %d", rc);
-        return false;
-    }
-    
-    /* Set callbacks */
-    rc = MQTTClient_setCallbacks(_mqtt_client, NULL, mqtt_connection_lost, mqtt_message_arrived, NULL);
-    if (rc != MQTTCLIENT_SUCCESS) {
-        SDS_LOG_E("Failed to set MQTT callbacks: %d", rc);
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
-        return false;
-    }
-    
-    /* Connect with LWT and authentication */
-    MQTTClient_connectOptions conn_opts = MQTTClient_connectOptions_initializer;
-    conn_opts.keepAliveInterval = MQTT_KEEPALIVE_SEC;
-    conn_opts.cleansession = 1;
-    
-    /* Configure authentication if provided */
-    if (username && username[0] != '\0') {
-        conn_opts.username = username;
-        conn_opts.password = password;
-        SDS_LOG_D("MQTT auth configured for user: %s", username);
-    }
-    
-    /* Configure LWT if topic is provided */
-    MQTTClient_willOptions will_opts = MQTTClient_willOptions_initializer;
-    if (will_topic && will_payload && will_payload_len > 0) {
-        will_opts.topicName = will_topic;
-        will_opts.message = (const char*)will_payload;
-        will_opts.retained = will_retain ? 1 : 0;
-        will_opts.qos = 1;  /* Use QoS 1 for LWT to ensure delivery */
-        conn_opts.will = &will_opts;
-        SDS_LOG_D("LWT configured: topic=%s", will_topic);
-    }
-    
-    rc = MQTTClient_connect(_mqtt_client, &conn_opts);
-    if (rc != MQTTCLIENT_SUCCESS) {
-        SDS_LOG_E("Failed to connect to MQTT broker %s: %d", address, rc);
-        MQTTClient_destroy(&_mqtt_client);
-        _mqtt_client = NULL;
-        return false;
-    }
-    
-    _connected = true;
-    SDS_LOG_I("Connected to MQTT broker: %s (with auth + LWT)", address);
-    return true;
+    return mqtt_connect(broker, port, client_id, username, password,
+                        will_topic, will_payload, will_payload_len, will_retain);
+}
+
+void sds_platform_mqtt_set_persistent_session(bool persistent) {
+    _persistent_session = persistent;
+}
+
+bool sds_platform_mqtt_session_present(void) {
+    return _session_present;
 }
 
 void sds_platform_mqtt_disconnect(void) {
@@ -315,15 +301,17 @@ void sds_platform_mqtt_disconnect(void) {
 }
 
 bool sds_platform_mqtt_connected(void) {
-    if (!_mqtt_client) {
-        return false;
-    }
-    _connected = MQTTClient_isConnected(_mqtt_client);
-    return _connected;
+    pthread_rwlock_rdlock(&_client_lock);
+    bool connected = _mqtt_client && MQTTClient_isConnected(_mqtt_client);
+    pthread_rwlock_unlock(&_client_lock);
+    _connected = connected;
+    return connected;
 }
 
 bool sds_platform_mqtt_publish(const char* topic, const uint8_t* payload, size_t payload_len, bool retained) {
+    pthread_rwlock_rdlock(&_client_lock);
     if (!_mqtt_client || !_connected) {
+        pthread_rwlock_unlock(&_client_lock);
         return false;
     }
     
@@ -335,6 +323,7 @@ bool sds_platform_mqtt_publish(const char* topic, const uint8_t* payload, size_t
     
     MQTTClient_deliveryToken token;
     int rc = MQTTClient_publishMessage(_mqtt_client, topic, &msg, &token);
+    pthread_rwlock_unlock(&_client_lock);
     
     if (rc != MQTTCLIENT_SUCCESS) {
         SDS_LOG_E("Failed to publish to %s: %d", topic, rc);
@@ -360,6 +349,40 @@ bool sds_platform_mqtt_subscribe(const char* topic) {
     return true;
 }
 
+bool sds_platform_mqtt_subscribe_many(const char* const* topics, size_t count) {
+    if (!_mqtt_client || !_connected) {
+        return false;
+    }
+    
+    bool granted = true;
+    for (size_t i = 0; i < count; i += MQTT_SUBSCRIBE_MANY_MAX) {
+        int n = (int)(count - i < MQTT_SUBSCRIBE_MANY_MAX ? count - i : MQTT_SUBSCRIBE_MANY_MAX);
+        int qos[MQTT_SUBSCRIBE_MANY_MAX];
+        for (int t = 0; t < n; t++) {
+            qos[t] = MQTT_QOS;
+        }
+        
+        int rc = MQTTClient_subscribeMany(_mqtt_client, n, (char* const*)(topics + i), qos);
+        if (rc != MQTTCLIENT_SUCCESS) {
+            SDS_LOG_E("Failed to subscribe to %d topics: %d", n, rc);
+            granted = false;
+            continue;
+        }
+        /* SUBACK carries 0x80 for each refused filter */
+        for (int t = 0; t < n; t++) {
+            if (qos[t] == 0x80) {
+                SDS_LOG_E("Subscription refused: %s", topics[i + t]);
+                granted = false;
+            }
+        }
+    }
+    
+    if (granted) {
+        SDS_LOG_D("Subscribed to %zu topics", count);
+    }
+    return granted;
+}
+
 bool sds_platform_mqtt_unsubscribe(const char* topic) {
     if (!_mqtt_client || !_connected) {
         return false;
@@ -387,6 +410,294 @@ void sds_platform_mqtt_set_callback(SdsMqttMessageCallback callback) {
     _message_callback = callback;
 }
 
+/* ============== Outbound Sender ============== */
+
+static void* sender_thread_main(void* arg) {
+    (void)arg;
+    
+    pthread_mutex_lock(&_sender_lock);
+    while (_sender_running) {
+        if (!_sender_pending) {
+            pthread_cond_wait(&_sender_wake, &_sender_lock);
+            continue;
+        }
+        _sender_pending = false;
+        pthread_mutex_unlock(&_sender_lock);
+        
+        _sender_drain();
+        
+        pthread_mutex_lock(&_sender_lock);
+    }
+    pthread_mutex_unlock(&_sender_lock);
+    return NULL;
+}
+
+bool sds_platform_outbound_start(SdsOutboundDrainFunc drain) {
+    if (_sender_running || !drain) {
+        return _sender_running;
+    }
+    
+    _sender_drain = drain;
+    _sender_pending = false;
+    _sender_running = true;
+    
+    if (pthread_create(&_sender_thread, NULL, sender_thread_main, NULL) != 0) {
+        SDS_LOG_W("Failed to start outbound sender thread");
+        _sender_running = false;
+        return false;
+    }
+    
+    SDS_LOG_D("Outbound sender thread started");
+    return true;
+}
+
+void sds_platform_outbound_notify(void) {
+    pthread_mutex_lock(&_sender_lock);
+    _sender_pending = true;
+    pthread_cond_signal(&_sender_wake);
+    pthread_mutex_unlock(&_sender_lock);
+}
+
+void sds_platform_outbound_stop(void) {
+    pthread_mutex_lock(&_sender_lock);
+    if (!_sender_running) {
+        pthread_mutex_unlock(&_sender_lock);
+        return;
+    }
+    _sender_running = false;
+    pthread_cond_signal(&_sender_wake);
+    pthread_mutex_unlock(&_sender_lock);
+    
+    pthread_join(_sender_thread, NULL);
+    _sender_drain = NULL;
+    SDS_LOG_D("Outbound sender thread stopped");
+}
+
+void sds_platform_outbound_lock(void) {
+    pthread_mutex_lock(&_outbound_lock);
+}
+
+void sds_platform_outbound_unlock(void) {
+    pthread_mutex_unlock(&_outbound_lock);
+}
+
+/* ============== Ingest Workers ============== */
+
+static void init_table_locks(void) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    for (int i = 0; i < SDS_TABLE_LOCK_STRIPES; i++) {
+        pthread_mutex_init(&_table_locks[i], &attr);
+    }
+    pthread_mutexattr_destroy(&attr);
+}
+
+static void* ingest_worker_main(void* arg) {
+    (void)arg;
+    
+    pthread_mutex_lock(&_worker_lock);
+    while (_workers_running) {
+        if (_workers_pending == 0) {
+            pthread_cond_wait(&_worker_wake, &_worker_lock);
+            continue;
+        }
+        _workers_pending--;
+        pthread_mutex_unlock(&_worker_lock);
+        
+        while (_ingest_work()) {
+        }
+        
+        pthread_mutex_lock(&_worker_lock);
+    }
+    pthread_mutex_unlock(&_worker_lock);
+    return NULL;
+}
+
+bool sds_platform_ingest_start(SdsIngestWorkFunc work, uint8_t workers) {
+    if (_workers_running || !work || workers == 0) {
+        return _workers_running;
+    }
+    if (workers > SDS_INGEST_MAX_WORKERS) {
+        SDS_LOG_W("%u ingest workers requested, starting %d", workers, SDS_INGEST_MAX_WORKERS);
+        workers = SDS_INGEST_MAX_WORKERS;
+    }
+    
+    pthread_once(&_table_locks_once, init_table_locks);
+    
+    /* The receive thread may already be notifying */
+    pthread_mutex_lock(&_worker_lock);
+    _ingest_work = work;
+    _workers_pending = 0;
+    _workers_running = true;
+    _worker_count = 0;
+    
+    for (uint8_t i = 0; i < workers; i++) {
+        if (pthread_create(&_workers[i], NULL, ingest_worker_main, NULL) != 0) {
+            break;
+        }
+        _worker_count++;
+    }
+    
+    if (_worker_count == 0) {
+        _workers_running = false;
+        pthread_mutex_unlock(&_worker_lock);
+        SDS_LOG_W("Failed to start ingest workers");
+        return false;
+    }
+    pthread_mutex_unlock(&_worker_lock);
+    
+    SDS_LOG_D("%u ingest workers started", _worker_count);
+    return true;
+}
+
+void sds_platform_ingest_notify(void) {
+    pthread_mutex_lock(&_worker_lock);
+    if (_workers_pending < _worker_count) {
+        _workers_pending++;
+        pthread_cond_signal(&_worker_wake);
+    }
+    pthread_mutex_unlock(&_worker_lock);
+}
+
+void sds_platform_ingest_stop(void) {
+    pthread_mutex_lock(&_worker_lock);
+    if (!_workers_running) {
+        pthread_mutex_unlock(&_worker_lock);
+        return;
+    }
+    _workers_running = false;
+    pthread_cond_broadcast(&_worker_wake);
+    pthread_mutex_unlock(&_worker_lock);
+    
+    for (uint8_t i = 0; i < _worker_count; i++) {
+        pthread_join(_workers[i], NULL);
+    }
+    _worker_count = 0;
+    _ingest_work = NULL;
+    SDS_LOG_D("Ingest workers stopped");
+}
+
+void sds_platform_ingest_lock(void) {
+    pthread_mutex_lock(&_ingest_lock);
+}
+
+void sds_platform_ingest_unlock(void) {
+    pthread_mutex_unlock(&_ingest_lock);
+}
+
+void sds_platform_table_lock(uint8_t table) {
+    pthread_once(&_table_locks_once, init_table_locks);
+    pthread_mutex_lock(&_table_locks[table % SDS_TABLE_LOCK_STRIPES]);
+}
+
+void sds_platform_table_unlock(uint8_t table) {
+    pthread_mutex_unlock(&_table_locks[table % SDS_TABLE_LOCK_STRIPES]);
+}
+
+/* ============== Persistent Storage ============== */
+
+/* One file per record; '/' in the key becomes '_' */
+static bool storage_path(const char* key, char* path, size_t size, bool create_dir) {
+    const char* dir = getenv("SDS_STORAGE_DIR");
+    if (!dir || dir[0] == '\0') {
+        dir = SDS_POSIX_STORAGE_DIR;
+    }
+    if (create_dir) {
+        mkdir(dir, 0755);  /* EEXIST is fine; the open below reports real failures */
+    }
+    
+    int n = snprintf(path, size, "%s/", dir);
+    if (n < 0 || (size_t)n >= size) return false;
+    for (const char* k = key; *k; k++) {
+        if ((size_t)n + 1 >= size) return false;
+        path[n++] = (*k == '/') ? '_' : *k;
+    }
+    path[n] = '\0';
+    return true;
+}
+
+size_t sds_platform_storage_load(const char* key, uint8_t* buf, size_t size) {
+    char path[512];
+    if (!storage_path(key, path, sizeof(path), false)) return 0;
+    
+    FILE* f = fopen(path, "rb");
+    if (!f) return 0;
+    
+    /* Read one byte past size to detect records that do not fit */
+    size_t len = fread(buf, 1, size, f);
+    bool truncated = len == size && fgetc(f) != EOF;
+    fclose(f);
+    return truncated ? 0 : len;
+}
+
+bool sds_platform_storage_save(const char* key, const uint8_t* data, size_t len) {
+    char path[512];
+    char tmp[520];
+    if (!storage_path(key, path, sizeof(path), true)) return false;
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    
+    /* Write aside and rename, so a crash never leaves a partial record */
+    FILE* f = fopen(tmp, "wb");
+    if (!f) return false;
+    bool ok = fwrite(data, 1, len, f) == len;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || rename(tmp, path) != 0) {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
+
+/* ============== Shared Memory ============== */
+
+void* sds_platform_shm_create(const char* name, size_t size) {
+    /* Start from a fresh object: readers of a stale one keep their mapping */
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) return NULL;
+    
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return NULL;
+    }
+    
+    void* addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        shm_unlink(name);
+        return NULL;
+    }
+    return addr;
+}
+
+void sds_platform_shm_remove(const char* name, void* addr, size_t size) {
+    if (addr) munmap(addr, size);
+    shm_unlink(name);
+}
+
+const void* sds_platform_shm_attach(const char* name, size_t* size) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return NULL;
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+    
+    void* addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return NULL;
+    *size = (size_t)st.st_size;
+    return addr;
+}
+
+void sds_platform_shm_detach(const void* addr, size_t size) {
+    if (addr) munmap((void*)addr, size);
+}
+
 /* ============== Timing ============== */
 
 uint32_t sds_platform_millis(void) {
@@ -399,6 +710,16 @@ uint32_t sds_platform_millis(void) {
     return (uint32_t)(now_ms - start_ms);
 }
 
+uint32_t sds_platform_micros(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    uint64_t start_us = (uint64_t)_start_time.tv_sec * 1000000 + _start_time.tv_nsec / 1000;
+    uint64_t now_us = (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+    
+    return (uint32_t)(now_us - start_us);
+}
+
 void sds_platform_delay_ms(uint32_t ms) {
     usleep(ms * 1000);
 }
@@ -32,10 +32,12 @@ __author__ = "SDS Team"
 
 # Core classes
 from sds.node import SdsNode
-from sds.table import SdsTable, SectionProxy, DeviceView
+from sds.table import SdsTable, SectionProxy, DeviceView, StatusSnapshot, StatusHistory
+from sds.aio import AsyncSdsNode, SdsEvent
+from sds.shared import SharedTable, SharedDevice
 
 # Enums
-from sds.types import Role, ErrorCode, LogLevel
+from sds.types import Role, ErrorCode, LogLevel, OutboundPolicy, WireFormat
 
 # Exceptions
 from sds.types import (
@@ -67,11 +69,19 @@ __all__ = [
     "SdsTable",
     "SectionProxy",
     "DeviceView",
+    "StatusSnapshot",
+    "StatusHistory",
+    "AsyncSdsNode",
+    "SdsEvent",
+    "SharedTable",
+    "SharedDevice",
     
     # Enums
     "Role",
     "ErrorCode",
     "LogLevel",
+    "OutboundPolicy",
+    "WireFormat",
     
     # Exceptions
     "SdsError",
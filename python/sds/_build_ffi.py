@@ -70,8 +70,10 @@ else:
     print(f"Warning: Platform implementation not found at {platform_posix_c}")
 
 # Platform-specific library paths
-# The POSIX platform uses Paho MQTT C library (paho-mqtt3c)
-libraries = ["paho-mqtt3c"]
+# The POSIX platform uses Paho MQTT C library (paho-mqtt3c) and a pthread sender
+libraries = ["paho-mqtt3c", "pthread"]
+if sys.platform.startswith("linux"):
+    libraries.append("rt")  # shm_open() on older glibc
 
 if sys.platform == "darwin":
     # macOS: Use Homebrew paths for Paho MQTT
@@ -64,8 +64,22 @@ typedef enum {
 void sds_set_log_level(SdsLogLevel level);
 SdsLogLevel sds_get_log_level(void);
 
+/* Platform clock (slot last_seen_ms values) */
+uint32_t sds_platform_millis(void);
+
 /* ============== Configuration ============== */
 
+typedef enum {
+    SDS_OUTBOUND_COALESCE = 0,
+    SDS_OUTBOUND_DROP_OLDEST = 1,
+    SDS_OUTBOUND_DROP_NEWEST = 2
+} SdsOutboundPolicy;
+
+typedef enum {
+    SDS_CALLBACKS_WORKER = 0,
+    SDS_CALLBACKS_LOOP = 1
+} SdsCallbackExecutor;
+
 typedef struct {
     const char* node_id;
     const char* mqtt_broker;
@@ -75,12 +89,46 @@ typedef struct {
     uint32_t eviction_grace_ms;
     bool enable_delta_sync;
     float delta_float_tolerance;
+    uint8_t outbound_queue_depth;
+    SdsOutboundPolicy outbound_policy;
+    void* table_arena;
+    size_t table_arena_size;
+    uint8_t max_tables;
+    uint8_t inbound_queue_depth;
+    uint8_t ingest_workers;
+    SdsCallbackExecutor callback_executor;
+    uint16_t batch_max_bytes;
+    uint32_t batch_flush_ms;
+    bool enable_instrumentation;
+    bool enable_latency_tracking;
+    bool enable_config_cache;
+    const char* cluster_group;
+    uint8_t cluster_members;
+    uint8_t cluster_member;
+    bool persistent_session;
+    uint16_t keyframe_interval;
 } SdsConfig;
 
+typedef enum {
+    SDS_WIRE_JSON = 0,
+    SDS_WIRE_BINARY = 1
+} SdsWireFormat;
+
 typedef struct {
     uint32_t sync_interval_ms;
+    SdsWireFormat wire_format;
+    bool dirty_tracking;
+    uint32_t sync_interval_min_ms;
+    uint32_t sync_interval_max_ms;
+    uint32_t liveness_max_ms;
 } SdsTableOptions;
 
+typedef enum {
+    SDS_SECTION_CONFIG = 0,
+    SDS_SECTION_STATE = 1,
+    SDS_SECTION_STATUS = 2
+} SdsSection;
+
 /* ============== Statistics ============== */
 
 typedef struct {
@@ -88,8 +136,64 @@ typedef struct {
     uint32_t messages_received;
     uint32_t reconnect_count;
     uint32_t errors;
+    uint32_t outbound_queued;
+    uint32_t outbound_high_water;
+    uint32_t outbound_dropped;
+    uint32_t outbound_coalesced;
+    uint32_t inbound_queued;
+    uint32_t inbound_high_water;
+    uint32_t inbound_dropped;
+    uint32_t batches_sent;
+    uint32_t batched_messages;
+    uint32_t config_cache_restored;
+    uint32_t config_unchanged;
+    uint32_t cluster_skipped;
+    uint32_t sessions_resumed;
+    uint32_t seq_gaps;
+    uint32_t resync_keyframes;
 } SdsStats;
 
+#define SDS_LATENCY_BUCKETS 20
+
+typedef struct {
+    uint32_t count;
+    uint32_t total_us;
+    uint32_t max_us;
+    uint32_t buckets[20];
+} SdsLatencyHistogram;
+
+typedef struct {
+    uint32_t messages_sent;
+    uint32_t bytes_sent;
+    uint32_t messages_received;
+    uint32_t bytes_received;
+    uint32_t full_syncs;
+    uint32_t delta_syncs;
+    uint32_t buffer_full;
+    uint32_t slots_full;
+    uint32_t decode_errors;
+    SdsLatencyHistogram serialize_us;
+    SdsLatencyHistogram parse_us;
+    SdsLatencyHistogram callback_us;
+    SdsLatencyHistogram propagation_ms;
+} SdsTableStats;
+
+typedef struct {
+    int32_t clock_offset_ms;
+    uint32_t rtt_ms;
+    uint32_t ref_ts;
+    uint32_t last_latency_ms;
+    uint32_t samples;
+    bool synced;
+} SdsNodeLatency;
+
+typedef struct {
+    SdsLatencyHistogram loop_us;
+    SdsLatencyHistogram mqtt_us;
+    SdsLatencyHistogram sync_us;
+    SdsLatencyHistogram eviction_us;
+} SdsLoopStats;
+
 /* ============== Callback Types ============== */
 
 /* Note: We use "extern Python" callbacks for CFFI */
@@ -97,6 +201,7 @@ typedef void (*SdsConfigCallback)(const char* table_type, void* user_data);
 typedef void (*SdsStateCallback)(const char* table_type, const char* from_node, void* user_data);
 typedef void (*SdsStatusCallback)(const char* table_type, const char* from_node, void* user_data);
 typedef void (*SdsErrorCallback)(SdsError error, const char* context);
+typedef void (*SdsWakeCallback)(void* user_data);
 typedef void (*SdsNodeIterator)(const char* node_id, const void* status, void* user_data);
 typedef bool (*SdsVersionMismatchCallback)(
     const char* table_type,
@@ -115,10 +220,21 @@ typedef struct {
     bool error;
 } SdsJsonWriter;
 
+/* Must match SdsJsonSpan / SdsJsonReader in sds_json.h */
+typedef struct {
+    uint16_t key;
+    uint16_t key_len;
+    uint16_t value;
+} SdsJsonSpan;
+
 typedef struct {
     const char* json;
     size_t len;
     size_t pos;
+    SdsJsonSpan* index;
+    uint16_t index_cap;
+    uint16_t index_count;
+    uint8_t index_state;
 } SdsJsonReader;
 
 /* Serialization function pointers (used internally) */
@@ -144,8 +260,29 @@ typedef struct {
     SdsFieldType type;
     uint16_t offset;
     uint16_t size;
+    float deadband;
+    float hysteresis;
+    uint32_t min_interval_ms;
+    uint8_t precision;
 } SdsFieldMeta;
 
+typedef enum {
+    SDS_AGG_COUNT = 0,
+    SDS_AGG_COUNT_ONLINE,
+    SDS_AGG_MIN,
+    SDS_AGG_MAX,
+    SDS_AGG_SUM,
+    SDS_AGG_MEAN,
+    SDS_AGG_PERCENTILE,
+} SdsAggregateOp;
+
+typedef struct {
+    const char* target;
+    SdsAggregateOp op;
+    const char* source;
+    uint8_t percentile;
+} SdsAggregateMeta;
+
 /* ============== Table Metadata ============== */
 
 typedef struct {
@@ -177,7 +314,12 @@ typedef struct {
     size_t slot_last_seen_offset;
     size_t slot_eviction_deadline_offset;
     size_t slot_status_offset;
-    uint8_t own_max_status_slots;
+    uint32_t own_max_status_slots;
+    uint8_t own_status_count_size;
+    uint8_t own_status_slots_external;
+    size_t own_status_history_offset;
+    uint16_t own_status_history_depth;
+    size_t slot_seq_offset;
     
     SdsSerializeFunc serialize_config;
     SdsSerializeFunc serialize_state;
@@ -194,6 +336,13 @@ typedef struct {
     uint8_t state_field_count;
     const SdsFieldMeta* status_fields;
     uint8_t status_field_count;
+    
+    /* Aggregates of a summary table */
+    const char* aggregate_source;
+    const SdsAggregateMeta* aggregates;
+    uint8_t aggregate_count;
+    size_t aggregate_storage_offset;
+    size_t aggregate_storage_size;
 } SdsTableMeta;
 
 const SdsTableMeta* sds_find_table_meta(const char* table_type);
@@ -202,7 +351,10 @@ void sds_set_table_registry(const SdsTableMeta* registry, size_t count);
 /* ============== Initialization API ============== */
 
 SdsError sds_init(const SdsConfig* config);
+size_t sds_table_arena_size(uint8_t max_tables, size_t section_bytes);
+size_t sds_config_arena_size(const SdsConfig* config, size_t section_bytes);
 void sds_loop(void);
+uint32_t sds_next_deadline_ms(void);
 void sds_shutdown(void);
 bool sds_is_ready(void);
 bool sds_is_connected(void);
@@ -211,8 +363,16 @@ typedef void (*SdsRawMessageCallback)(const char* topic, const uint8_t* payload,
 extern "Python" void _raw_message_callback(const char* topic, const uint8_t* payload, size_t payload_len, void* user_data);
 SdsError sds_subscribe_raw(const char* topic, SdsRawMessageCallback callback, void* user_data);
 SdsError sds_unsubscribe_raw(const char* topic);
+size_t sds_raw_subscription_storage_size(uint16_t max_subscriptions);
+SdsError sds_set_raw_subscription_storage(void* storage, uint16_t max_subscriptions);
+SdsError sds_publish_batched(const char* topic, const void* payload, size_t payload_len);
+SdsError sds_flush_batch(void);
 const char* sds_get_node_id(void);
 const SdsStats* sds_get_stats(void);
+SdsError sds_get_table_stats(const char* table_type, SdsTableStats* out);
+void sds_get_loop_stats(SdsLoopStats* out);
+void sds_reset_stats(void);
+uint32_t sds_latency_percentile(const SdsLatencyHistogram* h, uint8_t percent);
 
 /* ============== Table Registration API ============== */
 
@@ -239,8 +399,19 @@ SdsError sds_register_table_ex(
     SdsDeserializeFunc deserialize_status
 );
 
+SdsError sds_set_table_fields(
+    const char* table_type,
+    const SdsFieldMeta* config_fields, uint8_t config_field_count,
+    const SdsFieldMeta* state_fields, uint8_t state_field_count,
+    const SdsFieldMeta* status_fields, uint8_t status_field_count
+);
+
+SdsError sds_mark_dirty(const char* table_type, SdsSection section, uint8_t field_idx);
+
 SdsError sds_unregister_table(const char* table_type);
 uint8_t sds_get_table_count(void);
+SdsError sds_lock_table(const char* table_type);
+SdsError sds_unlock_table(const char* table_type);
 
 /* ============== Event Callbacks ============== */
 
@@ -248,6 +419,7 @@ void sds_on_config_update(const char* table_type, SdsConfigCallback callback, vo
 void sds_on_state_update(const char* table_type, SdsStateCallback callback, void* user_data);
 void sds_on_status_update(const char* table_type, SdsStatusCallback callback, void* user_data);
 void sds_on_error(SdsErrorCallback callback);
+void sds_on_wake(SdsWakeCallback callback, void* user_data);
 void sds_on_version_mismatch(SdsVersionMismatchCallback callback);
 
 const char* sds_get_schema_version(void);
@@ -268,13 +440,210 @@ void sds_foreach_node(
     void* user_data
 );
 
+typedef enum {
+    SDS_SNAPSHOT_ROWS = 0,
+    SDS_SNAPSHOT_COLUMNS = 1
+} SdsSnapshotLayout;
+
+typedef struct {
+    char node_id[32];
+    uint32_t last_seen_ms;
+    bool online;
+    bool eviction_pending;
+} SdsSnapshotRow;
+
+typedef struct {
+    uint32_t rows;
+    size_t row_size;
+} SdsSnapshotInfo;
+
+size_t sds_snapshot_size(const char* table_type, SdsSnapshotLayout layout);
+
+SdsError sds_snapshot_status(
+    const void* owner_table,
+    const char* table_type,
+    SdsSnapshotLayout layout,
+    void* buffer,
+    size_t buffer_size,
+    SdsSnapshotInfo* info
+);
+
+const void* sds_snapshot_column(const void* buffer, const char* table_type, uint16_t column);
+
+typedef uint32_t SdsSeqlock;
+
+SdsError sds_set_owner_slot_seqlocks(
+    const char* table_type,
+    SdsSeqlock* counters,
+    uint32_t count
+);
+
+bool sds_read_node_status(
+    const void* owner_table,
+    const char* table_type,
+    const char* node_id,
+    void* status_out,
+    size_t status_size,
+    SdsSnapshotRow* node_out
+);
+
+typedef void (*SdsNodeCopyIterator)(const SdsSnapshotRow* node, const void* status, void* user_data);
+
+uint32_t sds_foreach_node_copy(
+    const void* owner_table,
+    const char* table_type,
+    SdsNodeCopyIterator callback,
+    void* user_data
+);
+
+typedef struct {
+    char name[32];
+    uint8_t type;
+    uint8_t reserved;
+    uint16_t offset;
+    uint16_t size;
+    uint16_t reserved2;
+} SdsShmField;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t segment_size;
+    uint32_t state;
+    uint32_t clock_ms;
+    char table_type[32];
+    char schema_version[32];
+    char owner_node_id[32];
+    uint32_t max_slots;
+    uint32_t slot_size;
+    uint32_t slot_valid_offset;
+    uint32_t slot_online_offset;
+    uint32_t slot_last_seen_offset;
+    uint32_t slot_eviction_pending_offset;
+    uint32_t slot_status_offset;
+    uint32_t status_size;
+    uint32_t field_count;
+    uint32_t fields_offset;
+    uint32_t seqlocks_offset;
+    uint32_t slots_offset;
+} SdsShmHeader;
+
+SdsError sds_export_owner_table(const char* table_type, const char* name);
+SdsError sds_unexport_owner_table(const char* table_type);
+
+typedef struct {
+    const SdsShmHeader* header;
+    const SdsShmField* fields;
+    const uint8_t* slots;
+    size_t size;
+} SdsSharedTable;
+
+SdsError sds_shared_table_attach(const char* name, SdsSharedTable* table);
+void sds_shared_table_detach(SdsSharedTable* table);
+
+bool sds_shared_table_read(
+    const SdsSharedTable* table,
+    const char* node_id,
+    void* status_out,
+    size_t status_size,
+    SdsSnapshotRow* node_out
+);
+
+uint32_t sds_shared_table_foreach(
+    const SdsSharedTable* table,
+    SdsNodeCopyIterator callback,
+    void* user_data
+);
+
+typedef void (*SdsStatusSampleIterator)(uint32_t timestamp_ms, const void* status, void* user_data);
+
+size_t sds_status_history_size(const char* table_type, uint16_t depth);
+
+SdsError sds_set_owner_status_history(
+    const char* table_type,
+    void* storage,
+    size_t storage_size,
+    uint16_t depth
+);
+
+uint32_t sds_foreach_status_sample(
+    const char* table_type,
+    const char* node_id,
+    uint32_t max_age_ms,
+    SdsStatusSampleIterator callback,
+    void* user_data
+);
+
+size_t sds_status_history_columns_size(const char* table_type);
+
+SdsError sds_status_history_columns(
+    const char* table_type,
+    const char* node_id,
+    uint32_t max_age_ms,
+    void* buffer,
+    size_t buffer_size,
+    uint32_t* count
+);
+
+const void* sds_status_history_column(const void* buffer, const char* table_type, uint16_t column);
+
+size_t sds_aggregate_storage_size(
+    const char* source_type,
+    const SdsAggregateMeta* aggregates,
+    uint8_t count
+);
+
+SdsError sds_set_table_aggregates(
+    const char* summary_type,
+    const char* source_type,
+    const SdsAggregateMeta* aggregates,
+    uint8_t count,
+    void* storage,
+    size_t storage_size
+);
+
 void sds_set_owner_status_slots(
     const char* table_type,
     size_t slots_offset,
     size_t slot_size,
     size_t slot_status_offset,
     size_t count_offset,
-    uint8_t max_slots
+    uint32_t max_slots
+);
+
+typedef enum {
+    SDS_SLOTS_INLINE = 0,
+    SDS_SLOTS_EXTERNAL = 1
+} SdsSlotStorage;
+
+SdsError sds_set_owner_status_slots_wide(
+    const char* table_type,
+    SdsSlotStorage storage,
+    size_t slots_offset,
+    size_t slot_size,
+    size_t slot_status_offset,
+    size_t count_offset,
+    uint8_t count_size,
+    uint32_t max_slots
+);
+
+SdsError sds_set_owner_slot_index(
+    const char* table_type,
+    uint32_t* buckets,
+    uint32_t bucket_count
+);
+
+SdsError sds_set_owner_latency_slots(
+    const char* table_type,
+    SdsNodeLatency* nodes,
+    uint32_t count
+);
+
+bool sds_get_node_latency(
+    const char* table_type,
+    const char* node_id,
+    SdsNodeLatency* out
 );
 
 void sds_set_owner_slot_offsets(
@@ -295,11 +664,14 @@ uint32_t sds_get_liveness_interval(const char* table_type);
 
 uint32_t sds_get_eviction_grace(const char* table_type);
 void sds_on_device_evicted(const char* table_type, SdsDeviceEvictedCallback callback, void* user_data);
+uint8_t sds_cluster_member_for(const char* node_id);
+SdsError sds_set_cluster_membership(uint8_t members, uint8_t member);
 void sds_set_owner_eviction_offsets(
     const char* table_type,
     size_t eviction_pending_offset,
     size_t eviction_deadline_offset
 );
+void sds_set_owner_seq_offset(const char* table_type, size_t seq_offset);
 
 /* ============== JSON API (for advanced usage) ============== */
 
@@ -310,18 +682,31 @@ void sds_json_add_string(SdsJsonWriter* w, const char* key, const char* value);
 void sds_json_add_int(SdsJsonWriter* w, const char* key, int32_t value);
 void sds_json_add_uint(SdsJsonWriter* w, const char* key, uint32_t value);
 void sds_json_add_float(SdsJsonWriter* w, const char* key, float value);
+void sds_json_add_float_fixed(SdsJsonWriter* w, const char* key, float value, uint8_t decimals);
 void sds_json_add_bool(SdsJsonWriter* w, const char* key, bool value);
 const char* sds_json_get_string(SdsJsonWriter* w);
 size_t sds_json_get_length(SdsJsonWriter* w);
 bool sds_json_has_error(SdsJsonWriter* w);
+size_t sds_json_key_fragment(const char* key, char* out, size_t out_size);
+void sds_json_add_key(SdsJsonWriter* w, const char* fragment, size_t fragment_len);
+void sds_json_write_string(SdsJsonWriter* w, const char* value);
+void sds_json_write_int(SdsJsonWriter* w, int32_t value);
+void sds_json_write_uint(SdsJsonWriter* w, uint32_t value);
+void sds_json_write_float(SdsJsonWriter* w, float value);
+void sds_json_write_float_fixed(SdsJsonWriter* w, float value, uint8_t decimals);
+void sds_json_write_bool(SdsJsonWriter* w, bool value);
 
 void sds_json_reader_init(SdsJsonReader* r, const char* json, size_t len);
+bool sds_json_reader_init_indexed(SdsJsonReader* r, const char* json, size_t len,
+                                  SdsJsonSpan* spans, uint16_t span_count);
 const char* sds_json_find_field(SdsJsonReader* r, const char* key);
+const char* sds_json_find_field_n(SdsJsonReader* r, const char* key, size_t key_len);
 bool sds_json_parse_string(const char* value, char* out, size_t out_size);
 bool sds_json_parse_int(const char* value, int32_t* out);
 bool sds_json_parse_uint(const char* value, uint32_t* out);
 bool sds_json_parse_float(const char* value, float* out);
 bool sds_json_parse_bool(const char* value, bool* out);
+bool sds_json_parse_string_in(SdsJsonReader* r, const char* value, char* out, size_t out_size);
 bool sds_json_get_string_field(SdsJsonReader* r, const char* key, char* out, size_t out_size);
 bool sds_json_get_int_field(SdsJsonReader* r, const char* key, int32_t* out);
 bool sds_json_get_uint_field(SdsJsonReader* r, const char* key, uint32_t* out);
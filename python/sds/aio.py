@@ -0,0 +1,281 @@
+"""
+AsyncSdsNode - asyncio integration for SDS.
+
+Runs an SdsNode from an asyncio event loop without busy-polling:
+
+- sds_loop() runs in the loop's default executor, so the event loop keeps
+  running while the C library publishes or applies messages (the GIL is
+  released while in C).
+- Between iterations the node sleeps until the next scheduled deadline
+  (next_deadline_ms()) or until the C library reports a received message
+  through its wake callback.
+- Config, state, status and eviction callbacks only record an SdsEvent;
+  the events of one iteration are then handed to the application in one
+  batch, through an asyncio.Queue, outside the node lock. Slow handlers
+  delay nothing but their own task.
+
+Example:
+    >>> import asyncio
+    >>> from sds import Role
+    >>> from sds.aio import AsyncSdsNode
+    >>>
+    >>> async def main():
+    ...     async with AsyncSdsNode("owner", "localhost") as node:
+    ...         node.register_table("SensorData", Role.OWNER)
+    ...         async for event in node.events():
+    ...             print(event.kind, event.table_type, event.node_id)
+    >>>
+    >>> asyncio.run(main())
+"""
+from __future__ import annotations
+
+import asyncio
+import logging
+from collections import deque
+from typing import Any, AsyncIterator, Deque, List, NamedTuple, Optional
+
+from sds.node import SdsNode
+from sds.table import SdsTable
+from sds.types import Role
+
+# Module logger
+logger = logging.getLogger(__name__)
+
+# Longest sleep between iterations when nothing is scheduled
+DEFAULT_MAX_WAIT_MS = 1000
+
+
+class SdsEvent(NamedTuple):
+    """A table event delivered by AsyncSdsNode."""
+
+    kind: str                 # "config", "state", "status" or "evicted"
+    table_type: str
+    node_id: Optional[str]    # Sending or evicted device (None for config)
+
+
+class AsyncSdsNode:
+    """
+    asyncio front end for an SdsNode.
+
+    Takes the same arguments as SdsNode (auto_init is ignored; the node
+    connects in start() or when entering ``async with``). Attributes and
+    methods not defined here, such as get_stats() or publish_raw(), are
+    those of the wrapped SdsNode.
+
+    Events replace SdsNode's on_config/on_state/on_status/on_device_evicted
+    decorators, which this class uses itself.
+    """
+
+    def __init__(
+        self,
+        node_id: str,
+        broker_host: str,
+        port: int = 1883,
+        *,
+        max_events: int = 0,
+        max_wait_ms: int = DEFAULT_MAX_WAIT_MS,
+        **kwargs: Any,
+    ):
+        """
+        Create an asyncio SDS node.
+
+        Args:
+            node_id: Unique identifier for this node (max 31 characters)
+            broker_host: MQTT broker hostname or IP address
+            port: MQTT broker port (default: 1883)
+            max_events: Capacity of the event queue (default: 0 = unbounded).
+                        When full, the oldest event is dropped and counted
+                        in events_dropped.
+            max_wait_ms: Longest sleep between iterations when nothing is
+                         scheduled (default: 1000)
+            **kwargs: Other SdsNode arguments
+        """
+        kwargs["auto_init"] = False
+        self._node = SdsNode(node_id, broker_host, port, **kwargs)
+        self._max_events = max_events
+        self._max_wait_ms = max_wait_ms
+
+        # Filled from C callbacks on any thread; drained by the driver task
+        self._pending: Deque[SdsEvent] = deque()
+        self._wake_scheduled = False
+
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self._wake_event: Optional[asyncio.Event] = None
+        self._queue: Optional[asyncio.Queue] = None
+        self._task: Optional[asyncio.Task] = None
+        self._closing = False
+        self.events_dropped = 0
+
+    @property
+    def node(self) -> SdsNode:
+        """The wrapped SdsNode."""
+        return self._node
+
+    def __getattr__(self, name: str) -> Any:
+        # Only called for attributes not found on AsyncSdsNode itself
+        if name == "_node":
+            raise AttributeError(name)
+        return getattr(self._node, name)
+
+    # ============== Lifecycle ==============
+
+    async def start(self) -> None:
+        """
+        Connect and start the driver task.
+
+        Raises:
+            SdsError: If initialization fails after all retries
+        """
+        self._loop = asyncio.get_running_loop()
+        self._wake_event = asyncio.Event()
+        self._queue = asyncio.Queue(self._max_events)
+        self._closing = False
+
+        # Connecting retries with blocking sleeps; keep them off the loop
+        await self._loop.run_in_executor(None, self._node.init)
+
+        self._node._wake_listeners.append(self._wake)
+        self._node.on_device_evicted()(self._on_evicted)
+        self._task = self._loop.create_task(self._run())
+
+    async def close(self) -> None:
+        """Stop the driver task and shut the node down. Safe to call twice."""
+        self._closing = True
+        if self._task is not None:
+            self._wake_event.set()  # type: ignore[union-attr]
+            await self._task
+            self._task = None
+            # End of stream for events() and get_event()
+            self._pending.append(None)  # type: ignore[arg-type]
+            self._deliver()
+        if self._wake in self._node._wake_listeners:
+            self._node._wake_listeners.remove(self._wake)
+        loop = self._loop or asyncio.get_running_loop()
+        await loop.run_in_executor(None, self._node.shutdown)
+
+    async def __aenter__(self) -> "AsyncSdsNode":
+        await self.start()
+        return self
+
+    async def __aexit__(self, exc_type: Any, exc_val: Any, exc_tb: Any) -> None:
+        await self.close()
+
+    # ============== Tables ==============
+
+    def register_table(self, table_type: str, role: Role, **kwargs: Any) -> SdsTable:
+        """
+        Register a table and deliver its events.
+
+        Owners receive "state" and "status" events, devices "config" events.
+        Takes the same keyword arguments as SdsNode.register_table().
+
+        Returns:
+            The SdsTable
+        """
+        table = self._node.register_table(table_type, role, **kwargs)
+        if role == Role.OWNER:
+            self._node.on_state(table_type)(self._on_state)
+            self._node.on_status(table_type)(self._on_status)
+        else:
+            self._node.on_config(table_type)(self._on_config)
+        return table
+
+    # ============== Events ==============
+
+    async def get_event(self) -> Optional[SdsEvent]:
+        """Wait for the next event (None once the node is closed)."""
+        event = await self._events().get()
+        if event is None:
+            self._queue.put_nowait(None)  # type: ignore[union-attr]
+        return event
+
+    async def get_events(self) -> List[SdsEvent]:
+        """
+        Wait for at least one event and return every event queued so far.
+
+        Events from one iteration of the node arrive together, so this
+        returns them as one batch. Returns [] once the node is closed.
+        """
+        queue = self._events()
+        batch = [await queue.get()]
+        while not queue.empty() and batch[-1] is not None:
+            batch.append(queue.get_nowait())
+        if batch[-1] is None:
+            queue.put_nowait(None)
+            batch.pop()
+        return batch
+
+    async def events(self) -> AsyncIterator[SdsEvent]:
+        """Iterate over events until the node is closed."""
+        while True:
+            event = await self.get_event()
+            if event is None:
+                return
+            yield event
+
+    def _events(self) -> asyncio.Queue:
+        if self._queue is None:
+            raise RuntimeError("AsyncSdsNode is not started")
+        return self._queue
+
+    # ============== Driver ==============
+
+    async def _run(self) -> None:
+        """Run sds_loop() whenever a message arrived or work is due."""
+        assert self._loop is not None and self._wake_event is not None
+        node = self._node
+        while not self._closing:
+            # Reset before polling: wakes from here on start another pass
+            self._wake_scheduled = False
+            self._wake_event.clear()
+            try:
+                await self._loop.run_in_executor(None, node.poll)
+            except Exception:
+                logger.exception("Error in poll")
+            self._deliver()
+
+            deadline = node.next_deadline_ms()
+            wait_ms = self._max_wait_ms if deadline is None else min(deadline, self._max_wait_ms)
+            if wait_ms <= 0 or self._pending or self._closing:
+                await asyncio.sleep(0)
+                continue
+            try:
+                await asyncio.wait_for(self._wake_event.wait(), wait_ms / 1000.0)
+            except asyncio.TimeoutError:
+                pass
+        self._deliver()
+
+    def _deliver(self) -> None:
+        """Move this iteration's events to the queue."""
+        queue = self._queue
+        assert queue is not None
+        while self._pending:
+            event = self._pending.popleft()
+            if queue.full():
+                queue.get_nowait()
+                self.events_dropped += 1
+            queue.put_nowait(event)
+
+    def _wake(self) -> None:
+        """Wake the driver task; safe from any thread."""
+        loop = self._loop
+        if loop is None or self._wake_scheduled or loop.is_closed():
+            return
+        self._wake_scheduled = True
+        loop.call_soon_threadsafe(self._wake_event.set)  # type: ignore[union-attr]
+
+    def _push(self, event: SdsEvent) -> None:
+        self._pending.append(event)
+        self._wake()
+
+    def _on_config(self, table_type: str) -> None:
+        self._push(SdsEvent("config", table_type, None))
+
+    def _on_state(self, table_type: str, from_node: str) -> None:
+        self._push(SdsEvent("state", table_type, from_node))
+
+    def _on_status(self, table_type: str, from_node: str) -> None:
+        self._push(SdsEvent("status", table_type, from_node))
+
+    def _on_evicted(self, table_type: str, node_id: str) -> None:
+        self._push(SdsEvent("evicted", table_type, node_id))
@@ -15,21 +15,45 @@ import logging
 import threading
 import time
 import weakref
-from typing import Any, Callable, Dict, Optional, Type, Union, TYPE_CHECKING
+from typing import Any, Callable, Dict, List, Optional, Type, Union, TYPE_CHECKING
 
-from sds.types import Role, ErrorCode, SdsError, SdsMqttError, SdsValidationError, check_error
+from sds.types import (
+    Role, ErrorCode, SdsError, SdsMqttError, SdsValidationError, OutboundPolicy, WireFormat, check_error
+)
 
 # Maximum node ID length (matches C library SDS_MAX_NODE_ID_LEN - 1 for null terminator)
 MAX_NODE_ID_LEN = 31
 
+# Default table sync interval (matches C library SDS_DEFAULT_SYNC_INTERVAL_MS)
+DEFAULT_SYNC_INTERVAL_MS = 1000
+
+# Bucket count of the C library's built-in status slot index (SDS_SLOT_INDEX_SIZE)
+SLOT_INDEX_BUILTIN_SIZE = 256
+
 # Module logger
 logger = logging.getLogger(__name__)
 
+# Per-table counters reported by get_stats() with enable_instrumentation
+_TABLE_COUNTERS = (
+    "messages_sent", "bytes_sent", "messages_received", "bytes_received",
+    "full_syncs", "delta_syncs", "buffer_full", "slots_full", "decode_errors",
+)
+
+
+def _histogram_dict(h: Any) -> Dict[str, Any]:
+    """Convert an SdsLatencyHistogram to a plain dict."""
+    return {
+        "count": h.count,
+        "total_us": h.total_us,
+        "max_us": h.max_us,
+        "buckets": list(h.buckets),
+    }
+
 # Import CFFI bindings (will fail if extension not built)
 from sds._bindings import ffi, lib, encode_string, decode_string
 
 # Import table wrapper (import here to avoid circular imports)
-from sds.table import SdsTable
+from sds.table import SdsTable, TableLock
 
 
 # Type aliases for callbacks
@@ -88,6 +112,21 @@ class SdsNode:
         eviction_grace_ms: int = 0,
         enable_delta_sync: bool = False,
         delta_float_tolerance: float = 0.001,
+        outbound_queue_depth: int = 0,
+        outbound_policy: OutboundPolicy = OutboundPolicy.COALESCE,
+        max_tables: Optional[int] = None,
+        inbound_queue_depth: int = 0,
+        ingest_workers: int = 0,
+        batch_max_bytes: int = 0,
+        batch_flush_ms: int = 0,
+        enable_instrumentation: bool = False,
+        enable_latency_tracking: bool = False,
+        enable_config_cache: bool = False,
+        cluster_group: Optional[str] = None,
+        cluster_members: int = 0,
+        cluster_member: int = 0,
+        persistent_session: bool = False,
+        keyframe_interval: int = 0,
     ):
         """
         Create an SDS node.
@@ -111,6 +150,48 @@ class SdsNode:
                               changed since the last sync, reducing bandwidth usage.
             delta_float_tolerance: Float comparison tolerance for delta sync (default: 0.001)
                                   Float values within this tolerance are considered unchanged.
+            outbound_queue_depth: Sync messages buffered for the background sender thread
+                                  (default: 0 = publish from loop(); max SDS_OUTBOUND_QUEUE_MAX)
+            outbound_policy: What to drop when the outbound queue is full
+                             (default: OutboundPolicy.COALESCE)
+            max_tables: Table capacity (default: None = built-in SDS_MAX_TABLES).
+                        When set, an arena for that many tables is allocated.
+            inbound_queue_depth: Received messages buffered per node before they are
+                                 applied (default: 0 = apply on receive;
+                                 max SDS_INBOUND_QUEUE_MAX)
+            ingest_workers: Native threads applying queued messages, one table each at
+                            a time (default: 0 = applied by loop()). Python callbacks
+                            still run from loop().
+            batch_max_bytes: Combine state/status messages into one sds/batch/<node_id>
+                             message of up to this many bytes (default: 0 = publish
+                             each; max SDS_MSG_BUFFER_SIZE). Owners need it too, to
+                             subscribe to batches.
+            batch_flush_ms: Longest a message waits in a batch (default: 0 = sent at
+                            the end of the loop() that queued it)
+            enable_instrumentation: Keep per-table counters and latency histograms,
+                                    reported by get_stats() (default: False)
+            enable_latency_tracking: Estimate each device's clock offset and record
+                                     publish-to-apply latency (get_node_latency(),
+                                     "propagation_ms" in get_stats()). Enable on
+                                     owners and devices alike (default: False)
+            enable_config_cache: Devices save each applied config (under
+                                 $SDS_STORAGE_DIR, default ./.sds) and start from
+                                 it at register_table(); identical configs are
+                                 then skipped without parsing (default: False)
+            cluster_group: Owners subscribe through $share/<group>/ so the broker
+                           delivers each message to one member (default: None).
+                           The broker must keep each device on one member.
+            cluster_members: Owners in a cluster partitioning devices by node_id
+                             (default: 0 = off); see cluster_member_for()
+            cluster_member: This owner's index, 0 to cluster_members - 1
+            persistent_session: Keep the broker session across reconnects so
+                                subscriptions need not be re-sent (requires a
+                                stable node_id; default: False)
+            keyframe_interval: With delta sync, send every Nth status message
+                               in full; owners request one early when they
+                               miss a message. Owners likewise publish every
+                               Nth config change as a full baseline
+                               (default: 0 = 10)
         
         Raises:
             SdsValidationError: If node_id is invalid
@@ -142,6 +223,21 @@ class SdsNode:
         self._eviction_grace_ms = eviction_grace_ms
         self._enable_delta_sync = enable_delta_sync
         self._delta_float_tolerance = delta_float_tolerance
+        self._outbound_queue_depth = outbound_queue_depth
+        self._outbound_policy = outbound_policy
+        self._max_tables = max_tables
+        self._inbound_queue_depth = inbound_queue_depth
+        self._ingest_workers = ingest_workers
+        self._batch_max_bytes = batch_max_bytes
+        self._batch_flush_ms = batch_flush_ms
+        self._enable_instrumentation = enable_instrumentation
+        self._enable_latency_tracking = enable_latency_tracking
+        self._enable_config_cache = enable_config_cache
+        self._cluster_group = cluster_group
+        self._cluster_members = cluster_members
+        self._cluster_member = cluster_member
+        self._persistent_session = persistent_session
+        self._keyframe_interval = keyframe_interval
         
         # Thread safety lock - reentrant to allow nested calls
         self._lock = threading.RLock()
@@ -157,13 +253,21 @@ class SdsNode:
         self._version_mismatch_callback: Optional[VersionMismatchCallback] = None
         self._eviction_callback: Optional[DeviceEvictedCallback] = None
         
-        # Raw subscription callback storage
+        # Raw subscription callbacks by pattern. The C trie does the matching
+        # and hands back a handle to the pattern as user_data.
         self._raw_callbacks: Dict[str, Callable[[str, bytes], None]] = {}
+        self._raw_handles: Dict[str, Any] = {}
         self._raw_callback_handle: Optional[Any] = None
+        self._raw_storage: Optional[Any] = None
         
         # Keep C callback handles alive
         self._c_callbacks: Dict[str, Any] = {}
         
+        # Set from the C wake callback when a message arrives (any thread);
+        # poll(timeout_ms) waits on it. Listeners let event loops wake too.
+        self._wake = threading.Event()
+        self._wake_listeners: List[Callable[[], None]] = []
+        
         # Register this instance
         SdsNode._instances.add(self)
         
@@ -249,6 +353,39 @@ class SdsNode:
             config.enable_delta_sync = self._enable_delta_sync
             config.delta_float_tolerance = self._delta_float_tolerance
             
+            # Set outbound queue configuration
+            config.outbound_queue_depth = self._outbound_queue_depth
+            config.outbound_policy = int(self._outbound_policy)
+            
+            # Workers apply messages natively; Python callbacks stay on loop()
+            config.inbound_queue_depth = self._inbound_queue_depth
+            config.ingest_workers = self._ingest_workers
+            config.callback_executor = lib.SDS_CALLBACKS_LOOP
+            
+            # Set batch envelope configuration
+            config.batch_max_bytes = self._batch_max_bytes
+            config.batch_flush_ms = self._batch_flush_ms
+            config.enable_instrumentation = self._enable_instrumentation
+            config.enable_latency_tracking = self._enable_latency_tracking
+            config.enable_config_cache = self._enable_config_cache
+            config.persistent_session = self._persistent_session
+            config.keyframe_interval = self._keyframe_interval
+            
+            # Owner cluster: shared subscriptions or node_id partitioning
+            if self._cluster_group:
+                self._config_cluster_group = ffi.new("char[]", self._cluster_group.encode("utf-8"))
+                config.cluster_group = self._config_cluster_group
+            config.cluster_members = self._cluster_members
+            config.cluster_member = self._cluster_member
+            
+            # Table capacity beyond the built-in arena gets its own arena
+            if self._max_tables:
+                config.max_tables = self._max_tables
+                arena_size = lib.sds_config_arena_size(config, 0)
+                self._table_arena = ffi.new(f"uint8_t[{arena_size}]")
+                config.table_arena = self._table_arena
+                config.table_arena_size = arena_size
+            
             # Keep config struct alive
             self._config = config
             
@@ -264,6 +401,7 @@ class SdsNode:
                     result = lib.sds_init(config)
                     check_error(result)
                     self._initialized = True
+                    self._setup_wake_callback()
                     if attempt > 0:
                         logger.info(f"Connected to MQTT broker after {attempt + 1} attempts")
                     return
@@ -298,6 +436,9 @@ class SdsNode:
                 lib.sds_shutdown()
                 self._initialized = False
                 self._tables.clear()
+                self._raw_callbacks.clear()
+                self._raw_handles.clear()
+                self._raw_storage = None
                 
                 if SdsNode._current_instance is self:
                     SdsNode._current_instance = None
@@ -409,6 +550,52 @@ class SdsNode:
             )
             return result == 0  # SDS_OK
     
+    def publish_batched(self, topic: str, payload: Union[str, bytes]) -> None:
+        """
+        Relay a state or status message through this node's batch envelope.
+        
+        For gateways publishing on behalf of other nodes: the message joins
+        the sds/batch/<node_id> envelope and owners apply it as if it had
+        been published on topic. Without batching it is published on topic.
+        
+        Thread-safe.
+        
+        Args:
+            topic: "sds/<table_type>/state" or "sds/<table_type>/status/<node_id>"
+            payload: Serialized section (string or bytes)
+        
+        Raises:
+            SdsError: If SDS is not initialized, topic is not a state/status
+                      topic, or the message was dropped
+        
+        Example:
+            >>> gateway.publish_batched("sds/SensorData/status/leaf_07",
+            ...                         '{"online": true, "battery": 80}')
+        """
+        if isinstance(payload, str):
+            payload_bytes = payload.encode('utf-8')
+        else:
+            payload_bytes = payload
+        
+        with self._lock:
+            if not self._initialized:
+                raise SdsError.from_code(ErrorCode.NOT_INITIALIZED)
+            
+            result = lib.sds_publish_batched(topic.encode('utf-8'), payload_bytes, len(payload_bytes))
+            if result != 0:
+                raise SdsError.from_code(result)
+    
+    def flush_batch(self) -> None:
+        """
+        Publish the pending batch envelope now.
+        
+        Thread-safe.
+        """
+        with self._lock:
+            if not self._initialized:
+                raise SdsError.from_code(ErrorCode.NOT_INITIALIZED)
+            lib.sds_flush_batch()
+    
     def subscribe_raw(
         self,
         topic: str,
@@ -419,6 +606,9 @@ class SdsNode:
         Subscribe to an MQTT topic for raw message reception.
         
         Messages received on matching topics will be delivered to the callback.
+        Matching is done by the C library's topic trie, once per message, and
+        subscription storage grows as needed. Subscribing to the same pattern
+        again replaces its callback.
         
         Thread-safe.
         
@@ -432,7 +622,7 @@ class SdsNode:
         
         Raises:
             ValueError: If topic is empty or starts with "sds/"
-            SdsError: If SDS is not initialized or max subscriptions reached
+            SdsError: If SDS is not initialized
         
         Note:
             Topics starting with "sds/" are reserved and will be rejected.
@@ -451,39 +641,48 @@ class SdsNode:
             if not self._initialized:
                 raise SdsError.from_code(ErrorCode.NOT_INITIALIZED)
             
-            # Store callback in our registry
-            self._raw_callbacks[topic] = callback
+            # Already subscribed in C: only the callback changes
+            if topic in self._raw_callbacks:
+                self._raw_callbacks[topic] = callback
+                return True
             
             # Create C callback wrapper if not already done
             if self._raw_callback_handle is None:
                 @ffi.callback("SdsRawMessageCallback")
                 def raw_callback_wrapper(c_topic, c_payload, payload_len, user_data):
                     try:
-                        topic_str = ffi.string(c_topic).decode('utf-8')
-                        payload_bytes = bytes(ffi.buffer(c_payload, payload_len))
-                        # Find matching callback
-                        for pattern, cb in self._raw_callbacks.items():
-                            if self._topic_matches(pattern, topic_str):
-                                cb(topic_str, payload_bytes)
+                        # user_data identifies the matched pattern
+                        cb = self._raw_callbacks.get(ffi.from_handle(user_data))
+                        if cb is not None:
+                            topic_str = ffi.string(c_topic).decode('utf-8')
+                            cb(topic_str, bytes(ffi.buffer(c_payload, payload_len)))
                     except Exception as e:
                         logger.error(f"Error in raw callback: {e}")
                 
                 self._raw_callback_handle = raw_callback_wrapper
             
             topic_bytes = topic.encode('utf-8')
-            result = lib.sds_subscribe_raw(
-                topic_bytes,
-                self._raw_callback_handle,
-                ffi.NULL
-            )
+            handle = ffi.new_handle(topic)
+            result = lib.sds_subscribe_raw(topic_bytes, self._raw_callback_handle, handle)
+            if result == ErrorCode.MAX_TABLES_REACHED and self._grow_raw_storage():
+                result = lib.sds_subscribe_raw(topic_bytes, self._raw_callback_handle, handle)
             
             if result != 0:
-                # Remove from our registry on failure
-                del self._raw_callbacks[topic]
                 return False
             
+            self._raw_callbacks[topic] = callback
+            self._raw_handles[topic] = handle
             return True
     
+    def _grow_raw_storage(self) -> bool:
+        """Move raw subscriptions to storage for twice as many."""
+        capacity = max(16, 2 * len(self._raw_callbacks))
+        storage = ffi.new(f"uint8_t[{lib.sds_raw_subscription_storage_size(capacity)}]")
+        if lib.sds_set_raw_subscription_storage(storage, capacity) != 0:
+            return False
+        self._raw_storage = storage
+        return True
+    
     def unsubscribe_raw(self, topic: str) -> bool:
         """
         Unsubscribe from a raw MQTT topic.
@@ -509,29 +708,11 @@ class SdsNode:
             if result == 0:
                 # Remove from our registry
                 self._raw_callbacks.pop(topic, None)
+                self._raw_handles.pop(topic, None)
                 return True
             
             return False
     
-    @staticmethod
-    def _topic_matches(pattern: str, topic: str) -> bool:
-        """Match an MQTT topic against a pattern with wildcards."""
-        pattern_parts = pattern.split('/')
-        topic_parts = topic.split('/')
-        
-        i = 0
-        for i, p in enumerate(pattern_parts):
-            if p == '#':
-                return True  # # matches everything remaining
-            if i >= len(topic_parts):
-                return False
-            if p == '+':
-                continue  # + matches any single level
-            if p != topic_parts[i]:
-                return False
-        
-        return len(pattern_parts) == len(topic_parts)
-    
     def poll(self, timeout_ms: int = 0) -> None:
         """
         Process MQTT messages and sync table changes.
@@ -540,20 +721,75 @@ class SdsNode:
         Callbacks are executed while holding the lock.
         
         Args:
-            timeout_ms: Not currently used (reserved for future async support)
+            timeout_ms: Longest to wait, without holding the lock, for a
+                        message or the next scheduled work (next_deadline_ms()),
+                        which is then processed before returning
+                        (default: 0 = process once and return)
         """
+        self._wake.clear()
+        self._loop_once()
+        if timeout_ms <= 0:
+            return
+        
+        deadline = self.next_deadline_ms()
+        wait_ms = timeout_ms if deadline is None else min(timeout_ms, deadline)
+        if self._wake.wait(wait_ms / 1000.0) or wait_ms < timeout_ms:
+            self._wake.clear()
+            self._loop_once()
+    
+    def _loop_once(self) -> None:
+        """Run one sds_loop() under the lock (the GIL is released while in C)."""
         with self._lock:
             if not self._initialized:
                 raise SdsError.from_code(ErrorCode.NOT_INITIALIZED)
             
             lib.sds_loop()
     
+    def _setup_wake_callback(self) -> None:
+        """Set up the C-level wake callback (runs on the MQTT client thread)."""
+        @ffi.callback("SdsWakeCallback")
+        def c_callback(user_data):
+            self._wake.set()
+            for listener in list(self._wake_listeners):
+                try:
+                    listener()
+                except Exception:
+                    logger.exception("Error in wake listener")
+        
+        # Keep callback alive
+        self._c_callbacks["wake"] = c_callback
+        lib.sds_on_wake(c_callback, ffi.NULL)
+    
+    def next_deadline_ms(self) -> Optional[int]:
+        """
+        Get the time until poll() next has scheduled work.
+        
+        Covers table syncs, liveness heartbeats, eviction grace periods and,
+        while disconnected, the next reconnect attempt. Incoming messages are
+        only processed by poll(), so cap any sleep at your latency budget.
+        
+        Returns:
+            Milliseconds until the next deadline (0 if due now), or None if
+            nothing is scheduled
+        """
+        with self._lock:
+            if not self._initialized:
+                return None
+            ms = lib.sds_next_deadline_ms()
+            return None if ms == 0xFFFFFFFF else ms
+    
     def register_table(
         self,
         table_type: str,
         role: Role,
         *,
         sync_interval_ms: Optional[int] = None,
+        wire_format: WireFormat = WireFormat.JSON,
+        dirty_tracking: bool = False,
+        sync_interval_min_ms: int = 0,
+        sync_interval_max_ms: int = 0,
+        liveness_max_ms: int = 0,
+        history: int = 0,
         schema: Optional[Type] = None,
         config_schema: Optional[Type] = None,
         state_schema: Optional[Type] = None,
@@ -569,6 +805,19 @@ class SdsNode:
             table_type: Name of the table type (must match schema)
             role: SDS_ROLE_OWNER or SDS_ROLE_DEVICE
             sync_interval_ms: Optional sync interval override
+            wire_format: Outbound encoding (WireFormat.BINARY needs the
+                        generated C registry; Python-only schemas use JSON)
+            dirty_tracking: Publish only fields written through the table's
+                           section proxies instead of comparing whole sections
+            sync_interval_min_ms: Adaptive sync: shortest interval
+                                 (0 = sync_interval_ms)
+            sync_interval_max_ms: Adaptive sync: longest interval; the
+                                 interval shrinks while sections change and
+                                 grows while idle (0 = fixed interval)
+            liveness_max_ms: Device: longest heartbeat gap while idle
+                            (0 = fixed liveness interval)
+            history: Owner: status samples kept per device for
+                    SdsTable.history() (0 = none, or the schema's @history)
             schema: Schema bundle class with Config/State/Status attributes
                    (generated by sds_codegen.py)
             config_schema: Optional dataclass defining config fields
@@ -603,6 +852,12 @@ class SdsNode:
                 table_type=table_type,
                 role=role,
                 sync_interval_ms=sync_interval_ms,
+                wire_format=wire_format,
+                dirty_tracking=dirty_tracking,
+                sync_interval_min_ms=sync_interval_min_ms,
+                sync_interval_max_ms=sync_interval_max_ms,
+                liveness_max_ms=liveness_max_ms,
+                history=history,
                 schema=schema,
                 config_schema=config_schema,
                 state_schema=state_schema,
@@ -615,6 +870,12 @@ class SdsNode:
         role: Role,
         *,
         sync_interval_ms: Optional[int] = None,
+        wire_format: WireFormat = WireFormat.JSON,
+        dirty_tracking: bool = False,
+        sync_interval_min_ms: int = 0,
+        sync_interval_max_ms: int = 0,
+        liveness_max_ms: int = 0,
+        history: int = 0,
         schema: Optional[Type] = None,
         config_schema: Optional[Type] = None,
         state_schema: Optional[Type] = None,
@@ -652,6 +913,11 @@ class SdsNode:
                 state_schema=state_schema,
                 status_schema=status_schema,
                 sync_interval_ms=sync_interval_ms,
+                dirty_tracking=dirty_tracking,
+                sync_interval_min_ms=sync_interval_min_ms,
+                sync_interval_max_ms=sync_interval_max_ms,
+                liveness_max_ms=liveness_max_ms,
+                history=history,
             )
         
         # Determine table size based on role
@@ -663,11 +929,21 @@ class SdsNode:
         # Allocate table structure
         table_buffer = ffi.new(f"char[{table_size}]")
         
+        # Large owner tables (@slot_storage = external) hold a pointer to
+        # the slot array; allocate it here so the C side never allocates.
+        slot_storage = None
+        slot_index = None
+        if role == Role.OWNER and table_meta.own_status_slots_external:
+            max_slots = table_meta.own_max_status_slots
+            slot_storage = ffi.new(f"char[{table_meta.slot_size * max_slots}]")
+            slots_ptr = ffi.cast("char**", table_buffer + table_meta.own_status_slots_offset)
+            slots_ptr[0] = slot_storage
+        
         # Prepare options
-        options = ffi.NULL
-        if sync_interval_ms is not None:
-            options = ffi.new("SdsTableOptions*")
-            options.sync_interval_ms = sync_interval_ms
+        options = self._table_options(
+            sync_interval_ms, wire_format, dirty_tracking,
+            sync_interval_min_ms, sync_interval_max_ms, liveness_max_ms,
+        )
         
         # Register
         result = lib.sds_register_table(
@@ -678,6 +954,26 @@ class SdsNode:
         )
         check_error(result)
         
+        # Give tables beyond the built-in index capacity their own buckets
+        # (power of two, load <= 3/4) so lookups stay O(1)
+        if slot_storage is not None:
+            buckets = 2
+            while buckets * 3 < max_slots * 4:
+                buckets *= 2
+            if buckets > SLOT_INDEX_BUILTIN_SIZE:
+                slot_index = ffi.new(f"uint32_t[{buckets}]")
+                check_error(lib.sds_set_owner_slot_index(
+                    table_type.encode("utf-8"), slot_index, buckets
+                ))
+        
+        latency_slots = None
+        history_storage = None
+        slot_seqlocks = None
+        if role == Role.OWNER:
+            latency_slots = self._attach_latency_slots(table_type, table_meta.own_max_status_slots)
+            history_storage = self._attach_status_history(table_type, history)
+            slot_seqlocks = self._attach_slot_seqlocks(table_type, table_meta.own_max_status_slots)
+        
         # Create table wrapper
         sds_table = SdsTable(
             table_type=table_type,
@@ -687,7 +983,8 @@ class SdsNode:
             config_schema=config_schema,
             state_schema=state_schema,
             status_schema=status_schema,
-            lock=self._lock,
+            lock=TableLock(self._lock, table_type),
+            dirty_tracking=dirty_tracking,
         )
         
         # Store table info
@@ -696,10 +993,67 @@ class SdsNode:
             "buffer": table_buffer,
             "meta": table_meta,
             "table": sds_table,
+            "slot_storage": slot_storage,
+            "slot_index": slot_index,
+            "latency_slots": latency_slots,
+            "history_storage": history_storage,
+            "slot_seqlocks": slot_seqlocks,
         }
         
         return sds_table
     
+    def _attach_latency_slots(self, table_type: str, max_slots: int) -> Any:
+        """Give an owner table per-device latency records (enable_latency_tracking)."""
+        if not self._enable_latency_tracking or max_slots <= 0:
+            return None
+        latency_slots = ffi.new(f"SdsNodeLatency[{max_slots}]")
+        check_error(lib.sds_set_owner_latency_slots(
+            table_type.encode("utf-8"), latency_slots, max_slots
+        ))
+        return latency_slots
+    
+    def _attach_slot_seqlocks(self, table_type: str, max_slots: int) -> Any:
+        """Give each device slot its own seqlock, so lock-free reads only retry on their device."""
+        if max_slots <= 0:
+            return None
+        slot_seqlocks = ffi.new(f"SdsSeqlock[{max_slots}]")
+        check_error(lib.sds_set_owner_slot_seqlocks(
+            table_type.encode("utf-8"), slot_seqlocks, max_slots
+        ))
+        return slot_seqlocks
+    
+    def _attach_status_history(self, table_type: str, depth: int) -> Any:
+        """Give an owner table a status history ring per device slot."""
+        if depth <= 0:
+            return None
+        size = lib.sds_status_history_size(table_type.encode("utf-8"), depth)
+        if size == 0:
+            raise SdsError(ErrorCode.INVALID_CONFIG, f"Table '{table_type}' has no status slots")
+        storage = ffi.new("uint32_t[]", (size + 3) // 4)
+        check_error(lib.sds_set_owner_status_history(
+            table_type.encode("utf-8"), storage, size, depth
+        ))
+        return storage
+    
+    @staticmethod
+    def _table_options(sync_interval_ms: Optional[int], wire_format: WireFormat,
+                       dirty_tracking: bool = False, sync_interval_min_ms: int = 0,
+                       sync_interval_max_ms: int = 0, liveness_max_ms: int = 0):
+        """Build SdsTableOptions, or NULL when every option is the default."""
+        if (sync_interval_ms is None and wire_format == WireFormat.JSON and not dirty_tracking
+                and not sync_interval_max_ms and not liveness_max_ms):
+            return ffi.NULL
+        options = ffi.new("SdsTableOptions*")
+        options.sync_interval_ms = (
+            sync_interval_ms if sync_interval_ms is not None else DEFAULT_SYNC_INTERVAL_MS
+        )
+        options.wire_format = int(wire_format)
+        options.dirty_tracking = dirty_tracking
+        options.sync_interval_min_ms = sync_interval_min_ms
+        options.sync_interval_max_ms = sync_interval_max_ms
+        options.liveness_max_ms = liveness_max_ms
+        return options
+    
     def _register_table_with_python_schema(
         self,
         table_type: str,
@@ -708,11 +1062,17 @@ class SdsNode:
         state_schema: Optional[Type] = None,
         status_schema: Optional[Type] = None,
         sync_interval_ms: Optional[int] = None,
+        dirty_tracking: bool = False,
+        sync_interval_min_ms: int = 0,
+        sync_interval_max_ms: int = 0,
+        liveness_max_ms: int = 0,
+        history: int = 0,
     ) -> "SdsTable":
         """
         Register a table using Python-only schemas (no C registry).
         
-        Uses sds_register_table_ex with CFFI callbacks for serialization.
+        Uses sds_register_table_ex without callbacks and attaches SdsFieldMeta
+        descriptors, so the C core serializes the sections directly.
         """
         from sds.tables import analyze_dataclass, TableSectionInfo
         
@@ -741,6 +1101,7 @@ class SdsNode:
         # - padding: 1 byte (for uint32 alignment)
         # - last_seen_ms: 4 bytes
         # - eviction_deadline: 4 bytes
+        # - status_seq: 4 bytes
         # - status: status_size bytes
         SDS_MAX_NODE_ID_LEN = 32
         slot_node_id_offset = 0
@@ -750,8 +1111,9 @@ class SdsNode:
         # padding at 35 for uint32 alignment
         slot_last_seen_offset = SDS_MAX_NODE_ID_LEN + 4  # 36 (aligned)
         slot_eviction_deadline_offset = SDS_MAX_NODE_ID_LEN + 8  # 40
-        slot_status_offset = SDS_MAX_NODE_ID_LEN + 12  # 44
-        slot_size = SDS_MAX_NODE_ID_LEN + 12 + status_size  # 44 + status_size
+        slot_seq_offset = SDS_MAX_NODE_ID_LEN + 12  # 44
+        slot_status_offset = SDS_MAX_NODE_ID_LEN + 16  # 48
+        slot_size = SDS_MAX_NODE_ID_LEN + 16 + status_size  # 48 + status_size
         max_slots = 8
         
         # For owner, add space for status_slots and count
@@ -769,17 +1131,18 @@ class SdsNode:
         # Allocate table buffer
         table_buffer = ffi.new(f"char[{table_size}]")
         
-        # Create serialization/deserialization callbacks
-        # We use closures to capture the schema info
-        serializers = self._create_serializers(config_info, state_info, status_info, table_buffer)
+        # Field descriptors for the core's schema serializer
+        config_fields = self._create_field_meta(config_info)
+        state_fields = self._create_field_meta(state_info)
+        status_fields = self._create_field_meta(status_info)
         
         # Prepare options
-        options = ffi.NULL
-        if sync_interval_ms is not None:
-            options = ffi.new("SdsTableOptions*")
-            options.sync_interval_ms = sync_interval_ms
+        options = self._table_options(
+            sync_interval_ms, WireFormat.JSON, dirty_tracking,
+            sync_interval_min_ms, sync_interval_max_ms, liveness_max_ms,
+        )
         
-        # Register using extended API
+        # Register using extended API (no callbacks: sections come from field metadata)
         result = lib.sds_register_table_ex(
             table_buffer,
             table_type.encode("utf-8"),
@@ -788,16 +1151,17 @@ class SdsNode:
             config_offset, config_size,
             state_offset, state_size,
             status_offset, status_size,
-            serializers["serialize_config"],
-            serializers["deserialize_config"],
-            serializers["serialize_state"],
-            serializers["deserialize_state"],
-            serializers["serialize_status"],
-            serializers["deserialize_status"],
+            ffi.NULL, ffi.NULL,
+            ffi.NULL, ffi.NULL,
+            ffi.NULL, ffi.NULL,
         )
         check_error(result)
         
-        # For owner, configure status slot tracking
+        # For owner, configure status slot tracking before metadata: attaching
+        # config fields publishes the owner's initial config
+        latency_slots = None
+        history_storage = None
+        slot_seqlocks = None
         if role == Role.OWNER:
             lib.sds_set_owner_status_slots(
                 table_type.encode("utf-8"),
@@ -819,6 +1183,18 @@ class SdsNode:
                 slot_eviction_pending_offset,
                 slot_eviction_deadline_offset,
             )
+            lib.sds_set_owner_seq_offset(table_type.encode("utf-8"), slot_seq_offset)
+            latency_slots = self._attach_latency_slots(table_type, max_slots)
+            history_storage = self._attach_status_history(table_type, history)
+            slot_seqlocks = self._attach_slot_seqlocks(table_type, max_slots)
+        
+        result = lib.sds_set_table_fields(
+            table_type.encode("utf-8"),
+            config_fields[0], config_fields[2],
+            state_fields[0], state_fields[2],
+            status_fields[0], status_fields[2],
+        )
+        check_error(result)
         
         # Create a fake table_meta for the SdsTable wrapper
         # We'll store the info we need directly
@@ -851,7 +1227,8 @@ class SdsNode:
             state_schema=state_schema,
             status_schema=status_schema,
             python_meta=fake_meta,  # Use Python-calculated offsets
-            lock=self._lock,
+            lock=TableLock(self._lock, table_type),
+            dirty_tracking=dirty_tracking,
         )
         
         # Store table info
@@ -860,127 +1237,52 @@ class SdsNode:
             "buffer": table_buffer,
             "meta": None,
             "table": sds_table,
-            "serializers": serializers,  # Keep alive
+            "field_meta": (config_fields, state_fields, status_fields),  # Keep alive
+            "latency_slots": latency_slots,
+            "history_storage": history_storage,
+            "slot_seqlocks": slot_seqlocks,
         }
         
         return sds_table
     
-    def _create_serializers(
-        self,
-        config_info: Optional["TableSectionInfo"],
-        state_info: Optional["TableSectionInfo"],
-        status_info: Optional["TableSectionInfo"],
-        table_buffer: Any,
-    ) -> Dict[str, Any]:
-        """Create CFFI callbacks for serialization."""
-        
-        def make_serialize(section_info: Optional["TableSectionInfo"]):
-            if section_info is None:
-                return ffi.NULL
-            
-            @ffi.callback("SdsSerializeFunc")
-            def serialize(section_ptr, writer_ptr):
-                try:
-                    # Read values from C buffer and write to JSON
-                    for field in section_info.fields:
-                        offset = field.offset
-                        ptr = ffi.cast("char*", section_ptr) + offset
-                        
-                        if field.field_type.value == "float32":
-                            val = ffi.cast("float*", ptr)[0]
-                            lib.sds_json_add_float(writer_ptr, field.name.encode(), val)
-                        elif field.field_type.value == "int8":
-                            val = ffi.cast("int8_t*", ptr)[0]
-                            lib.sds_json_add_int(writer_ptr, field.name.encode(), val)
-                        elif field.field_type.value == "uint8":
-                            val = ffi.cast("uint8_t*", ptr)[0]
-                            lib.sds_json_add_uint(writer_ptr, field.name.encode(), int(val))
-                        elif field.field_type.value == "int16":
-                            val = ffi.cast("int16_t*", ptr)[0]
-                            lib.sds_json_add_int(writer_ptr, field.name.encode(), val)
-                        elif field.field_type.value == "uint16":
-                            val = ffi.cast("uint16_t*", ptr)[0]
-                            lib.sds_json_add_uint(writer_ptr, field.name.encode(), int(val))
-                        elif field.field_type.value == "int32":
-                            val = ffi.cast("int32_t*", ptr)[0]
-                            lib.sds_json_add_int(writer_ptr, field.name.encode(), val)
-                        elif field.field_type.value == "uint32":
-                            val = ffi.cast("uint32_t*", ptr)[0]
-                            lib.sds_json_add_uint(writer_ptr, field.name.encode(), val)
-                        elif field.field_type.value == "bool":
-                            val = ffi.cast("bool*", ptr)[0]
-                            lib.sds_json_add_bool(writer_ptr, field.name.encode(), val)
-                        elif field.field_type.value == "string":
-                            val = ffi.string(ffi.cast("char*", ptr), field.string_len)
-                            lib.sds_json_add_string(writer_ptr, field.name.encode(), val)
-                except Exception as e:
-                    logger.exception(f"Serialize error for {section_info.name if section_info else 'unknown'}")
-            
-            return serialize
-        
-        def make_deserialize(section_info: Optional["TableSectionInfo"]):
-            if section_info is None:
-                return ffi.NULL
-            
-            @ffi.callback("SdsDeserializeFunc")
-            def deserialize(section_ptr, reader_ptr):
-                try:
-                    for field in section_info.fields:
-                        offset = field.offset
-                        ptr = ffi.cast("char*", section_ptr) + offset
-                        
-                        if field.field_type.value == "float32":
-                            val = ffi.new("float*")
-                            if lib.sds_json_get_float_field(reader_ptr, field.name.encode(), val):
-                                ffi.cast("float*", ptr)[0] = val[0]
-                        elif field.field_type.value == "int8":
-                            val = ffi.new("int32_t*")  # Parse as int32, then cast to int8
-                            if lib.sds_json_get_int_field(reader_ptr, field.name.encode(), val):
-                                ffi.cast("int8_t*", ptr)[0] = val[0]
-                        elif field.field_type.value == "uint8":
-                            val = ffi.new("uint8_t*")
-                            if lib.sds_json_get_uint8_field(reader_ptr, field.name.encode(), val):
-                                ffi.cast("uint8_t*", ptr)[0] = val[0]
-                        elif field.field_type.value == "int16":
-                            val = ffi.new("int32_t*")  # Parse as int32, then cast to int16
-                            if lib.sds_json_get_int_field(reader_ptr, field.name.encode(), val):
-                                ffi.cast("int16_t*", ptr)[0] = val[0]
-                        elif field.field_type.value == "uint16":
-                            val = ffi.new("uint32_t*")  # Parse as uint32, then cast to uint16
-                            if lib.sds_json_get_uint_field(reader_ptr, field.name.encode(), val):
-                                ffi.cast("uint16_t*", ptr)[0] = val[0]
-                        elif field.field_type.value == "int32":
-                            val = ffi.new("int32_t*")
-                            if lib.sds_json_get_int_field(reader_ptr, field.name.encode(), val):
-                                ffi.cast("int32_t*", ptr)[0] = val[0]
-                        elif field.field_type.value == "uint32":
-                            val = ffi.new("uint32_t*")
-                            if lib.sds_json_get_uint_field(reader_ptr, field.name.encode(), val):
-                                ffi.cast("uint32_t*", ptr)[0] = val[0]
-                        elif field.field_type.value == "bool":
-                            val = ffi.new("bool*")
-                            if lib.sds_json_get_bool_field(reader_ptr, field.name.encode(), val):
-                                ffi.cast("bool*", ptr)[0] = val[0]
-                        elif field.field_type.value == "string":
-                            buf = ffi.new(f"char[{field.string_len}]")
-                            if lib.sds_json_get_string_field(reader_ptr, field.name.encode(), buf, field.string_len):
-                                ffi.memmove(ptr, buf, field.string_len)
-                except Exception as e:
-                    logger.exception(f"Deserialize error for {section_info.name if section_info else 'unknown'}")
-            
-            return deserialize
-        
-        # Create and store callbacks (must keep references alive!)
-        callbacks = {
-            "serialize_config": make_serialize(config_info),
-            "deserialize_config": make_deserialize(config_info),
-            "serialize_state": make_serialize(state_info),
-            "deserialize_state": make_deserialize(state_info),
-            "serialize_status": make_serialize(status_info),
-            "deserialize_status": make_deserialize(status_info),
-        }
+    _FIELD_META_TYPES = {
+        "bool": "SDS_FIELD_BOOL",
+        "uint8": "SDS_FIELD_UINT8",
+        "int8": "SDS_FIELD_INT8",
+        "uint16": "SDS_FIELD_UINT16",
+        "int16": "SDS_FIELD_INT16",
+        "uint32": "SDS_FIELD_UINT32",
+        "int32": "SDS_FIELD_INT32",
+        "float32": "SDS_FIELD_FLOAT",
+        "string": "SDS_FIELD_STRING",
+    }
+    
+    def _create_field_meta(self, section_info: Optional["TableSectionInfo"]) -> tuple:
+        """
+        Build an SdsFieldMeta array for a section.
         
-        return callbacks
+        Returns (array or ffi.NULL, name buffers, count). The core keeps
+        pointers into both, so the caller must keep the tuple alive for the
+        lifetime of the registration.
+        """
+        if section_info is None or not section_info.fields:
+            return (ffi.NULL, [], 0)
+        
+        fields = ffi.new("SdsFieldMeta[]", len(section_info.fields))
+        names = []
+        for i, field in enumerate(section_info.fields):
+            name = ffi.new("char[]", field.name.encode("utf-8"))
+            names.append(name)
+            fields[i].name = name
+            fields[i].type = getattr(lib, self._FIELD_META_TYPES[field.field_type.value])
+            fields[i].offset = field.offset
+            fields[i].size = field.size
+            fields[i].deadband = field.deadband
+            fields[i].hysteresis = field.hysteresis
+            fields[i].min_interval_ms = field.min_interval_ms
+            fields[i].precision = field.precision
+        
+        return (fields, names, len(section_info.fields))
     
     def unregister_table(self, table_type: str) -> None:
         """
@@ -1000,7 +1302,41 @@ class SdsNode:
         
         # Remove from our tracking
         self._tables.pop(table_type, None)
-    
+
+    def export_table(self, table_type: str, name: str) -> None:
+        """
+        Export an owner table's status slots to named shared memory.
+
+        Other local processes can then read it with sds.SharedTable(name).
+        The table must keep its slots in external storage (a generated
+        table with @slot_storage = external); tables registered from Python
+        dataclasses keep them inline and are rejected.
+
+        Args:
+            table_type: Name of the table type
+            name: Segment name, e.g. "/sds.SensorData"
+
+        Raises:
+            SdsTableError: If the table is not an owner table with external slots
+            SdsConfigError: If the name is not a valid segment name
+        """
+        if not self._initialized:
+            raise SdsError.from_code(ErrorCode.NOT_INITIALIZED)
+        check_error(lib.sds_export_owner_table(
+            table_type.encode("utf-8"), name.encode("utf-8")
+        ))
+
+    def unexport_table(self, table_type: str) -> None:
+        """
+        Stop exporting a table started with export_table().
+
+        Raises:
+            SdsTableError: If the table is not exported
+        """
+        if not self._initialized:
+            raise SdsError.from_code(ErrorCode.NOT_INITIALIZED)
+        check_error(lib.sds_unexport_owner_table(table_type.encode("utf-8")))
+
     def get_table(self, table_type: str) -> SdsTable:
         """
         Get a previously registered table.
@@ -1031,21 +1367,128 @@ class SdsNode:
         """
         return lib.sds_get_table_count()
     
-    def get_stats(self) -> Dict[str, int]:
+    def get_stats(self) -> Dict[str, Any]:
         """
         Get runtime statistics.
         
         Returns:
             Dictionary with keys: messages_sent, messages_received,
-            reconnect_count, errors
+            reconnect_count, errors, outbound_queued, outbound_high_water,
+            outbound_dropped, outbound_coalesced, inbound_queued,
+            inbound_high_water, inbound_dropped, batches_sent,
+            batched_messages, config_cache_restored, config_unchanged,
+            cluster_skipped, sessions_resumed, seq_gaps, resync_keyframes.
+            
+            With enable_instrumentation, also "loop" (histograms for loop_us,
+            mqtt_us, sync_us, eviction_us) and "tables" (per table type:
+            counters plus serialize_us, parse_us and callback_us histograms).
+            Each histogram is a dict with count, total_us, max_us and buckets,
+            where buckets[i] counts samples in [2**i, 2**(i+1)) microseconds.
+            
+            With enable_latency_tracking, each "tables" entry also has
+            "propagation_ms": the same histogram in milliseconds plus p50,
+            p90 and p99 (bucket resolution).
         """
         stats = lib.sds_get_stats()
-        return {
+        result: Dict[str, Any] = {
             "messages_sent": stats.messages_sent,
             "messages_received": stats.messages_received,
             "reconnect_count": stats.reconnect_count,
             "errors": stats.errors,
+            "outbound_queued": stats.outbound_queued,
+            "outbound_high_water": stats.outbound_high_water,
+            "outbound_dropped": stats.outbound_dropped,
+            "outbound_coalesced": stats.outbound_coalesced,
+            "inbound_queued": stats.inbound_queued,
+            "inbound_high_water": stats.inbound_high_water,
+            "inbound_dropped": stats.inbound_dropped,
+            "batches_sent": stats.batches_sent,
+            "batched_messages": stats.batched_messages,
+            "config_cache_restored": stats.config_cache_restored,
+            "config_unchanged": stats.config_unchanged,
+            "cluster_skipped": stats.cluster_skipped,
+            "sessions_resumed": stats.sessions_resumed,
+            "seq_gaps": stats.seq_gaps,
+            "resync_keyframes": stats.resync_keyframes,
         }
+        instrument = self._enable_instrumentation
+        latency = self._enable_latency_tracking
+        if not (instrument or latency) or not self._initialized:
+            return result
+        
+        if instrument:
+            loop = ffi.new("SdsLoopStats*")
+            lib.sds_get_loop_stats(loop)
+            result["loop"] = {
+                name: _histogram_dict(getattr(loop, name))
+                for name in ("loop_us", "mqtt_us", "sync_us", "eviction_us")
+            }
+        
+        tables: Dict[str, Dict[str, Any]] = {}
+        table_stats = ffi.new("SdsTableStats*")
+        with self._lock:
+            table_types = list(self._tables)
+        for table_type in table_types:
+            if lib.sds_get_table_stats(table_type.encode("utf-8"), table_stats) != 0:
+                continue
+            entry: Dict[str, Any] = {}
+            if instrument:
+                for name in _TABLE_COUNTERS:
+                    entry[name] = getattr(table_stats, name)
+                for name in ("serialize_us", "parse_us", "callback_us"):
+                    entry[name] = _histogram_dict(getattr(table_stats, name))
+            if latency:
+                propagation = table_stats.propagation_ms
+                entry["propagation_ms"] = _histogram_dict(propagation)
+                for pct in (50, 90, 99):
+                    entry["propagation_ms"][f"p{pct}"] = lib.sds_latency_percentile(
+                        ffi.addressof(table_stats, "propagation_ms"), pct
+                    )
+            tables[table_type] = entry
+        result["tables"] = tables
+        return result
+    
+    def get_node_latency(self, table_type: str, node_id: str) -> Optional[Dict[str, Any]]:
+        """
+        Get an owner's clock estimate and latest latency for one device.
+        
+        Args:
+            table_type: Owner table type
+            node_id: Device node ID
+            
+        Returns:
+            Dict with clock_offset_ms (device clock minus ours), rtt_ms,
+            ref_ts, last_latency_ms, samples and synced (offset from a clock
+            exchange rather than the one-way bound), or None if the device
+            has no slot or latency tracking is off.
+        """
+        if not self._enable_latency_tracking or not self._initialized:
+            return None
+        record = ffi.new("SdsNodeLatency*")
+        if not lib.sds_get_node_latency(
+            table_type.encode("utf-8"), node_id.encode("utf-8"), record
+        ):
+            return None
+        return {
+            "clock_offset_ms": record.clock_offset_ms,
+            "rtt_ms": record.rtt_ms,
+            "ref_ts": record.ref_ts,
+            "last_latency_ms": record.last_latency_ms,
+            "samples": record.samples,
+            "synced": bool(record.synced),
+        }
+    
+    def reset_stats(self) -> None:
+        """
+        Reset every counter and histogram in get_stats() to zero.
+        
+        Queue depth gauges (outbound_queued, inbound_queued) are kept.
+        Thread-safe.
+        """
+        with self._lock:
+            if not self._initialized:
+                raise SdsError.from_code(ErrorCode.NOT_INITIALIZED)
+            lib.sds_reset_stats()
     
     # ============== Callback Registration ==============
     
@@ -1349,6 +1792,41 @@ class SdsNode:
         """
         return lib.sds_get_liveness_interval(table_type.encode("utf-8"))
     
+    def cluster_member_for(self, device_node_id: str) -> int:
+        """
+        Get the cluster member that tracks a device.
+        
+        Every member computes the same answer (rendezvous hashing of the
+        node ID), so any process can tell which owner holds a device.
+        
+        Args:
+            device_node_id: Device node ID
+        
+        Returns:
+            Member index, or 0 when cluster_members is off
+        """
+        return lib.sds_cluster_member_for(device_node_id.encode("utf-8"))
+    
+    def set_cluster_membership(self, members: int, member: int) -> None:
+        """
+        Change the cluster size or this owner's index.
+        
+        Devices that now belong to another member are evicted (the eviction
+        callback runs for each); devices gained are picked up from their
+        next status message. Not available with cluster_group.
+        
+        Args:
+            members: Cluster size (0 or 1 = track every device)
+            member: This owner's index, below members
+        
+        Raises:
+            SdsError: If not initialized or the membership is invalid
+        """
+        with self._lock:
+            check_error(lib.sds_set_cluster_membership(members, member))
+            self._cluster_members = members
+            self._cluster_member = member
+    
     def get_eviction_grace(self) -> int:
         """
         Get the configured eviction grace period.
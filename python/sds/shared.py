@@ -0,0 +1,225 @@
+"""
+SharedTable - read-only access to owner tables exported to shared memory.
+
+An owner process calls SdsNode.export_table() (sds_export_owner_table() in
+C); any number of local processes can then attach to the segment by name
+and read device status without MQTT or an SdsNode of their own.
+
+Thread Safety:
+    Reads copy each slot under its seqlock, so they never see a device
+    half-written by the owner and need no lock on this side.
+"""
+from __future__ import annotations
+
+import struct
+from typing import Any, Dict, Iterator, List, Optional, Tuple
+
+from sds._bindings import ffi, lib, decode_string
+from sds.types import ErrorCode, SdsError, check_error
+
+# struct formats by SdsFieldType value (SDS_FIELD_BOOL .. SDS_FIELD_FLOAT)
+_SHM_FIELD_FORMATS = {
+    0: "?",
+    1: "B",
+    2: "b",
+    3: "H",
+    4: "h",
+    5: "I",
+    6: "i",
+    7: "f",
+}
+_SHM_FIELD_STRING = 8
+
+_SHM_STATE_LIVE = 1
+
+
+class SharedDevice:
+    """
+    Copy of one device's slot from an exported segment.
+
+    status maps each status field name to its value. age_ms is measured
+    on the owner's clock as of its last sds_loop().
+    """
+
+    __slots__ = ("node_id", "online", "last_seen", "age_ms", "eviction_pending", "status")
+
+    def __init__(self, node_id: str, online: bool, last_seen: int, age_ms: int,
+                 eviction_pending: bool, status: Dict[str, Any]):
+        self.node_id = node_id
+        self.online = online
+        self.last_seen = last_seen
+        self.age_ms = age_ms
+        self.eviction_pending = eviction_pending
+        self.status = status
+
+    def __repr__(self) -> str:
+        return f"SharedDevice({self.node_id!r}, online={self.online}, status={self.status})"
+
+
+class SharedTable:
+    """
+    Read-only view of an owner table exported to shared memory.
+
+    The header and field layout are read from the segment, so no schema
+    is needed. slots is a memoryview over the raw slot array for callers
+    decoding it themselves (check the seqlocks, or prefer read()).
+
+    Example:
+        with SharedTable("/sds.SensorData") as shared:
+            for node_id, device in shared.devices():
+                print(node_id, device.age_ms, device.status["battery_percent"])
+    """
+
+    def __init__(self, name: str):
+        """
+        Attach to a segment by name.
+
+        Args:
+            name: Segment name passed to export_table(), e.g. "/sds.SensorData"
+
+        Raises:
+            SdsTableError: If there is no such segment or it is not an SDS export
+        """
+        self._name = name
+        self._view = ffi.new("SdsSharedTable*")
+        check_error(lib.sds_shared_table_attach(name.encode("utf-8"), self._view))
+
+        header = self._view.header
+        self._status_size = header.status_size
+        self._fields: List[Tuple[str, int, int, int]] = []
+        for i in range(header.field_count):
+            f = self._view.fields[i]
+            if f.offset + f.size <= self._status_size:
+                self._fields.append((decode_string(f.name) or "", f.type, f.offset, f.size))
+
+    def _header(self) -> Any:
+        if self._view is None or self._view.header == ffi.NULL:
+            raise SdsError(ErrorCode.NOT_INITIALIZED, f"SharedTable '{self._name}' is closed")
+        return self._view.header
+
+    @property
+    def table_type(self) -> str:
+        """Table type name."""
+        return decode_string(self._header().table_type) or ""
+
+    @property
+    def schema_version(self) -> str:
+        """Schema version of the exporting owner."""
+        return decode_string(self._header().schema_version) or ""
+
+    @property
+    def owner_node_id(self) -> str:
+        """Node ID of the exporting owner."""
+        return decode_string(self._header().owner_node_id) or ""
+
+    @property
+    def live(self) -> bool:
+        """False once the owner unexported the table or shut down."""
+        return self._header().state == _SHM_STATE_LIVE
+
+    @property
+    def clock_ms(self) -> int:
+        """Owner clock at its last sds_loop(); stops advancing if the owner dies."""
+        return self._header().clock_ms
+
+    @property
+    def max_slots(self) -> int:
+        """Number of device slots in the segment."""
+        return self._header().max_slots
+
+    @property
+    def field_names(self) -> List[str]:
+        """Status field names."""
+        return [name for name, _, _, _ in self._fields]
+
+    @property
+    def slots(self) -> memoryview:
+        """Raw slot array (max_slots * slot_size bytes), read-only."""
+        header = self._header()
+        return memoryview(ffi.buffer(self._view.slots, header.max_slots * header.slot_size)).toreadonly()
+
+    def read(self, node_id: str) -> Optional[SharedDevice]:
+        """
+        Copy one device's slot.
+
+        Returns:
+            SharedDevice if the device is known, None otherwise
+        """
+        self._header()
+        row = ffi.new("SdsSnapshotRow*")
+        status = ffi.new("uint8_t[]", max(self._status_size, 1))
+        if not lib.sds_shared_table_read(self._view, node_id.encode("utf-8"),
+                                         status, self._status_size, row):
+            return None
+        return self._device(row, status)
+
+    def devices(self) -> Iterator[Tuple[str, SharedDevice]]:
+        """
+        Iterate over copies of every device in the segment.
+
+        All slots are copied in one native pass before the first yield.
+
+        Yields:
+            Tuples of (node_id, SharedDevice)
+        """
+        self._header()
+        size = self._status_size
+        copies: List[Tuple[Any, Any]] = []
+
+        @ffi.callback("SdsNodeCopyIterator")
+        def collector(node, status_ptr, user_data):
+            row = ffi.new("SdsSnapshotRow*", node[0])
+            status = ffi.new("uint8_t[]", max(size, 1))
+            ffi.memmove(status, status_ptr, size)
+            copies.append((row, status))
+
+        lib.sds_shared_table_foreach(self._view, collector, ffi.NULL)
+
+        for row, status in copies:
+            device = self._device(row, status)
+            yield device.node_id, device
+
+    def _device(self, row: Any, status: Any) -> SharedDevice:
+        raw = ffi.buffer(status, self._status_size)
+        values: Dict[str, Any] = {}
+        for name, field_type, offset, size in self._fields:
+            if field_type == _SHM_FIELD_STRING:
+                values[name] = bytes(raw[offset:offset + size]).split(b"\0", 1)[0].decode("utf-8", "replace")
+            elif field_type in _SHM_FIELD_FORMATS:
+                values[name] = struct.unpack_from("=" + _SHM_FIELD_FORMATS[field_type], raw, offset)[0]
+
+        # Signed: a slot written after the owner's last tick reads slightly ahead
+        age = (self._header().clock_ms - row.last_seen_ms) & 0xFFFFFFFF
+        if age >= 0x80000000:
+            age = 0
+        return SharedDevice(
+            node_id=decode_string(row.node_id) or "",
+            online=bool(row.online),
+            last_seen=row.last_seen_ms,
+            age_ms=age,
+            eviction_pending=bool(row.eviction_pending),
+            status=values,
+        )
+
+    def close(self) -> None:
+        """Detach from the segment. Views from slots must not be used afterwards."""
+        if self._view is not None:
+            lib.sds_shared_table_detach(self._view)
+            self._view = None
+
+    def __enter__(self) -> "SharedTable":
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb) -> None:
+        self.close()
+
+    def __del__(self) -> None:
+        try:
+            self.close()
+        except Exception:
+            pass
+
+    def __repr__(self) -> str:
+        if self._view is None:
+            return f"SharedTable({self._name!r}, closed)"
+        return f"SharedTable({self._name!r}, table={self.table_type!r}, slots={self.max_slots})"
@@ -6,14 +6,16 @@ and provides C-like attribute access (table.state.temperature = x).
 
 Thread Safety:
     SdsTable and SectionProxy are thread-safe when used with a lock
-    provided by SdsNode. All attribute access is protected by the lock.
+    provided by SdsNode. All attribute access is protected by the lock,
+    which also holds off native ingest workers writing to the same table.
 """
 from __future__ import annotations
 
+import contextlib
 import logging
 import struct
 import threading
-from typing import Any, Dict, Iterator, Optional, Tuple, Type, TypeVar
+from typing import Any, Callable, Dict, Iterator, Optional, Tuple, Type, TypeVar
 
 # Module logger
 logger = logging.getLogger(__name__)
@@ -31,6 +33,31 @@ from sds.tables import (
 T = TypeVar("T")
 
 
+class TableLock:
+    """
+    The node's lock plus the native lock for one table.
+    
+    With ingest_workers, received messages are written into the table from
+    native threads; sds_lock_table() keeps them out while Python reads or
+    writes. Without workers the native lock does nothing.
+    """
+    
+    __slots__ = ("_node_lock", "_table_type")
+    
+    def __init__(self, node_lock: threading.RLock, table_type: str):
+        self._node_lock = node_lock
+        self._table_type = table_type.encode("utf-8")
+    
+    def __enter__(self) -> "TableLock":
+        self._node_lock.acquire()
+        lib.sds_lock_table(self._table_type)
+        return self
+    
+    def __exit__(self, *exc: Any) -> None:
+        lib.sds_unlock_table(self._table_type)
+        self._node_lock.release()
+
+
 class SectionProxy:
     """
     Proxy object that provides C-like attribute access to a table section.
@@ -47,7 +74,7 @@ class SectionProxy:
     """
     
     # Slots for performance and to avoid __setattr__ recursion
-    __slots__ = ("_section_info", "_buffer_ptr", "_readonly", "_lock")
+    __slots__ = ("_section_info", "_buffer_ptr", "_readonly", "_lock", "_mark_dirty")
     
     def __init__(
         self,
@@ -55,6 +82,7 @@ class SectionProxy:
         buffer_ptr: Any,
         readonly: bool = False,
         lock: Optional[threading.RLock] = None,
+        mark_dirty: Optional[Callable[[int], None]] = None,
     ):
         """
         Initialize the section proxy.
@@ -64,11 +92,14 @@ class SectionProxy:
             buffer_ptr: CFFI pointer to the section start in the C buffer
             readonly: If True, writes will raise an error
             lock: Optional RLock for thread-safe access
+            mark_dirty: Called with the field index after each write
+                       (tables registered with dirty tracking)
         """
         object.__setattr__(self, "_section_info", section_info)
         object.__setattr__(self, "_buffer_ptr", buffer_ptr)
         object.__setattr__(self, "_readonly", readonly)
         object.__setattr__(self, "_lock", lock)
+        object.__setattr__(self, "_mark_dirty", mark_dirty)
     
     def _find_field(self, name: str) -> Optional[TableFieldInfo]:
         """Find field info by name."""
@@ -122,7 +153,7 @@ class SectionProxy:
     def __setattr__(self, name: str, value: Any) -> None:
         """Write a field value to the C buffer. Thread-safe if lock provided."""
         # Handle slots during __init__
-        if name in ("_section_info", "_buffer_ptr", "_readonly", "_lock"):
+        if name in ("_section_info", "_buffer_ptr", "_readonly", "_lock", "_mark_dirty"):
             object.__setattr__(self, name, value)
             return
         
@@ -179,6 +210,9 @@ class SectionProxy:
             ffi.cast("uint32_t*", field_ptr)[0] = int(value)
         else:
             raise ValueError(f"Unknown field type: {field.field_type}")
+        
+        if self._mark_dirty:
+            self._mark_dirty(self._section_info.fields.index(field))
     
     def __repr__(self) -> str:
         """Return a representation showing all field values."""
@@ -313,6 +347,144 @@ class DeviceView:
         return f"DeviceView(node_id={self._node_id!r}, online={self._online}{eviction_str})"
 
 
+class _StatusColumns:
+    """Status columns copied out of the C library (StatusSnapshot, StatusHistory)."""
+    
+    # name -> (column index, struct format, width) for non-field columns
+    _HEADER_COLUMNS: Dict[str, tuple] = {}
+    _FIRST_FIELD_COLUMN = 0
+    
+    def __init__(self, buffer: Any, table_type: bytes, rows: int, status_info: TableSectionInfo):
+        self._buffer = buffer
+        self._table_type = table_type
+        self._rows = rows
+        first = self._FIRST_FIELD_COLUMN
+        self._fields = {f.name: (first + i, f) for i, f in enumerate(status_info.fields)}
+    
+    def __len__(self) -> int:
+        return self._rows
+    
+    @property
+    def rows(self) -> int:
+        """Number of rows."""
+        return self._rows
+    
+    @property
+    def field_names(self) -> list[str]:
+        """Status field names, in schema order."""
+        return list(self._fields)
+    
+    def _column_address(self, index: int) -> Any:
+        raise NotImplementedError
+    
+    def _column_bytes(self, index: int, width: int) -> memoryview:
+        return memoryview(ffi.buffer(self._column_address(index), self._rows * width))
+    
+    def column(self, name: str) -> Any:
+        """
+        Get one column by status field name or header column name.
+        
+        Returns a memoryview for numeric fields and a list of str for
+        string fields.
+        """
+        if name in self._HEADER_COLUMNS:
+            index, fmt, width = self._HEADER_COLUMNS[name]
+            return self._column_bytes(index, width).cast(fmt)
+        if name not in self._fields:
+            raise KeyError(name)
+        index, field = self._fields[name]
+        raw = self._column_bytes(index, field.size)
+        if field.field_type == FieldType.STRING:
+            return [
+                bytes(raw[i * field.size:(i + 1) * field.size]).split(b"\0", 1)[0].decode("utf-8")
+                for i in range(self._rows)
+            ]
+        fmt, _ = _FIELD_FORMATS[field.field_type]
+        return raw.cast(fmt)
+    
+    def to_numpy(self) -> Dict[str, Any]:
+        """
+        Get every numeric column as a numpy array (requires numpy).
+        
+        Arrays share memory with this object; string fields are skipped.
+        """
+        import numpy as np
+        
+        arrays = {name: np.frombuffer(self.column(name), dtype=fmt)
+                  for name, (_, fmt, _) in self._HEADER_COLUMNS.items()}
+        for name, (_, field) in self._fields.items():
+            if field.field_type != FieldType.STRING:
+                arrays[name] = np.frombuffer(self.column(name), dtype=_FIELD_FORMATS[field.field_type][0])
+        return arrays
+
+
+class StatusSnapshot(_StatusColumns):
+    """
+    Columnar copy of every device's status (for owner role).
+    
+    Taken in one native call under the table lock, so all columns describe
+    the same instant. Numeric columns are memoryviews into the snapshot
+    buffer; to_numpy() wraps them as arrays without copying. Besides the
+    status fields, column() takes "last_seen", "online" and
+    "eviction_pending".
+    
+    Example:
+        snap = table.snapshot()
+        for node_id, battery in zip(snap.node_ids, snap.column("battery")):
+            print(node_id, battery)
+    """
+    
+    # Column 0 holds node IDs (see node_ids)
+    _HEADER_COLUMNS = {
+        "last_seen": (1, "I", 4),
+        "online": (2, "?", 1),
+        "eviction_pending": (3, "?", 1),
+    }
+    _FIRST_FIELD_COLUMN = 4
+    
+    @property
+    def node_ids(self) -> list[str]:
+        """Node ID of each row."""
+        ids = ffi.cast("char(*)[32]", self._column_address(0))
+        return [decode_string(ids[i]) for i in range(self._rows)]
+    
+    def _column_address(self, index: int) -> Any:
+        return lib.sds_snapshot_column(self._buffer, self._table_type, index)
+    
+    def __repr__(self) -> str:
+        return f"StatusSnapshot(rows={self._rows}, fields={self.field_names})"
+
+
+class StatusHistory(_StatusColumns):
+    """
+    Columnar copy of one device's recent status samples (for owner role).
+    
+    Rows are samples, oldest first; the "timestamp" column holds the owner
+    time (ms) each one was received. Field columns work as in
+    StatusSnapshot.
+    
+    Example:
+        hist = table.history("sensor_01", max_age_ms=60000)
+        print(list(zip(hist.timestamps, hist.column("battery_percent"))))
+    """
+    
+    _HEADER_COLUMNS = {
+        "timestamp": (0, "I", 4),
+    }
+    _FIRST_FIELD_COLUMN = 1
+    
+    @property
+    def timestamps(self) -> memoryview:
+        """Owner receive time (ms) of each sample."""
+        return self.column("timestamp")
+    
+    def _column_address(self, index: int) -> Any:
+        return lib.sds_status_history_column(self._buffer, self._table_type, index)
+    
+    def __repr__(self) -> str:
+        return f"StatusHistory(samples={self._rows}, fields={self.field_names})"
+
+
 class SdsTable:
     """
     High-level table wrapper with C-like attribute access.
@@ -372,6 +544,7 @@ class SdsTable:
         status_schema: Optional[Type] = None,
         python_meta: Optional[Dict[str, int]] = None,
         lock: Optional[threading.RLock] = None,
+        dirty_tracking: bool = False,
     ):
         """
         Initialize the table wrapper.
@@ -386,8 +559,10 @@ class SdsTable:
             status_schema: Optional dataclass for status section
             python_meta: Optional dict with offsets (for Python-only schemas)
             lock: Optional RLock for thread-safe access
+            dirty_tracking: Mark each written field with sds_mark_dirty()
         """
         self._table_type = table_type
+        self._dirty_tracking = dirty_tracking
         self._role = role
         self._buffer = buffer
         self._meta = meta
@@ -411,6 +586,13 @@ class SdsTable:
         
         self._setup_proxies()
     
+    def _marker(self, section: int) -> Optional[Callable[[int], None]]:
+        """Field write hook for a writable section (dirty-tracking tables only)."""
+        if not self._dirty_tracking:
+            return None
+        table_type = self._table_type.encode("utf-8")
+        return lambda index: lib.sds_mark_dirty(table_type, section, index)
+    
     def _setup_proxies(self) -> None:
         """Set up section proxy objects based on role."""
         buffer_ptr = ffi.cast("char*", self._buffer)
@@ -447,13 +629,15 @@ class SdsTable:
             if self._state_info:
                 state_ptr = buffer_ptr + state_offset
                 self._state_proxy = SectionProxy(
-                    self._state_info, state_ptr, readonly=False, lock=self._lock
+                    self._state_info, state_ptr, readonly=False, lock=self._lock,
+                    mark_dirty=self._marker(lib.SDS_SECTION_STATE),
                 )
             
             if self._status_info:
                 status_ptr = buffer_ptr + status_offset
                 self._status_proxy = SectionProxy(
-                    self._status_info, status_ptr, readonly=False, lock=self._lock
+                    self._status_info, status_ptr, readonly=False, lock=self._lock,
+                    mark_dirty=self._marker(lib.SDS_SECTION_STATUS),
                 )
         
         else:  # OWNER role
@@ -461,7 +645,8 @@ class SdsTable:
             if self._config_info:
                 config_ptr = buffer_ptr + config_offset
                 self._config_proxy = SectionProxy(
-                    self._config_info, config_ptr, readonly=False, lock=self._lock
+                    self._config_info, config_ptr, readonly=False, lock=self._lock,
+                    mark_dirty=self._marker(lib.SDS_SECTION_CONFIG),
                 )
             
             # For owner with Python schemas, also set up state proxy (for reading merged state)
@@ -642,7 +827,7 @@ class SdsTable:
         # Create status proxy from slot data (status_ptr already points to status)
         status_proxy = None
         if self._status_info:
-            status_proxy = SectionProxy(self._status_info, status_ptr, readonly=True)
+            status_proxy = SectionProxy(self._status_info, status_ptr, readonly=True, lock=self._lock)
         
         return DeviceView(
             node_id=node_id,
@@ -688,12 +873,13 @@ class SdsTable:
             if node_id:
                 devices.append(node_id)
         
-        lib.sds_foreach_node(
-            self._buffer,
-            self._table_type.encode("utf-8"),
-            collector,
-            ffi.NULL,
-        )
+        with self._lock or contextlib.nullcontext():
+            lib.sds_foreach_node(
+                self._buffer,
+                self._table_type.encode("utf-8"),
+                collector,
+                ffi.NULL,
+            )
         
         # Yield DeviceViews for each device
         for node_id in devices:
@@ -701,6 +887,211 @@ class SdsTable:
             if device is not None:
                 yield node_id, device
     
+    def read_device(self, node_id: str, timeout_ms: Optional[int] = None) -> Optional[DeviceView]:
+        """
+        Copy a device's status without taking the table lock (OWNER role only).
+        
+        Unlike get_device(), which views the live slot, the returned view
+        holds a private, consistent copy taken under the slot's seqlock, so
+        it is safe from any thread while sds_loop() keeps ingesting.
+        
+        Args:
+            node_id: The device's node ID
+            timeout_ms: Liveness timeout for online check (default: 1.5x liveness)
+        
+        Returns:
+            DeviceView over the copy if device is known, None otherwise
+        
+        Raises:
+            SdsError: If not owner role
+        
+        Example:
+            device = table.read_device("sensor_01")
+            if device and device.online:
+                print(device.status.battery_level)
+        """
+        if self._role != Role.OWNER:
+            raise SdsError(
+                ErrorCode.INVALID_ROLE,
+                "read_device() is only available for OWNER role"
+            )
+        
+        row = ffi.new("SdsSnapshotRow*")
+        size = self._status_info.total_size if self._status_info else 0
+        status = ffi.new("uint8_t[]", max(size, 1))
+        if not lib.sds_read_node_status(
+            self._buffer,
+            self._table_type.encode("utf-8"),
+            node_id.encode("utf-8"),
+            status,
+            size,
+            row,
+        ):
+            return None
+        return self._copied_view(row, status, self._liveness_timeout(timeout_ms))
+    
+    def read_devices(self, timeout_ms: Optional[int] = None) -> Iterator[Tuple[str, DeviceView]]:
+        """
+        Iterate over consistent copies of all known devices without locking (OWNER role only).
+        
+        Like iter_devices(), but every device is copied in one native pass
+        under the slot seqlocks, and the views stay valid after ingest moves on.
+        
+        Args:
+            timeout_ms: Liveness timeout for online check (default: 1.5x liveness)
+        
+        Yields:
+            Tuples of (node_id, DeviceView)
+        
+        Raises:
+            SdsError: If not owner role
+        """
+        if self._role != Role.OWNER:
+            raise SdsError(
+                ErrorCode.INVALID_ROLE,
+                "read_devices() is only available for OWNER role"
+            )
+        
+        size = self._status_info.total_size if self._status_info else 0
+        copies: list[Tuple[Any, Any]] = []
+        
+        @ffi.callback("SdsNodeCopyIterator")
+        def collector(node, status_ptr, user_data):
+            row = ffi.new("SdsSnapshotRow*", node[0])
+            status = ffi.new("uint8_t[]", max(size, 1))
+            ffi.memmove(status, status_ptr, size)
+            copies.append((row, status))
+        
+        lib.sds_foreach_node_copy(
+            self._buffer,
+            self._table_type.encode("utf-8"),
+            collector,
+            ffi.NULL,
+        )
+        
+        timeout = self._liveness_timeout(timeout_ms)
+        for row, status in copies:
+            device = self._copied_view(row, status, timeout)
+            yield device.node_id, device
+    
+    def _liveness_timeout(self, timeout_ms: Optional[int]) -> int:
+        if not timeout_ms:
+            liveness = lib.sds_get_liveness_interval(self._table_type.encode("utf-8"))
+            timeout_ms = int(liveness * 1.5)
+        return timeout_ms
+    
+    def _copied_view(self, row: Any, status: Any, timeout_ms: int) -> DeviceView:
+        """DeviceView over a slot copy; online follows sds_is_device_online()."""
+        age = (lib.sds_platform_millis() - row.last_seen_ms) & 0xFFFFFFFF
+        status_proxy = None
+        if self._status_info:
+            status_proxy = SectionProxy(self._status_info, status, readonly=True)
+        return DeviceView(
+            node_id=decode_string(row.node_id) or "",
+            state_proxy=None,
+            status_proxy=status_proxy,
+            online=bool(row.online) and age < timeout_ms,
+            last_seen=row.last_seen_ms,
+            eviction_pending=bool(row.eviction_pending),
+        )
+    
+    def snapshot(self) -> StatusSnapshot:
+        """
+        Copy every device's status into columns (OWNER role only).
+        
+        Much cheaper than iter_devices() for dashboards: one native call
+        and no per-device objects.
+        
+        Returns:
+            StatusSnapshot with one row per known device
+        
+        Raises:
+            SdsError: If not owner role or the table has no status schema
+        
+        Example:
+            snap = table.snapshot()
+            print(sum(snap.column("online")), "of", snap.rows, "online")
+        """
+        if self._role != Role.OWNER:
+            raise SdsError(
+                ErrorCode.INVALID_ROLE,
+                "snapshot() is only available for OWNER role"
+            )
+        if self._status_info is None:
+            raise SdsError(
+                ErrorCode.INVALID_TABLE,
+                "No status schema provided for this table"
+            )
+        
+        table_type = self._table_type.encode("utf-8")
+        size = lib.sds_snapshot_size(table_type, lib.SDS_SNAPSHOT_COLUMNS)
+        if size == 0:
+            raise SdsError(
+                ErrorCode.INVALID_TABLE,
+                "Table has no status slots or field metadata"
+            )
+        
+        buffer = ffi.new("uint64_t[]", (size + 7) // 8)
+        info = ffi.new("SdsSnapshotInfo*")
+        with self._lock or contextlib.nullcontext():
+            result = lib.sds_snapshot_status(
+                self._buffer, table_type, lib.SDS_SNAPSHOT_COLUMNS, buffer, size, info
+            )
+        if result != 0:
+            raise SdsError.from_code(result)
+        return StatusSnapshot(buffer, table_type, info.rows, self._status_info)
+    
+    def history(self, node_id: str, max_age_ms: int = 0) -> StatusHistory:
+        """
+        Copy one device's recent status samples into columns (OWNER role only).
+        
+        Needs history storage: register_table(..., history=N) or @history
+        in the schema.
+        
+        Args:
+            node_id: Device node ID
+            max_age_ms: Only samples at most this old (0 = all kept)
+        
+        Returns:
+            StatusHistory with one row per sample, oldest first (empty for
+            an unknown device)
+        
+        Raises:
+            SdsError: If not owner role or the table keeps no history
+        
+        Example:
+            hist = table.history("sensor_01")
+            temps = hist.to_numpy()["temperature"]
+        """
+        if self._role != Role.OWNER:
+            raise SdsError(
+                ErrorCode.INVALID_ROLE,
+                "history() is only available for OWNER role"
+            )
+        if self._status_info is None:
+            raise SdsError(
+                ErrorCode.INVALID_TABLE,
+                "No status schema provided for this table"
+            )
+        
+        table_type = self._table_type.encode("utf-8")
+        size = lib.sds_status_history_columns_size(table_type)
+        if size == 0:
+            raise SdsError(
+                ErrorCode.INVALID_TABLE,
+                "Table keeps no status history (register with history=N)"
+            )
+        
+        buffer = ffi.new("uint64_t[]", (size + 7) // 8)
+        count = ffi.new("uint32_t*")
+        with self._lock or contextlib.nullcontext():
+            result = lib.sds_status_history_columns(
+                table_type, node_id.encode("utf-8"), max_age_ms, buffer, size, count
+            )
+        if result != 0:
+            raise SdsError.from_code(result)
+        return StatusHistory(buffer, table_type, count[0], self._status_info)
+    
     @property
     def device_count(self) -> int:
         """
@@ -721,14 +1112,17 @@ class SdsTable:
         buffer_ptr = ffi.cast("char*", self._buffer)
         
         # Use C metadata or Python metadata
+        count_size = 1
         if self._meta is not None:
             count_offset = self._meta.own_status_count_offset
+            count_size = self._meta.own_status_count_size or 1
         elif self._python_meta and "status_count_offset" in self._python_meta:
             count_offset = self._python_meta["status_count_offset"]
         else:
             return 0  # No metadata available
         
-        count_ptr = ffi.cast("uint8_t*", buffer_ptr + count_offset)
+        count_type = {1: "uint8_t*", 2: "uint16_t*", 4: "uint32_t*"}[count_size]
+        count_ptr = ffi.cast(count_type, buffer_ptr + count_offset)
         return count_ptr[0]
     
     def __repr__(self) -> str:
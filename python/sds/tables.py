@@ -72,6 +72,10 @@ def Field(
     float32: bool = False,
     string_len: Optional[int] = None,
     default: Any = None,
+    deadband: float = 0.0,
+    hysteresis: float = 0.0,
+    min_interval_ms: int = 0,
+    precision: int = 0,
 ) -> Any:
     """
     Define a field with explicit type information.
@@ -90,6 +94,13 @@ def Field(
         float32: If True, field is float (32-bit)
         string_len: If set, field is a fixed-length string
         default: Default value for the field
+        deadband: State/status: ignore changes up to this size from the
+                 last published value (numeric fields)
+        hysteresis: State/status: extra change needed to reverse the last
+                   published direction (numeric fields)
+        min_interval_ms: State/status: shortest time between publishes
+        precision: Float fields: decimals written (1-9; default 0 = the
+                   shortest form that reads back as the same float)
     
     Returns:
         Field metadata for use in dataclass
@@ -124,6 +135,10 @@ def Field(
     metadata = {
         "sds_field_type": field_type,
         "sds_string_len": string_len,
+        "sds_deadband": deadband,
+        "sds_hysteresis": hysteresis,
+        "sds_min_interval_ms": min_interval_ms,
+        "sds_precision": precision,
     }
     
     if default is not None:
@@ -153,6 +168,10 @@ class TableFieldInfo:
     offset: int
     size: int
     string_len: Optional[int] = None
+    deadband: float = 0.0
+    hysteresis: float = 0.0
+    min_interval_ms: int = 0
+    precision: int = 0
 
 
 @dataclass
@@ -211,6 +230,28 @@ def analyze_dataclass(cls: Type) -> TableSectionInfo:
     Returns:
         TableSectionInfo with field layout
     """
+    # Generated section classes carry their layout (sds-codegen __sds_layout__)
+    layout = cls.__dict__.get("__sds_layout__")
+    if layout is not None:
+        return TableSectionInfo(
+            fields=[
+                TableFieldInfo(
+                    name=name,
+                    field_type=FieldType(kind),
+                    offset=offset,
+                    size=size,
+                    string_len=string_len,
+                    deadband=deadband,
+                    hysteresis=hysteresis,
+                    min_interval_ms=min_interval_ms,
+                    precision=precision,
+                )
+                for (name, kind, offset, size, string_len, deadband, hysteresis,
+                     min_interval_ms, precision) in layout
+            ],
+            total_size=cls.__sds_size__,
+        )
+    
     field_infos = []
     offset = 0
     
@@ -242,6 +283,10 @@ def analyze_dataclass(cls: Type) -> TableSectionInfo:
             offset=offset,
             size=size,
             string_len=string_len,
+            deadband=metadata.get("sds_deadband", 0.0),
+            hysteresis=metadata.get("sds_hysteresis", 0.0),
+            min_interval_ms=metadata.get("sds_min_interval_ms", 0),
+            precision=metadata.get("sds_precision", 0),
         ))
         
         offset += size
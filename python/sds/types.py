@@ -23,6 +23,37 @@ class Role(IntEnum):
     DEVICE = 1
 
 
+class OutboundPolicy(IntEnum):
+    """
+    What happens to a sync message when the outbound queue is full.
+    
+    Attributes:
+        COALESCE: A full section replaces the queued message for its topic;
+                  otherwise the oldest message is dropped (default)
+        DROP_OLDEST: Discard the oldest queued message
+        DROP_NEWEST: Discard the new message; the change is retried on the next sync
+    """
+    COALESCE = 0
+    DROP_OLDEST = 1
+    DROP_NEWEST = 2
+
+
+class WireFormat(IntEnum):
+    """
+    Encoding used when publishing a table's sections.
+    
+    Receivers detect the encoding per message, so nodes using different
+    formats can share a table.
+    
+    Attributes:
+        JSON: JSON text (default, readable by every SDS version)
+        BINARY: Compact binary encoding (tables with generated field metadata;
+                others fall back to JSON)
+    """
+    JSON = 0
+    BINARY = 1
+
+
 class LogLevel(IntEnum):
     """
     Log level for controlling SDS output.
@@ -25,12 +25,24 @@ class SensorDataConfig:
     command: int = Field(uint8=True, default=0)
     threshold: float = Field(float32=True, default=25.0)
 
+    __sds_layout__ = (
+        ('command', 'uint8', 0, 1, None, 0.0, 0.0, 0, 0),
+        ('threshold', 'float32', 1, 4, None, 0.0, 0.0, 0, 0),
+    )
+    __sds_size__ = 5
+
 @dataclass
 class SensorDataState:
     """State section of SensorData table."""
     temperature: float = Field(float32=True, default=0.0)
     humidity: float = Field(float32=True, default=0.0)
 
+    __sds_layout__ = (
+        ('temperature', 'float32', 0, 4, None, 0.0, 0.0, 0, 0),
+        ('humidity', 'float32', 4, 4, None, 0.0, 0.0, 0, 0),
+    )
+    __sds_size__ = 8
+
 @dataclass
 class SensorDataStatus:
     """Status section of SensorData table."""
@@ -38,6 +50,13 @@ class SensorDataStatus:
     battery_percent: int = Field(uint8=True, default=0)
     uptime_seconds: int = Field(uint32=True, default=0)
 
+    __sds_layout__ = (
+        ('error_code', 'uint8', 0, 1, None, 0.0, 0.0, 0, 0),
+        ('battery_percent', 'uint8', 1, 1, None, 0.0, 0.0, 0, 0),
+        ('uptime_seconds', 'uint32', 2, 4, None, 0.0, 0.0, 0, 0),
+    )
+    __sds_size__ = 6
+
 class SensorData:
     """
     Schema bundle for SensorData table.
@@ -48,6 +67,8 @@ class SensorData:
     Config = SensorDataConfig
     State = SensorDataState
     Status = SensorDataStatus
+    sync_interval_ms = 1000
+    liveness_interval_ms = 3000
 
 
 # ============== ActuatorData ==============
@@ -59,17 +80,34 @@ class ActuatorDataConfig:
     target_position: int = Field(uint8=True, default=0)
     speed: int = Field(uint8=True, default=50)
 
+    __sds_layout__ = (
+        ('target_position', 'uint8', 0, 1, None, 0.0, 0.0, 0, 0),
+        ('speed', 'uint8', 1, 1, None, 0.0, 0.0, 0, 0),
+    )
+    __sds_size__ = 2
+
 @dataclass
 class ActuatorDataState:
     """State section of ActuatorData table."""
     current_position: int = Field(uint8=True, default=0)
 
+    __sds_layout__ = (
+        ('current_position', 'uint8', 0, 1, None, 0.0, 0.0, 0, 0),
+    )
+    __sds_size__ = 1
+
 @dataclass
 class ActuatorDataStatus:
     """Status section of ActuatorData table."""
     motor_status: int = Field(uint8=True, default=0)
     error_code: int = Field(uint16=True, default=0)
 
+    __sds_layout__ = (
+        ('motor_status', 'uint8', 0, 1, None, 0.0, 0.0, 0, 0),
+        ('error_code', 'uint16', 1, 2, None, 0.0, 0.0, 0, 0),
+    )
+    __sds_size__ = 3
+
 class ActuatorData:
     """
     Schema bundle for ActuatorData table.
@@ -80,6 +118,8 @@ class ActuatorData:
     Config = ActuatorDataConfig
     State = ActuatorDataState
     Status = ActuatorDataStatus
+    sync_interval_ms = 100
+    liveness_interval_ms = 1500
 
 
 # All exported types
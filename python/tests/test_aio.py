@@ -0,0 +1,120 @@
+"""
+Tests for sds.aio module (AsyncSdsNode).
+
+Event queueing is tested without a broker; the driver task needs one.
+"""
+import asyncio
+import threading
+import time
+
+import pytest
+
+
+class TestAsyncBasic:
+    """Basic tests that don't require CFFI extension."""
+
+    def test_event_tuple(self):
+        """SdsEvent is a plain named tuple."""
+        from sds.aio import SdsEvent
+        event = SdsEvent("status", "SensorData", "dev_1")
+        assert event.kind == "status"
+        assert event == ("status", "SensorData", "dev_1")
+
+
+@pytest.mark.requires_cffi
+class TestAsyncEvents:
+    """Event delivery without a broker."""
+
+    def test_events_from_threads_arrive_in_one_batch(self, unique_node_id):
+        """Events pushed from other threads are delivered together."""
+        from sds.aio import AsyncSdsNode
+
+        async def run():
+            node = AsyncSdsNode(unique_node_id, "localhost")
+            node._loop = asyncio.get_running_loop()
+            node._wake_event = asyncio.Event()
+            node._queue = asyncio.Queue()
+
+            def producer():
+                for i in range(10):
+                    node._on_status("SensorData", f"dev_{i}")
+            thread = threading.Thread(target=producer)
+            thread.start()
+            thread.join()
+
+            await asyncio.wait_for(node._wake_event.wait(), 1.0)
+            node._deliver()
+            batch = await node.get_events()
+            assert [e.node_id for e in batch] == [f"dev_{i}" for i in range(10)]
+            assert all(e.kind == "status" for e in batch)
+
+        asyncio.run(run())
+
+    def test_full_queue_drops_oldest(self, unique_node_id):
+        """max_events bounds the queue; the oldest events go first."""
+        from sds.aio import AsyncSdsNode
+
+        async def run():
+            node = AsyncSdsNode(unique_node_id, "localhost", max_events=3)
+            node._loop = asyncio.get_running_loop()
+            node._wake_event = asyncio.Event()
+            node._queue = asyncio.Queue(3)
+
+            for i in range(5):
+                node._on_evicted("SensorData", f"dev_{i}")
+            node._deliver()
+            batch = await node.get_events()
+            assert [e.node_id for e in batch] == ["dev_2", "dev_3", "dev_4"]
+            assert node.events_dropped == 2
+
+        asyncio.run(run())
+
+
+@pytest.mark.requires_mqtt
+class TestAsyncWithBroker:
+    """Tests that drive a connected node."""
+
+    def test_start_and_close(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
+        """The node connects in start() and events() ends on close()."""
+        from sds.aio import AsyncSdsNode
+
+        async def run():
+            node = AsyncSdsNode(unique_node_id, mqtt_broker_host, mqtt_broker_port)
+            await node.start()
+            assert node.is_ready()
+            assert "messages_sent" in node.get_stats()
+
+            async def consume():
+                return [event async for event in node.events()]
+            consumer = asyncio.ensure_future(consume())
+            await asyncio.sleep(0.2)
+            await node.close()
+            assert await asyncio.wait_for(consumer, 2.0) == []
+            assert await node.get_events() == []
+            assert not node.node._initialized
+
+        asyncio.run(run())
+
+    def test_loop_stays_responsive(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
+        """The driver sleeps between deadlines instead of busy-polling."""
+        from sds.aio import AsyncSdsNode
+
+        async def run():
+            async with AsyncSdsNode(unique_node_id, mqtt_broker_host, mqtt_broker_port):
+                ticks = 0
+                start = time.monotonic()
+                while time.monotonic() - start < 0.5:
+                    await asyncio.sleep(0.01)
+                    ticks += 1
+                assert ticks > 20
+
+        asyncio.run(run())
+
+    def test_poll_timeout_waits(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
+        """poll(timeout_ms) returns within the timeout."""
+        from sds import SdsNode
+
+        with SdsNode(unique_node_id, mqtt_broker_host, mqtt_broker_port) as node:
+            start = time.monotonic()
+            node.poll(timeout_ms=100)
+            assert time.monotonic() - start < 1.0
@@ -159,6 +159,99 @@ class TestSdsNodeWithBroker:
             assert "reconnect_count" in stats
             assert "errors" in stats
     
+    def test_node_get_stats_instrumented(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
+        """get_stats() adds loop and per-table stats with enable_instrumentation."""
+        with SdsNode(
+            unique_node_id,
+            mqtt_broker_host,
+            mqtt_broker_port,
+            enable_instrumentation=True
+        ) as node:
+            node.poll()
+            stats = node.get_stats()
+            assert stats["loop"]["loop_us"]["count"] >= 1
+            assert len(stats["loop"]["mqtt_us"]["buckets"]) == 20
+            assert stats["tables"] == {}
+            
+            node.reset_stats()
+            assert node.get_stats()["loop"]["loop_us"]["count"] == 0
+    
+    def test_node_latency_tracking(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
+        """enable_latency_tracking adds propagation_ms; unknown devices have no record."""
+        with SdsNode(
+            unique_node_id,
+            mqtt_broker_host,
+            mqtt_broker_port,
+            enable_latency_tracking=True
+        ) as node:
+            node.register_table("SensorData", Role.OWNER)
+            node.poll()
+            stats = node.get_stats()
+            assert "loop" not in stats
+            propagation = stats["tables"]["SensorData"]["propagation_ms"]
+            assert propagation["count"] == 0
+            assert propagation["p99"] == 0
+            assert node.get_node_latency("SensorData", "no_such_device") is None
+    
+    def test_node_adaptive_liveness(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
+        """liveness_max_ms widens a device's liveness interval."""
+        with SdsNode(
+            unique_node_id,
+            mqtt_broker_host,
+            mqtt_broker_port
+        ) as node:
+            try:
+                node.register_table(
+                    "SensorData", Role.DEVICE,
+                    sync_interval_max_ms=4000,
+                    liveness_max_ms=60000,
+                )
+            except SdsError as e:
+                if e.code == ErrorCode.TABLE_NOT_FOUND:
+                    pytest.skip("SensorData table not in registry")
+                raise
+            assert node.get_liveness_interval("SensorData") == 60000
+            node.poll(timeout_ms=100)
+
+    def test_node_config_cache(self, unique_node_id, mqtt_broker_host, mqtt_broker_port,
+                               tmp_path, monkeypatch):
+        """enable_config_cache reports its counters; nothing is restored from an empty cache."""
+        monkeypatch.setenv("SDS_STORAGE_DIR", str(tmp_path))
+        with SdsNode(
+            unique_node_id,
+            mqtt_broker_host,
+            mqtt_broker_port,
+            enable_config_cache=True
+        ) as node:
+            try:
+                node.register_table("SensorData", Role.DEVICE)
+            except SdsError as e:
+                if e.code == ErrorCode.TABLE_NOT_FOUND:
+                    pytest.skip("SensorData table not in registry")
+                raise
+            stats = node.get_stats()
+            assert stats["config_cache_restored"] == 0
+            assert stats["config_unchanged"] == 0
+            node.poll(timeout_ms=100)
+
+    def test_node_cluster_membership(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
+        """cluster_members assigns every device to exactly one member."""
+        with SdsNode(
+            unique_node_id,
+            mqtt_broker_host,
+            mqtt_broker_port,
+            cluster_members=3,
+            cluster_member=1
+        ) as node:
+            members = {node.cluster_member_for(f"dev_{i}") for i in range(60)}
+            assert members == {0, 1, 2}
+            assert node.get_stats()["cluster_skipped"] == 0
+            
+            node.set_cluster_membership(1, 0)
+            assert node.cluster_member_for("dev_1") == 0
+            with pytest.raises(SdsError):
+                node.set_cluster_membership(2, 5)
+
     def test_node_poll(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
         """SdsNode.poll() processes events."""
         with SdsNode(
@@ -444,7 +537,22 @@ class TestRawSubscribeAPI:
             
             result = node.subscribe_raw(f"test/{unique_node_id}/sub", on_message)
             assert result is True
-    
+
+    def test_subscribe_raw_many_patterns(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
+        """subscribe_raw() grows past the built-in subscription storage."""
+        with SdsNode(
+            unique_node_id,
+            mqtt_broker_host,
+            mqtt_broker_port
+        ) as node:
+            def on_message(topic, payload):
+                pass
+
+            for i in range(40):
+                assert node.subscribe_raw(f"test/{unique_node_id}/dev{i}/+", on_message) is True
+            assert node.unsubscribe_raw(f"test/{unique_node_id}/dev0/+") is True
+            assert node.subscribe_raw(f"test/{unique_node_id}/a+", on_message) is False
+
     def test_subscribe_raw_rejects_sds_prefix(self, unique_node_id, mqtt_broker_host, mqtt_broker_port):
         """subscribe_raw() rejects topics starting with sds/."""
         with SdsNode(
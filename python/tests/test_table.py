@@ -67,6 +67,35 @@ class TestSdsTableClass:
         """Field helper creates correct metadata."""
         field = Field(uint8=True, default=5)
         assert field is not None
+    
+    def test_field_helper_filters(self):
+        """Field filters end up in the analyzed section layout."""
+        from sds.tables import analyze_dataclass
+        
+        @dataclass
+        class FilteredState:
+            temperature: float = Field(float32=True, deadband=0.5, hysteresis=0.1)
+            count: int = Field(uint32=True, min_interval_ms=2000)
+        
+        info = analyze_dataclass(FilteredState)
+        assert info.fields[0].deadband == 0.5
+        assert info.fields[0].hysteresis == 0.1
+        assert info.fields[0].min_interval_ms == 0
+        assert info.fields[1].deadband == 0.0
+        assert info.fields[1].min_interval_ms == 2000
+    
+    def test_field_helper_precision(self):
+        """Float precision ends up in the analyzed section layout."""
+        from sds.tables import analyze_dataclass
+        
+        @dataclass
+        class RoundedState:
+            temperature: float = Field(float32=True, precision=1)
+            humidity: float = Field(float32=True)
+        
+        info = analyze_dataclass(RoundedState)
+        assert info.fields[0].precision == 1
+        assert info.fields[1].precision == 0
 
 
 class TestFieldType:
@@ -244,7 +273,7 @@ class TestSdsTableDevice:
         mqtt_broker_host,
         mqtt_broker_port,
     ):
-        """Device role cannot use get_device() or iter_devices()."""
+        """Device role cannot use get_device(), iter_devices(), snapshot() or history()."""
         with SdsNode(
             unique_node_id,
             mqtt_broker_host,
@@ -261,6 +290,12 @@ class TestSdsTableDevice:
                 
                 with pytest.raises(SdsError, match="OWNER role"):
                     list(table.iter_devices())
+                
+                with pytest.raises(SdsError, match="OWNER role"):
+                    table.snapshot()
+                
+                with pytest.raises(SdsError, match="OWNER role"):
+                    table.history("sensor_01")
             except SdsError as e:
                 if e.code == ErrorCode.TABLE_NOT_FOUND:
                     pytest.skip("SensorData table not in registry")
@@ -10,6 +10,7 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdatomic.h>
 
 /* ============== Shadow Buffer Configuration ============== */
 
@@ -26,10 +27,25 @@
 
 /* ============== Internal Types ============== */
 
+#define SDS_SHM_MAX_NAME_LEN 64     /* Segment names, including the leading '/' */
+
 /* Serialization callback types */
 typedef void (*SdsSerializeFunc)(void* table, SdsJsonWriter* w);
 typedef void (*SdsDeserializeFunc)(void* table, SdsJsonReader* r);
 
+/* One bit per field of a section (field counts are uint8_t) */
+typedef struct {
+    uint8_t bits[32];
+} SdsFieldMask;
+
+/* Publish history of a field with hysteresis or a minimum interval (see Significance Filters) */
+typedef struct {
+    const SdsFieldMeta* field;
+    uint32_t last_ms;               /* Last publish that moved the field */
+    bool sent;                      /* last_ms is valid */
+    bool fell;                      /* That move was downwards */
+} SdsFieldTrack;
+
 typedef struct {
     bool active;
     void* table;
@@ -40,6 +56,14 @@ typedef struct {
     uint32_t liveness_interval_ms;  /* Max time between status publishes */
     uint32_t last_publish_ms;       /* Last time we published anything (for liveness) */
     
+    /* Adaptive scheduling (see Adaptive Scheduling) */
+    uint32_t sync_min_ms;
+    uint32_t sync_max_ms;           /* 0 = fixed sync_interval_ms */
+    uint32_t sync_current_ms;       /* Adaptive: interval until the next sync */
+    uint32_t liveness_max_ms;       /* Device: longest idle heartbeat gap (0 = fixed) */
+    uint32_t liveness_current_ms;   /* Device: gap before the next heartbeat (0 = liveness_interval_ms) */
+    SdsWireFormat wire_format;      /* Outbound encoding (inbound is auto-detected) */
+    
     /* Serialization callbacks (set during registration) */
     SdsSerializeFunc serialize_config;
     SdsDeserializeFunc deserialize_config;
@@ -48,14 +72,32 @@ typedef struct {
     SdsSerializeFunc serialize_status;
     SdsDeserializeFunc deserialize_status;
     
-    /* Shadow copies for change detection */
-    uint8_t shadow_config[SDS_SHADOW_SIZE];
-    uint8_t shadow_state[SDS_SHADOW_SIZE];
-    uint8_t shadow_status[SDS_SHADOW_SIZE];
+    /* Shadow copies for change detection, carved from the table arena */
+    uint8_t* shadow_config;
+    uint8_t* shadow_state;
+    uint8_t* shadow_status;
+    size_t shadow_capacity;     /* Bytes carved for this slot (kept across re-registration) */
     size_t config_size;
     size_t state_size;
     size_t status_size;
     
+    /* Fields marked by sds_mark_dirty() since the last publish */
+    bool dirty_tracking;
+    SdsFieldMask dirty_config;
+    SdsFieldMask dirty_state;
+    SdsFieldMask dirty_status;
+    
+    /* Fields carried by the newest queued state/status message (see Outbound Queue) */
+    SdsFieldMask queued_state;
+    SdsFieldMask queued_status;
+    
+    /* Significance filters (see Significance Filters) */
+    bool state_filtered;            /* A state field has a deadband, hysteresis or min interval */
+    bool status_filtered;
+    uint8_t track_count;
+    uint8_t track_cap;
+    SdsFieldTrack* track;           /* From the arena when a field needs history (kept across re-registration) */
+    
     /* Offsets within table struct */
     size_t config_offset;
     size_t state_offset;
@@ -72,11 +114,14 @@ typedef struct {
     /* For owner: status slot management */
     size_t status_slots_offset;  /* Offset to status array in owner table */
     size_t status_slot_size;     /* Size of each status slot */
-    uint8_t max_status_slots;
+    uint32_t max_status_slots;
+    bool status_slots_external;  /* status_slots_offset holds a pointer to the slot array */
+    uint8_t status_count_size;   /* Width of status_count in bytes (1, 2 or 4) */
     size_t slot_valid_offset;       /* Offset to valid flag within a slot */
     size_t slot_online_offset;      /* Offset to online flag within a slot */
     size_t slot_eviction_pending_offset; /* Offset to eviction_pending flag within a slot */
     size_t slot_last_seen_offset;   /* Offset to last_seen_ms within a slot */
+    _Atomic bool eviction_rearm;    /* An LWT started a grace period; sds_loop() arms the timer */
     
     /* Field metadata for delta sync (from registry) */
     const SdsFieldMeta* config_fields;
@@ -85,12 +130,103 @@ typedef struct {
     uint8_t state_field_count;
     const SdsFieldMeta* status_fields;
     uint8_t status_field_count;
+    
+    /* Pre-escaped key fragments per section: [len]["name":] per field, in field order */
+    char* field_keys;               /* From the arena when field metadata is set (kept across re-registration) */
+    uint16_t field_keys_cap;
+    uint16_t config_keys;           /* Offset into field_keys, or SDS_FIELD_KEYS_NONE */
+    uint16_t state_keys;
+    uint16_t status_keys;
     size_t slot_eviction_deadline_offset; /* Offset to eviction_deadline within a slot */
     size_t slot_status_offset;      /* Offset to status within a slot */
+    size_t slot_seq_offset;         /* Offset to status_seq within a slot (0 = no gap detection) */
     size_t status_count_offset;     /* Offset to status_count in owner table */
     /* Note: eviction_grace_ms and eviction_callback are now global (see _eviction_*) */
+    
+    /* For owner: node_id -> slot hash index (linear probing, slot + 1, 0 = empty) */
+    uint32_t* slot_index_builtin;   /* SDS_SLOT_INDEX_SIZE buckets from the arena (kept across re-registration) */
+    uint32_t* slot_index_ext;       /* Caller-provided buckets (sds_set_owner_slot_index) */
+    uint32_t slot_index_ext_size;
+    uint32_t* slot_index;           /* Active buckets (builtin or ext) */
+    uint32_t slot_index_mask;
+    bool slot_index_enabled;
+    uint32_t slot_free_hint;        /* Every slot below this one is in use */
+    
+    /* Slot seqlocks (see Slot Seqlocks): odd while the receive path writes */
+    _Atomic uint32_t slot_seq_table;    /* Slots without a counter of their own */
+    _Atomic uint32_t slot_index_seq;    /* Around slot index changes */
+    _Atomic uint32_t* slot_seqlocks;    /* Caller-provided, one per slot (sds_set_owner_slot_seqlocks) */
+    uint32_t slot_seqlock_count;
+    
+    /* Shared-memory export (sds_export_owner_table, see Shared-Memory Export) */
+    uint8_t* shm;                       /* Segment mapping, NULL = not exported */
+    size_t shm_size;
+    char shm_name[SDS_SHM_MAX_NAME_LEN];
+    uint8_t* shm_prev_slots;            /* Caller's slot array, restored on unexport */
+    _Atomic uint32_t* shm_prev_seqlocks;
+    uint32_t shm_prev_seqlock_count;
+    
+    /* Counters and histograms (SdsConfig.enable_instrumentation), under the table lock */
+    SdsTableStats* stats;           /* From the arena with instrumentation or latency tracking (kept across re-registration) */
+    
+    /* Latency tracking (SdsConfig.enable_latency_tracking, see Clock Offset) */
+    bool clock_ref_valid;           /* Device: a config has been applied */
+    uint32_t clock_ref_ts;          /* Device: that config's "ts" (owner clock) */
+    uint32_t clock_ref_rx;          /* Device: when it was applied (own clock) */
+    SdsNodeLatency* latency_nodes;  /* Owner: per-slot records (sds_set_owner_latency_slots) */
+    uint32_t latency_node_count;
+    
+    /* Adaptive liveness (see Adaptive Scheduling) */
+    uint32_t* slot_liveness;        /* Owner: "lv" each slot's device advertised (0 = none), from the arena (kept across re-registration) */
+    uint32_t slot_liveness_cap;
+    
+    /* Status history (sds_set_owner_status_history, see Status History) */
+    uint8_t* history;               /* Owner: one ring per status slot, NULL = off */
+    uint16_t history_depth;         /* Samples per ring */
+    size_t history_entry_size;      /* Timestamp + status section, 4-byte aligned */
+
+    /* Aggregates (sds_set_table_aggregates, see Aggregates) */
+    const SdsAggregateMeta* aggregate_meta; /* Summary: caller's descriptors, NULL = none */
+    struct SdsAggregateState* aggregates;   /* Summary: running state, under the source's lock */
+    uint8_t aggregate_count;
+    double* aggregate_scratch;      /* Summary: percentile values, one per source slot */
+    uint32_t aggregate_scratch_count;
+    char aggregate_source[SDS_MAX_TABLE_TYPE_LEN];
+    uint8_t aggregate_link;         /* Summary: source table index + 1; source: summary's (0 = none) */
+    bool aggregate_rescan;          /* Summary: rebuild the state from the slots at the next sync */
+
+    /* Config cache (SdsConfig.enable_config_cache, see Config Cache) */
+    uint32_t config_hash;           /* Device: hash of the last applied config payload */
+    bool config_hash_valid;
+    bool config_restored;           /* Device: applied from the cache, live config not seen yet */
+    
+    /* Config deltas (delta sync, see Config Deltas) */
+    uint32_t config_base_ts;        /* Owner: ts of the retained baseline; device: of the applied one */
+    bool config_base_valid;
+    uint16_t config_deltas;         /* Deltas published (owner) or applied (device) since the baseline */
+    SdsFieldMask config_since_base; /* Owner: fields those deltas carried */
+    
+    /* Status sequence (delta sync, see Status Sequence) */
+    uint32_t status_seq;            /* Device: sequence of the last status carrying fields (0 = none yet) */
+    uint16_t status_since_keyframe; /* Device: status messages since the last keyframe */
+    bool status_resync;             /* Device: an owner asked for a keyframe */
+    bool status_ping_queued;        /* Device: the newest queued status message is a ping */
 } SdsTableContext;
 
+#define SDS_FIELD_KEYS_NONE 0xFFFF
+
+#if SDS_FIELD_KEY_CACHE_SIZE >= SDS_FIELD_KEYS_NONE
+#error "SDS_FIELD_KEY_CACHE_SIZE must be below 65535"
+#endif
+
+#if SDS_SLOT_INDEX_SIZE < 2 || (SDS_SLOT_INDEX_SIZE & (SDS_SLOT_INDEX_SIZE - 1)) != 0
+#error "SDS_SLOT_INDEX_SIZE must be a power of two"
+#endif
+
+#if SDS_OUTBOUND_QUEUE_MAX < 1 || SDS_OUTBOUND_QUEUE_MAX > 255
+#error "SDS_OUTBOUND_QUEUE_MAX must be between 1 and 255"
+#endif
+
 /* ============== Log Level ============== */
 
 static SdsLogLevel _log_level = SDS_LOG_INFO;  /* Default to INFO level */
@@ -107,10 +243,88 @@ SdsLogLevel sds_get_log_level(void) {
 
 static bool _initialized = false;
 static char _node_id[SDS_MAX_NODE_ID_LEN] = "";
-static SdsTableContext _tables[SDS_MAX_TABLES];
+static SdsTableContext* _tables = NULL;    /* _table_cap contexts, carved from the table arena */
+static uint8_t _table_cap = 0;
 static uint8_t _table_count = 0;
+static uint8_t _shm_exports = 0;    /* Tables with a shared-memory segment */
+
+/* Topic -> table routes for inbound messages (see Message Routing) */
+typedef struct {
+    uint32_t hash;          /* FNV-1a of table_type */
+    uint8_t len;            /* strlen(table_type) */
+    uint8_t table;          /* Index into _tables */
+} SdsRoute;
+
+static SdsRoute* _routes = NULL;           /* _table_cap entries */
+static uint8_t _route_count = 0;
 static SdsStats _stats = {0};
 
+/* _stats counters are bumped from the receive thread, workers and the sender alike */
+static inline void stats_count(uint32_t* counter, uint32_t n) {
+    atomic_fetch_add_explicit((_Atomic uint32_t*)counter, n, memory_order_relaxed);
+}
+
+/* Inbound message pool and per-table lists (see Inbound Ingest) */
+#define SDS_INBOUND_NONE 0xFF
+
+#define SDS_INBOUND_CB_NONE   0
+#define SDS_INBOUND_CB_CONFIG 1
+#define SDS_INBOUND_CB_STATE  2
+#define SDS_INBOUND_CB_STATUS 3
+
+#if SDS_INBOUND_QUEUE_MAX < 1 || SDS_INBOUND_QUEUE_MAX > 254
+#error "SDS_INBOUND_QUEUE_MAX must be between 1 and 254"
+#endif
+
+typedef struct {
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+    uint8_t payload[SDS_MSG_BUFFER_SIZE];
+    size_t len;
+    uint32_t seq;           /* Arrival order */
+    uint8_t next;           /* Next message in the same list, or SDS_INBOUND_NONE */
+    uint8_t table;          /* Index into _tables (table messages) */
+    uint8_t callback;       /* Callback left for sds_loop() (SDS_INBOUND_CB_*) */
+    char node[SDS_MAX_NODE_ID_LEN]; /* Node reported by the deferred callback */
+} SdsInboundMsg;
+
+typedef struct {
+    uint8_t head;
+    uint8_t tail;
+} SdsInboundList;
+
+typedef struct {
+    SdsInboundList queue;   /* Messages waiting for this table */
+    bool busy;              /* A worker is applying one of them */
+    uint32_t seq;           /* Arrival order of the message being applied */
+} SdsInboundTable;
+
+/*
+ * Table arena: contexts, routes, inbound lists, timer arrays and per-table
+ * shadow buffers are carved from SdsConfig.table_arena (or the built-in
+ * arena below) by a bump allocator. Nothing is returned until
+ * sds_shutdown(); a slot reused by a later registration keeps its shadow
+ * block if the sections fit.
+ */
+#define SDS_ARENA_ALIGN 8
+#define SDS_ARENA_ROUND(n) (((size_t)(n) + SDS_ARENA_ALIGN - 1) & ~(size_t)(SDS_ARENA_ALIGN - 1))
+#define SDS_ARENA_FIXED_BYTES(n) ( \
+    SDS_ARENA_ROUND((size_t)(n) * sizeof(SdsTableContext)) + \
+    SDS_ARENA_ROUND((size_t)(n) * sizeof(SdsRoute)) + \
+    SDS_ARENA_ROUND((size_t)(n) * sizeof(SdsInboundTable)) + \
+    SDS_ARENA_ROUND((2 * (size_t)(n) + 2) * sizeof(uint32_t)) + \
+    3 * SDS_ARENA_ROUND((2 * (size_t)(n) + 2) * sizeof(uint16_t)))
+
+/* Built-in arena: SDS_MAX_TABLES tables with full-size shadows (set to 0 to always use SdsConfig.table_arena) */
+#ifndef SDS_TABLE_ARENA_SIZE
+#define SDS_TABLE_ARENA_SIZE \
+    (SDS_ARENA_FIXED_BYTES(SDS_MAX_TABLES) + SDS_MAX_TABLES * 3 * SDS_ARENA_ROUND(SDS_SHADOW_SIZE))
+#endif
+
+static uint64_t _builtin_arena[SDS_TABLE_ARENA_SIZE / sizeof(uint64_t) + 1];
+static uint8_t* _arena = NULL;
+static size_t _arena_size = 0;
+static size_t _arena_used = 0;
+
 #define SDS_MAX_BROKER_LEN 128
 #define SDS_MAX_CREDENTIAL_LEN 64
 static char _mqtt_broker_buf[SDS_MAX_BROKER_LEN] = "";
@@ -127,6 +341,10 @@ static size_t _table_registry_count = 0;
 /* Error callback for async error notifications */
 static SdsErrorCallback _error_callback = NULL;
 
+/* Message arrival notification (sds_on_wake) */
+static SdsWakeCallback _wake_callback = NULL;
+static void* _wake_user_data = NULL;
+
 /* Version mismatch callback */
 static SdsVersionMismatchCallback _version_mismatch_callback = NULL;
 
@@ -136,7 +354,6 @@ static char _schema_version[SDS_MAX_VERSION_LEN] = "unknown";
 
 /* Reconnection backoff state */
 static uint32_t _reconnect_backoff_ms = 0;
-static uint32_t _last_reconnect_attempt_ms = 0;
 #define SDS_RECONNECT_INITIAL_MS   1000   /* Start with 1 second */
 #define SDS_RECONNECT_MAX_MS       60000  /* Max 60 seconds */
 #define SDS_RECONNECT_MULTIPLIER   2      /* Double each time */
@@ -144,6 +361,18 @@ static uint32_t _last_reconnect_attempt_ms = 0;
 /* LWT subscription state - only subscribe once for all owner tables */
 static bool _lwt_subscribed = false;
 
+/* Persistent MQTT session (SdsConfig.persistent_session) */
+static bool _persistent_session = false;
+
+/* Owner subscription filter: a topic, in "$share/{cluster_group}/" when clustered */
+#define SDS_FILTER_BUFFER_SIZE (SDS_TOPIC_BUFFER_SIZE + SDS_MAX_CLUSTER_GROUP_LEN + 8)
+
+/* Topics collected for one sds_platform_mqtt_subscribe_many() request (on the caller's stack) */
+typedef struct {
+    char topics[SDS_SUBSCRIBE_BATCH][SDS_FILTER_BUFFER_SIZE];
+    uint8_t count;
+} SdsSubscribeBatch;
+
 /* Global eviction configuration (from SdsConfig) */
 static uint32_t _eviction_grace_ms = 0;
 static SdsDeviceEvictedCallback _eviction_callback = NULL;
@@ -152,19 +381,104 @@ static void* _eviction_user_data = NULL;
 /* Delta sync configuration (from SdsConfig) */
 static bool _delta_sync_enabled = false;
 static float _delta_float_tolerance = 0.001f;
+static uint16_t _keyframe_interval = SDS_DEFAULT_KEYFRAME_INTERVAL;
+
+/* Owner: devices to ask for a keyframe, published by sds_loop() */
+typedef struct {
+    uint8_t table;
+    char node[SDS_MAX_NODE_ID_LEN];
+} SdsResyncRequest;
+
+static SdsResyncRequest _resync_queue[SDS_RESYNC_QUEUE_MAX];
+static uint8_t _resync_count = 0;
 
-/* Raw MQTT subscription registry */
+/* Raw MQTT subscription registry (see Raw Subscription Trie) */
 #define SDS_RAW_TOPIC_MAX_LEN 128
 
 typedef struct {
     char topic[SDS_RAW_TOPIC_MAX_LEN];
     SdsRawMessageCallback callback;
     void* user_data;
+    uint16_t next;          /* Next subscription on the same trie list (index + 1, 0 = end) */
     bool active;
+    bool linked;            /* On a trie list until the next rebuild */
 } RawSubscription;
 
-static RawSubscription _raw_subs[SDS_MAX_RAW_SUBSCRIPTIONS];
-static uint8_t _raw_sub_count = 0;
+typedef struct {
+    uint32_t hash;          /* hash_topic_level() of the level text */
+    uint16_t parent;
+    uint16_t sub;           /* Subscription whose topic holds the level text */
+    uint8_t level_pos;      /* Level text: topic[level_pos .. level_pos + level_len) */
+    uint8_t level_len;
+    uint16_t plus;          /* "+" child (0 = none; the root is never a child) */
+    uint16_t exact;         /* Subscriptions ending at this node (index + 1) */
+    uint16_t multi;         /* Subscriptions ending in "#" below this node */
+} RawTrieNode;
+
+#define SDS_RAW_NODE_CAP(subs) (1 + (size_t)(subs) * SDS_RAW_TRIE_NODES_PER_SUB)
+
+/* Upper bound of sds_raw_subscription_storage_size() (buckets < 4x nodes) */
+#define SDS_RAW_STORAGE_BYTES(subs) \
+    ((size_t)(subs) * sizeof(RawSubscription) + SDS_RAW_NODE_CAP(subs) * sizeof(RawTrieNode) + \
+     4 * SDS_RAW_NODE_CAP(subs) * sizeof(uint16_t) + 3 * SDS_ARENA_ALIGN)
+
+static uint64_t _raw_builtin[SDS_RAW_STORAGE_BYTES(SDS_MAX_RAW_SUBSCRIPTIONS) / sizeof(uint64_t) + 1];
+static RawSubscription* _raw_subs = NULL;
+static RawTrieNode* _raw_nodes = NULL;
+static uint16_t* _raw_buckets = NULL;   /* (parent, level) -> node + 1, linear probing */
+static uint32_t _raw_bucket_mask = 0;
+static uint16_t _raw_sub_cap = 0;
+static uint16_t _raw_node_cap = 0;
+static uint16_t _raw_node_count = 0;
+static uint16_t _raw_sub_count = 0;
+static bool _raw_dispatching = false;   /* Callbacks running: defer rebuilds */
+static bool _raw_rebuild_pending = false;
+
+/* Outbound message queue (see Outbound Queue) */
+typedef struct {
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+    uint8_t payload[SDS_MSG_BUFFER_SIZE];
+    size_t len;
+    bool retained;
+} SdsOutboundMsg;
+
+static SdsOutboundMsg* _outq = NULL;  /* _outq_depth slots, carved from the table arena */
+static uint8_t _outq_head = 0;
+static uint8_t _outq_count = 0;
+static uint8_t _outq_depth = 0;     /* 0 = publish immediately */
+static SdsOutboundPolicy _outq_policy = SDS_OUTBOUND_COALESCE;
+static bool _outq_async = false;    /* Platform sender drains the queue */
+
+static SdsInboundMsg* _inq = NULL;    /* _inq_depth slots, carved from the table arena */
+static SdsInboundTable* _inq_tables = NULL;  /* _table_cap entries, carved from the table arena */
+static uint8_t _inq_depth = 0;      /* 0 = apply messages on receive */
+static uint8_t _inq_count = 0;      /* Messages not on the free list */
+static uint32_t _inq_seq = 0;
+static SdsInboundList _inq_free;
+static SdsInboundList _inq_lwt;     /* LWT messages, applied by sds_loop() */
+static SdsInboundList _inq_callbacks; /* Applied messages with a deferred callback */
+static uint8_t _inq_next_table = 0; /* Where the next worker starts looking */
+static bool _inq_async = false;     /* Platform workers apply the queue */
+static SdsCallbackExecutor _callback_executor = SDS_CALLBACKS_WORKER;
+
+/* Batch envelope being filled (see Batch Envelope) */
+static uint8_t* _batch_buf = NULL;  /* _batch_max bytes, carved from the table arena */
+static size_t _batch_len = 0;
+static uint16_t _batch_count = 0;   /* Messages in _batch_buf (0 = empty) */
+static size_t _batch_max = 0;       /* 0 = publish each message */
+static uint32_t _batch_flush_ms = 0;
+static bool _batch_subscribed = false;
+
+/* Instrumentation (see Statistics) */
+static bool _instrument = false;
+static SdsLoopStats _loop_stats;
+static bool _latency_tracking = false;
+static bool _config_cache = false;
+
+/* Owner cluster (see Cluster Membership) */
+static char _cluster_group[SDS_MAX_CLUSTER_GROUP_LEN] = "";  /* "" = plain subscriptions */
+static uint8_t _cluster_members = 0;    /* > 1 = devices partitioned by node_id */
+static uint8_t _cluster_member = 0;
 
 /* ============== Forward Declarations ============== */
 
@@ -172,48 +486,299 @@ static void on_mqtt_message(const char* topic, const uint8_t* payload, size_t pa
 static SdsTableContext* find_table(const char* table_type);
 static void notify_error(SdsError error, const char* context);
 static void subscribe_table_topics(SdsTableContext* ctx);
+static void resubscribe_all(void);
 static void unsubscribe_table_topics(SdsTableContext* ctx);
-static void sync_table(SdsTableContext* ctx);
+static bool sync_table(SdsTableContext* ctx);
+static void sync_adapt(SdsTableContext* ctx, bool changed, bool congested);
+static uint32_t sync_next_deadline(const SdsTableContext* ctx, uint32_t now);
+static bool outbound_congested(void);
 static bool field_changed(const SdsFieldMeta* field, const void* current, const void* shadow);
-static void serialize_field(const SdsFieldMeta* field, const void* section, SdsJsonWriter* w);
+static void serialize_field(const SdsFieldMeta* field, const char* key, const void* section, SdsJsonWriter* w);
+static void cache_field_keys(SdsTableContext* ctx);
+static void filters_setup(SdsTableContext* ctx);
+static SdsError register_table_common(
+    void* table, const char* table_type, SdsRole role, const SdsTableOptions* options,
+    const SdsTableMeta* meta,
+    size_t config_offset, size_t config_size,
+    size_t state_offset, size_t state_size,
+    size_t status_offset, size_t status_size,
+    SdsSerializeFunc serialize_config, SdsDeserializeFunc deserialize_config,
+    SdsSerializeFunc serialize_state, SdsDeserializeFunc deserialize_state,
+    SdsSerializeFunc serialize_status, SdsDeserializeFunc deserialize_status);
+static bool can_serialize(SdsSerializeFunc serialize, const SdsFieldMeta* fields);
+static bool publish_config(SdsTableContext* ctx, uint32_t now, const SdsFieldMask* delta);
 static void handle_lwt_message(const char* node_id, const uint8_t* payload, size_t len);
-static void handle_config_message(SdsTableContext* ctx, const uint8_t* payload, size_t len);
-static void handle_state_message(SdsTableContext* ctx, const char* from_node, const uint8_t* payload, size_t len);
-static void handle_status_message(SdsTableContext* ctx, const char* from_node, const uint8_t* payload, size_t len);
-static bool mqtt_topic_matches(const char* pattern, const char* topic);
+static void slot_index_rebuild(SdsTableContext* ctx);
+static void slot_liveness_setup(SdsTableContext* ctx);
+static void slot_index_insert(SdsTableContext* ctx, uint32_t slot);
+static void slot_index_remove(SdsTableContext* ctx, const char* node_id);
+static int32_t find_status_slot(const SdsTableContext* ctx, const char* node_id);
+static uint8_t* status_slots_base(const SdsTableContext* ctx, const void* table);
+static void status_count_adjust(SdsTableContext* ctx, int delta);
+static uint32_t status_slot_number(const SdsTableContext* ctx, const uint8_t* slot);
+static void seq_write_begin(_Atomic uint32_t* seq);
+static void seq_write_end(_Atomic uint32_t* seq);
+static void slot_write_begin(SdsTableContext* ctx, uint32_t slot);
+static void slot_write_end(SdsTableContext* ctx, uint32_t slot);
+static void aggregate_slot(SdsTableContext* source, uint32_t slot, int sign);
+static void aggregate_relink(SdsTableContext* ctx);
+static void aggregate_unlink(SdsTableContext* ctx);
+static void aggregate_fields_changed(SdsTableContext* ctx);
+static void aggregate_publish(SdsTableContext* summary);
+static void export_close(SdsTableContext* ctx);
+static void export_tick(void);
+static void routes_rebuild(void);
+static bool outbound_publish(const char* topic, const uint8_t* payload, size_t len, bool retained, bool supersedes);
+static bool outbound_merges(const char* topic);
+static void field_mask_set(SdsFieldMask* mask, uint8_t i);
+static void outbound_drain(void);
+static void batch_flush(void);
+static void resync_flush(void);
+static bool ingest_work(void);
+static bool inbound_setup(const SdsConfig* config);
+static void inbound_run_loop(void);
+static void inbound_purge_table(SdsTableContext* ctx);
+static uint32_t stats_clock(void);
+static uint32_t hash_payload(const uint8_t* payload, size_t len);
+static void stats_record(SdsLatencyHistogram* h, uint32_t start_us);
+static void histogram_add(SdsLatencyHistogram* h, uint32_t value);
+static bool inbound_pending(void);
+static void run_callback(SdsTableContext* ctx, uint8_t kind, const char* node_id);
+static void config_cache_restore(SdsTableContext* ctx);
+static void dispatch_table_message(SdsTableContext* ctx, const char* section,
+                                   const uint8_t* payload, size_t payload_len,
+                                   SdsInboundMsg* deferred);
+static void table_lock(const SdsTableContext* ctx);
+static void table_unlock(const SdsTableContext* ctx);
+static bool arena_setup(const SdsConfig* config);
+static void* arena_alloc(size_t size);
+static uint32_t hash_topic_level(const char* level, size_t* len);
 
-/* ============== MQTT Topic Matching ============== */
+/* ============== Raw Subscription Trie ============== */
 
-/**
- * Match an MQTT topic against a pattern with wildcards.
- * Supports + (single level) and # (multi-level) wildcards.
- */
-static bool mqtt_topic_matches(const char* pattern, const char* topic) {
-    while (*pattern && *topic) {
-        if (*pattern == '+') {
-            /* + matches exactly one level */
-            pattern++;
-            /* Skip to next / or end in topic */
-            while (*topic && *topic != '/') {
-                topic++;
-            }
-            /* If pattern has more after +, both should be at / or end */
-            if (*pattern && *pattern != '/') {
-                return false;
+/*
+ * Raw subscriptions are indexed by a trie with one node per topic level, so
+ * matching a message walks its levels instead of testing every pattern.
+ * Node 0 is the root. Literal children are found through one hash table
+ * keyed by (parent, level); each node also has at most one "+" child and
+ * two subscription lists: patterns ending at the node, and patterns ending
+ * in "#" below it ("a/#" also matches "a", as in MQTT). Wildcards in the
+ * first level do not match topics starting with '$'.
+ *
+ * Nodes keep no text of their own: they point into the topic of the
+ * subscription that created them. Unsubscribing therefore rebuilds the trie
+ * from the subscription array; during dispatch the rebuild waits until the
+ * callbacks have returned. Subscriptions, nodes (SDS_RAW_TRIE_NODES_PER_SUB
+ * per subscription) and buckets share one block, built in or supplied with
+ * sds_set_raw_subscription_storage().
+ */
+
+static uint32_t raw_bucket_count(size_t nodes) {
+    uint32_t buckets = 8;
+    while (buckets < 2 * nodes) {
+        buckets <<= 1;
+    }
+    return buckets;
+}
+
+size_t sds_raw_subscription_storage_size(uint16_t max_subscriptions) {
+    size_t subs = max_subscriptions ? max_subscriptions : SDS_MAX_RAW_SUBSCRIPTIONS;
+    size_t nodes = SDS_RAW_NODE_CAP(subs);
+    return SDS_ARENA_ROUND(subs * sizeof(RawSubscription)) +
+           SDS_ARENA_ROUND(nodes * sizeof(RawTrieNode)) +
+           raw_bucket_count(nodes) * sizeof(uint16_t) + (SDS_ARENA_ALIGN - 1);
+}
+
+static uint32_t raw_bucket(uint16_t parent, uint32_t hash) {
+    return (hash ^ ((uint32_t)parent * 0x9E3779B1u)) & _raw_bucket_mask;
+}
+
+static uint16_t raw_child_find(uint16_t parent, const char* level, size_t len, uint32_t hash) {
+    for (uint32_t b = raw_bucket(parent, hash); _raw_buckets[b]; b = (b + 1) & _raw_bucket_mask) {
+        const RawTrieNode* n = &_raw_nodes[_raw_buckets[b] - 1];
+        if (n->parent == parent && n->hash == hash && n->level_len == len &&
+            memcmp(_raw_subs[n->sub].topic + n->level_pos, level, len) == 0) {
+            return (uint16_t)(_raw_buckets[b] - 1);
+        }
+    }
+    return 0;
+}
+
+/* Returns the new node, or 0 when the node budget is spent */
+static uint16_t raw_node_new(uint16_t parent, uint16_t sub, size_t pos, size_t len, uint32_t hash) {
+    if (_raw_node_count >= _raw_node_cap) {
+        return 0;
+    }
+    uint16_t idx = _raw_node_count++;
+    RawTrieNode* n = &_raw_nodes[idx];
+    memset(n, 0, sizeof(*n));
+    n->hash = hash;
+    n->parent = parent;
+    n->sub = sub;
+    n->level_pos = (uint8_t)pos;
+    n->level_len = (uint8_t)len;
+    return idx;
+}
+
+/* "+" and "#" must fill their level, and "#" must be the last one */
+static bool raw_pattern_valid(const char* pattern) {
+    for (const char* p = pattern; *p; p++) {
+        if (*p != '+' && *p != '#') continue;
+        bool starts = p == pattern || p[-1] == '/';
+        bool ends = p[1] == '\0' || p[1] == '/';
+        if (!starts || !ends || (*p == '#' && p[1] != '\0')) {
+            return false;
+        }
+    }
+    return pattern[0] != '\0';
+}
+
+static bool raw_trie_insert(uint16_t sub) {
+    RawSubscription* rs = &_raw_subs[sub];
+    const char* topic = rs->topic;
+    uint16_t node = 0;
+    uint16_t* list = NULL;
+    
+    for (const char* level = topic; ; ) {
+        size_t len;
+        uint32_t hash = hash_topic_level(level, &len);
+        
+        if (len == 1 && level[0] == '#') {
+            list = &_raw_nodes[node].multi;
+            break;
+        }
+        
+        uint16_t child;
+        if (len == 1 && level[0] == '+') {
+            child = _raw_nodes[node].plus;
+            if (!child) {
+                child = raw_node_new(node, sub, 0, 0, 0);
+                if (!child) return false;
+                _raw_nodes[node].plus = child;
             }
-        } else if (*pattern == '#') {
-            /* # matches everything remaining */
-            return true;
-        } else if (*pattern == *topic) {
-            pattern++;
-            topic++;
         } else {
-            return false;
+            child = raw_child_find(node, level, len, hash);
+            if (!child) {
+                child = raw_node_new(node, sub, (size_t)(level - topic), len, hash);
+                if (!child) return false;
+                uint32_t b = raw_bucket(node, hash);
+                while (_raw_buckets[b]) {
+                    b = (b + 1) & _raw_bucket_mask;
+                }
+                _raw_buckets[b] = (uint16_t)(child + 1);
+            }
+        }
+        node = child;
+        
+        if (level[len] == '\0') {
+            list = &_raw_nodes[node].exact;
+            break;
+        }
+        level += len + 1;
+    }
+    
+    rs->next = *list;
+    *list = (uint16_t)(sub + 1);
+    rs->linked = true;
+    return true;
+}
+
+static void raw_trie_rebuild(void) {
+    if (_raw_dispatching) {
+        _raw_rebuild_pending = true;
+        return;
+    }
+    _raw_rebuild_pending = false;
+    
+    memset(&_raw_nodes[0], 0, sizeof(RawTrieNode));
+    _raw_node_count = 1;
+    memset(_raw_buckets, 0, (_raw_bucket_mask + 1) * sizeof(uint16_t));
+    for (uint16_t i = 0; i < _raw_sub_cap; i++) {
+        _raw_subs[i].next = 0;
+        _raw_subs[i].linked = false;
+    }
+    for (uint16_t i = 0; i < _raw_sub_cap; i++) {
+        if (_raw_subs[i].active && !raw_trie_insert(i)) {
+            /* Only after the storage shrank below the patterns' depth */
+            SDS_LOG_W("Raw subscription dropped, trie full: %s", _raw_subs[i].topic);
+            _raw_subs[i].active = false;
+            _raw_sub_count--;
         }
     }
+}
+
+/* Point the registry at storage, carrying over the first keep entries of subs */
+static void raw_storage_setup(void* storage, uint16_t max_subscriptions,
+                              const RawSubscription* subs, uint16_t keep) {
+    size_t nodes = SDS_RAW_NODE_CAP(max_subscriptions);
+    uint8_t* p = (uint8_t*)storage;
+    p += (SDS_ARENA_ALIGN - ((uintptr_t)p % SDS_ARENA_ALIGN)) % SDS_ARENA_ALIGN;
+    
+    _raw_subs = (RawSubscription*)p;
+    p += SDS_ARENA_ROUND(max_subscriptions * sizeof(RawSubscription));
+    _raw_nodes = (RawTrieNode*)p;
+    p += SDS_ARENA_ROUND(nodes * sizeof(RawTrieNode));
+    _raw_buckets = (uint16_t*)p;
+    _raw_bucket_mask = raw_bucket_count(nodes) - 1;
+    _raw_sub_cap = max_subscriptions;
+    _raw_node_cap = (uint16_t)nodes;
+    
+    /* The blocks may overlap: move before clearing anything */
+    if (keep > 0) {
+        memmove(_raw_subs, subs, keep * sizeof(RawSubscription));
+    }
+    memset(_raw_subs + keep, 0, (max_subscriptions - keep) * sizeof(RawSubscription));
+    _raw_sub_count = keep;
+}
+
+static void raw_deliver(uint16_t list, const char* topic, const uint8_t* payload, size_t payload_len) {
+    for (uint16_t i = list; i; i = _raw_subs[i - 1].next) {
+        RawSubscription* rs = &_raw_subs[i - 1];
+        if (rs->active) {
+            SDS_LOG_D("Raw message matched subscription: %s", rs->topic);
+            rs->callback(topic, payload, payload_len, rs->user_data);
+        }
+    }
+}
+
+/* rest: topic after the levels matched so far (NULL once all are matched) */
+static void raw_trie_match(uint16_t node, const char* rest, const char* topic,
+                           const uint8_t* payload, size_t payload_len) {
+    bool system = node == 0 && topic[0] == '$';
+    if (!system) {
+        raw_deliver(_raw_nodes[node].multi, topic, payload, payload_len);
+    }
+    if (!rest) {
+        raw_deliver(_raw_nodes[node].exact, topic, payload, payload_len);
+        return;
+    }
+    
+    size_t len;
+    uint32_t hash = hash_topic_level(rest, &len);
+    const char* next = rest[len] == '/' ? rest + len + 1 : NULL;
+    
+    uint16_t child = raw_child_find(node, rest, len, hash);
+    if (child) {
+        raw_trie_match(child, next, topic, payload, payload_len);
+    }
+    if (_raw_nodes[node].plus && !system) {
+        raw_trie_match(_raw_nodes[node].plus, next, topic, payload, payload_len);
+    }
+}
+
+static void raw_dispatch(const char* topic, const uint8_t* payload, size_t payload_len) {
+    if (_raw_sub_count == 0) {
+        return;
+    }
     
-    /* Both should be at end, or pattern ends with # */
-    return (*pattern == '\0' && *topic == '\0') || *pattern == '#';
+    /* Callbacks may (un)subscribe; the trie is rebuilt once they return */
+    bool nested = _raw_dispatching;
+    _raw_dispatching = true;
+    raw_trie_match(0, topic, topic, payload, payload_len);
+    _raw_dispatching = nested;
+    if (!nested && _raw_rebuild_pending) {
+        raw_trie_rebuild();
+    }
 }
 
 /* ============== Error Strings ============== */
@@ -261,6 +826,212 @@ const SdsTableMeta* sds_find_table_meta(const char* table_type) {
     return NULL;
 }
 
+/* ============== Deadline Scheduler ============== */
+
+/*
+ * Everything sds_loop() does on a timer is kept in a binary min-heap keyed by
+ * deadline, so a loop iteration only touches work that is due. Timer ids are
+ * fixed: one sync timer and one eviction timer per table context, plus the
+ * reconnect backoff timer and the batch flush timer. Liveness heartbeats are
+ * evaluated by sync_table() on sync ticks, so the sync timer covers them.
+ * Deadlines are compared with wrap-safe arithmetic (valid across the 49-day
+ * millis() rollover).
+ */
+#define SDS_TIMER_SYNC(table_idx)      ((uint16_t)(table_idx))
+#define SDS_TIMER_EVICTION(table_idx)  ((uint16_t)(_table_cap + (table_idx)))
+#define SDS_TIMER_RECONNECT            ((uint16_t)(2 * _table_cap))
+#define SDS_TIMER_BATCH                ((uint16_t)(2 * _table_cap + 1))
+#define SDS_TIMER_NONE                 0xFFFF
+
+/* Sized 2 * _table_cap + 2 and carved from the table arena at sds_init() */
+static uint32_t* _timer_deadline = NULL;
+static uint16_t* _timer_heap = NULL;   /* Timer ids, heap-ordered by deadline */
+static uint16_t* _timer_pos = NULL;    /* Heap position of each id, or SDS_TIMER_NONE */
+static uint16_t* _timer_due = NULL;    /* Scratch for sds_loop() */
+static uint16_t _timer_total = 0;
+static uint16_t _timer_count = 0;
+
+static inline bool deadline_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static inline uint32_t table_index(const SdsTableContext* ctx) {
+    return (uint32_t)(ctx - _tables);
+}
+
+static void timer_reset(void) {
+    _timer_count = 0;
+    for (uint16_t i = 0; i < _timer_total; i++) {
+        _timer_pos[i] = SDS_TIMER_NONE;
+    }
+}
+
+static void timer_swap(uint16_t i, uint16_t j) {
+    uint16_t a = _timer_heap[i];
+    uint16_t b = _timer_heap[j];
+    _timer_heap[i] = b;
+    _timer_heap[j] = a;
+    _timer_pos[b] = i;
+    _timer_pos[a] = j;
+}
+
+static void timer_sift_up(uint16_t i) {
+    while (i > 0) {
+        uint16_t parent = (uint16_t)((i - 1) / 2);
+        if (!deadline_before(_timer_deadline[_timer_heap[i]], _timer_deadline[_timer_heap[parent]])) {
+            break;
+        }
+        timer_swap(i, parent);
+        i = parent;
+    }
+}
+
+static void timer_sift_down(uint16_t i) {
+    for (;;) {
+        uint16_t smallest = i;
+        uint16_t left = (uint16_t)(2 * i + 1);
+        uint16_t right = (uint16_t)(2 * i + 2);
+        if (left < _timer_count &&
+            deadline_before(_timer_deadline[_timer_heap[left]], _timer_deadline[_timer_heap[smallest]])) {
+            smallest = left;
+        }
+        if (right < _timer_count &&
+            deadline_before(_timer_deadline[_timer_heap[right]], _timer_deadline[_timer_heap[smallest]])) {
+            smallest = right;
+        }
+        if (smallest == i) break;
+        timer_swap(i, smallest);
+        i = smallest;
+    }
+}
+
+/* Arm (or re-arm) a timer for an absolute deadline */
+static void timer_arm(uint16_t id, uint32_t deadline) {
+    _timer_deadline[id] = deadline;
+    uint16_t pos = _timer_pos[id];
+    if (pos == SDS_TIMER_NONE) {
+        pos = _timer_count++;
+        _timer_heap[pos] = id;
+        _timer_pos[id] = pos;
+    }
+    timer_sift_up(pos);
+    timer_sift_down(_timer_pos[id]);
+}
+
+/* Arm a timer only if it is idle or the new deadline is sooner */
+static void timer_arm_earliest(uint16_t id, uint32_t deadline) {
+    if (_timer_pos[id] == SDS_TIMER_NONE || deadline_before(deadline, _timer_deadline[id])) {
+        timer_arm(id, deadline);
+    }
+}
+
+static void timer_cancel(uint16_t id) {
+    uint16_t pos = _timer_pos[id];
+    if (pos == SDS_TIMER_NONE) return;
+    
+    uint16_t last = --_timer_count;
+    if (pos != last) {
+        uint16_t moved = _timer_heap[last];
+        timer_swap(pos, last);
+        timer_sift_up(pos);
+        timer_sift_down(_timer_pos[moved]);
+    }
+    _timer_pos[id] = SDS_TIMER_NONE;
+}
+
+/* Pop every timer whose deadline has passed; returns the number written to ids */
+static uint16_t timer_pop_due(uint32_t now, uint16_t* ids) {
+    uint16_t n = 0;
+    while (_timer_count > 0 && !deadline_before(now, _timer_deadline[_timer_heap[0]])) {
+        uint16_t id = _timer_heap[0];
+        timer_cancel(id);
+        ids[n++] = id;
+    }
+    return n;
+}
+
+static inline uint32_t ms_until(uint32_t now, uint32_t deadline) {
+    return deadline_before(now, deadline) ? deadline - now : 0;
+}
+
+/* ============== Table Arena ============== */
+
+size_t sds_table_arena_size(uint8_t max_tables, size_t section_bytes) {
+    size_t n = max_tables ? max_tables : SDS_MAX_TABLES;
+    size_t shadows = section_bytes
+        ? section_bytes + n * 3 * (SDS_ARENA_ALIGN - 1)   /* Each section rounded up */
+        : n * (3 * SDS_ARENA_ROUND(SDS_SHADOW_SIZE) + SDS_SLOT_INDEX_SIZE * sizeof(uint32_t) +
+               SDS_ARENA_ROUND(sizeof(SdsTableStats)) + SDS_ARENA_ROUND(SDS_FIELD_KEY_CACHE_SIZE) +
+               SDS_ARENA_ROUND(SDS_MAX_TRACKED_FIELDS * sizeof(SdsFieldTrack)) +
+               SDS_SLOT_INDEX_SIZE * sizeof(uint32_t));
+    return SDS_ARENA_FIXED_BYTES(n) + shadows + (SDS_ARENA_ALIGN - 1);
+}
+
+size_t sds_config_arena_size(const SdsConfig* config, size_t section_bytes) {
+    if (!config) {
+        return sds_table_arena_size(0, section_bytes);
+    }
+    size_t outbound = config->outbound_queue_depth < SDS_OUTBOUND_QUEUE_MAX
+        ? config->outbound_queue_depth : SDS_OUTBOUND_QUEUE_MAX;
+    size_t inbound = config->inbound_queue_depth < SDS_INBOUND_QUEUE_MAX
+        ? config->inbound_queue_depth : SDS_INBOUND_QUEUE_MAX;
+    size_t batch = config->batch_max_bytes < SDS_MSG_BUFFER_SIZE
+        ? config->batch_max_bytes : SDS_MSG_BUFFER_SIZE;
+    size_t n = config->max_tables ? config->max_tables : SDS_MAX_TABLES;
+    size_t stats = (section_bytes && (config->enable_instrumentation || config->enable_latency_tracking))
+        ? n * SDS_ARENA_ROUND(sizeof(SdsTableStats)) : 0;   /* The worst case already has them */
+    return sds_table_arena_size(config->max_tables, section_bytes) + stats +
+           SDS_ARENA_ROUND(outbound * sizeof(SdsOutboundMsg)) +
+           SDS_ARENA_ROUND(inbound * sizeof(SdsInboundMsg)) +
+           SDS_ARENA_ROUND(batch);
+}
+
+static void* arena_alloc(size_t size) {
+    size = SDS_ARENA_ROUND(size);
+    if (size > _arena_size - _arena_used) {
+        return NULL;
+    }
+    void* p = _arena + _arena_used;
+    _arena_used += size;
+    return p;
+}
+
+/* Reset the arena and carve the fixed per-capacity arrays */
+static bool arena_setup(const SdsConfig* config) {
+    uint8_t* base = config->table_arena ? (uint8_t*)config->table_arena : (uint8_t*)_builtin_arena;
+    size_t size = config->table_arena ? config->table_arena_size : sizeof(_builtin_arena);
+    
+    /* Align the start; the bump allocator keeps every block aligned */
+    size_t pad = (SDS_ARENA_ALIGN - ((uintptr_t)base % SDS_ARENA_ALIGN)) % SDS_ARENA_ALIGN;
+    _arena = base + pad;
+    _arena_size = size > pad ? size - pad : 0;
+    _arena_used = 0;
+    
+    uint8_t cap = config->max_tables ? config->max_tables : SDS_MAX_TABLES;
+    uint16_t timers = (uint16_t)(2 * cap + 2);
+    
+    _tables = arena_alloc(cap * sizeof(SdsTableContext));
+    _routes = arena_alloc(cap * sizeof(SdsRoute));
+    _inq_tables = arena_alloc(cap * sizeof(SdsInboundTable));
+    _timer_deadline = arena_alloc(timers * sizeof(uint32_t));
+    _timer_heap = arena_alloc(timers * sizeof(uint16_t));
+    _timer_pos = arena_alloc(timers * sizeof(uint16_t));
+    _timer_due = arena_alloc(timers * sizeof(uint16_t));
+    
+    if (!_tables || !_routes || !_inq_tables || !_timer_deadline || !_timer_heap || !_timer_pos || !_timer_due) {
+        SDS_LOG_E("Table arena too small for %u tables (%zu bytes, need %zu)",
+                  cap, size, sds_table_arena_size(cap, 0));
+        _table_cap = 0;
+        _timer_total = 0;
+        return false;
+    }
+    
+    memset(_tables, 0, cap * sizeof(SdsTableContext));
+    _table_cap = cap;
+    _timer_total = timers;
+    return true;
+}
+
 /* ============== Initialization ============== */
 
 SdsError sds_init(const SdsConfig* config) {
@@ -337,19 +1108,58 @@ SdsError sds_init(const SdsConfig* config) {
         SDS_LOG_D("MQTT authentication enabled for user: %s", _mqtt_username_buf);
     }
     
-    /* Initialize tables */
-    memset(_tables, 0, sizeof(_tables));
+    /* Owner cluster: shared subscriptions or node_id partitioning, not both */
+    _cluster_group[0] = '\0';
+    _cluster_members = 0;
+    _cluster_member = 0;
+    if (config->cluster_group && config->cluster_group[0] != '\0') {
+        size_t group_len = strlen(config->cluster_group);
+        if (group_len >= SDS_MAX_CLUSTER_GROUP_LEN || strpbrk(config->cluster_group, "/+#") ||
+            config->cluster_members > 1) {
+            SDS_LOG_E("Invalid cluster_group: %s", config->cluster_group);
+            sds_platform_shutdown();
+            return SDS_ERR_INVALID_CONFIG;
+        }
+        memcpy(_cluster_group, config->cluster_group, group_len + 1);
+        SDS_LOG_I("Owner subscriptions shared in group: %s", _cluster_group);
+    }
+    if (config->cluster_members > 1) {
+        if (config->cluster_member >= config->cluster_members) {
+            SDS_LOG_E("cluster_member %u out of range (%u members)",
+                      (unsigned)config->cluster_member, (unsigned)config->cluster_members);
+            sds_platform_shutdown();
+            return SDS_ERR_INVALID_CONFIG;
+        }
+        _cluster_members = config->cluster_members;
+        _cluster_member = config->cluster_member;
+        SDS_LOG_I("Cluster member %u of %u", (unsigned)_cluster_member, (unsigned)_cluster_members);
+    }
+    
+    /* Carve table contexts, routes and timers from the table arena */
+    if (!arena_setup(config)) {
+        sds_platform_shutdown();
+        return SDS_ERR_INVALID_CONFIG;
+    }
     _table_count = 0;
+    _route_count = 0;
     memset(&_stats, 0, sizeof(_stats));
+    memset(&_loop_stats, 0, sizeof(_loop_stats));
+    raw_storage_setup(_raw_builtin, SDS_MAX_RAW_SUBSCRIPTIONS, NULL, 0);
+    raw_trie_rebuild();
+    _instrument = config->enable_instrumentation;
+    _latency_tracking = config->enable_latency_tracking;
+    _config_cache = config->enable_config_cache;
     
     /* Reset reconnect backoff */
     _reconnect_backoff_ms = 0;
-    _last_reconnect_attempt_ms = 0;
+    timer_reset();
     
     /* Store global eviction configuration */
     _eviction_grace_ms = config->eviction_grace_ms;
     _eviction_callback = NULL;
     _eviction_user_data = NULL;
+    _wake_callback = NULL;
+    _wake_user_data = NULL;
     
     if (_eviction_grace_ms > 0) {
         SDS_LOG_I("Device eviction enabled: grace period = %u ms", _eviction_grace_ms);
@@ -363,13 +1173,88 @@ SdsError sds_init(const SdsConfig* config) {
         _delta_float_tolerance = 0.001f;  /* Default tolerance */
     }
     
+    _keyframe_interval = config->keyframe_interval ? config->keyframe_interval : SDS_DEFAULT_KEYFRAME_INTERVAL;
+    _resync_count = 0;
+    
     if (_delta_sync_enabled) {
-        SDS_LOG_I("Delta sync enabled: float tolerance = %.6f", _delta_float_tolerance);
+        SDS_LOG_I("Delta sync enabled: float tolerance = %.6f, keyframe every %u status messages",
+                  _delta_float_tolerance, (unsigned)_keyframe_interval);
+    }
+    
+    /* Store outbound queue configuration */
+    _outq_depth = config->outbound_queue_depth;
+    if (_outq_depth > SDS_OUTBOUND_QUEUE_MAX) {
+        SDS_LOG_W("Outbound queue depth %u exceeds SDS_OUTBOUND_QUEUE_MAX, using %d",
+                  _outq_depth, SDS_OUTBOUND_QUEUE_MAX);
+        _outq_depth = SDS_OUTBOUND_QUEUE_MAX;
+    }
+    _outq_policy = config->outbound_policy;
+    _outq_head = 0;
+    _outq_count = 0;
+    _outq_async = false;
+    _outq = NULL;
+    if (_outq_depth > 0) {
+        _outq = arena_alloc(_outq_depth * sizeof(SdsOutboundMsg));
+        if (!_outq) {
+            SDS_LOG_E("Table arena too small for an outbound queue of %u (need %zu bytes)",
+                      _outq_depth, sds_config_arena_size(config, 0));
+            _outq_depth = 0;
+            _table_cap = 0;
+            _timer_total = 0;
+            sds_platform_shutdown();
+            return SDS_ERR_INVALID_CONFIG;
+        }
+    }
+    
+    /* Store inbound queue configuration */
+    if (!inbound_setup(config)) {
+        SDS_LOG_E("Table arena too small for an inbound queue of %u (need %zu bytes)",
+                  config->inbound_queue_depth, sds_config_arena_size(config, 0));
+        _outq_depth = 0;
+        _table_cap = 0;
+        _timer_total = 0;
+        sds_platform_shutdown();
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    /* Store batch configuration */
+    _batch_max = config->batch_max_bytes;
+    if (_batch_max > SDS_MSG_BUFFER_SIZE) {
+        SDS_LOG_W("Batch size %zu exceeds SDS_MSG_BUFFER_SIZE, using %d",
+                  _batch_max, SDS_MSG_BUFFER_SIZE);
+        _batch_max = SDS_MSG_BUFFER_SIZE;
+    }
+    _batch_flush_ms = config->batch_flush_ms;
+    _batch_len = 0;
+    _batch_count = 0;
+    _batch_subscribed = false;
+    _batch_buf = NULL;
+    if (_batch_max > 0) {
+        _batch_buf = arena_alloc(_batch_max);
+        if (!_batch_buf) {
+            SDS_LOG_E("Table arena too small for a %zu-byte batch (need %zu bytes)",
+                      _batch_max, sds_config_arena_size(config, 0));
+            _batch_max = 0;
+            _outq_depth = 0;
+            _inq_depth = 0;
+            _table_cap = 0;
+            _timer_total = 0;
+            sds_platform_shutdown();
+            return SDS_ERR_INVALID_CONFIG;
+        }
+    }
+    
+    if (_batch_max > 0) {
+        SDS_LOG_I("Batching enabled: up to %zu bytes, flushed after %u ms",
+                  _batch_max, _batch_flush_ms);
     }
     
     /* Set MQTT callback */
     sds_platform_mqtt_set_callback(on_mqtt_message);
     
+    _persistent_session = config->persistent_session;
+    sds_platform_mqtt_set_persistent_session(_persistent_session);
+    
     /* Build LWT topic and payload */
     char lwt_topic[SDS_TOPIC_BUFFER_SIZE];
     char lwt_payload[128];
@@ -394,12 +1279,110 @@ SdsError sds_init(const SdsConfig* config) {
         return SDS_ERR_MQTT_CONNECT_FAILED;
     }
     
+    /* Sender and worker threads may call back into the API: finish setup before they start */
     _initialized = true;
+    
+    if (_outq_depth > 0) {
+        _outq_async = sds_platform_outbound_start(outbound_drain);
+        SDS_LOG_I("Outbound queue enabled: depth = %u (%s)", _outq_depth,
+                  _outq_async ? "async sender" : "drained by sds_loop");
+    }
+    
+    if (_inq_depth > 0 && config->ingest_workers > 0) {
+        /* Set before the workers start: they take table locks only when it is */
+        sds_platform_ingest_lock();
+        _inq_async = true;
+        sds_platform_ingest_unlock();
+        
+        if (sds_platform_ingest_start(ingest_work, config->ingest_workers)) {
+            sds_platform_ingest_notify();  /* Messages that arrived during connect */
+        } else {
+            sds_platform_ingest_lock();
+            _inq_async = false;
+            sds_platform_ingest_unlock();
+        }
+    }
+    if (_inq_depth > 0) {
+        SDS_LOG_I("Inbound queue enabled: depth = %u (%s)", _inq_depth,
+                  _inq_async ? "ingest workers" : "applied by sds_loop");
+    }
+    
     SDS_LOG_I("SDS initialized: node_id=%s", _node_id);
     
     return SDS_OK;
 }
 
+/*
+ * Tell the application a device is gone and free its status slot.
+ */
+static void release_status_slot(SdsTableContext* ctx, uint8_t* slot) {
+    size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    char* slot_node_id = (char*)slot;
+    
+    /* Invoke global eviction callback before clearing */
+    if (_eviction_callback) {
+        _eviction_callback(ctx->table_type, slot_node_id, _eviction_user_data);
+    }
+    
+    /* Clear the slot (unindex while node_id is still set) */
+    slot_index_remove(ctx, slot_node_id);
+    uint32_t slot_no = status_slot_number(ctx, slot);
+    slot_write_begin(ctx, slot_no);
+    *(bool*)(slot + valid_offset) = false;
+    if (ctx->slot_eviction_pending_offset > 0) {
+        *(bool*)(slot + ctx->slot_eviction_pending_offset) = false;
+    }
+    memset(slot_node_id, 0, SDS_MAX_NODE_ID_LEN);
+    slot_write_end(ctx, slot_no);
+    if (slot_no < ctx->slot_free_hint) {
+        ctx->slot_free_hint = slot_no;
+    }
+    
+    /* Decrement status_count */
+    status_count_adjust(ctx, -1);
+}
+
+/*
+ * Evict every slot of an owner table whose grace period has expired and
+ * re-arm the table's eviction timer for the earliest remaining deadline.
+ */
+static void run_evictions(SdsTableContext* ctx, uint32_t now) {
+    uint8_t* slots_base = status_slots_base(ctx, ctx->table);
+    if (!slots_base) return;  /* No slots configured */
+    if (ctx->slot_eviction_pending_offset == 0 || ctx->slot_eviction_deadline_offset == 0) return;
+    
+    size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    bool have_next = false;
+    uint32_t next_deadline = 0;
+    
+    for (uint32_t j = 0; j < ctx->max_status_slots; j++) {
+        uint8_t* slot = slots_base + ((size_t)j * ctx->status_slot_size);
+        bool* slot_valid = (bool*)(slot + valid_offset);
+        bool* slot_eviction_pending = (bool*)(slot + ctx->slot_eviction_pending_offset);
+        
+        if (!*slot_valid || !*slot_eviction_pending) continue;
+        
+        uint32_t deadline = *(uint32_t*)(slot + ctx->slot_eviction_deadline_offset);
+        if (deadline_before(now, deadline)) {
+            /* Still within its grace period */
+            if (!have_next || deadline_before(deadline, next_deadline)) {
+                next_deadline = deadline;
+                have_next = true;
+            }
+            continue;
+        }
+        
+        /* Eviction time! */
+        SDS_LOG_I("Evicting device %s from table %s (grace period expired)", 
+                  (char*)slot, ctx->table_type);
+        release_status_slot(ctx, slot);
+    }
+    
+    if (have_next) {
+        timer_arm_earliest(SDS_TIMER_EVICTION(table_index(ctx)), next_deadline);
+    }
+}
+
 void sds_loop(void) {
     if (!_initialized) {
         static bool warned = false;
@@ -410,17 +1393,20 @@ void sds_loop(void) {
         return;
     }
     
-    /* Check MQTT connection */
+    /* Readers of exported tables age last_seen_ms against the owner clock */
+    if (_shm_exports > 0) {
+        export_tick();
+    }
+    
+    /* Check MQTT connection */
     if (!sds_platform_mqtt_connected()) {
         uint32_t now = sds_platform_millis();
         
         /* Apply exponential backoff */
-        if (_reconnect_backoff_ms > 0) {
-            uint32_t elapsed = now - _last_reconnect_attempt_ms;
-            if (elapsed < _reconnect_backoff_ms) {
-                /* Not yet time to retry */
-                return;
-            }
+        if (_timer_pos[SDS_TIMER_RECONNECT] != SDS_TIMER_NONE &&
+            deadline_before(now, _timer_deadline[SDS_TIMER_RECONNECT])) {
+            /* Not yet time to retry */
+            return;
         }
         
         /* Initialize or increase backoff */
@@ -433,7 +1419,6 @@ void sds_loop(void) {
             }
         }
         
-        _last_reconnect_attempt_ms = now;
         SDS_LOG_W("MQTT disconnected, attempting reconnect (backoff: %u ms)...", _reconnect_backoff_ms);
         
         /* Rebuild LWT for reconnect */
@@ -456,94 +1441,179 @@ void sds_loop(void) {
         }
         
         if (reconnect_success) {
-            _stats.reconnect_count++;
+            stats_count(&_stats.reconnect_count, 1);
             SDS_LOG_I("MQTT reconnected successfully");
             
             /* Reset backoff on success */
             _reconnect_backoff_ms = 0;
+            timer_cancel(SDS_TIMER_RECONNECT);
+            
+            /* Messages queued before the disconnect can go out now */
+            if (_outq_async) {
+                sds_platform_outbound_notify();
+            }
+            
+            /* A resumed session still has every subscription */
+            if (_persistent_session && sds_platform_mqtt_session_present()) {
+                stats_count(&_stats.sessions_resumed, 1);
+                SDS_LOG_I("MQTT session resumed, subscriptions kept");
+            } else {
+                resubscribe_all();
+            }
             
-            /* Re-subscribe to all tables */
-            for (int i = 0; i < SDS_MAX_TABLES; i++) {
+            /* Resync owner slot indexes */
+            for (int i = 0; i < _table_cap; i++) {
                 if (_tables[i].active) {
-                    subscribe_table_topics(&_tables[i]);
+                    if (_tables[i].role == SDS_ROLE_OWNER) {
+                        table_lock(&_tables[i]);
+                        slot_index_rebuild(&_tables[i]);
+                        table_unlock(&_tables[i]);
+                    }
                 }
             }
         } else {
+            timer_arm(SDS_TIMER_RECONNECT, now + _reconnect_backoff_ms);
             notify_error(SDS_ERR_MQTT_DISCONNECTED, "Reconnect failed");
             SDS_LOG_W("Reconnect failed, next attempt in %u ms", _reconnect_backoff_ms);
         }
         return;
     }
     
+    uint32_t loop_start = stats_clock();
+    
     /* Process MQTT messages */
+    uint32_t stage_start = stats_clock();
     sds_platform_mqtt_loop();
+    stats_record(&_loop_stats.mqtt_us, stage_start);
+    
+    /* Apply queued messages that are ours to apply, and deferred callbacks */
+    if (_inq_depth > 0) {
+        inbound_run_loop();
+    }
     
     uint32_t now = sds_platform_millis();
     
-    /* Sync each table */
-    for (int i = 0; i < SDS_MAX_TABLES; i++) {
-        SdsTableContext* ctx = &_tables[i];
-        if (!ctx->active) continue;
-        
-        if (now - ctx->last_sync_ms >= ctx->sync_interval_ms) {
-            sync_table(ctx);
-            ctx->last_sync_ms = now;
+    /* Connected again without going through the reconnect path */
+    timer_cancel(SDS_TIMER_RECONNECT);
+    
+    /* Grace periods started on the receive path: the next eviction pass re-arms precisely */
+    for (uint8_t i = 0; i < _table_cap; i++) {
+        if (atomic_exchange_explicit(&_tables[i].eviction_rearm, false, memory_order_acquire) &&
+            _tables[i].active) {
+            timer_arm_earliest(SDS_TIMER_EVICTION(i), now);
         }
     }
     
-    /* Check for expired eviction timers (owner tables only) */
-    if (_eviction_grace_ms > 0) {
-        for (int i = 0; i < SDS_MAX_TABLES; i++) {
-            SdsTableContext* ctx = &_tables[i];
-            if (!ctx->active || ctx->role != SDS_ROLE_OWNER) continue;
-            if (ctx->status_slots_offset == 0) continue;  /* No slots configured */
-            
-            uint8_t* slots_base = (uint8_t*)ctx->table + ctx->status_slots_offset;
-            size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    /*
+     * Collect due timers before running them: handlers re-arm their own
+     * timers (possibly already due again when the interval is 0) and a
+     * callback may register or unregister tables.
+     */
+    uint16_t due_count = timer_pop_due(now, _timer_due);
+    
+    for (uint16_t i = 0; i < due_count; i++) {
+        uint16_t id = _timer_due[i];
+        
+        if (id < _table_cap) {
+            /* Sync (change detection + liveness) */
+            SdsTableContext* ctx = &_tables[id];
+            if (!ctx->active) continue;
             
-            for (uint8_t j = 0; j < ctx->max_status_slots; j++) {
-                uint8_t* slot = slots_base + (j * ctx->status_slot_size);
-                bool* slot_valid = (bool*)(slot + valid_offset);
-                
-                if (!*slot_valid) continue;
-                
-                /* Check if eviction is pending */
-                if (ctx->slot_eviction_pending_offset > 0) {
-                    bool* slot_eviction_pending = (bool*)(slot + ctx->slot_eviction_pending_offset);
-                    if (!*slot_eviction_pending) continue;
-                    
-                    /* Check if deadline has passed */
-                    if (ctx->slot_eviction_deadline_offset > 0) {
-                        uint32_t* slot_eviction_deadline = (uint32_t*)(slot + ctx->slot_eviction_deadline_offset);
-                        if (now >= *slot_eviction_deadline) {
-                            /* Eviction time! */
-                            char* slot_node_id = (char*)slot;
-                            SDS_LOG_I("Evicting device %s from table %s (grace period expired)", 
-                                      slot_node_id, ctx->table_type);
-                            
-                            /* Invoke global eviction callback before clearing */
-                            if (_eviction_callback) {
-                                _eviction_callback(ctx->table_type, slot_node_id, _eviction_user_data);
-                            }
-                            
-                            /* Clear the slot */
-                            *slot_valid = false;
-                            *slot_eviction_pending = false;
-                            memset(slot_node_id, 0, SDS_MAX_NODE_ID_LEN);
-                            
-                            /* Decrement status_count */
-                            if (ctx->status_count_offset > 0) {
-                                uint8_t* count_ptr = (uint8_t*)ctx->table + ctx->status_count_offset;
-                                if (*count_ptr > 0) {
-                                    (*count_ptr)--;
-                                }
-                            }
-                        }
-                    }
-                }
+            stage_start = stats_clock();
+            bool congested = ctx->sync_max_ms > 0 && outbound_congested();
+            table_lock(ctx);
+            bool changed = sync_table(ctx);
+            table_unlock(ctx);
+            stats_record(&_loop_stats.sync_us, stage_start);
+            ctx->last_sync_ms = now;
+            sync_adapt(ctx, changed, congested);
+            timer_arm(id, sync_next_deadline(ctx, now));
+        } else if (id < SDS_TIMER_RECONNECT) {
+            /* Eviction grace periods (owner tables only) */
+            SdsTableContext* ctx = &_tables[id - _table_cap];
+            if (ctx->active && ctx->role == SDS_ROLE_OWNER) {
+                stage_start = stats_clock();
+                table_lock(ctx);
+                run_evictions(ctx, now);
+                table_unlock(ctx);
+                stats_record(&_loop_stats.eviction_us, stage_start);
             }
+        } else if (id == SDS_TIMER_BATCH) {
+            batch_flush();
+        }
+    }
+    
+    if (_resync_count > 0) {
+        resync_flush();
+    }
+    
+    /* Without a flush interval, a batch carries what this loop synced */
+    if (_batch_count > 0 && _batch_flush_ms == 0) {
+        batch_flush();
+    }
+    
+    /* Without an async sender, queued messages go out at the end of the loop */
+    if (_outq_depth > 0 && !_outq_async) {
+        outbound_drain();
+    }
+    
+    stats_record(&_loop_stats.loop_us, loop_start);
+}
+
+uint32_t sds_next_deadline_ms(void) {
+    if (!_initialized) {
+        return UINT32_MAX;
+    }
+    
+    uint32_t now = sds_platform_millis();
+    
+    /* While disconnected, sds_loop() only retries the connection */
+    if (!sds_platform_mqtt_connected()) {
+        if (_timer_pos[SDS_TIMER_RECONNECT] == SDS_TIMER_NONE) {
+            return 0;
+        }
+        return ms_until(now, _timer_deadline[SDS_TIMER_RECONNECT]);
+    }
+    
+    /* Queued messages that sds_loop() itself has to send */
+    if (_outq_count > 0 && !_outq_async) {
+        return 0;
+    }
+    
+    /* Relayed messages waiting for the end of the next sds_loop() */
+    if (_batch_count > 0 && _batch_flush_ms == 0) {
+        return 0;
+    }
+    
+    /* Received messages (or their callbacks) that sds_loop() has to apply */
+    if (_inq_depth > 0 && inbound_pending()) {
+        return 0;
+    }
+    
+    /* Grace periods waiting for their eviction timer */
+    for (uint8_t i = 0; i < _table_cap; i++) {
+        if (atomic_load_explicit(&_tables[i].eviction_rearm, memory_order_relaxed)) {
+            return 0;
         }
     }
+    
+    if (_timer_count == 0) {
+        return UINT32_MAX;
+    }
+    
+    /* A leftover reconnect timer at the root is ignored; its children are next */
+    uint16_t root = _timer_heap[0];
+    if (root != SDS_TIMER_RECONNECT) {
+        return ms_until(now, _timer_deadline[root]);
+    }
+    if (_timer_count == 1) {
+        return UINT32_MAX;
+    }
+    uint32_t next = _timer_deadline[_timer_heap[1]];
+    if (_timer_count > 2 && deadline_before(_timer_deadline[_timer_heap[2]], next)) {
+        next = _timer_deadline[_timer_heap[2]];
+    }
+    return ms_until(now, next);
 }
 
 void sds_shutdown(void) {
@@ -551,6 +1621,30 @@ void sds_shutdown(void) {
         return;
     }
     
+    /* The pending batch goes out with the rest of the queue */
+    batch_flush();
+    _batch_max = 0;
+    
+    /* Stop the sender and flush what is still queued */
+    if (_outq_async) {
+        sds_platform_outbound_stop();
+        _outq_async = false;
+    }
+    if (_outq_depth > 0) {
+        outbound_drain();
+        _outq_count = 0;
+        _outq_depth = 0;
+    }
+    
+    /* Stop the ingest workers; messages not yet applied are discarded */
+    if (_inq_async) {
+        sds_platform_ingest_stop();
+        sds_platform_ingest_lock();
+        _inq_async = false;
+        sds_platform_ingest_unlock();
+    }
+    _inq_depth = 0;
+    
     /* Publish graceful offline message (prevents broker from sending LWT) */
     if (sds_platform_mqtt_connected()) {
         char lwt_topic[SDS_TOPIC_BUFFER_SIZE];
@@ -562,26 +1656,31 @@ void sds_shutdown(void) {
         SDS_LOG_D("Published graceful offline message");
     }
     
-    for (int i = 0; i < SDS_MAX_TABLES; i++) {
+    for (int i = 0; i < _table_cap; i++) {
         if (_tables[i].active) {
             unsubscribe_table_topics(&_tables[i]);
+            if (_tables[i].shm) export_close(&_tables[i]);
             _tables[i].active = false;
         }
     }
     _table_count = 0;
+    _route_count = 0;
     _lwt_subscribed = false;
-    
-    /* Clean up raw subscriptions */
-    for (int i = 0; i < SDS_MAX_RAW_SUBSCRIPTIONS; i++) {
+    _batch_subscribed = false;
+    _cluster_group[0] = '\0';
+    _cluster_members = 0;
+    timer_reset();
+    _table_cap = 0;
+    _timer_total = 0;
+    
+    /* Clean up raw subscriptions; caller storage is released */
+    for (uint16_t i = 0; i < _raw_sub_cap; i++) {
         if (_raw_subs[i].active) {
             sds_platform_mqtt_unsubscribe(_raw_subs[i].topic);
-            _raw_subs[i].active = false;
-            _raw_subs[i].topic[0] = '\0';
-            _raw_subs[i].callback = NULL;
-            _raw_subs[i].user_data = NULL;
         }
     }
-    _raw_sub_count = 0;
+    raw_storage_setup(_raw_builtin, SDS_MAX_RAW_SUBSCRIPTIONS, NULL, 0);
+    raw_trie_rebuild();
     
     sds_platform_shutdown();
     _initialized = false;
@@ -622,10 +1721,10 @@ SdsError sds_publish_raw(
     bool success = sds_platform_mqtt_publish(topic, (const uint8_t*)payload, payload_len, retained);
     
     if (success) {
-        _stats.messages_sent++;
+        stats_count(&_stats.messages_sent, 1);
         return SDS_OK;
     } else {
-        _stats.errors++;
+        stats_count(&_stats.errors, 1);
         return SDS_ERR_PLATFORM_ERROR;
     }
 }
@@ -656,38 +1755,87 @@ SdsError sds_subscribe_raw(
         return SDS_ERR_INVALID_CONFIG;
     }
     
-    /* Find free slot */
+    if (!raw_pattern_valid(topic)) {
+        SDS_LOG_W("Invalid topic filter: %s", topic);
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    /* Find a free slot (one still linked waits for the deferred rebuild) */
     int slot = -1;
-    for (int i = 0; i < SDS_MAX_RAW_SUBSCRIPTIONS; i++) {
-        if (!_raw_subs[i].active) {
+    for (uint16_t i = 0; i < _raw_sub_cap; i++) {
+        if (!_raw_subs[i].active && !_raw_subs[i].linked) {
             slot = i;
             break;
         }
     }
     
     if (slot < 0) {
-        SDS_LOG_W("Max raw subscriptions reached (%d)", SDS_MAX_RAW_SUBSCRIPTIONS);
+        SDS_LOG_W("Max raw subscriptions reached (%u)", (unsigned)_raw_sub_cap);
+        return SDS_ERR_MAX_TABLES_REACHED;
+    }
+    
+    /* Store subscription and index it before anything can match it */
+    RawSubscription* rs = &_raw_subs[slot];
+    memcpy(rs->topic, topic, topic_len + 1);
+    rs->callback = callback;
+    rs->user_data = user_data;
+    rs->active = true;
+    _raw_sub_count++;
+    if (!raw_trie_insert((uint16_t)slot)) {
+        SDS_LOG_W("Raw subscription trie full (%u nodes): %s", (unsigned)_raw_node_cap, topic);
+        rs->active = false;
+        _raw_sub_count--;
+        raw_trie_rebuild();  /* Drop the partial path */
         return SDS_ERR_MAX_TABLES_REACHED;
     }
     
     /* Subscribe via platform */
     if (!sds_platform_mqtt_subscribe(topic)) {
         SDS_LOG_E("Failed to subscribe to: %s", topic);
+        rs->active = false;
+        _raw_sub_count--;
+        raw_trie_rebuild();
         return SDS_ERR_PLATFORM_ERROR;
     }
     
-    /* Store subscription */
-    strncpy(_raw_subs[slot].topic, topic, SDS_RAW_TOPIC_MAX_LEN - 1);
-    _raw_subs[slot].topic[SDS_RAW_TOPIC_MAX_LEN - 1] = '\0';
-    _raw_subs[slot].callback = callback;
-    _raw_subs[slot].user_data = user_data;
-    _raw_subs[slot].active = true;
-    _raw_sub_count++;
-    
     SDS_LOG_I("Subscribed to raw topic: %s (slot %d)", topic, slot);
     return SDS_OK;
 }
 
+SdsError sds_set_raw_subscription_storage(void* storage, uint16_t max_subscriptions) {
+    if (!_initialized) {
+        return SDS_ERR_NOT_INITIALIZED;
+    }
+    
+    if (!storage) {
+        max_subscriptions = SDS_MAX_RAW_SUBSCRIPTIONS;
+        storage = _raw_builtin;
+    }
+    if (max_subscriptions == 0 || max_subscriptions < _raw_sub_count ||
+        SDS_RAW_NODE_CAP(max_subscriptions) > UINT16_MAX || _raw_dispatching) {
+        SDS_LOG_E("sds_set_raw_subscription_storage: cannot hold %u subscriptions here (%u active)",
+                  (unsigned)max_subscriptions, (unsigned)_raw_sub_count);
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    /* Compact the active subscriptions, move them over and index them again */
+    uint16_t n = 0;
+    for (uint16_t i = 0; i < _raw_sub_cap; i++) {
+        if (_raw_subs[i].active) {
+            if (i != n) {
+                _raw_subs[n] = _raw_subs[i];
+            }
+            n++;
+        }
+    }
+    raw_storage_setup(storage, max_subscriptions, _raw_subs, n);
+    raw_trie_rebuild();
+    
+    SDS_LOG_I("Raw subscription storage: %u subscriptions, %u trie nodes",
+              (unsigned)_raw_sub_cap, (unsigned)_raw_node_cap);
+    return SDS_OK;
+}
+
 SdsError sds_unsubscribe_raw(const char* topic) {
     if (!_initialized) {
         return SDS_ERR_NOT_INITIALIZED;
@@ -698,17 +1846,15 @@ SdsError sds_unsubscribe_raw(const char* topic) {
     }
     
     /* Find matching subscription */
-    for (int i = 0; i < SDS_MAX_RAW_SUBSCRIPTIONS; i++) {
+    for (uint16_t i = 0; i < _raw_sub_cap; i++) {
         if (_raw_subs[i].active && strcmp(_raw_subs[i].topic, topic) == 0) {
             /* Unsubscribe via platform */
             sds_platform_mqtt_unsubscribe(topic);
             
-            /* Clear slot */
+            /* The slot's text stays in place until the rebuild unlinks it */
             _raw_subs[i].active = false;
-            _raw_subs[i].topic[0] = '\0';
-            _raw_subs[i].callback = NULL;
-            _raw_subs[i].user_data = NULL;
             _raw_sub_count--;
+            raw_trie_rebuild();
             
             SDS_LOG_I("Unsubscribed from raw topic: %s", topic);
             return SDS_OK;
@@ -730,7 +1876,7 @@ const char* sds_get_node_id(void) {
 /* Internal: allocate and initialize a table slot */
 static SdsTableContext* alloc_table_slot(void* table, const char* table_type, SdsRole role, const SdsTableOptions* options) {
     SdsTableContext* ctx = NULL;
-    for (int i = 0; i < SDS_MAX_TABLES; i++) {
+    for (int i = 0; i < _table_cap; i++) {
         if (!_tables[i].active) {
             ctx = &_tables[i];
             break;
@@ -741,21 +1887,68 @@ static SdsTableContext* alloc_table_slot(void* table, const char* table_type, Sd
         return NULL;  /* No slots available */
     }
     
+    /* Keep the slot's arena blocks for reuse; everything else starts from zero */
+    uint8_t* shadow = ctx->shadow_config;
+    size_t shadow_capacity = ctx->shadow_capacity;
+    uint32_t* slot_index = ctx->slot_index_builtin;
+    SdsTableStats* stats = ctx->stats;
+    char* field_keys = ctx->field_keys;
+    uint16_t field_keys_cap = ctx->field_keys_cap;
+    SdsFieldTrack* track = ctx->track;
+    uint8_t track_cap = ctx->track_cap;
+    uint32_t* slot_liveness = ctx->slot_liveness;
+    uint32_t slot_liveness_cap = ctx->slot_liveness_cap;
     memset(ctx, 0, sizeof(*ctx));
+    ctx->shadow_config = shadow;
+    ctx->shadow_capacity = shadow_capacity;
+    ctx->slot_index_builtin = slot_index;
+    ctx->stats = stats;
+    ctx->field_keys = field_keys;
+    ctx->field_keys_cap = field_keys_cap;
+    ctx->track = track;
+    ctx->track_cap = track_cap;
+    ctx->slot_liveness = slot_liveness;
+    ctx->slot_liveness_cap = slot_liveness_cap;
     ctx->active = true;
     ctx->table = table;
     strncpy(ctx->table_type, table_type, SDS_MAX_TABLE_TYPE_LEN - 1);
     ctx->role = role;
     ctx->sync_interval_ms = options ? options->sync_interval_ms : SDS_DEFAULT_SYNC_INTERVAL_MS;
+    ctx->wire_format = options ? options->wire_format : SDS_WIRE_JSON;
+    ctx->dirty_tracking = options ? options->dirty_tracking : false;
     ctx->liveness_interval_ms = SDS_DEFAULT_LIVENESS_INTERVAL_MS;  /* Will be overridden from registry */
     ctx->last_sync_ms = sds_platform_millis();
     ctx->last_publish_ms = sds_platform_millis();  /* Initialize to now */
     
+    if (options && options->sync_interval_max_ms > 0) {
+        /* Adaptive: min defaults to the base interval, and never 0 so it can grow back */
+        uint32_t min = options->sync_interval_min_ms ? options->sync_interval_min_ms : ctx->sync_interval_ms;
+        if (min == 0) min = 1;
+        uint32_t max = options->sync_interval_max_ms < min ? min : options->sync_interval_max_ms;
+        ctx->sync_min_ms = min;
+        ctx->sync_max_ms = max;
+        ctx->sync_current_ms = ctx->sync_interval_ms < min ? min :
+                               ctx->sync_interval_ms > max ? max : ctx->sync_interval_ms;
+    }
+    ctx->liveness_max_ms = options ? options->liveness_max_ms : 0;
+    
+    uint32_t idx = table_index(ctx);
+    timer_cancel(SDS_TIMER_EVICTION(idx));
+    timer_arm(SDS_TIMER_SYNC(idx), ctx->last_sync_ms +
+              (ctx->sync_max_ms ? ctx->sync_current_ms : ctx->sync_interval_ms));
+    
     _table_count++;
     
     return ctx;
 }
 
+/* Give back a slot whose registration failed after alloc_table_slot() */
+static void release_table_slot(SdsTableContext* ctx) {
+    timer_cancel(SDS_TIMER_SYNC(table_index(ctx)));
+    ctx->active = false;
+    _table_count--;
+}
+
 /* Internal: subscribe to topics for a table */
 static void sds_activate_table_subscriptions(SdsTableContext* ctx) {
     if (sds_platform_mqtt_connected()) {
@@ -783,10 +1976,10 @@ SdsError sds_register_table(void* table, const char* table_type, SdsRole role, c
         return SDS_ERR_TABLE_NOT_FOUND;
     }
     
-    /* Use registry metadata to call sds_register_table_ex */
+    /* Register from registry metadata (callbacks and field descriptors) */
     if (role == SDS_ROLE_DEVICE) {
-        SdsError err = sds_register_table_ex(
-            table, table_type, role, options,
+        SdsError err = register_table_common(
+            table, table_type, role, options, meta,
             meta->dev_config_offset, meta->dev_config_size,
             meta->dev_state_offset, meta->dev_state_size,
             meta->dev_status_offset, meta->dev_status_size,
@@ -798,26 +1991,27 @@ SdsError sds_register_table(void* table, const char* table_type, SdsRole role, c
             NULL                          /* Device doesn't receive status */
         );
         
-        /* Set liveness interval and field metadata from registry */
+        /* Set liveness interval from registry */
         if (err == SDS_OK) {
             SdsTableContext* ctx = find_table(table_type);
             if (ctx) {
                 ctx->liveness_interval_ms = meta->liveness_interval_ms;
-                /* Copy field metadata for delta sync */
-                ctx->config_fields = meta->config_fields;
-                ctx->config_field_count = meta->config_field_count;
-                ctx->state_fields = meta->state_fields;
-                ctx->state_field_count = meta->state_field_count;
-                ctx->status_fields = meta->status_fields;
-                ctx->status_field_count = meta->status_field_count;
+                if (meta->aggregate_source && meta->aggregate_count > 0) {
+                    err = sds_set_table_aggregates(table_type, meta->aggregate_source,
+                        meta->aggregates, meta->aggregate_count,
+                        (uint8_t*)table + meta->aggregate_storage_offset, meta->aggregate_storage_size);
+                    if (err != SDS_OK) {
+                        sds_unregister_table(table_type);
+                    }
+                }
             }
         }
         
         return err;
     } else {
         /* OWNER role */
-        SdsError err = sds_register_table_ex(
-            table, table_type, role, options,
+        SdsError err = register_table_common(
+            table, table_type, role, options, meta,
             meta->own_config_offset, meta->own_config_size,
             meta->own_state_offset, meta->own_state_size,
             0, 0,                         /* Owner doesn't send status */
@@ -829,7 +2023,7 @@ SdsError sds_register_table(void* table, const char* table_type, SdsRole role, c
             meta->deserialize_status      /* Owner receives status */
         );
         
-        /* Populate status slot metadata, liveness, and field metadata for owners */
+        /* Populate status slot metadata and liveness for owners */
         if (err == SDS_OK) {
             SdsTableContext* ctx = find_table(table_type);
             if (ctx) {
@@ -845,15 +2039,20 @@ SdsError sds_register_table(void* table, const char* table_type, SdsRole role, c
                     ctx->slot_last_seen_offset = meta->slot_last_seen_offset;
                     ctx->slot_eviction_deadline_offset = meta->slot_eviction_deadline_offset;
                     ctx->slot_status_offset = meta->slot_status_offset;
+                    ctx->slot_seq_offset = meta->slot_seq_offset;
                     ctx->status_count_offset = meta->own_status_count_offset;
+                    ctx->status_count_size = meta->own_status_count_size ? meta->own_status_count_size : 1;
+                    ctx->status_slots_external = meta->own_status_slots_external != 0;
+                    slot_index_rebuild(ctx);
+                    slot_liveness_setup(ctx);
+                }
+                if (meta->own_status_history_offset > 0 && meta->own_status_history_depth > 0) {
+                    uint16_t depth = meta->own_status_history_depth;
+                    sds_set_owner_status_history(table_type,
+                        (uint8_t*)table + meta->own_status_history_offset,
+                        sds_status_history_size(table_type, depth), depth);
                 }
-                /* Copy field metadata for delta sync */
-                ctx->config_fields = meta->config_fields;
-                ctx->config_field_count = meta->config_field_count;
-                ctx->state_fields = meta->state_fields;
-                ctx->state_field_count = meta->state_field_count;
-                ctx->status_fields = meta->status_fields;
-                ctx->status_field_count = meta->status_field_count;
+                aggregate_relink(ctx);
             }
         }
         
@@ -875,25 +2074,141 @@ SdsError sds_unregister_table(const char* table_type) {
         unsubscribe_table_topics(ctx);
     }
     
+    /* Hand the slots back to the caller's array before the table goes */
+    if (ctx->shm) {
+        export_close(ctx);
+    }
+    aggregate_unlink(ctx);
+    
+    /* Wait out a worker applying a message, then drop the rest */
+    table_lock(ctx);
     ctx->active = false;
     _table_count--;
+    routes_rebuild();
+    inbound_purge_table(ctx);
+    table_unlock(ctx);
+    timer_cancel(SDS_TIMER_SYNC(table_index(ctx)));
+    timer_cancel(SDS_TIMER_EVICTION(table_index(ctx)));
     
     SDS_LOG_I("Table unregistered: %s", table_type);
     
     return SDS_OK;
 }
 
+SdsError sds_set_table_fields(
+    const char* table_type,
+    const SdsFieldMeta* config_fields, uint8_t config_field_count,
+    const SdsFieldMeta* state_fields, uint8_t state_field_count,
+    const SdsFieldMeta* status_fields, uint8_t status_field_count
+) {
+    if (!_initialized) {
+        return SDS_ERR_NOT_INITIALIZED;
+    }
+    
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx) {
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    
+    bool had_config_fields = ctx->config_fields != NULL;
+    
+    ctx->config_fields = config_fields;
+    ctx->config_field_count = config_fields ? config_field_count : 0;
+    ctx->state_fields = state_fields;
+    ctx->state_field_count = state_fields ? state_field_count : 0;
+    ctx->status_fields = status_fields;
+    ctx->status_field_count = status_fields ? status_field_count : 0;
+    cache_field_keys(ctx);
+    filters_setup(ctx);
+    aggregate_fields_changed(ctx);
+    
+    /* Schema-only owners could not publish at registration; do it now */
+    if (ctx->role == SDS_ROLE_OWNER && !ctx->serialize_config && !had_config_fields &&
+        ctx->config_fields && ctx->config_size > 0) {
+        if (publish_config(ctx, sds_platform_millis(), NULL)) {
+            SDS_LOG_I("Published initial config: %s", ctx->table_type);
+        }
+    }
+    
+    /* Likewise, schema-only devices could not restore a cached config */
+    config_cache_restore(ctx);
+    
+    return SDS_OK;
+}
+
+SdsError sds_mark_dirty(const char* table_type, SdsSection section, uint8_t field_idx) {
+    if (!_initialized) {
+        return SDS_ERR_NOT_INITIALIZED;
+    }
+    
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx) {
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    
+    SdsFieldMask* dirty;
+    uint8_t field_count;
+    switch (section) {
+        case SDS_SECTION_CONFIG: dirty = &ctx->dirty_config; field_count = ctx->config_field_count; break;
+        case SDS_SECTION_STATE:  dirty = &ctx->dirty_state;  field_count = ctx->state_field_count;  break;
+        case SDS_SECTION_STATUS: dirty = &ctx->dirty_status; field_count = ctx->status_field_count; break;
+        default: return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    if (field_idx == SDS_ALL_FIELDS) {
+        memset(dirty, 0xFF, sizeof(*dirty));
+    } else if (field_idx < field_count) {
+        field_mask_set(dirty, field_idx);
+    } else {
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    return SDS_OK;
+}
+
 uint8_t sds_get_table_count(void) {
     return _table_count;
 }
 
+SdsError sds_lock_table(const char* table_type) {
+    if (!_initialized) {
+        return SDS_ERR_NOT_INITIALIZED;
+    }
+    
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx) {
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    
+    table_lock(ctx);
+    return SDS_OK;
+}
+
+SdsError sds_unlock_table(const char* table_type) {
+    if (!_initialized) {
+        return SDS_ERR_NOT_INITIALIZED;
+    }
+    
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx) {
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    
+    table_unlock(ctx);
+    return SDS_OK;
+}
+
 /* ============== Extended Registration with Serialization ============== */
 
-SdsError sds_register_table_ex(
+/**
+ * Common registration path. meta (may be NULL) supplies field metadata so
+ * that the initial config publish can already use the schema serializer.
+ */
+static SdsError register_table_common(
     void* table,
     const char* table_type,
     SdsRole role,
     const SdsTableOptions* options,
+    const SdsTableMeta* meta,
     size_t config_offset, size_t config_size,
     size_t state_offset, size_t state_size,
     size_t status_offset, size_t status_size,
@@ -931,11 +2246,41 @@ SdsError sds_register_table_ex(
     if (config_size > SDS_SHADOW_SIZE || state_size > SDS_SHADOW_SIZE || status_size > SDS_SHADOW_SIZE) {
         SDS_LOG_E("Section size exceeds SDS_SHADOW_SIZE (%d bytes): config=%zu state=%zu status=%zu",
                   (int)SDS_SHADOW_SIZE, config_size, state_size, status_size);
-        ctx->active = false;
-        _table_count--;
+        release_table_slot(ctx);
         return SDS_ERR_SECTION_TOO_LARGE;
     }
     
+    /* Shadows are sized to the sections; a reused slot keeps a block that fits */
+    size_t shadow_bytes = SDS_ARENA_ROUND(config_size) + SDS_ARENA_ROUND(state_size) +
+                          SDS_ARENA_ROUND(status_size);
+    if (shadow_bytes > ctx->shadow_capacity) {
+        uint8_t* shadow = arena_alloc(shadow_bytes);
+        if (!shadow) {
+            SDS_LOG_E("Table arena exhausted: %s needs %zu shadow bytes, %zu free",
+                      table_type, shadow_bytes, _arena_size - _arena_used);
+            release_table_slot(ctx);
+            return SDS_ERR_SECTION_TOO_LARGE;
+        }
+        ctx->shadow_config = shadow;
+        ctx->shadow_capacity = shadow_bytes;
+    }
+    if (ctx->shadow_config) {
+        ctx->shadow_state = ctx->shadow_config + SDS_ARENA_ROUND(config_size);
+        ctx->shadow_status = ctx->shadow_state + SDS_ARENA_ROUND(state_size);
+        memset(ctx->shadow_config, 0, shadow_bytes);  /* First sync detects change */
+    }
+    
+    /* Per-table counters only when something records them */
+    if ((_instrument || _latency_tracking) && !ctx->stats) {
+        ctx->stats = arena_alloc(sizeof(SdsTableStats));
+        if (!ctx->stats) {
+            SDS_LOG_W("Table arena exhausted: %s is registered without per-table stats", table_type);
+        }
+    }
+    if (ctx->stats) {
+        memset(ctx->stats, 0, sizeof(*ctx->stats));
+    }
+    
     ctx->config_offset = config_offset;
     ctx->config_size = config_size;
     ctx->state_offset = state_offset;
@@ -950,35 +2295,34 @@ SdsError sds_register_table_ex(
     ctx->serialize_status = serialize_status;
     ctx->deserialize_status = deserialize_status;
     
-    /* Initialize shadows to zero (so first sync detects change) */
-    memset(ctx->shadow_config, 0, sizeof(ctx->shadow_config));
-    memset(ctx->shadow_state, 0, sizeof(ctx->shadow_state));
-    memset(ctx->shadow_status, 0, sizeof(ctx->shadow_status));
+    /* With dirty tracking the first sync sends every field */
+    memset(&ctx->dirty_config, 0xFF, sizeof(ctx->dirty_config));
+    memset(&ctx->dirty_state, 0xFF, sizeof(ctx->dirty_state));
+    memset(&ctx->dirty_status, 0xFF, sizeof(ctx->dirty_status));
+    
+    if (meta) {
+        ctx->config_fields = meta->config_fields;
+        ctx->config_field_count = meta->config_field_count;
+        ctx->state_fields = meta->state_fields;
+        ctx->state_field_count = meta->state_field_count;
+        ctx->status_fields = meta->status_fields;
+        ctx->status_field_count = meta->status_field_count;
+    }
+    cache_field_keys(ctx);
+    filters_setup(ctx);
+    routes_rebuild();
+    
+    /* Devices start from the cached config, before the retained one arrives */
+    config_cache_restore(ctx);
     
     /* Now that callbacks are set, subscribe to topics */
     sds_activate_table_subscriptions(ctx);
     
     /* Force initial sync for owners to publish config immediately */
-    if (role == SDS_ROLE_OWNER && serialize_config && config_size > 0) {
-        char topic[SDS_TOPIC_BUFFER_SIZE];
-        char buffer[SDS_MSG_BUFFER_SIZE];
-        SdsJsonWriter w;
-        void* config_ptr = (uint8_t*)table + config_offset;
-        
-        sds_json_writer_init(&w, buffer, sizeof(buffer));
-        sds_json_start_object(&w);
-        sds_json_add_uint(&w, "ts", sds_platform_millis());
-        sds_json_add_string(&w, "from", _node_id);
-        serialize_config(config_ptr, &w);  /* Pass section pointer */
-        sds_json_end_object(&w);
-        
-        snprintf(topic, sizeof(topic), "sds/%s/config", table_type);
-        sds_platform_mqtt_publish(topic, (uint8_t*)buffer, sds_json_get_length(&w), true);
-        
-        /* Update shadow after initial publish */
-        memcpy(ctx->shadow_config, config_ptr, ctx->config_size);
-        _stats.messages_sent++;
-        SDS_LOG_I("Published initial config: %s", table_type);
+    if (role == SDS_ROLE_OWNER && can_serialize(serialize_config, ctx->config_fields) && config_size > 0) {
+        if (publish_config(ctx, sds_platform_millis(), NULL)) {
+            SDS_LOG_I("Published initial config: %s", table_type);
+        }
     }
     
     SDS_LOG_I("Table registered: %s (role=%s)", table_type, 
@@ -987,6 +2331,32 @@ SdsError sds_register_table_ex(
     return SDS_OK;
 }
 
+SdsError sds_register_table_ex(
+    void* table,
+    const char* table_type,
+    SdsRole role,
+    const SdsTableOptions* options,
+    size_t config_offset, size_t config_size,
+    size_t state_offset, size_t state_size,
+    size_t status_offset, size_t status_size,
+    SdsSerializeFunc serialize_config,
+    SdsDeserializeFunc deserialize_config,
+    SdsSerializeFunc serialize_state,
+    SdsDeserializeFunc deserialize_state,
+    SdsSerializeFunc serialize_status,
+    SdsDeserializeFunc deserialize_status
+) {
+    return register_table_common(
+        table, table_type, role, options, NULL,
+        config_offset, config_size,
+        state_offset, state_size,
+        status_offset, status_size,
+        serialize_config, deserialize_config,
+        serialize_state, deserialize_state,
+        serialize_status, deserialize_status
+    );
+}
+
 /* ============== Callbacks ============== */
 
 void sds_on_config_update(const char* table_type, SdsConfigCallback callback, void* user_data) {
@@ -1017,6 +2387,11 @@ void sds_on_error(SdsErrorCallback callback) {
     _error_callback = callback;
 }
 
+void sds_on_wake(SdsWakeCallback callback, void* user_data) {
+    _wake_user_data = user_data;
+    _wake_callback = callback;
+}
+
 void sds_on_version_mismatch(SdsVersionMismatchCallback callback) {
     _version_mismatch_callback = callback;
 }
@@ -1043,7 +2418,7 @@ void sds_set_owner_status_slots(
     size_t slot_size,
     size_t slot_status_offset,
     size_t count_offset,
-    uint8_t max_slots
+    uint32_t max_slots
 ) {
     SdsTableContext* ctx = find_table(table_type);
     if (!ctx || ctx->role != SDS_ROLE_OWNER) {
@@ -1052,61 +2427,173 @@ void sds_set_owner_status_slots(
         return;
     }
     
+    sds_set_owner_status_slots_wide(table_type, SDS_SLOTS_INLINE, slots_offset, slot_size,
+                                    slot_status_offset, count_offset, 1, max_slots);
+}
+
+SdsError sds_set_owner_status_slots_wide(
+    const char* table_type,
+    SdsSlotStorage storage,
+    size_t slots_offset,
+    size_t slot_size,
+    size_t slot_status_offset,
+    size_t count_offset,
+    uint8_t count_size,
+    uint32_t max_slots
+) {
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) {
+        SDS_LOG_W("sds_set_owner_status_slots_wide: table %s not found or not owner", 
+                  table_type ? table_type : "(null)");
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    
+    if (count_size != 1 && count_size != 2 && count_size != 4) {
+        SDS_LOG_E("sds_set_owner_status_slots_wide: invalid count size %u", (unsigned)count_size);
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    /* status_count must be able to hold max_slots */
+    if (count_size < 4 && max_slots > ((1u << (count_size * 8)) - 1)) {
+        SDS_LOG_E("sds_set_owner_status_slots_wide: %u slots do not fit a %u-byte count",
+                  (unsigned)max_slots, (unsigned)count_size);
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    /* The segment was laid out for the old slots */
+    if (ctx->shm) {
+        export_close(ctx);
+    }
+    
     ctx->status_slots_offset = slots_offset;
+    ctx->status_slots_external = (storage == SDS_SLOTS_EXTERNAL);
     ctx->status_slot_size = slot_size;
     ctx->slot_status_offset = slot_status_offset;
     ctx->status_count_offset = count_offset;
+    ctx->status_count_size = count_size;
     ctx->max_status_slots = max_slots;
+    slot_index_rebuild(ctx);
+    slot_liveness_setup(ctx);
     
-    SDS_LOG_D("Configured status slots for %s: offset=%zu size=%zu max=%d",
-              table_type, slots_offset, slot_size, max_slots);
+    /* Rings were laid out for the old slots */
+    ctx->history = NULL;
+    ctx->history_depth = 0;
+    aggregate_relink(ctx);
+    
+    SDS_LOG_D("Configured status slots for %s: offset=%zu size=%zu max=%u%s",
+              table_type, slots_offset, slot_size, (unsigned)max_slots,
+              ctx->status_slots_external ? " (external)" : "");
+    return SDS_OK;
 }
 
-void sds_set_owner_slot_offsets(
+SdsError sds_set_owner_slot_index(
     const char* table_type,
-    size_t valid_offset,
-    size_t online_offset,
-    size_t last_seen_offset
+    uint32_t* buckets,
+    uint32_t bucket_count
 ) {
     SdsTableContext* ctx = find_table(table_type);
     if (!ctx || ctx->role != SDS_ROLE_OWNER) {
-        SDS_LOG_W("sds_set_owner_slot_offsets: table %s not found or not owner", 
+        SDS_LOG_W("sds_set_owner_slot_index: table %s not found or not owner", 
                   table_type ? table_type : "(null)");
-        return;
+        return SDS_ERR_TABLE_NOT_FOUND;
     }
     
-    ctx->slot_valid_offset = valid_offset;
-    ctx->slot_online_offset = online_offset;
-    ctx->slot_last_seen_offset = last_seen_offset;
+    if (buckets && (bucket_count < 2 || (bucket_count & (bucket_count - 1)) != 0)) {
+        SDS_LOG_E("sds_set_owner_slot_index: bucket count %u is not a power of two",
+                  (unsigned)bucket_count);
+        return SDS_ERR_INVALID_CONFIG;
+    }
     
-    SDS_LOG_D("Configured slot offsets for %s: valid=%zu online=%zu last_seen=%zu",
-              table_type, valid_offset, online_offset, last_seen_offset);
+    ctx->slot_index_ext = buckets;
+    ctx->slot_index_ext_size = buckets ? bucket_count : 0;
+    slot_index_rebuild(ctx);
+    return SDS_OK;
 }
 
-void sds_set_owner_eviction_offsets(
-    const char* table_type,
-    size_t eviction_pending_offset,
-    size_t eviction_deadline_offset
-) {
+SdsError sds_set_owner_slot_seqlocks(const char* table_type, SdsSeqlock* counters, uint32_t count) {
     SdsTableContext* ctx = find_table(table_type);
     if (!ctx || ctx->role != SDS_ROLE_OWNER) {
-        SDS_LOG_W("sds_set_owner_eviction_offsets: table %s not found or not owner", 
+        SDS_LOG_W("sds_set_owner_slot_seqlocks: table %s not found or not owner",
                   table_type ? table_type : "(null)");
-        return;
+        return SDS_ERR_TABLE_NOT_FOUND;
     }
     
-    ctx->slot_eviction_pending_offset = eviction_pending_offset;
+    if (counters && count == 0) {
+        SDS_LOG_E("sds_set_owner_slot_seqlocks: no counters for %s", table_type);
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    if (ctx->shm) {
+        SDS_LOG_E("sds_set_owner_slot_seqlocks: %s is exported, its counters live in the segment",
+                  table_type);
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    table_lock(ctx);
+    if (counters) memset(counters, 0, (size_t)count * sizeof(SdsSeqlock));
+    ctx->slot_seqlocks = (_Atomic uint32_t*)counters;
+    ctx->slot_seqlock_count = counters ? count : 0;
+    table_unlock(ctx);
+    return SDS_OK;
+}
+
+void sds_set_owner_slot_offsets(
+    const char* table_type,
+    size_t valid_offset,
+    size_t online_offset,
+    size_t last_seen_offset
+) {
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) {
+        SDS_LOG_W("sds_set_owner_slot_offsets: table %s not found or not owner", 
+                  table_type ? table_type : "(null)");
+        return;
+    }
+    
+    ctx->slot_valid_offset = valid_offset;
+    ctx->slot_online_offset = online_offset;
+    ctx->slot_last_seen_offset = last_seen_offset;
+    slot_index_rebuild(ctx);
+    
+    SDS_LOG_D("Configured slot offsets for %s: valid=%zu online=%zu last_seen=%zu",
+              table_type, valid_offset, online_offset, last_seen_offset);
+}
+
+void sds_set_owner_eviction_offsets(
+    const char* table_type,
+    size_t eviction_pending_offset,
+    size_t eviction_deadline_offset
+) {
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) {
+        SDS_LOG_W("sds_set_owner_eviction_offsets: table %s not found or not owner", 
+                  table_type ? table_type : "(null)");
+        return;
+    }
+    
+    ctx->slot_eviction_pending_offset = eviction_pending_offset;
     ctx->slot_eviction_deadline_offset = eviction_deadline_offset;
     
     SDS_LOG_D("Configured eviction offsets for %s: pending=%zu deadline=%zu",
               table_type, eviction_pending_offset, eviction_deadline_offset);
 }
 
+void sds_set_owner_seq_offset(const char* table_type, size_t seq_offset) {
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) {
+        SDS_LOG_W("sds_set_owner_seq_offset: table %s not found or not owner",
+                  table_type ? table_type : "(null)");
+        return;
+    }
+    
+    ctx->slot_seq_offset = seq_offset;
+}
+
 /**
  * Internal helper to notify errors through the callback.
  */
 static void notify_error(SdsError error, const char* context) {
-    _stats.errors++;
+    stats_count(&_stats.errors, 1);
     if (_error_callback) {
         _error_callback(error, context);
     }
@@ -1118,34 +2605,455 @@ const SdsStats* sds_get_stats(void) {
     return &_stats;
 }
 
-/* ============== Owner Helpers ============== */
+/* Start of a timed section (0 when instrumentation is off) */
+static uint32_t stats_clock(void) {
+    return _instrument ? sds_platform_micros() : 0;
+}
 
-const void* sds_find_node_status(const void* owner_table, const char* table_type, const char* node_id) {
-    if (!owner_table || !table_type || !node_id) return NULL;
+static void histogram_add(SdsLatencyHistogram* h, uint32_t value) {
+    uint8_t bucket = 0;
+    for (uint32_t v = value; v > 1 && bucket < SDS_LATENCY_BUCKETS - 1; v >>= 1) {
+        bucket++;
+    }
+    
+    h->count++;
+    h->total_us += value;
+    if (value > h->max_us) h->max_us = value;
+    h->buckets[bucket]++;
+}
+
+static void stats_record(SdsLatencyHistogram* h, uint32_t start_us) {
+    if (!_instrument) return;
+    histogram_add(h, sds_platform_micros() - start_us);
+}
+
+uint32_t sds_latency_percentile(const SdsLatencyHistogram* h, uint8_t percent) {
+    if (!h || h->count == 0) return 0;
+    if (percent > 100) percent = 100;
+    
+    /* Smallest bucket holding at least percent of the samples */
+    uint64_t target = ((uint64_t)h->count * percent + 99) / 100;
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (uint8_t i = 0; i < SDS_LATENCY_BUCKETS - 1; i++) {
+        seen += h->buckets[i];
+        if (seen >= target) {
+            uint32_t upper = (2u << i) - 1;
+            return upper < h->max_us ? upper : h->max_us;
+        }
+    }
+    return h->max_us;
+}
+
+SdsError sds_get_table_stats(const char* table_type, SdsTableStats* out) {
+    if (!_initialized) return SDS_ERR_NOT_INITIALIZED;
+    if (!table_type || !out) return SDS_ERR_INVALID_CONFIG;
     
-    /* Find the table context to get slot metadata */
     SdsTableContext* ctx = find_table(table_type);
-    if (!ctx || ctx->role != SDS_ROLE_OWNER) return NULL;
-    if (ctx->status_slots_offset == 0 || ctx->max_status_slots == 0) return NULL;
+    if (!ctx) return SDS_ERR_TABLE_NOT_FOUND;
+    
+    table_lock(ctx);
+    if (ctx->stats) {
+        *out = *ctx->stats;
+    } else {
+        memset(out, 0, sizeof(*out));
+    }
+    table_unlock(ctx);
+    return SDS_OK;
+}
+
+void sds_get_loop_stats(SdsLoopStats* out) {
+    if (out) *out = _loop_stats;
+}
+
+void sds_reset_stats(void) {
+    uint32_t outbound_queued = _stats.outbound_queued;
+    uint32_t inbound_queued = _stats.inbound_queued;
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.outbound_queued = outbound_queued;
+    _stats.inbound_queued = inbound_queued;
+    
+    memset(&_loop_stats, 0, sizeof(_loop_stats));
+    for (uint8_t i = 0; i < _table_cap; i++) {
+        if (!_tables[i].active || !_tables[i].stats) continue;
+        table_lock(&_tables[i]);
+        memset(_tables[i].stats, 0, sizeof(*_tables[i].stats));
+        table_unlock(&_tables[i]);
+    }
+}
+
+/* A table's counters when instrumentation is on (NULL = not counted) */
+static inline SdsTableStats* table_stats(const SdsTableContext* ctx) {
+    return _instrument ? ctx->stats : NULL;
+}
+
+/* A table message left the sync path (published or queued) */
+static void stats_sent(SdsTableContext* ctx, size_t len, bool delta) {
+    SdsTableStats* st = table_stats(ctx);
+    if (!st) return;
+    st->messages_sent++;
+    st->bytes_sent += (uint32_t)len;
+    if (delta) {
+        st->delta_syncs++;
+    } else {
+        st->full_syncs++;
+    }
+}
+
+/* ============== Status Slot Index ============== */
+
+/*
+ * Owner tables keep an open-addressing hash index (node_id -> slot)
+ * alongside the caller-owned slot array, so per-message lookups do not
+ * have to strcmp every slot. Entries store slot + 1 (0 = empty) and use
+ * linear probing with backward-shift deletion, so there are no tombstones.
+ * The slot array stays authoritative: every hit is verified against the
+ * slot's node_id and valid flag, and the index is rebuilt from the slots
+ * whenever the slot layout is (re)configured or MQTT reconnects.
+ */
+
+/* FNV-1a, 32-bit */
+static uint32_t hash_node_id(const char* node_id) {
+    uint32_t h = 2166136261u;
+    while (*node_id) {
+        h ^= (uint8_t)*node_id++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * Base address of the slot array for a given owner table buffer.
+ * Returns NULL if slots are not configured (or the external pointer is unset).
+ */
+static uint8_t* status_slots_base(const SdsTableContext* ctx, const void* table) {
+    if (ctx->status_slots_offset == 0 || ctx->max_status_slots == 0 || !table) return NULL;
+    
+    uint8_t* p = (uint8_t*)table + ctx->status_slots_offset;
+    if (ctx->status_slots_external) {
+        uint8_t* ext;
+        memcpy(&ext, p, sizeof(ext));
+        return ext;
+    }
+    return p;
+}
+
+/* Caller must have checked status_slots_base(ctx, ctx->table) != NULL */
+static uint8_t* status_slot_at(const SdsTableContext* ctx, uint32_t slot) {
+    return status_slots_base(ctx, ctx->table) + ((size_t)slot * ctx->status_slot_size);
+}
+
+/* Inverse of status_slot_at() */
+static uint32_t status_slot_number(const SdsTableContext* ctx, const uint8_t* slot) {
+    return (uint32_t)((size_t)(slot - status_slots_base(ctx, ctx->table)) / ctx->status_slot_size);
+}
+
+/* Add delta (+1/-1) to the owner's status_count, whatever its width */
+static void status_count_adjust(SdsTableContext* ctx, int delta) {
+    if (ctx->status_count_offset == 0) return;
+    
+    uint8_t* p = (uint8_t*)ctx->table + ctx->status_count_offset;
+    uint32_t count;
+    switch (ctx->status_count_size) {
+        case 2: { uint16_t v; memcpy(&v, p, 2); count = v; break; }
+        case 4: { memcpy(&count, p, 4); break; }
+        default: count = *p; break;
+    }
     
-    const uint8_t* slots_base = (const uint8_t*)owner_table + ctx->status_slots_offset;
+    if (delta < 0 && count == 0) return;
+    count = (uint32_t)((int64_t)count + delta);
     
-    /* Use configured offset or fallback to standard layout */
+    switch (ctx->status_count_size) {
+        case 2: { uint16_t v = (uint16_t)count; memcpy(p, &v, 2); break; }
+        case 4: { memcpy(p, &count, 4); break; }
+        default: *p = (uint8_t)count; break;
+    }
+}
+
+static bool slot_matches(const SdsTableContext* ctx, const uint8_t* slot, const char* node_id) {
     size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    return *(const bool*)(slot + valid_offset) && strcmp((const char*)slot, node_id) == 0;
+}
+
+static bool status_slot_matches(const SdsTableContext* ctx, uint32_t slot, const char* node_id) {
+    return slot_matches(ctx, status_slot_at(ctx, slot), node_id);
+}
+
+/* Linear scan of a slot array laid out as described by ctx */
+static int32_t scan_status_slots(const SdsTableContext* ctx, const uint8_t* slots_base, const char* node_id) {
+    if (!slots_base) return -1;
+    for (uint32_t slot = 0; slot < ctx->max_status_slots; slot++) {
+        if (slot_matches(ctx, slots_base + ((size_t)slot * ctx->status_slot_size), node_id)) {
+            return (int32_t)slot;
+        }
+    }
+    return -1;
+}
+
+/* Caller brackets with the index seqlock */
+static void slot_index_put(SdsTableContext* ctx, uint32_t slot) {
+    uint32_t i = hash_node_id((const char*)status_slot_at(ctx, slot)) & ctx->slot_index_mask;
+    while (ctx->slot_index[i] != 0) {
+        if (ctx->slot_index[i] == slot + 1) return;  /* Already indexed */
+        i = (i + 1) & ctx->slot_index_mask;
+    }
+    ctx->slot_index[i] = slot + 1;
+}
+
+static void slot_index_insert(SdsTableContext* ctx, uint32_t slot) {
+    if (!ctx->slot_index_enabled) return;
     
-    /* Search for the node */
-    for (uint8_t i = 0; i < ctx->max_status_slots; i++) {
-        const uint8_t* slot = slots_base + (i * ctx->status_slot_size);
-        const char* slot_node_id = (const char*)slot;
-        const bool* slot_valid = (const bool*)(slot + valid_offset);
+    seq_write_begin(&ctx->slot_index_seq);
+    slot_index_put(ctx, slot);
+    seq_write_end(&ctx->slot_index_seq);
+}
+
+/* Must be called while the slot still holds node_id */
+static void slot_index_remove(SdsTableContext* ctx, const char* node_id) {
+    if (!ctx->slot_index_enabled) return;
+    
+    uint32_t mask = ctx->slot_index_mask;
+    uint32_t i = hash_node_id(node_id) & mask;
+    while (ctx->slot_index[i] != 0) {
+        if (status_slot_matches(ctx, ctx->slot_index[i] - 1, node_id)) break;
+        i = (i + 1) & mask;
+    }
+    if (ctx->slot_index[i] == 0) return;  /* Not indexed */
+    
+    /* Backward-shift deletion: pull later entries of the probe run into the hole */
+    seq_write_begin(&ctx->slot_index_seq);
+    uint32_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        uint32_t entry = ctx->slot_index[j];
+        if (entry == 0) break;
         
-        if (*slot_valid && strcmp(slot_node_id, node_id) == 0) {
-            /* Return pointer to status within the slot */
-            return slot + ctx->slot_status_offset;
+        uint32_t home = hash_node_id((const char*)status_slot_at(ctx, entry - 1)) & mask;
+        /* Entry may move to i only if its home is not cyclically within (i, j] */
+        bool home_in_range = (i <= j) ? (home > i && home <= j) : (home > i || home <= j);
+        if (!home_in_range) {
+            ctx->slot_index[i] = entry;
+            i = j;
         }
     }
+    ctx->slot_index[i] = 0;
+    seq_write_end(&ctx->slot_index_seq);
+}
+
+static void slot_index_rebuild(SdsTableContext* ctx) {
+    seq_write_begin(&ctx->slot_index_seq);
     
-    return NULL;
+    /* The slots may have changed under us: look for free ones from the start */
+    ctx->slot_free_hint = 0;
+    ctx->slot_index_enabled = false;
+    
+    if (ctx->role != SDS_ROLE_OWNER || !status_slots_base(ctx, ctx->table)) {
+        seq_write_end(&ctx->slot_index_seq);
+        return;
+    }
+    
+    uint32_t size = ctx->slot_index_ext ? ctx->slot_index_ext_size : SDS_SLOT_INDEX_SIZE;
+    if ((uint64_t)ctx->max_status_slots * 4 > (uint64_t)size * 3) {
+        SDS_LOG_I("%s: %u status slots exceed the %u-bucket slot index, using linear lookup "
+                  "(see sds_set_owner_slot_index)",
+                  ctx->table_type, (unsigned)ctx->max_status_slots, (unsigned)size);
+        seq_write_end(&ctx->slot_index_seq);
+        return;
+    }
+    
+    /* Only owners that use the built-in buckets carve them, once per table slot */
+    if (!ctx->slot_index_ext && !ctx->slot_index_builtin) {
+        ctx->slot_index_builtin = arena_alloc(SDS_SLOT_INDEX_SIZE * sizeof(uint32_t));
+    }
+    ctx->slot_index = ctx->slot_index_ext ? ctx->slot_index_ext : ctx->slot_index_builtin;
+    if (!ctx->slot_index) {
+        SDS_LOG_W("%s: table arena has no room for the slot index, using linear lookup",
+                  ctx->table_type);
+        seq_write_end(&ctx->slot_index_seq);
+        return;
+    }
+    ctx->slot_index_mask = size - 1;
+    memset(ctx->slot_index, 0, (size_t)size * sizeof(uint32_t));
+    
+    ctx->slot_index_enabled = true;
+    size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    for (uint32_t slot = 0; slot < ctx->max_status_slots; slot++) {
+        const uint8_t* p = status_slot_at(ctx, slot);
+        if (*(const bool*)(p + valid_offset)) {
+            slot_index_put(ctx, slot);
+        }
+    }
+    seq_write_end(&ctx->slot_index_seq);
+}
+
+/**
+ * Find the slot holding node_id.
+ * 
+ * @return Slot index, or -1 if the node has no valid slot
+ */
+static int32_t find_status_slot(const SdsTableContext* ctx, const char* node_id) {
+    const uint8_t* base = status_slots_base(ctx, ctx->table);
+    if (!base) return -1;
+    
+    if (ctx->slot_index_enabled) {
+        uint32_t i = hash_node_id(node_id) & ctx->slot_index_mask;
+        while (ctx->slot_index[i] != 0) {
+            uint32_t slot = ctx->slot_index[i] - 1;
+            if (status_slot_matches(ctx, slot, node_id)) return (int32_t)slot;
+            i = (i + 1) & ctx->slot_index_mask;
+        }
+        return -1;
+    }
+    
+    return scan_status_slots(ctx, base, node_id);
+}
+
+/* ============== Slot Seqlocks ============== */
+
+/*
+ * The receive path writes status slots in place while application threads
+ * may be copying them (sds_read_node_status, sds_foreach_node_copy). Every
+ * slot write is bracketed by a sequence counter that is odd while the write
+ * is in progress; a reader copies between two loads of the counter and
+ * retries if it was odd or moved. Writers of one table are already
+ * serialized (the sds_loop() thread, or the table lock with ingest workers),
+ * so a counter never has two writers and readers never hold them up. No
+ * callback runs inside a bracket, so a callback may read too.
+ *
+ * Counters are per slot when the application supplies storage
+ * (sds_set_owner_slot_seqlocks), otherwise one counter covers the table.
+ * Slot index changes have their own counter: a lookup that raced one is
+ * repeated rather than reported as a miss.
+ */
+
+#define SDS_SLOT_READ_RETRIES 4     /* Lookups repeated when the slot changed hands */
+
+static _Atomic uint32_t* slot_seqlock(SdsTableContext* ctx, uint32_t slot) {
+    return slot < ctx->slot_seqlock_count ? &ctx->slot_seqlocks[slot] : &ctx->slot_seq_table;
+}
+
+static void seq_write_begin(_Atomic uint32_t* seq) {
+    atomic_fetch_add_explicit(seq, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static void seq_write_end(_Atomic uint32_t* seq) {
+    atomic_fetch_add_explicit(seq, 1, memory_order_release);
+}
+
+/* Wait out a write in progress (a few stores and one section decode) */
+static uint32_t seq_read_begin(_Atomic uint32_t* seq) {
+    uint32_t start;
+    while ((start = atomic_load_explicit(seq, memory_order_acquire)) & 1u) {
+    }
+    return start;
+}
+
+/* True if a write overlapped the copy since seq_read_begin() */
+static bool seq_read_retry(_Atomic uint32_t* seq, uint32_t start) {
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(seq, memory_order_relaxed) != start;
+}
+
+/* A slot write also takes the slot out of its summary's aggregates and puts it back */
+static void slot_write_begin(SdsTableContext* ctx, uint32_t slot) {
+    seq_write_begin(slot_seqlock(ctx, slot));
+    if (ctx->aggregate_link) aggregate_slot(ctx, slot, -1);
+}
+
+static void slot_write_end(SdsTableContext* ctx, uint32_t slot) {
+    if (ctx->aggregate_link) aggregate_slot(ctx, slot, +1);
+    seq_write_end(slot_seqlock(ctx, slot));
+}
+
+/* Slot metadata in snapshot row form */
+static void slot_header(const SdsTableContext* ctx, const uint8_t* slot, SdsSnapshotRow* hdr) {
+    memcpy(hdr->node_id, slot, SDS_MAX_NODE_ID_LEN);
+    hdr->node_id[SDS_MAX_NODE_ID_LEN - 1] = '\0';
+    hdr->last_seen_ms = ctx->slot_last_seen_offset
+        ? *(const uint32_t*)(slot + ctx->slot_last_seen_offset) : 0;
+    hdr->online = ctx->slot_online_offset && *(const bool*)(slot + ctx->slot_online_offset);
+    hdr->eviction_pending = ctx->slot_eviction_pending_offset &&
+                            *(const bool*)(slot + ctx->slot_eviction_pending_offset);
+}
+
+/*
+ * Consistent copy of a slot's metadata and its first status_size status
+ * bytes. False if the slot is free or (with node_id) holds another device.
+ */
+static bool slot_read(SdsTableContext* ctx, uint32_t slot, const char* node_id,
+                      SdsSnapshotRow* hdr, void* status, size_t status_size) {
+    _Atomic uint32_t* seq = slot_seqlock(ctx, slot);
+    const uint8_t* p = status_slot_at(ctx, slot);
+    size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    bool valid;
+    uint32_t start;
+    
+    do {
+        start = seq_read_begin(seq);
+        valid = *(const volatile bool*)(p + valid_offset);
+        slot_header(ctx, p, hdr);
+        if (status_size > 0) {
+            memcpy(status, p + ctx->slot_status_offset, status_size);
+        }
+    } while (seq_read_retry(seq, start));
+    
+    return valid && (!node_id || strcmp(hdr->node_id, node_id) == 0);
+}
+
+/*
+ * find_status_slot() for readers outside the receive path. The probe is
+ * bounded and checks each entry, since the index may change under it; a
+ * hit is only a candidate that slot_read() confirms.
+ */
+static int32_t find_status_slot_unlocked(SdsTableContext* ctx, const char* node_id) {
+    int32_t found;
+    uint32_t start;
+    
+    do {
+        start = seq_read_begin(&ctx->slot_index_seq);
+        if (!ctx->slot_index_enabled) {
+            found = scan_status_slots(ctx, status_slots_base(ctx, ctx->table), node_id);
+            continue;
+        }
+        
+        const volatile uint32_t* index = ctx->slot_index;
+        uint32_t mask = ctx->slot_index_mask;
+        found = -1;
+        uint32_t i = hash_node_id(node_id) & mask;
+        for (uint32_t n = 0; n <= mask && index[i] != 0; n++) {
+            uint32_t slot = index[i] - 1;
+            if (slot < ctx->max_status_slots && status_slot_matches(ctx, slot, node_id)) {
+                found = (int32_t)slot;
+                break;
+            }
+            i = (i + 1) & mask;
+        }
+    } while (seq_read_retry(&ctx->slot_index_seq, start));
+    
+    return found;
+}
+
+/* ============== Owner Helpers ============== */
+
+const void* sds_find_node_status(const void* owner_table, const char* table_type, const char* node_id) {
+    if (!owner_table || !table_type || !node_id) return NULL;
+    
+    /* Find the table context to get slot metadata */
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) return NULL;
+    
+    const uint8_t* slots_base = status_slots_base(ctx, owner_table);
+    if (!slots_base) return NULL;
+    
+    /* The index describes the registered table; other buffers are scanned */
+    int32_t slot = (owner_table == ctx->table)
+        ? find_status_slot(ctx, node_id)
+        : scan_status_slots(ctx, slots_base, node_id);
+    if (slot < 0) return NULL;
+    
+    /* Return pointer to status within the slot */
+    return slots_base + ((size_t)slot * ctx->status_slot_size) + ctx->slot_status_offset;
 }
 
 void sds_foreach_node(const void* owner_table, const char* table_type, SdsNodeIterator callback, void* user_data) {
@@ -1154,15 +3062,15 @@ void sds_foreach_node(const void* owner_table, const char* table_type, SdsNodeIt
     /* Find the table context to get slot metadata */
     SdsTableContext* ctx = find_table(table_type);
     if (!ctx || ctx->role != SDS_ROLE_OWNER) return;
-    if (ctx->status_slots_offset == 0 || ctx->max_status_slots == 0) return;
     
-    const uint8_t* slots_base = (const uint8_t*)owner_table + ctx->status_slots_offset;
+    const uint8_t* slots_base = status_slots_base(ctx, owner_table);
+    if (!slots_base) return;
     
     /* Use configured offset or fallback to standard layout */
     size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
     
     /* Iterate over all valid slots */
-    for (uint8_t i = 0; i < ctx->max_status_slots; i++) {
+    for (uint32_t i = 0; i < ctx->max_status_slots; i++) {
         const uint8_t* slot = slots_base + (i * ctx->status_slot_size);
         const char* slot_node_id = (const char*)slot;
         const bool* slot_valid = (const bool*)(slot + valid_offset);
@@ -1174,423 +3082,3869 @@ void sds_foreach_node(const void* owner_table, const char* table_type, SdsNodeIt
     }
 }
 
-bool sds_is_device_online(const void* owner_table, const char* table_type, const char* node_id, uint32_t timeout_ms) {
+/* Status bytes per slot (the status section is the slot's last member) */
+static size_t snapshot_status_bytes(const SdsTableContext* ctx) {
+    return ctx->status_slot_size > ctx->slot_status_offset
+        ? ctx->status_slot_size - ctx->slot_status_offset : 0;
+}
+
+bool sds_read_node_status(
+    const void* owner_table,
+    const char* table_type,
+    const char* node_id,
+    void* status_out,
+    size_t status_size,
+    SdsSnapshotRow* node_out
+) {
     if (!owner_table || !table_type || !node_id) return false;
     
-    /* Find the table context */
     SdsTableContext* ctx = find_table(table_type);
     if (!ctx || ctx->role != SDS_ROLE_OWNER) return false;
-    if (ctx->status_slots_offset == 0 || ctx->max_status_slots == 0) return false;
     
-    /* Require proper slot offsets for online detection */
-    if (ctx->slot_online_offset == 0 || ctx->slot_last_seen_offset == 0) {
-        SDS_LOG_W("sds_is_device_online: slot offsets not configured for %s", table_type);
-        return false;
-    }
+    const uint8_t* slots_base = status_slots_base(ctx, owner_table);
+    if (!slots_base) return false;
     
-    const uint8_t* slots_base = (const uint8_t*)owner_table + ctx->status_slots_offset;
+    size_t bytes = snapshot_status_bytes(ctx);
+    if (!status_out) bytes = 0;
+    if (bytes > status_size) bytes = status_size;
+    SdsSnapshotRow hdr;
     
-    /* Use configured offset or fallback to standard layout */
-    size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    /* Other buffers are not written by SDS: plain scan and copy */
+    if (owner_table != ctx->table) {
+        int32_t slot = scan_status_slots(ctx, slots_base, node_id);
+        if (slot < 0) return false;
+        
+        const uint8_t* p = slots_base + ((size_t)slot * ctx->status_slot_size);
+        slot_header(ctx, p, &hdr);
+        if (bytes > 0) memcpy(status_out, p + ctx->slot_status_offset, bytes);
+        if (node_out) *node_out = hdr;
+        return true;
+    }
     
-    /* Find the slot for this node */
-    for (uint8_t i = 0; i < ctx->max_status_slots; i++) {
-        const uint8_t* slot = slots_base + (i * ctx->status_slot_size);
-        const char* slot_node_id = (const char*)slot;
-        const bool* slot_valid = (const bool*)(slot + valid_offset);
+    /* A miss after a hit means the slot was freed or reused: look again */
+    for (int attempt = 0; attempt < SDS_SLOT_READ_RETRIES; attempt++) {
+        int32_t slot = find_status_slot_unlocked(ctx, node_id);
+        if (slot < 0) return false;
         
-        if (*slot_valid && strcmp(slot_node_id, node_id) == 0) {
-            /* Found the slot - use proper offsets for online and last_seen */
-            const bool* slot_online = (const bool*)(slot + ctx->slot_online_offset);
-            const uint32_t* slot_last_seen = (const uint32_t*)(slot + ctx->slot_last_seen_offset);
-            
-            /* Check explicit online flag (false if LWT received) */
-            if (!*slot_online) return false;
-            
-            /* Check if last_seen is within timeout */
-            uint32_t now = sds_platform_millis();
-            uint32_t age = now - *slot_last_seen;
-            return (age < timeout_ms);
+        if (slot_read(ctx, (uint32_t)slot, node_id, &hdr, status_out, bytes)) {
+            if (node_out) *node_out = hdr;
+            return true;
         }
     }
-    
-    return false;  /* Node not found */
+    return false;
 }
 
-uint32_t sds_get_liveness_interval(const char* table_type) {
-    if (!table_type) return 0;
-    
-    const SdsTableMeta* meta = sds_find_table_meta(table_type);
-    if (meta) {
-        return meta->liveness_interval_ms;
-    }
+uint32_t sds_foreach_node_copy(
+    const void* owner_table,
+    const char* table_type,
+    SdsNodeCopyIterator callback,
+    void* user_data
+) {
+    if (!owner_table || !table_type || !callback) return 0;
     
-    /* Also check registered tables (might be manually registered) */
     SdsTableContext* ctx = find_table(table_type);
-    if (ctx) {
-        return ctx->liveness_interval_ms;
-    }
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) return 0;
     
-    return 0;
+    const uint8_t* slots_base = status_slots_base(ctx, owner_table);
+    if (!slots_base) return 0;
+    
+    /* Sections are at most SDS_SHADOW_SIZE; the slot tail adds alignment padding */
+    uint64_t status[(SDS_SHADOW_SIZE + 15) / 8];
+    size_t bytes = snapshot_status_bytes(ctx);
+    if (bytes > sizeof(status)) bytes = sizeof(status);
+    
+    size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    uint32_t visited = 0;
+    
+    for (uint32_t i = 0; i < ctx->max_status_slots; i++) {
+        const uint8_t* slot = slots_base + ((size_t)i * ctx->status_slot_size);
+        SdsSnapshotRow hdr;
+        
+        if (owner_table == ctx->table) {
+            if (!slot_read(ctx, i, NULL, &hdr, status, bytes)) continue;
+        } else {
+            if (!*(const bool*)(slot + valid_offset)) continue;
+            slot_header(ctx, slot, &hdr);
+            memcpy(status, slot + ctx->slot_status_offset, bytes);
+        }
+        
+        callback(&hdr, status, user_data);
+        visited++;
+    }
+    return visited;
 }
 
-uint32_t sds_get_eviction_grace(const char* table_type) {
-    (void)table_type;  /* Eviction grace is now global, table_type ignored */
-    return _eviction_grace_ms;
+/*
+ * Status snapshots. Rows are SdsSnapshotRow + status, 8-byte strided.
+ * Columns are sized for every slot so their offsets depend only on the
+ * table's slot layout and status fields, not on how many devices are known.
+ */
+#define SDS_SNAPSHOT_ROUND(n) (((size_t)(n) + 7) & ~(size_t)7)
+
+/* Width of one column entry, or 0 if the table has no such column */
+static size_t snapshot_column_width(const SdsTableContext* ctx, uint16_t column) {
+    switch (column) {
+        case SDS_SNAPSHOT_COL_NODE_ID:          return SDS_MAX_NODE_ID_LEN;
+        case SDS_SNAPSHOT_COL_LAST_SEEN:        return sizeof(uint32_t);
+        case SDS_SNAPSHOT_COL_ONLINE:           return sizeof(bool);
+        case SDS_SNAPSHOT_COL_EVICTION_PENDING: return sizeof(bool);
+        default:
+            if (!ctx->status_fields || column - SDS_SNAPSHOT_COL_FIELDS >= ctx->status_field_count) {
+                return 0;
+            }
+            return ctx->status_fields[column - SDS_SNAPSHOT_COL_FIELDS].size;
+    }
 }
 
-void sds_on_device_evicted(const char* table_type, SdsDeviceEvictedCallback callback, void* user_data) {
-    (void)table_type;  /* Eviction callback is now global, table_type ignored for backward compat */
+static size_t snapshot_column_offset(const SdsTableContext* ctx, uint16_t column) {
+    size_t offset = 0;
+    for (uint16_t c = 0; c < column; c++) {
+        offset += SDS_SNAPSHOT_ROUND(snapshot_column_width(ctx, c) * ctx->max_status_slots);
+    }
+    return offset;
+}
+
+/* Owner table with status slots (and, for columns, status field metadata) */
+static SdsTableContext* snapshot_table(const char* table_type, SdsSnapshotLayout layout) {
+    SdsTableContext* ctx = table_type ? find_table(table_type) : NULL;
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) return NULL;
+    if (ctx->status_slots_offset == 0 || ctx->max_status_slots == 0) return NULL;
+    if (layout == SDS_SNAPSHOT_COLUMNS && (!ctx->status_fields || ctx->status_field_count == 0)) {
+        return NULL;
+    }
+    return ctx;
+}
+
+size_t sds_snapshot_size(const char* table_type, SdsSnapshotLayout layout) {
+    SdsTableContext* ctx = snapshot_table(table_type, layout);
+    if (!ctx) return 0;
+    
+    if (layout == SDS_SNAPSHOT_COLUMNS) {
+        return snapshot_column_offset(ctx, (uint16_t)(SDS_SNAPSHOT_COL_FIELDS + ctx->status_field_count));
+    }
+    return (size_t)ctx->max_status_slots *
+           SDS_SNAPSHOT_ROUND(SDS_SNAPSHOT_STATUS_OFFSET + snapshot_status_bytes(ctx));
+}
+
+SdsError sds_snapshot_status(
+    const void* owner_table,
+    const char* table_type,
+    SdsSnapshotLayout layout,
+    void* buffer,
+    size_t buffer_size,
+    SdsSnapshotInfo* info
+) {
+    if (!owner_table || !table_type || !buffer) {
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) {
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    if (!snapshot_table(table_type, layout)) {
+        return SDS_ERR_INVALID_TABLE;
+    }
+    if (buffer_size < sds_snapshot_size(table_type, layout)) {
+        return SDS_ERR_BUFFER_FULL;
+    }
+    
+    size_t status_bytes = snapshot_status_bytes(ctx);
+    size_t row_size = SDS_SNAPSHOT_ROUND(SDS_SNAPSHOT_STATUS_OFFSET + status_bytes);
+    size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    uint8_t* out = (uint8_t*)buffer;
+    uint8_t* columns[SDS_SNAPSHOT_COL_FIELDS + 255];
+    uint32_t rows = 0;
+    
+    if (layout == SDS_SNAPSHOT_COLUMNS) {
+        for (uint16_t c = 0; c < SDS_SNAPSHOT_COL_FIELDS + ctx->status_field_count; c++) {
+            columns[c] = out + snapshot_column_offset(ctx, c);
+        }
+    }
+    
+    table_lock(ctx);
+    const uint8_t* slots_base = status_slots_base(ctx, owner_table);
+    
+    for (uint32_t i = 0; slots_base && i < ctx->max_status_slots; i++) {
+        const uint8_t* slot = slots_base + ((size_t)i * ctx->status_slot_size);
+        if (!*(const bool*)(slot + valid_offset)) continue;
+        
+        SdsSnapshotRow hdr;
+        slot_header(ctx, slot, &hdr);
+        const uint8_t* status = slot + ctx->slot_status_offset;
+        
+        if (layout == SDS_SNAPSHOT_ROWS) {
+            uint8_t* row = out + (size_t)rows * row_size;
+            memset(row, 0, SDS_SNAPSHOT_STATUS_OFFSET);
+            memcpy(row, &hdr, sizeof(hdr));
+            memcpy(row + SDS_SNAPSHOT_STATUS_OFFSET, status, status_bytes);
+        } else {
+            memcpy(columns[SDS_SNAPSHOT_COL_NODE_ID] + (size_t)rows * SDS_MAX_NODE_ID_LEN,
+                   hdr.node_id, SDS_MAX_NODE_ID_LEN);
+            memcpy(columns[SDS_SNAPSHOT_COL_LAST_SEEN] + (size_t)rows * sizeof(uint32_t),
+                   &hdr.last_seen_ms, sizeof(uint32_t));
+            memcpy(columns[SDS_SNAPSHOT_COL_ONLINE] + (size_t)rows * sizeof(bool),
+                   &hdr.online, sizeof(bool));
+            memcpy(columns[SDS_SNAPSHOT_COL_EVICTION_PENDING] + (size_t)rows * sizeof(bool),
+                   &hdr.eviction_pending, sizeof(bool));
+            for (uint8_t f = 0; f < ctx->status_field_count; f++) {
+                const SdsFieldMeta* field = &ctx->status_fields[f];
+                memcpy(columns[SDS_SNAPSHOT_COL_FIELDS + f] + (size_t)rows * field->size,
+                       status + field->offset, field->size);
+            }
+        }
+        rows++;
+    }
+    table_unlock(ctx);
+    
+    if (info) {
+        info->rows = rows;
+        info->row_size = row_size;
+    }
+    return SDS_OK;
+}
+
+const void* sds_snapshot_column(const void* buffer, const char* table_type, uint16_t column) {
+    SdsTableContext* ctx = snapshot_table(table_type, SDS_SNAPSHOT_COLUMNS);
+    if (!buffer || !ctx || snapshot_column_width(ctx, column) == 0) return NULL;
+    return (const uint8_t*)buffer + snapshot_column_offset(ctx, column);
+}
+
+/* ============== Status History ============== */
+
+/*
+ * Each status slot owns a ring of history_depth entries, after a
+ * SdsHistoryRing header: [timestamp_ms][status section]. The ring of slot
+ * i starts at i * history_ring_size(ctx); rings are written under the
+ * table lock when a status message has been applied to the slot.
+ */
+typedef struct {
+    uint16_t head;      /* Entry written next */
+    uint16_t count;     /* Valid entries, up to history_depth */
+} SdsHistoryRing;
+
+static size_t history_ring_size(const SdsTableContext* ctx) {
+    return SDS_STATUS_HISTORY_BYTES(snapshot_status_bytes(ctx), 1, ctx->history_depth);
+}
+
+static SdsHistoryRing* history_ring(const SdsTableContext* ctx, uint32_t slot) {
+    return (SdsHistoryRing*)(ctx->history + (size_t)slot * history_ring_size(ctx));
+}
+
+static uint8_t* history_entry(const SdsTableContext* ctx, SdsHistoryRing* ring, uint32_t index) {
+    return (uint8_t*)ring + sizeof(SdsHistoryRing) + (size_t)index * ctx->history_entry_size;
+}
+
+/* Start an empty ring (a device took the slot) */
+static void history_reset(SdsTableContext* ctx, uint32_t slot) {
+    if (ctx->history && slot < ctx->max_status_slots) {
+        memset(history_ring(ctx, slot), 0, sizeof(SdsHistoryRing));
+    }
+}
+
+static void history_record(SdsTableContext* ctx, uint32_t slot, const void* status, uint32_t now) {
+    if (!ctx->history || slot >= ctx->max_status_slots) return;
+    
+    SdsHistoryRing* ring = history_ring(ctx, slot);
+    uint8_t* entry = history_entry(ctx, ring, ring->head);
+    memcpy(entry, &now, sizeof(now));
+    memcpy(entry + sizeof(uint32_t), status, snapshot_status_bytes(ctx));
+    
+    ring->head = (uint16_t)((ring->head + 1u) % ctx->history_depth);
+    if (ring->count < ctx->history_depth) ring->count++;
+}
+
+size_t sds_status_history_size(const char* table_type, uint16_t depth) {
+    SdsTableContext* ctx = snapshot_table(table_type, SDS_SNAPSHOT_ROWS);
+    if (!ctx || depth == 0) return 0;
+    return SDS_STATUS_HISTORY_BYTES(snapshot_status_bytes(ctx), ctx->max_status_slots, depth);
+}
+
+SdsError sds_set_owner_status_history(const char* table_type, void* storage,
+                                      size_t storage_size, uint16_t depth) {
+    SdsTableContext* ctx = table_type ? find_table(table_type) : NULL;
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) {
+        SDS_LOG_W("sds_set_owner_status_history: table %s not found or not owner",
+                  table_type ? table_type : "(null)");
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    
+    if (storage) {
+        size_t needed = sds_status_history_size(table_type, depth);
+        if (needed == 0 || ((uintptr_t)storage & 3) != 0) {
+            SDS_LOG_E("sds_set_owner_status_history: %s needs status slots, a depth and aligned storage",
+                      table_type);
+            return SDS_ERR_INVALID_CONFIG;
+        }
+        if (storage_size < needed) {
+            SDS_LOG_E("sds_set_owner_status_history: %zu bytes given, %zu needed",
+                      storage_size, needed);
+            return SDS_ERR_BUFFER_FULL;
+        }
+    }
+    
+    table_lock(ctx);
+    if (storage) memset(storage, 0, sds_status_history_size(table_type, depth));
+    ctx->history = (uint8_t*)storage;
+    ctx->history_depth = storage ? depth : 0;
+    ctx->history_entry_size = SDS_STATUS_HISTORY_ENTRY_BYTES(snapshot_status_bytes(ctx));
+    table_unlock(ctx);
+    return SDS_OK;
+}
+
+/*
+ * Ring of a known device, and the position and number of its samples
+ * within max_age_ms (oldest first). Call under the table lock.
+ */
+static SdsHistoryRing* history_find(SdsTableContext* ctx, const char* node_id, uint32_t max_age_ms,
+                                    uint32_t* first, uint32_t* count) {
+    int32_t slot = ctx->history ? find_status_slot(ctx, node_id) : -1;
+    if (slot < 0 || (uint32_t)slot >= ctx->max_status_slots) return NULL;
+    
+    SdsHistoryRing* ring = history_ring(ctx, (uint32_t)slot);
+    uint32_t start = (ring->head + ctx->history_depth - ring->count) % ctx->history_depth;
+    uint32_t n = ring->count;
+    
+    /* Samples are in time order: skip the ones that are too old */
+    if (max_age_ms > 0) {
+        uint32_t now = sds_platform_millis();
+        while (n > 0) {
+            uint32_t ts;
+            memcpy(&ts, history_entry(ctx, ring, start), sizeof(ts));
+            if (now - ts <= max_age_ms) break;
+            start = (start + 1) % ctx->history_depth;
+            n--;
+        }
+    }
+    *first = start;
+    *count = n;
+    return ring;
+}
+
+uint32_t sds_foreach_status_sample(const char* table_type, const char* node_id, uint32_t max_age_ms,
+                                   SdsStatusSampleIterator callback, void* user_data) {
+    if (!table_type || !node_id || !callback) return 0;
+    
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) return 0;
+    
+    table_lock(ctx);
+    uint32_t first = 0, count = 0;
+    SdsHistoryRing* ring = history_find(ctx, node_id, max_age_ms, &first, &count);
+    for (uint32_t i = 0; ring && i < count; i++) {
+        const uint8_t* entry = history_entry(ctx, ring, (first + i) % ctx->history_depth);
+        uint32_t ts;
+        memcpy(&ts, entry, sizeof(ts));
+        callback(ts, entry + sizeof(uint32_t), user_data);
+    }
+    table_unlock(ctx);
+    return ring ? count : 0;
+}
+
+/* Width of one history column entry, or 0 if there is no such column */
+static size_t history_column_width(const SdsTableContext* ctx, uint16_t column) {
+    if (column == SDS_HISTORY_COL_TIMESTAMP) return sizeof(uint32_t);
+    if (!ctx->status_fields || column - SDS_HISTORY_COL_FIELDS >= ctx->status_field_count) return 0;
+    return ctx->status_fields[column - SDS_HISTORY_COL_FIELDS].size;
+}
+
+static size_t history_column_offset(const SdsTableContext* ctx, uint16_t column) {
+    size_t offset = 0;
+    for (uint16_t c = 0; c < column; c++) {
+        offset += SDS_SNAPSHOT_ROUND(history_column_width(ctx, c) * ctx->history_depth);
+    }
+    return offset;
+}
+
+/* Owner table with history storage and status field metadata */
+static SdsTableContext* history_table(const char* table_type) {
+    SdsTableContext* ctx = snapshot_table(table_type, SDS_SNAPSHOT_COLUMNS);
+    return (ctx && ctx->history) ? ctx : NULL;
+}
+
+size_t sds_status_history_columns_size(const char* table_type) {
+    SdsTableContext* ctx = history_table(table_type);
+    if (!ctx) return 0;
+    return history_column_offset(ctx, (uint16_t)(SDS_HISTORY_COL_FIELDS + ctx->status_field_count));
+}
+
+SdsError sds_status_history_columns(const char* table_type, const char* node_id, uint32_t max_age_ms,
+                                    void* buffer, size_t buffer_size, uint32_t* count) {
+    if (!table_type || !node_id || !buffer || !count) {
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    *count = 0;
+    
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) {
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    if (!history_table(table_type)) {
+        return SDS_ERR_INVALID_TABLE;
+    }
+    if (buffer_size < sds_status_history_columns_size(table_type)) {
+        return SDS_ERR_BUFFER_FULL;
+    }
+    
+    uint8_t* out = (uint8_t*)buffer;
+    uint8_t* timestamps = out + history_column_offset(ctx, SDS_HISTORY_COL_TIMESTAMP);
+    
+    table_lock(ctx);
+    uint32_t first = 0, n = 0;
+    SdsHistoryRing* ring = history_find(ctx, node_id, max_age_ms, &first, &n);
+    for (uint32_t i = 0; ring && i < n; i++) {
+        const uint8_t* entry = history_entry(ctx, ring, (first + i) % ctx->history_depth);
+        const uint8_t* status = entry + sizeof(uint32_t);
+        memcpy(timestamps + (size_t)i * sizeof(uint32_t), entry, sizeof(uint32_t));
+        for (uint8_t f = 0; f < ctx->status_field_count; f++) {
+            const SdsFieldMeta* field = &ctx->status_fields[f];
+            uint8_t* column = out + history_column_offset(ctx, (uint16_t)(SDS_HISTORY_COL_FIELDS + f));
+            memcpy(column + (size_t)i * field->size, status + field->offset, field->size);
+        }
+    }
+    table_unlock(ctx);
+    
+    *count = ring ? n : 0;
+    return SDS_OK;
+}
+
+const void* sds_status_history_column(const void* buffer, const char* table_type, uint16_t column) {
+    SdsTableContext* ctx = history_table(table_type);
+    if (!buffer || !ctx || history_column_width(ctx, column) == 0) return NULL;
+    return (const uint8_t*)buffer + history_column_offset(ctx, column);
+}
+
+/* Schema (@liveness) or registered liveness interval, before adaptive widening */
+static uint32_t table_liveness(const SdsTableContext* ctx, const char* table_type) {
+    const SdsTableMeta* meta = sds_find_table_meta(table_type);
+    if (meta) return meta->liveness_interval_ms;
+    /* Also check registered tables (might be manually registered) */
+    return ctx ? ctx->liveness_interval_ms : 0;
+}
+
+/**
+ * Give each status slot room for the heartbeat gap its device advertises.
+ * Called whenever the slot count is configured; the block is carved from
+ * the table arena and reused while the slots fit in it.
+ */
+static void slot_liveness_setup(SdsTableContext* ctx) {
+    uint32_t n = ctx->max_status_slots;
+    if (n > ctx->slot_liveness_cap) {
+        uint32_t* lv = arena_alloc((size_t)n * sizeof(uint32_t));
+        if (lv) {
+            ctx->slot_liveness = lv;
+            ctx->slot_liveness_cap = n;
+        } else {
+            SDS_LOG_W("Table arena exhausted: %s ignores advertised liveness beyond slot %u",
+                      ctx->table_type, (unsigned)ctx->slot_liveness_cap);
+        }
+    }
+    if (ctx->slot_liveness) {
+        memset(ctx->slot_liveness, 0, (size_t)ctx->slot_liveness_cap * sizeof(uint32_t));
+    }
+}
+
+static uint32_t slot_advertised_liveness(const SdsTableContext* ctx, uint32_t slot) {
+    return slot < ctx->slot_liveness_cap ? ctx->slot_liveness[slot] : 0;
+}
+
+bool sds_is_device_online(const void* owner_table, const char* table_type, const char* node_id, uint32_t timeout_ms) {
+    if (!owner_table || !table_type || !node_id) return false;
+    
+    /* Find the table context */
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) return false;
+    
+    /* Require proper slot offsets for online detection */
+    if (ctx->slot_online_offset == 0 || ctx->slot_last_seen_offset == 0) {
+        SDS_LOG_W("sds_is_device_online: slot offsets not configured for %s", table_type);
+        return false;
+    }
+    
+    const uint8_t* slots_base = status_slots_base(ctx, owner_table);
+    if (!slots_base) return false;
+    
+    /* Find the slot for this node */
+    int32_t slot_index = (owner_table == ctx->table)
+        ? find_status_slot(ctx, node_id)
+        : scan_status_slots(ctx, slots_base, node_id);
+    if (slot_index < 0) return false;  /* Node not found */
+    
+    /* Found the slot - use proper offsets for online and last_seen */
+    const uint8_t* slot = slots_base + ((size_t)slot_index * ctx->status_slot_size);
+    const bool* slot_online = (const bool*)(slot + ctx->slot_online_offset);
+    const uint32_t* slot_last_seen = (const uint32_t*)(slot + ctx->slot_last_seen_offset);
+    
+    /* Check explicit online flag (false if LWT received) */
+    if (!*slot_online) return false;
+    
+    /* Default timeout: 1.5x the liveness interval, or the gap this device advertised */
+    if (timeout_ms == 0) {
+        uint32_t interval = table_liveness(ctx, table_type);
+        uint32_t advertised = slot_advertised_liveness(ctx, (uint32_t)slot_index);
+        timeout_ms = (advertised > interval ? advertised : interval) * 3 / 2;
+    }
+    
+    /* Check if last_seen is within timeout */
+    uint32_t now = sds_platform_millis();
+    uint32_t age = now - *slot_last_seen;
+    return (age < timeout_ms);
+}
+
+uint32_t sds_get_liveness_interval(const char* table_type) {
+    if (!table_type) return 0;
+    
+    SdsTableContext* ctx = find_table(table_type);
+    uint32_t interval = table_liveness(ctx, table_type);
+    if (!ctx) return interval;
+    
+    /* Adaptive liveness stretches heartbeats up to the advertised gap */
+    if (ctx->role != SDS_ROLE_OWNER) {
+        return ctx->liveness_max_ms > interval ? ctx->liveness_max_ms : interval;
+    }
+    
+    /* Owner: the widest gap a device now in a slot advertised */
+    const uint8_t* slots_base = status_slots_base(ctx, ctx->table);
+    size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    uint32_t n = ctx->max_status_slots < ctx->slot_liveness_cap ? ctx->max_status_slots : ctx->slot_liveness_cap;
+    for (uint32_t i = 0; slots_base && i < n; i++) {
+        const bool* valid = (const bool*)(slots_base + (size_t)i * ctx->status_slot_size + valid_offset);
+        if (*valid && ctx->slot_liveness[i] > interval) interval = ctx->slot_liveness[i];
+    }
+    return interval;
+}
+
+uint32_t sds_get_eviction_grace(const char* table_type) {
+    (void)table_type;  /* Eviction grace is now global, table_type ignored */
+    return _eviction_grace_ms;
+}
+
+void sds_on_device_evicted(const char* table_type, SdsDeviceEvictedCallback callback, void* user_data) {
+    (void)table_type;  /* Eviction callback is now global, table_type ignored for backward compat */
     _eviction_callback = callback;
     _eviction_user_data = user_data;
 }
 
-/* ============== Internal Functions ============== */
+/* ============== Shared-Memory Export ============== */
 
-static SdsTableContext* find_table(const char* table_type) {
-    for (int i = 0; i < SDS_MAX_TABLES; i++) {
-        if (_tables[i].active && strcmp(_tables[i].table_type, table_type) == 0) {
-            return &_tables[i];
+/*
+ * An exported table keeps its status slots in a named shared-memory segment
+ * (layout in sds.h: header, status field descriptors, one seqlock per slot,
+ * then the slots). Export needs external slot storage, so only the table's
+ * slot pointer moves: the caller's array is copied into the segment and
+ * restored on unexport. Ingest then writes the segment in place, and the
+ * per-slot seqlocks give attached processes the same consistent copies as
+ * in-process readers. The header is filled before state is set to LIVE;
+ * CLOSED tells readers the owner let go of it. clock_ms is the owner's
+ * sds_platform_millis() at its last sds_loop(), the base of last_seen_ms.
+ */
+
+#define SDS_SHM_ROUND(n) (((size_t)(n) + 7) & ~(size_t)7)
+
+/* An owner that died mid-write leaves its counter odd: readers give up after this */
+#define SDS_SHM_READ_SPINS 1000000u
+
+/* POSIX portable names: one leading '/' and no other */
+static bool shm_name_valid(const char* name) {
+    if (!name || name[0] != '/' || name[1] == '\0') return false;
+    size_t len = strlen(name);
+    return len < SDS_SHM_MAX_NAME_LEN && strchr(name + 1, '/') == NULL;
+}
+
+static void export_tick(void) {
+    uint32_t now = sds_platform_millis();
+    for (int i = 0; i < _table_cap; i++) {
+        SdsShmHeader* hdr = (SdsShmHeader*)_tables[i].shm;
+        if (_tables[i].active && hdr) {
+            atomic_store_explicit((_Atomic uint32_t*)&hdr->clock_ms, now, memory_order_relaxed);
+        }
+    }
+}
+
+static void export_close(SdsTableContext* ctx) {
+    SdsShmHeader* hdr = (SdsShmHeader*)ctx->shm;
+    
+    table_lock(ctx);
+    uint8_t* slots = status_slots_base(ctx, ctx->table);
+    memcpy(ctx->shm_prev_slots, slots, (size_t)ctx->max_status_slots * ctx->status_slot_size);
+    memcpy((uint8_t*)ctx->table + ctx->status_slots_offset, &ctx->shm_prev_slots, sizeof(uint8_t*));
+    ctx->slot_seqlocks = ctx->shm_prev_seqlocks;
+    ctx->slot_seqlock_count = ctx->shm_prev_seqlock_count;
+    atomic_store_explicit((_Atomic uint32_t*)&hdr->state, SDS_SHM_CLOSED, memory_order_release);
+    table_unlock(ctx);
+    
+    sds_platform_shm_remove(ctx->shm_name, ctx->shm, ctx->shm_size);
+    SDS_LOG_I("Stopped exporting %s (%s)", ctx->table_type, ctx->shm_name);
+    ctx->shm = NULL;
+    ctx->shm_size = 0;
+    _shm_exports--;
+}
+
+SdsError sds_export_owner_table(const char* table_type, const char* name) {
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) {
+        SDS_LOG_W("sds_export_owner_table: table %s not found or not owner",
+                  table_type ? table_type : "(null)");
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    
+    if (!shm_name_valid(name)) {
+        SDS_LOG_E("sds_export_owner_table: invalid segment name %s", name ? name : "(null)");
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    if (!ctx->status_slots_external || !status_slots_base(ctx, ctx->table) ||
+        !ctx->status_fields || ctx->status_field_count == 0) {
+        SDS_LOG_E("sds_export_owner_table: %s needs external status slots and status field metadata",
+                  table_type);
+        return SDS_ERR_INVALID_TABLE;
+    }
+    
+    if (ctx->shm) {
+        export_close(ctx);
+    }
+    
+    uint32_t max_slots = ctx->max_status_slots;
+    size_t fields_offset = SDS_SHM_ROUND(sizeof(SdsShmHeader));
+    size_t seqlocks_offset = SDS_SHM_ROUND(fields_offset + ctx->status_field_count * sizeof(SdsShmField));
+    size_t slots_offset = SDS_SHM_ROUND(seqlocks_offset + (size_t)max_slots * sizeof(SdsSeqlock));
+    uint64_t size = (uint64_t)slots_offset + (uint64_t)max_slots * ctx->status_slot_size;
+    if (size > UINT32_MAX) {
+        SDS_LOG_E("sds_export_owner_table: %s needs a %llu-byte segment",
+                  table_type, (unsigned long long)size);
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    uint8_t* seg = (uint8_t*)sds_platform_shm_create(name, (size_t)size);
+    if (!seg) {
+        SDS_LOG_E("sds_export_owner_table: cannot create segment %s", name);
+        return SDS_ERR_PLATFORM_ERROR;
+    }
+    
+    SdsShmHeader* hdr = (SdsShmHeader*)seg;
+    hdr->magic = SDS_SHM_MAGIC;
+    hdr->version = SDS_SHM_VERSION;
+    hdr->header_size = (uint16_t)sizeof(SdsShmHeader);
+    hdr->segment_size = (uint32_t)size;
+    hdr->clock_ms = sds_platform_millis();
+    snprintf(hdr->table_type, sizeof(hdr->table_type), "%s", ctx->table_type);
+    snprintf(hdr->schema_version, sizeof(hdr->schema_version), "%s", _schema_version);
+    snprintf(hdr->owner_node_id, sizeof(hdr->owner_node_id), "%s", _node_id);
+    hdr->max_slots = max_slots;
+    hdr->slot_size = (uint32_t)ctx->status_slot_size;
+    hdr->slot_valid_offset = (uint32_t)(ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN);
+    hdr->slot_online_offset = (uint32_t)ctx->slot_online_offset;
+    hdr->slot_last_seen_offset = (uint32_t)ctx->slot_last_seen_offset;
+    hdr->slot_eviction_pending_offset = (uint32_t)ctx->slot_eviction_pending_offset;
+    hdr->slot_status_offset = (uint32_t)ctx->slot_status_offset;
+    hdr->status_size = (uint32_t)snapshot_status_bytes(ctx);
+    hdr->field_count = ctx->status_field_count;
+    hdr->fields_offset = (uint32_t)fields_offset;
+    hdr->seqlocks_offset = (uint32_t)seqlocks_offset;
+    hdr->slots_offset = (uint32_t)slots_offset;
+    
+    SdsShmField* fields = (SdsShmField*)(seg + fields_offset);
+    for (uint8_t i = 0; i < ctx->status_field_count; i++) {
+        const SdsFieldMeta* f = &ctx->status_fields[i];
+        strncpy(fields[i].name, f->name, SDS_SHM_FIELD_NAME_LEN - 1);
+        fields[i].type = (uint8_t)f->type;
+        fields[i].offset = f->offset;
+        fields[i].size = f->size;
+    }
+    
+    /* Move the slots; slot numbers do not change, so the index stays valid */
+    table_lock(ctx);
+    uint8_t* slots = seg + slots_offset;
+    ctx->shm_prev_slots = status_slots_base(ctx, ctx->table);
+    memcpy(slots, ctx->shm_prev_slots, (size_t)max_slots * ctx->status_slot_size);
+    memcpy((uint8_t*)ctx->table + ctx->status_slots_offset, &slots, sizeof(slots));
+    ctx->shm_prev_seqlocks = ctx->slot_seqlocks;
+    ctx->shm_prev_seqlock_count = ctx->slot_seqlock_count;
+    ctx->slot_seqlocks = (_Atomic uint32_t*)(seg + seqlocks_offset);
+    ctx->slot_seqlock_count = max_slots;
+    ctx->shm = seg;
+    ctx->shm_size = (size_t)size;
+    strncpy(ctx->shm_name, name, sizeof(ctx->shm_name) - 1);
+    ctx->shm_name[sizeof(ctx->shm_name) - 1] = '\0';
+    atomic_store_explicit((_Atomic uint32_t*)&hdr->state, SDS_SHM_LIVE, memory_order_release);
+    table_unlock(ctx);
+    _shm_exports++;
+    
+    SDS_LOG_I("Exporting %s to %s (%u slots, %llu bytes)", table_type, name,
+              (unsigned)max_slots, (unsigned long long)size);
+    return SDS_OK;
+}
+
+SdsError sds_unexport_owner_table(const char* table_type) {
+    SdsTableContext* ctx = table_type ? find_table(table_type) : NULL;
+    if (!ctx || !ctx->shm) {
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    export_close(ctx);
+    return SDS_OK;
+}
+
+/* Every region the header describes lies within the segment */
+static bool shared_header_valid(const SdsShmHeader* hdr, size_t size) {
+    if (size < sizeof(SdsShmHeader)) return false;
+    if (hdr->magic != SDS_SHM_MAGIC || hdr->version != SDS_SHM_VERSION ||
+        hdr->header_size != sizeof(SdsShmHeader) || hdr->segment_size > size) {
+        return false;
+    }
+    if (atomic_load_explicit((_Atomic uint32_t*)&hdr->state, memory_order_acquire) == 0) {
+        return false;  /* Still being filled in */
+    }
+    
+    uint64_t slot_size = hdr->slot_size;
+    if (hdr->max_slots == 0 || slot_size < SDS_MAX_NODE_ID_LEN || hdr->seqlocks_offset % 4 != 0) {
+        return false;
+    }
+    if ((uint64_t)hdr->fields_offset + (uint64_t)hdr->field_count * sizeof(SdsShmField) > size ||
+        (uint64_t)hdr->seqlocks_offset + (uint64_t)hdr->max_slots * sizeof(SdsSeqlock) > size ||
+        (uint64_t)hdr->slots_offset + (uint64_t)hdr->max_slots * slot_size > size) {
+        return false;
+    }
+    if (hdr->slot_valid_offset + sizeof(bool) > slot_size ||
+        hdr->slot_online_offset + sizeof(bool) > slot_size ||
+        hdr->slot_eviction_pending_offset + sizeof(bool) > slot_size ||
+        hdr->slot_last_seen_offset + sizeof(uint32_t) > slot_size ||
+        (uint64_t)hdr->slot_status_offset + hdr->status_size > slot_size) {
+        return false;
+    }
+    return true;
+}
+
+SdsError sds_shared_table_attach(const char* name, SdsSharedTable* table) {
+    if (!name || !table) return SDS_ERR_INVALID_CONFIG;
+    memset(table, 0, sizeof(*table));
+    
+    size_t size = 0;
+    const uint8_t* seg = (const uint8_t*)sds_platform_shm_attach(name, &size);
+    if (!seg) return SDS_ERR_TABLE_NOT_FOUND;
+    
+    const SdsShmHeader* hdr = (const SdsShmHeader*)seg;
+    if (!shared_header_valid(hdr, size)) {
+        sds_platform_shm_detach(seg, size);
+        return SDS_ERR_INVALID_TABLE;
+    }
+    
+    table->header = hdr;
+    table->fields = (const SdsShmField*)(seg + hdr->fields_offset);
+    table->slots = seg + hdr->slots_offset;
+    table->size = size;
+    return SDS_OK;
+}
+
+void sds_shared_table_detach(SdsSharedTable* table) {
+    if (!table || !table->header) return;
+    sds_platform_shm_detach(table->header, table->size);
+    memset(table, 0, sizeof(*table));
+}
+
+/* slot_read() for an attached segment: layout from its header */
+static bool shared_slot_read(const SdsSharedTable* table, uint32_t slot, const char* node_id,
+                             SdsSnapshotRow* row, void* status, size_t status_size) {
+    const SdsShmHeader* h = table->header;
+    _Atomic uint32_t* seq = (_Atomic uint32_t*)((const uint8_t*)h + h->seqlocks_offset) + slot;
+    const uint8_t* p = table->slots + (size_t)slot * h->slot_size;
+    bool valid;
+    uint32_t start;
+    uint32_t spins = 0;
+    
+    do {
+        while ((start = atomic_load_explicit(seq, memory_order_acquire)) & 1u) {
+            if (++spins >= SDS_SHM_READ_SPINS) return false;
+        }
+        valid = *(const volatile bool*)(p + h->slot_valid_offset);
+        memcpy(row->node_id, p, SDS_MAX_NODE_ID_LEN);
+        row->node_id[SDS_MAX_NODE_ID_LEN - 1] = '\0';
+        row->last_seen_ms = 0;
+        if (h->slot_last_seen_offset) memcpy(&row->last_seen_ms, p + h->slot_last_seen_offset, sizeof(uint32_t));
+        row->online = h->slot_online_offset && *(const bool*)(p + h->slot_online_offset);
+        row->eviction_pending = h->slot_eviction_pending_offset &&
+                                *(const bool*)(p + h->slot_eviction_pending_offset);
+        if (status_size > 0) {
+            memcpy(status, p + h->slot_status_offset, status_size);
+        }
+    } while (seq_read_retry(seq, start));
+    
+    return valid && (!node_id || strcmp(row->node_id, node_id) == 0);
+}
+
+bool sds_shared_table_read(
+    const SdsSharedTable* table,
+    const char* node_id,
+    void* status_out,
+    size_t status_size,
+    SdsSnapshotRow* node_out
+) {
+    if (!table || !table->header || !node_id) return false;
+    
+    const SdsShmHeader* h = table->header;
+    size_t bytes = status_out ? h->status_size : 0;
+    if (bytes > status_size) bytes = status_size;
+    
+    /* Readers have no index: scan, then confirm under the slot's seqlock */
+    for (uint32_t i = 0; i < h->max_slots; i++) {
+        const char* slot_node_id = (const char*)(table->slots + (size_t)i * h->slot_size);
+        if (strncmp(slot_node_id, node_id, SDS_MAX_NODE_ID_LEN) != 0) continue;
+        
+        SdsSnapshotRow row;
+        if (shared_slot_read(table, i, node_id, &row, status_out, bytes)) {
+            if (node_out) *node_out = row;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t sds_shared_table_foreach(
+    const SdsSharedTable* table,
+    SdsNodeCopyIterator callback,
+    void* user_data
+) {
+    if (!table || !table->header || !callback) return 0;
+    
+    const SdsShmHeader* h = table->header;
+    uint64_t status[(SDS_SHADOW_SIZE + 15) / 8];
+    size_t bytes = h->status_size < sizeof(status) ? h->status_size : sizeof(status);
+    uint32_t visited = 0;
+    
+    for (uint32_t i = 0; i < h->max_slots; i++) {
+        SdsSnapshotRow row;
+        if (!shared_slot_read(table, i, NULL, &row, status, bytes)) continue;
+        callback(&row, status, user_data);
+        visited++;
+    }
+    return visited;
+}
+
+/* ============== Clock Offset ============== */
+
+/*
+ * Owners estimate each device's clock offset (device millis minus owner
+ * millis) from the timestamps already on the wire. A device's full status
+ * echoes the "ts" of the last config it applied (t0, owner clock) and when
+ * it applied it (t1, device clock); the status carries its own "ts" (t2)
+ * and the owner notes when it applies it (t3). As in NTP:
+ *
+ *   offset = ((t1 - t0) + (t2 - t3)) / 2,  rtt = (t3 - t0) - (t2 - t1)
+ *
+ * The lowest-rtt sample for a config wins; a newer config replaces it.
+ * Samples above SDS_CLOCK_MAX_RTT_MS (a retained config delivered late)
+ * are ignored. Until a device has a usable exchange its offset is the
+ * one-way bound max(t2 - t3), which excludes the fastest delivery seen.
+ */
+
+SdsError sds_set_owner_latency_slots(const char* table_type, SdsNodeLatency* nodes, uint32_t count) {
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) {
+        SDS_LOG_W("sds_set_owner_latency_slots: table %s not found or not owner",
+                  table_type ? table_type : "(null)");
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    
+    table_lock(ctx);
+    if (nodes) memset(nodes, 0, (size_t)count * sizeof(SdsNodeLatency));
+    ctx->latency_nodes = nodes;
+    ctx->latency_node_count = nodes ? count : 0;
+    table_unlock(ctx);
+    return SDS_OK;
+}
+
+bool sds_get_node_latency(const char* table_type, const char* node_id, SdsNodeLatency* out) {
+    if (!table_type || !node_id || !out) return false;
+    
+    SdsTableContext* ctx = find_table(table_type);
+    if (!ctx || ctx->role != SDS_ROLE_OWNER) return false;
+    
+    table_lock(ctx);
+    int32_t slot = find_status_slot(ctx, node_id);
+    bool found = slot >= 0 && (uint32_t)slot < ctx->latency_node_count;
+    if (found) *out = ctx->latency_nodes[slot];
+    table_unlock(ctx);
+    return found;
+}
+
+/* Forget a slot's clock estimate (new device in the slot, or it went offline) */
+static void latency_reset(SdsTableContext* ctx, uint32_t slot) {
+    if (slot < ctx->latency_node_count) {
+        memset(&ctx->latency_nodes[slot], 0, sizeof(SdsNodeLatency));
+    }
+}
+
+/**
+ * Fold one status message into the device's clock estimate and record its
+ * publish-to-apply latency.
+ * 
+ * @param ts Device "ts" of the message (t2)
+ * @param echo Clock echo carried by the message (t0, t1), or NULL
+ * @param now Owner time the message is applied (t3)
+ */
+static void latency_sample(SdsTableContext* ctx, int32_t slot, uint32_t ts,
+                           const uint32_t* echo, uint32_t now) {
+    SdsNodeLatency scratch = {0};
+    SdsNodeLatency* n = (slot >= 0 && (uint32_t)slot < ctx->latency_node_count)
+                        ? &ctx->latency_nodes[slot] : &scratch;
+    /* Without a record there is no history: only a synced sample gives a latency */
+    bool tracked = n != &scratch;
+    int32_t one_way = (int32_t)(ts - now);
+    
+    if (echo) {
+        int32_t rtt = (int32_t)((now - echo[0]) - (ts - echo[1]));
+        if (rtt >= 0 && (uint32_t)rtt <= SDS_CLOCK_MAX_RTT_MS &&
+            (!n->synced || echo[0] != n->ref_ts || (uint32_t)rtt < n->rtt_ms)) {
+            n->clock_offset_ms = (int32_t)(((int64_t)(int32_t)(echo[1] - echo[0]) + one_way) / 2);
+            n->rtt_ms = (uint32_t)rtt;
+            n->ref_ts = echo[0];
+            n->synced = true;
+        }
+    }
+    if (!n->synced) {
+        if (!tracked) return;
+        if (n->samples == 0 || one_way > n->clock_offset_ms) {
+            n->clock_offset_ms = one_way;
+        }
+    }
+    
+    /* Owner time the device published at is ts - offset */
+    int32_t latency = n->clock_offset_ms - one_way;
+    n->last_latency_ms = latency > 0 ? (uint32_t)latency : 0;
+    n->samples++;
+    if (ctx->stats) {
+        histogram_add(&ctx->stats->propagation_ms, n->last_latency_ms);
+    }
+}
+
+/* ============== Internal Functions ============== */
+
+static SdsTableContext* find_table(const char* table_type) {
+    for (int i = 0; i < _table_cap; i++) {
+        if (_tables[i].active && strcmp(_tables[i].table_type, table_type) == 0) {
+            return &_tables[i];
+        }
+    }
+    return NULL;
+}
+
+/* ============== Cluster Membership ============== */
+
+/*
+ * With SdsConfig.cluster_members > 1, a device belongs to the member with
+ * the highest score(hash(node_id), member) - rendezvous hashing - so members
+ * agree without talking to each other, and a resize only moves the devices
+ * whose best-scoring member changed. Messages for other members' devices are
+ * dropped as soon as the node is known: status, batch and LWT by topic,
+ * state once its "node" field has been read.
+ *
+ * With SdsConfig.cluster_group, owner topics are subscribed as
+ * $share/{group}/{filter} instead and the broker picks the member.
+ */
+
+static uint32_t cluster_score(uint32_t node_hash, uint8_t member) {
+    uint32_t h = node_hash ^ ((uint32_t)(member + 1) * 0x9E3779B9u);
+    /* murmur3 finalizer */
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static uint8_t cluster_member_of(const char* node_id, uint8_t members) {
+    uint32_t node_hash = hash_payload((const uint8_t*)node_id, strlen(node_id));
+    uint8_t best = 0;
+    uint32_t best_score = cluster_score(node_hash, 0);
+    for (uint8_t m = 1; m < members; m++) {
+        uint32_t score = cluster_score(node_hash, m);
+        if (score > best_score) {
+            best_score = score;
+            best = m;
+        }
+    }
+    return best;
+}
+
+/* Whether this member tracks node_id (counts the message as skipped if not) */
+static bool cluster_owns(const char* node_id) {
+    if (_cluster_members < 2 || cluster_member_of(node_id, _cluster_members) == _cluster_member) {
+        return true;
+    }
+    stats_count(&_stats.cluster_skipped, 1);
+    return false;
+}
+
+/* Owner subscription filter, in the shared group when there is one */
+static const char* cluster_filter(char* buf, size_t size, const char* filter) {
+    if (_cluster_group[0] == '\0') return filter;
+    snprintf(buf, size, "$share/%s/%s", _cluster_group, filter);
+    return buf;
+}
+
+uint8_t sds_cluster_member_for(const char* node_id) {
+    if (!node_id || _cluster_members < 2) return 0;
+    return cluster_member_of(node_id, _cluster_members);
+}
+
+SdsError sds_set_cluster_membership(uint8_t members, uint8_t member) {
+    if (!_initialized) return SDS_ERR_NOT_INITIALIZED;
+    if (_cluster_group[0] != '\0' || (members > 1 && member >= members)) {
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    _cluster_members = members > 1 ? members : 0;
+    _cluster_member = members > 1 ? member : 0;
+    SDS_LOG_I("Cluster membership: member %u of %u", (unsigned)_cluster_member, (unsigned)members);
+    if (_cluster_members == 0) return SDS_OK;
+    
+    /* Hand off devices that now belong to another member */
+    for (int i = 0; i < _table_cap; i++) {
+        SdsTableContext* ctx = &_tables[i];
+        if (!ctx->active || ctx->role != SDS_ROLE_OWNER) continue;
+        
+        table_lock(ctx);
+        uint8_t* slots_base = status_slots_base(ctx, ctx->table);
+        size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+        for (uint32_t j = 0; slots_base && j < ctx->max_status_slots; j++) {
+            uint8_t* slot = slots_base + ((size_t)j * ctx->status_slot_size);
+            if (!*(bool*)(slot + valid_offset) ||
+                cluster_member_of((const char*)slot, _cluster_members) == _cluster_member) {
+                continue;
+            }
+            SDS_LOG_I("Handing off device %s from table %s", (char*)slot, ctx->table_type);
+            release_status_slot(ctx, slot);
+        }
+        table_unlock(ctx);
+    }
+    return SDS_OK;
+}
+
+/* ============== Message Routing ============== */
+
+/*
+ * Topic -> table routes, rebuilt whenever the set of tables changes. The
+ * dispatcher hashes the table level of an inbound topic while scanning for
+ * its '/', so finding the table costs one pass over the topic plus a single
+ * memcmp on a hash hit.
+ */
+/**
+ * FNV-1a over one topic level (up to '/' or the end of the string).
+ * Stores the level length in *len.
+ */
+static uint32_t hash_topic_level(const char* level, size_t* len) {
+    uint32_t h = 2166136261u;
+    const char* p = level;
+    while (*p && *p != '/') {
+        h ^= (uint8_t)*p++;
+        h *= 16777619u;
+    }
+    *len = (size_t)(p - level);
+    return h;
+}
+
+static void routes_rebuild(void) {
+    /* With an inbound queue, routes are looked up on the receive thread */
+    if (_inq_depth > 0) {
+        sds_platform_ingest_lock();
+    }
+    
+    _route_count = 0;
+    for (int i = 0; i < _table_cap; i++) {
+        if (!_tables[i].active) continue;
+        
+        size_t len;
+        SdsRoute* route = &_routes[_route_count++];
+        route->hash = hash_topic_level(_tables[i].table_type, &len);
+        route->len = (uint8_t)len;
+        route->table = (uint8_t)i;
+    }
+    
+    if (_inq_depth > 0) {
+        sds_platform_ingest_unlock();
+    }
+}
+
+static SdsTableContext* route_lookup(const char* level, size_t len, uint32_t hash) {
+    for (uint8_t i = 0; i < _route_count; i++) {
+        const SdsRoute* route = &_routes[i];
+        if (route->hash == hash && route->len == len) {
+            SdsTableContext* ctx = &_tables[route->table];
+            if (memcmp(ctx->table_type, level, len) == 0) {
+                return ctx;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Send the collected topics as one SUBSCRIBE request */
+static void subscribe_batch_flush(SdsSubscribeBatch* batch) {
+    if (batch->count == 0) return;
+    
+    const char* topics[SDS_SUBSCRIBE_BATCH];
+    for (uint8_t i = 0; i < batch->count; i++) {
+        topics[i] = batch->topics[i];
+    }
+    if (!sds_platform_mqtt_subscribe_many(topics, batch->count)) {
+        SDS_LOG_W("Subscribe request for %u topics failed", (unsigned)batch->count);
+    }
+    batch->count = 0;
+}
+
+/* Queue a topic for the next SUBSCRIBE request, sending it when full */
+static void subscribe_batch_add(SdsSubscribeBatch* batch, const char* topic) {
+    if (batch->count == SDS_SUBSCRIBE_BATCH) {
+        subscribe_batch_flush(batch);
+    }
+    snprintf(batch->topics[batch->count++], SDS_FILTER_BUFFER_SIZE, "%s", topic);
+}
+
+/* Queue a table's subscriptions; the caller flushes the batch */
+static void subscribe_table_batch(SdsSubscribeBatch* batch, SdsTableContext* ctx) {
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+    char filter[SDS_FILTER_BUFFER_SIZE];
+    
+    if (ctx->role == SDS_ROLE_DEVICE) {
+        /* Device subscribes to config and its deltas (see Config Deltas) */
+        snprintf(topic, sizeof(topic), "sds/%s/config", ctx->table_type);
+        subscribe_batch_add(batch, topic);
+        snprintf(topic, sizeof(topic), "sds/%s/config/delta", ctx->table_type);
+        subscribe_batch_add(batch, topic);
+        
+        /* ...and to owners' resync requests for its sequenced status */
+        if (_delta_sync_enabled && ctx->status_size > 0) {
+            snprintf(topic, sizeof(topic), "sds/%s/resync/%s", ctx->table_type, _node_id);
+            subscribe_batch_add(batch, topic);
+        }
+        
+    } else if (ctx->role == SDS_ROLE_OWNER) {
+        /* Owner subscribes to state and status */
+        snprintf(topic, sizeof(topic), "sds/%s/state", ctx->table_type);
+        subscribe_batch_add(batch, cluster_filter(filter, sizeof(filter), topic));
+        
+        snprintf(topic, sizeof(topic), "sds/%s/status/+", ctx->table_type);
+        subscribe_batch_add(batch, cluster_filter(filter, sizeof(filter), topic));
+        
+        /* Subscribe to LWT topic for device offline detection (only once) */
+        if (!_lwt_subscribed) {
+            subscribe_batch_add(batch, cluster_filter(filter, sizeof(filter), "sds/lwt/+"));
+            _lwt_subscribed = true;
+            SDS_LOG_D("Subscribed to LWT topic for device offline detection");
+        }
+        
+        /* Batch envelopes carry state and status for any table (only once) */
+        if (_batch_max > 0 && !_batch_subscribed) {
+            subscribe_batch_add(batch, cluster_filter(filter, sizeof(filter), "sds/batch/+"));
+            _batch_subscribed = true;
+        }
+    }
+}
+
+static void subscribe_table_topics(SdsTableContext* ctx) {
+    SdsSubscribeBatch batch;
+    batch.count = 0;
+    subscribe_table_batch(&batch, ctx);
+    subscribe_batch_flush(&batch);
+}
+
+/* Restore every table and raw subscription after a new MQTT session */
+static void resubscribe_all(void) {
+    SdsSubscribeBatch batch;
+    batch.count = 0;
+    _lwt_subscribed = false;
+    _batch_subscribed = false;
+    
+    for (int i = 0; i < _table_cap; i++) {
+        if (_tables[i].active) {
+            subscribe_table_batch(&batch, &_tables[i]);
+        }
+    }
+    for (uint16_t i = 0; i < _raw_sub_cap; i++) {
+        if (_raw_subs[i].active) {
+            subscribe_batch_add(&batch, _raw_subs[i].topic);
+        }
+    }
+    subscribe_batch_flush(&batch);
+}
+
+static void unsubscribe_table_topics(SdsTableContext* ctx) {
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+    char filter[SDS_FILTER_BUFFER_SIZE];
+    
+    if (ctx->role == SDS_ROLE_DEVICE) {
+        snprintf(topic, sizeof(topic), "sds/%s/config", ctx->table_type);
+        sds_platform_mqtt_unsubscribe(topic);
+        snprintf(topic, sizeof(topic), "sds/%s/config/delta", ctx->table_type);
+        sds_platform_mqtt_unsubscribe(topic);
+        
+        if (_delta_sync_enabled && ctx->status_size > 0) {
+            snprintf(topic, sizeof(topic), "sds/%s/resync/%s", ctx->table_type, _node_id);
+            sds_platform_mqtt_unsubscribe(topic);
+        }
+        
+    } else if (ctx->role == SDS_ROLE_OWNER) {
+        snprintf(topic, sizeof(topic), "sds/%s/state", ctx->table_type);
+        sds_platform_mqtt_unsubscribe(cluster_filter(filter, sizeof(filter), topic));
+        
+        snprintf(topic, sizeof(topic), "sds/%s/status/+", ctx->table_type);
+        sds_platform_mqtt_unsubscribe(cluster_filter(filter, sizeof(filter), topic));
+        
+        /* Unsubscribe from LWT if no more owner tables remain */
+        if (_lwt_subscribed) {
+            bool has_other_owners = false;
+            for (int i = 0; i < _table_cap; i++) {
+                if (_tables[i].active && &_tables[i] != ctx && 
+                    _tables[i].role == SDS_ROLE_OWNER) {
+                    has_other_owners = true;
+                    break;
+                }
+            }
+            if (!has_other_owners) {
+                sds_platform_mqtt_unsubscribe(cluster_filter(filter, sizeof(filter), "sds/lwt/+"));
+                _lwt_subscribed = false;
+                SDS_LOG_D("Unsubscribed from LWT topic");
+                
+                if (_batch_subscribed) {
+                    sds_platform_mqtt_unsubscribe(cluster_filter(filter, sizeof(filter), "sds/batch/+"));
+                    _batch_subscribed = false;
+                }
+            }
+        }
+    }
+}
+
+/* ============== Delta Sync Helpers ============== */
+
+/**
+ * Check if a single field has changed between current and shadow.
+ */
+static bool field_changed(const SdsFieldMeta* field, const void* current, const void* shadow) {
+    const uint8_t* cur = (const uint8_t*)current + field->offset;
+    const uint8_t* shd = (const uint8_t*)shadow + field->offset;
+    
+    if (field->type == SDS_FIELD_FLOAT) {
+        float a, b;
+        memcpy(&a, cur, sizeof(float));
+        memcpy(&b, shd, sizeof(float));
+        float diff = (a > b) ? (a - b) : (b - a);
+        return diff > _delta_float_tolerance;
+    }
+    
+    return memcmp(cur, shd, field->size) != 0;
+}
+
+static inline bool field_mask_test(const SdsFieldMask* mask, uint8_t i) {
+    return (mask->bits[i / 8] & (1u << (i % 8))) != 0;
+}
+
+static void field_mask_set(SdsFieldMask* mask, uint8_t i) {
+    mask->bits[i / 8] |= (uint8_t)(1u << (i % 8));
+}
+
+static bool field_mask_any(const SdsFieldMask* mask) {
+    for (size_t i = 0; i < sizeof(mask->bits); i++) {
+        if (mask->bits[i]) return true;
+    }
+    return false;
+}
+
+static void field_mask_or(SdsFieldMask* mask, const SdsFieldMask* other) {
+    for (size_t i = 0; i < sizeof(mask->bits); i++) {
+        mask->bits[i] |= other->bits[i];
+    }
+}
+
+static void field_mask_clear_bits(SdsFieldMask* mask, const SdsFieldMask* other) {
+    for (size_t i = 0; i < sizeof(mask->bits); i++) {
+        mask->bits[i] &= (uint8_t)~other->bits[i];
+    }
+}
+
+/**
+ * Mark the fields that differ from the shadow (existing bits are kept).
+ * 
+ * @return Number of fields marked in the mask
+ */
+static int field_mask_diff(SdsFieldMask* mask, const SdsFieldMeta* fields, uint8_t field_count,
+                           const void* current, const void* shadow) {
+    int marked = 0;
+    for (uint8_t i = 0; i < field_count; i++) {
+        if (field_changed(&fields[i], current, shadow)) {
+            field_mask_set(mask, i);
+        }
+        if (field_mask_test(mask, i)) marked++;
+    }
+    return marked;
+}
+
+/* ============== Significance Filters ============== */
+
+/*
+ * Sections with a field that sets deadband, hysteresis or min_interval_ms
+ * pick what to publish field by field instead of comparing whole sections.
+ * Their shadow only takes the fields actually sent, so it holds each
+ * field's last published value: slow drift adds up until it crosses the
+ * deadband rather than being absorbed sync by sync.
+ */
+
+static inline bool field_has_filter(const SdsFieldMeta* field) {
+    return field->deadband > 0.0f || field->hysteresis > 0.0f || field->min_interval_ms > 0;
+}
+
+/* Read a numeric field as a double (bool and string fields read as 0) */
+static double field_number(const SdsFieldMeta* field, const uint8_t* p) {
+    switch (field->type) {
+        case SDS_FIELD_UINT8:  return *p;
+        case SDS_FIELD_INT8:   return (int8_t)*p;
+        case SDS_FIELD_UINT16: { uint16_t v; memcpy(&v, p, sizeof(v)); return v; }
+        case SDS_FIELD_INT16:  { int16_t v;  memcpy(&v, p, sizeof(v)); return v; }
+        case SDS_FIELD_UINT32: { uint32_t v; memcpy(&v, p, sizeof(v)); return v; }
+        case SDS_FIELD_INT32:  { int32_t v;  memcpy(&v, p, sizeof(v)); return v; }
+        case SDS_FIELD_FLOAT:  { float v;    memcpy(&v, p, sizeof(v)); return v; }
+        default:               return 0.0;
+    }
+}
+
+static SdsFieldTrack* field_track(SdsTableContext* ctx, const SdsFieldMeta* field) {
+    for (uint8_t i = 0; i < ctx->track_count; i++) {
+        if (ctx->track[i].field == field) return &ctx->track[i];
+    }
+    return NULL;
+}
+
+/**
+ * Flag the sections that have filters and give each field with hysteresis
+ * or a minimum interval a history slot. Called whenever field metadata is
+ * attached. The slots are carved from the table arena, one per tracked
+ * field, and reused when the next metadata needs no more.
+ */
+static void filters_setup(SdsTableContext* ctx) {
+    const SdsFieldMeta* sections[2] = { ctx->state_fields, ctx->status_fields };
+    uint8_t counts[2] = { ctx->state_field_count, ctx->status_field_count };
+    bool filtered[2] = { false, false };
+    
+    uint8_t tracked = 0;
+    for (int s = 0; s < 2; s++) {
+        for (uint8_t i = 0; sections[s] && i < counts[s]; i++) {
+            const SdsFieldMeta* field = &sections[s][i];
+            if ((field->hysteresis > 0.0f || field->min_interval_ms > 0) && tracked < SDS_MAX_TRACKED_FIELDS) {
+                tracked++;
+            }
+        }
+    }
+    
+    uint8_t cap = ctx->track_cap;
+    if (tracked > cap) {
+        SdsFieldTrack* track = arena_alloc(tracked * sizeof(SdsFieldTrack));
+        if (track) {
+            ctx->track = track;
+            ctx->track_cap = cap = tracked;
+        } else {
+            SDS_LOG_W("Table arena exhausted: %s ignores hysteresis and min interval", ctx->table_type);
+            cap = 0;
+        }
+    }
+    
+    ctx->track_count = 0;
+    for (int s = 0; s < 2; s++) {
+        for (uint8_t i = 0; sections[s] && i < counts[s]; i++) {
+            const SdsFieldMeta* field = &sections[s][i];
+            if (!field_has_filter(field)) continue;
+            filtered[s] = true;
+            if (field->hysteresis <= 0.0f && field->min_interval_ms == 0) continue;
+            
+            if (ctx->track_count < cap) {
+                SdsFieldTrack* t = &ctx->track[ctx->track_count++];
+                memset(t, 0, sizeof(*t));
+                t->field = field;
+            } else if (cap == tracked) {
+                SDS_LOG_W("%s.%s: no slot left (SDS_MAX_TRACKED_FIELDS=%d), hysteresis and min interval ignored",
+                          ctx->table_type, field->name, (int)SDS_MAX_TRACKED_FIELDS);
+            }
+        }
+    }
+    ctx->state_filtered = filtered[0];
+    ctx->status_filtered = filtered[1];
+}
+
+/**
+ * Check whether a field of a filtered section is worth publishing now.
+ */
+static bool field_significant(SdsTableContext* ctx, const SdsFieldMeta* field,
+                              const void* current, const void* shadow, uint32_t now) {
+    const SdsFieldTrack* t = field_track(ctx, field);
+    bool numeric = field->type != SDS_FIELD_BOOL && field->type != SDS_FIELD_STRING;
+    
+    if (numeric && (field->deadband > 0.0f || field->hysteresis > 0.0f)) {
+        double a = field_number(field, (const uint8_t*)current + field->offset);
+        double b = field_number(field, (const uint8_t*)shadow + field->offset);
+        double band = field->deadband > 0.0f ? field->deadband :
+                      field->type == SDS_FIELD_FLOAT ? _delta_float_tolerance : 0.0;
+        /* Reversing the last published move takes the extra hysteresis */
+        if (t && (t->fell ? a > b : a < b)) band += field->hysteresis;
+        double diff = (a > b) ? (a - b) : (b - a);
+        if (diff <= band) return false;
+    } else if (!field_changed(field, current, shadow)) {
+        return false;
+    }
+    
+    if (t && field->min_interval_ms > 0 && t->sent && now - t->last_ms < field->min_interval_ms) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Mark the fields of a filtered section that should be published now.
+ * 
+ * @param dirty Fields marked by sds_mark_dirty() (dirty tracking), or NULL
+ *              to compare every field; dirty fields without filters are
+ *              taken as they are
+ * @return Number of fields marked
+ */
+static int filter_mask(SdsTableContext* ctx, SdsFieldMask* mask,
+                       const SdsFieldMeta* fields, uint8_t field_count,
+                       const void* current, const void* shadow,
+                       const SdsFieldMask* dirty, uint32_t now) {
+    int marked = 0;
+    for (uint8_t i = 0; i < field_count; i++) {
+        if (dirty && !field_mask_test(dirty, i)) continue;
+        if ((dirty && !field_has_filter(&fields[i])) ||
+            field_significant(ctx, &fields[i], current, shadow, now)) {
+            field_mask_set(mask, i);
+            marked++;
+        }
+    }
+    return marked;
+}
+
+/**
+ * Record a publish of a filtered section: copy the sent fields into the
+ * shadow and note the direction and time of the ones that moved.
+ * 
+ * @param sent Fields carried by the message, or NULL for every field
+ */
+static void filter_commit(SdsTableContext* ctx, const SdsFieldMeta* fields, uint8_t field_count,
+                          const SdsFieldMask* sent, const void* current, uint8_t* shadow, uint32_t now) {
+    for (uint8_t i = 0; i < field_count; i++) {
+        const SdsFieldMeta* field = &fields[i];
+        if (sent && !field_mask_test(sent, i)) continue;
+        
+        const uint8_t* cur = (const uint8_t*)current + field->offset;
+        uint8_t* shd = shadow + field->offset;
+        if (memcmp(cur, shd, field->size) == 0) continue;
+        
+        SdsFieldTrack* t = field_track(ctx, field);
+        if (t) {
+            double a = field_number(field, cur);
+            double b = field_number(field, shd);
+            if (a != b) t->fell = a < b;
+            t->last_ms = now;
+            t->sent = true;
+        }
+        memcpy(shd, cur, field->size);
+    }
+}
+
+/* ============== Aggregates ============== */
+
+/*
+ * A summary table (device) holds one SdsAggregateState per aggregate at
+ * the start of its storage, then scratch for percentiles. The state is
+ * owned by the source table's lock: slot_write_begin() takes a slot's
+ * contribution out and slot_write_end() puts the new one in, so counts,
+ * sums and extremes follow the slots without a scan. An extreme whose
+ * last holder leaves is marked stale and found again by a scan at the
+ * next publish; percentiles are always selected at publish time.
+ */
+typedef struct SdsAggregateState {
+    const SdsAggregateMeta* meta;
+    const SdsFieldMeta* target;     /* Summary field */
+    const SdsFieldMeta* source;     /* Source status field, NULL for counts */
+    uint8_t section;                /* SDS_SECTION_STATE or SDS_SECTION_STATUS */
+    uint8_t target_index;           /* Field index in that section, for the dirty mask */
+    bool extreme_stale;             /* No slot is known to hold extreme */
+    uint32_t count;                 /* Contributing slots */
+    uint32_t extreme_count;         /* Of those, slots holding extreme */
+    double sum;
+    double extreme;                 /* Min or max of the contributions */
+} SdsAggregateState;
+
+_Static_assert(sizeof(SdsAggregateState) <= SDS_AGGREGATE_STATE_BYTES,
+               "SdsAggregateState must fit SDS_AGGREGATE_STATE_BYTES");
+
+static inline bool aggregate_numeric(const SdsFieldMeta* field) {
+    return field->type >= SDS_FIELD_UINT8 && field->type <= SDS_FIELD_FLOAT;
+}
+
+static inline bool aggregate_extremal(const SdsAggregateState* a) {
+    return a->meta->op == SDS_AGG_MIN || a->meta->op == SDS_AGG_MAX;
+}
+
+static SdsTableContext* aggregate_other(const SdsTableContext* ctx) {
+    return ctx->aggregate_link ? &_tables[ctx->aggregate_link - 1] : NULL;
+}
+
+/* A slot's input to an aggregate; false if it does not contribute */
+static bool aggregate_input(const SdsTableContext* source, const SdsAggregateState* a,
+                            uint32_t slot, double* v) {
+    const uint8_t* p = status_slot_at(source, slot);
+    size_t valid_offset = source->slot_valid_offset ? source->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+    if (!*(const bool*)(p + valid_offset)) return false;
+    bool online = source->slot_online_offset == 0 || *(const bool*)(p + source->slot_online_offset);
+    
+    *v = 0.0;
+    switch (a->meta->op) {
+        case SDS_AGG_COUNT:        return true;
+        case SDS_AGG_COUNT_ONLINE: return online;
+        default:
+            if (!online || !a->source) return false;
+            *v = field_number(a->source, p + source->slot_status_offset + a->source->offset);
+            return *v - *v == 0.0;  /* Skips NaN and infinities */
+    }
+}
+
+static void aggregate_extreme_add(SdsAggregateState* a, double v) {
+    bool beats = a->meta->op == SDS_AGG_MIN ? v < a->extreme : v > a->extreme;
+    if (a->extreme_count == 0 || beats) {
+        a->extreme = v;
+        a->extreme_count = 1;
+    } else if (v == a->extreme) {
+        a->extreme_count++;
+    }
+}
+
+/* Add (+1) or remove (-1) a source slot's contributions */
+static void aggregate_slot(SdsTableContext* source, uint32_t slot, int sign) {
+    SdsTableContext* summary = aggregate_other(source);
+    if (!summary || !status_slots_base(source, source->table) || slot >= source->max_status_slots) return;
+    
+    for (uint8_t i = 0; i < summary->aggregate_count; i++) {
+        SdsAggregateState* a = &summary->aggregates[i];
+        double v;
+        if (!aggregate_input(source, a, slot, &v)) continue;
+        
+        if (sign > 0) {
+            a->count++;
+            a->sum += v;
+            if (aggregate_extremal(a) && !a->extreme_stale) {
+                aggregate_extreme_add(a, v);
+            }
+        } else if (a->count > 0) {
+            a->count--;
+            a->sum -= v;
+            if (a->count == 0) {
+                /* Nothing left: also drops any rounding the sum picked up */
+                a->sum = 0.0;
+                a->extreme_count = 0;
+                a->extreme_stale = false;
+            } else if (aggregate_extremal(a) && !a->extreme_stale && a->extreme_count > 0 &&
+                       v == a->extreme && --a->extreme_count == 0) {
+                a->extreme_stale = true;
+            }
+        }
+    }
+}
+
+static void aggregate_rescan(SdsTableContext* summary, SdsTableContext* source) {
+    for (uint8_t i = 0; i < summary->aggregate_count; i++) {
+        SdsAggregateState* a = &summary->aggregates[i];
+        a->count = 0;
+        a->extreme_count = 0;
+        a->extreme_stale = false;
+        a->sum = 0.0;
+    }
+    for (uint32_t slot = 0; slot < source->max_status_slots; slot++) {
+        aggregate_slot(source, slot, +1);
+    }
+}
+
+static void aggregate_find_extreme(SdsTableContext* source, SdsAggregateState* a) {
+    a->extreme_count = 0;
+    a->extreme_stale = false;
+    for (uint32_t slot = 0; slot < source->max_status_slots; slot++) {
+        double v;
+        if (aggregate_input(source, a, slot, &v)) {
+            aggregate_extreme_add(a, v);
+        }
+    }
+}
+
+/* k-th smallest of v[0..n) (quickselect, reorders v) */
+static double aggregate_select(double* v, int64_t n, int64_t k) {
+    int64_t lo = 0;
+    int64_t hi = n - 1;
+    while (lo < hi) {
+        double pivot = v[lo + (hi - lo) / 2];
+        int64_t i = lo;
+        int64_t j = hi;
+        while (i <= j) {
+            while (v[i] < pivot) i++;
+            while (v[j] > pivot) j--;
+            if (i <= j) {
+                double t = v[i];
+                v[i++] = v[j];
+                v[j--] = t;
+            }
+        }
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    return v[k];
+}
+
+/* Nearest-rank percentile of the current contributions */
+static double aggregate_percentile(SdsTableContext* summary, SdsTableContext* source,
+                                   const SdsAggregateState* a) {
+    uint32_t n = 0;
+    for (uint32_t slot = 0; slot < source->max_status_slots && n < summary->aggregate_scratch_count; slot++) {
+        double v;
+        if (aggregate_input(source, a, slot, &v)) {
+            summary->aggregate_scratch[n++] = v;
+        }
+    }
+    if (n == 0) return 0.0;
+    
+    uint64_t rank = ((uint64_t)a->meta->percentile * n + 99) / 100;
+    return aggregate_select(summary->aggregate_scratch, n, (int64_t)rank - 1);
+}
+
+/* Write v to the summary field, rounded and clamped to its type */
+static void aggregate_store(SdsTableContext* ctx, const SdsAggregateState* a, double v) {
+    size_t section_offset = a->section == SDS_SECTION_STATE ? ctx->state_offset : ctx->status_offset;
+    uint8_t* p = (uint8_t*)ctx->table + section_offset + a->target->offset;
+    uint8_t before[4];
+    size_t width = a->target->size < sizeof(before) ? a->target->size : sizeof(before);
+    memcpy(before, p, width);
+    
+    if (a->target->type == SDS_FIELD_FLOAT) {
+        float f = (float)v;
+        memcpy(p, &f, sizeof(f));
+    } else {
+        double lo = 0.0, hi = 0.0;
+        switch (a->target->type) {
+            case SDS_FIELD_UINT8:  hi = 255.0; break;
+            case SDS_FIELD_INT8:   lo = -128.0; hi = 127.0; break;
+            case SDS_FIELD_UINT16: hi = 65535.0; break;
+            case SDS_FIELD_INT16:  lo = -32768.0; hi = 32767.0; break;
+            case SDS_FIELD_UINT32: hi = 4294967295.0; break;
+            default:               lo = -2147483648.0; hi = 2147483647.0; break;
+        }
+        v = v < 0.0 ? v - 0.5 : v + 0.5;
+        int64_t n = (int64_t)(v < lo ? lo : v > hi ? hi : v);
+        switch (a->target->type) {
+            case SDS_FIELD_UINT8:  { uint8_t x = (uint8_t)n;   memcpy(p, &x, sizeof(x)); break; }
+            case SDS_FIELD_INT8:   { int8_t x = (int8_t)n;     memcpy(p, &x, sizeof(x)); break; }
+            case SDS_FIELD_UINT16: { uint16_t x = (uint16_t)n; memcpy(p, &x, sizeof(x)); break; }
+            case SDS_FIELD_INT16:  { int16_t x = (int16_t)n;   memcpy(p, &x, sizeof(x)); break; }
+            case SDS_FIELD_UINT32: { uint32_t x = (uint32_t)n; memcpy(p, &x, sizeof(x)); break; }
+            default:               { int32_t x = (int32_t)n;   memcpy(p, &x, sizeof(x)); break; }
+        }
+    }
+    
+    if (ctx->dirty_tracking && memcmp(before, p, width) != 0) {
+        field_mask_set(a->section == SDS_SECTION_STATE ? &ctx->dirty_state : &ctx->dirty_status,
+                       a->target_index);
+    }
+}
+
+/* Write a summary's fields from its source; called at the start of its sync */
+static void aggregate_publish(SdsTableContext* summary) {
+    SdsTableContext* source = aggregate_other(summary);
+    if (!source) return;
+    
+    table_lock(source);
+    if (aggregate_other(summary) != source || !status_slots_base(source, source->table)) {
+        table_unlock(source);  /* Unlinked meanwhile */
+        return;
+    }
+    if (summary->aggregate_rescan) {
+        aggregate_rescan(summary, source);
+        summary->aggregate_rescan = false;
+    }
+    
+    for (uint8_t i = 0; i < summary->aggregate_count; i++) {
+        SdsAggregateState* a = &summary->aggregates[i];
+        double v = 0.0;
+        if (a->count > 0) {
+            switch (a->meta->op) {
+                case SDS_AGG_SUM:        v = a->sum; break;
+                case SDS_AGG_MEAN:       v = a->sum / a->count; break;
+                case SDS_AGG_PERCENTILE: v = aggregate_percentile(summary, source, a); break;
+                case SDS_AGG_MIN:
+                case SDS_AGG_MAX:
+                    if (a->extreme_stale) aggregate_find_extreme(source, a);
+                    v = a->extreme;
+                    break;
+                default:                 v = a->count; break;
+            }
+        }
+        aggregate_store(summary, a, v);
+    }
+    table_unlock(source);
+}
+
+static const SdsFieldMeta* aggregate_field(const SdsFieldMeta* fields, uint8_t count,
+                                           const char* name, uint8_t* index) {
+    for (uint8_t i = 0; fields && name && i < count; i++) {
+        if (strcmp(fields[i].name, name) == 0) {
+            if (index) *index = i;
+            return &fields[i];
+        }
+    }
+    return NULL;
+}
+
+/* Check the descriptors and find their summary fields */
+static SdsError aggregate_targets(SdsTableContext* summary) {
+    for (uint8_t i = 0; i < summary->aggregate_count; i++) {
+        const SdsAggregateMeta* m = &summary->aggregate_meta[i];
+        SdsAggregateState* a = &summary->aggregates[i];
+        
+        bool counts = m->op == SDS_AGG_COUNT || m->op == SDS_AGG_COUNT_ONLINE;
+        if ((unsigned)m->op > SDS_AGG_PERCENTILE || (!counts && !m->source) ||
+            (m->op == SDS_AGG_PERCENTILE && (m->percentile < 1 || m->percentile > 99))) {
+            SDS_LOG_E("Aggregate %s of %s: invalid operation", m->target ? m->target : "(null)",
+                      summary->table_type);
+            return SDS_ERR_INVALID_CONFIG;
+        }
+        
+        a->meta = m;
+        a->section = SDS_SECTION_STATE;
+        a->target = aggregate_field(summary->state_fields, summary->state_field_count,
+                                    m->target, &a->target_index);
+        if (!a->target) {
+            a->section = SDS_SECTION_STATUS;
+            a->target = aggregate_field(summary->status_fields, summary->status_field_count,
+                                        m->target, &a->target_index);
+        }
+        if (!a->target || !aggregate_numeric(a->target)) {
+            SDS_LOG_E("Aggregate %s of %s: no numeric state or status field of that name",
+                      m->target ? m->target : "(null)", summary->table_type);
+            return SDS_ERR_INVALID_CONFIG;
+        }
+    }
+    return SDS_OK;
+}
+
+/*
+ * Link a summary to its source. A source without status slots or status
+ * field metadata is not ready yet: the summary stays pending and is
+ * linked when the source gets them.
+ */
+static SdsError aggregate_link(SdsTableContext* summary, SdsTableContext* source) {
+    if (!source->status_fields || !status_slots_base(source, source->table) ||
+        source->max_status_slots == 0) {
+        SDS_LOG_D("Aggregates of %s wait for %s status slots", summary->table_type, source->table_type);
+        return SDS_OK;
+    }
+    if (source->aggregate_link && aggregate_other(source) != summary) {
+        SDS_LOG_E("Aggregates of %s: %s already feeds %s", summary->table_type,
+                  source->table_type, aggregate_other(source)->table_type);
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    bool percentile = false;
+    for (uint8_t i = 0; i < summary->aggregate_count; i++) {
+        SdsAggregateState* a = &summary->aggregates[i];
+        const char* name = a->meta->source;
+        if (a->meta->op == SDS_AGG_COUNT || a->meta->op == SDS_AGG_COUNT_ONLINE) continue;
+        
+        const SdsFieldMeta* field = aggregate_field(source->status_fields, source->status_field_count,
+                                                    name, NULL);
+        if (!field || !aggregate_numeric(field)) {
+            SDS_LOG_E("Aggregate %s of %s: %s has no numeric status field %s", a->meta->target,
+                      summary->table_type, source->table_type, name);
+            return SDS_ERR_INVALID_CONFIG;
+        }
+        a->source = field;
+        percentile |= a->meta->op == SDS_AGG_PERCENTILE;
+    }
+    if (percentile && summary->aggregate_scratch_count < source->max_status_slots) {
+        SDS_LOG_E("Aggregates of %s: percentile scratch for %u slots, %s has %u",
+                  summary->table_type, (unsigned)summary->aggregate_scratch_count,
+                  source->table_type, (unsigned)source->max_status_slots);
+        return SDS_ERR_BUFFER_FULL;
+    }
+    
+    table_lock(source);
+    summary->aggregate_link = (uint8_t)(table_index(source) + 1);
+    source->aggregate_link = (uint8_t)(table_index(summary) + 1);
+    summary->aggregate_rescan = true;
+    table_unlock(source);
+    
+    SDS_LOG_D("Aggregates of %s linked to %s", summary->table_type, source->table_type);
+    return SDS_OK;
+}
+
+/* Break a summary-source link, from either side */
+static void aggregate_unlink(SdsTableContext* ctx) {
+    SdsTableContext* other = aggregate_other(ctx);
+    if (!other) return;
+    
+    SdsTableContext* source = ctx->role == SDS_ROLE_OWNER ? ctx : other;
+    table_lock(source);
+    ctx->aggregate_link = 0;
+    other->aggregate_link = 0;
+    table_unlock(source);
+}
+
+/*
+ * Link again after a table's fields or slots changed: a summary to its
+ * source, or an owner to the summaries waiting for it.
+ */
+static void aggregate_relink(SdsTableContext* ctx) {
+    if (ctx->aggregate_meta) {
+        aggregate_unlink(ctx);
+        SdsTableContext* source = find_table(ctx->aggregate_source);
+        if (source && source->role == SDS_ROLE_OWNER) {
+            aggregate_link(ctx, source);
+        }
+    } else if (ctx->role == SDS_ROLE_OWNER) {
+        aggregate_unlink(ctx);
+        for (uint8_t i = 0; i < _table_cap; i++) {
+            SdsTableContext* summary = &_tables[i];
+            if (summary->active && summary->aggregate_meta &&
+                strcmp(summary->aggregate_source, ctx->table_type) == 0) {
+                aggregate_link(summary, ctx);
+            }
+        }
+    }
+}
+
+/* Field metadata of a summary or a source was replaced */
+static void aggregate_fields_changed(SdsTableContext* ctx) {
+    if (ctx->aggregate_meta && aggregate_targets(ctx) != SDS_OK) {
+        aggregate_unlink(ctx);
+        ctx->aggregate_meta = NULL;
+        ctx->aggregates = NULL;
+        ctx->aggregate_count = 0;
+    }
+    aggregate_relink(ctx);
+}
+
+size_t sds_aggregate_storage_size(const char* source_type, const SdsAggregateMeta* aggregates, uint8_t count) {
+    if (!aggregates || count == 0) return 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        if (aggregates[i].op == SDS_AGG_PERCENTILE) {
+            SdsTableContext* source = find_table(source_type);
+            if (!source || source->role != SDS_ROLE_OWNER || source->max_status_slots == 0) return 0;
+            return SDS_AGGREGATE_BYTES(count, source->max_status_slots);
+        }
+    }
+    return SDS_AGGREGATE_BYTES(count, 0);
+}
+
+SdsError sds_set_table_aggregates(const char* summary_type, const char* source_type,
+                                  const SdsAggregateMeta* aggregates, uint8_t count,
+                                  void* storage, size_t storage_size) {
+    SdsTableContext* ctx = find_table(summary_type);
+    if (!ctx || ctx->role != SDS_ROLE_DEVICE) {
+        SDS_LOG_W("sds_set_table_aggregates: table %s not found or not device",
+                  summary_type ? summary_type : "(null)");
+        return SDS_ERR_TABLE_NOT_FOUND;
+    }
+    
+    aggregate_unlink(ctx);
+    ctx->aggregate_meta = NULL;
+    ctx->aggregates = NULL;
+    ctx->aggregate_count = 0;
+    if (!aggregates || count == 0) {
+        return SDS_OK;
+    }
+    
+    if (!source_type || source_type[0] == '\0' || strcmp(source_type, ctx->table_type) == 0 ||
+        !storage || ((uintptr_t)storage & 7u) != 0) {
+        SDS_LOG_E("sds_set_table_aggregates: %s needs another source table and aligned storage",
+                  ctx->table_type);
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    if (storage_size < SDS_AGGREGATE_BYTES(count, 0)) {
+        SDS_LOG_E("sds_set_table_aggregates: %zu bytes given, %zu needed",
+                  storage_size, SDS_AGGREGATE_BYTES(count, 0));
+        return SDS_ERR_BUFFER_FULL;
+    }
+    
+    memset(storage, 0, storage_size);
+    ctx->aggregate_meta = aggregates;
+    ctx->aggregates = (SdsAggregateState*)storage;
+    ctx->aggregate_count = count;
+    ctx->aggregate_scratch = (double*)((uint8_t*)storage + SDS_AGGREGATE_BYTES(count, 0));
+    ctx->aggregate_scratch_count = (uint32_t)((storage_size - SDS_AGGREGATE_BYTES(count, 0)) / sizeof(double));
+    strncpy(ctx->aggregate_source, source_type, SDS_MAX_TABLE_TYPE_LEN - 1);
+    ctx->aggregate_source[SDS_MAX_TABLE_TYPE_LEN - 1] = '\0';
+    
+    SdsError err = aggregate_targets(ctx);
+    SdsTableContext* source = find_table(ctx->aggregate_source);
+    if (err == SDS_OK && source && source->role == SDS_ROLE_OWNER) {
+        err = aggregate_link(ctx, source);
+    }
+    if (err != SDS_OK) {
+        ctx->aggregate_meta = NULL;
+        ctx->aggregates = NULL;
+        ctx->aggregate_count = 0;
+    }
+    return err;
+}
+
+/* ============== Schema Serializer ============== */
+
+/*
+ * Sections described by SdsFieldMeta are serialized straight from the
+ * descriptors, so generated and Python tables need no per-table callbacks.
+ * Each field's `"name":` is rendered once into ctx->field_keys as a length
+ * byte followed by the fragment; walking a section's fragments in field
+ * order yields the key for field i without strlen or re-quoting. The cache
+ * is measured first and carved from the table arena at its exact size (at
+ * most SDS_FIELD_KEY_CACHE_SIZE), so tables without metadata take nothing.
+ */
+
+/**
+ * Render the key fragments for one section into a key cache of cap bytes.
+ * With keys NULL only the size is measured.
+ *
+ * @return Offset of the section's first fragment, or SDS_FIELD_KEYS_NONE
+ *         if the section has no metadata or does not fit
+ */
+static uint16_t build_field_keys(char* keys, size_t cap, size_t* used,
+                                 const SdsFieldMeta* fields, uint8_t field_count) {
+    if (!fields || field_count == 0) return SDS_FIELD_KEYS_NONE;
+    
+    char scratch[256];
+    size_t start = *used;
+    size_t pos = start;
+    for (uint8_t i = 0; i < field_count; i++) {
+        if (pos + 2 > cap) return SDS_FIELD_KEYS_NONE;
+        
+        /* Fragments are capped at 255 bytes by the length prefix */
+        size_t room = cap - pos - 1;
+        if (room > sizeof(scratch)) room = sizeof(scratch);
+        size_t len = sds_json_key_fragment(fields[i].name, keys ? &keys[pos + 1] : scratch, room);
+        if (len == 0) return SDS_FIELD_KEYS_NONE;
+        
+        if (keys) keys[pos] = (char)(uint8_t)len;
+        pos += 1 + len;
+    }
+    
+    *used = pos;
+    return (uint16_t)start;
+}
+
+/**
+ * (Re)build the key cache after field metadata changes.
+ */
+static void cache_field_keys(SdsTableContext* ctx) {
+    ctx->config_keys = SDS_FIELD_KEYS_NONE;
+    ctx->state_keys = SDS_FIELD_KEYS_NONE;
+    ctx->status_keys = SDS_FIELD_KEYS_NONE;
+    
+    size_t need = 0;
+    build_field_keys(NULL, SDS_FIELD_KEY_CACHE_SIZE, &need, ctx->config_fields, ctx->config_field_count);
+    build_field_keys(NULL, SDS_FIELD_KEY_CACHE_SIZE, &need, ctx->state_fields, ctx->state_field_count);
+    build_field_keys(NULL, SDS_FIELD_KEY_CACHE_SIZE, &need, ctx->status_fields, ctx->status_field_count);
+    
+    /* Room for the last fragment's terminator; reuse this slot's block when it fits */
+    size_t size = need ? need + 1 : 0;
+    if (size > ctx->field_keys_cap) {
+        char* keys = arena_alloc(size);
+        if (keys) {
+            ctx->field_keys = keys;
+            ctx->field_keys_cap = (uint16_t)size;
+        } else {
+            SDS_LOG_W("Table arena exhausted: %s formats field keys per message", ctx->table_type);
+            size = 0;
+        }
+    }
+    
+    if (size > 0) {
+        size_t used = 0;
+        ctx->config_keys = build_field_keys(ctx->field_keys, ctx->field_keys_cap, &used,
+                                            ctx->config_fields, ctx->config_field_count);
+        ctx->state_keys = build_field_keys(ctx->field_keys, ctx->field_keys_cap, &used,
+                                           ctx->state_fields, ctx->state_field_count);
+        ctx->status_keys = build_field_keys(ctx->field_keys, ctx->field_keys_cap, &used,
+                                            ctx->status_fields, ctx->status_field_count);
+    }
+    
+    if ((ctx->config_fields && ctx->config_keys == SDS_FIELD_KEYS_NONE) ||
+        (ctx->state_fields && ctx->state_keys == SDS_FIELD_KEYS_NONE) ||
+        (ctx->status_fields && ctx->status_keys == SDS_FIELD_KEYS_NONE)) {
+        SDS_LOG_D("Field key cache full for %s (SDS_FIELD_KEY_CACHE_SIZE=%d)",
+                  ctx->table_type, (int)SDS_FIELD_KEY_CACHE_SIZE);
+    }
+}
+
+static const char* section_keys(const SdsTableContext* ctx, uint16_t keys) {
+    return (keys == SDS_FIELD_KEYS_NONE) ? NULL : &ctx->field_keys[keys];
+}
+
+/**
+ * Serialize a single field to JSON.
+ * 
+ * @param key Cached [len]["name":] entry, or NULL to render the key now
+ */
+static void serialize_field(const SdsFieldMeta* field, const char* key, const void* section, SdsJsonWriter* w) {
+    const uint8_t* ptr = (const uint8_t*)section + field->offset;
+    
+    if (key) {
+        sds_json_add_key(w, key + 1, (uint8_t)key[0]);
+    } else {
+        char frag[256];
+        size_t len = sds_json_key_fragment(field->name, frag, sizeof(frag));
+        if (len == 0) {
+            w->error = true;
+            return;
+        }
+        sds_json_add_key(w, frag, len);
+    }
+    
+    switch (field->type) {
+        case SDS_FIELD_BOOL:
+            sds_json_write_bool(w, *ptr != 0);
+            break;
+        case SDS_FIELD_UINT8:
+            sds_json_write_uint(w, *ptr);
+            break;
+        case SDS_FIELD_INT8:
+            sds_json_write_int(w, *(const int8_t*)ptr);
+            break;
+        case SDS_FIELD_UINT16: {
+            uint16_t val;
+            memcpy(&val, ptr, sizeof(uint16_t));
+            sds_json_write_uint(w, val);
+            break;
+        }
+        case SDS_FIELD_INT16: {
+            int16_t val;
+            memcpy(&val, ptr, sizeof(int16_t));
+            sds_json_write_int(w, val);
+            break;
+        }
+        case SDS_FIELD_UINT32: {
+            uint32_t val;
+            memcpy(&val, ptr, sizeof(uint32_t));
+            sds_json_write_uint(w, val);
+            break;
+        }
+        case SDS_FIELD_INT32: {
+            int32_t val;
+            memcpy(&val, ptr, sizeof(int32_t));
+            sds_json_write_int(w, val);
+            break;
+        }
+        case SDS_FIELD_FLOAT: {
+            float val;
+            memcpy(&val, ptr, sizeof(float));
+            if (field->precision > 0) {
+                sds_json_write_float_fixed(w, val, field->precision);
+            } else {
+                sds_json_write_float(w, val);
+            }
+            break;
+        }
+        case SDS_FIELD_STRING:
+            sds_json_write_string(w, (const char*)ptr);
+            break;
+    }
+}
+
+/**
+ * Serialize a section's fields to JSON.
+ * 
+ * @param fields Array of field descriptors
+ * @param field_count Number of fields
+ * @param keys Cached key fragments for this section (or NULL)
+ * @param current Current section data
+ * @param mask Fields to write (delta sync), or NULL for all fields
+ * @param w JSON writer
+ * @return Number of fields written
+ */
+static int serialize_fields(
+    const SdsFieldMeta* fields,
+    uint8_t field_count,
+    const char* keys,
+    const void* current,
+    const SdsFieldMask* mask,
+    SdsJsonWriter* w
+) {
+    int written = 0;
+    
+    for (uint8_t i = 0; i < field_count; i++) {
+        const char* key = keys;
+        if (keys) keys += 1 + (uint8_t)keys[0];
+        
+        if (mask && !field_mask_test(mask, i)) continue;
+        serialize_field(&fields[i], key, current, w);
+        written++;
+    }
+    
+    return written;
+}
+
+/**
+ * Deserialize a section's fields from JSON.
+ * 
+ * Missing or out-of-range fields leave the section untouched, matching the
+ * generated deserializers (integers narrower than 32 bits are truncated,
+ * except uint8 which is range-checked).
+ */
+static void deserialize_fields(
+    const SdsFieldMeta* fields,
+    uint8_t field_count,
+    const char* keys,
+    void* section,
+    SdsJsonReader* r
+) {
+    for (uint8_t i = 0; i < field_count; i++) {
+        const SdsFieldMeta* field = &fields[i];
+        const char* value;
+        
+        if (keys) {
+            /* Fragment is `"name":`; the key as it appears in the payload sits inside */
+            uint8_t len = (uint8_t)keys[0];
+            value = sds_json_find_field_n(r, keys + 2, (size_t)len - 3);
+            keys += 1 + len;
+        } else {
+            value = sds_json_find_field(r, field->name);
+        }
+        if (!value) continue;
+        
+        uint8_t* ptr = (uint8_t*)section + field->offset;
+        
+        switch (field->type) {
+            case SDS_FIELD_BOOL: {
+                bool val;
+                if (sds_json_parse_bool(value, &val)) *(bool*)ptr = val;
+                break;
+            }
+            case SDS_FIELD_UINT8: {
+                uint32_t val;
+                if (sds_json_parse_uint(value, &val) && val <= UINT8_MAX) *ptr = (uint8_t)val;
+                break;
+            }
+            case SDS_FIELD_INT8: {
+                int32_t val;
+                if (sds_json_parse_int(value, &val)) *(int8_t*)ptr = (int8_t)val;
+                break;
+            }
+            case SDS_FIELD_UINT16: {
+                uint32_t val;
+                if (sds_json_parse_uint(value, &val)) {
+                    uint16_t v16 = (uint16_t)val;
+                    memcpy(ptr, &v16, sizeof(v16));
+                }
+                break;
+            }
+            case SDS_FIELD_INT16: {
+                int32_t val;
+                if (sds_json_parse_int(value, &val)) {
+                    int16_t v16 = (int16_t)val;
+                    memcpy(ptr, &v16, sizeof(v16));
+                }
+                break;
+            }
+            case SDS_FIELD_UINT32: {
+                uint32_t val;
+                if (sds_json_parse_uint(value, &val)) memcpy(ptr, &val, sizeof(val));
+                break;
+            }
+            case SDS_FIELD_INT32: {
+                int32_t val;
+                if (sds_json_parse_int(value, &val)) memcpy(ptr, &val, sizeof(val));
+                break;
+            }
+            case SDS_FIELD_FLOAT: {
+                float val;
+                if (sds_json_parse_float(value, &val)) memcpy(ptr, &val, sizeof(val));
+                break;
+            }
+            case SDS_FIELD_STRING:
+                sds_json_parse_string_in(r, value, (char*)ptr, field->size);
+                break;
+        }
+    }
+}
+
+/* ============== Binary Wire Format ============== */
+
+/*
+ * Compact alternative to JSON for sections described by SdsFieldMeta.
+ * All multi-byte values are little-endian:
+ *
+ *   u8   magic (SDS_WIRE_MAGIC; never '{' so receivers can sniff the format)
+ *   u8   version
+ *   u8   flags (SDS_WIRE_FLAG_*)
+ *   u32  ts
+ *   str  origin: sender node_id (config/state) or schema version (status)
+ *   [u32 echoed config ts, u32 its receive time, only with SDS_WIRE_FLAG_CLOCK]
+ *   [u32 advertised liveness interval, only with SDS_WIRE_FLAG_LIVENESS]
+ *   [u32 status sequence number or config delta baseline ts, only with SDS_WIRE_FLAG_SEQ]
+ *   [varint bitmap of present fields, only with SDS_WIRE_FLAG_DELTA]
+ *   values of the present fields, in field metadata order
+ *
+ * A str is a varint length followed by the bytes (no terminator). Varints
+ * carry 7 bits per byte, least significant group first, with the high bit
+ * set while more bytes follow; the bitmap uses the same grouping, bit i
+ * standing for field i. Bool/u8/i8 values take 1 byte, u16/i16 2 bytes,
+ * u32/i32/float 4 bytes. Field indices rely on both ends sharing the schema.
+ */
+#define SDS_WIRE_MAGIC        0xB5
+#define SDS_WIRE_VERSION      1
+#define SDS_WIRE_FLAG_DELTA   0x01  /* Presence bitmap follows the header */
+#define SDS_WIRE_FLAG_ONLINE  0x02  /* Status: device reports online */
+#define SDS_WIRE_FLAG_CLOCK   0x04  /* Status: clock echo follows the origin */
+#define SDS_WIRE_FLAG_LIVENESS 0x08 /* Status: advertised liveness interval follows */
+#define SDS_WIRE_FLAG_SEQ     0x10  /* Status: sequence number follows; config delta: baseline ts */
+#define SDS_WIRE_FLAG_PING    0x20  /* Status: heartbeat without fields, seq is the last one sent */
+
+/* Bitmap bytes needed for the largest section (uint8_t field counts) */
+#define SDS_WIRE_BITMAP_MAX   ((255 + 6) / 7)
+
+typedef struct {
+    uint8_t* buf;
+    size_t cap;
+    size_t len;
+    bool error;
+} SdsWireWriter;
+
+typedef struct {
+    const uint8_t* buf;
+    size_t len;
+    size_t pos;
+    bool error;
+} SdsWireReader;
+
+typedef struct {
+    uint8_t flags;
+    uint32_t ts;
+    char origin[SDS_MAX_NODE_ID_LEN];
+    uint32_t clock[2];      /* SDS_WIRE_FLAG_CLOCK: echoed config ts, receive time */
+    uint32_t liveness_ms;   /* SDS_WIRE_FLAG_LIVENESS: advertised liveness (0 = none) */
+    uint32_t seq;           /* SDS_WIRE_FLAG_SEQ: status sequence or config baseline ts (0 = none) */
+} SdsWireHeader;
+
+/*
+ * An inbound table message, parsed once by the dispatcher. JSON payloads are
+ * tokenized into json; binary payloads have their header decoded and wire
+ * positioned at the field data. Handlers read from here, never the raw bytes.
+ */
+typedef struct {
+    bool binary;
+    bool header_ok;         /* Binary: header decoded */
+    SdsJsonReader json;
+    SdsJsonSpan spans[SDS_JSON_MAX_INDEX_FIELDS];   /* JSON: json's key/value index */
+    SdsWireReader wire;
+    SdsWireHeader hdr;
+    SdsInboundMsg* deferred;    /* Record callbacks here for sds_loop() (NULL = invoke now) */
+    uint32_t start_us;          /* Dispatch start, for the parse histogram */
+} SdsInbound;
+
+static inline bool wire_is_binary(const uint8_t* payload, size_t len) {
+    return len > 0 && payload[0] == SDS_WIRE_MAGIC;
+}
+
+static inline bool wire_enabled(const SdsTableContext* ctx, const SdsFieldMeta* fields, uint8_t count) {
+    return ctx->wire_format == SDS_WIRE_BINARY && fields && count > 0;
+}
+
+static void wire_put(SdsWireWriter* w, const void* src, size_t n) {
+    if (w->error) return;
+    if (n > w->cap - w->len) {
+        w->error = true;
+        return;
+    }
+    memcpy(w->buf + w->len, src, n);
+    w->len += n;
+}
+
+static void wire_put_u8(SdsWireWriter* w, uint8_t v) {
+    wire_put(w, &v, 1);
+}
+
+static void wire_put_le(SdsWireWriter* w, uint32_t v, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        wire_put_u8(w, (uint8_t)(v >> (8 * i)));
+    }
+}
+
+static void wire_put_varint(SdsWireWriter* w, uint32_t v) {
+    while (v >= 0x80) {
+        wire_put_u8(w, (uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    wire_put_u8(w, (uint8_t)v);
+}
+
+static void wire_put_str(SdsWireWriter* w, const char* s, size_t max) {
+    size_t n = 0;
+    while (n < max && s[n] != '\0') n++;
+    wire_put_varint(w, (uint32_t)n);
+    wire_put(w, s, n);
+}
+
+static uint8_t wire_get_u8(SdsWireReader* r) {
+    if (r->error || r->pos >= r->len) {
+        r->error = true;
+        return 0;
+    }
+    return r->buf[r->pos++];
+}
+
+static uint32_t wire_get_le(SdsWireReader* r, size_t n) {
+    uint32_t v = 0;
+    for (size_t i = 0; i < n; i++) {
+        v |= (uint32_t)wire_get_u8(r) << (8 * i);
+    }
+    return v;
+}
+
+static uint32_t wire_get_varint(SdsWireReader* r) {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        uint8_t b = wire_get_u8(r);
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    r->error = true;  /* Longer than 5 bytes */
+    return 0;
+}
+
+/* Read a str in place; sets r->error if it runs past the payload */
+static const uint8_t* wire_get_span(SdsWireReader* r, size_t* n) {
+    uint32_t len = wire_get_varint(r);
+    if (r->error || len > r->len - r->pos) {
+        r->error = true;
+        *n = 0;
+        return NULL;
+    }
+    const uint8_t* p = r->buf + r->pos;
+    r->pos += len;
+    *n = len;
+    return p;
+}
+
+static void wire_put_field(SdsWireWriter* w, const SdsFieldMeta* field, const uint8_t* section) {
+    const uint8_t* ptr = section + field->offset;
+    
+    switch (field->type) {
+        case SDS_FIELD_BOOL:
+            wire_put_u8(w, *ptr != 0);
+            break;
+        case SDS_FIELD_UINT8:
+        case SDS_FIELD_INT8:
+            wire_put_u8(w, *ptr);
+            break;
+        case SDS_FIELD_UINT16:
+        case SDS_FIELD_INT16: {
+            uint16_t val;
+            memcpy(&val, ptr, sizeof(uint16_t));
+            wire_put_le(w, val, 2);
+            break;
+        }
+        case SDS_FIELD_UINT32:
+        case SDS_FIELD_INT32:
+        case SDS_FIELD_FLOAT: {
+            uint32_t val;  /* Float bit pattern is copied verbatim */
+            memcpy(&val, ptr, sizeof(uint32_t));
+            wire_put_le(w, val, 4);
+            break;
+        }
+        case SDS_FIELD_STRING:
+            wire_put_str(w, (const char*)ptr, field->size);
+            break;
+    }
+}
+
+static void wire_get_field(SdsWireReader* r, const SdsFieldMeta* field, uint8_t* section) {
+    uint8_t* ptr = section + field->offset;
+    
+    switch (field->type) {
+        case SDS_FIELD_BOOL:
+            *ptr = wire_get_u8(r) != 0;
+            break;
+        case SDS_FIELD_UINT8:
+        case SDS_FIELD_INT8:
+            *ptr = wire_get_u8(r);
+            break;
+        case SDS_FIELD_UINT16:
+        case SDS_FIELD_INT16: {
+            uint16_t val = (uint16_t)wire_get_le(r, 2);
+            memcpy(ptr, &val, sizeof(uint16_t));
+            break;
+        }
+        case SDS_FIELD_UINT32:
+        case SDS_FIELD_INT32:
+        case SDS_FIELD_FLOAT: {
+            uint32_t val = wire_get_le(r, 4);
+            memcpy(ptr, &val, sizeof(uint32_t));
+            break;
+        }
+        case SDS_FIELD_STRING: {
+            uint32_t n = wire_get_varint(r);
+            if (r->error || field->size == 0 || n >= field->size || n > r->len - r->pos) {
+                r->error = true;
+                return;
+            }
+            memcpy(ptr, r->buf + r->pos, n);
+            memset(ptr + n, 0, field->size - n);
+            r->pos += n;
+            break;
+        }
+    }
+}
+
+/**
+ * Encode a section in the binary wire format.
+ * 
+ * With a mask, only the marked fields are written (delta). A clock echo
+ * (config ts, receive time), a nonzero advertised liveness interval and a
+ * nonzero sequence number are written after the origin.
+ * 
+ * @return Encoded length, or 0 if the buffer is too small
+ */
+static size_t wire_encode_section(
+    uint8_t* buf, size_t cap,
+    uint32_t ts, uint8_t flags, const char* origin, const uint32_t* clock, uint32_t liveness_ms,
+    uint32_t seq, const SdsFieldMeta* fields, uint8_t field_count,
+    const void* section, const SdsFieldMask* mask
+) {
+    SdsWireWriter w = { buf, cap, 0, false };
+    uint8_t bitmap[SDS_WIRE_BITMAP_MAX] = {0};
+    
+    if (mask) flags |= SDS_WIRE_FLAG_DELTA;
+    if (clock) flags |= SDS_WIRE_FLAG_CLOCK;
+    if (liveness_ms) flags |= SDS_WIRE_FLAG_LIVENESS;
+    if (seq) flags |= SDS_WIRE_FLAG_SEQ;
+    
+    wire_put_u8(&w, SDS_WIRE_MAGIC);
+    wire_put_u8(&w, SDS_WIRE_VERSION);
+    wire_put_u8(&w, flags);
+    wire_put_le(&w, ts, 4);
+    wire_put_str(&w, origin, SDS_MAX_NODE_ID_LEN - 1);
+    if (clock) {
+        wire_put_le(&w, clock[0], 4);
+        wire_put_le(&w, clock[1], 4);
+    }
+    if (liveness_ms) {
+        wire_put_le(&w, liveness_ms, 4);
+    }
+    if (seq) {
+        wire_put_le(&w, seq, 4);
+    }
+    
+    if (mask) {
+        size_t used = 1;
+        for (uint8_t i = 0; i < field_count; i++) {
+            if (field_mask_test(mask, i)) {
+                bitmap[i / 7] |= (uint8_t)(1u << (i % 7));
+                used = (size_t)(i / 7) + 1;
+            }
+        }
+        for (size_t b = 0; b < used; b++) {
+            wire_put_u8(&w, (uint8_t)(bitmap[b] | (b + 1 < used ? 0x80 : 0)));
+        }
+    }
+    
+    for (uint8_t i = 0; i < field_count; i++) {
+        if (mask && !(bitmap[i / 7] & (1u << (i % 7)))) continue;
+        wire_put_field(&w, &fields[i], (const uint8_t*)section);
+    }
+    
+    return w.error ? 0 : w.len;
+}
+
+/**
+ * Parse the header of a binary payload, leaving the reader at the body.
+ */
+static bool wire_read_header(const uint8_t* payload, size_t len, SdsWireReader* r, SdsWireHeader* hdr) {
+    r->buf = payload;
+    r->len = len;
+    r->pos = 0;
+    r->error = false;
+    
+    if (wire_get_u8(r) != SDS_WIRE_MAGIC) return false;
+    if (wire_get_u8(r) != SDS_WIRE_VERSION) return false;
+    
+    hdr->flags = wire_get_u8(r);
+    hdr->ts = wire_get_le(r, 4);
+    
+    uint32_t n = wire_get_varint(r);
+    if (r->error || n > r->len - r->pos) return false;
+    size_t copy = n < sizeof(hdr->origin) ? n : sizeof(hdr->origin) - 1;
+    memcpy(hdr->origin, r->buf + r->pos, copy);
+    hdr->origin[copy] = '\0';
+    r->pos += n;
+    
+    if (hdr->flags & SDS_WIRE_FLAG_CLOCK) {
+        hdr->clock[0] = wire_get_le(r, 4);
+        hdr->clock[1] = wire_get_le(r, 4);
+    }
+    hdr->liveness_ms = (hdr->flags & SDS_WIRE_FLAG_LIVENESS) ? wire_get_le(r, 4) : 0;
+    hdr->seq = (hdr->flags & SDS_WIRE_FLAG_SEQ) ? wire_get_le(r, 4) : 0;
+    
+    return !r->error;
+}
+
+/**
+ * Decode the body of a binary payload into a section.
+ * 
+ * Fields are decoded into a scratch copy and committed only if the whole
+ * body is valid, so a truncated or mismatched message leaves the section
+ * untouched. Fields absent from a delta keep their current values.
+ */
+static bool wire_decode_section(
+    SdsWireReader* r, uint8_t flags,
+    const SdsFieldMeta* fields, uint8_t field_count,
+    void* section
+) {
+    uint8_t bitmap[SDS_WIRE_BITMAP_MAX];
+    uint8_t scratch[SDS_SHADOW_SIZE];
+    size_t extent = 0;
+    
+    for (uint8_t i = 0; i < field_count; i++) {
+        size_t end = (size_t)fields[i].offset + fields[i].size;
+        if (end > extent) extent = end;
+    }
+    if (extent > sizeof(scratch)) return false;
+    
+    memset(bitmap, 0x7F, sizeof(bitmap));  /* Full message: every field present */
+    if (flags & SDS_WIRE_FLAG_DELTA) {
+        memset(bitmap, 0, sizeof(bitmap));
+        size_t max_bytes = (size_t)(field_count + 6) / 7;
+        size_t b = 0;
+        uint8_t byte;
+        do {
+            byte = wire_get_u8(r);
+            if (r->error || b >= (max_bytes ? max_bytes : 1)) return false;
+            bitmap[b++] = byte & 0x7F;
+        } while (byte & 0x80);
+        
+        /* Bits beyond the local field count mean a different schema */
+        for (size_t i = field_count; i < b * 7; i++) {
+            if (bitmap[i / 7] & (1u << (i % 7))) return false;
+        }
+    }
+    
+    memcpy(scratch, section, extent);
+    for (uint8_t i = 0; i < field_count; i++) {
+        if (!(bitmap[i / 7] & (1u << (i % 7)))) continue;
+        wire_get_field(r, &fields[i], scratch);
+    }
+    if (r->error || r->pos != r->len) return false;
+    
+    memcpy(section, scratch, extent);
+    return true;
+}
+
+/* ============== Outbound Queue ============== */
+
+/*
+ * Table syncs publish through outbound_publish(). With a queue depth of 0
+ * messages go straight to the platform, as before. Otherwise they are
+ * copied into a bounded ring that the platform sender (or sds_loop())
+ * drains. The ring and the outbound_* stats are the only state shared
+ * with the sender; both are guarded by sds_platform_outbound_lock().
+ *
+ * Under SDS_OUTBOUND_COALESCE a delta for a topic that is still queued is
+ * widened by the table's queued_state/queued_status mask and replaces the
+ * queued message, so a backlog collapses to one message per section.
+ */
+
+/* More than half the outbound queue is waiting (adaptive sync backs off) */
+static bool outbound_congested(void) {
+    if (_outq_depth == 0) return false;
+    
+    sds_platform_outbound_lock();
+    bool congested = (uint16_t)_outq_count * 2 > _outq_depth;
+    sds_platform_outbound_unlock();
+    return congested;
+}
+
+/**
+ * Check whether a delta for topic should be merged with the newest queued
+ * message for it: true under SDS_OUTBOUND_COALESCE while one is queued.
+ */
+static bool outbound_merges(const char* topic) {
+    if (_outq_depth == 0 || _outq_policy != SDS_OUTBOUND_COALESCE) {
+        return false;
+    }
+    
+    bool queued = false;
+    sds_platform_outbound_lock();
+    for (uint8_t i = 0; i < _outq_count && !queued; i++) {
+        queued = strcmp(_outq[(_outq_head + i) % _outq_depth].topic, topic) == 0;
+    }
+    sds_platform_outbound_unlock();
+    return queued;
+}
+
+/**
+ * Publish or queue a table sync message.
+ * 
+ * @param supersedes true if payload carries everything the newest queued
+ *                   message for topic does (a full section, or a delta
+ *                   merged with it), so it may replace that message
+ * @return false if the message was dropped (SDS_OUTBOUND_DROP_NEWEST)
+ */
+static bool outbound_publish(const char* topic, const uint8_t* payload, size_t len, bool retained, bool supersedes) {
+    if (_outq_depth == 0) {
+        sds_platform_mqtt_publish(topic, payload, len, retained);
+        stats_count(&_stats.messages_sent, 1);
+        return true;
+    }
+    
+    sds_platform_outbound_lock();
+    
+    SdsOutboundMsg* msg = NULL;
+    if (supersedes && _outq_policy == SDS_OUTBOUND_COALESCE) {
+        /* Replace the newest message for this topic; older deltas keep their order */
+        for (uint8_t i = _outq_count; i > 0; i--) {
+            SdsOutboundMsg* queued = &_outq[(_outq_head + i - 1) % _outq_depth];
+            if (strcmp(queued->topic, topic) == 0) {
+                msg = queued;
+                stats_count(&_stats.outbound_coalesced, 1);
+                break;
+            }
+        }
+    }
+    
+    if (!msg) {
+        if (_outq_count == _outq_depth) {
+            stats_count(&_stats.outbound_dropped, 1);
+            if (_outq_policy == SDS_OUTBOUND_DROP_NEWEST) {
+                sds_platform_outbound_unlock();
+                SDS_LOG_D("Outbound queue full, dropped message for %s", topic);
+                return false;
+            }
+            SDS_LOG_D("Outbound queue full, dropped message for %s",
+                      _outq[_outq_head].topic);
+            _outq_head = (uint8_t)((_outq_head + 1) % _outq_depth);
+            _outq_count--;
+        }
+        msg = &_outq[(_outq_head + _outq_count) % _outq_depth];
+        _outq_count++;
+        strncpy(msg->topic, topic, sizeof(msg->topic) - 1);
+        msg->topic[sizeof(msg->topic) - 1] = '\0';
+    }
+    
+    memcpy(msg->payload, payload, len);
+    msg->len = len;
+    msg->retained = retained;
+    
+    _stats.outbound_queued = _outq_count;
+    if (_outq_count > _stats.outbound_high_water) {
+        _stats.outbound_high_water = _outq_count;
+    }
+    
+    sds_platform_outbound_unlock();
+    
+    if (_outq_async) {
+        sds_platform_outbound_notify();
+    }
+    return true;
+}
+
+/**
+ * Publish queued messages in order until the queue is empty or a publish
+ * fails. Runs on the platform sender, or from sds_loop() without one.
+ */
+static void outbound_drain(void) {
+    SdsOutboundMsg msg;
+    
+    while (sds_platform_mqtt_connected()) {
+        sds_platform_outbound_lock();
+        if (_outq_count == 0) {
+            sds_platform_outbound_unlock();
+            break;
+        }
+        
+        /* Copy out so the queue is not held across the publish */
+        const SdsOutboundMsg* head = &_outq[_outq_head];
+        memcpy(msg.topic, head->topic, sizeof(msg.topic));
+        memcpy(msg.payload, head->payload, head->len);
+        msg.len = head->len;
+        msg.retained = head->retained;
+        _outq_head = (uint8_t)((_outq_head + 1) % _outq_depth);
+        _outq_count--;
+        _stats.outbound_queued = _outq_count;
+        
+        sds_platform_outbound_unlock();
+        
+        bool success = sds_platform_mqtt_publish(msg.topic, msg.payload, msg.len, msg.retained);
+        
+        sds_platform_outbound_lock();
+        if (success) {
+            stats_count(&_stats.messages_sent, 1);
+        } else {
+            stats_count(&_stats.errors, 1);
+        }
+        sds_platform_outbound_unlock();
+        
+        if (!success) {
+            break;
+        }
+    }
+}
+
+/* ============== Batch Envelope ============== */
+
+/*
+ * With SdsConfig.batch_max_bytes > 0, state and status messages are appended
+ * to one envelope instead of being published one by one:
+ *
+ *   u8   magic (SDS_BATCH_MAGIC)
+ *   u8   version
+ *   records until the end of the payload:
+ *     str  topic without the "sds/" prefix
+ *     str  payload, exactly as it would have been published unbatched
+ *
+ * Strings are encoded as in the binary wire format. The envelope is
+ * published on sds/batch/{node_id} through outbound_publish() when the next
+ * record would not fit, when a record arrives for a topic already in it (so
+ * receivers still see each topic's messages in order), batch_flush_ms after
+ * its first record, or at the end of sds_loop() when batch_flush_ms is 0.
+ * Receivers route every record as if it had arrived on its own topic.
+ */
+#define SDS_BATCH_MAGIC        0xB6
+#define SDS_BATCH_VERSION      1
+#define SDS_BATCH_HEADER_SIZE  2
+
+static size_t varint_size(size_t v) {
+    size_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+/* Check whether the pending envelope has a record for name (topic after "sds/") */
+static bool batch_contains(const char* name, size_t name_len) {
+    SdsWireReader r = { _batch_buf, _batch_len, SDS_BATCH_HEADER_SIZE, false };
+    
+    while (r.pos < r.len) {
+        size_t n, payload_len;
+        const uint8_t* record = wire_get_span(&r, &n);
+        wire_get_span(&r, &payload_len);
+        if (r.error) return false;
+        if (n == name_len && memcmp(record, name, n) == 0) return true;
+    }
+    return false;
+}
+
+/* Publish the pending envelope, if any */
+static void batch_flush(void) {
+    if (_batch_count == 0) return;
+    
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+    snprintf(topic, sizeof(topic), "sds/batch/%s", _node_id);
+    if (outbound_publish(topic, _batch_buf, _batch_len, false, false)) {
+        stats_count(&_stats.batches_sent, 1);
+        stats_count(&_stats.batched_messages, _batch_count);
+        SDS_LOG_D("Published batch: %u messages, %zu bytes", _batch_count, _batch_len);
+    }
+    
+    _batch_len = 0;
+    _batch_count = 0;
+    timer_cancel(SDS_TIMER_BATCH);
+}
+
+/**
+ * Publish a state or status message, or append it to the pending envelope.
+ * 
+ * @param topic Full topic ("sds/...")
+ * @param supersedes Passed to outbound_publish() when sent unbatched
+ * @return false if the message was dropped (see outbound_publish())
+ */
+static bool batch_publish(const char* topic, const uint8_t* payload, size_t len, bool supersedes) {
+    if (_batch_max == 0) {
+        return outbound_publish(topic, payload, len, false, supersedes);
+    }
+    
+    const char* name = topic + 4;  /* After "sds/" */
+    size_t name_len = strlen(name);
+    size_t record = varint_size(name_len) + name_len + varint_size(len) + len;
+    
+    if (SDS_BATCH_HEADER_SIZE + record > _batch_max) {
+        /* Never fits; send it on its own, after what is already pending */
+        batch_flush();
+        return outbound_publish(topic, payload, len, false, supersedes);
+    }
+    
+    if (_batch_count > 0 &&
+        (_batch_len + record > _batch_max || batch_contains(name, name_len))) {
+        batch_flush();
+    }
+    
+    SdsWireWriter w = { _batch_buf, _batch_max, _batch_len, false };
+    if (_batch_count == 0) {
+        w.len = 0;
+        wire_put_u8(&w, SDS_BATCH_MAGIC);
+        wire_put_u8(&w, SDS_BATCH_VERSION);
+        if (_batch_flush_ms > 0) {
+            timer_arm(SDS_TIMER_BATCH, sds_platform_millis() + _batch_flush_ms);
+        }
+    }
+    wire_put_varint(&w, (uint32_t)name_len);
+    wire_put(&w, name, name_len);
+    wire_put_varint(&w, (uint32_t)len);
+    wire_put(&w, payload, len);
+    
+    _batch_len = w.len;
+    _batch_count++;
+    return true;
+}
+
+SdsError sds_publish_batched(const char* topic, const void* payload, size_t payload_len) {
+    if (!_initialized) {
+        return SDS_ERR_NOT_INITIALIZED;
+    }
+    
+    if (!topic || !payload || strncmp(topic, "sds/", 4) != 0 ||
+        strlen(topic) >= SDS_TOPIC_BUFFER_SIZE) {
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    /* sds/{table_type}/state or sds/{table_type}/status/{node_id} */
+    const char* section = strchr(topic + 4, '/');
+    if (!section || section == topic + 4 || section - (topic + 4) >= SDS_MAX_TABLE_TYPE_LEN) {
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    section++;
+    if (strcmp(section, "state") != 0 &&
+        (strncmp(section, "status/", 7) != 0 || section[7] == '\0' ||
+         strlen(section + 7) >= SDS_MAX_NODE_ID_LEN || strchr(section + 7, '/'))) {
+        return SDS_ERR_INVALID_CONFIG;
+    }
+    
+    if (payload_len > SDS_MSG_BUFFER_SIZE) {
+        return SDS_ERR_BUFFER_FULL;
+    }
+    
+    if (!batch_publish(topic, (const uint8_t*)payload, payload_len, false)) {
+        return SDS_ERR_BUFFER_FULL;
+    }
+    return SDS_OK;
+}
+
+SdsError sds_flush_batch(void) {
+    if (!_initialized) {
+        return SDS_ERR_NOT_INITIALIZED;
+    }
+    batch_flush();
+    return SDS_OK;
+}
+
+/* ============== Inbound Ingest ============== */
+
+/*
+ * With an inbound queue depth of 0 messages are applied on the receive
+ * path, as before. Otherwise on_mqtt_message() copies each table message
+ * into a free _inq slot and appends it to its table's list in _inq_tables;
+ * LWT messages go on _inq_lwt. Lists are linked through
+ * SdsInboundMsg.next and guarded by sds_platform_ingest_lock().
+ *
+ * ingest_work() claims a table that has messages and no worker, pops its
+ * oldest message under the table lock and applies it. Each table sees its
+ * messages in arrival order while different tables are applied in
+ * parallel. Workers only touch the table they hold: syncs, evictions and
+ * LWTs stay on sds_loop(), which takes the same table locks, and an LWT
+ * is applied once every message that arrived before it has been.
+ *
+ * Under SDS_CALLBACKS_LOOP a worker records the callback in the message
+ * and moves it to _inq_callbacks; sds_loop() invokes it and frees the
+ * slot. When no slot is free the new message is dropped.
+ */
+
+static void inbound_list_init(SdsInboundList* list) {
+    list->head = SDS_INBOUND_NONE;
+    list->tail = SDS_INBOUND_NONE;
+}
+
+static void inbound_list_push(SdsInboundList* list, uint8_t i) {
+    _inq[i].next = SDS_INBOUND_NONE;
+    if (list->tail == SDS_INBOUND_NONE) {
+        list->head = i;
+    } else {
+        _inq[list->tail].next = i;
+    }
+    list->tail = i;
+}
+
+static uint8_t inbound_list_pop(SdsInboundList* list) {
+    uint8_t i = list->head;
+    if (i != SDS_INBOUND_NONE) {
+        list->head = _inq[i].next;
+        if (list->head == SDS_INBOUND_NONE) {
+            list->tail = SDS_INBOUND_NONE;
+        }
+    }
+    return i;
+}
+
+/* Return a message slot to the pool (queue locked) */
+static void inbound_release(uint8_t i) {
+    inbound_list_push(&_inq_free, i);
+    _inq_count--;
+    _stats.inbound_queued = _inq_count;
+}
+
+static void table_lock(const SdsTableContext* ctx) {
+    if (_inq_async) {
+        sds_platform_table_lock((uint8_t)table_index(ctx));
+    }
+}
+
+static void table_unlock(const SdsTableContext* ctx) {
+    if (_inq_async) {
+        sds_platform_table_unlock((uint8_t)table_index(ctx));
+    }
+}
+
+/* Reset the queue and carve its pool (false if the arena has no room) */
+static bool inbound_setup(const SdsConfig* config) {
+    _inq_depth = config->inbound_queue_depth;
+    if (_inq_depth > SDS_INBOUND_QUEUE_MAX) {
+        SDS_LOG_W("Inbound queue depth %u exceeds SDS_INBOUND_QUEUE_MAX, using %d",
+                  _inq_depth, SDS_INBOUND_QUEUE_MAX);
+        _inq_depth = SDS_INBOUND_QUEUE_MAX;
+    }
+    _callback_executor = config->callback_executor;
+    _inq_async = false;
+    _inq_count = 0;
+    _inq_seq = 0;
+    _inq_next_table = 0;
+    _inq = NULL;
+    if (_inq_depth > 0) {
+        _inq = arena_alloc(_inq_depth * sizeof(SdsInboundMsg));
+        if (!_inq) {
+            _inq_depth = 0;
+            return false;
+        }
+    }
+    
+    inbound_list_init(&_inq_free);
+    inbound_list_init(&_inq_lwt);
+    inbound_list_init(&_inq_callbacks);
+    for (uint8_t i = 0; i < _inq_depth; i++) {
+        inbound_list_push(&_inq_free, i);
+    }
+    for (uint8_t t = 0; t < _table_cap; t++) {
+        inbound_list_init(&_inq_tables[t].queue);
+        _inq_tables[t].busy = false;
+    }
+    return true;
+}
+
+/**
+ * Copy a received message into the pool (called from on_mqtt_message()).
+ * 
+ * @param table_start Table level of the topic, or NULL for an LWT
+ */
+static void inbound_enqueue(const char* topic, const char* table_start, size_t table_len,
+                            uint32_t table_hash, const uint8_t* payload, size_t payload_len) {
+    size_t topic_len = strlen(topic);
+    if (topic_len >= SDS_TOPIC_BUFFER_SIZE || payload_len > SDS_MSG_BUFFER_SIZE) {
+        sds_platform_ingest_lock();
+        stats_count(&_stats.inbound_dropped, 1);
+        sds_platform_ingest_unlock();
+        SDS_LOG_W("Inbound message too large, dropped: %s (%zu bytes)", topic, payload_len);
+        return;
+    }
+    
+    sds_platform_ingest_lock();
+    
+    SdsInboundList* list = &_inq_lwt;
+    uint8_t table = SDS_INBOUND_NONE;
+    if (table_start) {
+        SdsTableContext* ctx = route_lookup(table_start, table_len, table_hash);
+        if (!ctx) {
+            sds_platform_ingest_unlock();
+            SDS_LOG_D("Message for unregistered table: %.*s", (int)table_len, table_start);
+            return;
+        }
+        table = (uint8_t)table_index(ctx);
+        list = &_inq_tables[table].queue;
+    }
+    
+    uint8_t i = inbound_list_pop(&_inq_free);
+    if (i == SDS_INBOUND_NONE) {
+        stats_count(&_stats.inbound_dropped, 1);
+        sds_platform_ingest_unlock();
+        SDS_LOG_D("Inbound queue full, dropped message for %s", topic);
+        return;
+    }
+    
+    SdsInboundMsg* msg = &_inq[i];
+    memcpy(msg->topic, topic, topic_len + 1);
+    memcpy(msg->payload, payload, payload_len);
+    msg->len = payload_len;
+    msg->seq = _inq_seq++;
+    msg->table = table;
+    msg->callback = SDS_INBOUND_CB_NONE;
+    inbound_list_push(list, i);
+    
+    _inq_count++;
+    _stats.inbound_queued = _inq_count;
+    if (_inq_count > _stats.inbound_high_water) {
+        _stats.inbound_high_water = _inq_count;
+    }
+    bool notify = _inq_async && table != SDS_INBOUND_NONE;
+    
+    sds_platform_ingest_unlock();
+    
+    if (notify) {
+        sds_platform_ingest_notify();
+    }
+}
+
+/**
+ * Apply the oldest message of one table no other worker holds.
+ * Run by the platform workers, or by sds_loop() without them.
+ * 
+ * @return false if no table had a message ready
+ */
+static bool ingest_work(void) {
+    sds_platform_ingest_lock();
+    
+    SdsInboundTable* it = NULL;
+    uint8_t table = 0;
+    for (uint8_t n = 0; n < _table_cap && !it; n++) {
+        table = (uint8_t)((_inq_next_table + n) % _table_cap);
+        if (_inq_tables[table].queue.head != SDS_INBOUND_NONE && !_inq_tables[table].busy) {
+            it = &_inq_tables[table];
+        }
+    }
+    if (!it) {
+        sds_platform_ingest_unlock();
+        return false;
+    }
+    
+    /* Claim the table; the next worker starts looking after it */
+    it->busy = true;
+    it->seq = _inq[it->queue.head].seq;
+    _inq_next_table = (uint8_t)((table + 1) % _table_cap);
+    sds_platform_ingest_unlock();
+    
+    SdsTableContext* ctx = &_tables[table];
+    table_lock(ctx);
+    
+    /* Unregistering the table while we waited for it empties its list */
+    sds_platform_ingest_lock();
+    uint8_t i = inbound_list_pop(&it->queue);
+    sds_platform_ingest_unlock();
+    
+    if (i != SDS_INBOUND_NONE) {
+        SdsInboundMsg* msg = &_inq[i];
+        const char* section = msg->topic + 4 + strlen(ctx->table_type) + 1;
+        bool defer = _inq_async && _callback_executor == SDS_CALLBACKS_LOOP;
+        dispatch_table_message(ctx, section, msg->payload, msg->len, defer ? msg : NULL);
+    }
+    
+    /* Hand over deferred callbacks before unlocking so unregistering can purge them */
+    sds_platform_ingest_lock();
+    it->busy = false;
+    if (i != SDS_INBOUND_NONE) {
+        if (_inq[i].callback != SDS_INBOUND_CB_NONE) {
+            inbound_list_push(&_inq_callbacks, i);
+        } else {
+            inbound_release(i);
+        }
+    }
+    sds_platform_ingest_unlock();
+    
+    table_unlock(ctx);
+    return true;
+}
+
+/* True once every table message that arrived before seq has been applied (queue locked) */
+static bool inbound_lwt_ready(uint32_t seq) {
+    for (uint8_t t = 0; t < _table_cap; t++) {
+        const SdsInboundTable* it = &_inq_tables[t];
+        if (it->busy && (int32_t)(it->seq - seq) < 0) {
+            return false;
+        }
+        if (it->queue.head != SDS_INBOUND_NONE && (int32_t)(_inq[it->queue.head].seq - seq) < 0) {
+            return false;
         }
     }
-    return NULL;
+    return true;
 }
 
-static void subscribe_table_topics(SdsTableContext* ctx) {
-    char topic[SDS_TOPIC_BUFFER_SIZE];
+/*
+ * sds_loop()'s share of the queue: table messages when there are no
+ * workers, then deferred callbacks, then LWTs that are due. Each pass is
+ * bounded by the pool size so a busy receive thread cannot starve the loop.
+ */
+static void inbound_run_loop(void) {
+    if (!_inq_async) {
+        for (uint8_t n = 0; n < _inq_depth && ingest_work(); n++) {
+        }
+    }
     
-    if (ctx->role == SDS_ROLE_DEVICE) {
-        /* Device subscribes to config */
-        snprintf(topic, sizeof(topic), "sds/%s/config", ctx->table_type);
-        sds_platform_mqtt_subscribe(topic);
-        
-    } else if (ctx->role == SDS_ROLE_OWNER) {
-        /* Owner subscribes to state and status */
-        snprintf(topic, sizeof(topic), "sds/%s/state", ctx->table_type);
-        sds_platform_mqtt_subscribe(topic);
+    for (uint8_t n = 0; n < _inq_depth; n++) {
+        sds_platform_ingest_lock();
+        uint8_t i = inbound_list_pop(&_inq_callbacks);
+        sds_platform_ingest_unlock();
+        if (i == SDS_INBOUND_NONE) break;
         
-        snprintf(topic, sizeof(topic), "sds/%s/status/+", ctx->table_type);
-        sds_platform_mqtt_subscribe(topic);
+        SdsTableContext* ctx = &_tables[_inq[i].table];
+        if (ctx->active) {
+            run_callback(ctx, _inq[i].callback, _inq[i].node);
+        }
         
-        /* Subscribe to LWT topic for device offline detection (only once) */
-        if (!_lwt_subscribed) {
-            sds_platform_mqtt_subscribe("sds/lwt/+");
-            _lwt_subscribed = true;
-            SDS_LOG_D("Subscribed to LWT topic for device offline detection");
+        sds_platform_ingest_lock();
+        inbound_release(i);
+        sds_platform_ingest_unlock();
+    }
+    
+    for (uint8_t n = 0; n < _inq_depth; n++) {
+        sds_platform_ingest_lock();
+        uint8_t i = _inq_lwt.head;
+        if (i != SDS_INBOUND_NONE && inbound_lwt_ready(_inq[i].seq)) {
+            inbound_list_pop(&_inq_lwt);
+        } else {
+            i = SDS_INBOUND_NONE;
         }
+        sds_platform_ingest_unlock();
+        if (i == SDS_INBOUND_NONE) break;
+        
+        handle_lwt_message(_inq[i].topic + 8, _inq[i].payload, _inq[i].len);
+        
+        sds_platform_ingest_lock();
+        inbound_release(i);
+        sds_platform_ingest_unlock();
     }
 }
 
-static void unsubscribe_table_topics(SdsTableContext* ctx) {
-    char topic[SDS_TOPIC_BUFFER_SIZE];
+/* Whether sds_loop() has queued work to do */
+static bool inbound_pending(void) {
+    sds_platform_ingest_lock();
+    bool pending = _inq_callbacks.head != SDS_INBOUND_NONE || _inq_lwt.head != SDS_INBOUND_NONE;
+    if (!_inq_async) {
+        pending = pending || _inq_count > 0;
+    }
+    sds_platform_ingest_unlock();
+    return pending;
+}
+
+/* Drop a table's queued messages and deferred callbacks (table locked) */
+static void inbound_purge_table(SdsTableContext* ctx) {
+    if (_inq_depth == 0) return;
     
-    if (ctx->role == SDS_ROLE_DEVICE) {
-        snprintf(topic, sizeof(topic), "sds/%s/config", ctx->table_type);
-        sds_platform_mqtt_unsubscribe(topic);
-        
-    } else if (ctx->role == SDS_ROLE_OWNER) {
-        snprintf(topic, sizeof(topic), "sds/%s/state", ctx->table_type);
-        sds_platform_mqtt_unsubscribe(topic);
-        
-        snprintf(topic, sizeof(topic), "sds/%s/status/+", ctx->table_type);
-        sds_platform_mqtt_unsubscribe(topic);
-        
-        /* Unsubscribe from LWT if no more owner tables remain */
-        if (_lwt_subscribed) {
-            bool has_other_owners = false;
-            for (int i = 0; i < SDS_MAX_TABLES; i++) {
-                if (_tables[i].active && &_tables[i] != ctx && 
-                    _tables[i].role == SDS_ROLE_OWNER) {
-                    has_other_owners = true;
-                    break;
-                }
-            }
-            if (!has_other_owners) {
-                sds_platform_mqtt_unsubscribe("sds/lwt/+");
-                _lwt_subscribed = false;
-                SDS_LOG_D("Unsubscribed from LWT topic");
-            }
+    uint8_t table = (uint8_t)table_index(ctx);
+    sds_platform_ingest_lock();
+    
+    uint8_t i;
+    while ((i = inbound_list_pop(&_inq_tables[table].queue)) != SDS_INBOUND_NONE) {
+        inbound_release(i);
+    }
+    
+    /* Other tables' callbacks keep their order */
+    SdsInboundList keep;
+    inbound_list_init(&keep);
+    while ((i = inbound_list_pop(&_inq_callbacks)) != SDS_INBOUND_NONE) {
+        if (_inq[i].table == table) {
+            inbound_release(i);
+        } else {
+            inbound_list_push(&keep, i);
         }
     }
+    _inq_callbacks = keep;
+    
+    sds_platform_ingest_unlock();
 }
 
-/* ============== Delta Sync Helpers ============== */
+/* ============== Adaptive Scheduling ============== */
 
-/**
- * Check if a single field has changed between current and shadow.
+/*
+ * Tables registered with SdsTableOptions.sync_interval_max_ms adapt their
+ * sync interval: halved (down to sync_min_ms) after a sync that published
+ * a change, grown by half (up to sync_max_ms) after one that found nothing
+ * new or that started with the outbound queue more than half full. With liveness_max_ms a
+ * device's heartbeat gap doubles after each idle heartbeat and resets on
+ * the next change; a backed-off table still wakes in time for it.
  */
-static bool field_changed(const SdsFieldMeta* field, const void* current, const void* shadow) {
-    const uint8_t* cur = (const uint8_t*)current + field->offset;
-    const uint8_t* shd = (const uint8_t*)shadow + field->offset;
-    
-    if (field->type == SDS_FIELD_FLOAT) {
-        float a, b;
-        memcpy(&a, cur, sizeof(float));
-        memcpy(&b, shd, sizeof(float));
-        float diff = (a > b) ? (a - b) : (b - a);
-        return diff > _delta_float_tolerance;
+
+/* Current gap between a device's heartbeats */
+static uint32_t heartbeat_gap(const SdsTableContext* ctx) {
+    if (ctx->liveness_max_ms > ctx->liveness_interval_ms && ctx->liveness_current_ms > 0) {
+        return ctx->liveness_current_ms;
     }
-    
-    return memcmp(cur, shd, field->size) != 0;
+    return ctx->liveness_interval_ms;
 }
 
 /**
- * Serialize a single field to JSON.
+ * Pick the next sync interval of an adaptive table.
+ * 
+ * @param changed The sync published a change
+ * @param congested The outbound queue was backed up before the sync
  */
-static void serialize_field(const SdsFieldMeta* field, const void* section, SdsJsonWriter* w) {
-    const uint8_t* ptr = (const uint8_t*)section + field->offset;
+static void sync_adapt(SdsTableContext* ctx, bool changed, bool congested) {
+    if (ctx->sync_max_ms == 0) return;
     
-    switch (field->type) {
-        case SDS_FIELD_BOOL:
-            sds_json_add_bool(w, field->name, *ptr != 0);
-            break;
-        case SDS_FIELD_UINT8:
-            sds_json_add_uint(w, field->name, *ptr);
-            break;
-        case SDS_FIELD_INT8:
-            sds_json_add_int(w, field->name, *(const int8_t*)ptr);
-            break;
-        case SDS_FIELD_UINT16: {
-            uint16_t val;
-            memcpy(&val, ptr, sizeof(uint16_t));
-            sds_json_add_uint(w, field->name, val);
-            break;
-        }
-        case SDS_FIELD_INT16: {
-            int16_t val;
-            memcpy(&val, ptr, sizeof(int16_t));
-            sds_json_add_int(w, field->name, val);
-            break;
-        }
-        case SDS_FIELD_UINT32: {
-            uint32_t val;
-            memcpy(&val, ptr, sizeof(uint32_t));
-            sds_json_add_uint(w, field->name, val);
-            break;
-        }
-        case SDS_FIELD_INT32: {
-            int32_t val;
-            memcpy(&val, ptr, sizeof(int32_t));
-            sds_json_add_int(w, field->name, val);
-            break;
-        }
-        case SDS_FIELD_FLOAT: {
-            float val;
-            memcpy(&val, ptr, sizeof(float));
-            sds_json_add_float(w, field->name, val);
-            break;
+    uint32_t interval = ctx->sync_current_ms;
+    if (changed && !congested) {
+        interval /= 2;
+    } else {
+        interval += interval / 2 + 1;
+    }
+    if (interval < ctx->sync_min_ms) interval = ctx->sync_min_ms;
+    if (interval > ctx->sync_max_ms) interval = ctx->sync_max_ms;
+    ctx->sync_current_ms = interval;
+}
+
+static uint32_t sync_next_deadline(const SdsTableContext* ctx, uint32_t now) {
+    if (ctx->sync_max_ms == 0) return now + ctx->sync_interval_ms;
+    
+    uint32_t next = now + ctx->sync_current_ms;
+    if (ctx->role == SDS_ROLE_DEVICE && ctx->status_size > 0 && ctx->liveness_interval_ms > 0) {
+        uint32_t heartbeat = ctx->last_publish_ms + heartbeat_gap(ctx);
+        if ((int32_t)(heartbeat - next) < 0) {
+            /* A heartbeat still due now (publish failed) retries after the shortest interval */
+            next = (int32_t)(heartbeat - now) > 0 ? heartbeat : now + ctx->sync_min_ms;
         }
-        case SDS_FIELD_STRING:
-            sds_json_add_string(w, field->name, (const char*)ptr);
-            break;
     }
+    return next;
+}
+
+/* ============== Table Sync ============== */
+
+static bool can_serialize(SdsSerializeFunc serialize, const SdsFieldMeta* fields) {
+    return serialize != NULL || fields != NULL;
+}
+
+static bool can_deserialize(SdsDeserializeFunc deserialize, const SdsFieldMeta* fields) {
+    return deserialize != NULL || fields != NULL;
+}
+
+/*
+ * ============== Config Deltas ==============
+ *
+ * Config is retained so devices that connect later pick it up, which makes
+ * every config message a full section. With delta sync the owner keeps the
+ * full section on sds/{table_type}/config as a baseline and publishes
+ * changes on sds/{table_type}/config/delta. Each delta names its baseline
+ * ("base", or the binary sequence field) and carries every field changed
+ * since it, so the newest delta alone brings a device holding the baseline
+ * up to date. Deltas are retained too: a device that connects later gets
+ * the baseline and then the delta. After keyframe_interval config messages
+ * the owner publishes a new baseline, which bounds the delta size; the
+ * retained delta left behind names the old baseline and is ignored.
+ *
+ * Devices drop deltas for a baseline they have not applied, and ignore a
+ * redelivered baseline (same ts, after a reconnect) once deltas were
+ * applied on top of it, rather than undo them until the delta follows. A
+ * config that leaves the section unchanged is not reported to the config
+ * callback. The config cache keeps baselines only.
+ */
+
+/* The next config change can go out as a delta against the current baseline */
+static bool config_delta_allowed(const SdsTableContext* ctx) {
+    return _delta_sync_enabled && ctx->config_fields && ctx->config_field_count > 0 &&
+           ctx->config_base_valid && (uint32_t)ctx->config_deltas + 1 < _keyframe_interval;
 }
 
 /**
- * Serialize only changed fields to JSON (delta sync).
+ * Publish the owner's config section and update its shadow: the full
+ * section as a retained baseline, or the fields in delta against it.
  * 
- * @param fields Array of field descriptors
- * @param field_count Number of fields
- * @param current Current section data
- * @param shadow Shadow copy for comparison
- * @param w JSON writer
- * @return Number of fields that changed
+ * @return true if the config was published
  */
-static int serialize_delta_fields(
-    const SdsFieldMeta* fields,
-    uint8_t field_count,
-    const void* current,
-    const void* shadow,
-    SdsJsonWriter* w
-) {
-    int changed_count = 0;
-    
-    for (uint8_t i = 0; i < field_count; i++) {
-        if (field_changed(&fields[i], current, shadow)) {
-            serialize_field(&fields[i], current, w);
-            changed_count++;
+static bool publish_config(SdsTableContext* ctx, uint32_t now, const SdsFieldMask* delta) {
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+    char buffer[SDS_MSG_BUFFER_SIZE];
+    SdsJsonWriter w;
+    void* config_ptr = (uint8_t*)ctx->table + ctx->config_offset;
+    size_t len = 0;
+    uint32_t start = stats_clock();
+    
+    if (wire_enabled(ctx, ctx->config_fields, ctx->config_field_count)) {
+        len = wire_encode_section(
+            (uint8_t*)buffer, sizeof(buffer), now, 0, _node_id, NULL, 0,
+            delta ? ctx->config_base_ts : 0,
+            ctx->config_fields, ctx->config_field_count, config_ptr, delta
+        );
+    } else {
+        sds_json_writer_init(&w, buffer, sizeof(buffer));
+        sds_json_start_object(&w);
+        sds_json_add_uint(&w, "ts", now);
+        sds_json_add_string(&w, "from", _node_id);
+        if (delta) {
+            sds_json_add_uint(&w, "base", ctx->config_base_ts);
+            serialize_fields(ctx->config_fields, ctx->config_field_count,
+                             section_keys(ctx, ctx->config_keys), config_ptr, delta, &w);
+        } else if (ctx->serialize_config) {
+            ctx->serialize_config(config_ptr, &w);  /* Pass section pointer */
+        } else {
+            serialize_fields(ctx->config_fields, ctx->config_field_count,
+                             section_keys(ctx, ctx->config_keys), config_ptr, NULL, &w);
         }
+        sds_json_end_object(&w);
+        if (!sds_json_has_error(&w)) len = sds_json_get_length(&w);
+    }
+    if (table_stats(ctx)) stats_record(&ctx->stats->serialize_us, start);
+    
+    if (len == 0) {
+        if (table_stats(ctx)) ctx->stats->buffer_full++;
+        notify_error(SDS_ERR_BUFFER_FULL, "Config serialization buffer overflow");
+        return false;
+    }
+    
+    snprintf(topic, sizeof(topic), delta ? "sds/%s/config/delta" : "sds/%s/config", ctx->table_type);
+    if (!outbound_publish(topic, (uint8_t*)buffer, len, true, true)) {
+        return false;
     }
+    stats_sent(ctx, len, delta != NULL);
     
-    return changed_count;
+    if (delta) {
+        ctx->config_since_base = *delta;
+        ctx->config_deltas++;
+    } else {
+        ctx->config_base_ts = now;
+        ctx->config_base_valid = true;
+        ctx->config_deltas = 0;
+        memset(&ctx->config_since_base, 0, sizeof(ctx->config_since_base));
+    }
+    memcpy(ctx->shadow_config, config_ptr, ctx->config_size);
+    memset(&ctx->dirty_config, 0, sizeof(ctx->dirty_config));
+    return true;
 }
 
-/* ============== Table Sync ============== */
+/* Next status sequence number; 0 stays reserved for "none yet" */
+static inline uint32_t status_seq_next(uint32_t seq) {
+    return seq + 1 == 0 ? 1 : seq + 1;
+}
 
-static void sync_table(SdsTableContext* ctx) {
+/**
+ * Publish whatever changed in a table, plus a device's liveness heartbeat.
+ * 
+ * @return true if a change was published (heartbeats alone do not count)
+ */
+static bool sync_table(SdsTableContext* ctx) {
     char topic[SDS_TOPIC_BUFFER_SIZE];
     char buffer[SDS_MSG_BUFFER_SIZE];
     SdsJsonWriter w;
     uint32_t now = sds_platform_millis();
     bool published_something = false;
+    bool published_change = false;
     
-    if (ctx->role == SDS_ROLE_OWNER) {
-        /* Owner publishes config */
-        if (ctx->serialize_config && ctx->config_size > 0) {
-            void* config_ptr = (uint8_t*)ctx->table + ctx->config_offset;
-            
-            /* Check if config changed */
-            if (memcmp(config_ptr, ctx->shadow_config, ctx->config_size) != 0) {
-                sds_json_writer_init(&w, buffer, sizeof(buffer));
-                sds_json_start_object(&w);
-                sds_json_add_uint(&w, "ts", now);
-                sds_json_add_string(&w, "from", _node_id);
-                ctx->serialize_config(config_ptr, &w);  /* Pass section pointer */
-                sds_json_end_object(&w);
-                
-                if (sds_json_has_error(&w)) {
-                    notify_error(SDS_ERR_BUFFER_FULL, "Config serialization buffer overflow");
-                } else {
-                    snprintf(topic, sizeof(topic), "sds/%s/config", ctx->table_type);
-                    sds_platform_mqtt_publish(topic, (uint8_t*)buffer, sds_json_get_length(&w), true);
-                    
-                    memcpy(ctx->shadow_config, config_ptr, ctx->config_size);
-                    _stats.messages_sent++;
-                    published_something = true;
-                    SDS_LOG_D("Published config: %s", ctx->table_type);
-                }
+    /* A summary table's aggregates are written just before they are compared */
+    if (ctx->aggregate_meta) {
+        aggregate_publish(ctx);
+    }
+    
+    if (ctx->role == SDS_ROLE_OWNER && can_serialize(ctx->serialize_config, ctx->config_fields) &&
+        ctx->config_size > 0) {
+        /* Owner publishes config when it changed */
+        void* config_ptr = (uint8_t*)ctx->table + ctx->config_offset;
+        bool changed = ctx->dirty_tracking ? field_mask_any(&ctx->dirty_config)
+                                           : memcmp(config_ptr, ctx->shadow_config, ctx->config_size) != 0;
+        SdsFieldMask mask = ctx->config_since_base;
+        bool delta = changed && config_delta_allowed(ctx);
+        if (delta) {
+            if (ctx->dirty_tracking) {
+                field_mask_or(&mask, &ctx->dirty_config);
+            } else {
+                field_mask_diff(&mask, ctx->config_fields, ctx->config_field_count,
+                                config_ptr, ctx->shadow_config);
+            }
+            uint8_t marked = 0;
+            for (uint8_t i = 0; i < ctx->config_field_count; i++) {
+                if (field_mask_test(&mask, i)) marked++;
+            }
+            /* A delta of every field might as well be a new baseline */
+            if (marked == ctx->config_field_count) {
+                delta = false;
             }
         }
+        if (changed && publish_config(ctx, now, delta ? &mask : NULL)) {
+            published_something = true;
+            published_change = true;
+            SDS_LOG_D("Published config%s: %s", delta ? " delta" : "", ctx->table_type);
+        }
     }
     
-    /* All nodes can publish state */
-    if (ctx->serialize_state && ctx->state_size > 0) {
+    /* Nodes with a state serializer publish state (schema-only tables: devices) */
+    bool state_out = ctx->serialize_state ||
+                     (ctx->role == SDS_ROLE_DEVICE && can_serialize(NULL, ctx->state_fields));
+    if (state_out && ctx->state_size > 0) {
         void* state_ptr = (uint8_t*)ctx->table + ctx->state_offset;
         
-        /* Check if state changed */
-        if (memcmp(state_ptr, ctx->shadow_state, ctx->state_size) != 0) {
-            sds_json_writer_init(&w, buffer, sizeof(buffer));
-            sds_json_start_object(&w);
-            sds_json_add_uint(&w, "ts", now);
-            sds_json_add_string(&w, "node", _node_id);
+        /* Check if state changed (filtered sections pick their fields up front) */
+        SdsFieldMask pending = {{0}};
+        bool changed;
+        if (ctx->state_filtered) {
+            changed = filter_mask(ctx, &pending, ctx->state_fields, ctx->state_field_count,
+                                  state_ptr, ctx->shadow_state,
+                                  ctx->dirty_tracking ? &ctx->dirty_state : NULL, now) > 0;
+        } else {
+            changed = ctx->dirty_tracking ? field_mask_any(&ctx->dirty_state)
+                                          : memcmp(state_ptr, ctx->shadow_state, ctx->state_size) != 0;
+        }
+        if (changed) {
+            size_t len = 0;
+            bool delta = _delta_sync_enabled && ctx->state_fields && ctx->state_field_count > 0;
+            SdsFieldMask mask = {{0}};
+            bool merged = false;
+            
+            snprintf(topic, sizeof(topic), "sds/%s/state", ctx->table_type);
+            if (delta) {
+                /* Fold in a still-queued delta so this message can replace it */
+                merged = outbound_merges(topic);
+                if (merged) mask = ctx->queued_state;
+                if (ctx->state_filtered) {
+                    field_mask_or(&mask, &pending);
+                } else if (ctx->dirty_tracking) {
+                    field_mask_or(&mask, &ctx->dirty_state);
+                } else {
+                    field_mask_diff(&mask, ctx->state_fields, ctx->state_field_count,
+                                    state_ptr, ctx->shadow_state);
+                }
+            }
             
-            /* Use delta sync if enabled and field metadata available */
-            if (_delta_sync_enabled && ctx->state_fields && ctx->state_field_count > 0) {
-                int changed = serialize_delta_fields(
+            uint32_t start = stats_clock();
+            if (wire_enabled(ctx, ctx->state_fields, ctx->state_field_count)) {
+                len = wire_encode_section(
+                    (uint8_t*)buffer, sizeof(buffer), now, 0, _node_id, NULL, 0, 0,
                     ctx->state_fields, ctx->state_field_count,
-                    state_ptr, ctx->shadow_state, &w
+                    state_ptr, delta ? &mask : NULL
                 );
-                SDS_LOG_D("Delta state: %d/%d fields changed", changed, ctx->state_field_count);
             } else {
-                ctx->serialize_state(state_ptr, &w);  /* Full section */
+                sds_json_writer_init(&w, buffer, sizeof(buffer));
+                sds_json_start_object(&w);
+                sds_json_add_uint(&w, "ts", now);
+                sds_json_add_string(&w, "node", _node_id);
+                
+                /* Use delta sync if enabled and field metadata available */
+                if (delta) {
+                    int changed = serialize_fields(
+                        ctx->state_fields, ctx->state_field_count, section_keys(ctx, ctx->state_keys),
+                        state_ptr, &mask, &w
+                    );
+                    SDS_LOG_D("Delta state: %d/%d fields changed", changed, ctx->state_field_count);
+                } else if (ctx->serialize_state) {
+                    ctx->serialize_state(state_ptr, &w);  /* Full section */
+                } else {
+                    serialize_fields(ctx->state_fields, ctx->state_field_count,
+                                     section_keys(ctx, ctx->state_keys), state_ptr, NULL, &w);
+                }
+                sds_json_end_object(&w);
+                if (!sds_json_has_error(&w)) len = sds_json_get_length(&w);
             }
-            sds_json_end_object(&w);
+            if (table_stats(ctx)) stats_record(&ctx->stats->serialize_us, start);
             
-            if (sds_json_has_error(&w)) {
+            if (len == 0) {
+                if (table_stats(ctx)) ctx->stats->buffer_full++;
                 notify_error(SDS_ERR_BUFFER_FULL, "State serialization buffer overflow");
-            } else {
-                snprintf(topic, sizeof(topic), "sds/%s/state", ctx->table_type);
-                sds_platform_mqtt_publish(topic, (uint8_t*)buffer, sds_json_get_length(&w), false);
-                
-                memcpy(ctx->shadow_state, state_ptr, ctx->state_size);
-                _stats.messages_sent++;
+            } else if (batch_publish(topic, (uint8_t*)buffer, len, !delta || merged)) {
+                stats_sent(ctx, len, delta);
+                /* A dropped message leaves the shadow alone so the change is retried */
+                if (ctx->state_filtered) {
+                    filter_commit(ctx, ctx->state_fields, ctx->state_field_count, delta ? &mask : NULL,
+                                  state_ptr, ctx->shadow_state, now);
+                }
+                if (ctx->state_filtered && delta) {
+                    /* Held-back fields stay pending */
+                    field_mask_clear_bits(&ctx->dirty_state, &mask);
+                } else {
+                    memcpy(ctx->shadow_state, state_ptr, ctx->state_size);
+                    memset(&ctx->dirty_state, 0, sizeof(ctx->dirty_state));
+                }
+                if (delta) {
+                    ctx->queued_state = mask;
+                } else {
+                    memset(&ctx->queued_state, 0xFF, sizeof(ctx->queued_state));
+                }
                 published_something = true;
+                published_change = true;
                 SDS_LOG_D("Published state: %s", ctx->table_type);
             }
         }
     }
     
     /* Devices publish status */
-    if (ctx->role == SDS_ROLE_DEVICE && ctx->serialize_status && ctx->status_size > 0) {
+    if (ctx->role == SDS_ROLE_DEVICE && can_serialize(ctx->serialize_status, ctx->status_fields) &&
+        ctx->status_size > 0) {
         void* status_ptr = (uint8_t*)ctx->table + ctx->status_offset;
         
         /* Check if status changed OR liveness timer expired */
-        bool status_changed = (memcmp(status_ptr, ctx->shadow_status, ctx->status_size) != 0);
+        SdsFieldMask pending = {{0}};
+        bool status_changed;
+        if (ctx->status_filtered) {
+            status_changed = filter_mask(ctx, &pending, ctx->status_fields, ctx->status_field_count,
+                                         status_ptr, ctx->shadow_status,
+                                         ctx->dirty_tracking ? &ctx->dirty_status : NULL, now) > 0;
+        } else {
+            status_changed = ctx->dirty_tracking ? field_mask_any(&ctx->dirty_status)
+                                                 : memcmp(status_ptr, ctx->shadow_status, ctx->status_size) != 0;
+        }
         bool liveness_expired = (ctx->liveness_interval_ms > 0) && 
-                                (now - ctx->last_publish_ms >= ctx->liveness_interval_ms);
-        
-        if (status_changed || liveness_expired) {
-            sds_json_writer_init(&w, buffer, sizeof(buffer));
-            sds_json_start_object(&w);
-            sds_json_add_uint(&w, "ts", now);
-            sds_json_add_bool(&w, "online", true);  /* Always include online=true for heartbeat */
-            sds_json_add_string(&w, "sv", _schema_version);  /* Schema version */
+                                (now - ctx->last_publish_ms >= heartbeat_gap(ctx));
+        /* Adaptive liveness: advertise the longest gap so owners can size timeouts */
+        uint32_t advertise_ms = ctx->liveness_max_ms > ctx->liveness_interval_ms ? ctx->liveness_max_ms : 0;
+        /* Delta sync numbers status messages and sends a keyframe every _keyframe_interval */
+        bool sequenced = _delta_sync_enabled && ctx->status_fields && ctx->status_field_count > 0;
+        bool resync = sequenced && ctx->status_resync;
+        
+        snprintf(topic, sizeof(topic), "sds/%s/status/%s", ctx->table_type, _node_id);
+        bool keyframe = !sequenced || resync || ctx->status_seq == 0 ||
+                        ctx->status_since_keyframe + 1u >= _keyframe_interval;
+        /* Heartbeats between keyframes carry no fields, only the last sequence number */
+        bool ping = !keyframe && !status_changed;
+        if (ping && liveness_expired && outbound_merges(topic)) {
+            /* A status message is still queued; it proves liveness soon enough */
+            liveness_expired = false;
+        }
+        
+        if (status_changed || liveness_expired || resync) {
+            size_t len = 0;
+            bool delta = !keyframe;
+            SdsFieldMask mask = {{0}};
+            bool merged = false;
+            /* Heartbeats and keyframes echo the last config for the owner's clock estimate */
+            uint32_t clock_echo[2] = { ctx->clock_ref_ts, ctx->clock_ref_rx };
+            const uint32_t* clock = (_latency_tracking && (keyframe || ping) && ctx->clock_ref_valid) ? clock_echo : NULL;
+            
+            if (delta && !ping) {
+                merged = outbound_merges(topic);
+                if (merged) mask = ctx->queued_status;
+                if (ctx->status_filtered) {
+                    field_mask_or(&mask, &pending);
+                } else if (ctx->dirty_tracking) {
+                    field_mask_or(&mask, &ctx->dirty_status);
+                } else {
+                    field_mask_diff(&mask, ctx->status_fields, ctx->status_field_count,
+                                    status_ptr, ctx->shadow_status);
+                }
+            }
+            
+            /* A merged delta replaces the queued one and takes over its number */
+            uint32_t seq = 0;
+            if (sequenced) {
+                seq = ping || (merged && !ctx->status_ping_queued) ? ctx->status_seq
+                                                                   : status_seq_next(ctx->status_seq);
+            }
             
-            /* Use delta sync if enabled and field metadata available, but only for changes */
-            if (_delta_sync_enabled && status_changed && ctx->status_fields && ctx->status_field_count > 0) {
-                int changed = serialize_delta_fields(
-                    ctx->status_fields, ctx->status_field_count,
-                    status_ptr, ctx->shadow_status, &w
+            uint32_t start = stats_clock();
+            if (wire_enabled(ctx, ctx->status_fields, ctx->status_field_count)) {
+                len = wire_encode_section(
+                    (uint8_t*)buffer, sizeof(buffer), now,
+                    SDS_WIRE_FLAG_ONLINE | (ping ? SDS_WIRE_FLAG_PING : 0), _schema_version, clock,
+                    advertise_ms, seq, ctx->status_fields, ctx->status_field_count,
+                    status_ptr, delta ? &mask : NULL
                 );
-                SDS_LOG_D("Delta status: %d/%d fields changed", changed, ctx->status_field_count);
             } else {
-                /* Full status on liveness heartbeat or if no field metadata */
-                ctx->serialize_status(status_ptr, &w);
+                sds_json_writer_init(&w, buffer, sizeof(buffer));
+                sds_json_start_object(&w);
+                sds_json_add_uint(&w, "ts", now);
+                sds_json_add_bool(&w, "online", true);  /* Always include online=true for heartbeat */
+                sds_json_add_string(&w, "sv", _schema_version);  /* Schema version */
+                if (clock) {
+                    sds_json_add_uint(&w, "cts", clock[0]);
+                    sds_json_add_uint(&w, "crx", clock[1]);
+                }
+                if (advertise_ms) {
+                    sds_json_add_uint(&w, "lv", advertise_ms);
+                }
+                if (seq) {
+                    /* The key tells the owner what kind of message the number belongs to */
+                    sds_json_add_uint(&w, keyframe ? "kf" : ping ? "hb" : "sq", seq);
+                }
+                
+                if (ping) {
+                    /* Envelope only */
+                } else if (delta) {
+                    int changed = serialize_fields(
+                        ctx->status_fields, ctx->status_field_count, section_keys(ctx, ctx->status_keys),
+                        status_ptr, &mask, &w
+                    );
+                    SDS_LOG_D("Delta status: %d/%d fields changed", changed, ctx->status_field_count);
+                } else if (ctx->serialize_status) {
+                    /* Full status on keyframes or if no field metadata */
+                    ctx->serialize_status(status_ptr, &w);
+                } else {
+                    serialize_fields(ctx->status_fields, ctx->status_field_count,
+                                     section_keys(ctx, ctx->status_keys), status_ptr, NULL, &w);
+                }
+                sds_json_end_object(&w);
+                if (!sds_json_has_error(&w)) len = sds_json_get_length(&w);
             }
-            sds_json_end_object(&w);
+            if (table_stats(ctx)) stats_record(&ctx->stats->serialize_us, start);
             
-            if (sds_json_has_error(&w)) {
+            if (len == 0) {
+                if (table_stats(ctx)) ctx->stats->buffer_full++;
                 notify_error(SDS_ERR_BUFFER_FULL, "Status serialization buffer overflow");
-            } else {
-                snprintf(topic, sizeof(topic), "sds/%s/status/%s", ctx->table_type, _node_id);
-                sds_platform_mqtt_publish(topic, (uint8_t*)buffer, sds_json_get_length(&w), false);
-                
-                memcpy(ctx->shadow_status, status_ptr, ctx->status_size);
-                _stats.messages_sent++;
+            } else if (batch_publish(topic, (uint8_t*)buffer, len, !delta || merged)) {
+                stats_sent(ctx, len, delta);
+                if (ctx->status_filtered) {
+                    filter_commit(ctx, ctx->status_fields, ctx->status_field_count, delta ? &mask : NULL,
+                                  status_ptr, ctx->shadow_status, now);
+                }
+                if (ctx->status_filtered && delta) {
+                    field_mask_clear_bits(&ctx->dirty_status, &mask);
+                } else {
+                    memcpy(ctx->shadow_status, status_ptr, ctx->status_size);
+                    memset(&ctx->dirty_status, 0, sizeof(ctx->dirty_status));
+                }
+                if (delta) {
+                    ctx->queued_status = mask;
+                } else {
+                    memset(&ctx->queued_status, 0xFF, sizeof(ctx->queued_status));
+                }
+                if (sequenced) {
+                    ctx->status_seq = seq;
+                    ctx->status_since_keyframe = keyframe ? 0 : (uint16_t)(ctx->status_since_keyframe + 1);
+                    ctx->status_ping_queued = ping && _outq_depth > 0;
+                    if (resync) {
+                        ctx->status_resync = false;
+                        stats_count(&_stats.resync_keyframes, 1);
+                    }
+                }
                 published_something = true;
                 
-                if (liveness_expired && !status_changed) {
-                    SDS_LOG_D("Published heartbeat: %s", ctx->table_type);
+                if (!status_changed) {
+                    if (resync && !liveness_expired) {
+                        SDS_LOG_D("Published resync keyframe: %s", ctx->table_type);
+                    } else {
+                        SDS_LOG_D("Published heartbeat: %s", ctx->table_type);
+                    }
+                    /* Nothing new since the last one: stretch the next gap */
+                    if (liveness_expired && advertise_ms && !published_change) {
+                        uint32_t gap = heartbeat_gap(ctx);
+                        ctx->liveness_current_ms = gap > advertise_ms / 2 ? advertise_ms : gap * 2;
+                    }
                 } else {
+                    published_change = true;
                     SDS_LOG_D("Published status: %s", ctx->table_type);
                 }
             }
         }
     }
     
-    /* Update last publish time if we sent anything */
-    if (published_something) {
-        ctx->last_publish_ms = now;
+    /* Update last publish time if we sent anything */
+    if (published_something) {
+        ctx->last_publish_ms = now;
+    }
+    
+    /* Activity brings heartbeats back to the schema interval */
+    if (published_change) {
+        ctx->liveness_current_ms = 0;
+    }
+    return published_change;
+}
+
+/* Invoke a table's config, state or status callback */
+static void run_callback(SdsTableContext* ctx, uint8_t kind, const char* node_id) {
+    uint32_t start = stats_clock();
+    
+    switch (kind) {
+        case SDS_INBOUND_CB_CONFIG:
+            if (!ctx->config_callback) return;
+            ctx->config_callback(ctx->table_type, ctx->config_user_data);
+            break;
+        case SDS_INBOUND_CB_STATE:
+            if (!ctx->state_callback) return;
+            ctx->state_callback(ctx->table_type, node_id, ctx->state_user_data);
+            break;
+        case SDS_INBOUND_CB_STATUS:
+            if (!ctx->status_callback) return;
+            ctx->status_callback(ctx->table_type, node_id, ctx->status_user_data);
+            break;
+        default:
+            return;
+    }
+    
+    /* Deferred callbacks run unlocked; the lock is recursive for the rest */
+    if (_instrument) {
+        table_lock(ctx);
+        if (table_stats(ctx)) stats_record(&ctx->stats->callback_us, start);
+        table_unlock(ctx);
+    }
+}
+
+/* Report an applied message now, or leave the callback for sds_loop() */
+static void deliver_callback(SdsTableContext* ctx, SdsInbound* in, uint8_t kind, const char* node_id) {
+    if (table_stats(ctx)) stats_record(&ctx->stats->parse_us, in->start_us);
+    
+    if (!in->deferred) {
+        run_callback(ctx, kind, node_id);
+        return;
+    }
+    
+    /* Only messages with a callback to run hold their slot until sds_loop() */
+    bool registered = (kind == SDS_INBOUND_CB_CONFIG && ctx->config_callback) ||
+                      (kind == SDS_INBOUND_CB_STATE && ctx->state_callback) ||
+                      (kind == SDS_INBOUND_CB_STATUS && ctx->status_callback);
+    if (!registered) {
+        return;
+    }
+    
+    in->deferred->callback = kind;
+    strncpy(in->deferred->node, node_id ? node_id : "", SDS_MAX_NODE_ID_LEN - 1);
+    in->deferred->node[SDS_MAX_NODE_ID_LEN - 1] = '\0';
+}
+
+/* Parse a payload into in; shared by the dispatcher and the config cache */
+static void inbound_parse(SdsInbound* in, const uint8_t* payload, size_t payload_len) {
+    in->binary = wire_is_binary(payload, payload_len);
+    in->header_ok = false;
+    if (in->binary) {
+        sds_json_reader_init(&in->json, NULL, 0);
+        in->header_ok = wire_read_header(payload, payload_len, &in->wire, &in->hdr);
+    } else {
+        sds_json_reader_init_indexed(&in->json, (const char*)payload, payload_len,
+                                     in->spans, SDS_JSON_MAX_INDEX_FIELDS);
     }
 }
 
-static void handle_config_message(SdsTableContext* ctx, const uint8_t* payload, size_t len) {
-    if (ctx->role != SDS_ROLE_DEVICE) return;
-    if (!ctx->deserialize_config) return;
-    
-    SdsJsonReader r;
-    sds_json_reader_init(&r, (const char*)payload, len);
+/* The baseline a config delta applies to (see Config Deltas) */
+static bool config_delta_base(SdsInbound* in, uint32_t* base) {
+    if (in->binary) {
+        *base = in->hdr.seq;
+        return in->header_ok && (in->hdr.flags & SDS_WIRE_FLAG_DELTA) != 0;
+    }
+    return sds_json_get_uint_field(&in->json, "base", base);
+}
+
+/**
+ * Apply a config baseline or, with delta set, a config delta.
+ * 
+ * @return true if the config was applied
+ */
+static bool handle_config_message(SdsTableContext* ctx, SdsInbound* in, bool delta) {
+    if (ctx->role != SDS_ROLE_DEVICE) return false;
     
     /* Pass pointer to config section, not full table */
     void* config_ptr = (uint8_t*)ctx->table + ctx->config_offset;
-    ctx->deserialize_config(config_ptr, &r);
+    
+    uint32_t ts = 0;
+    bool has_ts = in->binary ? in->header_ok : sds_json_get_uint_field(&in->json, "ts", &ts);
+    if (in->binary && in->header_ok) ts = in->hdr.ts;
+    
+    if (delta) {
+        uint32_t base = 0;
+        if (!config_delta_base(in, &base) || !ctx->config_base_valid || base != ctx->config_base_ts) {
+            SDS_LOG_D("Config delta for another baseline, dropped: %s", ctx->table_type);
+            return false;
+        }
+    }
+    
+    /* A redelivered baseline would undo the deltas applied on top of it */
+    bool redelivered = !delta && has_ts && ctx->config_base_valid && ctx->config_deltas > 0 &&
+                       ts == ctx->config_base_ts;
+    
+    if (redelivered) {
+        /* Already applied */
+    } else if (in->binary) {
+        if (!ctx->config_fields || !in->header_ok ||
+            !wire_decode_section(&in->wire, in->hdr.flags, ctx->config_fields, ctx->config_field_count, config_ptr)) {
+            if (table_stats(ctx)) ctx->stats->decode_errors++;
+            SDS_LOG_W("Dropped undecodable binary config: %s", ctx->table_type);
+            return false;
+        }
+    } else {
+        if (!can_deserialize(ctx->deserialize_config, ctx->config_fields)) return false;
+        
+        if (ctx->deserialize_config) {
+            ctx->deserialize_config(config_ptr, &in->json);
+        } else {
+            deserialize_fields(ctx->config_fields, ctx->config_field_count,
+                               section_keys(ctx, ctx->config_keys), config_ptr, &in->json);
+        }
+    }
+    
+    bool first = !ctx->config_base_valid;
+    if (delta) {
+        ctx->config_deltas++;
+    } else if (!redelivered) {
+        ctx->config_base_ts = ts;
+        ctx->config_base_valid = true;
+        ctx->config_deltas = 0;
+    }
     
     /* Update shadow */
-    if (ctx->config_size > 0) {
+    bool changed = first;
+    if (ctx->config_size > 0 && memcmp(ctx->shadow_config, config_ptr, ctx->config_size) != 0) {
         memcpy(ctx->shadow_config, config_ptr, ctx->config_size);
+        changed = true;
     }
     
-    SDS_LOG_I("Config applied: %s", ctx->table_type);
+    /* Reference point for the owner's clock estimate (echoed in heartbeats) */
+    if (_latency_tracking) {
+        ctx->clock_ref_valid = has_ts;
+        ctx->clock_ref_ts = ts;
+        ctx->clock_ref_rx = sds_platform_millis();
+    }
     
-    if (ctx->config_callback) {
-        ctx->config_callback(ctx->table_type, ctx->config_user_data);
+    /* The first live config after a cache restore is still reported */
+    if (!changed && !ctx->config_restored) {
+        stats_count(&_stats.config_unchanged, 1);
+        SDS_LOG_D("Config unchanged: %s", ctx->table_type);
+        return !redelivered;
     }
+    
+    SDS_LOG_I("Config %s: %s", delta ? "delta applied" : "applied", ctx->table_type);
+    
+    deliver_callback(ctx, in, SDS_INBOUND_CB_CONFIG, NULL);
+    if (redelivered) ctx->config_restored = false;
+    return !redelivered;
 }
 
-static void handle_state_message(SdsTableContext* ctx, const char* from_node, const uint8_t* payload, size_t len) {
+static void handle_state_message(SdsTableContext* ctx, const char* from_node, SdsInbound* in) {
     if (ctx->role != SDS_ROLE_OWNER) return;
-    if (!ctx->deserialize_state) return;
     
     /* Don't process our own state messages */
     if (strcmp(from_node, _node_id) == 0) return;
-    
-    SdsJsonReader r;
-    sds_json_reader_init(&r, (const char*)payload, len);
+    if (!cluster_owns(from_node)) return;
     
     /* Pass pointer to state section */
     void* state_ptr = (uint8_t*)ctx->table + ctx->state_offset;
-    ctx->deserialize_state(state_ptr, &r);
+    
+    if (in->binary) {
+        if (!ctx->state_fields || !in->header_ok ||
+            !wire_decode_section(&in->wire, in->hdr.flags, ctx->state_fields, ctx->state_field_count, state_ptr)) {
+            if (table_stats(ctx)) ctx->stats->decode_errors++;
+            SDS_LOG_W("Dropped undecodable binary state from %s: %s", from_node, ctx->table_type);
+            return;
+        }
+    } else {
+        if (!can_deserialize(ctx->deserialize_state, ctx->state_fields)) return;
+        
+        if (ctx->deserialize_state) {
+            ctx->deserialize_state(state_ptr, &in->json);
+        } else {
+            deserialize_fields(ctx->state_fields, ctx->state_field_count,
+                               section_keys(ctx, ctx->state_keys), state_ptr, &in->json);
+        }
+    }
     
     /* Update shadow (owner's merged state) */
     if (ctx->state_size > 0) {
         memcpy(ctx->shadow_state, state_ptr, ctx->state_size);
     }
     
+    /* State traffic proves liveness too (devices skip heartbeats after it) */
+    if (ctx->slot_last_seen_offset > 0) {
+        int32_t slot = find_status_slot(ctx, from_node);
+        if (slot >= 0) {
+            uint32_t* slot_last_seen = (uint32_t*)(status_slot_at(ctx, (uint32_t)slot) + ctx->slot_last_seen_offset);
+            slot_write_begin(ctx, (uint32_t)slot);
+            *slot_last_seen = sds_platform_millis();
+            slot_write_end(ctx, (uint32_t)slot);
+        }
+    }
+    
     SDS_LOG_I("State received from %s: %s", from_node, ctx->table_type);
     
-    if (ctx->state_callback) {
-        ctx->state_callback(ctx->table_type, from_node, ctx->state_user_data);
-    }
+    deliver_callback(ctx, in, SDS_INBOUND_CB_STATE, from_node);
 }
 
 /**
@@ -1601,33 +6955,28 @@ static void handle_state_message(SdsTableContext* ctx, const char* from_node, co
  * @return Pointer to status slot, or NULL if slots are full/not configured
  */
 static void* find_or_alloc_status_slot(SdsTableContext* ctx, const char* node_id) {
-    if (ctx->status_slots_offset == 0 || ctx->max_status_slots == 0) {
+    uint8_t* slots_base = status_slots_base(ctx, ctx->table);
+    if (!slots_base) {
         return NULL;  /* No slots configured */
     }
     
-    uint8_t* slots_base = (uint8_t*)ctx->table + ctx->status_slots_offset;
-    
     /* Use configured offset or fallback to standard layout */
     size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
     
     /* Search for existing slot with this node_id */
-    for (uint8_t i = 0; i < ctx->max_status_slots; i++) {
-        uint8_t* slot = slots_base + (i * ctx->status_slot_size);
-        char* slot_node_id = (char*)slot;  /* node_id is first field */
-        bool* slot_valid = (bool*)(slot + valid_offset);
-        
-        if (*slot_valid && strcmp(slot_node_id, node_id) == 0) {
-            return slot;  /* Found existing slot */
-        }
+    int32_t existing = find_status_slot(ctx, node_id);
+    if (existing >= 0) {
+        return status_slot_at(ctx, (uint32_t)existing);
     }
     
-    /* Find first empty slot */
-    for (uint8_t i = 0; i < ctx->max_status_slots; i++) {
+    /* Find the first empty slot; everything below the hint is taken */
+    for (uint32_t i = ctx->slot_free_hint; i < ctx->max_status_slots; i++) {
         uint8_t* slot = slots_base + (i * ctx->status_slot_size);
         bool* slot_valid = (bool*)(slot + valid_offset);
         
         if (!*slot_valid) {
             /* Initialize new slot */
+            slot_write_begin(ctx, i);
             strncpy((char*)slot, node_id, SDS_MAX_NODE_ID_LEN - 1);
             ((char*)slot)[SDS_MAX_NODE_ID_LEN - 1] = '\0';
             *slot_valid = true;
@@ -1644,33 +6993,164 @@ static void* find_or_alloc_status_slot(SdsTableContext* ctx, const char* node_id
                 *slot_last_seen = sds_platform_millis();
             }
             
-            /* Increment status_count in owner table */
-            if (ctx->status_count_offset > 0) {
-                uint8_t* count_ptr = (uint8_t*)ctx->table + ctx->status_count_offset;
-                (*count_ptr)++;
+            /* No sequence number seen yet: the first delta asks for a keyframe */
+            if (ctx->slot_seq_offset > 0) {
+                *(uint32_t*)(slot + ctx->slot_seq_offset) = 0;
             }
+            slot_write_end(ctx, i);
+            
+            /* Increment status_count in owner table */
+            status_count_adjust(ctx, +1);
             
-            SDS_LOG_D("Allocated status slot %d for node: %s", i, node_id);
+            slot_index_insert(ctx, i);
+            latency_reset(ctx, i);
+            history_reset(ctx, i);
+            if (i < ctx->slot_liveness_cap) ctx->slot_liveness[i] = 0;
+            
+            ctx->slot_free_hint = i + 1;
+            SDS_LOG_D("Allocated status slot %u for node: %s", (unsigned)i, node_id);
             return slot;
         }
     }
+    ctx->slot_free_hint = ctx->max_status_slots;  /* Full until a slot is released */
     
-    SDS_LOG_W("Status slots full (%d max), dropping status from %s", 
-              ctx->max_status_slots, node_id);
+    if (table_stats(ctx)) ctx->stats->slots_full++;
+    SDS_LOG_W("Status slots full (%u max), dropping status from %s", 
+              (unsigned)ctx->max_status_slots, node_id);
     return NULL;
 }
 
-static void handle_status_message(SdsTableContext* ctx, const char* from_node, const uint8_t* payload, size_t len) {
+/* ============== Status Sequence ============== */
+
+/*
+ * With delta sync, devices number their status messages (see SdsConfig).
+ * A keyframe carries the full section, a delta the next number and the
+ * changed fields, a ping (idle heartbeat) the number of the last message
+ * with fields and none of its own. An owner keeps the last number per slot;
+ * anything but a keyframe that does not follow it means a message was
+ * lost, and the owner asks that device for a keyframe. Requests are queued
+ * here (the receive path may run on an ingest worker) and published by
+ * sds_loop(); a full queue drops the request, and the next message from the
+ * device asks again.
+ */
+
+static void resync_request(SdsTableContext* ctx, const char* node_id) {
+    uint8_t table = (uint8_t)table_index(ctx);
+    
+    sds_platform_outbound_lock();
+    bool queued = false;
+    for (uint8_t i = 0; i < _resync_count && !queued; i++) {
+        queued = _resync_queue[i].table == table && strcmp(_resync_queue[i].node, node_id) == 0;
+    }
+    if (!queued && _resync_count < SDS_RESYNC_QUEUE_MAX) {
+        SdsResyncRequest* req = &_resync_queue[_resync_count++];
+        req->table = table;
+        strncpy(req->node, node_id, SDS_MAX_NODE_ID_LEN - 1);
+        req->node[SDS_MAX_NODE_ID_LEN - 1] = '\0';
+    }
+    sds_platform_outbound_unlock();
+}
+
+/* Publish the queued resync requests */
+static void resync_flush(void) {
+    SdsResyncRequest pending[SDS_RESYNC_QUEUE_MAX];
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+    char payload[64 + SDS_MAX_NODE_ID_LEN];
+    
+    sds_platform_outbound_lock();
+    uint8_t count = _resync_count;
+    memcpy(pending, _resync_queue, count * sizeof(pending[0]));
+    _resync_count = 0;
+    sds_platform_outbound_unlock();
+    
+    for (uint8_t i = 0; i < count; i++) {
+        SdsTableContext* ctx = &_tables[pending[i].table];
+        if (!ctx->active || ctx->role != SDS_ROLE_OWNER) continue;
+        
+        SdsJsonWriter w;
+        sds_json_writer_init(&w, payload, sizeof(payload));
+        sds_json_start_object(&w);
+        sds_json_add_uint(&w, "ts", sds_platform_millis());
+        sds_json_add_string(&w, "from", _node_id);
+        sds_json_end_object(&w);
+        
+        snprintf(topic, sizeof(topic), "sds/%s/resync/%s", ctx->table_type, pending[i].node);
+        outbound_publish(topic, (const uint8_t*)payload, sds_json_get_length(&w), false, false);
+        SDS_LOG_D("Requested status keyframe from %s: %s", pending[i].node, ctx->table_type);
+    }
+}
+
+/* Check a status message's number against the device's slot */
+static void status_seq_check(SdsTableContext* ctx, const char* node_id, uint32_t* slot_seq,
+                             uint32_t seq, bool keyframe, bool ping) {
+    if (keyframe) {
+        *slot_seq = seq;
+        return;
+    }
+    
+    uint32_t expected = ping ? *slot_seq : status_seq_next(*slot_seq);
+    if (*slot_seq != 0 && seq == expected) {
+        *slot_seq = seq;
+        return;
+    }
+    
+    /* A known stream broke; an unknown one (new slot, restarted owner) just needs a keyframe */
+    if (*slot_seq != 0) {
+        stats_count(&_stats.seq_gaps, 1);
+        SDS_LOG_D("Status sequence gap from %s: got %u after %u (%s)", node_id,
+                  (unsigned)seq, (unsigned)*slot_seq, ctx->table_type);
+        *slot_seq = 0;
+    }
+    resync_request(ctx, node_id);
+}
+
+/* Device: an owner lost track of this node's status */
+static void handle_resync_message(SdsTableContext* ctx, const char* node_id) {
+    if (ctx->role != SDS_ROLE_DEVICE || strcmp(node_id, _node_id) != 0) return;
+    
+    ctx->status_resync = true;
+    SDS_LOG_D("Resync requested: %s", ctx->table_type);
+}
+
+static void handle_status_message(SdsTableContext* ctx, const char* from_node, SdsInbound* in) {
     if (ctx->role != SDS_ROLE_OWNER) return;
-    if (!ctx->deserialize_status) return;
     
-    /* Parse JSON to check schema version first */
-    SdsJsonReader r;
-    sds_json_reader_init(&r, (const char*)payload, len);
+    char remote_version[SDS_MAX_VERSION_LEN] = "";
+    bool msg_online = true;  /* Default to true */
+    uint32_t advertised_ms = 0;
+    uint32_t seq = 0;           /* 0 = unsequenced */
+    bool seq_keyframe = false;
+    bool seq_ping = false;
+    
+    if (in->binary) {
+        if (!ctx->status_fields || !in->header_ok) {
+            if (table_stats(ctx)) ctx->stats->decode_errors++;
+            SDS_LOG_W("Dropped undecodable binary status from %s: %s", from_node, ctx->table_type);
+            return;
+        }
+        snprintf(remote_version, sizeof(remote_version), "%s", in->hdr.origin);
+        msg_online = (in->hdr.flags & SDS_WIRE_FLAG_ONLINE) != 0;
+        advertised_ms = in->hdr.liveness_ms;
+        seq = in->hdr.seq;
+        seq_keyframe = (in->hdr.flags & SDS_WIRE_FLAG_DELTA) == 0;
+        seq_ping = (in->hdr.flags & SDS_WIRE_FLAG_PING) != 0;
+    } else {
+        if (!can_deserialize(ctx->deserialize_status, ctx->status_fields)) return;
+        
+        /* Envelope fields come from the same index the deserializer uses */
+        sds_json_get_string_field(&in->json, "sv", remote_version, sizeof(remote_version));
+        sds_json_get_bool_field(&in->json, "online", &msg_online);
+        sds_json_get_uint_field(&in->json, "lv", &advertised_ms);
+        if (sds_json_get_uint_field(&in->json, "kf", &seq)) {
+            seq_keyframe = true;
+        } else if (sds_json_get_uint_field(&in->json, "hb", &seq)) {
+            seq_ping = true;
+        } else {
+            sds_json_get_uint_field(&in->json, "sq", &seq);
+        }
+    }
     
     /* Check schema version */
-    char remote_version[SDS_MAX_VERSION_LEN] = "";
-    sds_json_get_string_field(&r, "sv", remote_version, sizeof(remote_version));
     
     if (remote_version[0] != '\0' && strcmp(remote_version, _schema_version) != 0) {
         /* Version mismatch detected */
@@ -1696,22 +7176,26 @@ static void handle_status_message(SdsTableContext* ctx, const char* from_node, c
     if (!slot) {
         /* Log and invoke callback anyway - slot might not be configured */
         SDS_LOG_D("Status from %s (no slot available): %s", from_node, ctx->table_type);
-        if (ctx->status_callback) {
-            ctx->status_callback(ctx->table_type, from_node, ctx->status_user_data);
-        }
+        deliver_callback(ctx, in, SDS_INBOUND_CB_STATUS, from_node);
         return;
     }
     
+    /* Slot writes from here to the sequence check are one seqlock write */
+    uint32_t slot_no = status_slot_number(ctx, (const uint8_t*)slot);
+    slot_write_begin(ctx, slot_no);
+    
     /* Update last_seen_ms on every status message */
     if (ctx->slot_last_seen_offset > 0) {
         uint32_t* slot_last_seen = (uint32_t*)((uint8_t*)slot + ctx->slot_last_seen_offset);
         *slot_last_seen = sds_platform_millis();
     }
     
-    /* Update online flag from the message (devices send online=true) */
-    bool msg_online = true;  /* Default to true */
-    sds_json_get_bool_field(&r, "online", &msg_online);
+    /* Devices with adaptive liveness may go this long between heartbeats */
+    if (slot_no < ctx->slot_liveness_cap) {
+        ctx->slot_liveness[slot_no] = advertised_ms;
+    }
     
+    /* Update online flag from the message (devices send online=true) */
     if (ctx->slot_online_offset > 0) {
         bool* slot_online = (bool*)((uint8_t*)slot + ctx->slot_online_offset);
         *slot_online = msg_online;
@@ -1730,13 +7214,53 @@ static void handle_status_message(SdsTableContext* ctx, const char* from_node, c
     void* status_ptr = (uint8_t*)slot + ctx->slot_status_offset;
     
     /* Deserialize status into the slot */
-    ctx->deserialize_status(status_ptr, &r);
+    if (in->binary) {
+        if (!wire_decode_section(&in->wire, in->hdr.flags, ctx->status_fields, ctx->status_field_count, status_ptr)) {
+            slot_write_end(ctx, slot_no);
+            if (table_stats(ctx)) ctx->stats->decode_errors++;
+            SDS_LOG_W("Dropped undecodable binary status from %s: %s", from_node, ctx->table_type);
+            return;
+        }
+    } else if (ctx->deserialize_status) {
+        ctx->deserialize_status(status_ptr, &in->json);
+    } else {
+        deserialize_fields(ctx->status_fields, ctx->status_field_count,
+                           section_keys(ctx, ctx->status_keys), status_ptr, &in->json);
+    }
     
-    SDS_LOG_D("Status updated from %s: %s", from_node, ctx->table_type);
+    if (seq != 0 && ctx->slot_seq_offset > 0) {
+        status_seq_check(ctx, from_node, (uint32_t*)((uint8_t*)slot + ctx->slot_seq_offset),
+                         seq, seq_keyframe, seq_ping);
+    }
+    slot_write_end(ctx, slot_no);
+    
+    if (ctx->history) {
+        history_record(ctx, slot_no, status_ptr, sds_platform_millis());
+    }
     
-    if (ctx->status_callback) {
-        ctx->status_callback(ctx->table_type, from_node, ctx->status_user_data);
+    if (_latency_tracking) {
+        uint32_t ts = 0;
+        uint32_t echo[2];
+        bool has_ts, has_echo;
+        if (in->binary) {
+            ts = in->hdr.ts;
+            echo[0] = in->hdr.clock[0];
+            echo[1] = in->hdr.clock[1];
+            has_ts = true;
+            has_echo = (in->hdr.flags & SDS_WIRE_FLAG_CLOCK) != 0;
+        } else {
+            has_ts = sds_json_get_uint_field(&in->json, "ts", &ts);
+            has_echo = sds_json_get_uint_field(&in->json, "cts", &echo[0]) &&
+                       sds_json_get_uint_field(&in->json, "crx", &echo[1]);
+        }
+        if (has_ts) {
+            latency_sample(ctx, (int32_t)slot_no, ts, has_echo ? echo : NULL, sds_platform_millis());
+        }
     }
+    
+    SDS_LOG_D("Status updated from %s: %s", from_node, ctx->table_type);
+    
+    deliver_callback(ctx, in, SDS_INBOUND_CB_STATUS, from_node);
 }
 
 /**
@@ -1762,99 +7286,274 @@ static void handle_lwt_message(const char* node_id, const uint8_t* payload, size
     
     SDS_LOG_I("Device offline (LWT): %s", node_id);
     
+    /* With workers, queued LWTs are applied by sds_loop() on the application thread */
+    bool defer = _inq_async && _callback_executor == SDS_CALLBACKS_LOOP;
+    
     /* Iterate through all owner tables and mark this device as offline */
-    for (int i = 0; i < SDS_MAX_TABLES; i++) {
+    for (int i = 0; i < _table_cap; i++) {
         SdsTableContext* ctx = &_tables[i];
         
         if (!ctx->active || ctx->role != SDS_ROLE_OWNER) {
             continue;
         }
         
-        if (ctx->status_slots_offset == 0 || ctx->max_status_slots == 0) {
-            continue;  /* No slots configured */
+        /* Look up the slot for this node_id (-1 if no slots are configured) */
+        table_lock(ctx);
+        int32_t slot_index = find_status_slot(ctx, node_id);
+        if (slot_index < 0) {
+            table_unlock(ctx);
+            continue;  /* Device not tracked in this table */
         }
         
-        /* Search for a slot with this node_id */
-        uint8_t* slots_base = (uint8_t*)ctx->table + ctx->status_slots_offset;
-        size_t valid_offset = ctx->slot_valid_offset ? ctx->slot_valid_offset : SDS_MAX_NODE_ID_LEN;
+        uint8_t* slot = status_slot_at(ctx, (uint32_t)slot_index);
+        
+        /* Its clock may restart before it returns */
+        latency_reset(ctx, (uint32_t)slot_index);
+        slot_write_begin(ctx, (uint32_t)slot_index);
+        
+        /* Found the device - mark as offline */
+        if (ctx->slot_online_offset > 0) {
+            bool* slot_online = (bool*)(slot + ctx->slot_online_offset);
+            *slot_online = false;
+            SDS_LOG_D("Marked %s offline in table %s", node_id, ctx->table_type);
+        }
+        
+        /* Update last_seen to track when we got the LWT */
+        uint32_t now = sds_platform_millis();
+        if (ctx->slot_last_seen_offset > 0) {
+            uint32_t* slot_last_seen = (uint32_t*)(slot + ctx->slot_last_seen_offset);
+            *slot_last_seen = now;
+        }
         
-        for (uint8_t j = 0; j < ctx->max_status_slots; j++) {
-            uint8_t* slot = slots_base + (j * ctx->status_slot_size);
-            char* slot_node_id = (char*)slot;
-            bool* slot_valid = (bool*)(slot + valid_offset);
+        /* Start eviction timer if global grace period is configured */
+        if (_eviction_grace_ms > 0 && ctx->slot_eviction_pending_offset > 0) {
+            bool* slot_eviction_pending = (bool*)(slot + ctx->slot_eviction_pending_offset);
+            *slot_eviction_pending = true;
             
-            if (*slot_valid && strcmp(slot_node_id, node_id) == 0) {
-                /* Found the device - mark as offline */
-                if (ctx->slot_online_offset > 0) {
-                    bool* slot_online = (bool*)(slot + ctx->slot_online_offset);
-                    *slot_online = false;
-                    SDS_LOG_D("Marked %s offline in table %s", node_id, ctx->table_type);
-                }
-                
-                /* Update last_seen to track when we got the LWT */
-                uint32_t now = sds_platform_millis();
-                if (ctx->slot_last_seen_offset > 0) {
-                    uint32_t* slot_last_seen = (uint32_t*)(slot + ctx->slot_last_seen_offset);
-                    *slot_last_seen = now;
-                }
-                
-                /* Start eviction timer if global grace period is configured */
-                if (_eviction_grace_ms > 0 && ctx->slot_eviction_pending_offset > 0) {
-                    bool* slot_eviction_pending = (bool*)(slot + ctx->slot_eviction_pending_offset);
-                    *slot_eviction_pending = true;
-                    
-                    if (ctx->slot_eviction_deadline_offset > 0) {
-                        uint32_t* slot_eviction_deadline = (uint32_t*)(slot + ctx->slot_eviction_deadline_offset);
-                        *slot_eviction_deadline = now + _eviction_grace_ms;
-                        SDS_LOG_D("Started eviction timer for %s (deadline: %u ms)", node_id, *slot_eviction_deadline);
-                    }
-                }
-                
-                /* Invoke status callback to notify application */
-                if (ctx->status_callback) {
-                    ctx->status_callback(ctx->table_type, node_id, ctx->status_user_data);
-                }
-                
-                break;  /* Found in this table, move to next table */
+            if (ctx->slot_eviction_deadline_offset > 0) {
+                uint32_t* slot_eviction_deadline = (uint32_t*)(slot + ctx->slot_eviction_deadline_offset);
+                *slot_eviction_deadline = now + _eviction_grace_ms;
+                /* The timer heap belongs to sds_loop(); this may be the receive thread */
+                atomic_store_explicit(&ctx->eviction_rearm, true, memory_order_release);
+                SDS_LOG_D("Started eviction timer for %s (deadline: %u ms)", node_id, *slot_eviction_deadline);
             }
         }
+        slot_write_end(ctx, (uint32_t)slot_index);
+        
+        /* Notify the application, after unlocking under SDS_CALLBACKS_LOOP like deferred callbacks */
+        if (!defer) {
+            run_callback(ctx, SDS_INBOUND_CB_STATUS, node_id);
+        }
+        table_unlock(ctx);
+        if (defer && ctx->active) {
+            run_callback(ctx, SDS_INBOUND_CB_STATUS, node_id);
+        }
     }
 }
 
-static void on_mqtt_message(const char* topic, const uint8_t* payload, size_t payload_len) {
-    _stats.messages_received++;
+/* ============== Config Cache ============== */
+
+/*
+ * With SdsConfig.enable_config_cache, a device saves each config payload
+ * it applies under "{node_id}/{table_type}" with sds_platform_storage_save():
+ *
+ *   u8 magic, u8 version, u16 config_size, u32 payload hash (FNV-1a),
+ *   schema version (varint length + bytes), payload
+ *
+ * At registration the record is replayed through handle_config_message(),
+ * so the table starts from the last config without waiting for the broker.
+ * Records for another schema version or section size are ignored. A config
+ * message whose payload hash equals the applied one is not parsed again;
+ * the first one after a restore still runs the config callback.
+ */
+
+#define SDS_CACHE_MAGIC       0xC5
+#define SDS_CACHE_VERSION     1
+#define SDS_CACHE_RECORD_MAX  (8 + 1 + SDS_MAX_VERSION_LEN + SDS_MSG_BUFFER_SIZE)
+
+/* FNV-1a, 32-bit */
+static uint32_t hash_payload(const uint8_t* payload, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= payload[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void config_cache_key(const SdsTableContext* ctx, char* key, size_t size) {
+    snprintf(key, size, "%s/%s", _node_id, ctx->table_type);
+}
+
+static void config_cache_save(SdsTableContext* ctx, const uint8_t* payload, size_t len, uint32_t hash) {
+    uint8_t record[SDS_CACHE_RECORD_MAX];
+    SdsWireWriter w = { record, sizeof(record), 0, false };
+    wire_put_u8(&w, SDS_CACHE_MAGIC);
+    wire_put_u8(&w, SDS_CACHE_VERSION);
+    wire_put_le(&w, (uint32_t)ctx->config_size, 2);
+    wire_put_le(&w, hash, 4);
+    wire_put_str(&w, _schema_version, SDS_MAX_VERSION_LEN);
+    wire_put(&w, payload, len);
+    if (w.error) {
+        SDS_LOG_W("Config too large to cache: %s", ctx->table_type);
+        return;
+    }
     
-    SDS_LOG_D("Message: topic=%s len=%zu", topic, payload_len);
+    char key[SDS_MAX_NODE_ID_LEN + SDS_MAX_TABLE_TYPE_LEN + 1];
+    config_cache_key(ctx, key, sizeof(key));
+    if (!sds_platform_storage_save(key, record, w.len)) {
+        SDS_LOG_W("Failed to cache config: %s", ctx->table_type);
+    }
+}
+
+static void config_cache_restore(SdsTableContext* ctx) {
+    if (!_config_cache || ctx->role != SDS_ROLE_DEVICE || ctx->config_size == 0 ||
+        ctx->config_hash_valid) {
+        return;
+    }
     
-    /* Check if this is a raw subscription (non-sds/ topics) */
-    if (strncmp(topic, "sds/", 4) != 0) {
-        /* Route to raw subscription callbacks */
-        for (uint8_t i = 0; i < SDS_MAX_RAW_SUBSCRIPTIONS; i++) {
-            if (_raw_subs[i].active && mqtt_topic_matches(_raw_subs[i].topic, topic)) {
-                SDS_LOG_D("Raw message matched subscription: %s", _raw_subs[i].topic);
-                _raw_subs[i].callback(topic, payload, payload_len, _raw_subs[i].user_data);
-                /* Continue to check other subscriptions (topic could match multiple patterns) */
-            }
-        }
+    char key[SDS_MAX_NODE_ID_LEN + SDS_MAX_TABLE_TYPE_LEN + 1];
+    config_cache_key(ctx, key, sizeof(key));
+    uint8_t record[SDS_CACHE_RECORD_MAX];
+    size_t len = sds_platform_storage_load(key, record, sizeof(record));
+    if (len == 0) {
         return;
     }
     
-    /* Handle LWT messages: sds/lwt/{node_id} */
-    if (strncmp(topic + 4, "lwt/", 4) == 0) {
-        const char* node_id = topic + 8;  /* After "sds/lwt/" */
-        if (node_id[0] != '\0') {
-            handle_lwt_message(node_id, payload, payload_len);
-        }
+    SdsWireReader r = { record, len, 0, false };
+    uint8_t magic = wire_get_u8(&r);
+    uint8_t version = wire_get_u8(&r);
+    uint32_t config_size = wire_get_le(&r, 2);
+    uint32_t hash = wire_get_le(&r, 4);
+    uint32_t sv_len = wire_get_varint(&r);
+    if (r.error || magic != SDS_CACHE_MAGIC || version != SDS_CACHE_VERSION ||
+        sv_len >= SDS_MAX_VERSION_LEN || sv_len >= len - r.pos) {
+        SDS_LOG_W("Ignoring invalid cached config: %s", ctx->table_type);
+        return;
+    }
+    char schema_version[SDS_MAX_VERSION_LEN];
+    memcpy(schema_version, record + r.pos, sv_len);
+    schema_version[sv_len] = '\0';
+    const uint8_t* payload = record + r.pos + sv_len;
+    size_t payload_len = len - r.pos - sv_len;
+    
+    if (strcmp(schema_version, _schema_version) != 0 || config_size != ctx->config_size) {
+        SDS_LOG_I("Cached config is for another schema (%s), ignoring: %s",
+                  schema_version, ctx->table_type);
+        return;
+    }
+    if (hash_payload(payload, payload_len) != hash) {
+        SDS_LOG_W("Ignoring corrupt cached config: %s", ctx->table_type);
         return;
     }
     
-    /* Extract table_type */
-    const char* table_start = topic + 4;
-    const char* table_end = strchr(table_start, '/');
-    if (!table_end) return;
+    SdsInbound in;
+    in.start_us = stats_clock();
+    in.deferred = NULL;
+    inbound_parse(&in, payload, payload_len);
+    if (!handle_config_message(ctx, &in, false)) {
+        return;
+    }
     
-    char table_type[SDS_MAX_TABLE_TYPE_LEN];
-    size_t table_len = table_end - table_start;
+    /* The cached "ts" is stale; the clock reference waits for the live config */
+    ctx->clock_ref_valid = false;
+    ctx->config_hash = hash;
+    ctx->config_hash_valid = true;
+    ctx->config_restored = true;
+    stats_count(&_stats.config_cache_restored, 1);
+    SDS_LOG_I("Config restored from cache: %s", ctx->table_type);
+}
+
+/**
+ * Apply a table message.
+ * 
+ * @param section Topic after "sds/{table_type}/"
+ * @param deferred Queued message to record callbacks in (NULL = invoke them)
+ */
+static void dispatch_table_message(SdsTableContext* ctx, const char* section,
+                                   const uint8_t* payload, size_t payload_len,
+                                   SdsInboundMsg* deferred) {
+    const char* status_node = NULL;
+    
+    if (strncmp(section, "resync/", 7) == 0) {
+        handle_resync_message(ctx, section + 7);
+        return;
+    }
+    
+    bool config_delta = strcmp(section, "config/delta") == 0;
+    if (!config_delta && strcmp(section, "config") != 0 && strcmp(section, "state") != 0) {
+        if (strncmp(section, "status/", 7) != 0 || section[7] == '\0') return;
+        status_node = section + 7;
+    }
+    
+    SdsTableStats* st = table_stats(ctx);
+    if (st) {
+        st->messages_received++;
+        st->bytes_received += (uint32_t)payload_len;
+    }
+    
+    SdsInbound in;
+    in.start_us = stats_clock();
+    in.deferred = deferred;
+    
+    /* A config identical to the applied one needs no parsing */
+    bool is_config = !status_node && section[1] == 'o';  /* "config", "config/delta" */
+    bool cache_config = is_config && !config_delta && _config_cache && ctx->role == SDS_ROLE_DEVICE;
+    uint32_t config_hash = 0;
+    if (cache_config) {
+        config_hash = hash_payload(payload, payload_len);
+        /* After a restore, latency tracking still needs the live receive time */
+        if (ctx->config_hash_valid && config_hash == ctx->config_hash &&
+            !(ctx->config_restored && _latency_tracking)) {
+            stats_count(&_stats.config_unchanged, 1);
+            SDS_LOG_D("Config unchanged: %s", ctx->table_type);
+            if (ctx->config_restored) {
+                ctx->config_restored = false;
+                deliver_callback(ctx, &in, SDS_INBOUND_CB_CONFIG, NULL);
+            }
+            return;
+        }
+    }
+    
+    /* Parse the payload once; handlers share the result */
+    inbound_parse(&in, payload, payload_len);
+    
+    if (status_node) {
+        handle_status_message(ctx, status_node, &in);
+        
+    } else if (is_config) {
+        if (handle_config_message(ctx, &in, config_delta) && cache_config) {
+            if (!ctx->config_hash_valid || config_hash != ctx->config_hash) {
+                config_cache_save(ctx, payload, payload_len, config_hash);
+            }
+            ctx->config_hash = config_hash;
+            ctx->config_hash_valid = true;
+            ctx->config_restored = false;
+        }
+        
+    } else {  /* "state" */
+        /* Node comes from the binary header or the JSON "node" field */
+        char from_node[SDS_MAX_NODE_ID_LEN] = "";
+        if (in.binary) {
+            if (in.header_ok) {
+                memcpy(from_node, in.hdr.origin, sizeof(from_node));
+            }
+        } else {
+            sds_json_get_string_field(&in.json, "node", from_node, sizeof(from_node));
+        }
+        
+        handle_state_message(ctx, from_node, &in);
+    }
+}
+
+/* Route a message on sds/{table_type}/... to its table */
+static void route_table_message(const char* topic, const uint8_t* payload, size_t payload_len) {
+    /* Route on the table level: sds/{table_type}/... */
+    const char* table_start = topic + 4;
+    size_t table_len;
+    uint32_t table_hash = hash_topic_level(table_start, &table_len);
+    const char* table_end = table_start + table_len;
+    if (*table_end != '/') return;
     
     /* Validate table_type length */
     if (table_len == 0) {
@@ -1866,31 +7565,101 @@ static void on_mqtt_message(const char* topic, const uint8_t* payload, size_t pa
         return;
     }
     
-    strncpy(table_type, table_start, table_len);
-    table_type[table_len] = '\0';
+    /* Status of another cluster member's device: drop before queueing or parsing */
+    if (_cluster_members > 1 && strncmp(table_end + 1, "status/", 7) == 0 &&
+        !cluster_owns(table_end + 8)) {
+        return;
+    }
     
-    SdsTableContext* ctx = find_table(table_type);
+    if (_inq_depth > 0) {
+        inbound_enqueue(topic, table_start, table_len, table_hash, payload, payload_len);
+        return;
+    }
+    
+    SdsTableContext* ctx = route_lookup(table_start, table_len, table_hash);
     if (!ctx) {
-        SDS_LOG_D("Message for unregistered table: %s", table_type);
+        SDS_LOG_D("Message for unregistered table: %.*s", (int)table_len, table_start);
         return;
     }
     
-    const char* section = table_end + 1;
+    dispatch_table_message(ctx, table_end + 1, payload, payload_len, NULL);
+}
+
+/**
+ * Unpack a batch envelope (see Batch Envelope) and route each record as if
+ * it had arrived on its own topic. Stops at the first malformed record.
+ */
+static void handle_batch_message(const uint8_t* payload, size_t len) {
+    SdsWireReader r = { payload, len, 0, false };
+    char topic[SDS_TOPIC_BUFFER_SIZE] = "sds/";
+    
+    if (wire_get_u8(&r) != SDS_BATCH_MAGIC || wire_get_u8(&r) != SDS_BATCH_VERSION) {
+        SDS_LOG_D("Ignoring batch with unknown format");
+        return;
+    }
     
-    if (strncmp(section, "config", 6) == 0) {
-        handle_config_message(ctx, payload, payload_len);
-        
-    } else if (strncmp(section, "state", 5) == 0) {
-        /* Extract node from JSON payload */
-        SdsJsonReader r;
-        sds_json_reader_init(&r, (const char*)payload, payload_len);
-        char from_node[SDS_MAX_NODE_ID_LEN] = "";
-        sds_json_get_string_field(&r, "node", from_node, sizeof(from_node));
-        
-        handle_state_message(ctx, from_node, payload, payload_len);
+    while (r.pos < r.len) {
+        size_t name_len, record_len;
+        const uint8_t* name = wire_get_span(&r, &name_len);
+        const uint8_t* record = wire_get_span(&r, &record_len);
+        if (r.error) {
+            SDS_LOG_D("Truncated batch (%zu bytes)", len);
+            return;
+        }
+        if (name_len >= sizeof(topic) - 4 || memchr(name, '\0', name_len)) {
+            continue;
+        }
         
-    } else if (strncmp(section, "status/", 7) == 0) {
-        const char* from_node = section + 7;
-        handle_status_message(ctx, from_node, payload, payload_len);
+        memcpy(topic + 4, name, name_len);
+        topic[4 + name_len] = '\0';
+        route_table_message(topic, record, record_len);
+    }
+}
+
+static void receive_message(const char* topic, const uint8_t* payload, size_t payload_len) {
+    stats_count(&_stats.messages_received, 1);
+    
+    SDS_LOG_D("Message: topic=%s len=%zu", topic, payload_len);
+    
+    /* Check if this is a raw subscription (non-sds/ topics) */
+    if (strncmp(topic, "sds/", 4) != 0) {
+        /* Route to every matching raw subscription */
+        raw_dispatch(topic, payload, payload_len);
+        return;
+    }
+    
+    /* Handle LWT messages: sds/lwt/{node_id} */
+    if (strncmp(topic + 4, "lwt/", 4) == 0) {
+        const char* node_id = topic + 8;  /* After "sds/lwt/" */
+        if (node_id[0] == '\0' || !cluster_owns(node_id)) {
+            return;
+        }
+        if (_inq_depth > 0) {
+            inbound_enqueue(topic, NULL, 0, 0, payload, payload_len);
+        } else {
+            handle_lwt_message(node_id, payload, payload_len);
+        }
+        return;
+    }
+    
+    /* Handle batch envelopes: sds/batch/{node_id} */
+    if (strncmp(topic + 4, "batch/", 6) == 0) {
+        /* Every record of an envelope comes from the node in its topic */
+        if (cluster_owns(topic + 10)) {
+            handle_batch_message(payload, payload_len);
+        }
+        return;
+    }
+    
+    route_table_message(topic, payload, payload_len);
+}
+
+/* Platform receive callback; wakes the application once the message is in */
+static void on_mqtt_message(const char* topic, const uint8_t* payload, size_t payload_len) {
+    receive_message(topic, payload, payload_len);
+    
+    SdsWakeCallback wake = _wake_callback;
+    if (wake) {
+        wake(_wake_user_data);
     }
 }
@@ -4,11 +4,8 @@
 
 #include "sds_json.h"
 #include <string.h>
-#include <stdio.h>
-#include <stdlib.h>
 #include <ctype.h>
-#include <limits.h>
-#include <errno.h>
+#include <math.h>
 
 /* ============== JSON Writer ============== */
 
@@ -125,58 +122,337 @@ void sds_json_end_object(SdsJsonWriter* w) {
     json_append_char(w, '}');
 }
 
-void sds_json_add_string(SdsJsonWriter* w, const char* key, const char* value) {
+static void json_append_n(SdsJsonWriter* w, const char* str, size_t len) {
+    if (w->error) return;
+    
+    if (w->pos + len >= w->size) {
+        w->error = true;
+        return;
+    }
+    
+    memcpy(w->buffer + w->pos, str, len);
+    w->pos += len;
+    w->buffer[w->pos] = '\0';
+}
+
+static void json_append_key(SdsJsonWriter* w, const char* key) {
     if (needs_comma(w)) json_append_char(w, ',');
     json_append_char(w, '"');
     json_append(w, key);  /* Keys don't need escaping - they're from code */
-    json_append(w, "\":\"");
+    json_append(w, "\":");
+}
+
+size_t sds_json_key_fragment(const char* key, char* out, size_t out_size) {
+    if (!key || !out || out_size == 0) return 0;
+    
+    SdsJsonWriter w;
+    sds_json_writer_init(&w, out, out_size);
+    json_append_char(&w, '"');
+    json_append_escaped(&w, key);
+    json_append(&w, "\":");
+    if (w.error) {
+        out[0] = '\0';
+        return 0;
+    }
+    return w.pos;
+}
+
+void sds_json_add_key(SdsJsonWriter* w, const char* fragment, size_t fragment_len) {
+    if (needs_comma(w)) json_append_char(w, ',');
+    json_append_n(w, fragment, fragment_len);
+}
+
+void sds_json_write_string(SdsJsonWriter* w, const char* value) {
+    json_append_char(w, '"');
     json_append_escaped(w, value);  /* Values need escaping - they're user data */
     json_append_char(w, '"');
 }
 
-void sds_json_add_int(SdsJsonWriter* w, const char* key, int32_t value) {
-    if (needs_comma(w)) json_append_char(w, ',');
+/* ============== Number Formatting ============== */
+
+/*
+ * Numbers are formatted and parsed here instead of with snprintf/strtof:
+ * those are slow on targets without a double FPU, depend on the C
+ * locale's decimal point, and "%.4f" both pads values with zeros and
+ * drops the digits of small ones.
+ */
+
+/* Longest number written: "-1.2345678e-45" or 20 integer digits */
+#define NUM_BUF_SIZE 32
+
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809" "10111213141516171819"
+    "20212223242526272829" "30313233343536373839"
+    "40414243444546474849" "50515253545556575859"
+    "60616263646566676869" "70717273747576777879"
+    "80818283848586878889" "90919293949596979899";
+
+static const double POW10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const uint32_t POW10_U32[] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u,
+    100000000u, 1000000000u
+};
+
+/**
+ * Write the decimal digits of v so they end just before end.
+ * Two digits per division; 64-bit division only while v needs it.
+ * Returns a pointer to the first digit.
+ */
+static char* format_digits(char* end, uint64_t v) {
+    while (v > UINT32_MAX) {
+        unsigned i = (unsigned)(v % 100) * 2;
+        v /= 100;
+        *--end = DIGIT_PAIRS[i + 1];
+        *--end = DIGIT_PAIRS[i];
+    }
+    uint32_t u = (uint32_t)v;
+    while (u >= 100) {
+        unsigned i = (u % 100) * 2;
+        u /= 100;
+        *--end = DIGIT_PAIRS[i + 1];
+        *--end = DIGIT_PAIRS[i];
+    }
+    if (u >= 10) {
+        *--end = DIGIT_PAIRS[u * 2 + 1];
+        *--end = DIGIT_PAIRS[u * 2];
+    } else {
+        *--end = (char)('0' + u);
+    }
+    return end;
+}
+
+/** x * 10^e (exact when x is an integer up to 2^53 and |e| <= 22) */
+static double scale_pow10(double x, int e) {
+    while (e > 22) { x *= 1e22; e -= 22; }
+    while (e < -22) { x /= 1e22; e += 22; }
+    return e >= 0 ? x * POW10[e] : x / POW10[-e];
+}
+
+/**
+ * Convert mantissa * 10^e10 to a float.
+ * Returns false if the result is beyond the float range.
+ */
+static bool decimal_to_float(uint64_t mantissa, int e10, float* out) {
+    if (mantissa == 0 || e10 < -66) {       /* Below half of FLT_TRUE_MIN */
+        *out = 0.0f;
+        return true;
+    }
+    if (e10 > 39) return false;
+    double d = scale_pow10((double)mantissa, e10);
+    if (d >= 3.4028235677973366e38) return false;  /* Rounds past FLT_MAX */
+    *out = (float)d;
+    return true;
+}
+
+/**
+ * Write q / 10^decimals with trailing fractional zeros dropped.
+ * Returns the length written to out (at least NUM_BUF_SIZE bytes).
+ */
+static size_t format_fixed(char* out, uint64_t q, int decimals) {
+    while (decimals > 0 && q % 10 == 0) {
+        q /= 10;
+        decimals--;
+    }
     
-    char num[16];
-    snprintf(num, sizeof(num), "%d", value);
+    char tmp[24];
+    char* end = tmp + sizeof(tmp);
+    char* digits = format_digits(end, q);
+    size_t len = (size_t)(end - digits);
+    size_t n = 0;
     
-    json_append_char(w, '"');
-    json_append(w, key);
-    json_append(w, "\":");
-    json_append(w, num);
+    if (decimals == 0) {
+        memcpy(out, digits, len);
+        return len;
+    }
+    if (len <= (size_t)decimals) {
+        out[n++] = '0';
+        out[n++] = '.';
+        for (size_t i = len; i < (size_t)decimals; i++) out[n++] = '0';
+        memcpy(out + n, digits, len);
+        return n + len;
+    }
+    size_t int_len = len - (size_t)decimals;
+    memcpy(out, digits, int_len);
+    out[int_len] = '.';
+    memcpy(out + int_len + 1, digits + int_len, (size_t)decimals);
+    return len + 1;
 }
 
-void sds_json_add_uint(SdsJsonWriter* w, const char* key, uint32_t value) {
-    if (needs_comma(w)) json_append_char(w, ',');
+/**
+ * Find the shortest decimal d * 10^(e - count + 1), first digit at 10^e,
+ * that converts back to x (finite and positive): tries 1 to 9
+ * significant digits, 9 always being enough for a float.
+ */
+static void float_shortest(float x, uint32_t* digits, int* count, int* e) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    int e2 = (int)((bits >> 23) & 0xFF) - 127;
+    double xd = (double)x;
     
-    char num[16];
-    snprintf(num, sizeof(num), "%u", value);
+    /* Decimal exponent of the first digit: estimate from the binary one */
+    int e10 = e2 * 30103 / 100000;
+    while (e10 > -46 && scale_pow10(1.0, e10) > xd) e10--;
+    while (scale_pow10(1.0, e10 + 1) <= xd) e10++;
     
-    json_append_char(w, '"');
-    json_append(w, key);
-    json_append(w, "\":");
-    json_append(w, num);
+    uint32_t d = 0;
+    int p;
+    int de = e10;
+    for (p = 1; p <= 9; p++) {
+        d = (uint32_t)(scale_pow10(xd, p - 1 - e10) + 0.5);
+        de = e10;
+        if (d >= POW10_U32[p]) {        /* Rounded up into another digit */
+            d /= 10;
+            de++;
+        }
+        float back;
+        if (decimal_to_float(d, de - p + 1, &back) && back == x) break;
+    }
+    if (p > 9) p = 9;
+    
+    while (p > 1 && d % 10 == 0) {
+        d /= 10;
+        p--;
+    }
+    *digits = d;
+    *count = p;
+    *e = de;
 }
 
-void sds_json_add_float(SdsJsonWriter* w, const char* key, float value) {
-    if (needs_comma(w)) json_append_char(w, ',');
+/**
+ * Format a finite float in its shortest round-trip form: fixed notation
+ * for 1e-4 <= |x| < 1e9, otherwise d.ddde[-]x (as "%.9g" would, without
+ * the surplus digits). Returns the length written.
+ */
+static size_t format_float_shortest(char* out, float value) {
+    size_t n = 0;
+    if (value < 0.0f) {
+        out[n++] = '-';
+        value = -value;
+    }
+    if (value == 0.0f) {
+        out[0] = '0';          /* Also for -0 */
+        return 1;
+    }
     
-    char num[32];
-    snprintf(num, sizeof(num), "%.4f", value);
+    uint32_t d;
+    int p, e;
+    float_shortest(value, &d, &p, &e);
     
-    json_append_char(w, '"');
-    json_append(w, key);
-    json_append(w, "\":");
-    json_append(w, num);
+    if (e >= -4 && e < 9) {
+        int decimals = p - 1 - e;
+        if (decimals >= 0) {
+            return n + format_fixed(out + n, d, decimals);
+        }
+        n += format_fixed(out + n, d, 0);
+        for (int i = 0; i < -decimals; i++) out[n++] = '0';
+        return n;
+    }
+    
+    char tmp[12];
+    char* end = tmp + sizeof(tmp);
+    char* digits = format_digits(end, d);
+    out[n++] = digits[0];
+    if (p > 1) {
+        out[n++] = '.';
+        memcpy(out + n, digits + 1, (size_t)(p - 1));
+        n += (size_t)(p - 1);
+    }
+    out[n++] = 'e';
+    if (e < 0) {
+        out[n++] = '-';
+        e = -e;
+    }
+    digits = format_digits(end, (uint64_t)e);
+    memcpy(out + n, digits, (size_t)(end - digits));
+    return n + (size_t)(end - digits);
 }
 
-void sds_json_add_bool(SdsJsonWriter* w, const char* key, bool value) {
-    if (needs_comma(w)) json_append_char(w, ',');
+void sds_json_write_int(SdsJsonWriter* w, int32_t value) {
+    char num[12];
+    char* end = num + sizeof(num);
+    uint32_t mag = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    char* start = format_digits(end, mag);
+    if (value < 0) *--start = '-';
+    json_append_n(w, start, (size_t)(end - start));
+}
+
+void sds_json_write_uint(SdsJsonWriter* w, uint32_t value) {
+    char num[12];
+    char* end = num + sizeof(num);
+    char* start = format_digits(end, value);
+    json_append_n(w, start, (size_t)(end - start));
+}
+
+void sds_json_write_float(SdsJsonWriter* w, float value) {
+    if (!isfinite(value)) {
+        json_append_n(w, "null", 4);   /* JSON has no NaN or infinity */
+        return;
+    }
+    char num[NUM_BUF_SIZE];
+    json_append_n(w, num, format_float_shortest(num, value));
+}
+
+void sds_json_write_float_fixed(SdsJsonWriter* w, float value, uint8_t decimals) {
+    if (!isfinite(value)) {
+        json_append_n(w, "null", 4);
+        return;
+    }
+    if (decimals > SDS_JSON_MAX_DECIMALS) decimals = SDS_JSON_MAX_DECIMALS;
     
-    json_append_char(w, '"');
-    json_append(w, key);
-    json_append(w, "\":");
-    json_append(w, value ? "true" : "false");
+    double scaled = (double)(value < 0.0f ? -value : value) * POW10[decimals];
+    if (scaled >= 1e18) {           /* Would not fit the integer path */
+        sds_json_write_float(w, value);
+        return;
+    }
+    
+    char num[NUM_BUF_SIZE];
+    size_t n = 0;
+    uint64_t q = (uint64_t)(scaled + 0.5);
+    if (value < 0.0f && q != 0) num[n++] = '-';
+    n += format_fixed(num + n, q, decimals);
+    json_append_n(w, num, n);
+}
+
+void sds_json_write_bool(SdsJsonWriter* w, bool value) {
+    if (value) {
+        json_append_n(w, "true", 4);
+    } else {
+        json_append_n(w, "false", 5);
+    }
+}
+
+void sds_json_add_string(SdsJsonWriter* w, const char* key, const char* value) {
+    json_append_key(w, key);
+    sds_json_write_string(w, value);
+}
+
+void sds_json_add_int(SdsJsonWriter* w, const char* key, int32_t value) {
+    json_append_key(w, key);
+    sds_json_write_int(w, value);
+}
+
+void sds_json_add_uint(SdsJsonWriter* w, const char* key, uint32_t value) {
+    json_append_key(w, key);
+    sds_json_write_uint(w, value);
+}
+
+void sds_json_add_float(SdsJsonWriter* w, const char* key, float value) {
+    json_append_key(w, key);
+    sds_json_write_float(w, value);
+}
+
+void sds_json_add_float_fixed(SdsJsonWriter* w, const char* key, float value, uint8_t decimals) {
+    json_append_key(w, key);
+    sds_json_write_float_fixed(w, value, decimals);
+}
+
+void sds_json_add_bool(SdsJsonWriter* w, const char* key, bool value) {
+    json_append_key(w, key);
+    sds_json_write_bool(w, value);
 }
 
 const char* sds_json_get_string(SdsJsonWriter* w) {
@@ -197,6 +473,10 @@ void sds_json_reader_init(SdsJsonReader* r, const char* json, size_t len) {
     r->json = json;
     r->len = len;
     r->pos = 0;
+    r->index = NULL;
+    r->index_cap = 0;
+    r->index_count = 0;
+    r->index_state = SDS_JSON_INDEX_NONE;
 }
 
 static void skip_whitespace(const char** p, const char* end) {
@@ -205,14 +485,256 @@ static void skip_whitespace(const char** p, const char* end) {
     }
 }
 
+/**
+ * Skip a string token starting at its opening quote.
+ * Leaves *p just past the closing quote. Returns false if unterminated.
+ */
+static bool skip_string(const char** p, const char* end) {
+    const char* s = *p + 1;
+    while (s < end && *s != '"') {
+        if (*s == '\\') s++;   /* Skip escaped character */
+        s++;
+    }
+    if (s >= end) return false;
+    *p = s + 1;
+    return true;
+}
+
+/**
+ * Skip one JSON value (string, object, array or scalar).
+ * Leaves *p at the first character after the value.
+ */
+static bool skip_value(const char** p, const char* end) {
+    const char* s = *p;
+    if (s >= end) return false;
+    
+    if (*s == '"') {
+        return skip_string(p, end);
+    }
+    
+    if (*s == '{' || *s == '[') {
+        int depth = 0;
+        while (s < end) {
+            if (*s == '"') {
+                if (!skip_string(&s, end)) return false;
+                continue;
+            }
+            if (*s == '{' || *s == '[') {
+                depth++;
+            } else if (*s == '}' || *s == ']') {
+                if (--depth == 0) {
+                    *p = s + 1;
+                    return true;
+                }
+            }
+            s++;
+        }
+        return false;
+    }
+    
+    /* Scalar: number, true, false, null */
+    while (s < end && *s != ',' && *s != '}' && *s != ']' &&
+           !isspace((unsigned char)*s)) {
+        s++;
+    }
+    if (s == *p) return false;
+    *p = s;
+    return true;
+}
+
+/**
+ * Tokenize one member, starting after the '{' or ',' before it.
+ * Leaves *p after the ',' that follows it, or at the closing '}'.
+ * 
+ * @return 1 for a member, 0 at the end of the object, -1 if malformed
+ */
+static int next_member(const char** p, const char* end, SdsJsonMember* m) {
+    skip_whitespace(p, end);
+    if (*p >= end) return -1;
+    if (**p == '}') return 0;
+    if (**p != '"') return -1;
+    
+    m->key = *p + 1;
+    if (!skip_string(p, end)) return -1;
+    m->key_len = (size_t)(*p - m->key) - 1;
+    
+    skip_whitespace(p, end);
+    if (*p >= end || **p != ':') return -1;
+    (*p)++;
+    skip_whitespace(p, end);
+    
+    m->value = *p;
+    if (!skip_value(p, end)) return -1;
+    
+    skip_whitespace(p, end);
+    if (*p >= end) return -1;
+    if (**p == ',') {
+        (*p)++;
+    } else if (**p != '}') {
+        return -1;
+    }
+    return 1;
+}
+
+/* Whether an indexed span already holds this key */
+static bool index_has_key(const SdsJsonReader* r, const char* key, size_t key_len) {
+    for (uint16_t i = 0; i < r->index_count; i++) {
+        const SdsJsonSpan* span = &r->index[i];
+        if (span->key_len == key_len && memcmp(r->json + span->key, key, key_len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Tokenize the top-level object into r->index.
+ * Repeated keys keep their first occurrence, which the linear scan finds.
+ * On malformed input the index is discarded and the reader scans.
+ */
+static bool build_index(SdsJsonReader* r) {
+    const char* p = r->json;
+    const char* end = r->json + r->len;
+    SdsJsonMember m;
+    uint64_t seen = 0;      /* Key length and edge characters: most keys skip the duplicate check */
+    
+    skip_whitespace(&p, end);
+    if (p >= end || *p != '{') return false;
+    p++;
+    
+    while (true) {
+        int rc = next_member(&p, end, &m);
+        if (rc <= 0) return rc == 0;
+        
+        uint64_t bit = m.key_len
+            ? 1ull << ((m.key_len * 31u + (uint8_t)m.key[0] + (uint8_t)m.key[m.key_len - 1]) & 63u)
+            : 1ull;
+        if ((seen & bit) && index_has_key(r, m.key, m.key_len)) {
+            continue;
+        }
+        seen |= bit;
+        
+        if (r->index_count < r->index_cap) {
+            SdsJsonSpan* span = &r->index[r->index_count++];
+            span->key = (uint16_t)(m.key - r->json);
+            span->key_len = (uint16_t)m.key_len;
+            span->value = (uint16_t)(m.value - r->json);
+        } else {
+            /* Leave the rest of the object to the fallback scan */
+            r->index_state = SDS_JSON_INDEX_TRUNCATED;
+            return true;
+        }
+    }
+}
+
+bool sds_json_reader_init_indexed(SdsJsonReader* r, const char* json, size_t len,
+                                  SdsJsonSpan* spans, uint16_t span_count) {
+    sds_json_reader_init(r, json, len);
+    if (!json || len == 0 || len > UINT16_MAX || !spans || span_count == 0) {
+        return false;
+    }
+    
+    r->index = spans;
+    r->index_cap = span_count;
+    r->index_state = SDS_JSON_INDEX_COMPLETE;
+    if (!build_index(r)) {
+        r->index_count = 0;
+        r->index_state = SDS_JSON_INDEX_NONE;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Look up a key in the index, starting at the span after the previous hit
+ * so that in-order lookups (as generated deserializers do) match first try.
+ */
+static const char* find_indexed(SdsJsonReader* r, const char* key, size_t key_len) {
+    uint16_t count = r->index_count;
+    size_t start = (r->pos < count) ? r->pos : 0;
+    
+    for (uint16_t n = 0; n < count; n++) {
+        size_t i = start + n;
+        if (i >= count) i -= count;
+        
+        const SdsJsonSpan* span = &r->index[i];
+        if (span->key_len == key_len &&
+            memcmp(r->json + span->key, key, key_len) == 0) {
+            r->pos = i + 1;
+            return r->json + span->value;
+        }
+    }
+    return NULL;
+}
+
+void sds_json_iter_init(SdsJsonIter* it, SdsJsonReader* r) {
+    it->r = r;
+    it->span = 0;
+    it->p = NULL;
+}
+
+bool sds_json_iter_next(SdsJsonIter* it, SdsJsonMember* m) {
+    SdsJsonReader* r = it->r;
+    if (!r->json || r->len == 0) return false;
+    const char* end = r->json + r->len;
+    
+    if (r->index_state != SDS_JSON_INDEX_NONE) {
+        if (it->span < r->index_count) {
+            const SdsJsonSpan* span = &r->index[it->span++];
+            m->key = r->json + span->key;
+            m->key_len = span->key_len;
+            m->value = r->json + span->value;
+            return true;
+        }
+        if (r->index_state == SDS_JSON_INDEX_COMPLETE) return false;
+    }
+    
+    if (!it->p) {
+        const char* p = r->json;
+        if (r->index_state == SDS_JSON_INDEX_TRUNCATED) {
+            /* Resume after the last indexed member (build_index checked its ',') */
+            p = r->json + r->index[r->index_count - 1].value;
+            skip_value(&p, end);
+            skip_whitespace(&p, end);
+        } else {
+            skip_whitespace(&p, end);
+            if (p >= end || *p != '{') {
+                it->p = end;
+                return false;
+            }
+        }
+        it->p = p + 1;  /* Past the '{' or ',' */
+    }
+    
+    int rc = next_member(&it->p, end, m);
+    if (rc <= 0) {
+        it->p = end;
+        return false;
+    }
+    return true;
+}
+
 const char* sds_json_find_field(SdsJsonReader* r, const char* key) {
+    if (!key) {
+        return NULL;
+    }
+    return sds_json_find_field_n(r, key, strlen(key));
+}
+
+const char* sds_json_find_field_n(SdsJsonReader* r, const char* key, size_t key_len) {
     if (!r->json || r->len == 0 || !key) {
         return NULL;
     }
     
+    if (r->index_state != SDS_JSON_INDEX_NONE) {
+        const char* value = find_indexed(r, key, key_len);
+        if (value || r->index_state == SDS_JSON_INDEX_COMPLETE) {
+            return value;
+        }
+    }
+    
     const char* p = r->json;
     const char* end = r->json + r->len;
-    size_t key_len = strlen(key);
     
     while (p < end) {
         /* Find opening quote for key */
@@ -222,7 +744,7 @@ const char* sds_json_find_field(SdsJsonReader* r, const char* key) {
         
         /* Check if this is our key */
         if (p + key_len < end && 
-            strncmp(p, key, key_len) == 0 && 
+            memcmp(p, key, key_len) == 0 && 
             p[key_len] == '"') {
             
             p += key_len + 1;  /* Skip key and closing quote */
@@ -365,58 +887,110 @@ bool sds_json_parse_string(const char* value, char* out, size_t out_size) {
     return true;
 }
 
+/* Whitespace as the C locale defines it, whatever the current locale */
+static const char* skip_number_space(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' || *p == '\f' || *p == '\v') p++;
+    return p;
+}
+
+/**
+ * Parse a run of decimal digits no larger than max.
+ * Returns the end of the digits, or NULL if there are none or too many.
+ */
+static const char* parse_digits(const char* p, uint64_t max, uint64_t* out) {
+    const char* start = p;
+    uint64_t v = 0;
+    while (*p >= '0' && *p <= '9') {
+        v = v * 10 + (uint64_t)(*p++ - '0');
+        if (v > max) return NULL;
+    }
+    if (p == start) return NULL;
+    *out = v;
+    return p;
+}
+
 bool sds_json_parse_int(const char* value, int32_t* out) {
     if (!value) return false;
     
-    errno = 0;
-    char* endptr;
-    long val = strtol(value, &endptr, 10);
-    
-    /* Check for parse error */
-    if (endptr == value) return false;
+    const char* p = skip_number_space(value);
+    bool negative = (*p == '-');
+    if (*p == '-' || *p == '+') p++;
     
-    /* Check for overflow/underflow */
-    if (errno == ERANGE) return false;
+    /* Rejects values outside int32_t, including those beyond 64 bits */
+    uint64_t mag;
+    if (!parse_digits(p, negative ? (uint64_t)INT32_MAX + 1 : INT32_MAX, &mag)) return false;
     
-    /* Check if value fits in int32_t (important on 64-bit systems where long > 32 bits) */
-    if (val < INT32_MIN || val > INT32_MAX) return false;
-    
-    *out = (int32_t)val;
+    *out = negative ? (int32_t)(0 - mag) : (int32_t)mag;
     return true;
 }
 
 bool sds_json_parse_uint(const char* value, uint32_t* out) {
     if (!value) return false;
     
-    /* Check for negative sign - strtoul accepts negative numbers */
-    while (isspace((unsigned char)*value)) value++;
-    if (*value == '-') return false;
-    
-    errno = 0;
-    char* endptr;
-    unsigned long val = strtoul(value, &endptr, 10);
-    
-    /* Check for parse error */
-    if (endptr == value) return false;
-    
-    /* Check for overflow */
-    if (errno == ERANGE) return false;
+    const char* p = skip_number_space(value);
+    if (*p == '-') return false;
+    if (*p == '+') p++;
     
-    /* Check if value fits in uint32_t (important on 64-bit systems where long > 32 bits) */
-    if (val > UINT32_MAX) return false;
+    uint64_t val;
+    if (!parse_digits(p, UINT32_MAX, &val)) return false;
     
     *out = (uint32_t)val;
     return true;
 }
 
+/*
+ * JSON numbers: sign, digits, fraction, exponent. The first 19
+ * significant digits are kept, which is more than a float can tell apart.
+ * Values beyond the float range are rejected, tiny ones read as zero.
+ */
 bool sds_json_parse_float(const char* value, float* out) {
     if (!value) return false;
     
-    char* endptr;
-    float val = strtof(value, &endptr);
-    if (endptr == value) return false;
+    const char* p = skip_number_space(value);
+    bool negative = (*p == '-');
+    if (*p == '-' || *p == '+') p++;
+    
+    uint64_t mantissa = 0;
+    int kept = 0;           /* Significant digits in mantissa */
+    int e10 = 0;
+    bool any = false;
+    
+    for (; *p >= '0' && *p <= '9'; p++) {
+        any = true;
+        if (kept < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            if (mantissa) kept++;
+        } else {
+            e10++;
+        }
+    }
+    if (*p == '.') {
+        for (p++; *p >= '0' && *p <= '9'; p++) {
+            any = true;
+            if (kept < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                if (mantissa) kept++;
+                e10--;
+            }
+        }
+    }
+    if (!any) return false;
+    
+    if (*p == 'e' || *p == 'E') {
+        const char* q = p + 1;
+        bool exp_negative = (*q == '-');
+        if (*q == '-' || *q == '+') q++;
+        int exp = 0;
+        for (; *q >= '0' && *q <= '9'; q++) {
+            if (exp < 10000) exp = exp * 10 + (*q - '0');
+        }
+        e10 += exp_negative ? -exp : exp;   /* "1e" reads as 1, like strtof */
+    }
     
-    *out = val;
+    float val;
+    if (!decimal_to_float(mantissa, e10, &val)) return false;
+    
+    *out = negative ? -val : val;
     return true;
 }
 
@@ -434,15 +1008,20 @@ bool sds_json_parse_bool(const char* value, bool* out) {
     return false;
 }
 
-bool sds_json_get_string_field(SdsJsonReader* r, const char* key, char* out, size_t out_size) {
-    const char* value = sds_json_find_field(r, key);
-    if (!value) return false;
+bool sds_json_parse_string_in(SdsJsonReader* r, const char* value, char* out, size_t out_size) {
+    if (!value || value < r->json || value >= r->json + r->len) return false;
     
     /* Calculate remaining bytes in the JSON buffer from value position */
     size_t remaining = r->len - (size_t)(value - r->json);
     return parse_string_bounded(value, remaining, out, out_size);
 }
 
+bool sds_json_get_string_field(SdsJsonReader* r, const char* key, char* out, size_t out_size) {
+    const char* value = sds_json_find_field(r, key);
+    if (!value) return false;
+    return sds_json_parse_string_in(r, value, out, out_size);
+}
+
 bool sds_json_get_int_field(SdsJsonReader* r, const char* key, int32_t* out) {
     const char* value = sds_json_find_field(r, key);
     if (!value) return false;
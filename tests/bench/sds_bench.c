@@ -0,0 +1,517 @@
+/*
+ * sds_bench.c - Microbenchmarks for the JSON, delta and dispatch hot paths
+ *
+ * Runs against the mock platform, so no broker is needed and results only
+ * reflect library code (plus the mock's publish capture).
+ *
+ * Cases:
+ * - json_find:   reader init + one sds_json_find_field() vs. payload size
+ *                and key position, with a plain and an indexed reader
+ * - delta_sync:  one state sync with 0-100% of 16 fields changed
+ *                (delta serializer, shadow compare, publish)
+ * - status_slot: status message from a known device at 16/256/4096 slots,
+ *                with the default and a sized slot index
+ * - dispatch:    full on_mqtt_message() path for config, state and status
+ * - raw_route:   raw message matched against 8/64/512 subscribed patterns
+ *
+ * Build:
+ *   cmake -DSDS_BUILD_BENCH=ON -DCMAKE_BUILD_TYPE=Release .. && make sds_bench
+ *
+ * Run:
+ *   ./sds_bench                 CSV on stdout
+ *   ./sds_bench --json          JSON on stdout
+ *   ./sds_bench --filter delta  Only cases whose name contains "delta"
+ *   ./sds_bench --scale 0.1     Scale iteration counts (quick smoke run)
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "sds.h"
+#include "sds_json.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+
+/* ============== Harness ============== */
+
+#define BENCH_REPEATS 3
+
+typedef void (*BenchFunc)(void* arg, uint32_t iterations);
+
+static bool g_json_output = false;
+static bool g_first_result = true;
+static const char* g_filter = NULL;
+static double g_scale = 1.0;
+
+/* Keeps results observable so the compiler cannot drop the work */
+static volatile uintptr_t g_sink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void report(const char* name, uint32_t iterations, double ns_per_op, size_t bytes) {
+    if (g_json_output) {
+        printf("%s\n    {\"name\": \"%s\", \"iterations\": %u, \"ns_per_op\": %.1f, \"bytes\": %zu}",
+               g_first_result ? "" : ",", name, iterations, ns_per_op, bytes);
+    } else {
+        printf("%s,%u,%.1f,%zu\n", name, iterations, ns_per_op, bytes);
+    }
+    g_first_result = false;
+    fflush(stdout);
+}
+
+/*
+ * Run func once to warm up, then BENCH_REPEATS times, and report the
+ * fastest repeat. bytes is the input size per operation (0 if not useful).
+ */
+static void run_bench(const char* name, BenchFunc func, void* arg, uint32_t iterations, size_t bytes) {
+    if (g_filter && !strstr(name, g_filter)) return;
+
+    iterations = (uint32_t)(iterations * g_scale);
+    if (iterations == 0) iterations = 1;
+
+    func(arg, iterations / 10 + 1);
+
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        uint64_t start = now_ns();
+        func(arg, iterations);
+        uint64_t elapsed = now_ns() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    report(name, iterations, (double)best / iterations, bytes);
+}
+
+static void init_mock_node(const char* node_id, bool enable_delta) {
+    sds_shutdown();
+    sds_mock_reset();
+
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_delta_sync = enable_delta,
+    };
+    if (sds_init(&config) != SDS_OK) {
+        fprintf(stderr, "sds_init failed\n");
+        exit(1);
+    }
+}
+
+/* ============== Table Definitions ============== */
+
+#define BENCH_STATE_FIELDS 16
+
+typedef struct {
+    uint8_t mode;
+    float threshold;
+} BenchConfig;
+
+typedef struct {
+    float values[BENCH_STATE_FIELDS];
+} BenchState;
+
+typedef struct {
+    uint8_t error_code;
+    uint8_t battery;
+    uint32_t uptime;
+} BenchStatus;
+
+typedef struct {
+    BenchConfig config;
+    BenchState state;
+    BenchStatus status;
+} BenchDeviceTable;
+
+typedef struct {
+    char node_id[SDS_MAX_NODE_ID_LEN];
+    bool valid;
+    bool online;
+    uint32_t last_seen_ms;
+    BenchStatus status;
+} BenchStatusSlot;
+
+typedef struct {
+    BenchConfig config;
+    BenchState state;
+    BenchStatusSlot* status_slots;
+    uint16_t status_count;
+} BenchOwnerTable;
+
+static const SdsFieldMeta bench_config_fields[] = {
+    { .name = "mode", .type = SDS_FIELD_UINT8, .offset = offsetof(BenchConfig, mode), .size = sizeof(uint8_t) },
+    { .name = "threshold", .type = SDS_FIELD_FLOAT, .offset = offsetof(BenchConfig, threshold), .size = sizeof(float) },
+};
+
+#define STATE_FIELD(i) { .name = "v" #i, .type = SDS_FIELD_FLOAT, \
+                         .offset = offsetof(BenchState, values) + (i) * sizeof(float), .size = sizeof(float) }
+
+static const SdsFieldMeta bench_state_fields[BENCH_STATE_FIELDS] = {
+    STATE_FIELD(0), STATE_FIELD(1), STATE_FIELD(2), STATE_FIELD(3),
+    STATE_FIELD(4), STATE_FIELD(5), STATE_FIELD(6), STATE_FIELD(7),
+    STATE_FIELD(8), STATE_FIELD(9), STATE_FIELD(10), STATE_FIELD(11),
+    STATE_FIELD(12), STATE_FIELD(13), STATE_FIELD(14), STATE_FIELD(15),
+};
+
+static const SdsFieldMeta bench_status_fields[] = {
+    { .name = "error_code", .type = SDS_FIELD_UINT8, .offset = offsetof(BenchStatus, error_code), .size = sizeof(uint8_t) },
+    { .name = "battery", .type = SDS_FIELD_UINT8, .offset = offsetof(BenchStatus, battery), .size = sizeof(uint8_t) },
+    { .name = "uptime", .type = SDS_FIELD_UINT32, .offset = offsetof(BenchStatus, uptime), .size = sizeof(uint32_t) },
+};
+
+static void set_bench_fields(const char* table_type) {
+    sds_set_table_fields(table_type,
+        bench_config_fields, 2,
+        bench_state_fields, BENCH_STATE_FIELDS,
+        bench_status_fields, 3);
+}
+
+static void register_bench_device(BenchDeviceTable* table) {
+    SdsTableOptions opts = { .sync_interval_ms = 100 };
+    memset(table, 0, sizeof(*table));
+    sds_register_table_ex(
+        table, "Bench", SDS_ROLE_DEVICE, &opts,
+        offsetof(BenchDeviceTable, config), sizeof(BenchConfig),
+        offsetof(BenchDeviceTable, state), sizeof(BenchState),
+        offsetof(BenchDeviceTable, status), sizeof(BenchStatus),
+        NULL, NULL, NULL, NULL, NULL, NULL);
+    set_bench_fields("Bench");
+}
+
+static void register_bench_owner(BenchOwnerTable* table, BenchStatusSlot* slots, uint32_t max_slots) {
+    memset(table, 0, sizeof(*table));
+    table->status_slots = slots;
+    sds_register_table_ex(
+        table, "Bench", SDS_ROLE_OWNER, NULL,
+        offsetof(BenchOwnerTable, config), sizeof(BenchConfig),
+        offsetof(BenchOwnerTable, state), sizeof(BenchState),
+        0, 0,
+        NULL, NULL, NULL, NULL, NULL, NULL);
+    set_bench_fields("Bench");
+    sds_set_owner_slot_offsets("Bench",
+        offsetof(BenchStatusSlot, valid),
+        offsetof(BenchStatusSlot, online),
+        offsetof(BenchStatusSlot, last_seen_ms));
+    sds_set_owner_status_slots_wide("Bench", SDS_SLOTS_EXTERNAL,
+        offsetof(BenchOwnerTable, status_slots),
+        sizeof(BenchStatusSlot),
+        offsetof(BenchStatusSlot, status),
+        offsetof(BenchOwnerTable, status_count), sizeof(uint16_t),
+        max_slots);
+}
+
+/* ============== JSON Field Lookup ============== */
+
+typedef struct {
+    char payload[4096];
+    size_t len;
+    char key[16];
+    bool indexed;
+} JsonFindArg;
+
+static void build_json_payload(JsonFindArg* arg, int fields, int key_pos, bool indexed) {
+    size_t n = 0;
+    n += (size_t)snprintf(arg->payload + n, sizeof(arg->payload) - n, "{\"ts\":12345,\"from\":\"device_0001\"");
+    for (int i = 0; i < fields; i++) {
+        n += (size_t)snprintf(arg->payload + n, sizeof(arg->payload) - n, ",\"field_%02d\":%d.25", i, i * 7);
+    }
+    n += (size_t)snprintf(arg->payload + n, sizeof(arg->payload) - n, "}");
+    arg->len = n;
+    snprintf(arg->key, sizeof(arg->key), "field_%02d", key_pos);
+    arg->indexed = indexed;
+}
+
+static void bench_json_find(void* p, uint32_t iterations) {
+    JsonFindArg* arg = (JsonFindArg*)p;
+    SdsJsonReader r;
+    SdsJsonSpan spans[SDS_JSON_MAX_INDEX_FIELDS];
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (arg->indexed) {
+            sds_json_reader_init_indexed(&r, arg->payload, arg->len, spans, SDS_JSON_MAX_INDEX_FIELDS);
+        } else {
+            sds_json_reader_init(&r, arg->payload, arg->len);
+        }
+        g_sink = (uintptr_t)sds_json_find_field(&r, arg->key);
+    }
+}
+
+static void run_json_benches(void) {
+    static const int sizes[] = { 4, 16, 64 };
+    static JsonFindArg arg;
+    char name[96];
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int fields = sizes[s];
+        const int positions[] = { 0, fields / 2, fields - 1 };
+        const char* pos_names[] = { "first", "middle", "last" };
+        for (int p = 0; p < 3; p++) {
+            for (int indexed = 0; indexed <= 1; indexed++) {
+                build_json_payload(&arg, fields, positions[p], indexed);
+                snprintf(name, sizeof(name), "json_find/%s/fields=%d/key=%s",
+                         indexed ? "indexed" : "scan", fields, pos_names[p]);
+                run_bench(name, bench_json_find, &arg, 200000, arg.len);
+            }
+        }
+    }
+}
+
+/* ============== Delta Serialization ============== */
+
+typedef struct {
+    BenchDeviceTable table;
+    int changed;
+    uint32_t round;
+} DeltaArg;
+
+static void bench_delta_sync(void* p, uint32_t iterations) {
+    DeltaArg* arg = (DeltaArg*)p;
+    for (uint32_t i = 0; i < iterations; i++) {
+        arg->round++;
+        for (int f = 0; f < arg->changed; f++) {
+            arg->table.state.values[f] = (float)arg->round + (float)f;
+        }
+        sds_mock_advance_time(100);
+        sds_loop();
+    }
+}
+
+static void run_delta_benches(void) {
+    static const int changed[] = { 0, 1, 4, 8, 16 };
+    static DeltaArg arg;
+    char name[96];
+
+    for (int delta = 0; delta <= 1; delta++) {
+        for (size_t c = 0; c < sizeof(changed) / sizeof(changed[0]); c++) {
+            snprintf(name, sizeof(name), "delta_sync/%s/changed=%d/16",
+                     delta ? "delta" : "full", changed[c]);
+            if (g_filter && !strstr(name, g_filter)) continue;
+
+            init_mock_node("bench_device", delta);
+            register_bench_device(&arg.table);
+            arg.changed = changed[c];
+            arg.round = 0;
+            run_bench(name, bench_delta_sync, &arg, 20000, 0);
+        }
+    }
+    sds_shutdown();
+}
+
+/* ============== Status Slot Lookup ============== */
+
+typedef struct {
+    uint32_t devices;
+    char topics[64][64];
+    char payload[128];
+    size_t payload_len;
+} SlotArg;
+
+static uint32_t g_slot_index[8192];
+
+static void bench_status_slot(void* p, uint32_t iterations) {
+    SlotArg* arg = (SlotArg*)p;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sds_mock_inject_message(arg->topics[i & 63], (const uint8_t*)arg->payload, arg->payload_len);
+    }
+}
+
+static void run_status_slot_benches(void) {
+    static const uint32_t slot_counts[] = { 16, 256, 4096 };
+    static BenchOwnerTable table;
+    static SlotArg arg;
+    char name[96];
+    char topic[64];
+
+    for (size_t s = 0; s < sizeof(slot_counts) / sizeof(slot_counts[0]); s++) {
+        uint32_t slots = slot_counts[s];
+        for (int sized_index = 0; sized_index <= 1; sized_index++) {
+            snprintf(name, sizeof(name), "status_slot/%s/slots=%u",
+                     sized_index ? "sized_index" : "default_index", slots);
+            if (g_filter && !strstr(name, g_filter)) continue;
+
+            BenchStatusSlot* storage = calloc(slots, sizeof(BenchStatusSlot));
+            if (!storage) continue;
+
+            init_mock_node("bench_owner", false);
+            register_bench_owner(&table, storage, slots);
+            if (sized_index) {
+                sds_set_owner_slot_index("Bench", g_slot_index, slots * 2);
+            }
+
+            arg.payload_len = (size_t)snprintf(arg.payload, sizeof(arg.payload),
+                "{\"ts\":1,\"online\":true,\"error_code\":0,\"battery\":77,\"uptime\":1000}");
+
+            /* Fill every slot, then look up devices spread across the table */
+            for (uint32_t d = 0; d < slots; d++) {
+                snprintf(topic, sizeof(topic), "sds/Bench/status/dev_%05u", d);
+                sds_mock_inject_message(topic, (const uint8_t*)arg.payload, arg.payload_len);
+            }
+            for (uint32_t t = 0; t < 64; t++) {
+                snprintf(arg.topics[t], sizeof(arg.topics[t]), "sds/Bench/status/dev_%05u",
+                         (uint32_t)(((uint64_t)t * 2654435761u) % slots));
+            }
+            if (table.status_count != slots) {
+                fprintf(stderr, "%s: expected %u devices, got %u\n", name, slots, table.status_count);
+            }
+
+            run_bench(name, bench_status_slot, &arg, 50000, arg.payload_len);
+            sds_shutdown();
+            free(storage);
+        }
+    }
+}
+
+/* ============== Message Dispatch ============== */
+
+typedef struct {
+    const char* topic;
+    char payload[512];
+    size_t payload_len;
+} DispatchArg;
+
+static void bench_dispatch(void* p, uint32_t iterations) {
+    DispatchArg* arg = (DispatchArg*)p;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sds_mock_inject_message(arg->topic, (const uint8_t*)arg->payload, arg->payload_len);
+    }
+}
+
+static size_t build_state_payload(char* out, size_t size, const char* from) {
+    size_t n = (size_t)snprintf(out, size, "{\"ts\":1,\"from\":\"%s\"", from);
+    for (int i = 0; i < BENCH_STATE_FIELDS; i++) {
+        n += (size_t)snprintf(out + n, size - n, ",\"v%d\":%d.5", i, i);
+    }
+    n += (size_t)snprintf(out + n, size - n, "}");
+    return n;
+}
+
+static void run_dispatch_benches(void) {
+    static BenchDeviceTable device;
+    static BenchOwnerTable owner;
+    static BenchStatusSlot slots[16];
+    static DispatchArg arg;
+
+    init_mock_node("bench_device", false);
+    register_bench_device(&device);
+    arg.topic = "sds/Bench/config";
+    arg.payload_len = (size_t)snprintf(arg.payload, sizeof(arg.payload),
+        "{\"ts\":1,\"from\":\"bench_owner\",\"mode\":3,\"threshold\":21.5}");
+    run_bench("dispatch/config", bench_dispatch, &arg, 200000, arg.payload_len);
+
+    init_mock_node("bench_owner", false);
+    register_bench_owner(&owner, slots, 16);
+
+    arg.topic = "sds/Bench/state";
+    arg.payload_len = build_state_payload(arg.payload, sizeof(arg.payload), "dev_00001");
+    run_bench("dispatch/state", bench_dispatch, &arg, 200000, arg.payload_len);
+
+    arg.topic = "sds/Bench/status/dev_00001";
+    arg.payload_len = (size_t)snprintf(arg.payload, sizeof(arg.payload),
+        "{\"ts\":1,\"online\":true,\"error_code\":0,\"battery\":77,\"uptime\":1000}");
+    run_bench("dispatch/status", bench_dispatch, &arg, 200000, arg.payload_len);
+
+    arg.topic = "sds/Unknown/state";
+    run_bench("dispatch/unknown_table", bench_dispatch, &arg, 200000, arg.payload_len);
+
+    sds_shutdown();
+}
+
+/* ============== Raw Subscription Routing ============== */
+
+static void bench_raw_callback(const char* topic, const uint8_t* payload, size_t len, void* user_data) {
+    (void)topic;
+    (void)payload;
+    (void)user_data;
+    g_sink += len;
+}
+
+static void run_raw_route_benches(void) {
+    static const uint16_t counts[] = { 8, 64, SDS_MOCK_MAX_SUBSCRIPTIONS };
+    static DispatchArg arg;
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        uint16_t n = counts[c];
+        init_mock_node("bench_bridge", false);
+        void* storage = malloc(sds_raw_subscription_storage_size(n));
+        if (!storage || sds_set_raw_subscription_storage(storage, n) != SDS_OK) {
+            sds_shutdown();
+            free(storage);
+            continue;
+        }
+
+        char topic[48];
+        for (uint16_t i = 0; i < n; i++) {
+            snprintf(topic, sizeof(topic), "bridge/dev%u/+", (unsigned)i);
+            sds_subscribe_raw(topic, bench_raw_callback, NULL);
+        }
+
+        snprintf(topic, sizeof(topic), "bridge/dev%u/temp", (unsigned)(n - 1));
+        arg.topic = topic;
+        arg.payload_len = (size_t)snprintf(arg.payload, sizeof(arg.payload), "21.5");
+
+        char name[48];
+        snprintf(name, sizeof(name), "raw_route/patterns_%u", (unsigned)n);
+        run_bench(name, bench_dispatch, &arg, 500000, arg.payload_len);
+
+        sds_shutdown();
+        free(storage);
+    }
+}
+
+/* ============== Main ============== */
+
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [--json|--csv] [--filter SUBSTR] [--scale FACTOR]\n", prog);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            g_json_output = true;
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            g_json_output = false;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            g_filter = argv[++i];
+        } else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            g_scale = atof(argv[++i]);
+            if (g_scale <= 0) g_scale = 1.0;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    sds_set_log_level(SDS_LOG_NONE);
+
+    if (g_json_output) {
+        printf("{\n  \"suite\": \"sds_bench\",\n  \"benchmarks\": [");
+    } else {
+        printf("name,iterations,ns_per_op,bytes\n");
+    }
+
+    run_json_benches();
+    run_delta_benches();
+    run_status_slot_benches();
+    run_dispatch_benches();
+    run_raw_route_benches();
+
+    if (g_json_output) {
+        printf("\n  ]\n}\n");
+    }
+    return 0;
+}
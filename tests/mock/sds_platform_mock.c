@@ -9,6 +9,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdlib.h>
 
 /* ============== Internal State ============== */
 
@@ -19,10 +20,13 @@ static SdsMockConfig g_config = {
     .mqtt_connected = false,
     .mqtt_publish_returns_success = true,
     .mqtt_subscribe_returns_success = true,
+    .outbound_async = false,
+    .ingest_async = false,
 };
 
 /* Time simulation */
 static uint32_t g_mock_time_ms = 0;
+static uint32_t g_mock_extra_us = 0;   /* sds_mock_advance_micros() on top of ms time */
 
 /* Message callback registered by SDS core */
 static SdsMqttMessageCallback g_message_callback = NULL;
@@ -31,12 +35,15 @@ static SdsMqttMessageCallback g_message_callback = NULL;
 static SdsMockPublishedMessage g_published[SDS_MOCK_MAX_PUBLISHED];
 static size_t g_publish_count = 0;
 static size_t g_publish_write_index = 0;
+static SdsMockPublishHook g_publish_hook = NULL;
+static void* g_publish_hook_user_data = NULL;
 
 /* Subscription tracking */
 static char g_subscriptions[SDS_MOCK_MAX_SUBSCRIPTIONS][SDS_MOCK_MAX_TOPIC_LEN];
 static size_t g_subscription_count = 0;
 static size_t g_subscribe_call_count = 0;
 static size_t g_unsubscribe_call_count = 0;
+static size_t g_subscribe_many_call_count = 0;
 
 /* Connection tracking */
 static size_t g_connect_count = 0;
@@ -44,6 +51,42 @@ static char g_last_client_id[64] = "";
 static char g_last_broker[128] = "";
 static uint16_t g_last_port = 0;
 
+/* Sessions: the broker keeps subscriptions only for resumed persistent sessions */
+static bool g_persistent_session = false;
+static bool g_session_stored = false;
+static bool g_session_present = false;
+
+/* Outbound sender simulation */
+static SdsOutboundDrainFunc g_outbound_drain = NULL;
+static size_t g_outbound_notify_count = 0;
+
+/* Ingest worker simulation */
+static SdsIngestWorkFunc g_ingest_work = NULL;
+static size_t g_ingest_notify_count = 0;
+static int g_table_locks_held = 0;
+
+/* Persistent storage (kept across sds_shutdown()/sds_init()) */
+typedef struct {
+    char key[SDS_MOCK_MAX_TOPIC_LEN];
+    uint8_t data[SDS_MOCK_MAX_STORAGE_LEN];
+    size_t len;
+} SdsMockStorageRecord;
+
+static SdsMockStorageRecord g_storage[SDS_MOCK_MAX_STORAGE_RECORDS];
+static size_t g_storage_count = 0;
+static size_t g_storage_save_count = 0;
+
+/* Shared memory: freed once unlinked and unmapped everywhere */
+typedef struct {
+    char name[SDS_MOCK_MAX_TOPIC_LEN];
+    uint8_t* data;
+    size_t size;
+    bool linked;
+    uint32_t maps;
+} SdsMockShmSegment;
+
+static SdsMockShmSegment g_shm[SDS_MOCK_MAX_SHM_SEGMENTS];
+
 /* Log capture */
 static SdsMockLogEntry g_logs[SDS_MOCK_MAX_LOG_ENTRIES];
 static size_t g_log_count = 0;
@@ -58,9 +101,13 @@ void sds_mock_reset(void) {
     g_config.mqtt_connected = false;
     g_config.mqtt_publish_returns_success = true;
     g_config.mqtt_subscribe_returns_success = true;
+    g_config.outbound_async = false;
+    g_config.ingest_async = false;
+    g_config.mqtt_session_present = false;
     
     /* Reset time */
     g_mock_time_ms = 0;
+    g_mock_extra_us = 0;
     
     /* Reset callback */
     g_message_callback = NULL;
@@ -69,18 +116,42 @@ void sds_mock_reset(void) {
     memset(g_published, 0, sizeof(g_published));
     g_publish_count = 0;
     g_publish_write_index = 0;
+    g_publish_hook = NULL;
+    g_publish_hook_user_data = NULL;
     
     /* Reset subscriptions */
     memset(g_subscriptions, 0, sizeof(g_subscriptions));
     g_subscription_count = 0;
     g_subscribe_call_count = 0;
     g_unsubscribe_call_count = 0;
+    g_subscribe_many_call_count = 0;
     
     /* Reset connection tracking */
     g_connect_count = 0;
     g_last_client_id[0] = '\0';
     g_last_broker[0] = '\0';
     g_last_port = 0;
+    g_persistent_session = false;
+    g_session_stored = false;
+    g_session_present = false;
+    
+    /* Reset outbound sender */
+    g_outbound_drain = NULL;
+    g_outbound_notify_count = 0;
+    g_ingest_work = NULL;
+    g_ingest_notify_count = 0;
+    g_table_locks_held = 0;
+    
+    /* Reset storage */
+    memset(g_storage, 0, sizeof(g_storage));
+    g_storage_count = 0;
+    g_storage_save_count = 0;
+    
+    /* Reset shared memory */
+    for (size_t i = 0; i < SDS_MOCK_MAX_SHM_SEGMENTS; i++) {
+        free(g_shm[i].data);
+    }
+    memset(g_shm, 0, sizeof(g_shm));
     
     /* Reset logs */
     memset(g_logs, 0, sizeof(g_logs));
@@ -112,6 +183,10 @@ uint32_t sds_mock_get_time(void) {
     return g_mock_time_ms;
 }
 
+void sds_mock_advance_micros(uint32_t delta_us) {
+    g_mock_extra_us += delta_us;
+}
+
 /* ============== Message Injection ============== */
 
 void sds_mock_inject_message(const char* topic, const uint8_t* payload, size_t payload_len) {
@@ -186,6 +261,11 @@ const SdsMockPublishedMessage* sds_mock_find_publish_by_topic(const char* topic_
     return NULL;
 }
 
+void sds_mock_set_publish_hook(SdsMockPublishHook hook, void* user_data) {
+    g_publish_hook = hook;
+    g_publish_hook_user_data = user_data;
+}
+
 /* ============== Subscription Tracking ============== */
 
 bool sds_mock_is_subscribed(const char* topic) {
@@ -221,6 +301,10 @@ size_t sds_mock_get_unsubscribe_call_count(void) {
     return g_unsubscribe_call_count;
 }
 
+size_t sds_mock_get_subscribe_many_call_count(void) {
+    return g_subscribe_many_call_count;
+}
+
 /* ============== Connection Tracking ============== */
 
 size_t sds_mock_get_connect_count(void) {
@@ -239,6 +323,10 @@ uint16_t sds_mock_get_last_port(void) {
     return g_last_port;
 }
 
+bool sds_mock_get_persistent_session(void) {
+    return g_persistent_session;
+}
+
 void sds_mock_simulate_disconnect(void) {
     g_config.mqtt_connected = false;
 }
@@ -249,6 +337,161 @@ void sds_mock_simulate_reconnect(void) {
     }
 }
 
+/* ============== Outbound Sender ============== */
+
+void sds_mock_run_outbound_sender(void) {
+    if (g_outbound_drain) {
+        g_outbound_drain();
+    }
+}
+
+size_t sds_mock_get_outbound_notify_count(void) {
+    return g_outbound_notify_count;
+}
+
+/* ============== Ingest Workers ============== */
+
+size_t sds_mock_run_ingest_workers(void) {
+    size_t applied = 0;
+    while (g_ingest_work && g_ingest_work()) {
+        applied++;
+    }
+    return applied;
+}
+
+size_t sds_mock_get_ingest_notify_count(void) {
+    return g_ingest_notify_count;
+}
+
+int sds_mock_get_table_locks_held(void) {
+    return g_table_locks_held;
+}
+
+/* ============== Persistent Storage ============== */
+
+static SdsMockStorageRecord* storage_find(const char* key) {
+    for (size_t i = 0; i < g_storage_count; i++) {
+        if (strcmp(g_storage[i].key, key) == 0) {
+            return &g_storage[i];
+        }
+    }
+    return NULL;
+}
+
+const uint8_t* sds_mock_storage_get(const char* key, size_t* len) {
+    SdsMockStorageRecord* rec = storage_find(key);
+    if (len) {
+        *len = rec ? rec->len : 0;
+    }
+    return rec ? rec->data : NULL;
+}
+
+bool sds_mock_storage_set(const char* key, const uint8_t* data, size_t len) {
+    if (strlen(key) >= SDS_MOCK_MAX_TOPIC_LEN || len > SDS_MOCK_MAX_STORAGE_LEN) {
+        return false;
+    }
+    
+    SdsMockStorageRecord* rec = storage_find(key);
+    if (!rec) {
+        if (g_storage_count >= SDS_MOCK_MAX_STORAGE_RECORDS) {
+            return false;
+        }
+        rec = &g_storage[g_storage_count++];
+        strcpy(rec->key, key);
+    }
+    memcpy(rec->data, data, len);
+    rec->len = len;
+    return true;
+}
+
+size_t sds_mock_get_storage_save_count(void) {
+    return g_storage_save_count;
+}
+
+/* ============== Shared Memory ============== */
+
+static void shm_release(SdsMockShmSegment* seg) {
+    if (seg->maps > 0) seg->maps--;
+    if (seg->maps == 0 && !seg->linked) {
+        free(seg->data);
+        memset(seg, 0, sizeof(*seg));
+    }
+}
+
+static SdsMockShmSegment* shm_find_linked(const char* name) {
+    for (size_t i = 0; i < SDS_MOCK_MAX_SHM_SEGMENTS; i++) {
+        if (g_shm[i].linked && strcmp(g_shm[i].name, name) == 0) {
+            return &g_shm[i];
+        }
+    }
+    return NULL;
+}
+
+static SdsMockShmSegment* shm_find_mapping(const void* addr) {
+    for (size_t i = 0; i < SDS_MOCK_MAX_SHM_SEGMENTS; i++) {
+        if (g_shm[i].data && g_shm[i].data == addr) {
+            return &g_shm[i];
+        }
+    }
+    return NULL;
+}
+
+void* sds_platform_shm_create(const char* name, size_t size) {
+    if (!name || strlen(name) >= SDS_MOCK_MAX_TOPIC_LEN || size == 0) return NULL;
+    
+    SdsMockShmSegment* old = shm_find_linked(name);
+    if (old) {
+        old->linked = false;
+        old->maps++;
+        shm_release(old);
+    }
+    
+    for (size_t i = 0; i < SDS_MOCK_MAX_SHM_SEGMENTS; i++) {
+        if (!g_shm[i].data) {
+            g_shm[i].data = calloc(1, size);
+            if (!g_shm[i].data) return NULL;
+            strcpy(g_shm[i].name, name);
+            g_shm[i].size = size;
+            g_shm[i].linked = true;
+            g_shm[i].maps = 1;
+            return g_shm[i].data;
+        }
+    }
+    return NULL;
+}
+
+void sds_platform_shm_remove(const char* name, void* addr, size_t size) {
+    (void)size;
+    SdsMockShmSegment* seg = shm_find_linked(name);
+    if (seg && seg->data == addr) {
+        seg->linked = false;
+    }
+    seg = shm_find_mapping(addr);
+    if (seg) shm_release(seg);
+}
+
+const void* sds_platform_shm_attach(const char* name, size_t* size) {
+    SdsMockShmSegment* seg = name ? shm_find_linked(name) : NULL;
+    if (!seg) return NULL;
+    seg->maps++;
+    *size = seg->size;
+    return seg->data;
+}
+
+void sds_platform_shm_detach(const void* addr, size_t size) {
+    (void)size;
+    SdsMockShmSegment* seg = shm_find_mapping(addr);
+    if (seg) shm_release(seg);
+}
+
+size_t sds_mock_get_shm_count(void) {
+    size_t count = 0;
+    for (size_t i = 0; i < SDS_MOCK_MAX_SHM_SEGMENTS; i++) {
+        if (g_shm[i].linked) count++;
+    }
+    return count;
+}
+
 /* ============== Log Capture ============== */
 
 size_t sds_mock_get_log_count(void) {
@@ -330,9 +573,16 @@ bool sds_platform_mqtt_connect(const char* broker, uint16_t port, const char* cl
     
     if (g_config.mqtt_connect_returns_success) {
         g_config.mqtt_connected = true;
+        g_session_present = g_persistent_session && g_session_stored && g_config.mqtt_session_present;
+        g_session_stored = g_persistent_session;
+        if (!g_session_present) {
+            /* New session: the broker holds no subscriptions for it */
+            g_subscription_count = 0;
+        }
         return true;
     }
     
+    g_session_present = false;
     return false;
 }
 
@@ -376,6 +626,14 @@ bool sds_platform_mqtt_connect_with_auth(
     return sds_platform_mqtt_connect(broker, port, client_id);
 }
 
+void sds_platform_mqtt_set_persistent_session(bool persistent) {
+    g_persistent_session = persistent;
+}
+
+bool sds_platform_mqtt_session_present(void) {
+    return g_session_present;
+}
+
 void sds_platform_mqtt_disconnect(void) {
     g_config.mqtt_connected = false;
 }
@@ -422,6 +680,10 @@ bool sds_platform_mqtt_publish(
     g_publish_write_index = (g_publish_write_index + 1) % SDS_MOCK_MAX_PUBLISHED;
     g_publish_count++;
     
+    if (g_publish_hook) {
+        g_publish_hook(topic, payload, payload_len, retained, g_publish_hook_user_data);
+    }
+    
     return true;
 }
 
@@ -458,6 +720,18 @@ bool sds_platform_mqtt_subscribe(const char* topic) {
     return false;  /* No room for more subscriptions */
 }
 
+bool sds_platform_mqtt_subscribe_many(const char* const* topics, size_t count) {
+    g_subscribe_many_call_count++;
+    
+    bool granted = true;
+    for (size_t i = 0; i < count; i++) {
+        if (!sds_platform_mqtt_subscribe(topics[i])) {
+            granted = false;
+        }
+    }
+    return granted;
+}
+
 bool sds_platform_mqtt_unsubscribe(const char* topic) {
     g_unsubscribe_call_count++;
     
@@ -488,6 +762,75 @@ void sds_platform_mqtt_loop(void) {
     /* Mock does nothing here - messages are injected manually */
 }
 
+bool sds_platform_outbound_start(SdsOutboundDrainFunc drain) {
+    if (!g_config.outbound_async) {
+        return false;
+    }
+    g_outbound_drain = drain;
+    return true;
+}
+
+void sds_platform_outbound_notify(void) {
+    g_outbound_notify_count++;
+}
+
+void sds_platform_outbound_stop(void) {
+    g_outbound_drain = NULL;
+}
+
+void sds_platform_outbound_lock(void) {
+}
+
+void sds_platform_outbound_unlock(void) {
+}
+
+bool sds_platform_ingest_start(SdsIngestWorkFunc work, uint8_t workers) {
+    (void)workers;
+    if (!g_config.ingest_async) {
+        return false;
+    }
+    g_ingest_work = work;
+    return true;
+}
+
+void sds_platform_ingest_notify(void) {
+    g_ingest_notify_count++;
+}
+
+void sds_platform_ingest_stop(void) {
+    g_ingest_work = NULL;
+}
+
+void sds_platform_ingest_lock(void) {
+}
+
+void sds_platform_ingest_unlock(void) {
+}
+
+void sds_platform_table_lock(uint8_t table) {
+    (void)table;
+    g_table_locks_held++;
+}
+
+void sds_platform_table_unlock(uint8_t table) {
+    (void)table;
+    g_table_locks_held--;
+}
+
+size_t sds_platform_storage_load(const char* key, uint8_t* buf, size_t size) {
+    SdsMockStorageRecord* rec = storage_find(key);
+    if (!rec || rec->len > size) {
+        return 0;
+    }
+    memcpy(buf, rec->data, rec->len);
+    return rec->len;
+}
+
+bool sds_platform_storage_save(const char* key, const uint8_t* data, size_t len) {
+    g_storage_save_count++;
+    return sds_mock_storage_set(key, data, len);
+}
+
 void sds_platform_mqtt_set_callback(SdsMqttMessageCallback callback) {
     g_message_callback = callback;
 }
@@ -496,6 +839,10 @@ uint32_t sds_platform_millis(void) {
     return g_mock_time_ms;
 }
 
+uint32_t sds_platform_micros(void) {
+    return g_mock_time_ms * 1000u + g_mock_extra_us;
+}
+
 void sds_platform_delay_ms(uint32_t ms) {
     /* In mock, delay just advances time */
     g_mock_time_ms += ms;
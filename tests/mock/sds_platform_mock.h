@@ -6,6 +6,8 @@
  *   - Message injection (simulating MQTT receives)
  *   - Publish capture (verifying outgoing messages)
  *   - Subscription tracking
+ *   - Outbound sender simulation
+ *   - In-memory persistent storage
  *   - Configurable failure injection
  * 
  * Usage:
@@ -39,6 +41,9 @@ typedef struct {
     bool mqtt_connected;                /* sds_platform_mqtt_connected() return value */
     bool mqtt_publish_returns_success;  /* sds_platform_mqtt_publish() return value */
     bool mqtt_subscribe_returns_success;/* sds_platform_mqtt_subscribe() return value */
+    bool outbound_async;                /* sds_platform_outbound_start() return value */
+    bool ingest_async;                  /* sds_platform_ingest_start() return value */
+    bool mqtt_session_present;          /* Broker resumes persistent sessions on connect */
 } SdsMockConfig;
 
 /**
@@ -84,6 +89,14 @@ void sds_mock_advance_time(uint32_t delta_ms);
  */
 uint32_t sds_mock_get_time(void);
 
+/**
+ * Advance the microsecond clock (sds_platform_micros()) without moving
+ * millisecond time, e.g. from a callback to simulate work.
+ * 
+ * @param delta_us Microseconds to advance
+ */
+void sds_mock_advance_micros(uint32_t delta_us);
+
 /* ============== Message Injection ============== */
 
 /**
@@ -169,12 +182,32 @@ void sds_mock_clear_publishes(void);
  */
 const SdsMockPublishedMessage* sds_mock_find_publish_by_topic(const char* topic_pattern);
 
+/**
+ * Called for every successful publish, after it is captured.
+ * Lets a harness route published messages (e.g. an in-memory bus).
+ */
+typedef void (*SdsMockPublishHook)(
+    const char* topic,
+    const uint8_t* payload,
+    size_t payload_len,
+    bool retained,
+    void* user_data
+);
+
+/**
+ * Set the publish hook (NULL to remove). Cleared by sds_mock_reset().
+ * 
+ * @param hook Hook function
+ * @param user_data Passed to the hook
+ */
+void sds_mock_set_publish_hook(SdsMockPublishHook hook, void* user_data);
+
 /* ============== Subscription Tracking ============== */
 
 /**
  * Maximum tracked subscriptions.
  */
-#define SDS_MOCK_MAX_SUBSCRIPTIONS 32
+#define SDS_MOCK_MAX_SUBSCRIPTIONS 512
 
 /**
  * Check if a topic is currently subscribed.
@@ -206,6 +239,14 @@ const char* sds_mock_get_subscription(size_t index);
  */
 size_t sds_mock_get_subscribe_call_count(void);
 
+/**
+ * Get total number of subscribe_many() calls (SUBSCRIBE requests).
+ * Each of their topics also counts as a subscribe() call.
+ * 
+ * @return Total subscribe_many() calls since reset
+ */
+size_t sds_mock_get_subscribe_many_call_count(void);
+
 /**
  * Get total number of unsubscribe calls.
  * 
@@ -243,6 +284,13 @@ const char* sds_mock_get_last_broker(void);
  */
 uint16_t sds_mock_get_last_port(void);
 
+/**
+ * Check the session kind selected with sds_platform_mqtt_set_persistent_session().
+ * 
+ * @return true if connects use persistent sessions
+ */
+bool sds_mock_get_persistent_session(void);
+
 /**
  * Simulate a disconnect event.
  * Sets mqtt_connected to false.
@@ -255,6 +303,95 @@ void sds_mock_simulate_disconnect(void);
  */
 void sds_mock_simulate_reconnect(void);
 
+/* ============== Outbound Sender ============== */
+
+/**
+ * Run the outbound drain function as the platform sender would.
+ * Does nothing unless outbound_async was true at sds_init().
+ */
+void sds_mock_run_outbound_sender(void);
+
+/**
+ * Get total number of sds_platform_outbound_notify() calls.
+ * 
+ * @return Notify calls since reset
+ */
+size_t sds_mock_get_outbound_notify_count(void);
+
+/* ============== Ingest Workers ============== */
+
+/**
+ * Run the ingest work function until it has nothing left, as a platform
+ * worker would. Does nothing unless ingest_async was true at sds_init().
+ * 
+ * @return Number of messages applied
+ */
+size_t sds_mock_run_ingest_workers(void);
+
+/**
+ * Get total number of sds_platform_ingest_notify() calls.
+ * 
+ * @return Notify calls since reset
+ */
+size_t sds_mock_get_ingest_notify_count(void);
+
+/**
+ * Get the number of table locks currently held (recursive holds count each).
+ * 
+ * @return Table locks taken and not yet released
+ */
+int sds_mock_get_table_locks_held(void);
+
+/* ============== Persistent Storage ============== */
+
+/**
+ * Maximum records and record size kept by the in-memory store.
+ * The store survives sds_shutdown()/sds_init(), like flash across a
+ * reboot, and is cleared by sds_mock_reset().
+ */
+#define SDS_MOCK_MAX_STORAGE_RECORDS 8
+#define SDS_MOCK_MAX_STORAGE_LEN     2304
+
+/**
+ * Get a stored record.
+ * 
+ * @param key Record key
+ * @param len Receives the record length (may be NULL)
+ * @return Record bytes, or NULL if none is stored
+ */
+const uint8_t* sds_mock_storage_get(const char* key, size_t* len);
+
+/**
+ * Store a record directly, as sds_platform_storage_save() would
+ * (e.g. to plant a corrupt one).
+ * 
+ * @return false if the store is full or the record too large
+ */
+bool sds_mock_storage_set(const char* key, const uint8_t* data, size_t len);
+
+/**
+ * Get total number of sds_platform_storage_save() calls.
+ * 
+ * @return Save calls since reset
+ */
+size_t sds_mock_get_storage_save_count(void);
+
+/* ============== Shared Memory ============== */
+
+/**
+ * Maximum in-memory shared-memory segments. Segments are heap blocks
+ * looked up by name; attaching maps the same block, so a test can read an
+ * export as another process would. Cleared by sds_mock_reset().
+ */
+#define SDS_MOCK_MAX_SHM_SEGMENTS 4
+
+/**
+ * Get the number of segment names that currently resolve.
+ * 
+ * @return Segments created and not yet removed
+ */
+size_t sds_mock_get_shm_count(void);
+
 /* ============== Logging Capture ============== */
 
 /**
@@ -3,9 +3,20 @@
 # run_scale_test.sh - Launch scale test with owner and multiple devices
 #
 # Usage:
-#   ./run_scale_test.sh [num_devices] [duration_seconds] [broker_ip]
+#   ./run_scale_test.sh [num_devices] [duration_seconds] [broker_ip] [num_owners]
+#   ./run_scale_test.sh [num_devices] [duration_seconds] [broker_ip] sweep
 #
-# Default: 25 devices, 30 seconds, localhost
+# Default: 25 devices, 30 seconds, localhost, 1 owner
+#
+# With num_owners > 1 the owners run as one cluster (SdsConfig.cluster_members)
+# and each tracks its share of the devices; the summary shows the per-member
+# load next to the ideal num_devices / num_owners. Each owner tracks at most
+# 64 devices, so the fleet a cluster can follow grows with num_owners.
+#
+# "sweep" runs the same fleet against 1, 2 and 4 members and reports the
+# busiest member's applied message rate and CPU time for each, as a ratio of
+# the single-owner run. Linear scaling shows as ratios near 1/members. Keep
+# num_devices at 64 or less so the single owner can track the whole fleet.
 #
 
 set -e
@@ -18,6 +29,7 @@ BUILD_DIR="$PROJECT_ROOT/build"
 NUM_DEVICES=${1:-25}
 DURATION=${2:-30}
 BROKER=${3:-localhost}
+NUM_OWNERS=${4:-1}
 
 # Colors
 RED='\033[0;31m'
@@ -37,9 +49,11 @@ cleanup() {
         done
     fi
     
-    # Kill owner process
-    if [ -n "$OWNER_PID" ]; then
-        kill $OWNER_PID 2>/dev/null || true
+    # Kill owner processes
+    if [ -n "$OWNER_PIDS" ]; then
+        for pid in $OWNER_PIDS; do
+            kill $pid 2>/dev/null || true
+        done
     fi
     
     wait 2>/dev/null || true
@@ -54,6 +68,7 @@ echo "╔═══════════════════════
 echo "║              SDS Scale Test                                  ║"
 echo "╠══════════════════════════════════════════════════════════════╣"
 echo "║  Devices: $NUM_DEVICES                                                ║"
+echo "║  Owners: $NUM_OWNERS                                                  ║"
 echo "║  Duration: ${DURATION}s                                               ║"
 echo "║  Broker: $BROKER                                           ║"
 echo "╚══════════════════════════════════════════════════════════════╝"
@@ -81,48 +96,134 @@ if ! nc -z "$BROKER" 1883 2>/dev/null; then
 fi
 echo -e "${GREEN}Broker is reachable.${NC}\n"
 
-# Start owner process
-echo -e "${YELLOW}Starting owner process...${NC}"
-"$BUILD_DIR/test_scale_owner" "$BROKER" "$DURATION" &
-OWNER_PID=$!
-sleep 1
+# Run one fleet against $1 members. Sets OWNER_EXIT, and BUSIEST_MSGS,
+# BUSIEST_ELAPSED and BUSIEST_CPU for the most loaded member.
+run_fleet() {
+    NUM_OWNERS=$1
+    OWNER_EXIT=0
+    BUSIEST_MSGS=0
+    BUSIEST_CPU=0
+    BUSIEST_ELAPSED=0
+
+    # Start owner processes (member 0 shows the live output, the others log)
+    echo -e "${YELLOW}Starting $NUM_OWNERS owner process(es)...${NC}"
+    OWNER_PIDS=""
+    FIRST_OWNER_PID=""
+    for m in $(seq 0 $((NUM_OWNERS - 1))); do
+        log="$BUILD_DIR/scale_owner_$m.log"
+        if [ $m -eq 0 ]; then
+            "$BUILD_DIR/test_scale_owner" "$BROKER" "$DURATION" "$NUM_OWNERS" "$m" | tee "$log" &
+        else
+            "$BUILD_DIR/test_scale_owner" "$BROKER" "$DURATION" "$NUM_OWNERS" "$m" > "$log" 2>&1 &
+        fi
+        OWNER_PIDS="$OWNER_PIDS $!"
+        [ -z "$FIRST_OWNER_PID" ] && FIRST_OWNER_PID=$!
+    done
+    sleep 1
+
+    # Verify owners started
+    for pid in $OWNER_PIDS; do
+        if ! kill -0 $pid 2>/dev/null; then
+            echo -e "${RED}Owner process failed to start${NC}"
+            exit 1
+        fi
+    done
+
+    # Start device processes
+    echo -e "${YELLOW}Starting $NUM_DEVICES device processes...${NC}"
+    DEVICE_PIDS=""
+
+    for i in $(seq 1 $NUM_DEVICES); do
+        device_id=$(printf "device_%02d" $i)
+        "$BUILD_DIR/test_scale_device" "$device_id" "$BROKER" "$DURATION" > /dev/null 2>&1 &
+        DEVICE_PIDS="$DEVICE_PIDS $!"
+    
+        # Stagger device startup slightly to avoid connection storm
+        sleep 0.1
+    done
+
+    echo -e "${GREEN}All $NUM_DEVICES devices started.${NC}\n"
+
+    # Wait for owners to complete (member 0 shows the consolidated output)
+    echo -e "${CYAN}Running test...${NC}\n"
+    OWNER_EXIT=0
+    for pid in $OWNER_PIDS; do
+        wait $pid || OWNER_EXIT=1
+    done
+
+    # Wait for devices to finish
+    echo -e "\n${YELLOW}Waiting for devices to finish...${NC}"
+    for pid in $DEVICE_PIDS; do
+        wait $pid 2>/dev/null || true
+    done
+
+    # Clear the trap since we've handled cleanup
+    DEVICE_PIDS=""
+    OWNER_PIDS=""
+
+    # Per-member results; the cluster summary checks every device was
+    # tracked once and shows how the load split between members
+    [ "$NUM_OWNERS" -gt 1 ] && echo -e "\n${CYAN}Cluster summary:${NC}"
+    TOTAL_TRACKED=0
+    MAX_TRACKED=0
+    for m in $(seq 0 $((NUM_OWNERS - 1))); do
+        line=$(grep '^RESULT' "$BUILD_DIR/scale_owner_$m.log" || true)
+        devices=$(echo "$line" | sed -n 's/.*devices=\([0-9]*\).*/\1/p')
+        messages=$(echo "$line" | sed -n 's/.*messages=\([0-9]*\).*/\1/p')
+        skipped=$(echo "$line" | sed -n 's/.*skipped=\([0-9]*\).*/\1/p')
+        elapsed=$(echo "$line" | sed -n 's/.*elapsed_ms=\([0-9]*\).*/\1/p')
+        cpu=$(echo "$line" | sed -n 's/.*cpu_ms=\([0-9]*\).*/\1/p')
+        devices=${devices:-0}
+        messages=${messages:-0}
+        if [ "$NUM_OWNERS" -gt 1 ]; then
+            echo "  member $m: ${devices} devices, ${messages} messages applied, ${skipped:-0} skipped, ${cpu:-0} ms CPU"
+        fi
+        TOTAL_TRACKED=$((TOTAL_TRACKED + devices))
+        [ "$devices" -gt "$MAX_TRACKED" ] && MAX_TRACKED=$devices
+        if [ "$messages" -ge "$BUSIEST_MSGS" ]; then
+            BUSIEST_MSGS=$messages
+            BUSIEST_ELAPSED=${elapsed:-0}
+        fi
+        [ "${cpu:-0}" -gt "$BUSIEST_CPU" ] && BUSIEST_CPU=${cpu:-0}
+    done
+    if [ "$NUM_OWNERS" -gt 1 ]; then
+        echo "  tracked: $TOTAL_TRACKED of $NUM_DEVICES devices"
+        echo "  busiest member: $MAX_TRACKED devices (ideal $((NUM_DEVICES / NUM_OWNERS)))"
+        if [ "$TOTAL_TRACKED" -ne "$NUM_DEVICES" ]; then
+            echo -e "${RED}Devices were missed or tracked twice${NC}"
+            OWNER_EXIT=1
+        fi
+    fi
+}
 
-# Verify owner started
-if ! kill -0 $OWNER_PID 2>/dev/null; then
-    echo -e "${RED}Owner process failed to start${NC}"
-    exit 1
+if [ "$NUM_OWNERS" = "sweep" ]; then
+    SWEEP_EXIT=0
+    SWEEP_LINES=""
+    BASE_RATE=""
+    BASE_CPU=""
+    for n in 1 2 4; do
+        echo -e "${CYAN}─── $n member(s) ───${NC}"
+        run_fleet $n
+        [ $OWNER_EXIT -ne 0 ] && SWEEP_EXIT=1
+        rate=$(awk -v m=$BUSIEST_MSGS -v t=$BUSIEST_ELAPSED 'BEGIN { printf "%.1f", (t > 0) ? m * 1000 / t : 0 }')
+        if [ -z "$BASE_RATE" ]; then
+            BASE_RATE=$rate
+            BASE_CPU=$BUSIEST_CPU
+        fi
+        ratio=$(awk -v r=$rate -v b=$BASE_RATE 'BEGIN { printf "%.2f", (b > 0) ? r / b : 0 }')
+        cpu_ratio=$(awk -v c=$BUSIEST_CPU -v b=$BASE_CPU 'BEGIN { printf "%.2f", (b > 0) ? c / b : 0 }')
+        ideal=$(awk -v n=$n 'BEGIN { printf "%.2f", 1 / n }')
+        SWEEP_LINES="$SWEEP_LINES$(printf '  %7d  %12s  %6s  %8s  %6s  %6s' $n $rate $ratio $BUSIEST_CPU $cpu_ratio $ideal)\n"
+    done
+
+    echo -e "\n${CYAN}Scaling (busiest member, relative to 1 member):${NC}"
+    echo "  members    messages/s   ratio    cpu ms   ratio   ideal"
+    echo -ne "$SWEEP_LINES"
+    OWNER_EXIT=$SWEEP_EXIT
+else
+    run_fleet $NUM_OWNERS
 fi
 
-# Start device processes
-echo -e "${YELLOW}Starting $NUM_DEVICES device processes...${NC}"
-DEVICE_PIDS=""
-
-for i in $(seq 1 $NUM_DEVICES); do
-    device_id=$(printf "device_%02d" $i)
-    "$BUILD_DIR/test_scale_device" "$device_id" "$BROKER" "$DURATION" > /dev/null 2>&1 &
-    DEVICE_PIDS="$DEVICE_PIDS $!"
-    
-    # Stagger device startup slightly to avoid connection storm
-    sleep 0.1
-done
-
-echo -e "${GREEN}All $NUM_DEVICES devices started.${NC}\n"
-
-# Wait for owner to complete (it shows the consolidated output)
-echo -e "${CYAN}Running test...${NC}\n"
-wait $OWNER_PID
-OWNER_EXIT=$?
-
-# Wait for devices to finish
-echo -e "\n${YELLOW}Waiting for devices to finish...${NC}"
-for pid in $DEVICE_PIDS; do
-    wait $pid 2>/dev/null || true
-done
-
-# Clear the trap since we've handled cleanup
-DEVICE_PIDS=""
-OWNER_PID=""
-
 echo -e "\n${GREEN}Scale test complete.${NC}"
 
 if [ $OWNER_EXIT -eq 0 ]; then
@@ -0,0 +1,686 @@
+/*
+ * sds_fleet_sim.c - In-process fleet simulator for owner capacity testing
+ *
+ * Drives one real owner (the SDS core on the mock platform) against N
+ * simulated devices over an in-memory bus in virtual time, so fleets of
+ * 10k+ devices can be measured without a broker or a process per device.
+ *
+ * Simulated devices are not SDS nodes (the core runs one node per
+ * process). Each is a small record that publishes what a device with the
+ * Sim table would: status heartbeats and changes, state updates, an LWT
+ * when it drops off and a fresh status when it comes back. The bus queues
+ * device messages and delivers them to the owner once per tick (dropping
+ * a --loss fraction), stores the owner's retained config and fans it out
+ * to online devices, replaying it to devices that reconnect.
+ *
+ * Reports:
+ * - owner CPU per delivered message: process CPU time spent in message
+ *   dispatch and sds_loop(), excluding the simulator's own work
+ * - owner memory: slot storage, slot index and peak RSS of the process
+ * - slot lookup cost: sds_find_node_status() on random devices
+ * - bus, churn and config convergence counts
+ *
+ * Build:
+ *   cmake -DSDS_BUILD_BENCH=ON -DCMAKE_BUILD_TYPE=Release .. && make sds_fleet_sim
+ *
+ * Run:
+ *   ./sds_fleet_sim                                  10k devices, 60 s
+ *   ./sds_fleet_sim --devices 50000 --loss 0.01 --churn 0.0005
+ *   ./sds_fleet_sim --json                           Results as JSON
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sds.h"
+#include "sds_json.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include <sys/resource.h>
+
+/* ============== Options ============== */
+
+typedef struct {
+    uint32_t devices;           /* Simulated devices */
+    uint32_t duration_ms;       /* Virtual run time */
+    uint32_t tick_ms;           /* Virtual time step (owner sds_loop() per tick) */
+    uint32_t heartbeat_ms;      /* Status heartbeat when nothing changes */
+    double change_rate;         /* Status changes per device per second */
+    double state_rate;          /* State updates per device per second */
+    double churn;               /* Disconnects (LWT) per online device per second */
+    uint32_t offline_ms;        /* Mean time offline after a disconnect */
+    double loss;                /* Fraction of device messages lost */
+    uint32_t config_every_ms;   /* Owner config change period (0 = never) */
+    uint32_t evict_ms;          /* Owner eviction grace (0 = off) */
+    uint32_t lookups;           /* Slot lookups timed after the run */
+    uint32_t seed;
+    bool json;
+} SimOptions;
+
+static SimOptions g_opts = {
+    .devices = 10000,
+    .duration_ms = 60000,
+    .tick_ms = 100,
+    .heartbeat_ms = 3000,
+    .change_rate = 0.05,
+    .state_rate = 0.1,
+    .churn = 0.0002,
+    .offline_ms = 10000,
+    .loss = 0.0,
+    .config_every_ms = 10000,
+    .evict_ms = 0,
+    .lookups = 200000,
+    .seed = 1,
+    .json = false,
+};
+
+/* ============== Table Definition ============== */
+
+typedef struct {
+    uint8_t mode;
+    float threshold;
+} SimConfig;
+
+typedef struct {
+    float value;
+    uint32_t counter;
+} SimState;
+
+typedef struct {
+    uint8_t error_code;
+    uint8_t battery;
+    uint32_t uptime;
+} SimStatus;
+
+typedef struct {
+    char node_id[SDS_MAX_NODE_ID_LEN];
+    bool valid;
+    bool online;
+    bool eviction_pending;
+    uint32_t last_seen_ms;
+    uint32_t eviction_deadline;
+    SimStatus status;
+} SimStatusSlot;
+
+typedef struct {
+    SimConfig config;
+    SimState state;
+    SimStatusSlot* status_slots;
+    uint32_t status_count;
+} SimOwnerTable;
+
+static const SdsFieldMeta sim_config_fields[] = {
+    { .name = "mode", .type = SDS_FIELD_UINT8, .offset = offsetof(SimConfig, mode), .size = sizeof(uint8_t) },
+    { .name = "threshold", .type = SDS_FIELD_FLOAT, .offset = offsetof(SimConfig, threshold), .size = sizeof(float) },
+};
+
+static const SdsFieldMeta sim_state_fields[] = {
+    { .name = "value", .type = SDS_FIELD_FLOAT, .offset = offsetof(SimState, value), .size = sizeof(float) },
+    { .name = "counter", .type = SDS_FIELD_UINT32, .offset = offsetof(SimState, counter), .size = sizeof(uint32_t) },
+};
+
+static const SdsFieldMeta sim_status_fields[] = {
+    { .name = "error_code", .type = SDS_FIELD_UINT8, .offset = offsetof(SimStatus, error_code), .size = sizeof(uint8_t) },
+    { .name = "battery", .type = SDS_FIELD_UINT8, .offset = offsetof(SimStatus, battery), .size = sizeof(uint8_t) },
+    { .name = "uptime", .type = SDS_FIELD_UINT32, .offset = offsetof(SimStatus, uptime), .size = sizeof(uint32_t) },
+};
+
+/* ============== Simulated Devices ============== */
+
+#define SIM_ID_LEN 16
+
+typedef struct {
+    bool online;
+    bool joined;                /* Has been online since the run started */
+    uint32_t next_status_ms;    /* Next heartbeat */
+    uint32_t back_ms;           /* Offline: when the device reconnects */
+    uint32_t config_gen;        /* Last config generation delivered */
+    SimStatus status;
+    SimState state;
+} SimDevice;
+
+static SimDevice* g_devices;
+static char (*g_ids)[SIM_ID_LEN];
+
+static uint32_t g_rng;
+
+/* xorshift32: fast and reproducible for a given --seed */
+static uint32_t sim_rand(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+static double sim_unit(void) {
+    return (double)sim_rand() / 4294967296.0;
+}
+
+/* ============== Bus ============== */
+
+#define SIM_TOPIC_LEN 64
+#define SIM_PAYLOAD_LEN 192
+
+typedef struct {
+    char topic[SIM_TOPIC_LEN];
+    char payload[SIM_PAYLOAD_LEN];
+    uint16_t len;
+} BusMessage;
+
+typedef struct {
+    BusMessage* queue;          /* Device -> owner, delivered once per tick */
+    size_t queued;
+    size_t capacity;
+
+    uint32_t config_gen;        /* Bumped on every (retained) owner config publish */
+    bool config_pending;        /* Published this tick, not yet fanned out */
+
+    uint64_t sent;              /* Device messages published */
+    uint64_t lost;              /* Dropped by --loss */
+    uint64_t delivered;         /* Handed to the owner */
+    uint64_t lwt;               /* LWT messages (broker-published, not lost) */
+    uint64_t reconnects;
+    uint64_t config_publishes;
+    uint64_t config_deliveries; /* Config copies received by devices */
+    uint64_t owner_other;       /* Other owner publishes */
+} SimBus;
+
+static SimBus g_bus;
+
+static void bus_queue(const char* topic, const char* payload, size_t len, bool lossless) {
+    if (!lossless) {
+        g_bus.sent++;
+        if (g_opts.loss > 0 && sim_unit() < g_opts.loss) {
+            g_bus.lost++;
+            return;
+        }
+    }
+    if (g_bus.queued == g_bus.capacity) {
+        size_t capacity = g_bus.capacity ? g_bus.capacity * 2 : 1024;
+        BusMessage* queue = realloc(g_bus.queue, capacity * sizeof(BusMessage));
+        if (!queue) {
+            fprintf(stderr, "bus queue: out of memory\n");
+            exit(1);
+        }
+        g_bus.queue = queue;
+        g_bus.capacity = capacity;
+    }
+    BusMessage* m = &g_bus.queue[g_bus.queued++];
+    snprintf(m->topic, sizeof(m->topic), "%s", topic);
+    if (len > sizeof(m->payload)) len = sizeof(m->payload);
+    memcpy(m->payload, payload, len);
+    m->len = (uint16_t)len;
+}
+
+/* Owner publishes land here (mock publish hook) */
+static void bus_on_owner_publish(const char* topic, const uint8_t* payload, size_t payload_len,
+                                 bool retained, void* user_data) {
+    (void)payload;
+    (void)payload_len;
+    (void)retained;
+    (void)user_data;
+    /* Devices only track which config they hold, not its content */
+    if (strncmp(topic, "sds/Sim/config", 14) == 0) {
+        g_bus.config_gen++;
+        g_bus.config_publishes++;
+        g_bus.config_pending = true;
+    } else {
+        g_bus.owner_other++;
+    }
+}
+
+/* Fan a new owner config out to online devices */
+static void bus_fan_out_config(void) {
+    if (!g_bus.config_pending) return;
+    g_bus.config_pending = false;
+    for (uint32_t d = 0; d < g_opts.devices; d++) {
+        if (!g_devices[d].online) continue;
+        if (g_opts.loss > 0 && sim_unit() < g_opts.loss) continue;
+        g_devices[d].config_gen = g_bus.config_gen;
+        g_bus.config_deliveries++;
+    }
+}
+
+/* ============== Device Behaviour ============== */
+
+static void device_publish_status(uint32_t d, uint32_t now) {
+    SimDevice* dev = &g_devices[d];
+    char topic[SIM_TOPIC_LEN];
+    char payload[SIM_PAYLOAD_LEN];
+    SdsJsonWriter w;
+
+    dev->status.uptime = now / 1000;
+    sds_json_writer_init(&w, payload, sizeof(payload));
+    sds_json_start_object(&w);
+    sds_json_add_uint(&w, "ts", now);
+    sds_json_add_bool(&w, "online", true);
+    sds_json_add_uint(&w, "error_code", dev->status.error_code);
+    sds_json_add_uint(&w, "battery", dev->status.battery);
+    sds_json_add_uint(&w, "uptime", dev->status.uptime);
+    sds_json_end_object(&w);
+
+    snprintf(topic, sizeof(topic), "sds/Sim/status/%s", g_ids[d]);
+    bus_queue(topic, payload, sds_json_get_length(&w), false);
+    dev->next_status_ms = now + g_opts.heartbeat_ms;
+}
+
+static void device_publish_state(uint32_t d, uint32_t now) {
+    SimDevice* dev = &g_devices[d];
+    char payload[SIM_PAYLOAD_LEN];
+    SdsJsonWriter w;
+
+    dev->state.counter++;
+    dev->state.value = (float)(sim_rand() % 1000) / 10.0f;
+    sds_json_writer_init(&w, payload, sizeof(payload));
+    sds_json_start_object(&w);
+    sds_json_add_uint(&w, "ts", now);
+    sds_json_add_string(&w, "from", g_ids[d]);
+    sds_json_add_float(&w, "value", dev->state.value);
+    sds_json_add_uint(&w, "counter", dev->state.counter);
+    sds_json_end_object(&w);
+
+    bus_queue("sds/Sim/state", payload, sds_json_get_length(&w), false);
+}
+
+static void device_disconnect(uint32_t d, uint32_t now) {
+    SimDevice* dev = &g_devices[d];
+    char topic[SIM_TOPIC_LEN];
+    char payload[SIM_PAYLOAD_LEN];
+
+    dev->online = false;
+    dev->back_ms = now + (uint32_t)(g_opts.offline_ms * (0.5 + sim_unit()));
+    snprintf(topic, sizeof(topic), "sds/lwt/%s", g_ids[d]);
+    int len = snprintf(payload, sizeof(payload), "{\"online\":false,\"node\":\"%s\",\"ts\":0}", g_ids[d]);
+    bus_queue(topic, payload, (size_t)len, true);
+    g_bus.lwt++;
+}
+
+static void device_reconnect(uint32_t d, uint32_t now) {
+    SimDevice* dev = &g_devices[d];
+    dev->online = true;
+    if (dev->joined) g_bus.reconnects++;
+    dev->joined = true;
+    /* The broker replays the retained config on subscribe */
+    if (g_bus.config_gen > 0) {
+        dev->config_gen = g_bus.config_gen;
+        g_bus.config_deliveries++;
+    }
+    device_publish_status(d, now);
+}
+
+static void devices_step(uint32_t now) {
+    double tick_s = g_opts.tick_ms / 1000.0;
+    double p_churn = g_opts.churn * tick_s;
+    double p_change = g_opts.change_rate * tick_s;
+    double p_state = g_opts.state_rate * tick_s;
+
+    for (uint32_t d = 0; d < g_opts.devices; d++) {
+        SimDevice* dev = &g_devices[d];
+        if (!dev->online) {
+            if ((int32_t)(now - dev->back_ms) >= 0) device_reconnect(d, now);
+            continue;
+        }
+        if (p_churn > 0 && sim_unit() < p_churn) {
+            device_disconnect(d, now);
+            continue;
+        }
+        if (p_change > 0 && sim_unit() < p_change) {
+            dev->status.battery = dev->status.battery > 0 ? dev->status.battery - 1 : 100;
+            dev->status.error_code = (uint8_t)(sim_rand() % 4 == 0);
+            device_publish_status(d, now);
+        } else if ((int32_t)(now - dev->next_status_ms) >= 0) {
+            device_publish_status(d, now);
+        }
+        if (p_state > 0 && sim_unit() < p_state) {
+            device_publish_state(d, now);
+        }
+    }
+}
+
+/* ============== Owner ============== */
+
+static SimOwnerTable g_owner;
+static SimStatusSlot* g_slots;
+static uint32_t* g_index;
+static uint32_t g_index_buckets;
+static uint64_t g_evicted;
+
+static void on_evicted(const char* table_type, const char* node_id, void* user_data) {
+    (void)table_type;
+    (void)node_id;
+    (void)user_data;
+    g_evicted++;
+}
+
+static uint64_t cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t wall_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void owner_init(void) {
+    sds_mock_reset();
+
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+    sds_mock_set_publish_hook(bus_on_owner_publish, NULL);
+
+    SdsConfig config = {
+        .node_id = "sim_owner",
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .eviction_grace_ms = g_opts.evict_ms,
+    };
+    if (sds_init(&config) != SDS_OK) {
+        fprintf(stderr, "sds_init failed\n");
+        exit(1);
+    }
+
+    /* 4/3 x devices, rounded up to a power of two */
+    g_index_buckets = 1;
+    while (g_index_buckets < g_opts.devices + g_opts.devices / 3 + 1) g_index_buckets <<= 1;
+    g_slots = calloc(g_opts.devices, sizeof(SimStatusSlot));
+    g_index = calloc(g_index_buckets, sizeof(uint32_t));
+    if (!g_slots || !g_index) {
+        fprintf(stderr, "owner slots: out of memory\n");
+        exit(1);
+    }
+
+    SdsTableOptions opts = { .sync_interval_ms = g_opts.tick_ms };
+    memset(&g_owner, 0, sizeof(g_owner));
+    g_owner.status_slots = g_slots;
+    g_owner.config.threshold = 25.0f;
+    SdsError err = sds_register_table_ex(
+        &g_owner, "Sim", SDS_ROLE_OWNER, &opts,
+        offsetof(SimOwnerTable, config), sizeof(SimConfig),
+        offsetof(SimOwnerTable, state), sizeof(SimState),
+        0, 0,
+        NULL, NULL, NULL, NULL, NULL, NULL);
+    if (err != SDS_OK) {
+        fprintf(stderr, "register owner table: %s\n", sds_error_string(err));
+        exit(1);
+    }
+    sds_set_table_fields("Sim",
+        sim_config_fields, 2,
+        sim_state_fields, 2,
+        sim_status_fields, 3);
+    sds_set_owner_slot_offsets("Sim",
+        offsetof(SimStatusSlot, valid),
+        offsetof(SimStatusSlot, online),
+        offsetof(SimStatusSlot, last_seen_ms));
+    sds_set_owner_eviction_offsets("Sim",
+        offsetof(SimStatusSlot, eviction_pending),
+        offsetof(SimStatusSlot, eviction_deadline));
+    err = sds_set_owner_status_slots_wide("Sim", SDS_SLOTS_EXTERNAL,
+        offsetof(SimOwnerTable, status_slots),
+        sizeof(SimStatusSlot),
+        offsetof(SimStatusSlot, status),
+        offsetof(SimOwnerTable, status_count), sizeof(uint32_t),
+        g_opts.devices);
+    if (err == SDS_OK) {
+        err = sds_set_owner_slot_index("Sim", g_index, g_index_buckets);
+    }
+    if (err != SDS_OK) {
+        fprintf(stderr, "owner slots: %s\n", sds_error_string(err));
+        exit(1);
+    }
+    sds_on_device_evicted("Sim", on_evicted, NULL);
+}
+
+/* Deliver the tick's queued messages and run the owner loop; returns CPU ns */
+static uint64_t owner_step(void) {
+    uint64_t start = cpu_ns();
+    for (size_t i = 0; i < g_bus.queued; i++) {
+        BusMessage* m = &g_bus.queue[i];
+        sds_mock_inject_message(m->topic, (const uint8_t*)m->payload, m->len);
+    }
+    sds_loop();
+    uint64_t elapsed = cpu_ns() - start;
+
+    g_bus.delivered += g_bus.queued;
+    g_bus.queued = 0;
+    return elapsed;
+}
+
+/* ============== Report ============== */
+
+typedef struct {
+    uint64_t owner_cpu_ns;
+    uint64_t wall_ns;
+    double lookup_ns;
+    uint32_t lookup_hits;
+    uint32_t tracked;
+    uint32_t tracked_online;
+    uint32_t devices_online;
+    uint32_t config_current;
+    long peak_rss_kb;
+} SimResults;
+
+static void measure_lookups(SimResults* res) {
+    uint32_t* picks = malloc(sizeof(uint32_t) * 1024);
+    if (!picks || g_opts.lookups == 0) {
+        free(picks);
+        return;
+    }
+    for (int i = 0; i < 1024; i++) picks[i] = sim_rand() % g_opts.devices;
+
+    uint32_t hits = 0;
+    uint64_t start = wall_ns();
+    for (uint32_t i = 0; i < g_opts.lookups; i++) {
+        if (sds_find_node_status(&g_owner, "Sim", g_ids[picks[i & 1023]])) hits++;
+    }
+    res->lookup_ns = (double)(wall_ns() - start) / g_opts.lookups;
+    res->lookup_hits = hits;
+    free(picks);
+}
+
+static void collect(SimResults* res) {
+    for (uint32_t s = 0; s < g_owner.status_count && s < g_opts.devices; s++) {
+        if (!g_slots[s].valid) continue;
+        res->tracked++;
+        if (g_slots[s].online) res->tracked_online++;
+    }
+    for (uint32_t d = 0; d < g_opts.devices; d++) {
+        if (!g_devices[d].online) continue;
+        res->devices_online++;
+        if (g_devices[d].config_gen == g_bus.config_gen) res->config_current++;
+    }
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        res->peak_rss_kb = usage.ru_maxrss / 1024;  /* bytes on macOS */
+#else
+        res->peak_rss_kb = usage.ru_maxrss;
+#endif
+    }
+}
+
+static void print_report(const SimResults* res) {
+    double ns_per_msg = g_bus.delivered ? (double)res->owner_cpu_ns / (double)g_bus.delivered : 0.0;
+    double msg_rate = g_opts.duration_ms ? g_bus.delivered * 1000.0 / g_opts.duration_ms : 0.0;
+    size_t slot_bytes = (size_t)g_opts.devices * sizeof(SimStatusSlot);
+    size_t index_bytes = (size_t)g_index_buckets * sizeof(uint32_t);
+
+    if (g_opts.json) {
+        printf("{\n");
+        printf("  \"suite\": \"sds_fleet_sim\",\n");
+        printf("  \"devices\": %u,\n", g_opts.devices);
+        printf("  \"duration_ms\": %u,\n", g_opts.duration_ms);
+        printf("  \"tick_ms\": %u,\n", g_opts.tick_ms);
+        printf("  \"loss\": %g,\n", g_opts.loss);
+        printf("  \"churn\": %g,\n", g_opts.churn);
+        printf("  \"messages_sent\": %llu,\n", (unsigned long long)g_bus.sent);
+        printf("  \"messages_lost\": %llu,\n", (unsigned long long)g_bus.lost);
+        printf("  \"messages_delivered\": %llu,\n", (unsigned long long)g_bus.delivered);
+        printf("  \"virtual_msgs_per_sec\": %.1f,\n", msg_rate);
+        printf("  \"owner_cpu_ns\": %llu,\n", (unsigned long long)res->owner_cpu_ns);
+        printf("  \"owner_ns_per_msg\": %.1f,\n", ns_per_msg);
+        printf("  \"slot_lookup_ns\": %.1f,\n", res->lookup_ns);
+        printf("  \"slot_lookup_hits\": %u,\n", res->lookup_hits);
+        printf("  \"slot_bytes\": %zu,\n", slot_bytes);
+        printf("  \"index_bytes\": %zu,\n", index_bytes);
+        printf("  \"peak_rss_kb\": %ld,\n", res->peak_rss_kb);
+        printf("  \"lwt\": %llu,\n", (unsigned long long)g_bus.lwt);
+        printf("  \"reconnects\": %llu,\n", (unsigned long long)g_bus.reconnects);
+        printf("  \"evicted\": %llu,\n", (unsigned long long)g_evicted);
+        printf("  \"tracked\": %u,\n", res->tracked);
+        printf("  \"tracked_online\": %u,\n", res->tracked_online);
+        printf("  \"devices_online\": %u,\n", res->devices_online);
+        printf("  \"config_publishes\": %llu,\n", (unsigned long long)g_bus.config_publishes);
+        printf("  \"config_deliveries\": %llu,\n", (unsigned long long)g_bus.config_deliveries);
+        printf("  \"config_current\": %u,\n", res->config_current);
+        printf("  \"wall_ms\": %.1f\n", res->wall_ns / 1e6);
+        printf("}\n");
+        return;
+    }
+
+    printf("\nSDS fleet simulation: %u devices, %.1f s virtual, %u ms ticks (seed %u)\n",
+           g_opts.devices, g_opts.duration_ms / 1000.0, g_opts.tick_ms, g_opts.seed);
+    printf("  change %.3g/s  state %.3g/s  churn %.3g/s  loss %.3g  heartbeat %u ms\n\n",
+           g_opts.change_rate, g_opts.state_rate, g_opts.churn, g_opts.loss, g_opts.heartbeat_ms);
+
+    printf("  Bus\n");
+    printf("    sent %llu, lost %llu, delivered %llu (%.0f msg/s virtual)\n",
+           (unsigned long long)g_bus.sent, (unsigned long long)g_bus.lost,
+           (unsigned long long)g_bus.delivered, msg_rate);
+    printf("    LWT %llu, reconnects %llu, owner config %llu -> %llu device copies\n\n",
+           (unsigned long long)g_bus.lwt, (unsigned long long)g_bus.reconnects,
+           (unsigned long long)g_bus.config_publishes, (unsigned long long)g_bus.config_deliveries);
+
+    printf("  Owner\n");
+    printf("    CPU %.1f ms total, %.1f ns per message\n", res->owner_cpu_ns / 1e6, ns_per_msg);
+    printf("    slot lookup %.1f ns (%u/%u hits)\n", res->lookup_ns, res->lookup_hits, g_opts.lookups);
+    printf("    memory: slots %zu KB, index %zu KB, peak RSS %ld KB\n",
+           slot_bytes / 1024, index_bytes / 1024, res->peak_rss_kb);
+    printf("    tracked %u devices (%u online), evicted %llu\n\n",
+           res->tracked, res->tracked_online, (unsigned long long)g_evicted);
+
+    printf("  Fleet\n");
+    printf("    online %u/%u, current config %u/%u\n",
+           res->devices_online, g_opts.devices, res->config_current, res->devices_online);
+    printf("    wall time %.1f ms\n\n", res->wall_ns / 1e6);
+}
+
+/* ============== Main ============== */
+
+static void usage(const char* prog) {
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --devices N        simulated devices (default 10000)\n"
+        "  --duration S       virtual seconds (default 60)\n"
+        "  --tick MS          virtual time step (default 100)\n"
+        "  --heartbeat MS     status heartbeat (default 3000)\n"
+        "  --change-rate R    status changes per device per second (default 0.05)\n"
+        "  --state-rate R     state updates per device per second (default 0.1)\n"
+        "  --churn R          disconnects per device per second (default 0.0002)\n"
+        "  --offline MS       mean time offline (default 10000)\n"
+        "  --loss P           fraction of device messages lost (default 0)\n"
+        "  --config-every MS  owner config change period, 0 = never (default 10000)\n"
+        "  --evict MS         owner eviction grace, 0 = off (default 0)\n"
+        "  --lookups N        slot lookups timed after the run (default 200000)\n"
+        "  --seed N           random seed (default 1)\n"
+        "  --json             JSON output\n",
+        prog);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--json") == 0) {
+            g_opts.json = true;
+            continue;
+        }
+        if (!val) {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+        if (strcmp(arg, "--devices") == 0) g_opts.devices = (uint32_t)strtoul(val, NULL, 10);
+        else if (strcmp(arg, "--duration") == 0) g_opts.duration_ms = (uint32_t)(atof(val) * 1000);
+        else if (strcmp(arg, "--tick") == 0) g_opts.tick_ms = (uint32_t)strtoul(val, NULL, 10);
+        else if (strcmp(arg, "--heartbeat") == 0) g_opts.heartbeat_ms = (uint32_t)strtoul(val, NULL, 10);
+        else if (strcmp(arg, "--change-rate") == 0) g_opts.change_rate = atof(val);
+        else if (strcmp(arg, "--state-rate") == 0) g_opts.state_rate = atof(val);
+        else if (strcmp(arg, "--churn") == 0) g_opts.churn = atof(val);
+        else if (strcmp(arg, "--offline") == 0) g_opts.offline_ms = (uint32_t)strtoul(val, NULL, 10);
+        else if (strcmp(arg, "--loss") == 0) g_opts.loss = atof(val);
+        else if (strcmp(arg, "--config-every") == 0) g_opts.config_every_ms = (uint32_t)strtoul(val, NULL, 10);
+        else if (strcmp(arg, "--evict") == 0) g_opts.evict_ms = (uint32_t)strtoul(val, NULL, 10);
+        else if (strcmp(arg, "--lookups") == 0) g_opts.lookups = (uint32_t)strtoul(val, NULL, 10);
+        else if (strcmp(arg, "--seed") == 0) g_opts.seed = (uint32_t)strtoul(val, NULL, 10);
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (g_opts.devices == 0 || g_opts.tick_ms == 0 || g_opts.heartbeat_ms == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    sds_set_log_level(SDS_LOG_NONE);
+    g_rng = g_opts.seed ? g_opts.seed : 1;
+
+    g_devices = calloc(g_opts.devices, sizeof(SimDevice));
+    g_ids = calloc(g_opts.devices, sizeof(*g_ids));
+    if (!g_devices || !g_ids) {
+        fprintf(stderr, "devices: out of memory\n");
+        return 1;
+    }
+
+    owner_init();
+
+    /* Devices come up over the first heartbeat period */
+    for (uint32_t d = 0; d < g_opts.devices; d++) {
+        snprintf(g_ids[d], SIM_ID_LEN, "dev_%06u", d);
+        g_devices[d].back_ms = sim_rand() % g_opts.heartbeat_ms;
+        g_devices[d].status.battery = 100;
+    }
+
+    SimResults res;
+    memset(&res, 0, sizeof(res));
+    uint32_t next_config = g_opts.config_every_ms;
+    uint64_t wall_start = wall_ns();
+
+    for (uint32_t now = 0; now < g_opts.duration_ms; now += g_opts.tick_ms) {
+        sds_mock_set_time(now);
+        devices_step(now);
+        if (g_opts.config_every_ms && now >= next_config) {
+            g_owner.config.threshold += 0.5f;
+            next_config += g_opts.config_every_ms;
+        }
+        res.owner_cpu_ns += owner_step();
+        bus_fan_out_config();
+    }
+
+    res.wall_ns = wall_ns() - wall_start;
+    measure_lookups(&res);
+    collect(&res);
+    print_report(&res);
+
+    sds_shutdown();
+    free(g_bus.queue);
+    free(g_index);
+    free(g_slots);
+    free(g_ids);
+    free(g_devices);
+    return 0;
+}
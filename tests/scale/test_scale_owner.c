@@ -2,11 +2,13 @@
  * test_scale_owner.c - Owner process for scale testing
  * 
  * Registers a table as OWNER and tracks status from multiple devices.
+ * With a member count > 1 the process is one member of an owner cluster
+ * (SdsConfig.cluster_members) and tracks only its share of the devices.
  * 
  * Usage:
- *   ./test_scale_owner [broker_ip] [duration_seconds]
+ *   ./test_scale_owner [broker_ip] [duration_seconds] [members] [member]
  * 
- * Default: localhost, 30 seconds
+ * Default: localhost, 30 seconds, 1 member
  */
 
 #include "sds.h"
@@ -170,6 +172,13 @@ static void print_status(void) {
 int main(int argc, char** argv) {
     const char* broker = argc > 1 ? argv[1] : "localhost";
     int duration = argc > 2 ? atoi(argv[2]) : 30;
+    int members = argc > 3 ? atoi(argv[3]) : 1;
+    int member = argc > 4 ? atoi(argv[4]) : 0;
+    
+    if (members < 1 || members > 255 || member < 0 || member >= members) {
+        printf("Invalid cluster member %d of %d\n", member, members);
+        return 1;
+    }
     
     printf("╔══════════════════════════════════════════════════════════════╗\n");
     printf("║           SDS Scale Test - OWNER                             ║\n");
@@ -177,16 +186,22 @@ int main(int argc, char** argv) {
     printf("║  Broker: %-51s ║\n", broker);
     printf("║  Duration: %d seconds                                        ║\n", duration);
     printf("║  Max devices: %d                                             ║\n", MAX_DEVICES);
+    printf("║  Cluster member: %d of %d                                      ║\n", member, members);
     printf("╚══════════════════════════════════════════════════════════════╝\n\n");
     
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
     
     /* Initialize SDS */
+    char node_id[SDS_MAX_NODE_ID_LEN];
+    snprintf(node_id, sizeof(node_id), "scale_owner_%d", member);
+    
     SdsConfig config = {
-        .node_id = "scale_owner",
+        .node_id = node_id,
         .mqtt_broker = broker,
-        .mqtt_port = 1883
+        .mqtt_port = 1883,
+        .cluster_members = (uint8_t)members,
+        .cluster_member = (uint8_t)member
     };
     
     SdsError err = sds_init(&config);
@@ -275,8 +290,17 @@ int main(int argc, char** argv) {
     printf("  Total MQTT messages sent: %u\n", final_stats->messages_sent);
     printf("  Total MQTT messages received: %u\n", final_stats->messages_received);
     printf("  Total errors: %u\n", final_stats->errors);
+    printf("  Skipped (other members): %u\n", final_stats->cluster_skipped);
     printf("══════════════════════════════════════════════════════════════\n");
     
+    /* One line per member for run_scale_test.sh to aggregate; cpu_ms is
+     * this process's CPU time over the whole run */
+    uint32_t elapsed_ms = sds_platform_millis() - g_start_time;
+    unsigned long cpu_ms = (unsigned long)(clock() * 1000.0 / CLOCKS_PER_SEC);
+    printf("RESULT member=%d members=%d devices=%d messages=%d skipped=%u elapsed_ms=%u cpu_ms=%lu\n",
+           member, members, g_unique_devices, g_messages_received,
+           final_stats->cluster_skipped, elapsed_ms, cpu_ms);
+    
     /* List active devices */
     printf("\nActive devices:\n");
     for (int i = 0; i < g_table.status_count && i < MAX_DEVICES; i++) {
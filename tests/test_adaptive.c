@@ -0,0 +1,381 @@
+/*
+ * test_adaptive.c - Adaptive Scheduling Tests
+ *
+ * Tests adaptive sync and liveness intervals with the mock platform:
+ * - Fixed intervals stay unchanged without options
+ * - Sync interval backs off while idle, tightens on change, backs off
+ *   while the outbound queue is congested
+ * - Heartbeat gap stretches while idle and resets on change
+ * - Backed-off devices still wake for heartbeats
+ * - Advertised liveness ("lv", binary flag) widens owner timeouts
+ * - State messages refresh an owner's last_seen
+ *
+ * Build:
+ *   gcc -I../include -o test_adaptive test_adaptive.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_adaptive
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+static SensorDataOwnerTable g_owner;
+static SensorDataTable g_device;
+
+static SdsError init_node(const char* node_id, SdsRole role, const SdsTableOptions* opts,
+                          uint8_t queue_depth, bool async) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+        .outbound_async = async,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .outbound_queue_depth = queue_depth,
+    };
+
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_owner, 0, sizeof(g_owner));
+    memset(&g_device, 0, sizeof(g_device));
+
+    if (role == SDS_ROLE_OWNER) {
+        return sds_register_table(&g_owner, "SensorData", SDS_ROLE_OWNER, opts);
+    }
+    return sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, opts);
+}
+
+/* Advance to the next sync and run it; returns the interval until the one after */
+static uint32_t run_next_sync(void) {
+    sds_mock_advance_time(sds_next_deadline_ms());
+    sds_loop();
+    return sds_next_deadline_ms();
+}
+
+static size_t count_status_publishes(void) {
+    size_t count = 0;
+    for (size_t i = 0; i < sds_mock_get_publish_count(); i++) {
+        if (strcmp(sds_mock_get_publish(i)->topic, "sds/SensorData/status/dev_a") == 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Step in 500 ms ticks until the next status publish; returns its time (0 = none) */
+static uint32_t next_status_time(uint32_t limit_ms) {
+    size_t before = count_status_publishes();
+    for (uint32_t waited = 0; waited < limit_ms; waited += 500) {
+        sds_mock_advance_time(500);
+        sds_loop();
+        if (count_status_publishes() > before) return sds_mock_get_time();
+    }
+    return 0;
+}
+
+static void inject_status(const char* node, const char* extra) {
+    char topic[64];
+    char payload[192];
+    snprintf(topic, sizeof(topic), "sds/SensorData/status/%s", node);
+    snprintf(payload, sizeof(payload),
+             "{\"ts\":1,%s\"online\":true,\"error_code\":0,\"battery_percent\":50,\"uptime_seconds\":5}",
+             extra ? extra : "");
+    sds_mock_inject_message_str(topic, payload);
+}
+
+/* ============== Sync Interval Tests ============== */
+
+TEST(fixed_interval_by_default) {
+    SdsTableOptions opts = { .sync_interval_ms = 200 };
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, &opts, 0, false), SDS_OK);
+
+    ASSERT_EQ(run_next_sync(), 200u);
+    ASSERT_EQ(run_next_sync(), 200u);
+    ASSERT_EQ(run_next_sync(), 200u);
+}
+
+TEST(backs_off_while_idle) {
+    SdsTableOptions opts = { .sync_interval_ms = 100, .sync_interval_max_ms = 1000 };
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, &opts, 0, false), SDS_OK);
+
+    ASSERT_EQ(sds_next_deadline_ms(), 100u);
+    ASSERT_EQ(run_next_sync(), 151u);
+    ASSERT_EQ(run_next_sync(), 227u);
+    ASSERT_EQ(run_next_sync(), 341u);
+    ASSERT_EQ(run_next_sync(), 512u);
+    ASSERT_EQ(run_next_sync(), 769u);
+    ASSERT_EQ(run_next_sync(), 1000u);
+    ASSERT_EQ(run_next_sync(), 1000u);
+}
+
+TEST(tightens_on_change) {
+    SdsTableOptions opts = {
+        .sync_interval_ms = 800, .sync_interval_min_ms = 100, .sync_interval_max_ms = 1600
+    };
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, &opts, 0, false), SDS_OK);
+
+    g_owner.config.threshold = 1.0f;
+    ASSERT_EQ(run_next_sync(), 400u);
+    g_owner.config.threshold = 2.0f;
+    ASSERT_EQ(run_next_sync(), 200u);
+    g_owner.config.threshold = 3.0f;
+    ASSERT_EQ(run_next_sync(), 100u);
+    g_owner.config.threshold = 4.0f;
+    ASSERT_EQ(run_next_sync(), 100u);
+
+    /* Quiet again: back off */
+    ASSERT_EQ(run_next_sync(), 151u);
+}
+
+TEST(backs_off_while_congested) {
+    SdsTableOptions opts = {
+        .sync_interval_ms = 800, .sync_interval_min_ms = 100, .sync_interval_max_ms = 1600
+    };
+    /* Async sender that has not run yet: the config queued at registration
+     * keeps the queue full */
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, &opts, 1, true), SDS_OK);
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 1u);
+
+    /* Changes while the queue is backed up still back off */
+    g_owner.config.threshold = 1.0f;
+    ASSERT_EQ(run_next_sync(), 1201u);
+
+    /* Once the sender catches up, changes tighten the interval again */
+    sds_mock_run_outbound_sender();
+    g_owner.config.threshold = 2.0f;
+    ASSERT_EQ(run_next_sync(), 600u);
+}
+
+TEST(min_defaults_to_base_interval) {
+    SdsTableOptions opts = { .sync_interval_ms = 300, .sync_interval_max_ms = 600 };
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, &opts, 0, false), SDS_OK);
+
+    g_owner.config.threshold = 1.0f;
+    ASSERT_EQ(run_next_sync(), 300u);
+}
+
+/* ============== Liveness Tests ============== */
+
+TEST(heartbeat_gap_stretches_while_idle) {
+    /* Schema liveness is 3000 ms */
+    SdsTableOptions opts = { .sync_interval_ms = 500, .liveness_max_ms = 12000 };
+    ASSERT_EQ(init_node("dev_a", SDS_ROLE_DEVICE, &opts, 0, false), SDS_OK);
+
+    ASSERT_EQ(next_status_time(20000), 3000u);
+    ASSERT_EQ(next_status_time(20000), 9000u);     /* Gap 6000 */
+    ASSERT_EQ(next_status_time(20000), 21000u);    /* Gap 12000 */
+    ASSERT_EQ(next_status_time(20000), 33000u);    /* Capped */
+
+    /* A change resets the gap to the schema interval */
+    g_device.status.battery_percent = 10;
+    ASSERT_EQ(next_status_time(20000), 33500u);
+    ASSERT_EQ(next_status_time(20000), 36500u);
+}
+
+TEST(fixed_liveness_by_default) {
+    SdsTableOptions opts = { .sync_interval_ms = 500 };
+    ASSERT_EQ(init_node("dev_a", SDS_ROLE_DEVICE, &opts, 0, false), SDS_OK);
+
+    ASSERT_EQ(next_status_time(20000), 3000u);
+    ASSERT_EQ(next_status_time(20000), 6000u);
+    ASSERT_EQ(next_status_time(20000), 9000u);
+
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/SensorData/status/dev_a");
+    ASSERT(msg != NULL);
+    ASSERT(strstr((const char*)msg->payload, "\"lv\"") == NULL);
+}
+
+TEST(backed_off_sync_wakes_for_heartbeat) {
+    SdsTableOptions opts = { .sync_interval_ms = 1000, .sync_interval_max_ms = 60000 };
+    ASSERT_EQ(init_node("dev_a", SDS_ROLE_DEVICE, &opts, 0, false), SDS_OK);
+
+    /* Let the interval grow well past the 3000 ms liveness interval */
+    uint32_t heartbeats = 0;
+    uint32_t last = 0;
+    for (int i = 0; i < 12; i++) {
+        size_t before = count_status_publishes();
+        uint32_t next = run_next_sync();
+        ASSERT(next <= 3000u);
+        if (count_status_publishes() > before) {
+            ASSERT(sds_mock_get_time() - last <= 3000u);
+            last = sds_mock_get_time();
+            heartbeats++;
+        }
+    }
+    ASSERT(heartbeats >= 3);
+}
+
+TEST(device_advertises_liveness) {
+    SdsTableOptions opts = { .sync_interval_ms = 500, .liveness_max_ms = 12000 };
+    ASSERT_EQ(init_node("dev_a", SDS_ROLE_DEVICE, &opts, 0, false), SDS_OK);
+
+    ASSERT_EQ(sds_get_liveness_interval("SensorData"), 12000u);
+    ASSERT(next_status_time(20000) != 0);
+
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/SensorData/status/dev_a");
+    ASSERT(msg != NULL);
+    ASSERT(strstr((const char*)msg->payload, "\"lv\":12000") != NULL);
+}
+
+TEST(owner_uses_advertised_liveness) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, NULL, 0, false), SDS_OK);
+    ASSERT_EQ(sds_get_liveness_interval("SensorData"), 3000u);
+
+    sds_mock_set_time(1000);
+    inject_status("dev_a", NULL);
+    inject_status("dev_b", "\"lv\":12000,");
+    ASSERT_EQ(sds_get_liveness_interval("SensorData"), 12000u);
+
+    /* 0 = 1.5x each device's own interval: 4.5 s for dev_a, 18 s for dev_b */
+    sds_mock_set_time(6000);
+    ASSERT(!sds_is_device_online(&g_owner, "SensorData", "dev_a", 0));
+    sds_mock_set_time(15000);
+    ASSERT(sds_is_device_online(&g_owner, "SensorData", "dev_b", 0));
+    ASSERT(sds_is_device_online(&g_owner, "SensorData", "dev_a", 20000));
+    sds_mock_set_time(20000);
+    ASSERT(!sds_is_device_online(&g_owner, "SensorData", "dev_b", 0));
+}
+
+TEST(advertised_liveness_follows_the_device) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, NULL, 0, false), SDS_OK);
+
+    sds_mock_set_time(1000);
+    inject_status("dev_b", "\"lv\":12000,");
+    ASSERT_EQ(sds_get_liveness_interval("SensorData"), 12000u);
+
+    /* Back on the schema interval: the owner narrows again */
+    inject_status("dev_b", NULL);
+    ASSERT_EQ(sds_get_liveness_interval("SensorData"), 3000u);
+    sds_mock_set_time(6000);
+    ASSERT(!sds_is_device_online(&g_owner, "SensorData", "dev_b", 0));
+}
+
+TEST(binary_status_advertises_liveness) {
+    SdsMockPublishedMessage status;
+    SdsTableOptions dev_opts = {
+        .sync_interval_ms = 500, .wire_format = SDS_WIRE_BINARY, .liveness_max_ms = 9000
+    };
+    ASSERT_EQ(init_node("dev_a", SDS_ROLE_DEVICE, &dev_opts, 0, false), SDS_OK);
+    g_device.status.battery_percent = 70;
+    ASSERT(next_status_time(20000) != 0);
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/SensorData/status/dev_a");
+    ASSERT(msg != NULL);
+    status = *msg;
+    sds_shutdown();
+
+    sds_mock_reset();
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, NULL, 0, false), SDS_OK);
+    sds_mock_inject_message(status.topic, status.payload, status.payload_len);
+
+    ASSERT_EQ(sds_get_liveness_interval("SensorData"), 9000u);
+    const SensorDataStatus* st = sds_find_node_status(&g_owner, "SensorData", "dev_a");
+    ASSERT(st != NULL);
+    ASSERT_EQ(st->battery_percent, 70);
+}
+
+TEST(state_refreshes_last_seen) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, NULL, 0, false), SDS_OK);
+
+    sds_mock_set_time(1000);
+    inject_status("dev_a", NULL);
+
+    /* No heartbeat, but the device keeps publishing state */
+    sds_mock_set_time(5000);
+    sds_mock_inject_message_str("sds/SensorData/state",
+                                "{\"ts\":2,\"node\":\"dev_a\",\"temperature\":21.5,\"humidity\":40.0}");
+    sds_mock_set_time(8000);
+    ASSERT(sds_is_device_online(&g_owner, "SensorData", "dev_a", 4500));
+
+    /* State from a node without a slot does not allocate one */
+    sds_mock_inject_message_str("sds/SensorData/state",
+                                "{\"ts\":2,\"node\":\"dev_z\",\"temperature\":21.5,\"humidity\":40.0}");
+    ASSERT(sds_find_node_status(&g_owner, "SensorData", "dev_z") == NULL);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║          Adaptive Scheduling Tests (Mock Platform)           ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Sync Interval Tests ───\n");
+    RUN_TEST(fixed_interval_by_default);
+    RUN_TEST(backs_off_while_idle);
+    RUN_TEST(tightens_on_change);
+    RUN_TEST(backs_off_while_congested);
+    RUN_TEST(min_defaults_to_base_interval);
+
+    printf("\n─── Liveness Tests ───\n");
+    RUN_TEST(heartbeat_gap_stretches_while_idle);
+    RUN_TEST(fixed_liveness_by_default);
+    RUN_TEST(backed_off_sync_wakes_for_heartbeat);
+    RUN_TEST(device_advertises_liveness);
+    RUN_TEST(owner_uses_advertised_liveness);
+    RUN_TEST(advertised_liveness_follows_the_device);
+    RUN_TEST(binary_status_advertises_liveness);
+    RUN_TEST(state_refreshes_last_seen);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
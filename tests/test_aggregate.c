@@ -0,0 +1,621 @@
+/*
+ * test_aggregate.c - Aggregate (Summary Table) Tests
+ *
+ * Tests a bridge node that owns SensorData and publishes a summary table
+ * as a device, with the mock platform:
+ * - Storage sizing and argument checks
+ * - Counts across status, LWT and eviction
+ * - Min/max after the device holding the extreme leaves
+ * - Sum, mean and nearest-rank percentiles
+ * - Summary published on its own sync interval only
+ * - Linking when the source registers later, and after it unregisters
+ * - Aggregates attached from registry metadata (errors fail the registration)
+ *
+ * Build:
+ *   gcc -I../include -o test_aggregate test_aggregate.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_aggregate
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    sds_set_table_registry(SDS_TABLE_REGISTRY, SDS_TABLE_REGISTRY_COUNT); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NEAR(a, b) ASSERT((a) - (b) < 0.001f && (b) - (a) < 0.001f)
+
+/* ============== Summary Table ============== */
+
+#define GRACE_MS 30000
+#define SUMMARY_SYNC_MS 5000
+
+typedef struct {
+    uint16_t devices;
+    uint16_t online_count;
+    uint8_t battery_min;
+    uint8_t battery_max;
+    float battery_mean;
+    uint32_t uptime_sum;
+    uint8_t battery_p50;
+    uint8_t battery_p90;
+} SummaryStatus;
+
+static const SdsFieldMeta SUMMARY_FIELDS[] = {
+    { .name = "devices", .type = SDS_FIELD_UINT16, .offset = offsetof(SummaryStatus, devices), .size = 2 },
+    { .name = "online_count", .type = SDS_FIELD_UINT16, .offset = offsetof(SummaryStatus, online_count), .size = 2 },
+    { .name = "battery_min", .type = SDS_FIELD_UINT8, .offset = offsetof(SummaryStatus, battery_min), .size = 1 },
+    { .name = "battery_max", .type = SDS_FIELD_UINT8, .offset = offsetof(SummaryStatus, battery_max), .size = 1 },
+    { .name = "battery_mean", .type = SDS_FIELD_FLOAT, .offset = offsetof(SummaryStatus, battery_mean), .size = 4 },
+    { .name = "uptime_sum", .type = SDS_FIELD_UINT32, .offset = offsetof(SummaryStatus, uptime_sum), .size = 4 },
+    { .name = "battery_p50", .type = SDS_FIELD_UINT8, .offset = offsetof(SummaryStatus, battery_p50), .size = 1 },
+    { .name = "battery_p90", .type = SDS_FIELD_UINT8, .offset = offsetof(SummaryStatus, battery_p90), .size = 1 },
+};
+
+static const SdsAggregateMeta SUMMARY_AGGREGATES[] = {
+    { "devices", SDS_AGG_COUNT, NULL, 0 },
+    { "online_count", SDS_AGG_COUNT_ONLINE, NULL, 0 },
+    { "battery_min", SDS_AGG_MIN, "battery_percent", 0 },
+    { "battery_max", SDS_AGG_MAX, "battery_percent", 0 },
+    { "battery_mean", SDS_AGG_MEAN, "battery_percent", 0 },
+    { "uptime_sum", SDS_AGG_SUM, "uptime_seconds", 0 },
+    { "battery_p50", SDS_AGG_PERCENTILE, "battery_percent", 50 },
+    { "battery_p90", SDS_AGG_PERCENTILE, "battery_percent", 90 },
+};
+#define SUMMARY_AGGREGATE_COUNT 8
+
+typedef struct {
+    SummaryStatus status;
+    uint64_t aggregate_storage[SDS_AGGREGATE_BYTES(SUMMARY_AGGREGATE_COUNT, SDS_GENERATED_MAX_NODES) / 8];
+} SummaryTable;
+
+static SensorDataOwnerTable g_sensor;
+static SummaryTable g_summary;
+
+static SdsError init_bridge(void) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+    sds_mock_set_time(10000);
+
+    SdsConfig config = {
+        .node_id = "bridge",
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .eviction_grace_ms = GRACE_MS,
+    };
+
+    memset(&g_sensor, 0, sizeof(g_sensor));
+    memset(&g_summary, 0, sizeof(g_summary));
+    return sds_init(&config);
+}
+
+static SdsError register_sensor(void) {
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    return sds_register_table(&g_sensor, "SensorData", SDS_ROLE_OWNER, &opts);
+}
+
+static SdsError register_summary_table(void) {
+    SdsTableOptions opts = { .sync_interval_ms = SUMMARY_SYNC_MS };
+    SdsError err = sds_register_table_ex(
+        &g_summary, "Summary", SDS_ROLE_DEVICE, &opts,
+        0, 0, 0, 0,
+        offsetof(SummaryTable, status), sizeof(SummaryStatus),
+        NULL, NULL, NULL, NULL, NULL, NULL);
+    if (err != SDS_OK) return err;
+    return sds_set_table_fields("Summary", NULL, 0, NULL, 0, SUMMARY_FIELDS, SUMMARY_AGGREGATE_COUNT);
+}
+
+static SdsError attach_aggregates(void) {
+    return sds_set_table_aggregates("Summary", "SensorData", SUMMARY_AGGREGATES, SUMMARY_AGGREGATE_COUNT,
+                                    g_summary.aggregate_storage, sizeof(g_summary.aggregate_storage));
+}
+
+static SdsError init_bridge_with_summary(void) {
+    SdsError err = init_bridge();
+    if (err == SDS_OK) err = register_sensor();
+    if (err == SDS_OK) err = register_summary_table();
+    if (err == SDS_OK) err = attach_aggregates();
+    return err;
+}
+
+static void inject_sensor_status(const char* node, int battery, int uptime) {
+    char topic[64];
+    char payload[128];
+    snprintf(topic, sizeof(topic), "sds/SensorData/status/%s", node);
+    snprintf(payload, sizeof(payload),
+             "{\"ts\":1,\"online\":true,\"error_code\":0,\"battery_percent\":%d,\"uptime_seconds\":%d}",
+             battery, uptime);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+static void inject_lwt(const char* node) {
+    char topic[64];
+    char payload[96];
+    snprintf(topic, sizeof(topic), "sds/lwt/%s", node);
+    snprintf(payload, sizeof(payload), "{\"online\":false,\"node\":\"%s\",\"ts\":0}", node);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+/* Run the summary's next sync */
+static void sync_summary(void) {
+    sds_mock_advance_time(SUMMARY_SYNC_MS);
+    sds_loop();
+}
+
+static size_t summary_publishes(void) {
+    size_t n = 0;
+    for (size_t i = 0; i < sds_mock_get_publish_count(); i++) {
+        if (strcmp(sds_mock_get_publish(i)->topic, "sds/Summary/status/bridge") == 0) n++;
+    }
+    return n;
+}
+
+/* ============== Storage Tests ============== */
+
+TEST(storage_size_matches_macro) {
+    ASSERT_EQ(init_bridge(), SDS_OK);
+
+    /* Percentiles need the source's slot count */
+    ASSERT_EQ(sds_aggregate_storage_size("SensorData", SUMMARY_AGGREGATES, 2), SDS_AGGREGATE_BYTES(2, 0));
+    ASSERT_EQ(sds_aggregate_storage_size("SensorData", SUMMARY_AGGREGATES, SUMMARY_AGGREGATE_COUNT), 0);
+    ASSERT_EQ(register_sensor(), SDS_OK);
+    ASSERT_EQ(sds_aggregate_storage_size("SensorData", SUMMARY_AGGREGATES, SUMMARY_AGGREGATE_COUNT),
+              sizeof(g_summary.aggregate_storage));
+    ASSERT_EQ(sds_aggregate_storage_size("SensorData", NULL, 0), 0);
+}
+
+TEST(attach_checks_arguments) {
+    ASSERT_EQ(init_bridge(), SDS_OK);
+    ASSERT_EQ(register_sensor(), SDS_OK);
+    ASSERT_EQ(register_summary_table(), SDS_OK);
+
+    uint64_t* storage = g_summary.aggregate_storage;
+    size_t size = sizeof(g_summary.aggregate_storage);
+    const SdsAggregateMeta* aggs = SUMMARY_AGGREGATES;
+
+    ASSERT_EQ(sds_set_table_aggregates("Unknown", "SensorData", aggs, 2, storage, size),
+              SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT_EQ(sds_set_table_aggregates("SensorData", "Summary", aggs, 2, storage, size),
+              SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT_EQ(sds_set_table_aggregates("Summary", "Summary", aggs, 2, storage, size),
+              SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_table_aggregates("Summary", "SensorData", aggs, 2, (uint8_t*)storage + 4, size - 8),
+              SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_table_aggregates("Summary", "SensorData", aggs, 2, storage,
+                                       SDS_AGGREGATE_BYTES(2, 0) - 1), SDS_ERR_BUFFER_FULL);
+
+    /* Percentile scratch below the source's slot count */
+    ASSERT_EQ(sds_set_table_aggregates("Summary", "SensorData", aggs, SUMMARY_AGGREGATE_COUNT, storage,
+                                       SDS_AGGREGATE_BYTES(SUMMARY_AGGREGATE_COUNT, 4)), SDS_ERR_BUFFER_FULL);
+
+    static const SdsAggregateMeta bad_target[] = { { "missing", SDS_AGG_COUNT, NULL, 0 } };
+    static const SdsAggregateMeta bad_source[] = { { "battery_max", SDS_AGG_MAX, "missing", 0 } };
+    static const SdsAggregateMeta no_source[] = { { "battery_max", SDS_AGG_MAX, NULL, 0 } };
+    static const SdsAggregateMeta bad_rank[] = { { "battery_p50", SDS_AGG_PERCENTILE, "battery_percent", 0 } };
+    ASSERT_EQ(sds_set_table_aggregates("Summary", "SensorData", bad_target, 1, storage, size),
+              SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_table_aggregates("Summary", "SensorData", bad_source, 1, storage, size),
+              SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_table_aggregates("Summary", "SensorData", no_source, 1, storage, size),
+              SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_table_aggregates("Summary", "SensorData", bad_rank, 1, storage, size),
+              SDS_ERR_INVALID_CONFIG);
+
+    ASSERT_EQ(attach_aggregates(), SDS_OK);
+    ASSERT_EQ(sds_set_table_aggregates("Summary", NULL, NULL, 0, NULL, 0), SDS_OK);
+}
+
+TEST(source_feeds_one_summary) {
+    ASSERT_EQ(init_bridge_with_summary(), SDS_OK);
+
+    static SummaryTable other;
+    memset(&other, 0, sizeof(other));
+    ASSERT_EQ(sds_register_table_ex(&other, "Other", SDS_ROLE_DEVICE, NULL, 0, 0, 0, 0,
+                                    offsetof(SummaryTable, status), sizeof(SummaryStatus),
+                                    NULL, NULL, NULL, NULL, NULL, NULL), SDS_OK);
+    ASSERT_EQ(sds_set_table_fields("Other", NULL, 0, NULL, 0, SUMMARY_FIELDS, SUMMARY_AGGREGATE_COUNT), SDS_OK);
+    ASSERT_EQ(sds_set_table_aggregates("Other", "SensorData", SUMMARY_AGGREGATES, 2,
+                                       other.aggregate_storage, sizeof(other.aggregate_storage)),
+              SDS_ERR_INVALID_CONFIG);
+}
+
+/* ============== Count Tests ============== */
+
+TEST(counts_follow_status_lwt_and_eviction) {
+    ASSERT_EQ(init_bridge_with_summary(), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    inject_sensor_status("dev_b", 60, 200);
+    inject_sensor_status("dev_c", 40, 300);
+    inject_sensor_status("dev_a", 81, 101);  /* Update, not a new device */
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 3);
+    ASSERT_EQ(g_summary.status.online_count, 3);
+
+    inject_lwt("dev_b");
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 3);
+    ASSERT_EQ(g_summary.status.online_count, 2);
+
+    sds_mock_advance_time(GRACE_MS);
+    sds_loop();
+    ASSERT_EQ(g_sensor.status_count, 2);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 2);
+    ASSERT_EQ(g_summary.status.online_count, 2);
+}
+
+TEST(empty_source_reads_zero) {
+    ASSERT_EQ(init_bridge_with_summary(), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_max, 80);
+
+    inject_lwt("dev_a");
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 1);
+    ASSERT_EQ(g_summary.status.online_count, 0);
+    ASSERT_EQ(g_summary.status.battery_max, 0);
+    ASSERT_EQ(g_summary.status.battery_mean, 0.0f);
+    ASSERT_EQ(g_summary.status.battery_p90, 0);
+}
+
+/* ============== Value Tests ============== */
+
+TEST(extremes_follow_departures) {
+    ASSERT_EQ(init_bridge_with_summary(), SDS_OK);
+
+    inject_sensor_status("dev_a", 20, 1);
+    inject_sensor_status("dev_b", 50, 1);
+    inject_sensor_status("dev_c", 80, 1);
+    inject_sensor_status("dev_d", 80, 1);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_min, 20);
+    ASSERT_EQ(g_summary.status.battery_max, 80);
+
+    /* Another device still holds the max */
+    inject_lwt("dev_c");
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_max, 80);
+
+    inject_sensor_status("dev_d", 70, 1);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_max, 70);
+
+    inject_lwt("dev_a");
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_min, 50);
+
+    /* Back online with a new low */
+    inject_sensor_status("dev_a", 10, 1);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_min, 10);
+    ASSERT_EQ(g_summary.status.battery_max, 70);
+}
+
+TEST(sum_and_mean_track_updates) {
+    ASSERT_EQ(init_bridge_with_summary(), SDS_OK);
+
+    inject_sensor_status("dev_a", 90, 1000);
+    inject_sensor_status("dev_b", 60, 2000);
+    inject_sensor_status("dev_c", 31, 3000);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.uptime_sum, 6000);
+    ASSERT_NEAR(g_summary.status.battery_mean, 60.333333f);
+
+    inject_sensor_status("dev_c", 30, 3500);
+    inject_lwt("dev_a");
+    sync_summary();
+    ASSERT_EQ(g_summary.status.uptime_sum, 5500);
+    ASSERT_NEAR(g_summary.status.battery_mean, 45.0f);
+}
+
+TEST(percentiles_use_nearest_rank) {
+    ASSERT_EQ(init_bridge_with_summary(), SDS_OK);
+
+    /* 10..100 in scrambled order */
+    static const int batteries[] = { 70, 10, 100, 40, 90, 20, 60, 30, 80, 50 };
+    char node[16];
+    for (int i = 0; i < 10; i++) {
+        snprintf(node, sizeof(node), "dev_%d", i);
+        inject_sensor_status(node, batteries[i], 1);
+    }
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_p50, 50);
+    ASSERT_EQ(g_summary.status.battery_p90, 90);
+
+    /* 11 values: rank ceil(0.5 * 11) = 6 */
+    inject_sensor_status("dev_x", 55, 1);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_p50, 55);
+    ASSERT_EQ(g_summary.status.battery_p90, 90);
+
+    inject_sensor_status("dev_y", 5, 1);
+    inject_sensor_status("dev_z", 5, 1);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_p50, 50);
+}
+
+TEST(values_clamped_to_target_type) {
+    ASSERT_EQ(init_bridge(), SDS_OK);
+    ASSERT_EQ(register_sensor(), SDS_OK);
+    ASSERT_EQ(register_summary_table(), SDS_OK);
+
+    /* Summed uptimes overflow a uint8 target */
+    static const SdsAggregateMeta aggs[] = { { "battery_max", SDS_AGG_SUM, "uptime_seconds", 0 } };
+    ASSERT_EQ(sds_set_table_aggregates("Summary", "SensorData", aggs, 1, g_summary.aggregate_storage,
+                                       sizeof(g_summary.aggregate_storage)), SDS_OK);
+    inject_sensor_status("dev_a", 50, 200);
+    inject_sensor_status("dev_b", 50, 300);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.battery_max, 255);
+}
+
+/* ============== Publish Tests ============== */
+
+TEST(summary_publishes_on_its_interval) {
+    ASSERT_EQ(init_bridge_with_summary(), SDS_OK);
+    sds_mock_clear_publishes();
+
+    inject_sensor_status("dev_a", 80, 100);
+    inject_sensor_status("dev_b", 60, 200);
+    for (int i = 0; i < 4; i++) {
+        sds_mock_advance_time(1000);
+        sds_loop();
+        inject_sensor_status("dev_a", 79 - i, 100 + i);
+    }
+    ASSERT_EQ(summary_publishes(), 0);
+
+    sds_mock_advance_time(1000);
+    sds_loop();
+    ASSERT_EQ(summary_publishes(), 1);
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/Summary/status/bridge");
+    ASSERT(msg != NULL);
+    ASSERT(strstr((const char*)msg->payload, "\"online_count\":2") != NULL);
+    ASSERT(strstr((const char*)msg->payload, "\"battery_min\":60") != NULL);
+    ASSERT(strstr((const char*)msg->payload, "\"battery_max\":76") != NULL);
+
+    /* Raw device status is not republished */
+    ASSERT(sds_mock_find_publish_by_topic("sds/SensorData/status/dev_a") == NULL);
+}
+
+TEST(dirty_tracking_marks_changed_aggregates) {
+    ASSERT_EQ(init_bridge(), SDS_OK);
+    ASSERT_EQ(register_sensor(), SDS_OK);
+    SdsTableOptions opts = { .sync_interval_ms = SUMMARY_SYNC_MS, .dirty_tracking = true };
+    ASSERT_EQ(sds_register_table_ex(&g_summary, "Summary", SDS_ROLE_DEVICE, &opts, 0, 0, 0, 0,
+                                    offsetof(SummaryTable, status), sizeof(SummaryStatus),
+                                    NULL, NULL, NULL, NULL, NULL, NULL), SDS_OK);
+    ASSERT_EQ(sds_set_table_fields("Summary", NULL, 0, NULL, 0, SUMMARY_FIELDS, SUMMARY_AGGREGATE_COUNT), SDS_OK);
+    ASSERT_EQ(attach_aggregates(), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    sync_summary();
+    size_t published = summary_publishes();
+    ASSERT(published >= 1);
+
+    /* Same aggregates: nothing marked, nothing sent */
+    inject_sensor_status("dev_a", 80, 100);
+    sync_summary();
+    ASSERT_EQ(summary_publishes(), published);
+
+    inject_sensor_status("dev_a", 81, 100);
+    sync_summary();
+    ASSERT_EQ(summary_publishes(), published + 1);
+    ASSERT(strstr((const char*)sds_mock_get_last_publish()->payload, "\"battery_max\":81") != NULL);
+}
+
+/* ============== Linking Tests ============== */
+
+TEST(links_when_source_registers_later) {
+    ASSERT_EQ(init_bridge(), SDS_OK);
+    ASSERT_EQ(register_summary_table(), SDS_OK);
+    ASSERT_EQ(attach_aggregates(), SDS_OK);
+
+    /* Left alone while the source is missing */
+    g_summary.status.devices = 7;
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 7);
+
+    ASSERT_EQ(register_sensor(), SDS_OK);
+    inject_sensor_status("dev_a", 80, 100);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 1);
+    ASSERT_EQ(g_summary.status.battery_max, 80);
+}
+
+TEST(relinks_after_source_reregisters) {
+    ASSERT_EQ(init_bridge_with_summary(), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    inject_sensor_status("dev_b", 70, 100);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 2);
+
+    ASSERT_EQ(sds_unregister_table("SensorData"), SDS_OK);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 2);
+
+    /* A fresh owner table starts without devices */
+    memset(&g_sensor, 0, sizeof(g_sensor));
+    ASSERT_EQ(register_sensor(), SDS_OK);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 0);
+
+    inject_sensor_status("dev_c", 40, 100);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 1);
+    ASSERT_EQ(g_summary.status.battery_max, 40);
+}
+
+TEST(summary_unregister_stops_updates) {
+    ASSERT_EQ(init_bridge_with_summary(), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    ASSERT_EQ(sds_unregister_table("Summary"), SDS_OK);
+    inject_sensor_status("dev_b", 70, 100);
+    inject_lwt("dev_a");
+    sync_summary();
+    ASSERT_EQ(g_sensor.status_count, 2);
+    ASSERT_EQ(g_summary.status.devices, 0);
+}
+
+/* ============== Registry Tests ============== */
+
+TEST(registry_attaches_aggregates) {
+    static SdsTableMeta registry[2];
+    registry[0] = SDS_TABLE_REGISTRY[0];
+    registry[1] = (SdsTableMeta){
+        .table_type = "Summary",
+        .sync_interval_ms = SUMMARY_SYNC_MS,
+        .liveness_interval_ms = 30000,
+        .device_table_size = sizeof(SummaryTable),
+        .dev_status_offset = offsetof(SummaryTable, status),
+        .dev_status_size = sizeof(SummaryStatus),
+        .status_fields = SUMMARY_FIELDS,
+        .status_field_count = SUMMARY_AGGREGATE_COUNT,
+        .aggregate_source = "SensorData",
+        .aggregates = SUMMARY_AGGREGATES,
+        .aggregate_count = SUMMARY_AGGREGATE_COUNT,
+        .aggregate_storage_offset = offsetof(SummaryTable, aggregate_storage),
+        .aggregate_storage_size = sizeof(((SummaryTable*)0)->aggregate_storage),
+    };
+    sds_set_table_registry(registry, 2);
+
+    ASSERT_EQ(init_bridge(), SDS_OK);
+    SdsTableOptions opts = { .sync_interval_ms = SUMMARY_SYNC_MS };
+    ASSERT_EQ(sds_register_table(&g_summary, "Summary", SDS_ROLE_DEVICE, &opts), SDS_OK);
+    ASSERT_EQ(register_sensor(), SDS_OK);
+
+    inject_sensor_status("dev_a", 30, 100);
+    inject_sensor_status("dev_b", 90, 100);
+    sync_summary();
+    ASSERT_EQ(g_summary.status.devices, 2);
+    ASSERT_EQ(g_summary.status.battery_min, 30);
+    ASSERT_EQ(g_summary.status.battery_p50, 30);
+    ASSERT_NEAR(g_summary.status.battery_mean, 60.0f);
+}
+
+TEST(registry_aggregate_error_fails_registration) {
+    static SdsTableMeta registry[2];
+    registry[0] = SDS_TABLE_REGISTRY[0];
+    registry[1] = (SdsTableMeta){
+        .table_type = "Summary",
+        .sync_interval_ms = SUMMARY_SYNC_MS,
+        .liveness_interval_ms = 30000,
+        .device_table_size = sizeof(SummaryTable),
+        .dev_status_offset = offsetof(SummaryTable, status),
+        .dev_status_size = sizeof(SummaryStatus),
+        .status_fields = SUMMARY_FIELDS,
+        .status_field_count = SUMMARY_AGGREGATE_COUNT,
+        .aggregate_source = "SensorData",
+        .aggregates = SUMMARY_AGGREGATES,
+        .aggregate_count = SUMMARY_AGGREGATE_COUNT,
+        .aggregate_storage_offset = offsetof(SummaryTable, aggregate_storage),
+        .aggregate_storage_size = SDS_AGGREGATE_BYTES(SUMMARY_AGGREGATE_COUNT, 0) - 1,
+    };
+    sds_set_table_registry(registry, 2);
+
+    ASSERT_EQ(init_bridge(), SDS_OK);
+    uint8_t tables = sds_get_table_count();
+    SdsTableOptions opts = { .sync_interval_ms = SUMMARY_SYNC_MS };
+    ASSERT_EQ(sds_register_table(&g_summary, "Summary", SDS_ROLE_DEVICE, &opts), SDS_ERR_BUFFER_FULL);
+    ASSERT_EQ(sds_get_table_count(), tables);
+
+    /* The slot is free for a registration that fits */
+    registry[1].aggregate_storage_size = sizeof(((SummaryTable*)0)->aggregate_storage);
+    ASSERT_EQ(sds_register_table(&g_summary, "Summary", SDS_ROLE_DEVICE, &opts), SDS_OK);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║                Aggregate Tests (Mock Platform)               ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Storage Tests ───\n");
+    RUN_TEST(storage_size_matches_macro);
+    RUN_TEST(attach_checks_arguments);
+    RUN_TEST(source_feeds_one_summary);
+
+    printf("\n─── Count Tests ───\n");
+    RUN_TEST(counts_follow_status_lwt_and_eviction);
+    RUN_TEST(empty_source_reads_zero);
+
+    printf("\n─── Value Tests ───\n");
+    RUN_TEST(extremes_follow_departures);
+    RUN_TEST(sum_and_mean_track_updates);
+    RUN_TEST(percentiles_use_nearest_rank);
+    RUN_TEST(values_clamped_to_target_type);
+
+    printf("\n─── Publish Tests ───\n");
+    RUN_TEST(summary_publishes_on_its_interval);
+    RUN_TEST(dirty_tracking_marks_changed_aggregates);
+
+    printf("\n─── Linking Tests ───\n");
+    RUN_TEST(links_when_source_registers_later);
+    RUN_TEST(relinks_after_source_reregisters);
+    RUN_TEST(summary_unregister_stops_updates);
+
+    printf("\n─── Registry Tests ───\n");
+    RUN_TEST(registry_attaches_aggregates);
+    RUN_TEST(registry_aggregate_error_fails_registration);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
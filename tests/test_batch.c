@@ -0,0 +1,527 @@
+/*
+ * test_batch.c - Batch Envelope Tests
+ *
+ * Tests batched state/status publishing with the mock platform:
+ * - Table syncs of one sds_loop() share one sds/batch/{node} message
+ * - Size limit, flush interval and repeated topics start a new envelope
+ * - Gateways relay other nodes' messages with sds_publish_batched()
+ * - Owners subscribe to sds/batch/+ and apply every record
+ * - Malformed envelopes keep the records before the damage
+ *
+ * Build:
+ *   gcc -I../include -o test_batch test_batch.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_batch
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+#define BATCH_TOPIC "sds/batch/dev1"
+#define STATUS_JSON "{\"ts\":1,\"online\":true,\"error_code\":0,\"battery_percent\":%d,\"uptime_seconds\":5}"
+
+static SensorDataTable g_sensor_dev;
+static ActuatorDataTable g_actuator_dev;
+static SensorDataOwnerTable g_sensor_owner;
+
+static SdsError init_node(const char* node_id, uint16_t batch_bytes, uint32_t flush_ms) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .batch_max_bytes = batch_bytes,
+        .batch_flush_ms = flush_ms,
+    };
+
+    return sds_init(&config);
+}
+
+/* Device node with two tables that sync on the same tick */
+static SdsError init_device(uint16_t batch_bytes, uint32_t flush_ms) {
+    SdsError err = init_node("dev1", batch_bytes, flush_ms);
+    if (err != SDS_OK) return err;
+
+    memset(&g_sensor_dev, 0, sizeof(g_sensor_dev));
+    memset(&g_actuator_dev, 0, sizeof(g_actuator_dev));
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    err = sds_register_table(&g_sensor_dev, "SensorData", SDS_ROLE_DEVICE, &opts);
+    if (err != SDS_OK) return err;
+    return sds_register_table(&g_actuator_dev, "ActuatorData", SDS_ROLE_DEVICE, &opts);
+}
+
+static SdsError init_owner(uint16_t batch_bytes) {
+    SdsError err = init_node("owner1", batch_bytes, 0);
+    if (err != SDS_OK) return err;
+
+    memset(&g_sensor_owner, 0, sizeof(g_sensor_owner));
+    return sds_register_table(&g_sensor_owner, "SensorData", SDS_ROLE_OWNER, NULL);
+}
+
+/* Change both tables and run the sync tick */
+static void sync_device(void) {
+    g_sensor_dev.state.temperature += 1.0f;
+    g_sensor_dev.status.battery_percent++;
+    g_actuator_dev.status.motor_status++;
+    sds_mock_advance_time(1000);
+    sds_loop();
+}
+
+static size_t count_publishes(const char* prefix) {
+    size_t n = 0;
+    for (size_t i = 0; i < sds_mock_get_publish_count(); i++) {
+        if (strncmp(sds_mock_get_publish(i)->topic, prefix, strlen(prefix)) == 0) n++;
+    }
+    return n;
+}
+
+static size_t get_varint(const uint8_t* buf, size_t len, size_t* pos) {
+    size_t v = 0;
+    for (int shift = 0; *pos < len; shift += 7) {
+        uint8_t b = buf[(*pos)++];
+        v |= (size_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) break;
+    }
+    return v;
+}
+
+/*
+ * Walk an envelope's records. Returns the number of records, or -1 if it is
+ * malformed; copies the topic of record `want` (if any) into topic.
+ */
+static int batch_records(const SdsMockPublishedMessage* msg, int want, char* topic, size_t topic_size) {
+    const uint8_t* p = msg->payload;
+    size_t len = msg->payload_len;
+    size_t pos = 2;
+    int count = 0;
+
+    if (len < 2 || p[0] != 0xB6 || p[1] != 1) return -1;
+
+    while (pos < len) {
+        size_t n = get_varint(p, len, &pos);
+        if (n > len - pos) return -1;
+        if (count == want && topic) {
+            snprintf(topic, topic_size, "%.*s", (int)n, (const char*)p + pos);
+        }
+        pos += n;
+        n = get_varint(p, len, &pos);
+        if (n > len - pos) return -1;
+        pos += n;
+        count++;
+    }
+    return count;
+}
+
+static bool batch_has_record(const SdsMockPublishedMessage* msg, const char* topic) {
+    char name[SDS_TOPIC_BUFFER_SIZE];
+    int count = batch_records(msg, -1, NULL, 0);
+    for (int i = 0; i < count; i++) {
+        batch_records(msg, i, name, sizeof(name));
+        if (strcmp(name, topic) == 0) return true;
+    }
+    return false;
+}
+
+/* Append one record to a hand-built envelope (lengths below 128) */
+static size_t put_record(uint8_t* buf, size_t pos, const char* topic, const char* payload) {
+    size_t topic_len = strlen(topic);
+    size_t payload_len = strlen(payload);
+    buf[pos++] = (uint8_t)topic_len;
+    memcpy(buf + pos, topic, topic_len);
+    pos += topic_len;
+    buf[pos++] = (uint8_t)payload_len;
+    memcpy(buf + pos, payload, payload_len);
+    return pos + payload_len;
+}
+
+static const SensorDataStatus* owner_status(const char* node) {
+    return (const SensorDataStatus*)sds_find_node_status(&g_sensor_owner, "SensorData", node);
+}
+
+/* ============== Sender Tests ============== */
+
+TEST(disabled_publishes_each_message) {
+    ASSERT_EQ(init_device(0, 0), SDS_OK);
+    sds_mock_clear_publishes();
+
+    sync_device();
+
+    ASSERT_EQ(count_publishes("sds/batch/"), 0);
+    ASSERT(sds_mock_find_publish_by_topic("sds/SensorData/state") != NULL);
+    ASSERT(sds_mock_find_publish_by_topic("sds/ActuatorData/status/dev1") != NULL);
+    ASSERT_EQ(sds_get_stats()->batches_sent, 0);
+}
+
+TEST(loop_syncs_share_one_envelope) {
+    ASSERT_EQ(init_device(1024, 0), SDS_OK);
+    sds_mock_clear_publishes();
+
+    sync_device();
+
+    ASSERT_EQ(sds_mock_get_publish_count(), 1);
+    const SdsMockPublishedMessage* msg = sds_mock_get_last_publish();
+    ASSERT_EQ(strcmp(msg->topic, BATCH_TOPIC), 0);
+    ASSERT(!msg->retained);
+    ASSERT(batch_has_record(msg, "SensorData/state"));
+    ASSERT(batch_has_record(msg, "SensorData/status/dev1"));
+    ASSERT(batch_has_record(msg, "ActuatorData/status/dev1"));
+
+    int records = batch_records(msg, -1, NULL, 0);
+    ASSERT(records >= 3);
+    ASSERT_EQ(sds_get_stats()->batches_sent, 1);
+    ASSERT_EQ(sds_get_stats()->batched_messages, (uint32_t)records);
+}
+
+TEST(size_limit_splits_envelopes) {
+    ASSERT_EQ(init_device(160, 0), SDS_OK);
+    sds_mock_clear_publishes();
+
+    sync_device();
+
+    size_t envelopes = count_publishes("sds/batch/");
+    ASSERT(envelopes >= 2);
+    ASSERT_EQ(envelopes, sds_mock_get_publish_count());
+
+    uint32_t records = 0;
+    for (size_t i = 0; i < envelopes; i++) {
+        const SdsMockPublishedMessage* msg = sds_mock_get_publish(i);
+        ASSERT(msg->payload_len <= 160);
+        int n = batch_records(msg, -1, NULL, 0);
+        ASSERT(n > 0);
+        records += (uint32_t)n;
+    }
+    ASSERT_EQ(sds_get_stats()->batches_sent, (uint32_t)envelopes);
+    ASSERT_EQ(sds_get_stats()->batched_messages, records);
+}
+
+TEST(oversized_message_bypasses_envelope) {
+    ASSERT_EQ(init_device(24, 0), SDS_OK);
+    sds_mock_clear_publishes();
+
+    sync_device();
+
+    /* No section fits in 24 bytes, so each goes out on its own topic */
+    ASSERT_EQ(count_publishes("sds/batch/"), 0);
+    ASSERT(sds_mock_find_publish_by_topic("sds/SensorData/status/dev1") != NULL);
+}
+
+TEST(flush_interval_holds_envelope) {
+    ASSERT_EQ(init_device(1024, 200), SDS_OK);
+    sds_mock_clear_publishes();
+
+    sync_device();
+    ASSERT_EQ(sds_mock_get_publish_count(), 0);
+    ASSERT(sds_next_deadline_ms() <= 200);
+
+    sds_mock_advance_time(199);
+    sds_loop();
+    ASSERT_EQ(sds_mock_get_publish_count(), 0);
+
+    sds_mock_advance_time(1);
+    sds_loop();
+    ASSERT_EQ(sds_mock_get_publish_count(), 1);
+    ASSERT_EQ(strcmp(sds_mock_get_last_publish()->topic, BATCH_TOPIC), 0);
+}
+
+TEST(relayed_messages_join_envelope) {
+    ASSERT_EQ(init_node("dev1", 1024, 0), SDS_OK);
+    char payload[128];
+
+    snprintf(payload, sizeof(payload), STATUS_JSON, 50);
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/status/leaf1", payload, strlen(payload)), SDS_OK);
+    snprintf(payload, sizeof(payload), STATUS_JSON, 60);
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/status/leaf2", payload, strlen(payload)), SDS_OK);
+
+    ASSERT_EQ(sds_mock_get_publish_count(), 0);
+    ASSERT_EQ(sds_next_deadline_ms(), 0);
+
+    sds_loop();
+
+    ASSERT_EQ(sds_mock_get_publish_count(), 1);
+    const SdsMockPublishedMessage* msg = sds_mock_get_last_publish();
+    ASSERT_EQ(batch_records(msg, -1, NULL, 0), 2);
+    ASSERT(batch_has_record(msg, "SensorData/status/leaf1"));
+    ASSERT(batch_has_record(msg, "SensorData/status/leaf2"));
+}
+
+TEST(repeated_topic_starts_new_envelope) {
+    ASSERT_EQ(init_node("dev1", 1024, 0), SDS_OK);
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/state", "{\"temperature\":1}", 17), SDS_OK);
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/state", "{\"temperature\":2}", 17), SDS_OK);
+
+    /* The first envelope went out when the topic came round again */
+    ASSERT_EQ(sds_mock_get_publish_count(), 1);
+    ASSERT_EQ(sds_flush_batch(), SDS_OK);
+    ASSERT_EQ(sds_mock_get_publish_count(), 2);
+
+    for (size_t i = 0; i < 2; i++) {
+        const SdsMockPublishedMessage* msg = sds_mock_get_publish(i);
+        ASSERT_EQ(batch_records(msg, 0, topic, sizeof(topic)), 1);
+        ASSERT_EQ(strcmp(topic, "SensorData/state"), 0);
+        ASSERT(memchr(msg->payload, i == 0 ? '1' : '2', msg->payload_len) != NULL);
+    }
+
+    /* Nothing pending: flushing again publishes nothing */
+    ASSERT_EQ(sds_flush_batch(), SDS_OK);
+    ASSERT_EQ(sds_mock_get_publish_count(), 2);
+}
+
+TEST(envelope_carved_from_table_arena) {
+    static uint64_t arena[16384 / 8];
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    size_t sections = sizeof(SensorDataConfig) + sizeof(SensorDataState) + sizeof(SensorDataStatus);
+    SdsConfig config = {
+        .node_id = "dev1",
+        .mqtt_broker = "mock_broker",
+        .batch_max_bytes = 256,
+        .table_arena = arena,
+        .max_tables = 1,
+    };
+
+    /* Room for the table only: the envelope does not fit */
+    config.table_arena_size = sds_table_arena_size(1, sections);
+    ASSERT_EQ(sds_init(&config), SDS_ERR_INVALID_CONFIG);
+
+    config.table_arena_size = sds_config_arena_size(&config, sections);
+    ASSERT(config.table_arena_size <= sizeof(arena));
+    ASSERT(config.table_arena_size >= sds_table_arena_size(1, sections) + 256);
+    ASSERT_EQ(sds_init(&config), SDS_OK);
+
+    memset(&g_sensor_dev, 0, sizeof(g_sensor_dev));
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    ASSERT_EQ(sds_register_table(&g_sensor_dev, "SensorData", SDS_ROLE_DEVICE, &opts), SDS_OK);
+    sds_mock_clear_publishes();
+
+    g_sensor_dev.state.temperature += 1.0f;
+    sds_mock_advance_time(1000);
+    sds_loop();
+
+    ASSERT_EQ(count_publishes("sds/batch/"), 1);
+    ASSERT(batch_has_record(sds_mock_find_publish_by_topic(BATCH_TOPIC), "SensorData/state"));
+}
+
+TEST(publish_batched_checks_topic) {
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/state", "{}", 2), SDS_ERR_NOT_INITIALIZED);
+    ASSERT_EQ(sds_flush_batch(), SDS_ERR_NOT_INITIALIZED);
+
+    ASSERT_EQ(init_node("dev1", 1024, 0), SDS_OK);
+
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/config", "{}", 2), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/status/", "{}", 2), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/status/a/b", "{}", 2), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_publish_batched("sds//state", "{}", 2), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_publish_batched("sensors/state", "{}", 2), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/state", NULL, 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_publish_batched(NULL, "{}", 2), SDS_ERR_INVALID_CONFIG);
+
+    static char big[SDS_MSG_BUFFER_SIZE + 1];
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/state", big, sizeof(big)), SDS_ERR_BUFFER_FULL);
+
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/state", "{}", 2), SDS_OK);
+}
+
+TEST(publish_batched_without_batching_publishes_topic) {
+    ASSERT_EQ(init_node("gw1", 0, 0), SDS_OK);
+    sds_mock_clear_publishes();
+
+    ASSERT_EQ(sds_publish_batched("sds/SensorData/status/leaf1", "{}", 2), SDS_OK);
+
+    ASSERT_EQ(sds_mock_get_publish_count(), 1);
+    ASSERT_EQ(strcmp(sds_mock_get_last_publish()->topic, "sds/SensorData/status/leaf1"), 0);
+}
+
+/* ============== Receiver Tests ============== */
+
+TEST(owner_subscribes_when_batching) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT(!sds_mock_is_subscribed("sds/batch/+"));
+    sds_shutdown();
+
+    sds_mock_reset();
+    ASSERT_EQ(init_owner(1024), SDS_OK);
+    ASSERT(sds_mock_is_subscribed("sds/batch/+"));
+
+    ASSERT_EQ(sds_unregister_table("SensorData"), SDS_OK);
+    ASSERT(!sds_mock_is_subscribed("sds/batch/+"));
+}
+
+TEST(device_does_not_subscribe) {
+    ASSERT_EQ(init_device(1024, 0), SDS_OK);
+    ASSERT(!sds_mock_is_subscribed("sds/batch/+"));
+}
+
+TEST(owner_applies_device_envelope) {
+    /* Capture what a batching device publishes */
+    ASSERT_EQ(init_device(1024, 0), SDS_OK);
+    g_sensor_dev.status.battery_percent = 41;
+    sds_mock_clear_publishes();
+    sds_mock_advance_time(1000);
+    sds_loop();
+    ASSERT_EQ(sds_mock_get_publish_count(), 1);
+
+    static SdsMockPublishedMessage envelope;
+    envelope = *sds_mock_get_last_publish();
+    sds_shutdown();
+
+    sds_mock_reset();
+    ASSERT_EQ(init_owner(1024), SDS_OK);
+    sds_mock_inject_message(envelope.topic, envelope.payload, envelope.payload_len);
+
+    const SensorDataStatus* status = owner_status("dev1");
+    ASSERT(status != NULL);
+    ASSERT_EQ(status->battery_percent, 41);
+}
+
+TEST(owner_applies_relayed_records) {
+    ASSERT_EQ(init_owner(1024), SDS_OK);
+
+    uint8_t buf[512] = { 0xB6, 1 };
+    char payload[128];
+    size_t len = 2;
+    snprintf(payload, sizeof(payload), STATUS_JSON, 70);
+    len = put_record(buf, len, "SensorData/status/leaf1", payload);
+    len = put_record(buf, len, "Unknown/status/leaf1", payload);
+    snprintf(payload, sizeof(payload), STATUS_JSON, 80);
+    len = put_record(buf, len, "SensorData/status/leaf2", payload);
+
+    sds_mock_inject_message("sds/batch/gw1", buf, len);
+
+    ASSERT(owner_status("leaf1") != NULL);
+    ASSERT_EQ(owner_status("leaf1")->battery_percent, 70);
+    ASSERT(owner_status("leaf2") != NULL);
+    ASSERT_EQ(owner_status("leaf2")->battery_percent, 80);
+    ASSERT_EQ(sds_get_stats()->messages_received, 1);
+}
+
+TEST(truncated_envelope_keeps_complete_records) {
+    ASSERT_EQ(init_owner(1024), SDS_OK);
+
+    uint8_t buf[512] = { 0xB6, 1 };
+    char payload[128];
+    size_t len = 2;
+    snprintf(payload, sizeof(payload), STATUS_JSON, 70);
+    len = put_record(buf, len, "SensorData/status/leaf1", payload);
+    len = put_record(buf, len, "SensorData/status/leaf2", payload);
+
+    sds_mock_inject_message("sds/batch/gw1", buf, len - 10);
+
+    ASSERT(owner_status("leaf1") != NULL);
+    ASSERT(owner_status("leaf2") == NULL);
+}
+
+TEST(unknown_envelope_version_ignored) {
+    ASSERT_EQ(init_owner(1024), SDS_OK);
+
+    uint8_t buf[512] = { 0xB6, 2 };
+    char payload[128];
+    snprintf(payload, sizeof(payload), STATUS_JSON, 70);
+    size_t len = put_record(buf, 2, "SensorData/status/leaf1", payload);
+
+    sds_mock_inject_message("sds/batch/gw1", buf, len);
+    ASSERT(owner_status("leaf1") == NULL);
+
+    sds_mock_inject_message("sds/batch/gw1", buf, 0);
+    ASSERT(owner_status("leaf1") == NULL);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║            Batch Envelope Tests (Mock Platform)              ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Sender Tests ───\n");
+    RUN_TEST(disabled_publishes_each_message);
+    RUN_TEST(loop_syncs_share_one_envelope);
+    RUN_TEST(size_limit_splits_envelopes);
+    RUN_TEST(oversized_message_bypasses_envelope);
+    RUN_TEST(flush_interval_holds_envelope);
+    RUN_TEST(relayed_messages_join_envelope);
+    RUN_TEST(repeated_topic_starts_new_envelope);
+    RUN_TEST(envelope_carved_from_table_arena);
+    RUN_TEST(publish_batched_checks_topic);
+    RUN_TEST(publish_batched_without_batching_publishes_topic);
+
+    printf("\n─── Receiver Tests ───\n");
+    RUN_TEST(owner_subscribes_when_batching);
+    RUN_TEST(device_does_not_subscribe);
+    RUN_TEST(owner_applies_device_envelope);
+    RUN_TEST(owner_applies_relayed_records);
+    RUN_TEST(truncated_envelope_keeps_complete_records);
+    RUN_TEST(unknown_envelope_version_ignored);
+
+    printf("\n");
+    printf("════════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("════════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -0,0 +1,398 @@
+/*
+ * test_cluster.c - Owner Cluster Tests
+ *
+ * Tests SdsConfig.cluster_members / cluster_member / cluster_group:
+ * - Rendezvous assignment is stable, balanced, and moves few devices on resize
+ * - Each member tracks only its own devices (status, state, LWT)
+ * - The members of a cluster together track every device exactly once
+ * - sds_set_cluster_membership() hands off devices that moved
+ * - Shared-subscription mode subscribes through $share/{group}/
+ * - Invalid cluster settings are rejected
+ *
+ * Build:
+ *   gcc -I../include -o test_cluster test_cluster.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_cluster
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+#define NUM_NODES 12
+
+static SensorDataOwnerTable g_owner;
+static int g_state_callbacks = 0;
+static int g_evictions = 0;
+
+static void on_state(const char* table_type, const char* from_node, void* user_data) {
+    (void)table_type;
+    (void)from_node;
+    (void)user_data;
+    g_state_callbacks++;
+}
+
+static void on_evicted(const char* table_type, const char* node_id, void* user_data) {
+    (void)table_type;
+    (void)node_id;
+    (void)user_data;
+    g_evictions++;
+}
+
+static void node_name(char* buf, size_t size, int i) {
+    snprintf(buf, size, "dev_%02d", i);
+}
+
+static SdsError init_node(const char* group, uint8_t members, uint8_t member) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = "owner",
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .eviction_grace_ms = 5000,
+        .cluster_group = group,
+        .cluster_members = members,
+        .cluster_member = member,
+    };
+    return sds_init(&config);
+}
+
+/* Start a cluster member owning SensorData */
+static SdsError start_member(uint8_t members, uint8_t member) {
+    SdsError err = init_node(NULL, members, member);
+    if (err != SDS_OK) return err;
+
+    memset(&g_owner, 0, sizeof(g_owner));
+    g_state_callbacks = 0;
+    g_evictions = 0;
+    err = sds_register_table(&g_owner, "SensorData", SDS_ROLE_OWNER, NULL);
+    if (err != SDS_OK) return err;
+    sds_on_state_update("SensorData", on_state, NULL);
+    sds_on_device_evicted(NULL, on_evicted, NULL);
+    return SDS_OK;
+}
+
+static void inject_status(const char* node_id) {
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+    snprintf(topic, sizeof(topic), "sds/SensorData/status/%s", node_id);
+    sds_mock_inject_message_str(topic,
+        "{\"ts\":1000,\"online\":true,\"error_code\":0,\"battery_percent\":80,\"uptime_seconds\":5}");
+}
+
+static bool tracks(const char* node_id) {
+    return sds_find_node_status(&g_owner, "SensorData", node_id) != NULL;
+}
+
+/* ============== Tests: Assignment ============== */
+
+TEST(assignment_is_balanced) {
+    ASSERT_EQ(init_node(NULL, 4, 0), SDS_OK);
+
+    int counts[4] = { 0 };
+    char name[16];
+    for (int i = 0; i < 400; i++) {
+        node_name(name, sizeof(name), i);
+        uint8_t m = sds_cluster_member_for(name);
+        ASSERT(m < 4);
+        ASSERT_EQ(sds_cluster_member_for(name), m);
+        counts[m]++;
+    }
+    for (int m = 0; m < 4; m++) {
+        ASSERT(counts[m] > 60 && counts[m] < 140);
+    }
+}
+
+TEST(resize_moves_devices_only_to_new_member) {
+    ASSERT_EQ(init_node(NULL, 4, 0), SDS_OK);
+
+    uint8_t before[400];
+    char name[16];
+    for (int i = 0; i < 400; i++) {
+        node_name(name, sizeof(name), i);
+        before[i] = sds_cluster_member_for(name);
+    }
+
+    ASSERT_EQ(sds_set_cluster_membership(5, 0), SDS_OK);
+    int moved = 0;
+    for (int i = 0; i < 400; i++) {
+        node_name(name, sizeof(name), i);
+        uint8_t after = sds_cluster_member_for(name);
+        if (after != before[i]) {
+            ASSERT_EQ(after, 4);
+            moved++;
+        }
+    }
+    /* About a fifth of the devices move to the new member */
+    ASSERT(moved > 40 && moved < 120);
+}
+
+TEST(partitioning_off_tracks_everything) {
+    ASSERT_EQ(start_member(0, 0), SDS_OK);
+    ASSERT_EQ(sds_cluster_member_for("dev_01"), 0);
+
+    char name[16];
+    for (int i = 0; i < NUM_NODES; i++) {
+        node_name(name, sizeof(name), i);
+        inject_status(name);
+    }
+    ASSERT_EQ(g_owner.status_count, NUM_NODES);
+    ASSERT_EQ(sds_get_stats()->cluster_skipped, 0);
+}
+
+/* ============== Tests: Partitioning ============== */
+
+TEST(member_tracks_only_its_devices) {
+    ASSERT_EQ(start_member(2, 1), SDS_OK);
+
+    char name[16];
+    uint32_t others = 0;
+    for (int i = 0; i < NUM_NODES; i++) {
+        node_name(name, sizeof(name), i);
+        inject_status(name);
+        bool mine = sds_cluster_member_for(name) == 1;
+        ASSERT_EQ(tracks(name), mine);
+        if (!mine) others++;
+    }
+    ASSERT(others > 0);
+    ASSERT_EQ(g_owner.status_count, NUM_NODES - others);
+    ASSERT_EQ(sds_get_stats()->cluster_skipped, others);
+}
+
+TEST(members_cover_every_device_once) {
+    int tracked_by[NUM_NODES] = { 0 };
+    char name[16];
+
+    for (uint8_t m = 0; m < 3; m++) {
+        sds_shutdown();
+        sds_mock_reset();
+        ASSERT_EQ(start_member(3, m), SDS_OK);
+        for (int i = 0; i < NUM_NODES; i++) {
+            node_name(name, sizeof(name), i);
+            inject_status(name);
+        }
+        for (int i = 0; i < NUM_NODES; i++) {
+            node_name(name, sizeof(name), i);
+            if (tracks(name)) tracked_by[i]++;
+        }
+    }
+    for (int i = 0; i < NUM_NODES; i++) {
+        ASSERT_EQ(tracked_by[i], 1);
+    }
+}
+
+TEST(lwt_for_other_member_is_dropped) {
+    ASSERT_EQ(start_member(2, 0), SDS_OK);
+
+    char mine[16] = "";
+    char theirs[16] = "";
+    for (int i = 0; i < NUM_NODES; i++) {
+        char name[16];
+        node_name(name, sizeof(name), i);
+        if (sds_cluster_member_for(name) == 0) snprintf(mine, sizeof(mine), "%s", name);
+        else snprintf(theirs, sizeof(theirs), "%s", name);
+    }
+    ASSERT(mine[0] && theirs[0]);
+
+    inject_status(mine);
+    ASSERT(sds_is_device_online(&g_owner, "SensorData", mine, 60000));
+
+    char topic[SDS_TOPIC_BUFFER_SIZE];
+    snprintf(topic, sizeof(topic), "sds/lwt/%s", theirs);
+    sds_mock_inject_message_str(topic, "{\"online\":false}");
+    ASSERT_EQ(sds_get_stats()->cluster_skipped, 1);
+
+    snprintf(topic, sizeof(topic), "sds/lwt/%s", mine);
+    sds_mock_inject_message_str(topic, "{\"online\":false}");
+    ASSERT(!sds_is_device_online(&g_owner, "SensorData", mine, 60000));
+    ASSERT_EQ(sds_get_stats()->cluster_skipped, 1);
+}
+
+TEST(state_for_other_member_is_dropped) {
+    ASSERT_EQ(start_member(2, 0), SDS_OK);
+
+    char name[16];
+    int mine = 0;
+    for (int i = 0; i < NUM_NODES; i++) {
+        node_name(name, sizeof(name), i);
+        char payload[128];
+        snprintf(payload, sizeof(payload),
+                 "{\"ts\":1,\"node\":\"%s\",\"temperature\":%d.0,\"humidity\":1.0}", name, i);
+        sds_mock_inject_message_str("sds/SensorData/state", payload);
+        if (sds_cluster_member_for(name) == 0) mine++;
+    }
+    ASSERT(mine > 0 && mine < NUM_NODES);
+    ASSERT_EQ(g_state_callbacks, mine);
+    ASSERT_EQ(sds_get_stats()->cluster_skipped, (uint32_t)(NUM_NODES - mine));
+}
+
+TEST(set_membership_hands_off_devices) {
+    ASSERT_EQ(start_member(0, 0), SDS_OK);
+
+    char name[16];
+    for (int i = 0; i < NUM_NODES; i++) {
+        node_name(name, sizeof(name), i);
+        inject_status(name);
+    }
+    ASSERT_EQ(g_owner.status_count, NUM_NODES);
+
+    ASSERT_EQ(sds_set_cluster_membership(2, 0), SDS_OK);
+    int kept = 0;
+    for (int i = 0; i < NUM_NODES; i++) {
+        node_name(name, sizeof(name), i);
+        bool mine = sds_cluster_member_for(name) == 0;
+        ASSERT_EQ(tracks(name), mine);
+        if (mine) kept++;
+    }
+    ASSERT_EQ(g_owner.status_count, kept);
+    ASSERT_EQ(g_evictions, NUM_NODES - kept);
+
+    /* Handed-off devices stay with the other member */
+    uint32_t skipped = sds_get_stats()->cluster_skipped;
+    for (int i = 0; i < NUM_NODES; i++) {
+        node_name(name, sizeof(name), i);
+        inject_status(name);
+    }
+    ASSERT_EQ(g_owner.status_count, kept);
+    ASSERT_EQ(sds_get_stats()->cluster_skipped, skipped + (uint32_t)(NUM_NODES - kept));
+
+    /* Back to a single member: everyone is picked up again */
+    ASSERT_EQ(sds_set_cluster_membership(1, 0), SDS_OK);
+    for (int i = 0; i < NUM_NODES; i++) {
+        node_name(name, sizeof(name), i);
+        inject_status(name);
+    }
+    ASSERT_EQ(g_owner.status_count, NUM_NODES);
+}
+
+/* ============== Tests: Shared Subscriptions and Config ============== */
+
+TEST(shared_group_subscribes_through_share) {
+    ASSERT_EQ(init_node("owners", 0, 0), SDS_OK);
+    memset(&g_owner, 0, sizeof(g_owner));
+    ASSERT_EQ(sds_register_table(&g_owner, "SensorData", SDS_ROLE_OWNER, NULL), SDS_OK);
+
+    ASSERT(sds_mock_is_subscribed("$share/owners/sds/SensorData/state"));
+    ASSERT(sds_mock_is_subscribed("$share/owners/sds/SensorData/status/+"));
+    ASSERT(sds_mock_is_subscribed("$share/owners/sds/lwt/+"));
+    ASSERT(!sds_mock_is_subscribed("sds/SensorData/status/+"));
+    ASSERT(!sds_mock_is_subscribed("sds/lwt/+"));
+
+    /* Deliveries carry the plain topic and every device is kept */
+    inject_status("dev_01");
+    inject_status("dev_02");
+    ASSERT_EQ(g_owner.status_count, 2);
+
+    ASSERT_EQ(sds_unregister_table("SensorData"), SDS_OK);
+    ASSERT(!sds_mock_is_subscribed("$share/owners/sds/SensorData/status/+"));
+    ASSERT(!sds_mock_is_subscribed("$share/owners/sds/lwt/+"));
+
+    /* Membership changes belong to the broker in this mode */
+    ASSERT_EQ(sds_set_cluster_membership(2, 0), SDS_ERR_INVALID_CONFIG);
+}
+
+TEST(device_tables_ignore_cluster_group) {
+    static SensorDataTable device;
+    ASSERT_EQ(init_node("owners", 0, 0), SDS_OK);
+    ASSERT_EQ(sds_register_table(&device, "SensorData", SDS_ROLE_DEVICE, NULL), SDS_OK);
+    ASSERT(sds_mock_is_subscribed("sds/SensorData/config"));
+}
+
+TEST(invalid_cluster_config_rejected) {
+    ASSERT_EQ(init_node("a/b", 0, 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(init_node("a+", 0, 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(init_node("0123456789012345678901234567890123", 0, 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(init_node("owners", 2, 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(init_node(NULL, 2, 2), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_cluster_membership(2, 0), SDS_ERR_NOT_INITIALIZED);
+
+    ASSERT_EQ(init_node(NULL, 2, 1), SDS_OK);
+    ASSERT_EQ(sds_set_cluster_membership(3, 3), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_cluster_membership(3, 2), SDS_OK);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║             Owner Cluster Tests (Mock Platform)              ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Assignment Tests ───\n");
+    RUN_TEST(assignment_is_balanced);
+    RUN_TEST(resize_moves_devices_only_to_new_member);
+    RUN_TEST(partitioning_off_tracks_everything);
+
+    printf("\n─── Partitioning Tests ───\n");
+    RUN_TEST(member_tracks_only_its_devices);
+    RUN_TEST(members_cover_every_device_once);
+    RUN_TEST(lwt_for_other_member_is_dropped);
+    RUN_TEST(state_for_other_member_is_dropped);
+    RUN_TEST(set_membership_hands_off_devices);
+
+    printf("\n─── Shared Subscription and Config Tests ───\n");
+    RUN_TEST(shared_group_subscribes_through_share);
+    RUN_TEST(device_tables_ignore_cluster_group);
+    RUN_TEST(invalid_cluster_config_rejected);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -0,0 +1,324 @@
+/*
+ * test_config_cache.c - Retained-Config Cache Tests
+ *
+ * Tests SdsConfig.enable_config_cache with the mock platform's in-memory
+ * storage, simulating reboots with sds_shutdown()/sds_init():
+ * - Applied configs are saved once per distinct payload
+ * - Devices restore the cached config at registration
+ * - Unchanged configs are skipped; the first after a restore runs the callback
+ * - Records for another schema version, or corrupt ones, are ignored
+ * - Binary configs round-trip; owners and disabled nodes never cache
+ *
+ * Build:
+ *   gcc -I../include -o test_config_cache test_config_cache.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_config_cache
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    sds_set_schema_version("1.0.0"); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+#define CONFIG_TOPIC "sds/SensorData/config"
+#define CONFIG_A "{\"ts\":1000,\"command\":3,\"threshold\":2.5}"
+#define CONFIG_B "{\"ts\":2000,\"command\":7,\"threshold\":9.0}"
+
+static SensorDataOwnerTable g_owner;
+static SensorDataTable g_device;
+static int g_config_callbacks = 0;
+
+static void on_config(const char* table_type, void* user_data) {
+    (void)table_type;
+    (void)user_data;
+    g_config_callbacks++;
+}
+
+/* Boot a node: sds_init() and register SensorData (storage survives) */
+static SdsError boot(const char* node_id, SdsRole role, bool cache, SdsWireFormat format) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_config_cache = cache,
+    };
+
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_owner, 0, sizeof(g_owner));
+    memset(&g_device, 0, sizeof(g_device));
+    g_config_callbacks = 0;
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000, .wire_format = format };
+    if (role == SDS_ROLE_OWNER) {
+        return sds_register_table(&g_owner, "SensorData", SDS_ROLE_OWNER, &opts);
+    }
+    err = sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, &opts);
+    if (err != SDS_OK) return err;
+    sds_on_config_update("SensorData", on_config, NULL);
+    return SDS_OK;
+}
+
+/* First session of dev_a: apply CONFIG_A so that it is cached */
+static SdsError seed_cache(void) {
+    SdsError err = boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON);
+    if (err != SDS_OK) return err;
+    sds_mock_inject_message_str(CONFIG_TOPIC, CONFIG_A);
+    sds_shutdown();
+    return SDS_OK;
+}
+
+/* ============== Save Tests ============== */
+
+TEST(disabled_saves_nothing) {
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, false, SDS_WIRE_JSON), SDS_OK);
+    sds_mock_inject_message_str(CONFIG_TOPIC, CONFIG_A);
+
+    ASSERT_EQ(g_device.config.command, 3);
+    ASSERT_EQ(sds_mock_get_storage_save_count(), 0u);
+    ASSERT(sds_mock_storage_get("dev_a/SensorData", NULL) == NULL);
+}
+
+TEST(applied_config_is_saved_once) {
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    sds_mock_inject_message_str(CONFIG_TOPIC, CONFIG_A);
+
+    size_t len = 0;
+    const uint8_t* rec = sds_mock_storage_get("dev_a/SensorData", &len);
+    ASSERT(rec != NULL);
+    ASSERT(len > strlen(CONFIG_A));
+    ASSERT_EQ(rec[0], 0xC5);
+    ASSERT(memcmp(rec + len - strlen(CONFIG_A), CONFIG_A, strlen(CONFIG_A)) == 0);
+    ASSERT_EQ(sds_mock_get_storage_save_count(), 1u);
+    ASSERT_EQ(g_config_callbacks, 1);
+
+    /* A reconnect redelivers the same retained config: not parsed, not saved */
+    sds_mock_inject_message_str(CONFIG_TOPIC, CONFIG_A);
+    ASSERT_EQ(sds_mock_get_storage_save_count(), 1u);
+    ASSERT_EQ(sds_get_stats()->config_unchanged, 1u);
+    ASSERT_EQ(g_config_callbacks, 1);
+
+    sds_mock_inject_message_str(CONFIG_TOPIC, CONFIG_B);
+    ASSERT_EQ(g_device.config.command, 7);
+    ASSERT_EQ(sds_mock_get_storage_save_count(), 2u);
+    ASSERT_EQ(g_config_callbacks, 2);
+}
+
+TEST(owner_never_caches) {
+    ASSERT_EQ(boot("owner", SDS_ROLE_OWNER, true, SDS_WIRE_JSON), SDS_OK);
+    g_owner.config.command = 4;
+    sds_mock_advance_time(1000);
+    sds_loop();
+
+    ASSERT(sds_mock_find_publish_by_topic(CONFIG_TOPIC) != NULL);
+    ASSERT_EQ(sds_mock_get_storage_save_count(), 0u);
+}
+
+/* ============== Restore Tests ============== */
+
+TEST(restore_on_registration) {
+    ASSERT_EQ(seed_cache(), SDS_OK);
+
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    ASSERT_EQ(g_device.config.command, 3);
+    ASSERT(g_device.config.threshold > 2.49f && g_device.config.threshold < 2.51f);
+    ASSERT_EQ(sds_get_stats()->config_cache_restored, 1u);
+}
+
+TEST(other_node_does_not_restore) {
+    ASSERT_EQ(seed_cache(), SDS_OK);
+
+    ASSERT_EQ(boot("dev_b", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    ASSERT_EQ(g_device.config.command, 0);
+    ASSERT_EQ(sds_get_stats()->config_cache_restored, 0u);
+}
+
+TEST(unchanged_after_restore_runs_callback_once) {
+    ASSERT_EQ(seed_cache(), SDS_OK);
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    size_t saves = sds_mock_get_storage_save_count();
+
+    /* Change the table locally: a skipped config must not overwrite it */
+    g_device.config.command = 42;
+    sds_mock_inject_message_str(CONFIG_TOPIC, CONFIG_A);
+    ASSERT_EQ(g_device.config.command, 42);
+    ASSERT_EQ(g_config_callbacks, 1);
+    ASSERT_EQ(sds_get_stats()->config_unchanged, 1u);
+
+    sds_mock_inject_message_str(CONFIG_TOPIC, CONFIG_A);
+    ASSERT_EQ(g_config_callbacks, 1);
+    ASSERT_EQ(sds_get_stats()->config_unchanged, 2u);
+    ASSERT_EQ(sds_mock_get_storage_save_count(), saves);
+}
+
+TEST(changed_after_restore_applies) {
+    ASSERT_EQ(seed_cache(), SDS_OK);
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    size_t saves = sds_mock_get_storage_save_count();
+
+    sds_mock_inject_message_str(CONFIG_TOPIC, CONFIG_B);
+    ASSERT_EQ(g_device.config.command, 7);
+    ASSERT_EQ(g_config_callbacks, 1);
+    ASSERT_EQ(sds_get_stats()->config_unchanged, 0u);
+    ASSERT_EQ(sds_mock_get_storage_save_count(), saves + 1);
+
+    /* The next boot starts from CONFIG_B */
+    sds_shutdown();
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    ASSERT_EQ(g_device.config.command, 7);
+}
+
+TEST(schema_change_ignores_cache) {
+    ASSERT_EQ(seed_cache(), SDS_OK);
+
+    sds_set_schema_version("2.0.0");
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    ASSERT_EQ(g_device.config.command, 0);
+    ASSERT_EQ(sds_get_stats()->config_cache_restored, 0u);
+
+    /* Nothing was restored, so the retained config is applied in full */
+    sds_mock_inject_message_str(CONFIG_TOPIC, CONFIG_A);
+    ASSERT_EQ(g_device.config.command, 3);
+    ASSERT_EQ(sds_get_stats()->config_unchanged, 0u);
+}
+
+TEST(corrupt_record_ignored) {
+    ASSERT_EQ(seed_cache(), SDS_OK);
+
+    size_t len = 0;
+    const uint8_t* rec = sds_mock_storage_get("dev_a/SensorData", &len);
+    ASSERT(rec != NULL);
+    uint8_t copy[SDS_MOCK_MAX_STORAGE_LEN];
+    memcpy(copy, rec, len);
+    copy[len - 3] ^= 0x01;  /* Inside the payload: hash mismatch */
+    ASSERT(sds_mock_storage_set("dev_a/SensorData", copy, len));
+
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    ASSERT_EQ(g_device.config.command, 0);
+    ASSERT_EQ(sds_get_stats()->config_cache_restored, 0u);
+
+    /* Truncated and foreign records are ignored too */
+    sds_shutdown();
+    ASSERT(sds_mock_storage_set("dev_a/SensorData", copy, 5));
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    ASSERT_EQ(sds_get_stats()->config_cache_restored, 0u);
+
+    sds_shutdown();
+    ASSERT(sds_mock_storage_set("dev_a/SensorData", (const uint8_t*)CONFIG_A, strlen(CONFIG_A)));
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    ASSERT_EQ(g_device.config.command, 0);
+}
+
+TEST(binary_config_round_trip) {
+    /* Capture a binary config from an owner */
+    ASSERT_EQ(boot("owner", SDS_ROLE_OWNER, false, SDS_WIRE_BINARY), SDS_OK);
+    g_owner.config.command = 9;
+    sds_mock_advance_time(1000);
+    sds_loop();
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(CONFIG_TOPIC);
+    ASSERT(msg != NULL);
+    ASSERT_EQ(msg->payload[0], 0xB5);
+    uint8_t payload[SDS_MOCK_MAX_PAYLOAD_LEN];
+    size_t payload_len = msg->payload_len;
+    memcpy(payload, msg->payload, payload_len);
+    sds_shutdown();
+
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    sds_mock_inject_message(CONFIG_TOPIC, payload, payload_len);
+    ASSERT_EQ(g_device.config.command, 9);
+    sds_shutdown();
+
+    ASSERT_EQ(boot("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+    ASSERT_EQ(g_device.config.command, 9);
+    sds_mock_inject_message(CONFIG_TOPIC, payload, payload_len);
+    ASSERT_EQ(sds_get_stats()->config_unchanged, 1u);
+    ASSERT_EQ(g_config_callbacks, 1);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║              Config Cache Tests (Mock Platform)              ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Save Tests ───\n");
+    RUN_TEST(disabled_saves_nothing);
+    RUN_TEST(applied_config_is_saved_once);
+    RUN_TEST(owner_never_caches);
+
+    printf("\n─── Restore Tests ───\n");
+    RUN_TEST(restore_on_registration);
+    RUN_TEST(other_node_does_not_restore);
+    RUN_TEST(unchanged_after_restore_runs_callback_once);
+    RUN_TEST(changed_after_restore_applies);
+    RUN_TEST(schema_change_ignores_cache);
+    RUN_TEST(corrupt_record_ignored);
+
+    printf("\n─── Binary Wire Format Tests ───\n");
+    RUN_TEST(binary_config_round_trip);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -0,0 +1,473 @@
+/*
+ * test_config_delta.c - Config Delta Tests
+ *
+ * Tests delta sync for owner config with the mock platform:
+ * - Owners keep a retained baseline and publish cumulative deltas
+ * - A new baseline every keyframe_interval config messages
+ * - Devices apply deltas in place, drop deltas for another baseline and
+ *   keep their deltas when the baseline is redelivered
+ * - Configs that change nothing skip the config callback
+ * - JSON and binary wire formats
+ *
+ * Build:
+ *   gcc -I../include -o test_config_delta test_config_delta.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_config_delta
+ */
+
+#include "sds.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_STR_CONTAINS(haystack, needle) ASSERT(strstr((haystack), (needle)) != NULL)
+#define ASSERT_STR_NOT_CONTAINS(haystack, needle) ASSERT(strstr((haystack), (needle)) == NULL)
+
+/* ============== Table Definitions ============== */
+
+typedef struct {
+    uint8_t mode;
+    float threshold;
+    uint16_t interval;
+} CfgConfig;
+
+typedef struct {
+    float temperature;
+} CfgState;
+
+typedef struct {
+    uint8_t error_code;
+} CfgStatus;
+
+typedef struct {
+    CfgConfig config;
+    CfgState state;
+    CfgStatus status;
+} CfgTable;
+
+static const SdsFieldMeta cfg_config_fields[] = {
+    { .name = "mode", .type = SDS_FIELD_UINT8, .offset = offsetof(CfgConfig, mode), .size = sizeof(uint8_t) },
+    { .name = "threshold", .type = SDS_FIELD_FLOAT, .offset = offsetof(CfgConfig, threshold), .size = sizeof(float) },
+    { .name = "interval", .type = SDS_FIELD_UINT16, .offset = offsetof(CfgConfig, interval), .size = sizeof(uint16_t) },
+};
+#define CFG_CONFIG_FIELD_COUNT 3
+
+static const SdsFieldMeta cfg_state_fields[] = {
+    { .name = "temperature", .type = SDS_FIELD_FLOAT, .offset = offsetof(CfgState, temperature), .size = sizeof(float) },
+};
+
+static const SdsFieldMeta cfg_status_fields[] = {
+    { .name = "error_code", .type = SDS_FIELD_UINT8, .offset = offsetof(CfgStatus, error_code), .size = sizeof(uint8_t) },
+};
+
+#define CONFIG_TOPIC "sds/CfgTable/config"
+#define DELTA_TOPIC  "sds/CfgTable/config/delta"
+
+/* ============== Helper Functions ============== */
+
+static CfgTable g_table;
+static int g_config_callbacks = 0;
+
+typedef struct {
+    uint8_t payload[SDS_MOCK_MAX_PAYLOAD_LEN];
+    size_t len;
+} Captured;
+
+static void on_config(const char* table_type, void* user_data) {
+    (void)table_type;
+    (void)user_data;
+    g_config_callbacks++;
+}
+
+static SdsError init_node(const char* node_id, SdsRole role, bool delta_sync,
+                          uint16_t keyframe_interval, SdsWireFormat wire) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+    sds_mock_set_time(10000);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_delta_sync = delta_sync,
+        .keyframe_interval = keyframe_interval,
+    };
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_table, 0, sizeof(g_table));
+    g_table.config.mode = 1;
+    g_table.config.threshold = 1.5f;
+    g_table.config.interval = 10;
+    g_config_callbacks = 0;
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000, .wire_format = wire };
+    err = sds_register_table_ex(
+        &g_table, "CfgTable", role, &opts,
+        offsetof(CfgTable, config), sizeof(CfgConfig),
+        offsetof(CfgTable, state), sizeof(CfgState),
+        offsetof(CfgTable, status), sizeof(CfgStatus),
+        NULL, NULL, NULL, NULL, NULL, NULL
+    );
+    if (err != SDS_OK) return err;
+
+    err = sds_set_table_fields("CfgTable", cfg_config_fields, CFG_CONFIG_FIELD_COUNT,
+                               cfg_state_fields, 1, cfg_status_fields, 1);
+    if (err == SDS_OK && role == SDS_ROLE_DEVICE) {
+        sds_on_config_update("CfgTable", on_config, NULL);
+    }
+    return err;
+}
+
+static SdsError init_owner(bool delta_sync, uint16_t keyframe_interval) {
+    return init_node("owner1", SDS_ROLE_OWNER, delta_sync, keyframe_interval, SDS_WIRE_JSON);
+}
+
+static SdsError init_device(void) {
+    return init_node("dev1", SDS_ROLE_DEVICE, true, 0, SDS_WIRE_JSON);
+}
+
+/* Run one sync interval on the owner */
+static void owner_sync(void) {
+    sds_mock_clear_publishes();
+    sds_mock_advance_time(1000);
+    sds_loop();
+}
+
+static const char* published(const char* topic) {
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(topic);
+    return msg ? (const char*)msg->payload : NULL;
+}
+
+static bool capture(const char* topic, Captured* out) {
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(topic);
+    if (!msg) return false;
+    memcpy(out->payload, msg->payload, msg->payload_len);
+    out->len = msg->payload_len;
+    return true;
+}
+
+/* ============== Owner Tests ============== */
+
+TEST(baseline_published_retained) {
+    ASSERT_EQ(init_owner(true, 0), SDS_OK);
+
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(CONFIG_TOPIC);
+    ASSERT(msg != NULL);
+    ASSERT(msg->retained);
+    ASSERT_STR_CONTAINS((const char*)msg->payload, "\"mode\":1");
+    ASSERT_STR_CONTAINS((const char*)msg->payload, "\"threshold\"");
+    ASSERT_STR_CONTAINS((const char*)msg->payload, "\"interval\":10");
+    ASSERT_STR_NOT_CONTAINS((const char*)msg->payload, "\"base\"");
+}
+
+TEST(change_sends_delta_against_baseline) {
+    ASSERT_EQ(init_owner(true, 0), SDS_OK);
+
+    g_table.config.threshold = 2.5f;
+    owner_sync();
+
+    ASSERT(published(CONFIG_TOPIC) == NULL);
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(DELTA_TOPIC);
+    ASSERT(msg != NULL);
+    ASSERT(msg->retained);
+    ASSERT_STR_CONTAINS((const char*)msg->payload, "\"base\":10000");
+    ASSERT_STR_CONTAINS((const char*)msg->payload, "\"threshold\":2.5");
+    ASSERT_STR_NOT_CONTAINS((const char*)msg->payload, "\"mode\"");
+    ASSERT_STR_NOT_CONTAINS((const char*)msg->payload, "\"interval\"");
+}
+
+TEST(deltas_are_cumulative) {
+    ASSERT_EQ(init_owner(true, 0), SDS_OK);
+
+    g_table.config.threshold = 2.5f;
+    owner_sync();
+    g_table.config.mode = 3;
+    owner_sync();
+
+    const char* payload = published(DELTA_TOPIC);
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"base\":10000");
+    ASSERT_STR_CONTAINS(payload, "\"threshold\":2.5");
+    ASSERT_STR_CONTAINS(payload, "\"mode\":3");
+    ASSERT_STR_NOT_CONTAINS(payload, "\"interval\"");
+
+    /* Nothing changed: nothing sent */
+    owner_sync();
+    ASSERT_EQ(sds_mock_get_publish_count(), 0);
+}
+
+TEST(delta_of_every_field_is_baseline) {
+    ASSERT_EQ(init_owner(true, 0), SDS_OK);
+
+    g_table.config.threshold = 2.5f;
+    owner_sync();
+    g_table.config.mode = 3;
+    g_table.config.interval = 20;
+    owner_sync();
+
+    ASSERT(published(DELTA_TOPIC) == NULL);
+    const char* payload = published(CONFIG_TOPIC);
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"interval\":20");
+
+    /* The next delta builds on the new baseline */
+    g_table.config.mode = 4;
+    owner_sync();
+    payload = published(DELTA_TOPIC);
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"base\":12000");
+    ASSERT_STR_NOT_CONTAINS(payload, "\"threshold\"");
+}
+
+TEST(baseline_refresh_every_keyframe_interval) {
+    ASSERT_EQ(init_owner(true, 3), SDS_OK);
+
+    g_table.config.threshold = 2.0f;
+    owner_sync();
+    ASSERT(published(DELTA_TOPIC) != NULL);
+    g_table.config.threshold = 3.0f;
+    owner_sync();
+    ASSERT(published(DELTA_TOPIC) != NULL);
+
+    g_table.config.threshold = 4.0f;
+    owner_sync();
+    ASSERT(published(DELTA_TOPIC) == NULL);
+    ASSERT_STR_CONTAINS(published(CONFIG_TOPIC), "\"threshold\":4");
+}
+
+TEST(full_config_without_delta_sync) {
+    ASSERT_EQ(init_owner(false, 0), SDS_OK);
+
+    g_table.config.threshold = 2.5f;
+    owner_sync();
+
+    ASSERT(published(DELTA_TOPIC) == NULL);
+    const char* payload = published(CONFIG_TOPIC);
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"mode\":1");
+    ASSERT_STR_CONTAINS(payload, "\"threshold\":2.5");
+}
+
+/* ============== Device Tests ============== */
+
+TEST(device_subscribes_to_deltas) {
+    ASSERT_EQ(init_device(), SDS_OK);
+    ASSERT(sds_mock_is_subscribed(CONFIG_TOPIC));
+    ASSERT(sds_mock_is_subscribed(DELTA_TOPIC));
+
+    sds_unregister_table("CfgTable");
+    ASSERT(!sds_mock_is_subscribed(DELTA_TOPIC));
+}
+
+TEST(device_applies_delta_in_place) {
+    ASSERT_EQ(init_device(), SDS_OK);
+
+    sds_mock_inject_message_str(CONFIG_TOPIC,
+        "{\"ts\":100,\"from\":\"owner1\",\"mode\":2,\"threshold\":1.5,\"interval\":30}");
+    ASSERT_EQ(g_config_callbacks, 1);
+
+    sds_mock_inject_message_str(DELTA_TOPIC,
+        "{\"ts\":200,\"from\":\"owner1\",\"base\":100,\"threshold\":2.5}");
+    ASSERT_EQ(g_config_callbacks, 2);
+    ASSERT_EQ(g_table.config.mode, 2);
+    ASSERT_EQ(g_table.config.threshold, 2.5f);
+    ASSERT_EQ(g_table.config.interval, 30);
+}
+
+TEST(delta_for_other_baseline_dropped) {
+    ASSERT_EQ(init_device(), SDS_OK);
+
+    /* Before any baseline */
+    sds_mock_inject_message_str(DELTA_TOPIC,
+        "{\"ts\":200,\"from\":\"owner1\",\"base\":100,\"threshold\":2.5}");
+    ASSERT_EQ(g_config_callbacks, 0);
+    ASSERT_EQ(g_table.config.threshold, 1.5f);
+
+    sds_mock_inject_message_str(CONFIG_TOPIC,
+        "{\"ts\":300,\"from\":\"owner1\",\"mode\":2,\"threshold\":1.5,\"interval\":30}");
+    ASSERT_EQ(g_config_callbacks, 1);
+
+    /* For an older baseline, and without one */
+    sds_mock_inject_message_str(DELTA_TOPIC,
+        "{\"ts\":200,\"from\":\"owner1\",\"base\":100,\"threshold\":2.5}");
+    sds_mock_inject_message_str(DELTA_TOPIC, "{\"ts\":400,\"from\":\"owner1\",\"threshold\":2.5}");
+    ASSERT_EQ(g_config_callbacks, 1);
+    ASSERT_EQ(g_table.config.threshold, 1.5f);
+}
+
+TEST(unchanged_config_skips_callback) {
+    ASSERT_EQ(init_device(), SDS_OK);
+
+    sds_mock_inject_message_str(CONFIG_TOPIC,
+        "{\"ts\":100,\"from\":\"owner1\",\"mode\":2,\"threshold\":1.5,\"interval\":30}");
+    ASSERT_EQ(g_config_callbacks, 1);
+
+    /* New baseline, same values */
+    sds_mock_inject_message_str(CONFIG_TOPIC,
+        "{\"ts\":200,\"from\":\"owner1\",\"mode\":2,\"threshold\":1.5,\"interval\":30}");
+    ASSERT_EQ(g_config_callbacks, 1);
+
+    /* Delta to the value already held */
+    sds_mock_inject_message_str(DELTA_TOPIC,
+        "{\"ts\":300,\"from\":\"owner1\",\"base\":200,\"mode\":2}");
+    ASSERT_EQ(g_config_callbacks, 1);
+    ASSERT_EQ(sds_get_stats()->config_unchanged, 2);
+}
+
+TEST(first_config_always_reported) {
+    ASSERT_EQ(init_device(), SDS_OK);
+
+    /* Identical to the registered values, but nothing was applied yet */
+    sds_mock_inject_message_str(CONFIG_TOPIC,
+        "{\"ts\":100,\"from\":\"owner1\",\"mode\":1,\"threshold\":1.5,\"interval\":10}");
+    ASSERT_EQ(g_config_callbacks, 1);
+}
+
+TEST(redelivered_baseline_keeps_deltas) {
+    ASSERT_EQ(init_device(), SDS_OK);
+    const char* baseline = "{\"ts\":100,\"from\":\"owner1\",\"mode\":2,\"threshold\":1.5,\"interval\":30}";
+
+    sds_mock_inject_message_str(CONFIG_TOPIC, baseline);
+    sds_mock_inject_message_str(DELTA_TOPIC,
+        "{\"ts\":200,\"from\":\"owner1\",\"base\":100,\"threshold\":2.5}");
+    ASSERT_EQ(g_config_callbacks, 2);
+
+    /* Reconnect: the broker resends both retained messages */
+    sds_mock_inject_message_str(CONFIG_TOPIC, baseline);
+    ASSERT_EQ(g_table.config.threshold, 2.5f);
+    sds_mock_inject_message_str(DELTA_TOPIC,
+        "{\"ts\":200,\"from\":\"owner1\",\"base\":100,\"threshold\":2.5}");
+    ASSERT_EQ(g_config_callbacks, 2);
+
+    /* A new baseline replaces everything */
+    sds_mock_inject_message_str(CONFIG_TOPIC,
+        "{\"ts\":500,\"from\":\"owner1\",\"mode\":2,\"threshold\":1.0,\"interval\":30}");
+    ASSERT_EQ(g_table.config.threshold, 1.0f);
+    ASSERT_EQ(g_config_callbacks, 3);
+}
+
+/* ============== End-to-End Tests ============== */
+
+static void round_trip(SdsWireFormat wire) {
+    Captured baseline, delta;
+
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, 0, wire), SDS_OK);
+    ASSERT(capture(CONFIG_TOPIC, &baseline));
+    g_table.config.threshold = 2.5f;
+    owner_sync();
+    g_table.config.interval = 99;
+    owner_sync();
+    ASSERT(capture(DELTA_TOPIC, &delta));
+    ASSERT_EQ(delta.payload[0] == '{', wire == SDS_WIRE_JSON);
+    sds_shutdown();
+
+    ASSERT_EQ(init_node("dev1", SDS_ROLE_DEVICE, true, 0, SDS_WIRE_JSON), SDS_OK);
+    g_table.config.mode = 0;
+    g_table.config.threshold = 0;
+    g_table.config.interval = 0;
+
+    /* Delta first is dropped; the broker sends the baseline first anyway */
+    sds_mock_inject_message(DELTA_TOPIC, delta.payload, delta.len);
+    ASSERT_EQ(g_table.config.threshold, 0.0f);
+    sds_mock_inject_message(CONFIG_TOPIC, baseline.payload, baseline.len);
+    ASSERT_EQ(g_table.config.threshold, 1.5f);
+    sds_mock_inject_message(DELTA_TOPIC, delta.payload, delta.len);
+
+    ASSERT_EQ(g_table.config.mode, 1);
+    ASSERT_EQ(g_table.config.threshold, 2.5f);
+    ASSERT_EQ(g_table.config.interval, 99);
+    ASSERT_EQ(g_config_callbacks, 2);
+}
+
+TEST(json_round_trip) {
+    round_trip(SDS_WIRE_JSON);
+}
+
+TEST(binary_round_trip) {
+    round_trip(SDS_WIRE_BINARY);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║              SDS Config Delta Tests                          ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n");
+
+    printf("\n─── Owner ───\n");
+    RUN_TEST(baseline_published_retained);
+    RUN_TEST(change_sends_delta_against_baseline);
+    RUN_TEST(deltas_are_cumulative);
+    RUN_TEST(delta_of_every_field_is_baseline);
+    RUN_TEST(baseline_refresh_every_keyframe_interval);
+    RUN_TEST(full_config_without_delta_sync);
+
+    printf("\n─── Device ───\n");
+    RUN_TEST(device_subscribes_to_deltas);
+    RUN_TEST(device_applies_delta_in_place);
+    RUN_TEST(delta_for_other_baseline_dropped);
+    RUN_TEST(unchanged_config_skips_callback);
+    RUN_TEST(first_config_always_reported);
+    RUN_TEST(redelivered_baseline_keeps_deltas);
+
+    printf("\n─── End to End ───\n");
+    RUN_TEST(json_round_trip);
+    RUN_TEST(binary_round_trip);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -6,6 +6,7 @@
  * - Verifies full sync when delta is disabled
  * - Tests float tolerance
  * - Tests config remains full even with delta enabled
+ * - Owners apply delta state in place
  * 
  * Build:
  *   gcc -I../include -o test_delta_sync test_delta_sync.c \
@@ -84,17 +85,22 @@ typedef struct {
     DeltaStatus status;
 } DeltaDeviceTable;
 
+typedef struct {
+    DeltaConfig config;
+    DeltaState state;
+} DeltaOwnerTable;
+
 /* Field metadata (simulating what codegen would generate) */
 static const SdsFieldMeta delta_state_fields[] = {
-    { "temperature", SDS_FIELD_FLOAT, offsetof(DeltaState, temperature), sizeof(float) },
-    { "humidity", SDS_FIELD_FLOAT, offsetof(DeltaState, humidity), sizeof(float) },
-    { "reading_count", SDS_FIELD_UINT32, offsetof(DeltaState, reading_count), sizeof(uint32_t) },
+    { .name = "temperature", .type = SDS_FIELD_FLOAT, .offset = offsetof(DeltaState, temperature), .size = sizeof(float) },
+    { .name = "humidity", .type = SDS_FIELD_FLOAT, .offset = offsetof(DeltaState, humidity), .size = sizeof(float) },
+    { .name = "reading_count", .type = SDS_FIELD_UINT32, .offset = offsetof(DeltaState, reading_count), .size = sizeof(uint32_t) },
 };
 #define DELTA_STATE_FIELD_COUNT 3
 
 static const SdsFieldMeta delta_status_fields[] = {
-    { "error_code", SDS_FIELD_UINT8, offsetof(DeltaStatus, error_code), sizeof(uint8_t) },
-    { "battery_level", SDS_FIELD_UINT8, offsetof(DeltaStatus, battery_level), sizeof(uint8_t) },
+    { .name = "error_code", .type = SDS_FIELD_UINT8, .offset = offsetof(DeltaStatus, error_code), .size = sizeof(uint8_t) },
+    { .name = "battery_level", .type = SDS_FIELD_UINT8, .offset = offsetof(DeltaStatus, battery_level), .size = sizeof(uint8_t) },
 };
 #define DELTA_STATUS_FIELD_COUNT 2
 
@@ -174,6 +180,38 @@ static SdsError register_device_table(DeltaDeviceTable* table, const char* table
     );
 }
 
+static SdsError register_owner_table(DeltaOwnerTable* table, const char* table_type) {
+    return sds_register_table_ex(
+        table, table_type, SDS_ROLE_OWNER, NULL,
+        offsetof(DeltaOwnerTable, config), sizeof(DeltaConfig),
+        offsetof(DeltaOwnerTable, state), sizeof(DeltaState),
+        0, 0,
+        serialize_config, NULL,
+        NULL, deserialize_state,
+        NULL, deserialize_status
+    );
+}
+
+/* Device table with dirty tracking and field metadata attached */
+static SdsError register_dirty_table(DeltaDeviceTable* table, const char* table_type) {
+    SdsTableOptions opts = { .sync_interval_ms = 1000, .dirty_tracking = true };
+    SdsError err = sds_register_table_ex(
+        table, table_type, SDS_ROLE_DEVICE, &opts,
+        offsetof(DeltaDeviceTable, config), sizeof(DeltaConfig),
+        offsetof(DeltaDeviceTable, state), sizeof(DeltaState),
+        offsetof(DeltaDeviceTable, status), sizeof(DeltaStatus),
+        NULL, deserialize_config,
+        serialize_state, NULL,
+        serialize_status, NULL
+    );
+    if (err == SDS_OK) {
+        err = sds_set_table_fields(table_type, NULL, 0,
+            delta_state_fields, DELTA_STATE_FIELD_COUNT,
+            delta_status_fields, DELTA_STATUS_FIELD_COUNT);
+    }
+    return err;
+}
+
 /* ============== Tests ============== */
 
 TEST(full_sync_when_delta_disabled) {
@@ -391,8 +429,125 @@ TEST(delta_config_values_preserved) {
     ASSERT_EQ(err, SDS_OK);
 }
 
+TEST(owner_applies_delta_state_in_place) {
+    init_with_delta("owner_node", true, 0.001f);
+    
+    DeltaOwnerTable table = {0};
+    table.config.mode = 3;
+    ASSERT_EQ(register_owner_table(&table, "DeltaTable"), SDS_OK);
+    
+    /* Config is always published in full */
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/DeltaTable/config");
+    ASSERT(msg != NULL);
+    ASSERT_STR_CONTAINS((char*)msg->payload, "\"mode\":3");
+    ASSERT_STR_CONTAINS((char*)msg->payload, "threshold");
+    
+    sds_mock_inject_message_str("sds/DeltaTable/state",
+        "{\"ts\":1,\"node\":\"dev_a\",\"temperature\":25.0,\"humidity\":60.0,\"reading_count\":7}");
+    
+    /* A delta carries only the changed field; the rest stays as it was */
+    sds_mock_inject_message_str("sds/DeltaTable/state",
+        "{\"ts\":2,\"node\":\"dev_a\",\"temperature\":26.0}");
+    ASSERT(fabsf(table.state.temperature - 26.0f) < 0.001f);
+    ASSERT(fabsf(table.state.humidity - 60.0f) < 0.001f);
+    ASSERT_EQ(table.state.reading_count, 7);
+}
+
 /* ============== Main ============== */
 
+/* ============== Dirty Tracking Tests ============== */
+
+TEST(dirty_tracking_first_sync_sends_all_fields) {
+    init_with_delta("device_node", true, 0.001f);
+    
+    DeltaDeviceTable table = {0};
+    ASSERT_EQ(register_dirty_table(&table, "DirtyTable"), SDS_OK);
+    table.state.temperature = 25.0f;
+    
+    sds_mock_advance_time(1100);
+    sds_loop();
+    
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/DirtyTable/state");
+    ASSERT(msg != NULL);
+    ASSERT_STR_CONTAINS((char*)msg->payload, "temperature");
+    ASSERT_STR_CONTAINS((char*)msg->payload, "humidity");
+    ASSERT_STR_CONTAINS((char*)msg->payload, "reading_count");
+}
+
+TEST(dirty_tracking_ignores_unmarked_changes) {
+    init_with_delta("device_node", true, 0.001f);
+    
+    DeltaDeviceTable table = {0};
+    register_dirty_table(&table, "DirtyTable");
+    sds_mock_advance_time(1100);
+    sds_loop();
+    sds_mock_clear_publishes();
+    
+    table.state.temperature = 30.0f;
+    table.status.battery_level = 50;
+    sds_mock_advance_time(1100);
+    sds_loop();
+    
+    ASSERT(sds_mock_find_publish_by_topic("sds/DirtyTable/state") == NULL);
+    ASSERT(sds_mock_find_publish_by_topic("sds/DirtyTable/status/device_node") == NULL);
+}
+
+TEST(dirty_tracking_sends_marked_fields) {
+    init_with_delta("device_node", true, 0.001f);
+    
+    DeltaDeviceTable table = {0};
+    register_dirty_table(&table, "DirtyTable");
+    sds_mock_advance_time(1100);
+    sds_loop();
+    sds_mock_clear_publishes();
+    
+    /* humidity changes too, but only reading_count is marked */
+    table.state.humidity = 70.0f;
+    table.state.reading_count = 42;
+    table.status.battery_level = 50;
+    ASSERT_EQ(sds_mark_dirty("DirtyTable", SDS_SECTION_STATE, 2), SDS_OK);
+    ASSERT_EQ(sds_mark_dirty("DirtyTable", SDS_SECTION_STATUS, 1), SDS_OK);
+    
+    sds_mock_advance_time(1100);
+    sds_loop();
+    
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/DirtyTable/state");
+    ASSERT(msg != NULL);
+    ASSERT_STR_CONTAINS((char*)msg->payload, "\"reading_count\":42");
+    ASSERT_STR_NOT_CONTAINS((char*)msg->payload, "humidity");
+    
+    msg = sds_mock_find_publish_by_topic("sds/DirtyTable/status/device_node");
+    ASSERT(msg != NULL);
+    ASSERT_STR_CONTAINS((char*)msg->payload, "\"battery_level\":50");
+    ASSERT_STR_NOT_CONTAINS((char*)msg->payload, "error_code");
+    
+    /* Marks are cleared by the publish */
+    sds_mock_clear_publishes();
+    sds_mock_advance_time(1100);
+    sds_loop();
+    ASSERT(sds_mock_find_publish_by_topic("sds/DirtyTable/state") == NULL);
+}
+
+TEST(mark_dirty_validates_arguments) {
+    init_with_delta("device_node", true, 0.001f);
+    
+    DeltaDeviceTable dirty = {0};
+    DeltaDeviceTable plain = {0};
+    register_dirty_table(&dirty, "DirtyTable");
+    register_device_table(&plain, "DeltaTable");
+    
+    ASSERT_EQ(sds_mark_dirty("NoSuchTable", SDS_SECTION_STATE, 0), SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT_EQ(sds_mark_dirty("DirtyTable", SDS_SECTION_STATE, DELTA_STATE_FIELD_COUNT), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_mark_dirty("DirtyTable", (SdsSection)7, 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_mark_dirty("DirtyTable", SDS_SECTION_CONFIG, SDS_ALL_FIELDS), SDS_OK);
+    
+    /* Tables without dirty tracking accept and ignore marks */
+    ASSERT_EQ(sds_mark_dirty("DeltaTable", SDS_SECTION_STATE, SDS_ALL_FIELDS), SDS_OK);
+    
+    sds_shutdown();
+    ASSERT_EQ(sds_mark_dirty("DirtyTable", SDS_SECTION_STATE, 0), SDS_ERR_NOT_INITIALIZED);
+}
+
 int main(void) {
     printf("\n");
     printf("╔══════════════════════════════════════════════════════════════╗\n");
@@ -416,6 +571,13 @@ int main(void) {
     
     printf("\n─── Configuration Tests ───\n");
     RUN_TEST(delta_config_values_preserved);
+    RUN_TEST(owner_applies_delta_state_in_place);
+    
+    printf("\n─── Dirty Tracking Tests ───\n");
+    RUN_TEST(dirty_tracking_first_sync_sends_all_fields);
+    RUN_TEST(dirty_tracking_ignores_unmarked_changes);
+    RUN_TEST(dirty_tracking_sends_marked_fields);
+    RUN_TEST(mark_dirty_validates_arguments);
     
     printf("\n");
     printf("══════════════════════════════════════════════════════════════\n");
@@ -113,6 +113,9 @@ TEST(init_empty_broker) {
     };
     /* Empty broker should fail during connect, not validation */
     /* The behavior depends on platform */
+    SdsError err = sds_init(&config);
+    ASSERT(err != SDS_ERR_INVALID_CONFIG);
+    sds_shutdown();
 }
 
 TEST(init_broker_too_long) {
@@ -424,6 +427,7 @@ int main(int argc, char* argv[]) {
     printf("--- Initialization Error Tests ---\n");
     RUN_TEST(init_null_config);
     RUN_TEST(init_null_broker);
+    RUN_TEST(init_empty_broker);
     RUN_TEST(init_broker_too_long);
     RUN_TEST(init_node_id_too_long);
     RUN_TEST(init_double_init);
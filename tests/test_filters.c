@@ -0,0 +1,446 @@
+/*
+ * test_filters.c - Significance Filter Tests
+ *
+ * Tests per-field deadband, hysteresis and minimum publish interval with
+ * the mock platform:
+ * - Changes inside the deadband are held, drift adds up until it crosses
+ * - Integer deadbands
+ * - Reversing direction needs the extra hysteresis
+ * - Minimum interval holds a changed field and releases it later
+ * - Filters gate full (non-delta) publishes and dirty-tracked fields
+ * - Unfiltered sections keep comparing whole sections
+ * - History slots carved from the table arena, or skipped without room
+ *
+ * Build:
+ *   gcc -I../include -o test_filters test_filters.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_filters
+ */
+
+#include "sds.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_STR_CONTAINS(haystack, needle) ASSERT(strstr((haystack), (needle)) != NULL)
+#define ASSERT_STR_NOT_CONTAINS(haystack, needle) ASSERT(strstr((haystack), (needle)) == NULL)
+
+/* ============== Table Definitions ============== */
+
+typedef struct {
+    uint8_t mode;
+} FilterConfig;
+
+typedef struct {
+    float temperature;
+    float humidity;
+    uint32_t count;
+    uint8_t flags;
+} FilterState;
+
+typedef struct {
+    uint8_t battery;
+    uint8_t error_code;
+} FilterStatus;
+
+typedef struct {
+    FilterConfig config;
+    FilterState state;
+    FilterStatus status;
+} FilterDeviceTable;
+
+static const SdsFieldMeta filter_config_fields[] = {
+    { .name = "mode", .type = SDS_FIELD_UINT8, .offset = offsetof(FilterConfig, mode), .size = sizeof(uint8_t) },
+};
+
+static const SdsFieldMeta filter_state_fields[] = {
+    { .name = "temperature", .type = SDS_FIELD_FLOAT, .offset = offsetof(FilterState, temperature), .size = sizeof(float), .deadband = 0.5f },
+    { .name = "humidity", .type = SDS_FIELD_FLOAT, .offset = offsetof(FilterState, humidity), .size = sizeof(float), .deadband = 0.2f, .hysteresis = 1.0f },
+    { .name = "count", .type = SDS_FIELD_UINT32, .offset = offsetof(FilterState, count), .size = sizeof(uint32_t), .min_interval_ms = 2500 },
+    { .name = "flags", .type = SDS_FIELD_UINT8, .offset = offsetof(FilterState, flags), .size = sizeof(uint8_t) },
+};
+
+static const SdsFieldMeta filter_status_fields[] = {
+    { .name = "battery", .type = SDS_FIELD_UINT8, .offset = offsetof(FilterStatus, battery), .size = sizeof(uint8_t), .deadband = 1.0f },
+    { .name = "error_code", .type = SDS_FIELD_UINT8, .offset = offsetof(FilterStatus, error_code), .size = sizeof(uint8_t) },
+};
+
+/* Same layout without filters */
+static const SdsFieldMeta plain_state_fields[] = {
+    { .name = "temperature", .type = SDS_FIELD_FLOAT, .offset = offsetof(FilterState, temperature), .size = sizeof(float) },
+    { .name = "humidity", .type = SDS_FIELD_FLOAT, .offset = offsetof(FilterState, humidity), .size = sizeof(float) },
+    { .name = "count", .type = SDS_FIELD_UINT32, .offset = offsetof(FilterState, count), .size = sizeof(uint32_t) },
+    { .name = "flags", .type = SDS_FIELD_UINT8, .offset = offsetof(FilterState, flags), .size = sizeof(uint8_t) },
+};
+
+/* ============== Helper Functions ============== */
+
+static FilterDeviceTable g_table;
+static uint8_t g_arena[4096];
+
+/* arena_size 0 uses the built-in arena */
+static SdsError init_device_in(size_t arena_size, bool delta, bool dirty_tracking,
+                               const SdsFieldMeta* state_fields) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = "dev_a",
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_delta_sync = delta,
+        .delta_float_tolerance = 0.001f,
+    };
+    if (arena_size > 0) {
+        config.table_arena = g_arena;
+        config.table_arena_size = arena_size;
+        config.max_tables = 1;
+    }
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_table, 0, sizeof(g_table));
+    SdsTableOptions opts = { .sync_interval_ms = 1000, .dirty_tracking = dirty_tracking };
+    err = sds_register_table_ex(
+        &g_table, "Filter", SDS_ROLE_DEVICE, &opts,
+        offsetof(FilterDeviceTable, config), sizeof(FilterConfig),
+        offsetof(FilterDeviceTable, state), sizeof(FilterState),
+        offsetof(FilterDeviceTable, status), sizeof(FilterStatus),
+        NULL, NULL, NULL, NULL, NULL, NULL
+    );
+    if (err != SDS_OK) return err;
+    return sds_set_table_fields("Filter", filter_config_fields, 1,
+                                state_fields, 4, filter_status_fields, 2);
+}
+
+static SdsError init_device(bool delta, bool dirty_tracking, const SdsFieldMeta* state_fields) {
+    return init_device_in(0, delta, dirty_tracking, state_fields);
+}
+
+static size_t count_publishes(const char* topic) {
+    size_t count = 0;
+    for (size_t i = 0; i < sds_mock_get_publish_count(); i++) {
+        if (strcmp(sds_mock_get_publish(i)->topic, topic) == 0) count++;
+    }
+    return count;
+}
+
+/* Run one sync; returns the state payload it published, or NULL */
+static const char* sync_state(void) {
+    size_t before = count_publishes("sds/Filter/state");
+    sds_mock_advance_time(1000);
+    sds_loop();
+    if (count_publishes("sds/Filter/state") == before) return NULL;
+
+    for (size_t i = sds_mock_get_publish_count(); i > 0; i--) {
+        const SdsMockPublishedMessage* msg = sds_mock_get_publish(i - 1);
+        if (strcmp(msg->topic, "sds/Filter/state") == 0) return (const char*)msg->payload;
+    }
+    return NULL;
+}
+
+/* Run one sync; returns the status payload it published, or NULL */
+static const char* sync_status(void) {
+    size_t before = count_publishes("sds/Filter/status/dev_a");
+    sds_mock_advance_time(1000);
+    sds_loop();
+    if (count_publishes("sds/Filter/status/dev_a") == before) return NULL;
+    return (const char*)sds_mock_find_publish_by_topic("sds/Filter/status/dev_a")->payload;
+}
+
+/* ============== Deadband Tests ============== */
+
+TEST(deadband_holds_small_changes) {
+    ASSERT_EQ(init_device(true, false, filter_state_fields), SDS_OK);
+
+    g_table.state.temperature = 20.0f;
+    ASSERT(sync_state() != NULL);
+
+    g_table.state.temperature = 20.3f;
+    ASSERT(sync_state() == NULL);
+    g_table.state.temperature = 19.6f;
+    ASSERT(sync_state() == NULL);
+}
+
+TEST(deadband_accumulates_drift) {
+    ASSERT_EQ(init_device(true, false, filter_state_fields), SDS_OK);
+
+    g_table.state.temperature = 20.0f;
+    ASSERT(sync_state() != NULL);
+
+    /* Each step is inside the deadband; the total is not */
+    g_table.state.temperature = 20.3f;
+    ASSERT(sync_state() == NULL);
+    g_table.state.temperature = 20.6f;
+    const char* payload = sync_state();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"temperature\":20.6");
+
+    /* Measured from the new published value */
+    g_table.state.temperature = 21.0f;
+    ASSERT(sync_state() == NULL);
+}
+
+TEST(integer_deadband) {
+    ASSERT_EQ(init_device(true, false, filter_state_fields), SDS_OK);
+
+    g_table.status.battery = 50;
+    ASSERT(sync_status() != NULL);
+
+    g_table.status.battery = 51;
+    ASSERT(sync_status() == NULL);
+    g_table.status.battery = 52;
+    const char* payload = sync_status();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"battery\":52");
+}
+
+TEST(unfiltered_field_publishes_alone) {
+    ASSERT_EQ(init_device(true, false, filter_state_fields), SDS_OK);
+
+    g_table.state.temperature = 20.0f;
+    g_table.state.flags = 1;
+    ASSERT(sync_state() != NULL);
+
+    g_table.state.temperature = 20.2f;
+    g_table.state.flags = 2;
+    const char* payload = sync_state();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"flags\":2");
+    ASSERT_STR_NOT_CONTAINS(payload, "temperature");
+}
+
+/* ============== Hysteresis Tests ============== */
+
+TEST(hysteresis_needs_extra_to_reverse) {
+    ASSERT_EQ(init_device(true, false, filter_state_fields), SDS_OK);
+
+    g_table.state.humidity = 50.0f;
+    ASSERT(sync_state() != NULL);
+    g_table.state.humidity = 51.0f;
+    ASSERT(sync_state() != NULL);
+
+    /* Falling back needs more than deadband + hysteresis (1.2) */
+    g_table.state.humidity = 50.5f;
+    ASSERT(sync_state() == NULL);
+    g_table.state.humidity = 50.0f;
+    ASSERT(sync_state() == NULL);
+    g_table.state.humidity = 49.7f;
+    const char* payload = sync_state();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "humidity");
+
+    /* Still falling: only the deadband applies */
+    g_table.state.humidity = 49.4f;
+    ASSERT(sync_state() != NULL);
+}
+
+/* ============== Minimum Interval Tests ============== */
+
+TEST(min_interval_holds_field) {
+    ASSERT_EQ(init_device(true, false, filter_state_fields), SDS_OK);
+
+    g_table.state.count = 1;
+    ASSERT(sync_state() != NULL);
+
+    g_table.state.count = 2;
+    ASSERT(sync_state() == NULL);
+    ASSERT(sync_state() == NULL);
+
+    /* 3000 ms after the last publish: released with the latest value */
+    g_table.state.count = 3;
+    const char* payload = sync_state();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"count\":3");
+}
+
+TEST(min_interval_does_not_hold_other_fields) {
+    ASSERT_EQ(init_device(true, false, filter_state_fields), SDS_OK);
+
+    g_table.state.count = 1;
+    ASSERT(sync_state() != NULL);
+
+    g_table.state.count = 2;
+    g_table.state.flags = 1;
+    const char* payload = sync_state();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"flags\":1");
+    ASSERT_STR_NOT_CONTAINS(payload, "count");
+}
+
+/* ============== Publish Mode Tests ============== */
+
+TEST(filters_gate_full_publishes) {
+    ASSERT_EQ(init_device(false, false, filter_state_fields), SDS_OK);
+
+    g_table.state.temperature = 20.0f;
+    ASSERT(sync_state() != NULL);
+
+    g_table.state.temperature = 20.3f;
+    ASSERT(sync_state() == NULL);
+
+    g_table.state.temperature = 20.6f;
+    const char* payload = sync_state();
+    ASSERT(payload != NULL);
+    /* Full section */
+    ASSERT_STR_CONTAINS(payload, "temperature");
+    ASSERT_STR_CONTAINS(payload, "humidity");
+    ASSERT_STR_CONTAINS(payload, "flags");
+}
+
+TEST(dirty_field_inside_deadband_stays_pending) {
+    ASSERT_EQ(init_device(true, true, filter_state_fields), SDS_OK);
+
+    sds_mark_dirty("Filter", SDS_SECTION_STATE, SDS_ALL_FIELDS);
+    g_table.state.temperature = 20.0f;
+    ASSERT(sync_state() != NULL);
+
+    g_table.state.temperature = 20.3f;
+    sds_mark_dirty("Filter", SDS_SECTION_STATE, 0);
+    ASSERT(sync_state() == NULL);
+
+    /* Still dirty: crossing the deadband later publishes it unmarked */
+    g_table.state.temperature = 20.6f;
+    const char* payload = sync_state();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "temperature");
+
+    /* Dirty fields without filters publish as before */
+    sds_mark_dirty("Filter", SDS_SECTION_STATE, 3);
+    payload = sync_state();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"flags\":0");
+}
+
+TEST(unfiltered_section_compares_whole_section) {
+    ASSERT_EQ(init_device(true, false, plain_state_fields), SDS_OK);
+
+    g_table.state.temperature = 20.0f;
+    ASSERT(sync_state() != NULL);
+
+    g_table.state.temperature = 20.3f;
+    const char* payload = sync_state();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "temperature");
+}
+
+/* ============== Arena Tests ============== */
+
+/* Key cache of the filter table's fields: name + 4 bytes each, plus 1, rounded */
+#define FILTER_KEY_BYTES 80
+
+TEST(history_slots_carved_from_table_arena) {
+    size_t tables = sds_table_arena_size(1, sizeof(FilterConfig) + sizeof(FilterState) + sizeof(FilterStatus));
+    ASSERT(tables + FILTER_KEY_BYTES + 64 <= sizeof(g_arena));
+
+    /* No room for history: the deadband still applies, min interval does not */
+    ASSERT_EQ(init_device_in(tables + FILTER_KEY_BYTES, true, false, filter_state_fields), SDS_OK);
+    ASSERT(sds_mock_log_contains("ignores hysteresis and min interval"));
+    g_table.state.count = 1;
+    ASSERT(sync_state() != NULL);
+    g_table.state.count = 2;
+    ASSERT(sync_state() != NULL);
+    g_table.state.temperature = 0.3f;
+    ASSERT(sync_state() == NULL);
+    sds_shutdown();
+    sds_mock_reset();
+
+    ASSERT_EQ(init_device_in(tables + FILTER_KEY_BYTES + 64, true, false, filter_state_fields), SDS_OK);
+    ASSERT(!sds_mock_log_contains("ignores hysteresis and min interval"));
+    g_table.state.count = 1;
+    ASSERT(sync_state() != NULL);
+    g_table.state.count = 2;
+    ASSERT(sync_state() == NULL);
+
+    /* Fewer tracked fields reuse the same slots */
+    ASSERT_EQ(sds_set_table_fields("Filter", filter_config_fields, 1,
+                                   plain_state_fields, 4, filter_status_fields, 2), SDS_OK);
+    ASSERT_EQ(sds_set_table_fields("Filter", filter_config_fields, 1,
+                                   filter_state_fields, 4, filter_status_fields, 2), SDS_OK);
+    ASSERT(!sds_mock_log_contains("ignores hysteresis and min interval"));
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║          Significance Filter Tests (Mock Platform)           ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Deadband Tests ───\n");
+    RUN_TEST(deadband_holds_small_changes);
+    RUN_TEST(deadband_accumulates_drift);
+    RUN_TEST(integer_deadband);
+    RUN_TEST(unfiltered_field_publishes_alone);
+
+    printf("\n─── Hysteresis Tests ───\n");
+    RUN_TEST(hysteresis_needs_extra_to_reverse);
+
+    printf("\n─── Minimum Interval Tests ───\n");
+    RUN_TEST(min_interval_holds_field);
+    RUN_TEST(min_interval_does_not_hold_other_fields);
+
+    printf("\n─── Publish Mode Tests ───\n");
+    RUN_TEST(filters_gate_full_publishes);
+    RUN_TEST(dirty_field_inside_deadband_stays_pending);
+    RUN_TEST(unfiltered_section_compares_whole_section);
+
+    printf("\n─── Arena Tests ───\n");
+    RUN_TEST(history_slots_carved_from_table_arena);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
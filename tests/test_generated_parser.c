@@ -0,0 +1,215 @@
+/*
+ * test_generated_parser.c - Generated Deserializer Tests
+ *
+ * Tests the per-section deserializers sds-codegen emits into sds_types.h:
+ * - One pass over the payload, fields in any order
+ * - Envelope keys, unknown keys and nested objects are skipped
+ * - Out-of-range values leave the field untouched
+ * - Indexed, truncated-index and plain readers give the same result
+ *
+ * Build:
+ *   gcc -I../include -o test_generated_parser test_generated_parser.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_generated_parser
+ */
+
+#include "sds.h"
+#include "sds_json.h"
+#include "sds_types.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    test_##name(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helpers ============== */
+
+static SdsJsonSpan g_spans[SDS_JSON_MAX_INDEX_FIELDS];
+
+static void parse_config(SensorDataConfig* cfg, const char* json, bool indexed) {
+    SdsJsonReader r;
+    if (indexed) {
+        sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS);
+    } else {
+        sds_json_reader_init(&r, json, strlen(json));
+    }
+    sensor_data_deserialize_config(cfg, &r);
+}
+
+static void parse_status(SensorDataStatus* st, const char* json) {
+    SdsJsonReader r;
+    sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS);
+    sensor_data_deserialize_status(st, &r);
+}
+
+/* ============== Field Dispatch Tests ============== */
+
+TEST(fields_in_declaration_order) {
+    SensorDataConfig cfg = {0};
+    parse_config(&cfg, "{\"command\":7,\"threshold\":12.5}", true);
+    ASSERT_EQ(cfg.command, 7);
+    ASSERT_EQ(cfg.threshold, 12.5f);
+}
+
+TEST(fields_in_any_order) {
+    SensorDataStatus st = {0};
+    parse_status(&st, "{\"uptime_seconds\":86400,\"battery_percent\":80,\"error_code\":3}");
+    ASSERT_EQ(st.error_code, 3);
+    ASSERT_EQ(st.battery_percent, 80);
+    ASSERT_EQ(st.uptime_seconds, 86400u);
+}
+
+TEST(envelope_keys_ignored) {
+    SensorDataStatus st = {0};
+    parse_status(&st, "{\"ts\":1000,\"from\":\"node1\",\"online\":true,"
+                      "\"seq\":4,\"error_code\":1,\"battery_percent\":50,"
+                      "\"uptime_seconds\":9}");
+    ASSERT_EQ(st.error_code, 1);
+    ASSERT_EQ(st.battery_percent, 50);
+    ASSERT_EQ(st.uptime_seconds, 9u);
+}
+
+TEST(unknown_key_of_same_length_ignored) {
+    SensorDataConfig cfg = {0};
+    /* "commands" misses on length, "comman_" on the key compare */
+    parse_config(&cfg, "{\"comman_\":1,\"commands\":2,\"command\":3}", true);
+    ASSERT_EQ(cfg.command, 3);
+}
+
+TEST(missing_fields_untouched) {
+    SensorDataConfig cfg = { .command = 9, .threshold = 1.5f };
+    parse_config(&cfg, "{\"threshold\":4.0}", true);
+    ASSERT_EQ(cfg.command, 9);
+    ASSERT_EQ(cfg.threshold, 4.0f);
+}
+
+TEST(uint8_out_of_range_rejected) {
+    SensorDataStatus st = { .battery_percent = 42 };
+    parse_status(&st, "{\"battery_percent\":300,\"error_code\":255}");
+    ASSERT_EQ(st.battery_percent, 42);
+    ASSERT_EQ(st.error_code, 255);
+}
+
+TEST(wrong_value_type_rejected) {
+    SensorDataConfig cfg = { .command = 5 };
+    parse_config(&cfg, "{\"command\":\"high\",\"threshold\":2.0}", true);
+    ASSERT_EQ(cfg.command, 5);
+    ASSERT_EQ(cfg.threshold, 2.0f);
+}
+
+TEST(nested_object_skipped) {
+    SensorDataConfig cfg = {0};
+    parse_config(&cfg, "{\"meta\":{\"command\":9,\"list\":[1,{\"command\":8}]},"
+                       "\"command\":4}", true);
+    ASSERT_EQ(cfg.command, 4);
+}
+
+/* ============== Reader Mode Tests ============== */
+
+TEST(plain_reader_matches_indexed) {
+    const char* json = "{\"threshold\":3.25,\"ts\":5,\"command\":2}";
+    SensorDataConfig a = {0};
+    SensorDataConfig b = {0};
+    parse_config(&a, json, true);
+    parse_config(&b, json, false);
+    ASSERT_EQ(a.command, 2);
+    ASSERT_EQ(a.threshold, 3.25f);
+    ASSERT_EQ(b.command, a.command);
+    ASSERT_EQ(b.threshold, a.threshold);
+}
+
+TEST(fields_past_truncated_index) {
+    /* More top-level keys than the index holds, section fields last */
+    char json[2048];
+    size_t n = 0;
+    n += (size_t)snprintf(json + n, sizeof(json) - n, "{");
+    for (int i = 0; i < SDS_JSON_MAX_INDEX_FIELDS + 8; i++) {
+        n += (size_t)snprintf(json + n, sizeof(json) - n, "\"x%d\":%d,", i, i);
+    }
+    snprintf(json + n, sizeof(json) - n, "\"threshold\":6.5,\"command\":11}");
+
+    SdsJsonReader r;
+    sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS);
+    ASSERT_EQ(r.index_state, SDS_JSON_INDEX_TRUNCATED);
+
+    SensorDataConfig cfg = {0};
+    sensor_data_deserialize_config(&cfg, &r);
+    ASSERT_EQ(cfg.command, 11);
+    ASSERT_EQ(cfg.threshold, 6.5f);
+}
+
+TEST(malformed_payload_stops_cleanly) {
+    SensorDataConfig cfg = { .command = 1 };
+    parse_config(&cfg, "{\"command\":6,\"threshold\"", false);
+    ASSERT_EQ(cfg.command, 6);
+    parse_config(&cfg, "", false);
+    parse_config(&cfg, "[1,2]", true);
+    ASSERT_EQ(cfg.command, 6);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║          SDS Generated Parser Tests                          ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n");
+
+    printf("\n─── Field Dispatch ───\n");
+    RUN_TEST(fields_in_declaration_order);
+    RUN_TEST(fields_in_any_order);
+    RUN_TEST(envelope_keys_ignored);
+    RUN_TEST(unknown_key_of_same_length_ignored);
+    RUN_TEST(missing_fields_untouched);
+    RUN_TEST(uint8_out_of_range_rejected);
+    RUN_TEST(wrong_value_type_rejected);
+    RUN_TEST(nested_object_skipped);
+
+    printf("\n─── Reader Modes ───\n");
+    RUN_TEST(plain_reader_matches_indexed);
+    RUN_TEST(fields_past_truncated_index);
+    RUN_TEST(malformed_payload_stops_cleanly);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
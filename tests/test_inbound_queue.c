@@ -0,0 +1,431 @@
+/*
+ * test_inbound_queue.c - Inbound Queue and Ingest Worker Tests
+ *
+ * Tests the per-table inbound queue with the mock platform:
+ * - Messages are queued on receive instead of applied inline
+ * - Ingest workers (simulated) vs. applying from sds_loop()
+ * - Callbacks on the worker or deferred to sds_loop()
+ * - Per-table ordering, LWT ordering and full-queue drops
+ * - Unregistering a table drops its queued messages
+ * - sds_on_wake() runs once per received message, after it was queued
+ *
+ * Build:
+ *   gcc -I../include -o test_inbound_queue test_inbound_queue.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_inbound_queue
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+static SensorDataOwnerTable g_sensor;
+static ActuatorDataOwnerTable g_actuator;
+
+static int g_status_calls = 0;
+static char g_status_node[SDS_MAX_NODE_ID_LEN];
+static int g_status_locks_held = 0;
+
+static void on_status(const char* table_type, const char* from_node, void* user_data) {
+    (void)table_type;
+    (void)user_data;
+    g_status_calls++;
+    g_status_locks_held = sds_mock_get_table_locks_held();
+    strncpy(g_status_node, from_node, sizeof(g_status_node) - 1);
+}
+
+static SdsError init_owner(uint8_t depth, uint8_t workers, bool async, SdsCallbackExecutor executor) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+        .ingest_async = async,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = "owner1",
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .inbound_queue_depth = depth,
+        .ingest_workers = workers,
+        .callback_executor = executor,
+    };
+
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_sensor, 0, sizeof(g_sensor));
+    memset(&g_actuator, 0, sizeof(g_actuator));
+    g_status_calls = 0;
+    g_status_node[0] = '\0';
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    err = sds_register_table(&g_sensor, "SensorData", SDS_ROLE_OWNER, &opts);
+    if (err != SDS_OK) return err;
+    err = sds_register_table(&g_actuator, "ActuatorData", SDS_ROLE_OWNER, &opts);
+    if (err != SDS_OK) return err;
+
+    sds_on_status_update("SensorData", on_status, NULL);
+    return SDS_OK;
+}
+
+static void inject_sensor_status(const char* node, int battery) {
+    char topic[64];
+    char payload[128];
+    snprintf(topic, sizeof(topic), "sds/SensorData/status/%s", node);
+    snprintf(payload, sizeof(payload),
+             "{\"ts\":1,\"online\":true,\"error_code\":0,\"battery_percent\":%d,\"uptime_seconds\":5}",
+             battery);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+static const SensorDataStatus* sensor_status(const char* node) {
+    return (const SensorDataStatus*)sds_find_node_status(&g_sensor, "SensorData", node);
+}
+
+/* ============== Queue Mode Tests ============== */
+
+TEST(depth_zero_applies_on_receive) {
+    ASSERT_EQ(init_owner(0, 0, false, SDS_CALLBACKS_WORKER), SDS_OK);
+
+    inject_sensor_status("dev1", 80);
+
+    ASSERT(sensor_status("dev1") != NULL);
+    ASSERT_EQ(g_status_calls, 1);
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 0);
+}
+
+TEST(loop_applies_queue_without_workers) {
+    ASSERT_EQ(init_owner(4, 2, false, SDS_CALLBACKS_WORKER), SDS_OK);
+
+    inject_sensor_status("dev1", 80);
+
+    /* Queued, not applied */
+    ASSERT(sensor_status("dev1") == NULL);
+    ASSERT_EQ(g_status_calls, 0);
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 1);
+    ASSERT_EQ(sds_next_deadline_ms(), 0);
+
+    sds_loop();
+
+    const SensorDataStatus* st = sensor_status("dev1");
+    ASSERT(st != NULL);
+    ASSERT_EQ(st->battery_percent, 80);
+    ASSERT_EQ(g_status_calls, 1);
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 0);
+}
+
+TEST(workers_apply_outside_loop) {
+    ASSERT_EQ(init_owner(4, 2, true, SDS_CALLBACKS_WORKER), SDS_OK);
+
+    inject_sensor_status("dev1", 80);
+    ASSERT_EQ(sds_mock_get_ingest_notify_count(), 2);  /* One at start, one for the message */
+
+    /* sds_loop() leaves table messages to the workers */
+    sds_loop();
+    ASSERT(sensor_status("dev1") == NULL);
+
+    ASSERT_EQ(sds_mock_run_ingest_workers(), 1);
+    ASSERT(sensor_status("dev1") != NULL);
+    ASSERT_EQ(g_status_calls, 1);
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 0);
+}
+
+TEST(callbacks_deferred_to_loop) {
+    ASSERT_EQ(init_owner(4, 2, true, SDS_CALLBACKS_LOOP), SDS_OK);
+
+    inject_sensor_status("dev1", 80);
+    ASSERT_EQ(sds_mock_run_ingest_workers(), 1);
+
+    /* Applied; the callback waits for sds_loop() and holds its slot */
+    ASSERT(sensor_status("dev1") != NULL);
+    ASSERT_EQ(g_status_calls, 0);
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 1);
+    ASSERT_EQ(sds_next_deadline_ms(), 0);
+
+    sds_loop();
+
+    ASSERT_EQ(g_status_calls, 1);
+    ASSERT(strcmp(g_status_node, "dev1") == 0);
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 0);
+}
+
+TEST(lwt_callback_deferred_to_loop) {
+    ASSERT_EQ(init_owner(4, 2, true, SDS_CALLBACKS_LOOP), SDS_OK);
+
+    inject_sensor_status("dev1", 80);
+    ASSERT_EQ(sds_mock_run_ingest_workers(), 1);
+    sds_loop();
+    ASSERT_EQ(g_status_calls, 1);
+
+    sds_mock_inject_message_str("sds/lwt/dev1", "{\"online\":false,\"node\":\"dev1\"}");
+    g_status_locks_held = -1;
+    sds_loop();
+
+    /* Run from sds_loop() with no table lock held, like other deferred callbacks */
+    ASSERT_EQ(g_status_calls, 2);
+    ASSERT_EQ(g_status_locks_held, 0);
+    ASSERT(!sds_is_device_online(&g_sensor, "SensorData", "dev1", 60000));
+}
+
+/* ============== Ordering Tests ============== */
+
+TEST(table_messages_applied_in_order) {
+    ASSERT_EQ(init_owner(8, 2, true, SDS_CALLBACKS_WORKER), SDS_OK);
+
+    inject_sensor_status("dev1", 10);
+    inject_sensor_status("dev1", 20);
+    sds_mock_inject_message_str("sds/ActuatorData/status/act1",
+                                "{\"ts\":1,\"online\":true,\"motor_status\":2}");
+    inject_sensor_status("dev1", 30);
+
+    ASSERT_EQ(sds_mock_run_ingest_workers(), 4);
+
+    ASSERT_EQ(sensor_status("dev1")->battery_percent, 30);
+    ASSERT_EQ(g_status_calls, 3);
+    ASSERT(sds_find_node_status(&g_actuator, "ActuatorData", "act1") != NULL);
+}
+
+TEST(lwt_waits_for_earlier_messages) {
+    ASSERT_EQ(init_owner(4, 2, true, SDS_CALLBACKS_WORKER), SDS_OK);
+
+    inject_sensor_status("dev1", 80);
+    sds_mock_inject_message_str("sds/lwt/dev1", "{\"online\":false,\"node\":\"dev1\"}");
+
+    /* The status has not been applied yet, so neither is the LWT */
+    sds_loop();
+    ASSERT(sensor_status("dev1") == NULL);
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 2);
+
+    ASSERT_EQ(sds_mock_run_ingest_workers(), 1);
+    ASSERT(sds_is_device_online(&g_sensor, "SensorData", "dev1", 60000));
+
+    sds_loop();
+    ASSERT(!sds_is_device_online(&g_sensor, "SensorData", "dev1", 60000));
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 0);
+}
+
+/* ============== Limit Tests ============== */
+
+TEST(full_queue_drops_new_messages) {
+    ASSERT_EQ(init_owner(2, 0, false, SDS_CALLBACKS_WORKER), SDS_OK);
+
+    inject_sensor_status("dev1", 10);
+    inject_sensor_status("dev2", 20);
+    inject_sensor_status("dev3", 30);
+
+    const SdsStats* stats = sds_get_stats();
+    ASSERT_EQ(stats->inbound_queued, 2);
+    ASSERT_EQ(stats->inbound_high_water, 2);
+    ASSERT_EQ(stats->inbound_dropped, 1);
+
+    sds_loop();
+
+    ASSERT(sensor_status("dev1") != NULL);
+    ASSERT(sensor_status("dev2") != NULL);
+    ASSERT(sensor_status("dev3") == NULL);
+}
+
+TEST(depth_clamped_to_queue_max) {
+    ASSERT_EQ(init_owner(255, 0, false, SDS_CALLBACKS_WORKER), SDS_OK);
+
+    char node[16];
+    for (int i = 0; i < SDS_INBOUND_QUEUE_MAX + 1; i++) {
+        snprintf(node, sizeof(node), "dev%d", i);
+        inject_sensor_status(node, i);
+    }
+
+    ASSERT_EQ(sds_get_stats()->inbound_high_water, SDS_INBOUND_QUEUE_MAX);
+    ASSERT_EQ(sds_get_stats()->inbound_dropped, 1);
+}
+
+TEST(pool_carved_from_table_arena) {
+    static uint64_t arena[32768 / 8];
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = "owner1",
+        .mqtt_broker = "mock_broker",
+        .inbound_queue_depth = 4,
+        .table_arena = arena,
+        .max_tables = 1,
+    };
+
+    /* Room for the table only: the pool does not fit */
+    config.table_arena_size = sds_table_arena_size(1, sizeof(SensorDataConfig));
+    ASSERT_EQ(sds_init(&config), SDS_ERR_INVALID_CONFIG);
+
+    config.table_arena_size = sds_config_arena_size(&config, 2 * sizeof(SensorDataConfig));
+    ASSERT(config.table_arena_size <= sizeof(arena));
+    ASSERT_EQ(sds_init(&config), SDS_OK);
+
+    memset(&g_sensor, 0, sizeof(g_sensor));
+    ASSERT_EQ(sds_register_table(&g_sensor, "SensorData", SDS_ROLE_OWNER, NULL), SDS_OK);
+    inject_sensor_status("dev1", 80);
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 1);
+    sds_loop();
+    ASSERT(sensor_status("dev1") != NULL);
+}
+
+TEST(unregister_drops_queued_messages) {
+    ASSERT_EQ(init_owner(4, 2, true, SDS_CALLBACKS_LOOP), SDS_OK);
+
+    inject_sensor_status("dev1", 10);
+    sds_mock_inject_message_str("sds/ActuatorData/status/act1",
+                                "{\"ts\":1,\"online\":true,\"motor_status\":2}");
+    ASSERT_EQ(sds_mock_run_ingest_workers(), 2);  /* SensorData callback now deferred */
+    inject_sensor_status("dev2", 20);
+
+    ASSERT_EQ(sds_unregister_table("SensorData"), SDS_OK);
+
+    ASSERT_EQ(sds_get_stats()->inbound_queued, 0);
+    ASSERT_EQ(sds_mock_run_ingest_workers(), 0);
+    sds_loop();
+    ASSERT_EQ(g_status_calls, 0);
+    ASSERT(sds_find_node_status(&g_actuator, "ActuatorData", "act1") != NULL);
+}
+
+TEST(lock_table_checks_table) {
+    ASSERT_EQ(sds_lock_table("SensorData"), SDS_ERR_NOT_INITIALIZED);
+    ASSERT_EQ(init_owner(4, 2, true, SDS_CALLBACKS_WORKER), SDS_OK);
+
+    ASSERT_EQ(sds_lock_table("SensorData"), SDS_OK);
+    ASSERT_EQ(sds_unlock_table("SensorData"), SDS_OK);
+    ASSERT_EQ(sds_lock_table("Unknown"), SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT_EQ(sds_unlock_table("Unknown"), SDS_ERR_TABLE_NOT_FOUND);
+}
+
+/* ============== Wake Tests ============== */
+
+static int g_wakes = 0;
+static int g_queued_at_wake = -1;
+
+static void on_wake(void* user_data) {
+    g_wakes++;
+    g_queued_at_wake = (int)sds_get_stats()->inbound_queued;
+    (void)user_data;
+}
+
+TEST(wake_after_message_is_queued) {
+    ASSERT_EQ(init_owner(4, 0, false, SDS_CALLBACKS_WORKER), SDS_OK);
+    g_wakes = 0;
+    sds_on_wake(on_wake, NULL);
+
+    inject_sensor_status("dev1", 80);
+    ASSERT_EQ(g_wakes, 1);
+    ASSERT_EQ(g_queued_at_wake, 1);
+
+    /* Raw and LWT messages wake too; sds_loop() itself does not */
+    sds_mock_inject_message_str("sds/lwt/dev1", "{\"online\":false,\"node\":\"dev1\"}");
+    sds_mock_inject_message_str("custom/topic", "x");
+    ASSERT_EQ(g_wakes, 3);
+    sds_loop();
+    ASSERT_EQ(g_wakes, 3);
+}
+
+TEST(wake_reset_by_init) {
+    ASSERT_EQ(init_owner(0, 0, false, SDS_CALLBACKS_WORKER), SDS_OK);
+    g_wakes = 0;
+    sds_on_wake(on_wake, NULL);
+    inject_sensor_status("dev1", 80);
+    ASSERT_EQ(g_wakes, 1);
+
+    sds_shutdown();
+    ASSERT_EQ(init_owner(0, 0, false, SDS_CALLBACKS_WORKER), SDS_OK);
+    inject_sensor_status("dev1", 80);
+    ASSERT_EQ(g_wakes, 1);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║            Inbound Queue Tests (Mock Platform)               ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Queue Mode Tests ───\n");
+    RUN_TEST(depth_zero_applies_on_receive);
+    RUN_TEST(loop_applies_queue_without_workers);
+    RUN_TEST(workers_apply_outside_loop);
+    RUN_TEST(callbacks_deferred_to_loop);
+    RUN_TEST(lwt_callback_deferred_to_loop);
+
+    printf("\n─── Ordering Tests ───\n");
+    RUN_TEST(table_messages_applied_in_order);
+    RUN_TEST(lwt_waits_for_earlier_messages);
+
+    printf("\n─── Limit Tests ───\n");
+    RUN_TEST(full_queue_drops_new_messages);
+    RUN_TEST(depth_clamped_to_queue_max);
+    RUN_TEST(pool_carved_from_table_arena);
+    RUN_TEST(unregister_drops_queued_messages);
+    RUN_TEST(lock_table_checks_table);
+
+    printf("\n─── Wake Tests ───\n");
+    RUN_TEST(wake_after_message_is_queued);
+    RUN_TEST(wake_reset_by_init);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
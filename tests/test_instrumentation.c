@@ -0,0 +1,405 @@
+/*
+ * test_instrumentation.c - Instrumentation Tests
+ *
+ * Tests per-table counters and latency histograms with the mock platform:
+ * - Everything stays zero unless SdsConfig.enable_instrumentation is set
+ * - Per-table stats carved from the table arena
+ * - Sent/received messages and bytes, delta vs. full syncs
+ * - Slot-full and decode drops
+ * - Serialize, parse and callback histograms (mock microsecond clock)
+ * - sds_loop() stage histograms
+ * - Reset and argument checks
+ *
+ * Build:
+ *   gcc -I../include -o test_instrumentation test_instrumentation.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_instrumentation
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+static SensorDataOwnerTable g_owner;
+static SensorDataTable g_device;
+
+static uint32_t g_callback_work_us = 0;
+
+static void on_status(const char* table_type, const char* from_node, void* user_data) {
+    (void)table_type;
+    (void)from_node;
+    (void)user_data;
+    sds_mock_advance_micros(g_callback_work_us);
+}
+
+static SdsError init_node(const char* node_id, SdsRole role, bool instrument, bool delta) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_delta_sync = delta,
+        .enable_instrumentation = instrument,
+    };
+
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_owner, 0, sizeof(g_owner));
+    memset(&g_device, 0, sizeof(g_device));
+    g_callback_work_us = 0;
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    if (role == SDS_ROLE_OWNER) {
+        err = sds_register_table(&g_owner, "SensorData", SDS_ROLE_OWNER, &opts);
+        sds_on_status_update("SensorData", on_status, NULL);
+        return err;
+    }
+    return sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, &opts);
+}
+
+static void inject_status(const char* node, int battery) {
+    char topic[64];
+    char payload[128];
+    snprintf(topic, sizeof(topic), "sds/SensorData/status/%s", node);
+    snprintf(payload, sizeof(payload),
+             "{\"ts\":1,\"online\":true,\"error_code\":0,\"battery_percent\":%d,\"uptime_seconds\":5}",
+             battery);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+static void run_sync(void) {
+    sds_mock_advance_time(1000);
+    sds_loop();
+}
+
+static uint32_t bucket_total(const SdsLatencyHistogram* h) {
+    uint32_t total = 0;
+    for (int i = 0; i < SDS_LATENCY_BUCKETS; i++) {
+        total += h->buckets[i];
+    }
+    return total;
+}
+
+/* ============== Opt-in Tests ============== */
+
+TEST(disabled_keeps_zero) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, false, false), SDS_OK);
+
+    inject_status("dev_a", 80);
+    run_sync();
+
+    SdsTableStats ts;
+    memset(&ts, 0xFF, sizeof(ts));
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.messages_received, 0);
+    ASSERT_EQ(ts.parse_us.count, 0);
+    ASSERT_EQ(ts.callback_us.count, 0);
+
+    SdsLoopStats ls;
+    sds_get_loop_stats(&ls);
+    ASSERT_EQ(ls.loop_us.count, 0);
+    ASSERT_EQ(sds_get_stats()->messages_received, 1);
+}
+
+TEST(stats_carved_from_table_arena) {
+    static uint8_t arena[4096];
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    size_t sections = sizeof(SensorDataConfig) + sizeof(SensorDataState) + sizeof(SensorDataStatus);
+    SdsConfig config = {
+        .node_id = "device1",
+        .mqtt_broker = "mock_broker",
+        .table_arena = arena,
+        .max_tables = 1,
+    };
+    ASSERT_EQ(sds_config_arena_size(&config, sections), sds_table_arena_size(1, sections));
+    config.enable_instrumentation = true;
+    ASSERT(sds_config_arena_size(&config, sections) >= sds_table_arena_size(1, sections) + sizeof(SdsTableStats));
+
+    /* Room for the table only: it registers, without stats */
+    config.table_arena_size = sds_table_arena_size(1, sections);
+    ASSERT_EQ(sds_init(&config), SDS_OK);
+    memset(&g_device, 0, sizeof(g_device));
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    ASSERT_EQ(sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, &opts), SDS_OK);
+    g_device.state.temperature = 21.5f;
+    run_sync();
+
+    SdsTableStats ts;
+    memset(&ts, 0xFF, sizeof(ts));
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.messages_sent, 0);
+    ASSERT_EQ(ts.serialize_us.count, 0);
+    sds_shutdown();
+
+    config.table_arena_size = sds_config_arena_size(&config, sections);
+    ASSERT(config.table_arena_size <= sizeof(arena));
+    ASSERT_EQ(sds_init(&config), SDS_OK);
+    memset(&g_device, 0, sizeof(g_device));
+    ASSERT_EQ(sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, &opts), SDS_OK);
+    g_device.state.temperature = 21.5f;
+    run_sync();
+
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT(ts.messages_sent > 0);
+}
+
+/* ============== Counter Tests ============== */
+
+TEST(device_counts_sent_messages) {
+    ASSERT_EQ(init_node("device1", SDS_ROLE_DEVICE, true, false), SDS_OK);
+
+    g_device.state.temperature = 21.5f;
+    g_device.status.battery_percent = 90;
+    sds_mock_clear_publishes();
+    run_sync();
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.messages_sent, 2);
+    ASSERT_EQ(ts.full_syncs, 2);
+    ASSERT_EQ(ts.delta_syncs, 0);
+    ASSERT_EQ(ts.serialize_us.count, 2);
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < sds_mock_get_publish_count(); i++) {
+        const SdsMockPublishedMessage* msg = sds_mock_get_publish(i);
+        if (strncmp(msg->topic, "sds/SensorData/", 15) == 0) bytes += msg->payload_len;
+    }
+    ASSERT_EQ(ts.bytes_sent, (uint32_t)bytes);
+}
+
+TEST(device_counts_delta_syncs) {
+    ASSERT_EQ(init_node("device1", SDS_ROLE_DEVICE, true, true), SDS_OK);
+
+    g_device.state.temperature = 21.5f;
+    run_sync();
+    g_device.state.temperature = 22.5f;
+    run_sync();
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT(ts.delta_syncs >= 2);
+    ASSERT_EQ(ts.messages_sent, ts.delta_syncs + ts.full_syncs);
+}
+
+TEST(owner_counts_received_messages) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, false), SDS_OK);
+
+    const char* payload =
+        "{\"ts\":1,\"online\":true,\"error_code\":0,\"battery_percent\":80,\"uptime_seconds\":5}";
+    sds_mock_inject_message_str("sds/SensorData/status/dev_a", payload);
+    sds_mock_inject_message_str("sds/SensorData/status/dev_b", payload);
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.messages_received, 2);
+    ASSERT_EQ(ts.bytes_received, (uint32_t)(2 * strlen(payload)));
+    ASSERT_EQ(ts.parse_us.count, 2);
+    ASSERT_EQ(ts.callback_us.count, 2);
+    ASSERT_EQ(bucket_total(&ts.parse_us), 2);
+}
+
+TEST(owner_counts_full_slots) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, false), SDS_OK);
+
+    char node[16];
+    for (int i = 0; i <= SDS_GENERATED_MAX_NODES; i++) {
+        snprintf(node, sizeof(node), "dev_%02d", i);
+        inject_status(node, 50);
+    }
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.slots_full, 1);
+    ASSERT_EQ(ts.messages_received, SDS_GENERATED_MAX_NODES + 1);
+}
+
+TEST(owner_counts_decode_errors) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, false), SDS_OK);
+
+    /* Binary magic with a truncated header */
+    const uint8_t bad[] = { 0xB5, 0x01 };
+    sds_mock_inject_message("sds/SensorData/status/dev_a", bad, sizeof(bad));
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.decode_errors, 1);
+    ASSERT_EQ(ts.parse_us.count, 0);
+}
+
+/* ============== Histogram Tests ============== */
+
+TEST(callback_time_lands_in_log_bucket) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, false), SDS_OK);
+
+    g_callback_work_us = 300;   /* [256, 512) -> bucket 8 */
+    inject_status("dev_a", 80);
+    g_callback_work_us = 0;     /* bucket 0 */
+    inject_status("dev_a", 81);
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.callback_us.count, 2);
+    ASSERT_EQ(ts.callback_us.buckets[8], 1);
+    ASSERT_EQ(ts.callback_us.buckets[0], 1);
+    ASSERT_EQ(ts.callback_us.max_us, 300);
+    ASSERT_EQ(ts.callback_us.total_us, 300);
+}
+
+TEST(large_samples_use_last_bucket) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, false), SDS_OK);
+
+    g_callback_work_us = 5000000;
+    inject_status("dev_a", 80);
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.callback_us.buckets[SDS_LATENCY_BUCKETS - 1], 1);
+}
+
+TEST(loop_stages_recorded) {
+    ASSERT_EQ(init_node("device1", SDS_ROLE_DEVICE, true, false), SDS_OK);
+
+    run_sync();
+    run_sync();
+
+    SdsLoopStats ls;
+    sds_get_loop_stats(&ls);
+    ASSERT_EQ(ls.loop_us.count, 2);
+    ASSERT_EQ(ls.mqtt_us.count, 2);
+    ASSERT(ls.sync_us.count >= 1);
+    ASSERT_EQ(ls.eviction_us.count, 0);
+}
+
+/* ============== Reset and Error Tests ============== */
+
+TEST(reset_clears_everything) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, false), SDS_OK);
+
+    inject_status("dev_a", 80);
+    run_sync();
+    sds_reset_stats();
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.messages_received, 0);
+    ASSERT_EQ(ts.parse_us.count, 0);
+
+    SdsLoopStats ls;
+    sds_get_loop_stats(&ls);
+    ASSERT_EQ(ls.loop_us.count, 0);
+    ASSERT_EQ(sds_get_stats()->messages_received, 0);
+
+    inject_status("dev_a", 81);
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.messages_received, 1);
+}
+
+TEST(table_stats_checks_arguments) {
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_ERR_NOT_INITIALIZED);
+
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, false), SDS_OK);
+    ASSERT_EQ(sds_get_table_stats(NULL, &ts), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_get_table_stats("SensorData", NULL), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_get_table_stats("Unknown", &ts), SDS_ERR_TABLE_NOT_FOUND);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║            Instrumentation Tests (Mock Platform)             ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Opt-in Tests ───\n");
+    RUN_TEST(disabled_keeps_zero);
+    RUN_TEST(stats_carved_from_table_arena);
+
+    printf("\n─── Counter Tests ───\n");
+    RUN_TEST(device_counts_sent_messages);
+    RUN_TEST(device_counts_delta_syncs);
+    RUN_TEST(owner_counts_received_messages);
+    RUN_TEST(owner_counts_full_slots);
+    RUN_TEST(owner_counts_decode_errors);
+
+    printf("\n─── Histogram Tests ───\n");
+    RUN_TEST(callback_time_lands_in_log_bucket);
+    RUN_TEST(large_samples_use_last_bucket);
+    RUN_TEST(loop_stages_recorded);
+
+    printf("\n─── Reset and Error Tests ───\n");
+    RUN_TEST(reset_clears_everything);
+    RUN_TEST(table_stats_checks_arguments);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -22,6 +22,7 @@
 
 static int tests_passed = 0;
 static int tests_failed = 0;
+static SdsJsonSpan g_spans[SDS_JSON_MAX_INDEX_FIELDS];  /* Index storage for indexed readers */
 
 #define TEST(name) static void test_##name(void)
 #define RUN_TEST(name) do { \
@@ -1059,6 +1060,495 @@ TEST(reader_uint8_max_valid) {
     ASSERT(out == 255);
 }
 
+/* ============================================================================
+ * INDEXED READER TESTS
+ * ============================================================================ */
+
+TEST(indexed_reader_basic) {
+    const char* json = "{\"ts\":100,\"name\":\"hello\",\"temp\":23.5,\"on\":true}";
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    ASSERT(r.index_state == SDS_JSON_INDEX_COMPLETE);
+    ASSERT(r.index_count == 4);
+    
+    uint32_t ts = 0;
+    char name[16];
+    float temp = 0;
+    bool on = false;
+    ASSERT(sds_json_get_uint_field(&r, "ts", &ts));
+    ASSERT(sds_json_get_string_field(&r, "name", name, sizeof(name)));
+    ASSERT(sds_json_get_float_field(&r, "temp", &temp));
+    ASSERT(sds_json_get_bool_field(&r, "on", &on));
+    ASSERT(ts == 100);
+    ASSERT_STR_EQ(name, "hello");
+    ASSERT_FLOAT_EQ(temp, 23.5f, 0.001f);
+    ASSERT(on);
+}
+
+TEST(indexed_reader_out_of_order) {
+    const char* json = "{\"a\":1,\"b\":2,\"c\":3}";
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    
+    int32_t v = 0;
+    ASSERT(sds_json_get_int_field(&r, "c", &v) && v == 3);
+    ASSERT(sds_json_get_int_field(&r, "a", &v) && v == 1);
+    ASSERT(sds_json_get_int_field(&r, "b", &v) && v == 2);
+    ASSERT(sds_json_get_int_field(&r, "b", &v) && v == 2);
+    ASSERT(!sds_json_get_int_field(&r, "d", &v));
+}
+
+TEST(indexed_reader_value_matching_key_name) {
+    /* A string value equal to a later key must not shadow that key */
+    const char* json = "{\"node\":\"temp\",\"temp\":42}";
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    
+    int32_t v = 0;
+    ASSERT(sds_json_get_int_field(&r, "temp", &v));
+    ASSERT(v == 42);
+}
+
+TEST(indexed_reader_whitespace_and_nesting) {
+    const char* json = " { \"obj\" : {\"x\":\"}\",\"y\":[1,2]} , \"s\" : \"a\\\"b\" , \"n\" : -7 } ";
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    ASSERT(r.index_count == 3);
+    
+    char s[8];
+    int32_t n = 0;
+    ASSERT(sds_json_get_string_field(&r, "s", s, sizeof(s)));
+    ASSERT_STR_EQ(s, "a\"b");
+    ASSERT(sds_json_get_int_field(&r, "n", &n));
+    ASSERT(n == -7);
+    /* Nested keys are not top-level fields */
+    ASSERT(!sds_json_get_string_field(&r, "x", s, sizeof(s)));
+}
+
+TEST(indexed_reader_empty_object) {
+    const char* json = "{}";
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    ASSERT(r.index_count == 0);
+    
+    int32_t v;
+    ASSERT(!sds_json_get_int_field(&r, "a", &v));
+}
+
+TEST(indexed_reader_malformed_falls_back) {
+    /* Truncated payload: not indexable but legacy scan still finds fields */
+    const char* json = "{\"a\":1,\"b\":2,\"c\"";
+    SdsJsonReader r;
+    ASSERT(!sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    ASSERT(r.index_state == SDS_JSON_INDEX_NONE);
+    
+    int32_t v = 0;
+    ASSERT(sds_json_get_int_field(&r, "b", &v));
+    ASSERT(v == 2);
+}
+
+TEST(indexed_reader_length_limited) {
+    /* Only the first len bytes belong to the object */
+    const char* json = "{\"a\":1}{\"b\":2}";
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, 7, g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    
+    int32_t v = 0;
+    ASSERT(sds_json_get_int_field(&r, "a", &v) && v == 1);
+    ASSERT(!sds_json_get_int_field(&r, "b", &v));
+}
+
+TEST(indexed_reader_truncated_index) {
+    /* More keys than the index holds: overflow keys found by fallback scan */
+    char json[4096];
+    SdsJsonWriter w;
+    sds_json_writer_init(&w, json, sizeof(json));
+    sds_json_start_object(&w);
+    for (int i = 0; i < SDS_JSON_MAX_INDEX_FIELDS + 8; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "f%d", i);
+        sds_json_add_int(&w, key, i);
+    }
+    sds_json_end_object(&w);
+    ASSERT(!sds_json_has_error(&w));
+    
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, sds_json_get_length(&w), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    ASSERT(r.index_state == SDS_JSON_INDEX_TRUNCATED);
+    ASSERT(r.index_count == SDS_JSON_MAX_INDEX_FIELDS);
+    
+    int32_t v = 0;
+    ASSERT(sds_json_get_int_field(&r, "f0", &v) && v == 0);
+    ASSERT(sds_json_get_int_field(&r, "f70", &v) && v == 70);
+    ASSERT(!sds_json_get_int_field(&r, "missing", &v));
+}
+
+TEST(indexed_reader_duplicate_keys_first_wins) {
+    const char* json = "{\"a\":1,\"b\":2,\"a\":3,\"c\":4,\"b\":5}";
+    SdsJsonReader lin, r;
+    sds_json_reader_init(&lin, json, strlen(json));
+    ASSERT(sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    ASSERT(r.index_count == 3);
+    
+    /* Whatever the lookup hint, a repeated key reads as its first occurrence */
+    int32_t v = 0;
+    ASSERT(sds_json_get_int_field(&r, "b", &v) && v == 2);
+    ASSERT(sds_json_get_int_field(&r, "a", &v) && v == 1);
+    ASSERT(sds_json_get_int_field(&r, "c", &v) && v == 4);
+    ASSERT(sds_json_get_int_field(&r, "b", &v) && v == 2);
+    ASSERT(sds_json_find_field(&r, "a") == sds_json_find_field(&lin, "a"));
+    ASSERT(sds_json_find_field(&r, "b") == sds_json_find_field(&lin, "b"));
+    
+    /* Iteration visits each key once */
+    SdsJsonIter it;
+    SdsJsonMember m;
+    int n = 0;
+    sds_json_iter_init(&it, &r);
+    while (sds_json_iter_next(&it, &m)) n++;
+    ASSERT(n == 3);
+}
+
+TEST(indexed_reader_caller_sized_index) {
+    /* A two-span index covers the first two keys; the rest is scanned */
+    const char* json = "{\"a\":1,\"b\":2,\"c\":3}";
+    SdsJsonSpan spans[2];
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, strlen(json), spans, 2));
+    ASSERT(r.index_state == SDS_JSON_INDEX_TRUNCATED);
+    ASSERT(r.index_count == 2);
+    
+    int32_t v = 0;
+    ASSERT(sds_json_get_int_field(&r, "c", &v) && v == 3);
+    ASSERT(sds_json_get_int_field(&r, "a", &v) && v == 1);
+    
+    /* Without spans the reader just scans */
+    ASSERT(!sds_json_reader_init_indexed(&r, json, strlen(json), NULL, 0));
+    ASSERT(r.index_state == SDS_JSON_INDEX_NONE);
+    ASSERT(sds_json_get_int_field(&r, "b", &v) && v == 2);
+}
+
+TEST(indexed_reader_matches_linear_reader) {
+    const char* json = "{\"ts\":5,\"online\":true,\"sv\":\"1.0\",\"v\":3.25,\"s\":\"x\"}";
+    SdsJsonReader lin, idx;
+    sds_json_reader_init(&lin, json, strlen(json));
+    ASSERT(sds_json_reader_init_indexed(&idx, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    
+    const char* keys[] = { "sv", "ts", "s", "v", "online", "nope" };
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        ASSERT(sds_json_find_field(&lin, keys[i]) == sds_json_find_field(&idx, keys[i]));
+    }
+}
+
+/* ============================================================================
+ * KEY FRAGMENT TESTS
+ * ============================================================================ */
+
+
+/* ============== Member Iterator Tests ============== */
+
+static int collect_members(SdsJsonReader* r, char keys[][16], const char** values, int cap) {
+    SdsJsonIter it;
+    SdsJsonMember m;
+    int n = 0;
+    sds_json_iter_init(&it, r);
+    while (sds_json_iter_next(&it, &m) && n < cap) {
+        size_t len = m.key_len < 15 ? m.key_len : 15;
+        memcpy(keys[n], m.key, len);
+        keys[n][len] = '\0';
+        values[n] = m.value;
+        n++;
+    }
+    return n;
+}
+
+TEST(iter_indexed_in_payload_order) {
+    const char* json = "{\"ts\":100,\"name\":\"hello\",\"temp\":23.5}";
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    
+    char keys[8][16];
+    const char* values[8];
+    ASSERT(collect_members(&r, keys, values, 8) == 3);
+    ASSERT_STR_EQ(keys[0], "ts");
+    ASSERT_STR_EQ(keys[1], "name");
+    ASSERT_STR_EQ(keys[2], "temp");
+    
+    char name[16];
+    float temp = 0;
+    ASSERT(sds_json_parse_string_in(&r, values[1], name, sizeof(name)));
+    ASSERT_STR_EQ(name, "hello");
+    ASSERT(sds_json_parse_float(values[2], &temp));
+    ASSERT_FLOAT_EQ(temp, 23.5f, 0.001f);
+}
+
+TEST(iter_plain_reader_tokenizes) {
+    const char* json = " { \"obj\" : {\"x\":\"}\",\"y\":[1,2]} , \"s\" : \"a,b\" , \"n\" : -7 } ";
+    SdsJsonReader r;
+    sds_json_reader_init(&r, json, strlen(json));
+    
+    char keys[8][16];
+    const char* values[8];
+    ASSERT(collect_members(&r, keys, values, 8) == 3);
+    ASSERT_STR_EQ(keys[0], "obj");
+    ASSERT_STR_EQ(keys[1], "s");
+    ASSERT_STR_EQ(keys[2], "n");
+    
+    int32_t n = 0;
+    ASSERT(sds_json_parse_int(values[2], &n) && n == -7);
+}
+
+TEST(iter_truncated_index_continues) {
+    char json[4096];
+    SdsJsonWriter w;
+    sds_json_writer_init(&w, json, sizeof(json));
+    sds_json_start_object(&w);
+    for (int i = 0; i < SDS_JSON_MAX_INDEX_FIELDS + 8; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "f%d", i);
+        sds_json_add_int(&w, key, i);
+    }
+    sds_json_end_object(&w);
+    
+    SdsJsonReader r;
+    ASSERT(sds_json_reader_init_indexed(&r, json, sds_json_get_length(&w), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    ASSERT(r.index_state == SDS_JSON_INDEX_TRUNCATED);
+    
+    SdsJsonIter it;
+    SdsJsonMember m;
+    int n = 0;
+    sds_json_iter_init(&it, &r);
+    while (sds_json_iter_next(&it, &m)) {
+        int32_t v = -1;
+        ASSERT(sds_json_parse_int(m.value, &v));
+        ASSERT(v == n);
+        n++;
+    }
+    ASSERT(n == SDS_JSON_MAX_INDEX_FIELDS + 8);
+}
+
+TEST(iter_empty_and_malformed) {
+    SdsJsonReader r;
+    SdsJsonIter it;
+    SdsJsonMember m;
+    
+    sds_json_reader_init_indexed(&r, "{}", 2, g_spans, SDS_JSON_MAX_INDEX_FIELDS);
+    sds_json_iter_init(&it, &r);
+    ASSERT(!sds_json_iter_next(&it, &m));
+    
+    sds_json_reader_init(&r, NULL, 0);
+    sds_json_iter_init(&it, &r);
+    ASSERT(!sds_json_iter_next(&it, &m));
+    
+    /* Members before the damage are still walked, then the walk stops */
+    const char* json = "{\"a\":1,\"b\":2 \"c\":3}";
+    ASSERT(!sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS));
+    sds_json_iter_init(&it, &r);
+    ASSERT(sds_json_iter_next(&it, &m));
+    ASSERT(m.key_len == 1 && m.key[0] == 'a');
+    ASSERT(!sds_json_iter_next(&it, &m));
+    ASSERT(!sds_json_iter_next(&it, &m));
+    
+    sds_json_reader_init(&r, "[1,2]", 5);
+    sds_json_iter_init(&it, &r);
+    ASSERT(!sds_json_iter_next(&it, &m));
+}
+
+TEST(key_fragment_basic) {
+    char frag[32];
+    size_t len = sds_json_key_fragment("temp", frag, sizeof(frag));
+    ASSERT(len == 7);
+    ASSERT_STR_EQ(frag, "\"temp\":");
+}
+
+TEST(key_fragment_escapes_key) {
+    char frag[32];
+    size_t len = sds_json_key_fragment("a\"b", frag, sizeof(frag));
+    ASSERT(len == 7);
+    ASSERT_STR_EQ(frag, "\"a\\\"b\":");
+}
+
+TEST(key_fragment_too_small) {
+    char frag[7];  /* "temp": needs 7 + NUL */
+    ASSERT(sds_json_key_fragment("temp", frag, sizeof(frag)) == 0);
+    ASSERT(frag[0] == '\0');
+}
+
+TEST(add_key_matches_add_field) {
+    char frag_a[16], frag_b[16];
+    size_t len_a = sds_json_key_fragment("a", frag_a, sizeof(frag_a));
+    size_t len_b = sds_json_key_fragment("b", frag_b, sizeof(frag_b));
+    
+    char buf1[128], buf2[128];
+    SdsJsonWriter w1, w2;
+    
+    sds_json_writer_init(&w1, buf1, sizeof(buf1));
+    sds_json_start_object(&w1);
+    sds_json_add_int(&w1, "a", -5);
+    sds_json_add_string(&w1, "b", "x\"y");
+    sds_json_end_object(&w1);
+    
+    sds_json_writer_init(&w2, buf2, sizeof(buf2));
+    sds_json_start_object(&w2);
+    sds_json_add_key(&w2, frag_a, len_a);
+    sds_json_write_int(&w2, -5);
+    sds_json_add_key(&w2, frag_b, len_b);
+    sds_json_write_string(&w2, "x\"y");
+    sds_json_end_object(&w2);
+    
+    ASSERT(!sds_json_has_error(&w2));
+    ASSERT_STR_EQ(buf1, buf2);
+}
+
+TEST(add_key_overflow_sets_error) {
+    char buf[8];
+    SdsJsonWriter w;
+    sds_json_writer_init(&w, buf, sizeof(buf));
+    sds_json_start_object(&w);
+    sds_json_add_key(&w, "\"longkey\":", 10);
+    ASSERT(sds_json_has_error(&w));
+}
+
+TEST(find_field_n_uses_length) {
+    const char* json = "{\"temp\":1,\"temperature\":2}";
+    SdsJsonReader r;
+    sds_json_reader_init(&r, json, strlen(json));
+    
+    /* Key buffer is not NUL-terminated at the lookup length */
+    uint32_t val = 0;
+    ASSERT(sds_json_parse_uint(sds_json_find_field_n(&r, "temperature", 4), &val));
+    ASSERT(val == 1);
+    ASSERT(sds_json_parse_uint(sds_json_find_field_n(&r, "temperature", 11), &val));
+    ASSERT(val == 2);
+    
+    sds_json_reader_init_indexed(&r, json, strlen(json), g_spans, SDS_JSON_MAX_INDEX_FIELDS);
+    ASSERT(sds_json_parse_uint(sds_json_find_field_n(&r, "temperature", 4), &val));
+    ASSERT(val == 1);
+}
+
+/* ============================================================================
+ * NUMBER FORMATTING TESTS
+ * ============================================================================ */
+
+static char g_num[64];
+
+static const char* write_float(float value) {
+    SdsJsonWriter w;
+    sds_json_writer_init(&w, g_num, sizeof(g_num));
+    sds_json_write_float(&w, value);
+    return g_num;
+}
+
+static const char* write_fixed(float value, uint8_t decimals) {
+    SdsJsonWriter w;
+    sds_json_writer_init(&w, g_num, sizeof(g_num));
+    sds_json_write_float_fixed(&w, value, decimals);
+    return g_num;
+}
+
+TEST(float_shortest_form) {
+    ASSERT_STR_EQ(write_float(23.5f), "23.5");
+    ASSERT_STR_EQ(write_float(0.1f), "0.1");
+    ASSERT_STR_EQ(write_float(25.0f), "25");
+    ASSERT_STR_EQ(write_float(-40.25f), "-40.25");
+    ASSERT_STR_EQ(write_float(0.0f), "0");
+    ASSERT_STR_EQ(write_float(-0.0f), "0");
+    ASSERT_STR_EQ(write_float(100.0f), "100");
+    ASSERT_STR_EQ(write_float(0.0001f), "0.0001");
+    ASSERT_STR_EQ(write_float(123456789.0f), "123456790");
+}
+
+TEST(float_shortest_exponent_form) {
+    ASSERT_STR_EQ(write_float(1.5e-7f), "1.5e-7");
+    ASSERT_STR_EQ(write_float(1e10f), "1e10");
+    ASSERT_STR_EQ(write_float(-2.5e20f), "-2.5e20");
+    ASSERT_STR_EQ(write_float(FLT_MAX), "3.4028235e38");
+    ASSERT_STR_EQ(write_float(FLT_MIN), "1.1754944e-38");
+    ASSERT_STR_EQ(write_float(1e-45f), "1e-45");   /* Smallest denormal */
+}
+
+TEST(float_non_finite_is_null) {
+    ASSERT_STR_EQ(write_float(NAN), "null");
+    ASSERT_STR_EQ(write_float(INFINITY), "null");
+    ASSERT_STR_EQ(write_fixed(-INFINITY, 2), "null");
+}
+
+TEST(float_shortest_round_trips) {
+    /* Same float back through our parser and through strtof */
+    unsigned mismatches = 0;
+    for (uint32_t bits = 1; bits < 0x7F800000u; bits += 7919) {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        const char* text = write_float(value);
+        float ours = 0.0f;
+        if (!sds_json_parse_float(text, &ours) || ours != value) mismatches++;
+        if (strtof(text, NULL) != value) mismatches++;
+    }
+    ASSERT(mismatches == 0);
+}
+
+TEST(float_fixed_precision) {
+    ASSERT_STR_EQ(write_fixed(23.456f, 1), "23.5");
+    ASSERT_STR_EQ(write_fixed(23.456f, 2), "23.46");
+    ASSERT_STR_EQ(write_fixed(20.0f, 2), "20");
+    ASSERT_STR_EQ(write_fixed(0.05f, 1), "0.1");
+    ASSERT_STR_EQ(write_fixed(0.004f, 3), "0.004");
+    ASSERT_STR_EQ(write_fixed(-1.25f, 1), "-1.3");
+    ASSERT_STR_EQ(write_fixed(-0.04f, 1), "0");       /* No "-0" */
+    ASSERT_STR_EQ(write_fixed(1e20f, 2), "1e20");     /* Too large: shortest form */
+    ASSERT_STR_EQ(write_fixed(3.14159265f, 12), "3.141592741");  /* Clamped to 9 */
+}
+
+TEST(int_formatting_extremes) {
+    SdsJsonWriter w;
+    char buf[64];
+    sds_json_writer_init(&w, buf, sizeof(buf));
+    sds_json_start_object(&w);
+    sds_json_add_int(&w, "a", INT32_MIN);
+    sds_json_add_int(&w, "b", INT32_MAX);
+    sds_json_add_uint(&w, "c", UINT32_MAX);
+    sds_json_add_int(&w, "d", -7);
+    sds_json_end_object(&w);
+    ASSERT_STR_EQ(buf, "{\"a\":-2147483648,\"b\":2147483647,\"c\":4294967295,\"d\":-7}");
+}
+
+TEST(parse_float_forms) {
+    float out = 0.0f;
+    ASSERT(sds_json_parse_float(".5", &out) && out == 0.5f);
+    ASSERT(sds_json_parse_float("5.", &out) && out == 5.0f);
+    ASSERT(sds_json_parse_float("  -0.001,", &out) && out == -0.001f);
+    ASSERT(sds_json_parse_float("1E3}", &out) && out == 1000.0f);
+    ASSERT(sds_json_parse_float("2.5e+2", &out) && out == 250.0f);
+    ASSERT(sds_json_parse_float("7e", &out) && out == 7.0f);
+    ASSERT(sds_json_parse_float("1e-50", &out) && out == 0.0f);
+    ASSERT(sds_json_parse_float("0.1000000000000000000000001", &out) && out == 0.1f);
+    ASSERT(sds_json_parse_float("123456789012345678901234567890", &out) &&
+           out == 123456789012345678901234567890.0f);
+}
+
+TEST(parse_float_rejects) {
+    float out = 42.0f;
+    ASSERT(!sds_json_parse_float("", &out));
+    ASSERT(!sds_json_parse_float("-", &out));
+    ASSERT(!sds_json_parse_float(".", &out));
+    ASSERT(!sds_json_parse_float("null", &out));
+    ASSERT(!sds_json_parse_float("1e39", &out));
+    ASSERT(!sds_json_parse_float("-4e38", &out));
+    ASSERT(out == 42.0f);
+}
+
+TEST(parse_int_forms) {
+    int32_t i = 0;
+    uint32_t u = 0;
+    ASSERT(sds_json_parse_int("+7", &i) && i == 7);
+    ASSERT(sds_json_parse_int(" -12,", &i) && i == -12);
+    ASSERT(!sds_json_parse_int("2147483648", &i));
+    ASSERT(!sds_json_parse_int("- 1", &i));
+    ASSERT(sds_json_parse_uint("4294967295", &u) && u == UINT32_MAX);
+    ASSERT(!sds_json_parse_uint("4294967296", &u));
+    ASSERT(!sds_json_parse_uint("+", &u));
+    ASSERT(i == -12 && u == UINT32_MAX);
+}
+
 /* ============================================================================
  * MAIN
  * ============================================================================ */
@@ -1162,6 +1652,44 @@ int main(void) {
     RUN_TEST(reader_uint8_overflow);
     RUN_TEST(reader_uint8_max_valid);
     
+    printf("\n─── Indexed Reader Tests ───\n");
+    RUN_TEST(indexed_reader_basic);
+    RUN_TEST(indexed_reader_out_of_order);
+    RUN_TEST(indexed_reader_value_matching_key_name);
+    RUN_TEST(indexed_reader_whitespace_and_nesting);
+    RUN_TEST(indexed_reader_empty_object);
+    RUN_TEST(indexed_reader_malformed_falls_back);
+    RUN_TEST(indexed_reader_length_limited);
+    RUN_TEST(indexed_reader_truncated_index);
+    RUN_TEST(indexed_reader_duplicate_keys_first_wins);
+    RUN_TEST(indexed_reader_caller_sized_index);
+    RUN_TEST(indexed_reader_matches_linear_reader);
+    
+    printf("\n─── Member Iterator Tests ───\n");
+    RUN_TEST(iter_indexed_in_payload_order);
+    RUN_TEST(iter_plain_reader_tokenizes);
+    RUN_TEST(iter_truncated_index_continues);
+    RUN_TEST(iter_empty_and_malformed);
+    
+    printf("\n─── Key Fragment Tests ───\n");
+    RUN_TEST(key_fragment_basic);
+    RUN_TEST(key_fragment_escapes_key);
+    RUN_TEST(key_fragment_too_small);
+    RUN_TEST(add_key_matches_add_field);
+    RUN_TEST(add_key_overflow_sets_error);
+    RUN_TEST(find_field_n_uses_length);
+    
+    printf("\n─── Number Formatting Tests ───\n");
+    RUN_TEST(float_shortest_form);
+    RUN_TEST(float_shortest_exponent_form);
+    RUN_TEST(float_non_finite_is_null);
+    RUN_TEST(float_shortest_round_trips);
+    RUN_TEST(float_fixed_precision);
+    RUN_TEST(int_formatting_extremes);
+    RUN_TEST(parse_float_forms);
+    RUN_TEST(parse_float_rejects);
+    RUN_TEST(parse_int_forms);
+    
     printf("\n");
     printf("══════════════════════════════════════════════════════════\n");
     printf("  Results: %d passed, %d failed\n", tests_passed, tests_failed);
@@ -0,0 +1,424 @@
+/*
+ * test_latency.c - Propagation Latency Tests
+ *
+ * Tests clock offset estimation and publish-to-apply latency with the mock
+ * platform:
+ * - Devices echo the last config "ts" in full status (JSON and binary)
+ * - Owners bound the offset one-way until a clock exchange arrives
+ * - NTP-style offset/rtt from an exchange, rtt filtering and replacement
+ * - Records reset on slot allocation and LWT
+ * - propagation_ms histogram and sds_latency_percentile()
+ *
+ * Build:
+ *   gcc -I../include -o test_latency test_latency.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_latency
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+static SensorDataOwnerTable g_owner;
+static SensorDataTable g_device;
+static SdsNodeLatency g_latency[SDS_GENERATED_MAX_NODES];
+
+static SdsError init_node(const char* node_id, SdsRole role, bool tracking, SdsWireFormat format) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_latency_tracking = tracking,
+    };
+
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_owner, 0, sizeof(g_owner));
+    memset(&g_device, 0, sizeof(g_device));
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000, .wire_format = format };
+    if (role == SDS_ROLE_OWNER) {
+        err = sds_register_table(&g_owner, "SensorData", SDS_ROLE_OWNER, &opts);
+        if (err != SDS_OK) return err;
+        return sds_set_owner_latency_slots("SensorData", g_latency, SDS_GENERATED_MAX_NODES);
+    }
+    return sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, &opts);
+}
+
+/* Status from a device, applied at owner time now_ms */
+static void inject_status_at(const char* node, uint32_t now_ms, uint32_t ts, const char* echo) {
+    char topic[64];
+    char payload[192];
+    sds_mock_set_time(now_ms);
+    snprintf(topic, sizeof(topic), "sds/SensorData/status/%s", node);
+    snprintf(payload, sizeof(payload),
+             "{\"ts\":%u,%s\"online\":true,\"error_code\":0,\"battery_percent\":50,\"uptime_seconds\":5}",
+             (unsigned)ts, echo ? echo : "");
+    sds_mock_inject_message_str(topic, payload);
+}
+
+static const SdsMockPublishedMessage* find_status_publish(void) {
+    return sds_mock_find_publish_by_topic("sds/SensorData/status/dev_a");
+}
+
+static bool payload_contains(const SdsMockPublishedMessage* msg, const char* needle) {
+    char text[SDS_MOCK_MAX_PAYLOAD_LEN + 1];
+    size_t len = msg->payload_len < SDS_MOCK_MAX_PAYLOAD_LEN ? msg->payload_len : SDS_MOCK_MAX_PAYLOAD_LEN;
+    memcpy(text, msg->payload, len);
+    text[len] = '\0';
+    return strstr(text, needle) != NULL;
+}
+
+/* ============== Percentile Tests ============== */
+
+TEST(percentile_from_buckets) {
+    SdsLatencyHistogram h;
+    memset(&h, 0, sizeof(h));
+    ASSERT_EQ(sds_latency_percentile(&h, 50), 0u);
+    ASSERT_EQ(sds_latency_percentile(NULL, 50), 0u);
+
+    /* 90 samples in [8, 16), 10 samples in [128, 256), largest 150 */
+    h.count = 100;
+    h.buckets[3] = 90;
+    h.buckets[7] = 10;
+    h.max_us = 150;
+
+    ASSERT_EQ(sds_latency_percentile(&h, 50), 15u);
+    ASSERT_EQ(sds_latency_percentile(&h, 90), 15u);
+    ASSERT_EQ(sds_latency_percentile(&h, 91), 150u);   /* Capped at the largest sample */
+    ASSERT_EQ(sds_latency_percentile(&h, 100), 150u);
+    ASSERT_EQ(sds_latency_percentile(&h, 0), 15u);
+}
+
+/* ============== Device Echo Tests ============== */
+
+TEST(device_echoes_config_ts) {
+    ASSERT_EQ(init_node("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+
+    sds_mock_set_time(7000);
+    sds_mock_inject_message_str("sds/SensorData/config",
+                                "{\"ts\":1234,\"from\":\"owner1\",\"command\":1,\"threshold\":2.0}");
+
+    sds_mock_clear_publishes();
+    g_device.status.battery_percent = 80;
+    sds_mock_advance_time(1000);
+    sds_loop();
+
+    const SdsMockPublishedMessage* msg = find_status_publish();
+    ASSERT(msg != NULL);
+    ASSERT(payload_contains(msg, "\"cts\":1234"));
+    ASSERT(payload_contains(msg, "\"crx\":7000"));
+}
+
+TEST(device_without_config_sends_no_echo) {
+    ASSERT_EQ(init_node("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_JSON), SDS_OK);
+
+    sds_mock_clear_publishes();
+    g_device.status.battery_percent = 80;
+    sds_mock_advance_time(1000);
+    sds_loop();
+
+    const SdsMockPublishedMessage* msg = find_status_publish();
+    ASSERT(msg != NULL);
+    ASSERT(!payload_contains(msg, "\"cts\""));
+}
+
+TEST(disabled_sends_no_echo) {
+    ASSERT_EQ(init_node("dev_a", SDS_ROLE_DEVICE, false, SDS_WIRE_JSON), SDS_OK);
+
+    sds_mock_inject_message_str("sds/SensorData/config",
+                                "{\"ts\":1234,\"from\":\"owner1\",\"command\":1,\"threshold\":2.0}");
+
+    sds_mock_clear_publishes();
+    g_device.status.battery_percent = 80;
+    sds_mock_advance_time(1000);
+    sds_loop();
+
+    const SdsMockPublishedMessage* msg = find_status_publish();
+    ASSERT(msg != NULL);
+    ASSERT(!payload_contains(msg, "\"cts\""));
+}
+
+/* ============== Owner Estimate Tests ============== */
+
+TEST(one_way_bound_before_exchange) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, SDS_WIRE_JSON), SDS_OK);
+
+    /* Device clock 4000 ms behind; first delivery sets the bound */
+    inject_status_at("dev_a", 5000, 1000, NULL);
+    inject_status_at("dev_a", 6030, 2000, NULL);
+
+    SdsNodeLatency n;
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT(!n.synced);
+    ASSERT_EQ(n.clock_offset_ms, -4000);
+    ASSERT_EQ(n.last_latency_ms, 30u);
+    ASSERT_EQ(n.samples, 2u);
+
+    /* A faster delivery moves the bound */
+    inject_status_at("dev_a", 6990, 3000, NULL);
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT_EQ(n.clock_offset_ms, -3990);
+    ASSERT_EQ(n.last_latency_ms, 0u);
+}
+
+TEST(clock_exchange_sets_offset) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, SDS_WIRE_JSON), SDS_OK);
+
+    /*
+     * Device clock runs 10000 ms ahead, 20 ms each way:
+     * config published at owner 1000, applied at device 11020;
+     * status published at device 15000, applied at owner 5020.
+     */
+    inject_status_at("dev_a", 5020, 15000, "\"cts\":1000,\"crx\":11020,");
+
+    SdsNodeLatency n;
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT(n.synced);
+    ASSERT_EQ(n.clock_offset_ms, 10000);
+    ASSERT_EQ(n.rtt_ms, 40u);
+    ASSERT_EQ(n.ref_ts, 1000u);
+    ASSERT_EQ(n.last_latency_ms, 20u);
+
+    /* Later deltas without an echo use the synced offset */
+    inject_status_at("dev_a", 6100, 16000, NULL);
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT(n.synced);
+    ASSERT_EQ(n.last_latency_ms, 100u);
+}
+
+TEST(exchange_rtt_filter) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, SDS_WIRE_JSON), SDS_OK);
+
+    /* Retained config applied long after it was published: rtt too large */
+    inject_status_at("dev_a", 90000, 100000, "\"cts\":1000,\"crx\":50000,");
+
+    SdsNodeLatency n;
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT(!n.synced);
+
+    /* Same reference, lower rtt replaces; higher rtt is ignored */
+    inject_status_at("dev_a", 5020, 15000, "\"cts\":1000,\"crx\":11020,");
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT(n.synced);
+    ASSERT_EQ(n.rtt_ms, 40u);
+
+    inject_status_at("dev_a", 6100, 16000, "\"cts\":1000,\"crx\":11020,");
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT_EQ(n.rtt_ms, 40u);
+    ASSERT_EQ(n.clock_offset_ms, 10000);
+
+    /* A newer config replaces the reference even with a larger rtt */
+    inject_status_at("dev_a", 8100, 18000, "\"cts\":7000,\"crx\":17040,");
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT_EQ(n.ref_ts, 7000u);
+    ASSERT_EQ(n.rtt_ms, 140u);
+    ASSERT_EQ(n.clock_offset_ms, 9970);
+}
+
+TEST(lwt_resets_record) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, SDS_WIRE_JSON), SDS_OK);
+
+    inject_status_at("dev_a", 5020, 15000, "\"cts\":1000,\"crx\":11020,");
+    sds_mock_inject_message_str("sds/lwt/dev_a", "{\"online\":false,\"node\":\"dev_a\",\"ts\":0}");
+
+    SdsNodeLatency n;
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT(!n.synced);
+    ASSERT_EQ(n.samples, 0u);
+
+    /* Rebooted device: clock restarted, new bound */
+    inject_status_at("dev_a", 9000, 200, NULL);
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT_EQ(n.clock_offset_ms, -8800);
+    ASSERT_EQ(n.samples, 1u);
+}
+
+TEST(propagation_histogram) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, SDS_WIRE_JSON), SDS_OK);
+
+    inject_status_at("dev_a", 5020, 15000, "\"cts\":1000,\"crx\":11020,");  /* 20 ms */
+    inject_status_at("dev_a", 6100, 16000, NULL);                          /* 100 ms */
+    inject_status_at("dev_b", 3000, 3000, NULL);                           /* Bound: 0 ms */
+
+    /* Recorded without enable_instrumentation */
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.propagation_ms.count, 3u);
+    ASSERT_EQ(ts.propagation_ms.max_us, 100u);
+    ASSERT_EQ(ts.propagation_ms.total_us, 120u);
+    ASSERT_EQ(ts.propagation_ms.buckets[0], 1u);
+    ASSERT_EQ(ts.propagation_ms.buckets[4], 1u);
+    ASSERT_EQ(ts.propagation_ms.buckets[6], 1u);
+    ASSERT_EQ(sds_latency_percentile(&ts.propagation_ms, 50), 31u);
+    ASSERT_EQ(sds_latency_percentile(&ts.propagation_ms, 99), 100u);
+    ASSERT_EQ(ts.serialize_us.count, 0u);
+
+    sds_reset_stats();
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.propagation_ms.count, 0u);
+}
+
+TEST(disabled_owner_records_nothing) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, false, SDS_WIRE_JSON), SDS_OK);
+
+    inject_status_at("dev_a", 5020, 15000, "\"cts\":1000,\"crx\":11020,");
+
+    SdsNodeLatency n;
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT_EQ(n.samples, 0u);
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.propagation_ms.count, 0u);
+}
+
+/* ============== Binary Wire Tests ============== */
+
+TEST(binary_status_carries_echo) {
+    SdsMockPublishedMessage status;
+
+    ASSERT_EQ(init_node("dev_a", SDS_ROLE_DEVICE, true, SDS_WIRE_BINARY), SDS_OK);
+    sds_mock_set_time(11020);
+    sds_mock_inject_message_str("sds/SensorData/config",
+                                "{\"ts\":1000,\"from\":\"owner1\",\"command\":1,\"threshold\":2.0}");
+    sds_mock_clear_publishes();
+    g_device.status.battery_percent = 80;
+    sds_mock_set_time(15000);
+    sds_loop();
+    const SdsMockPublishedMessage* msg = find_status_publish();
+    ASSERT(msg != NULL);
+    status = *msg;
+    sds_shutdown();
+
+    sds_mock_reset();
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, SDS_WIRE_JSON), SDS_OK);
+    sds_mock_set_time(5020);
+    sds_mock_inject_message(status.topic, status.payload, status.payload_len);
+
+    SdsNodeLatency n;
+    ASSERT(sds_get_node_latency("SensorData", "dev_a", &n));
+    ASSERT(n.synced);
+    ASSERT_EQ(n.clock_offset_ms, 10000);
+    ASSERT_EQ(n.last_latency_ms, 20u);
+
+    const SensorDataStatus* st = sds_find_node_status(&g_owner, "SensorData", "dev_a");
+    ASSERT(st != NULL);
+    ASSERT_EQ(st->battery_percent, 80);
+}
+
+/* ============== API Tests ============== */
+
+TEST(api_arguments) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, SDS_WIRE_JSON), SDS_OK);
+
+    SdsNodeLatency n;
+    ASSERT(!sds_get_node_latency("SensorData", "unknown", &n));
+    ASSERT(!sds_get_node_latency("Unknown", "dev_a", &n));
+    ASSERT(!sds_get_node_latency("SensorData", "dev_a", NULL));
+    ASSERT_EQ(sds_set_owner_latency_slots("Unknown", g_latency, 1), SDS_ERR_TABLE_NOT_FOUND);
+
+    /* Without records the histogram still fills from clock exchanges */
+    ASSERT_EQ(sds_set_owner_latency_slots("SensorData", NULL, 0), SDS_OK);
+    inject_status_at("dev_a", 5020, 15000, "\"cts\":1000,\"crx\":11020,");
+    inject_status_at("dev_a", 6100, 16000, NULL);
+    ASSERT(!sds_get_node_latency("SensorData", "dev_a", &n));
+
+    SdsTableStats ts;
+    ASSERT_EQ(sds_get_table_stats("SensorData", &ts), SDS_OK);
+    ASSERT_EQ(ts.propagation_ms.count, 1u);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║          Propagation Latency Tests (Mock Platform)           ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Percentile Tests ───\n");
+    RUN_TEST(percentile_from_buckets);
+
+    printf("\n─── Device Echo Tests ───\n");
+    RUN_TEST(device_echoes_config_ts);
+    RUN_TEST(device_without_config_sends_no_echo);
+    RUN_TEST(disabled_sends_no_echo);
+
+    printf("\n─── Owner Estimate Tests ───\n");
+    RUN_TEST(one_way_bound_before_exchange);
+    RUN_TEST(clock_exchange_sets_offset);
+    RUN_TEST(exchange_rtt_filter);
+    RUN_TEST(lwt_resets_record);
+    RUN_TEST(propagation_histogram);
+    RUN_TEST(disabled_owner_records_nothing);
+
+    printf("\n─── Binary Wire Format Tests ───\n");
+    RUN_TEST(binary_status_carries_echo);
+
+    printf("\n─── API Tests ───\n");
+    RUN_TEST(api_arguments);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -0,0 +1,512 @@
+/*
+ * test_outbound_queue.c - Outbound Queue Tests
+ *
+ * Tests the bounded outbound message queue with the mock platform:
+ * - Messages are queued instead of published inline
+ * - Async sender (simulated) vs. draining from sds_loop()
+ * - Coalesce / drop-oldest / drop-newest policies
+ * - Delta messages are never coalesced
+ * - Queue survives a disconnect and is flushed on shutdown
+ * - Queue depth and drop statistics
+ *
+ * Build:
+ *   gcc -I../include -o test_outbound_queue test_outbound_queue.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_outbound_queue
+ */
+
+#include "sds.h"
+#include "sds_json.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_STR_CONTAINS(haystack, needle) ASSERT(strstr((haystack), (needle)) != NULL)
+
+/* ============== Table Definitions ============== */
+
+typedef struct {
+    uint8_t mode;
+} QueueConfig;
+
+typedef struct {
+    float temperature;
+    uint32_t reading_count;
+} QueueState;
+
+typedef struct {
+    uint8_t error_code;
+} QueueStatus;
+
+typedef struct {
+    QueueConfig config;
+    QueueState state;
+    QueueStatus status;
+} QueueDeviceTable;
+
+static const SdsFieldMeta queue_state_fields[] = {
+    { .name = "temperature", .type = SDS_FIELD_FLOAT, .offset = offsetof(QueueState, temperature), .size = sizeof(float) },
+    { .name = "reading_count", .type = SDS_FIELD_UINT32, .offset = offsetof(QueueState, reading_count), .size = sizeof(uint32_t) },
+};
+
+static void serialize_state(void* section, SdsJsonWriter* w) {
+    QueueState* st = (QueueState*)section;
+    sds_json_add_float(w, "temperature", st->temperature);
+    sds_json_add_uint(w, "reading_count", st->reading_count);
+}
+
+/* ============== Helper Functions ============== */
+
+#define STATE_TOPIC "sds/QueueTable/state"
+
+static SdsError init_node(uint8_t depth, SdsOutboundPolicy policy, bool async, bool delta) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+        .outbound_async = async,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = "dev1",
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_delta_sync = delta,
+        .outbound_queue_depth = depth,
+        .outbound_policy = policy,
+    };
+
+    return sds_init(&config);
+}
+
+/* State-only device table; sync every 100 ms */
+static SdsError register_device(QueueDeviceTable* table, bool with_fields) {
+    SdsTableOptions opts = { .sync_interval_ms = 100 };
+    SdsError err = sds_register_table_ex(
+        table, "QueueTable", SDS_ROLE_DEVICE, &opts,
+        offsetof(QueueDeviceTable, config), sizeof(QueueConfig),
+        offsetof(QueueDeviceTable, state), sizeof(QueueState),
+        0, 0,
+        NULL, NULL,
+        serialize_state, NULL,
+        NULL, NULL
+    );
+    if (err == SDS_OK && with_fields) {
+        err = sds_set_table_fields("QueueTable",
+            NULL, 0, queue_state_fields, 2, NULL, 0);
+    }
+    return err;
+}
+
+/* Change the state and run one sync */
+static void sync_reading(QueueDeviceTable* table, uint32_t reading_count) {
+    table->state.reading_count = reading_count;
+    sds_mock_advance_time(150);
+    sds_loop();
+}
+
+static size_t count_publishes(const char* topic) {
+    size_t count = 0;
+    for (size_t i = 0; i < sds_mock_get_publish_count(); i++) {
+        const SdsMockPublishedMessage* msg = sds_mock_get_publish(i);
+        if (msg && strcmp(msg->topic, topic) == 0) count++;
+    }
+    return count;
+}
+
+static const char* payload_str(const SdsMockPublishedMessage* msg) {
+    static char buf[SDS_MOCK_MAX_PAYLOAD_LEN + 1];
+    memcpy(buf, msg->payload, msg->payload_len);
+    buf[msg->payload_len] = '\0';
+    return buf;
+}
+
+/* ============== Queue Mode Tests ============== */
+
+TEST(depth_zero_publishes_inline) {
+    ASSERT_EQ(init_node(0, SDS_OUTBOUND_COALESCE, true, false), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, false);
+    sync_reading(&table, 1);
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+    ASSERT_EQ(sds_mock_get_outbound_notify_count(), 0);
+    ASSERT_EQ(sds_get_stats()->outbound_high_water, 0);
+}
+
+TEST(loop_drains_queue_without_async_sender) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, false, false), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, false);
+    sync_reading(&table, 1);
+
+    /* Queued during the sync, sent at the end of the same loop */
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 0);
+    ASSERT_EQ(sds_get_stats()->outbound_high_water, 1);
+    ASSERT_EQ(sds_get_stats()->messages_sent, 1);
+}
+
+TEST(async_sender_publishes_outside_loop) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, true, false), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, false);
+    sync_reading(&table, 1);
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 0);
+    ASSERT(sds_mock_get_outbound_notify_count() >= 1);
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 1);
+
+    sds_mock_run_outbound_sender();
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 0);
+    ASSERT_EQ(sds_get_stats()->messages_sent, 1);
+}
+
+TEST(depth_clamped_to_queue_max) {
+    ASSERT_EQ(init_node(SDS_OUTBOUND_QUEUE_MAX + 10, SDS_OUTBOUND_DROP_OLDEST, true, true), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, true);
+
+    /* Every sync changes the state and queues a delta */
+    for (uint32_t i = 1; i <= SDS_OUTBOUND_QUEUE_MAX + 2; i++) {
+        table.state.temperature = (float)i;
+        sync_reading(&table, i);
+    }
+
+    ASSERT_EQ(sds_get_stats()->outbound_queued, SDS_OUTBOUND_QUEUE_MAX);
+    ASSERT_EQ(sds_get_stats()->outbound_dropped, 2);
+}
+
+TEST(queue_carved_from_table_arena) {
+    static uint64_t arena[16384 / 8];
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = "dev1",
+        .mqtt_broker = "mock_broker",
+        .outbound_queue_depth = 2,
+        .table_arena = arena,
+        .max_tables = 1,
+    };
+
+    /* Room for the table only: the ring does not fit */
+    config.table_arena_size = sds_table_arena_size(1, sizeof(QueueConfig) + sizeof(QueueState));
+    ASSERT_EQ(sds_init(&config), SDS_ERR_INVALID_CONFIG);
+
+    config.table_arena_size = sds_config_arena_size(&config, sizeof(QueueConfig) + sizeof(QueueState));
+    ASSERT(config.table_arena_size <= sizeof(arena));
+    ASSERT(config.table_arena_size > sds_table_arena_size(1, sizeof(QueueConfig) + sizeof(QueueState)));
+    ASSERT_EQ(sds_init(&config), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    ASSERT_EQ(register_device(&table, false), SDS_OK);
+    sync_reading(&table, 7);
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 0);  /* Drained by sds_loop() */
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+}
+
+/* ============== Policy Tests ============== */
+
+TEST(coalesce_keeps_latest_full_section) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, true, false), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, false);
+    sync_reading(&table, 1);
+    sync_reading(&table, 2);
+    sync_reading(&table, 3);
+
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 1);
+    ASSERT_EQ(sds_get_stats()->outbound_coalesced, 2);
+    ASSERT_EQ(sds_get_stats()->outbound_dropped, 0);
+
+    sds_mock_run_outbound_sender();
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_last_publish()), "\"reading_count\":3");
+}
+
+TEST(coalesce_merges_delta_fields) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, true, true), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, true);
+    table.state.temperature = 21.0f;
+    sync_reading(&table, 0);
+    sync_reading(&table, 5);
+
+    /* Two deltas with different fields merge into one message */
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 1);
+    ASSERT_EQ(sds_get_stats()->outbound_coalesced, 1);
+
+    sds_mock_run_outbound_sender();
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_publish(0)), "\"temperature\":21");
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_publish(0)), "\"reading_count\":5");
+}
+
+TEST(coalesce_burst_sends_one_delta) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, true, true), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, true);
+    for (uint32_t i = 1; i <= 200; i++) {
+        sync_reading(&table, i);
+    }
+
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 1);
+    ASSERT_EQ(sds_get_stats()->outbound_coalesced, 199);
+
+    sds_mock_run_outbound_sender();
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_publish(0)), "\"reading_count\":200");
+}
+
+TEST(delta_after_drain_starts_fresh) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, true, true), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, true);
+    table.state.temperature = 21.0f;
+    sync_reading(&table, 0);
+    sds_mock_run_outbound_sender();
+
+    /* Nothing queued for the topic, so only the new change is sent */
+    sync_reading(&table, 7);
+    sds_mock_run_outbound_sender();
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 2);
+    const char* payload = payload_str(sds_mock_get_publish(1));
+    ASSERT_STR_CONTAINS(payload, "\"reading_count\":7");
+    ASSERT(strstr(payload, "temperature") == NULL);
+}
+
+TEST(drop_oldest_keeps_newest_messages) {
+    ASSERT_EQ(init_node(2, SDS_OUTBOUND_DROP_OLDEST, true, false), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, false);
+    sync_reading(&table, 1);
+    sync_reading(&table, 2);
+    sync_reading(&table, 3);
+
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 2);
+    ASSERT_EQ(sds_get_stats()->outbound_high_water, 2);
+    ASSERT_EQ(sds_get_stats()->outbound_dropped, 1);
+
+    sds_mock_run_outbound_sender();
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 2);
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_publish(0)), "\"reading_count\":2");
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_publish(1)), "\"reading_count\":3");
+}
+
+TEST(drop_newest_retries_on_next_sync) {
+    ASSERT_EQ(init_node(2, SDS_OUTBOUND_DROP_NEWEST, true, false), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, false);
+    sync_reading(&table, 1);
+    sync_reading(&table, 2);
+    sync_reading(&table, 3);
+
+    ASSERT_EQ(sds_get_stats()->outbound_dropped, 1);
+
+    sds_mock_run_outbound_sender();
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 2);
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_last_publish()), "\"reading_count\":2");
+
+    /* The dropped change was not written to the shadow, so it goes out now */
+    sds_mock_advance_time(150);
+    sds_loop();
+    sds_mock_run_outbound_sender();
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 3);
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_last_publish()), "\"reading_count\":3");
+}
+
+/* ============== Connection Tests ============== */
+
+TEST(queue_held_while_disconnected) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, true, false), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, false);
+    sync_reading(&table, 1);
+
+    sds_mock_simulate_disconnect();
+    sds_mock_run_outbound_sender();
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 0);
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 1);
+
+    /* Reconnect through sds_loop wakes the sender */
+    size_t notifies = sds_mock_get_outbound_notify_count();
+    sds_mock_advance_time(2000);
+    sds_loop();
+    ASSERT(sds_mock_get_outbound_notify_count() > notifies);
+
+    sds_mock_run_outbound_sender();
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 0);
+}
+
+TEST(offline_deltas_merge_until_reconnect) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, true, true), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, true);
+    sync_reading(&table, 1);
+    sds_mock_run_outbound_sender();
+    sds_mock_clear_publishes();
+
+    /* The first change is queued before the link drops; later ones merge */
+    table.state.temperature = 30.0f;
+    sync_reading(&table, 1);
+    sds_mock_simulate_disconnect();
+    sds_mock_run_outbound_sender();
+    sync_reading(&table, 2);
+    sync_reading(&table, 3);
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 1);
+
+    sds_mock_advance_time(2000);
+    sds_loop();
+    sds_mock_run_outbound_sender();
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_publish(0)), "\"temperature\":30");
+    ASSERT_STR_CONTAINS(payload_str(sds_mock_get_publish(0)), "\"reading_count\":3");
+}
+
+TEST(publish_failure_counts_error) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, true, false), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, false);
+    sync_reading(&table, 1);
+
+    SdsMockConfig mock_cfg = *sds_mock_get_config();
+    mock_cfg.mqtt_publish_returns_success = false;
+    sds_mock_configure(&mock_cfg);
+
+    uint32_t errors = sds_get_stats()->errors;
+    sds_mock_run_outbound_sender();
+
+    ASSERT_EQ(sds_get_stats()->errors, errors + 1);
+    ASSERT_EQ(sds_get_stats()->messages_sent, 0);
+    ASSERT_EQ(sds_get_stats()->outbound_queued, 0);
+}
+
+TEST(shutdown_flushes_queue) {
+    ASSERT_EQ(init_node(4, SDS_OUTBOUND_COALESCE, true, false), SDS_OK);
+
+    QueueDeviceTable table = {0};
+    register_device(&table, false);
+    sync_reading(&table, 7);
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 0);
+
+    sds_shutdown();
+
+    ASSERT_EQ(count_publishes(STATE_TOPIC), 1);
+    ASSERT(sds_mock_find_publish_by_topic("sds/lwt/dev1") != NULL);
+
+    /* The flushed state goes out before the offline message */
+    const SdsMockPublishedMessage* last = sds_mock_get_last_publish();
+    ASSERT(strcmp(last->topic, "sds/lwt/dev1") == 0);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║           Outbound Queue Tests (Mock Platform)               ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Queue Mode Tests ───\n");
+    RUN_TEST(depth_zero_publishes_inline);
+    RUN_TEST(loop_drains_queue_without_async_sender);
+    RUN_TEST(async_sender_publishes_outside_loop);
+    RUN_TEST(depth_clamped_to_queue_max);
+    RUN_TEST(queue_carved_from_table_arena);
+
+    printf("\n─── Policy Tests ───\n");
+    RUN_TEST(coalesce_keeps_latest_full_section);
+    RUN_TEST(coalesce_merges_delta_fields);
+    RUN_TEST(coalesce_burst_sends_one_delta);
+    RUN_TEST(delta_after_drain_starts_fresh);
+    RUN_TEST(drop_oldest_keeps_newest_messages);
+    RUN_TEST(drop_newest_retries_on_next_sync);
+
+    printf("\n─── Connection Tests ───\n");
+    RUN_TEST(queue_held_while_disconnected);
+    RUN_TEST(offline_deltas_merge_until_reconnect);
+    RUN_TEST(publish_failure_counts_error);
+    RUN_TEST(shutdown_flushes_queue);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
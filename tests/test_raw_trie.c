@@ -0,0 +1,358 @@
+/*
+ * test_raw_trie.c - Raw Subscription Trie Tests
+ *
+ * Tests topic matching and subscription storage for sds_subscribe_raw()
+ * with the mock platform:
+ * - Literal, "+" and "#" levels, overlapping patterns, '$' topics
+ * - Filter validation
+ * - Unsubscribe and (un)subscribe from inside a callback
+ * - Caller storage: growing past SDS_MAX_RAW_SUBSCRIPTIONS, trie budget
+ *
+ * Build:
+ *   gcc -I../include -o test_raw_trie test_raw_trie.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_raw_trie
+ */
+
+#include "sds.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+/* Per-pattern delivery counts, indexed by the user_data slot */
+#define MAX_PATTERNS 300
+static int g_hits[MAX_PATTERNS];
+static int g_slots[MAX_PATTERNS];
+
+static void on_raw(const char* topic, const uint8_t* payload, size_t len, void* user_data) {
+    (void)topic;
+    (void)payload;
+    (void)len;
+    g_hits[*(int*)user_data]++;
+}
+
+static SdsError init_node(void) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = "bridge",
+        .mqtt_broker = "mock_broker",
+    };
+
+    memset(g_hits, 0, sizeof(g_hits));
+    for (int i = 0; i < MAX_PATTERNS; i++) {
+        g_slots[i] = i;
+    }
+    return sds_init(&config);
+}
+
+static SdsError sub(const char* pattern, int slot) {
+    return sds_subscribe_raw(pattern, on_raw, &g_slots[slot]);
+}
+
+static void inject(const char* topic) {
+    sds_mock_inject_message(topic, (const uint8_t*)"x", 1);
+}
+
+/* ============== Matching Tests ============== */
+
+TEST(literal_and_single_level) {
+    ASSERT_EQ(init_node(), SDS_OK);
+    ASSERT_EQ(sub("log/a", 0), SDS_OK);
+    ASSERT_EQ(sub("log/+", 1), SDS_OK);
+    ASSERT_EQ(sub("+/a", 2), SDS_OK);
+    ASSERT_EQ(sub("log/+/x", 3), SDS_OK);
+
+    inject("log/a");
+    ASSERT_EQ(g_hits[0], 1);
+    ASSERT_EQ(g_hits[1], 1);
+    ASSERT_EQ(g_hits[2], 1);
+    ASSERT_EQ(g_hits[3], 0);
+
+    inject("log/b");
+    inject("log/a/x");
+    inject("log");
+    inject("logs/a");
+    ASSERT_EQ(g_hits[0], 1);
+    ASSERT_EQ(g_hits[1], 2);
+    ASSERT_EQ(g_hits[2], 2);
+    ASSERT_EQ(g_hits[3], 1);
+
+    /* "+" matches an empty level */
+    inject("log/");
+    ASSERT_EQ(g_hits[1], 3);
+}
+
+TEST(multi_level) {
+    ASSERT_EQ(init_node(), SDS_OK);
+    ASSERT_EQ(sub("log/#", 0), SDS_OK);
+    ASSERT_EQ(sub("#", 1), SDS_OK);
+    ASSERT_EQ(sub("log/+/#", 2), SDS_OK);
+
+    inject("log/a/b/c");
+    ASSERT_EQ(g_hits[0], 1);
+    ASSERT_EQ(g_hits[1], 1);
+    ASSERT_EQ(g_hits[2], 1);
+
+    /* "log/#" includes the parent level; "log/+/#" needs one more */
+    inject("log");
+    ASSERT_EQ(g_hits[0], 2);
+    ASSERT_EQ(g_hits[1], 2);
+    ASSERT_EQ(g_hits[2], 1);
+
+    inject("log/a");
+    ASSERT_EQ(g_hits[2], 2);
+
+    inject("metrics/cpu");
+    ASSERT_EQ(g_hits[0], 3);
+    ASSERT_EQ(g_hits[1], 4);
+}
+
+TEST(system_topics_need_literal_first_level) {
+    ASSERT_EQ(init_node(), SDS_OK);
+    ASSERT_EQ(sub("#", 0), SDS_OK);
+    ASSERT_EQ(sub("+/broker", 1), SDS_OK);
+    ASSERT_EQ(sub("$SYS/#", 2), SDS_OK);
+
+    inject("$SYS/broker");
+    ASSERT_EQ(g_hits[0], 0);
+    ASSERT_EQ(g_hits[1], 0);
+    ASSERT_EQ(g_hits[2], 1);
+}
+
+TEST(same_pattern_twice_delivers_twice) {
+    ASSERT_EQ(init_node(), SDS_OK);
+    ASSERT_EQ(sub("a/b", 0), SDS_OK);
+    ASSERT_EQ(sub("a/b", 1), SDS_OK);
+
+    inject("a/b");
+    ASSERT_EQ(g_hits[0], 1);
+    ASSERT_EQ(g_hits[1], 1);
+
+    /* Removes one of them */
+    ASSERT_EQ(sds_unsubscribe_raw("a/b"), SDS_OK);
+    inject("a/b");
+    ASSERT_EQ(g_hits[0] + g_hits[1], 3);
+}
+
+TEST(invalid_filters_rejected) {
+    ASSERT_EQ(init_node(), SDS_OK);
+    ASSERT_EQ(sub("log/a+", 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sub("log/#/a", 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sub("log#", 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sub("", 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sub("+/+/#", 0), SDS_OK);
+}
+
+/* ============== Unsubscribe Tests ============== */
+
+TEST(unsubscribe_keeps_shared_levels) {
+    ASSERT_EQ(init_node(), SDS_OK);
+    ASSERT_EQ(sub("a/b/c", 0), SDS_OK);
+    ASSERT_EQ(sub("a/b/d", 1), SDS_OK);
+    ASSERT_EQ(sub("a/+", 2), SDS_OK);
+
+    /* The a and b nodes point into the first pattern's text */
+    ASSERT_EQ(sds_unsubscribe_raw("a/b/c"), SDS_OK);
+    ASSERT_EQ(sds_unsubscribe_raw("a/b/c"), SDS_ERR_TABLE_NOT_FOUND);
+
+    inject("a/b/c");
+    inject("a/b/d");
+    inject("a/b");
+    ASSERT_EQ(g_hits[0], 0);
+    ASSERT_EQ(g_hits[1], 1);
+    ASSERT_EQ(g_hits[2], 1);
+
+    /* Freed slots are reused */
+    ASSERT_EQ(sub("x/y", 3), SDS_OK);
+    inject("x/y");
+    ASSERT_EQ(g_hits[3], 1);
+}
+
+static void on_raw_unsubscribe(const char* topic, const uint8_t* payload, size_t len, void* user_data) {
+    on_raw(topic, payload, len, user_data);
+    if (g_hits[0] == 1) {
+        sds_unsubscribe_raw("a/+");
+        sds_unsubscribe_raw("a/b");
+        sds_subscribe_raw("a/c", on_raw, &g_slots[3]);
+    }
+}
+
+TEST(callback_may_resubscribe) {
+    ASSERT_EQ(init_node(), SDS_OK);
+    ASSERT_EQ(sds_subscribe_raw("a/#", on_raw_unsubscribe, &g_slots[0]), SDS_OK);
+    ASSERT_EQ(sub("a/+", 1), SDS_OK);
+    ASSERT_EQ(sub("a/b", 2), SDS_OK);
+
+    /* "a/#" runs first (it ends above the others) and removes them */
+    inject("a/b");
+    ASSERT_EQ(g_hits[0], 1);
+    ASSERT_EQ(g_hits[1], 0);
+    ASSERT_EQ(g_hits[2], 0);
+
+    inject("a/c");
+    ASSERT_EQ(g_hits[3], 1);
+    ASSERT_EQ(g_hits[0], 2);
+}
+
+/* ============== Storage Tests ============== */
+
+TEST(builtin_storage_limit) {
+    ASSERT_EQ(init_node(), SDS_OK);
+    char topic[32];
+    for (int i = 0; i < SDS_MAX_RAW_SUBSCRIPTIONS; i++) {
+        snprintf(topic, sizeof(topic), "t/%d", i);
+        ASSERT_EQ(sub(topic, i), SDS_OK);
+    }
+    ASSERT_EQ(sub("t/full", 0), SDS_ERR_MAX_TABLES_REACHED);
+
+    /* One subscription deeper than the node budget */
+    ASSERT_EQ(sds_unsubscribe_raw("t/0"), SDS_OK);
+    ASSERT_EQ(sub("d/1/2/3/4/5/6/7/8/9/10/11/12/13/14/15/16/17/18/19/20/21/22/23/24/25/26/27/28/29/30", 0),
+              SDS_ERR_MAX_TABLES_REACHED);
+    inject("t/1");
+    ASSERT_EQ(g_hits[1], 1);
+}
+
+TEST(caller_storage_grows) {
+    ASSERT_EQ(init_node(), SDS_OK);
+    char topic[48];
+    for (int i = 0; i < SDS_MAX_RAW_SUBSCRIPTIONS; i++) {
+        snprintf(topic, sizeof(topic), "bridge/dev%d/+", i);
+        ASSERT_EQ(sub(topic, i), SDS_OK);
+    }
+
+    size_t size = sds_raw_subscription_storage_size(MAX_PATTERNS);
+    ASSERT(size > sds_raw_subscription_storage_size(0));
+    void* storage = malloc(size);
+    ASSERT(storage != NULL);
+    ASSERT_EQ(sds_set_raw_subscription_storage(storage, MAX_PATTERNS), SDS_OK);
+
+    /* Existing subscriptions moved over */
+    inject("bridge/dev3/temp");
+    ASSERT_EQ(g_hits[3], 1);
+
+    for (int i = SDS_MAX_RAW_SUBSCRIPTIONS; i < MAX_PATTERNS; i++) {
+        snprintf(topic, sizeof(topic), "bridge/dev%d/+", i);
+        ASSERT_EQ(sub(topic, i), SDS_OK);
+    }
+    inject("bridge/dev299/temp");
+    inject("bridge/dev150/temp");
+    ASSERT_EQ(g_hits[299], 1);
+    ASSERT_EQ(g_hits[150], 1);
+    ASSERT_EQ(g_hits[15], 0);
+
+    /* Too many to go back to the built-in storage */
+    ASSERT_EQ(sds_set_raw_subscription_storage(NULL, 0), SDS_ERR_INVALID_CONFIG);
+    for (int i = SDS_MAX_RAW_SUBSCRIPTIONS; i < MAX_PATTERNS; i++) {
+        snprintf(topic, sizeof(topic), "bridge/dev%d/+", i);
+        ASSERT_EQ(sds_unsubscribe_raw(topic), SDS_OK);
+    }
+    ASSERT_EQ(sds_set_raw_subscription_storage(NULL, 0), SDS_OK);
+    free(storage);
+
+    inject("bridge/dev7/temp");
+    ASSERT_EQ(g_hits[7], 1);
+}
+
+TEST(storage_api_arguments) {
+    ASSERT_EQ(sds_set_raw_subscription_storage(NULL, 0), SDS_ERR_NOT_INITIALIZED);
+    ASSERT_EQ(init_node(), SDS_OK);
+
+    static uint64_t small[128];
+    ASSERT(sds_raw_subscription_storage_size(2) <= sizeof(small));
+    ASSERT_EQ(sub("a", 0), SDS_OK);
+    ASSERT_EQ(sub("b", 1), SDS_OK);
+    ASSERT_EQ(sub("c", 2), SDS_OK);
+    ASSERT_EQ(sds_set_raw_subscription_storage(small, 2), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_raw_subscription_storage(small, 0), SDS_ERR_INVALID_CONFIG);
+
+    ASSERT_EQ(sds_unsubscribe_raw("c"), SDS_OK);
+    ASSERT_EQ(sds_set_raw_subscription_storage(small, 2), SDS_OK);
+    ASSERT_EQ(sub("c", 2), SDS_ERR_MAX_TABLES_REACHED);
+    inject("b");
+    ASSERT_EQ(g_hits[1], 1);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║         Raw Subscription Trie Tests (Mock Platform)          ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Matching Tests ───\n");
+    RUN_TEST(literal_and_single_level);
+    RUN_TEST(multi_level);
+    RUN_TEST(system_topics_need_literal_first_level);
+    RUN_TEST(same_pattern_twice_delivers_twice);
+    RUN_TEST(invalid_filters_rejected);
+
+    printf("\n─── Unsubscribe Tests ───\n");
+    RUN_TEST(unsubscribe_keeps_shared_levels);
+    RUN_TEST(callback_may_resubscribe);
+
+    printf("\n─── Storage Tests ───\n");
+    RUN_TEST(builtin_storage_limit);
+    RUN_TEST(caller_storage_grows);
+    RUN_TEST(storage_api_arguments);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -7,6 +7,7 @@
  *   - Reconnect with pending data
  *   - Multiple rapid reconnects
  *   - Re-subscription after reconnect
+ *   - Persistent sessions and batched SUBSCRIBE requests
  * 
  * Build:
  *   gcc -I../include -I. -o test_reconnection test_reconnection.c \
@@ -137,6 +138,34 @@ static SdsError init_device(const char* node_id) {
     return sds_init(&config);
 }
 
+static SdsError init_persistent_device(const char* node_id, bool broker_keeps_session) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+        .mqtt_session_present = broker_keeps_session,
+    };
+    sds_mock_configure(&mock_cfg);
+    
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .persistent_session = true,
+    };
+    
+    return sds_init(&config);
+}
+
+static void on_raw_message(const char* topic, const uint8_t* payload, size_t payload_len, void* user_data) {
+    (void)topic;
+    (void)payload;
+    (void)payload_len;
+    (*(int*)user_data)++;
+}
+
 static SdsError register_device_table(TestDeviceTable* table, const char* type) {
     return sds_register_table_ex(
         table, type, SDS_ROLE_DEVICE, NULL,
@@ -444,6 +473,126 @@ TEST(messages_received_counter_survives_reconnect) {
     ASSERT_EQ(stats->messages_received, 3);
 }
 
+TEST(reconnect_waits_for_backoff_deadline) {
+    init_device("backoff_node");
+    
+    SdsMockConfig cfg = *sds_mock_get_config();
+    cfg.mqtt_connected = false;
+    cfg.mqtt_connect_returns_success = false;
+    sds_mock_configure(&cfg);
+    
+    /* Disconnected with no attempt yet: retry is due now */
+    ASSERT_EQ(sds_next_deadline_ms(), 0);
+    
+    size_t connects = sds_mock_get_connect_count();
+    sds_loop();
+    ASSERT_EQ(sds_mock_get_connect_count(), connects + 1);
+    ASSERT_EQ(sds_next_deadline_ms(), 1000);  /* Initial backoff */
+    
+    /* No attempt before the deadline */
+    sds_mock_advance_time(999);
+    sds_loop();
+    ASSERT_EQ(sds_mock_get_connect_count(), connects + 1);
+    ASSERT_EQ(sds_next_deadline_ms(), 1);
+    
+    /* Second failure doubles the backoff */
+    sds_mock_advance_time(1);
+    sds_loop();
+    ASSERT_EQ(sds_mock_get_connect_count(), connects + 2);
+    ASSERT_EQ(sds_next_deadline_ms(), 2000);
+    
+    /* Successful reconnect clears the reconnect deadline */
+    cfg = *sds_mock_get_config();
+    cfg.mqtt_connect_returns_success = true;
+    sds_mock_configure(&cfg);
+    sds_mock_advance_time(2000);
+    sds_loop();
+    ASSERT(sds_is_ready());
+    ASSERT_EQ(sds_next_deadline_ms(), UINT32_MAX);  /* No tables registered */
+}
+
+/* ============================================================================
+ * PERSISTENT SESSION TESTS
+ * ============================================================================ */
+
+TEST(clean_reconnect_resubscribes_in_one_request) {
+    init_device("batch_node");
+    
+    TestDeviceTable table1 = {0};
+    TestDeviceTable table2 = {0};
+    register_device_table(&table1, "Table1");
+    register_device_table(&table2, "Table2");
+    int raw_count = 0;
+    ASSERT_EQ(sds_subscribe_raw("app/commands/#", on_raw_message, &raw_count), SDS_OK);
+    ASSERT(!sds_mock_get_persistent_session());
+    
+    size_t requests = sds_mock_get_subscribe_many_call_count();
+    sds_mock_simulate_disconnect();
+    sds_loop();
+    
+    /* Clean session: the broker dropped everything; all of it comes back at once */
+    ASSERT(sds_is_ready());
+    ASSERT_EQ(sds_mock_get_subscribe_many_call_count(), requests + 1);
+    ASSERT(sds_mock_is_subscribed("sds/Table1/config"));
+    ASSERT(sds_mock_is_subscribed("sds/Table2/config"));
+    ASSERT(sds_mock_is_subscribed("app/commands/#"));
+    ASSERT_EQ(sds_get_stats()->sessions_resumed, 0);
+}
+
+TEST(owner_lwt_subscription_restored) {
+    init_device("owner_node");
+    
+    TestDeviceTable table = {0};
+    ASSERT_EQ(sds_register_table_ex(
+        &table, "OwnerTable", SDS_ROLE_OWNER, NULL,
+        offsetof(TestDeviceTable, config), sizeof(TestConfig),
+        offsetof(TestDeviceTable, state), sizeof(TestState),
+        0, 0,
+        serialize_config, deserialize_config,
+        serialize_state, deserialize_state,
+        NULL, NULL), SDS_OK);
+    ASSERT(sds_mock_is_subscribed("sds/lwt/+"));
+    
+    sds_mock_simulate_disconnect();
+    sds_loop();
+    
+    ASSERT(sds_mock_is_subscribed("sds/OwnerTable/state"));
+    ASSERT(sds_mock_is_subscribed("sds/lwt/+"));
+}
+
+TEST(persistent_session_skips_resubscribe) {
+    ASSERT_EQ(init_persistent_device("persist_node", true), SDS_OK);
+    ASSERT(sds_mock_get_persistent_session());
+    
+    TestDeviceTable table = {0};
+    register_device_table(&table, "TestTable");
+    size_t sub_calls = sds_mock_get_subscribe_call_count();
+    
+    sds_mock_simulate_disconnect();
+    sds_loop();
+    
+    ASSERT(sds_is_ready());
+    ASSERT_EQ(sds_mock_get_subscribe_call_count(), sub_calls);
+    ASSERT(sds_mock_is_subscribed("sds/TestTable/config"));
+    ASSERT_EQ(sds_get_stats()->sessions_resumed, 1);
+    ASSERT_EQ(sds_get_stats()->reconnect_count, 1);
+}
+
+TEST(lost_persistent_session_resubscribes) {
+    ASSERT_EQ(init_persistent_device("persist_node", false), SDS_OK);
+    
+    TestDeviceTable table = {0};
+    register_device_table(&table, "TestTable");
+    
+    sds_mock_simulate_disconnect();
+    sds_loop();
+    
+    /* Broker came back without the session (e.g. failover to a fresh node) */
+    ASSERT(sds_is_ready());
+    ASSERT(sds_mock_is_subscribed("sds/TestTable/config"));
+    ASSERT_EQ(sds_get_stats()->sessions_resumed, 0);
+}
+
 /* ============================================================================
  * MAIN
  * ============================================================================ */
@@ -472,6 +621,13 @@ int main(void) {
     RUN_TEST(reconnect_failure_invokes_error_callback);
     RUN_TEST(config_received_after_reconnect);
     RUN_TEST(messages_received_counter_survives_reconnect);
+    RUN_TEST(reconnect_waits_for_backoff_deadline);
+    
+    printf("\n─── Persistent Sessions ───\n");
+    RUN_TEST(clean_reconnect_resubscribes_in_one_request);
+    RUN_TEST(owner_lwt_subscription_restored);
+    RUN_TEST(persistent_session_skips_resubscribe);
+    RUN_TEST(lost_persistent_session_resubscribes);
     
     printf("\n");
     printf("══════════════════════════════════════════════════════════════\n");
@@ -0,0 +1,585 @@
+/*
+ * test_schema_serializer.c - Schema (SdsFieldMeta) Serializer Tests
+ *
+ * Tests tables registered without serialization callbacks, using the
+ * mock platform:
+ * - Published JSON is byte-identical to the equivalent callbacks
+ * - Float fields honor SdsFieldMeta.precision
+ * - Config/state/status are parsed from field metadata alone
+ * - Registry entries and sds_set_table_fields() publish the initial config
+ * - Owners without a state serializer still never publish state
+ * - Sections too large for the key cache still serialize correctly
+ * - The key cache is carved from the table arena, or skipped without room
+ *
+ * Build:
+ *   gcc -I../include -o test_schema_serializer test_schema_serializer.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_schema_serializer
+ */
+
+#include "sds.h"
+#include "sds_json.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_STR_EQ(a, b) ASSERT(strcmp((a), (b)) == 0)
+
+/* ============== Table Definitions ============== */
+
+typedef struct {
+    uint8_t mode;
+    char label[16];
+    int16_t offset;
+} SchemaConfig;
+
+typedef struct {
+    float temperature;
+    int32_t delta;
+    bool active;
+} SchemaState;
+
+typedef struct {
+    uint8_t error_code;
+    uint16_t battery_mv;
+    uint32_t uptime;
+} SchemaStatus;
+
+typedef struct {
+    SchemaConfig config;
+    SchemaState state;
+    SchemaStatus status;
+} SchemaDeviceTable;
+
+typedef struct {
+    char node_id[SDS_MAX_NODE_ID_LEN];
+    bool valid;
+    bool online;
+    bool eviction_pending;
+    uint32_t last_seen_ms;
+    uint32_t eviction_deadline;
+    SchemaStatus status;
+} SchemaStatusSlot;
+
+#define SCHEMA_MAX_NODES 4
+
+typedef struct {
+    SchemaConfig config;
+    SchemaState state;
+    SchemaStatusSlot status_slots[SCHEMA_MAX_NODES];
+    uint8_t status_count;
+} SchemaOwnerTable;
+
+static const SdsFieldMeta schema_config_fields[] = {
+    { .name = "mode", .type = SDS_FIELD_UINT8, .offset = offsetof(SchemaConfig, mode), .size = sizeof(uint8_t) },
+    { .name = "label", .type = SDS_FIELD_STRING, .offset = offsetof(SchemaConfig, label), .size = 16 },
+    { .name = "offset", .type = SDS_FIELD_INT16, .offset = offsetof(SchemaConfig, offset), .size = sizeof(int16_t) },
+};
+
+static const SdsFieldMeta schema_state_fields[] = {
+    { .name = "temperature", .type = SDS_FIELD_FLOAT, .offset = offsetof(SchemaState, temperature), .size = sizeof(float) },
+    { .name = "delta", .type = SDS_FIELD_INT32, .offset = offsetof(SchemaState, delta), .size = sizeof(int32_t) },
+    { .name = "active", .type = SDS_FIELD_BOOL, .offset = offsetof(SchemaState, active), .size = sizeof(bool) },
+};
+
+static const SdsFieldMeta schema_status_fields[] = {
+    { .name = "error_code", .type = SDS_FIELD_UINT8, .offset = offsetof(SchemaStatus, error_code), .size = sizeof(uint8_t) },
+    { .name = "battery_mv", .type = SDS_FIELD_UINT16, .offset = offsetof(SchemaStatus, battery_mv), .size = sizeof(uint16_t) },
+    { .name = "uptime", .type = SDS_FIELD_UINT32, .offset = offsetof(SchemaStatus, uptime), .size = sizeof(uint32_t) },
+};
+
+/* ============== Reference Callbacks ============== */
+
+static void serialize_state(void* section, SdsJsonWriter* w) {
+    SchemaState* st = (SchemaState*)section;
+    sds_json_add_float(w, "temperature", st->temperature);
+    sds_json_add_int(w, "delta", st->delta);
+    sds_json_add_bool(w, "active", st->active);
+}
+
+static void serialize_status(void* section, SdsJsonWriter* w) {
+    SchemaStatus* st = (SchemaStatus*)section;
+    sds_json_add_uint(w, "error_code", st->error_code);
+    sds_json_add_uint(w, "battery_mv", st->battery_mv);
+    sds_json_add_uint(w, "uptime", st->uptime);
+}
+
+/* ============== Helper Functions ============== */
+
+static char g_captured[SDS_MOCK_MAX_PAYLOAD_LEN + 1];
+
+static SdsError init_node(const char* node_id, bool enable_delta) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_delta_sync = enable_delta,
+    };
+
+    return sds_init(&config);
+}
+
+/* Register a device either with reference callbacks or with field metadata only */
+static SdsError register_device(SchemaDeviceTable* table, bool with_callbacks) {
+    SdsError err = sds_register_table_ex(
+        table, "SchemaTable", SDS_ROLE_DEVICE, NULL,
+        offsetof(SchemaDeviceTable, config), sizeof(SchemaConfig),
+        offsetof(SchemaDeviceTable, state), sizeof(SchemaState),
+        offsetof(SchemaDeviceTable, status), sizeof(SchemaStatus),
+        NULL, NULL,
+        with_callbacks ? serialize_state : NULL, NULL,
+        with_callbacks ? serialize_status : NULL, NULL
+    );
+    if (err != SDS_OK || with_callbacks) return err;
+    return sds_set_table_fields("SchemaTable",
+        schema_config_fields, 3, schema_state_fields, 3, schema_status_fields, 3);
+}
+
+static SdsError register_owner(SchemaOwnerTable* table) {
+    SdsError err = sds_register_table_ex(
+        table, "SchemaTable", SDS_ROLE_OWNER, NULL,
+        offsetof(SchemaOwnerTable, config), sizeof(SchemaConfig),
+        offsetof(SchemaOwnerTable, state), sizeof(SchemaState),
+        0, 0,
+        NULL, NULL, NULL, NULL, NULL, NULL
+    );
+    if (err != SDS_OK) return err;
+
+    sds_set_owner_status_slots("SchemaTable",
+        offsetof(SchemaOwnerTable, status_slots), sizeof(SchemaStatusSlot),
+        offsetof(SchemaStatusSlot, status), offsetof(SchemaOwnerTable, status_count),
+        SCHEMA_MAX_NODES);
+    sds_set_owner_slot_offsets("SchemaTable",
+        offsetof(SchemaStatusSlot, valid), offsetof(SchemaStatusSlot, online),
+        offsetof(SchemaStatusSlot, last_seen_ms));
+
+    return sds_set_table_fields("SchemaTable",
+        schema_config_fields, 3, schema_state_fields, 3, schema_status_fields, 3);
+}
+
+/* Copy the newest payload on a topic as a NUL-terminated string */
+static const char* capture(const char* topic) {
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(topic);
+    if (!msg) return NULL;
+    memcpy(g_captured, msg->payload, msg->payload_len);
+    g_captured[msg->payload_len] = '\0';
+    return g_captured;
+}
+
+/* Publish state and status from "dev1" and copy both payloads out */
+static bool publish_device(bool with_callbacks, char* state, char* status, size_t size) {
+    SchemaDeviceTable table = {0};
+    init_node("dev1", false);
+    register_device(&table, with_callbacks);
+    table.state.temperature = -12.5f;
+    table.state.delta = -40000;
+    table.state.active = true;
+    table.status.error_code = 7;
+    table.status.battery_mv = 3650;
+    table.status.uptime = 4000000000u;
+
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    const char* s = capture("sds/SchemaTable/state");
+    if (!s) return false;
+    snprintf(state, size, "%s", s);
+    s = capture("sds/SchemaTable/status/dev1");
+    if (!s) return false;
+    snprintf(status, size, "%s", s);
+
+    sds_shutdown();
+    sds_mock_reset();
+    return true;
+}
+
+/* ============== Serialization Tests ============== */
+
+TEST(schema_output_matches_callbacks) {
+    char cb_state[256], cb_status[256];
+    char schema_state[256], schema_status[256];
+
+    ASSERT(publish_device(true, cb_state, cb_status, sizeof(cb_state)));
+    ASSERT(publish_device(false, schema_state, schema_status, sizeof(schema_state)));
+
+    ASSERT_STR_EQ(cb_state, schema_state);
+    ASSERT_STR_EQ(cb_status, schema_status);
+    ASSERT(strstr(schema_state, "\"delta\":-40000") != NULL);
+    ASSERT(strstr(schema_status, "\"uptime\":4000000000") != NULL);
+}
+
+TEST(schema_owner_publishes_config) {
+    init_node("owner1", false);
+
+    SchemaOwnerTable owner = {0};
+    ASSERT_EQ(register_owner(&owner), SDS_OK);
+    owner.config.mode = 2;
+    strcpy(owner.config.label, "say \"hi\"");
+    owner.config.offset = -300;
+
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    const char* cfg = capture("sds/SchemaTable/config");
+    ASSERT(cfg != NULL);
+    ASSERT(strstr(cfg, "\"mode\":2,\"label\":\"say \\\"hi\\\"\",\"offset\":-300}") != NULL);
+}
+
+TEST(set_fields_publishes_initial_config) {
+    init_node("owner1", false);
+
+    SchemaOwnerTable owner = {0};
+    ASSERT_EQ(register_owner(&owner), SDS_OK);
+
+    /* All-zero config is still announced once, as callback owners do */
+    const char* cfg = capture("sds/SchemaTable/config");
+    ASSERT(cfg != NULL);
+    ASSERT(strstr(cfg, "\"mode\":0,\"label\":\"\",\"offset\":0}") != NULL);
+    ASSERT_EQ(sds_mock_get_publish_count(), 1);
+
+    /* Re-attaching metadata does not republish */
+    ASSERT_EQ(sds_set_table_fields("SchemaTable",
+        schema_config_fields, 3, schema_state_fields, 3, schema_status_fields, 3), SDS_OK);
+    ASSERT_EQ(sds_mock_get_publish_count(), 1);
+}
+
+TEST(schema_owner_never_publishes_state) {
+    init_node("owner1", false);
+
+    SchemaOwnerTable owner = {0};
+    ASSERT_EQ(register_owner(&owner), SDS_OK);
+    owner.state.delta = 5;
+
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    ASSERT(sds_mock_find_publish_by_topic("sds/SchemaTable/state") == NULL);
+}
+
+TEST(schema_delta_sends_changed_fields) {
+    init_node("dev1", true);
+
+    SchemaDeviceTable table = {0};
+    ASSERT_EQ(register_device(&table, false), SDS_OK);
+    table.state.temperature = 1.0f;
+    table.state.delta = 1;
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    table.state.delta = 2;
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    const char* st = capture("sds/SchemaTable/state");
+    ASSERT(st != NULL);
+    ASSERT(strstr(st, "\"delta\":2") != NULL);
+    ASSERT(strstr(st, "temperature") == NULL);
+    ASSERT(strstr(st, "active") == NULL);
+}
+
+TEST(schema_float_precision) {
+    static const SdsFieldMeta rounded_state_fields[] = {
+        { .name = "temperature", .type = SDS_FIELD_FLOAT, .offset = offsetof(SchemaState, temperature),
+          .size = sizeof(float), .precision = 1 },
+        { .name = "delta", .type = SDS_FIELD_INT32, .offset = offsetof(SchemaState, delta), .size = sizeof(int32_t) },
+        { .name = "active", .type = SDS_FIELD_BOOL, .offset = offsetof(SchemaState, active), .size = sizeof(bool) },
+    };
+    init_node("dev1", false);
+
+    SchemaDeviceTable table = {0};
+    ASSERT_EQ(register_device(&table, false), SDS_OK);
+    ASSERT_EQ(sds_set_table_fields("SchemaTable",
+        schema_config_fields, 3, rounded_state_fields, 3, schema_status_fields, 3), SDS_OK);
+    table.state.temperature = 21.47f;
+
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    const char* st = capture("sds/SchemaTable/state");
+    ASSERT(st != NULL);
+    ASSERT(strstr(st, "\"temperature\":21.5,") != NULL);
+}
+
+/* ============== Deserialization Tests ============== */
+
+TEST(schema_config_decodes_at_device) {
+    init_node("dev1", false);
+
+    SchemaDeviceTable table = {0};
+    ASSERT_EQ(register_device(&table, false), SDS_OK);
+    table.config.mode = 9;
+
+    sds_mock_inject_message_str("sds/SchemaTable/config",
+        "{\"ts\":1,\"from\":\"owner1\",\"offset\":-123,\"label\":\"a\\nb\",\"mode\":300}");
+
+    ASSERT_EQ(table.config.offset, -123);
+    ASSERT_STR_EQ(table.config.label, "a\nb");
+    ASSERT_EQ(table.config.mode, 9);  /* Out of range for uint8: unchanged */
+}
+
+TEST(schema_state_and_status_decode_at_owner) {
+    init_node("owner1", false);
+
+    SchemaOwnerTable owner = {0};
+    ASSERT_EQ(register_owner(&owner), SDS_OK);
+
+    sds_mock_inject_message_str("sds/SchemaTable/state",
+        "{\"ts\":1,\"node\":\"dev1\",\"temperature\":21.5,\"delta\":-7,\"active\":true}");
+    ASSERT(owner.state.temperature > 21.49f && owner.state.temperature < 21.51f);
+    ASSERT_EQ(owner.state.delta, -7);
+    ASSERT(owner.state.active);
+
+    sds_mock_inject_message_str("sds/SchemaTable/status/dev1",
+        "{\"ts\":1,\"online\":true,\"error_code\":4,\"battery_mv\":3300,\"uptime\":99}");
+    ASSERT_EQ(owner.status_count, 1);
+    ASSERT_STR_EQ(owner.status_slots[0].node_id, "dev1");
+    ASSERT_EQ(owner.status_slots[0].status.error_code, 4);
+    ASSERT_EQ(owner.status_slots[0].status.battery_mv, 3300);
+    ASSERT_EQ(owner.status_slots[0].status.uptime, 99);
+
+    /* Partial update leaves other fields alone */
+    sds_mock_inject_message_str("sds/SchemaTable/status/dev1",
+        "{\"ts\":2,\"online\":true,\"uptime\":100}");
+    ASSERT_EQ(owner.status_slots[0].status.battery_mv, 3300);
+    ASSERT_EQ(owner.status_slots[0].status.uptime, 100);
+}
+
+/* ============== Registry and Cache Tests ============== */
+
+static const SdsTableMeta schema_registry[] = {
+    {
+        .table_type = "SchemaTable",
+        .sync_interval_ms = 1000,
+        .liveness_interval_ms = 30000,
+        .device_table_size = sizeof(SchemaDeviceTable),
+        .owner_table_size = sizeof(SchemaOwnerTable),
+        .dev_config_offset = offsetof(SchemaDeviceTable, config),
+        .dev_config_size = sizeof(SchemaConfig),
+        .dev_state_offset = offsetof(SchemaDeviceTable, state),
+        .dev_state_size = sizeof(SchemaState),
+        .dev_status_offset = offsetof(SchemaDeviceTable, status),
+        .dev_status_size = sizeof(SchemaStatus),
+        .own_config_offset = offsetof(SchemaOwnerTable, config),
+        .own_config_size = sizeof(SchemaConfig),
+        .own_state_offset = offsetof(SchemaOwnerTable, state),
+        .own_state_size = sizeof(SchemaState),
+        .config_fields = schema_config_fields,
+        .config_field_count = 3,
+        .state_fields = schema_state_fields,
+        .state_field_count = 3,
+        .status_fields = schema_status_fields,
+        .status_field_count = 3,
+    },
+};
+
+TEST(registry_without_callbacks_publishes_initial_config) {
+    init_node("owner1", false);
+    sds_set_table_registry(schema_registry, 1);
+
+    SchemaOwnerTable owner = {0};
+    owner.config.mode = 5;
+    ASSERT_EQ(sds_register_table(&owner, "SchemaTable", SDS_ROLE_OWNER, NULL), SDS_OK);
+
+    const char* cfg = capture("sds/SchemaTable/config");
+    ASSERT(cfg != NULL);
+    ASSERT(strstr(cfg, "\"mode\":5,\"label\":\"\",\"offset\":0}") != NULL);
+}
+
+/* Names long enough that the three sections overflow SDS_FIELD_KEY_CACHE_SIZE */
+#define LONG_NAME(c) \
+    c "____________________________________________________________" \
+      "____________________________________________________________" \
+      "____________________________________________________________"
+
+static const SdsFieldMeta long_state_fields[] = {
+    { .name = LONG_NAME("t"), .type = SDS_FIELD_FLOAT, .offset = offsetof(SchemaState, temperature), .size = sizeof(float) },
+    { .name = LONG_NAME("d"), .type = SDS_FIELD_INT32, .offset = offsetof(SchemaState, delta), .size = sizeof(int32_t) },
+    { .name = LONG_NAME("a"), .type = SDS_FIELD_BOOL, .offset = offsetof(SchemaState, active), .size = sizeof(bool) },
+};
+
+TEST(uncached_keys_still_round_trip) {
+    init_node("dev1", false);
+
+    SchemaDeviceTable table = {0};
+    ASSERT_EQ(sds_register_table_ex(
+        &table, "SchemaTable", SDS_ROLE_DEVICE, NULL,
+        offsetof(SchemaDeviceTable, config), sizeof(SchemaConfig),
+        offsetof(SchemaDeviceTable, state), sizeof(SchemaState),
+        offsetof(SchemaDeviceTable, status), sizeof(SchemaStatus),
+        NULL, NULL, NULL, NULL, NULL, NULL), SDS_OK);
+    ASSERT_EQ(sds_set_table_fields("SchemaTable",
+        NULL, 0, long_state_fields, 3, NULL, 0), SDS_OK);
+
+    table.state.delta = 77;
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    const char* st = capture("sds/SchemaTable/state");
+    ASSERT(st != NULL);
+    ASSERT(strstr(st, "\"" LONG_NAME("d") "\":77") != NULL);
+    ASSERT(strstr(st, "\"" LONG_NAME("a") "\":false}") != NULL);
+
+    /* The owner side parses the same keys */
+    char payload[SDS_MOCK_MAX_PAYLOAD_LEN + 1];
+    snprintf(payload, sizeof(payload), "%s", st);
+    sds_shutdown();
+    sds_mock_reset();
+
+    init_node("owner1", false);
+    SchemaOwnerTable owner = {0};
+    ASSERT_EQ(sds_register_table_ex(
+        &owner, "SchemaTable", SDS_ROLE_OWNER, NULL,
+        offsetof(SchemaOwnerTable, config), sizeof(SchemaConfig),
+        offsetof(SchemaOwnerTable, state), sizeof(SchemaState),
+        0, 0, NULL, NULL, NULL, NULL, NULL, NULL), SDS_OK);
+    ASSERT_EQ(sds_set_table_fields("SchemaTable",
+        NULL, 0, long_state_fields, 3, NULL, 0), SDS_OK);
+
+    sds_mock_inject_message_str("sds/SchemaTable/state", payload);
+    ASSERT_EQ(owner.state.delta, 77);
+}
+
+/* Each field takes its name plus 4 bytes of cache: [len]"name": */
+#define SCHEMA_KEY_BYTES 104
+
+static SdsError init_arena_node(uint8_t* arena, size_t size) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = "dev1",
+        .mqtt_broker = "mock_broker",
+        .table_arena = arena,
+        .table_arena_size = size,
+        .max_tables = 1,
+    };
+    return sds_init(&config);
+}
+
+TEST(field_keys_carved_from_table_arena) {
+    static uint8_t arena[4096];
+    size_t sections = sizeof(SchemaConfig) + sizeof(SchemaState) + sizeof(SchemaStatus);
+    ASSERT(sds_table_arena_size(1, sections) + SCHEMA_KEY_BYTES <= sizeof(arena));
+
+    /* Room for the sections only: keys are formatted per message */
+    ASSERT_EQ(init_arena_node(arena, sds_table_arena_size(1, sections)), SDS_OK);
+    SchemaDeviceTable table = {0};
+    ASSERT_EQ(register_device(&table, false), SDS_OK);
+    ASSERT(sds_mock_log_contains("formats field keys per message"));
+
+    table.state.delta = -5;
+    sds_mock_advance_time(1100);
+    sds_loop();
+    const char* st = capture("sds/SchemaTable/state");
+    ASSERT(st != NULL);
+    ASSERT(strstr(st, "\"delta\":-5") != NULL);
+    sds_shutdown();
+    sds_mock_reset();
+
+    ASSERT_EQ(init_arena_node(arena, sds_table_arena_size(1, sections) + SCHEMA_KEY_BYTES), SDS_OK);
+    memset(&table, 0, sizeof(table));
+    ASSERT_EQ(register_device(&table, false), SDS_OK);
+    ASSERT(!sds_mock_log_contains("formats field keys per message"));
+
+    /* The same metadata again reuses the block */
+    ASSERT_EQ(sds_set_table_fields("SchemaTable",
+        schema_config_fields, 3, schema_state_fields, 3, schema_status_fields, 3), SDS_OK);
+    ASSERT(!sds_mock_log_contains("formats field keys per message"));
+
+    table.state.delta = -5;
+    sds_mock_advance_time(1100);
+    sds_loop();
+    st = capture("sds/SchemaTable/state");
+    ASSERT(st != NULL);
+    ASSERT(strstr(st, "\"delta\":-5") != NULL);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║        Schema Serializer Tests (Mock Platform)               ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Serialization Tests ───\n");
+    RUN_TEST(schema_output_matches_callbacks);
+    RUN_TEST(schema_owner_publishes_config);
+    RUN_TEST(set_fields_publishes_initial_config);
+    RUN_TEST(schema_owner_never_publishes_state);
+    RUN_TEST(schema_delta_sends_changed_fields);
+    RUN_TEST(schema_float_precision);
+
+    printf("\n─── Deserialization Tests ───\n");
+    RUN_TEST(schema_config_decodes_at_device);
+    RUN_TEST(schema_state_and_status_decode_at_owner);
+
+    printf("\n─── Registry and Cache Tests ───\n");
+    RUN_TEST(registry_without_callbacks_publishes_initial_config);
+    RUN_TEST(uncached_keys_still_round_trip);
+    RUN_TEST(field_keys_carved_from_table_arena);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
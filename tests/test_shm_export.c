@@ -0,0 +1,457 @@
+/*
+ * test_shm_export.c - Shared-Memory Export Tests
+ *
+ * Tests exporting owner status slots to a named segment with the mock
+ * platform (attaching maps the same block, as another process would):
+ * - Header layout: schema, owner, field descriptors, region offsets
+ * - Ingest writes the segment; attached reads see status and liveness
+ * - sds_shared_table_foreach() over the attached view
+ * - Unexport / unregister / shutdown copy the slots back and close it
+ * - Inline slot tables, missing metadata and bad names are rejected
+ *
+ * Build:
+ *   gcc -I../include -I. -o test_shm_export test_shm_export.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_shm_export
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Table Definition ============== */
+
+#define TEST_EVICTION_GRACE_MS 100
+#define SHM_TEST_SLOTS 16
+#define SHM_TEST_NAME "/sds.test.Shm"
+
+typedef struct {
+    uint8_t mode;
+} ShmConfig;
+
+typedef struct {
+    float value;
+} ShmState;
+
+typedef struct {
+    uint8_t error_code;
+    uint8_t battery;
+    uint32_t uptime;
+} ShmStatus;
+
+typedef struct {
+    char node_id[SDS_MAX_NODE_ID_LEN];
+    bool valid;
+    bool online;
+    bool eviction_pending;
+    uint32_t last_seen_ms;
+    uint32_t eviction_deadline;
+    ShmStatus status;
+} ShmStatusSlot;
+
+typedef struct {
+    ShmConfig config;
+    ShmState state;
+    ShmStatusSlot* status_slots;
+    uint32_t status_count;
+} ShmOwnerTable;
+
+static const SdsFieldMeta shm_status_fields[] = {
+    { .name = "error_code", .type = SDS_FIELD_UINT8, .offset = offsetof(ShmStatus, error_code), .size = sizeof(uint8_t) },
+    { .name = "battery", .type = SDS_FIELD_UINT8, .offset = offsetof(ShmStatus, battery), .size = sizeof(uint8_t) },
+    { .name = "uptime", .type = SDS_FIELD_UINT32, .offset = offsetof(ShmStatus, uptime), .size = sizeof(uint32_t) },
+};
+
+static ShmOwnerTable g_owner;
+static ShmStatusSlot g_slots[SHM_TEST_SLOTS];
+static SensorDataOwnerTable g_inline;
+
+/* ============== Helper Functions ============== */
+
+static SdsError init_owner(uint32_t eviction_grace_ms) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = "owner1",
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .eviction_grace_ms = eviction_grace_ms,
+    };
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_owner, 0, sizeof(g_owner));
+    memset(g_slots, 0, sizeof(g_slots));
+    g_owner.status_slots = g_slots;
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    err = sds_register_table_ex(
+        &g_owner, "Shm", SDS_ROLE_OWNER, &opts,
+        offsetof(ShmOwnerTable, config), sizeof(ShmConfig),
+        offsetof(ShmOwnerTable, state), sizeof(ShmState),
+        0, 0,
+        NULL, NULL, NULL, NULL, NULL, NULL);
+    if (err != SDS_OK) return err;
+
+    sds_set_table_fields("Shm", NULL, 0, NULL, 0, shm_status_fields, 3);
+    sds_set_owner_slot_offsets("Shm",
+        offsetof(ShmStatusSlot, valid),
+        offsetof(ShmStatusSlot, online),
+        offsetof(ShmStatusSlot, last_seen_ms));
+    sds_set_owner_eviction_offsets("Shm",
+        offsetof(ShmStatusSlot, eviction_pending),
+        offsetof(ShmStatusSlot, eviction_deadline));
+    return sds_set_owner_status_slots_wide("Shm", SDS_SLOTS_EXTERNAL,
+        offsetof(ShmOwnerTable, status_slots),
+        sizeof(ShmStatusSlot),
+        offsetof(ShmStatusSlot, status),
+        offsetof(ShmOwnerTable, status_count), sizeof(uint32_t),
+        SHM_TEST_SLOTS);
+}
+
+static void inject_status(const char* node, uint32_t uptime) {
+    char topic[64];
+    char payload[128];
+    snprintf(topic, sizeof(topic), "sds/Shm/status/%s", node);
+    snprintf(payload, sizeof(payload),
+             "{\"ts\":1,\"online\":true,\"error_code\":%u,\"battery\":%u,\"uptime\":%u}",
+             (unsigned)(uptime % 7), (unsigned)(uptime % 100), (unsigned)uptime);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+static void inject_lwt(const char* node) {
+    char topic[64];
+    snprintf(topic, sizeof(topic), "sds/lwt/%s", node);
+    sds_mock_inject_message_str(topic, "{\"online\":false,\"node\":\"x\",\"ts\":0}");
+}
+
+typedef struct {
+    uint32_t count;
+    uint32_t uptime_sum;
+} ForeachTally;
+
+static void tally_node(const SdsSnapshotRow* node, const void* status, void* user_data) {
+    (void)node;
+    ForeachTally* t = (ForeachTally*)user_data;
+    const ShmStatus* st = (const ShmStatus*)status;
+    t->count++;
+    t->uptime_sum += st->uptime;
+}
+
+/* ============== Layout Tests ============== */
+
+TEST(export_writes_header) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+    ASSERT_EQ(sds_mock_get_shm_count(), 1);
+
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach(SHM_TEST_NAME, &view), SDS_OK);
+    const SdsShmHeader* h = view.header;
+    ASSERT_EQ(h->magic, SDS_SHM_MAGIC);
+    ASSERT_EQ(h->version, SDS_SHM_VERSION);
+    ASSERT_EQ(h->state, SDS_SHM_LIVE);
+    ASSERT(strcmp(h->table_type, "Shm") == 0);
+    ASSERT(strcmp(h->owner_node_id, "owner1") == 0);
+    ASSERT_EQ(h->max_slots, SHM_TEST_SLOTS);
+    ASSERT_EQ(h->slot_size, sizeof(ShmStatusSlot));
+    ASSERT_EQ(h->slot_status_offset, offsetof(ShmStatusSlot, status));
+    ASSERT_EQ(h->slot_last_seen_offset, offsetof(ShmStatusSlot, last_seen_ms));
+    ASSERT_EQ(h->status_size, sizeof(ShmStatus));
+    ASSERT_EQ(h->field_count, 3);
+    ASSERT(strcmp(view.fields[2].name, "uptime") == 0);
+    ASSERT_EQ(view.fields[2].type, SDS_FIELD_UINT32);
+    ASSERT_EQ(view.fields[2].offset, offsetof(ShmStatus, uptime));
+    ASSERT_EQ(h->slots_offset % 8, 0);
+    ASSERT(h->slots_offset + SHM_TEST_SLOTS * sizeof(ShmStatusSlot) <= view.size);
+    sds_shared_table_detach(&view);
+    ASSERT(view.header == NULL);
+}
+
+TEST(export_moves_existing_devices) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    inject_status("dev_a", 11);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+
+    /* The table now points into the segment */
+    ASSERT(g_owner.status_slots != g_slots);
+    ASSERT_EQ(g_owner.status_slots[0].status.uptime, 11);
+
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach(SHM_TEST_NAME, &view), SDS_OK);
+    ShmStatus st;
+    ASSERT(sds_shared_table_read(&view, "dev_a", &st, sizeof(st), NULL));
+    ASSERT_EQ(st.uptime, 11);
+    sds_shared_table_detach(&view);
+}
+
+/* ============== Read Tests ============== */
+
+TEST(attached_reads_follow_ingest) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach(SHM_TEST_NAME, &view), SDS_OK);
+
+    sds_mock_advance_time(250);
+    inject_status("dev_a", 142);
+    inject_status("dev_b", 9);
+
+    ShmStatus st;
+    SdsSnapshotRow node;
+    ASSERT(sds_shared_table_read(&view, "dev_a", &st, sizeof(st), &node));
+    ASSERT_EQ(st.uptime, 142);
+    ASSERT_EQ(st.battery, 42);
+    ASSERT_EQ(st.error_code, 142 % 7);
+    ASSERT(strcmp(node.node_id, "dev_a") == 0);
+    ASSERT(node.online);
+    ASSERT_EQ(node.last_seen_ms, g_owner.status_slots[0].last_seen_ms);
+
+    inject_status("dev_a", 143);
+    ASSERT(sds_shared_table_read(&view, "dev_a", &st, sizeof(st), NULL));
+    ASSERT_EQ(st.uptime, 143);
+    ASSERT(!sds_shared_table_read(&view, "dev_z", &st, sizeof(st), NULL));
+    sds_shared_table_detach(&view);
+}
+
+TEST(attached_reads_report_lwt_and_eviction) {
+    ASSERT_EQ(init_owner(TEST_EVICTION_GRACE_MS), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach(SHM_TEST_NAME, &view), SDS_OK);
+
+    inject_status("dev_a", 3);
+    inject_lwt("dev_a");
+
+    SdsSnapshotRow node;
+    ASSERT(sds_shared_table_read(&view, "dev_a", NULL, 0, &node));
+    ASSERT(!node.online);
+    ASSERT(node.eviction_pending);
+
+    sds_mock_advance_time(TEST_EVICTION_GRACE_MS + 10);
+    sds_loop();
+    ASSERT(!sds_shared_table_read(&view, "dev_a", NULL, 0, &node));
+    sds_shared_table_detach(&view);
+}
+
+TEST(loop_refreshes_owner_clock) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach(SHM_TEST_NAME, &view), SDS_OK);
+
+    uint32_t before = view.header->clock_ms;
+    sds_mock_advance_time(1500);
+    sds_loop();
+    ASSERT_EQ(view.header->clock_ms - before, 1500);
+    sds_shared_table_detach(&view);
+}
+
+TEST(foreach_visits_valid_slots) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+    inject_status("dev_a", 10);
+    inject_status("dev_b", 20);
+    inject_status("dev_c", 30);
+
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach(SHM_TEST_NAME, &view), SDS_OK);
+    ForeachTally t = {0};
+    ASSERT_EQ(sds_shared_table_foreach(&view, tally_node, &t), 3);
+    ASSERT_EQ(t.count, 3);
+    ASSERT_EQ(t.uptime_sum, 60);
+    sds_shared_table_detach(&view);
+}
+
+/* ============== Lifecycle Tests ============== */
+
+TEST(unexport_restores_slots_and_closes) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach(SHM_TEST_NAME, &view), SDS_OK);
+    inject_status("dev_a", 77);
+
+    ASSERT_EQ(sds_unexport_owner_table("Shm"), SDS_OK);
+    ASSERT(g_owner.status_slots == g_slots);
+    ASSERT_EQ(g_slots[0].status.uptime, 77);
+    ASSERT(strcmp(g_slots[0].node_id, "dev_a") == 0);
+
+    /* Still mapped by the reader, but closed and no longer named */
+    ASSERT_EQ(view.header->state, SDS_SHM_CLOSED);
+    ASSERT_EQ(sds_mock_get_shm_count(), 0);
+    SdsSharedTable again;
+    ASSERT_EQ(sds_shared_table_attach(SHM_TEST_NAME, &again), SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT_EQ(sds_unexport_owner_table("Shm"), SDS_ERR_TABLE_NOT_FOUND);
+    sds_shared_table_detach(&view);
+
+    /* Ingest continues into the caller's array */
+    inject_status("dev_a", 78);
+    ASSERT_EQ(g_slots[0].status.uptime, 78);
+}
+
+TEST(shutdown_closes_export) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach(SHM_TEST_NAME, &view), SDS_OK);
+
+    sds_shutdown();
+    ASSERT_EQ(view.header->state, SDS_SHM_CLOSED);
+    ASSERT_EQ(sds_mock_get_shm_count(), 0);
+    sds_shared_table_detach(&view);
+}
+
+TEST(reexport_replaces_segment) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+    inject_status("dev_a", 5);
+    ASSERT_EQ(sds_export_owner_table("Shm", "/sds.test.Shm2"), SDS_OK);
+    ASSERT_EQ(sds_mock_get_shm_count(), 1);
+
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach("/sds.test.Shm2", &view), SDS_OK);
+    ShmStatus st;
+    ASSERT(sds_shared_table_read(&view, "dev_a", &st, sizeof(st), NULL));
+    ASSERT_EQ(st.uptime, 5);
+    sds_shared_table_detach(&view);
+    ASSERT_EQ(sds_unexport_owner_table("Shm"), SDS_OK);
+    ASSERT(g_owner.status_slots == g_slots);
+}
+
+/* ============== Rejection Tests ============== */
+
+TEST(export_rejects_inline_slots) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    memset(&g_inline, 0, sizeof(g_inline));
+    ASSERT_EQ(sds_register_table(&g_inline, "SensorData", SDS_ROLE_OWNER, NULL), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("SensorData", SHM_TEST_NAME), SDS_ERR_INVALID_TABLE);
+    ASSERT_EQ(sds_export_owner_table("Missing", SHM_TEST_NAME), SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT_EQ(sds_mock_get_shm_count(), 0);
+}
+
+TEST(export_rejects_missing_field_metadata) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    sds_set_table_fields("Shm", NULL, 0, NULL, 0, NULL, 0);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_ERR_INVALID_TABLE);
+}
+
+TEST(export_rejects_bad_names) {
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", NULL), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_export_owner_table("Shm", "sds.Shm"), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_export_owner_table("Shm", "/"), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_export_owner_table("Shm", "/sds/Shm"), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_mock_get_shm_count(), 0);
+}
+
+TEST(seqlocks_locked_while_exported) {
+    static SdsSeqlock locks[SHM_TEST_SLOTS];
+    ASSERT_EQ(init_owner(0), SDS_OK);
+    ASSERT_EQ(sds_export_owner_table("Shm", SHM_TEST_NAME), SDS_OK);
+    ASSERT_EQ(sds_set_owner_slot_seqlocks("Shm", locks, SHM_TEST_SLOTS), SDS_ERR_INVALID_CONFIG);
+}
+
+TEST(attach_rejects_foreign_segments) {
+    SdsSharedTable view;
+    ASSERT_EQ(sds_shared_table_attach("/sds.none", &view), SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT(view.header == NULL);
+
+    uint8_t* seg = (uint8_t*)sds_platform_shm_create("/sds.foreign", 4096);
+    ASSERT(seg != NULL);
+    memset(seg, 0x5A, 4096);
+    ASSERT_EQ(sds_shared_table_attach("/sds.foreign", &view), SDS_ERR_INVALID_TABLE);
+    ASSERT(!sds_shared_table_read(&view, "dev_a", NULL, 0, NULL));
+    ASSERT_EQ(sds_shared_table_foreach(&view, tally_node, NULL), 0);
+    sds_platform_shm_remove("/sds.foreign", seg, 4096);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║          SDS Shared-Memory Export Tests                      ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n");
+
+    printf("\n─── Layout ───\n");
+    RUN_TEST(export_writes_header);
+    RUN_TEST(export_moves_existing_devices);
+
+    printf("\n─── Attached Reads ───\n");
+    RUN_TEST(attached_reads_follow_ingest);
+    RUN_TEST(attached_reads_report_lwt_and_eviction);
+    RUN_TEST(loop_refreshes_owner_clock);
+    RUN_TEST(foreach_visits_valid_slots);
+
+    printf("\n─── Lifecycle ───\n");
+    RUN_TEST(unexport_restores_slots_and_closes);
+    RUN_TEST(shutdown_closes_export);
+    RUN_TEST(reexport_replaces_segment);
+
+    printf("\n─── Rejection ───\n");
+    RUN_TEST(export_rejects_inline_slots);
+    RUN_TEST(export_rejects_missing_field_metadata);
+    RUN_TEST(export_rejects_bad_names);
+    RUN_TEST(seqlocks_locked_while_exported);
+    RUN_TEST(attach_rejects_foreign_segments);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -0,0 +1,393 @@
+/*
+ * test_slot_seqlock.c - Lock-Free Slot Read Tests
+ *
+ * Tests seqlock-protected status slot copies with the mock platform:
+ * - sds_read_node_status(): status and header copies, truncation, misses
+ * - Liveness and eviction metadata after LWT
+ * - Per-slot counters advance only for the device written
+ * - sds_foreach_node_copy() over the live table and over other buffers
+ * - A reader thread racing the receive path never sees a torn status
+ *
+ * Build:
+ *   gcc -I../include -I. -pthread -o test_slot_seqlock test_slot_seqlock.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_slot_seqlock
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+#define TEST_EVICTION_GRACE_MS 100
+
+static SensorDataOwnerTable g_sensor;
+static SensorDataTable g_device;
+static SdsSeqlock g_seqlocks[SDS_GENERATED_MAX_NODES];
+
+static SdsError init_node(const char* node_id, SdsRole role, uint32_t eviction_grace_ms) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .eviction_grace_ms = eviction_grace_ms,
+    };
+
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_sensor, 0, sizeof(g_sensor));
+    memset(&g_device, 0, sizeof(g_device));
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    if (role == SDS_ROLE_OWNER) {
+        return sds_register_table(&g_sensor, "SensorData", SDS_ROLE_OWNER, &opts);
+    }
+    return sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, &opts);
+}
+
+/* Status whose fields agree with each other: error_code == battery == uptime % 100 */
+static void inject_sensor_status(const char* node, uint32_t uptime) {
+    char topic[64];
+    char payload[128];
+    snprintf(topic, sizeof(topic), "sds/SensorData/status/%s", node);
+    snprintf(payload, sizeof(payload),
+             "{\"ts\":1,\"online\":true,\"error_code\":%u,\"battery_percent\":%u,\"uptime_seconds\":%u}",
+             (unsigned)(uptime % 100), (unsigned)(uptime % 100), (unsigned)uptime);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+static void inject_lwt(const char* node) {
+    char topic[64];
+    snprintf(topic, sizeof(topic), "sds/lwt/%s", node);
+    sds_mock_inject_message_str(topic, "{\"online\":false,\"node\":\"x\",\"ts\":0}");
+}
+
+static bool status_consistent(const SensorDataStatus* st) {
+    return st->error_code == st->battery_percent &&
+           st->battery_percent == st->uptime_seconds % 100;
+}
+
+/* ============== Single Read Tests ============== */
+
+TEST(read_copies_status_and_header) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, 0), SDS_OK);
+
+    sds_mock_advance_time(500);
+    inject_sensor_status("dev_a", 142);
+    inject_sensor_status("dev_b", 7);
+
+    SensorDataStatus st;
+    SdsSnapshotRow node;
+    memset(&st, 0xAA, sizeof(st));
+    ASSERT(sds_read_node_status(&g_sensor, "SensorData", "dev_a", &st, sizeof(st), &node));
+    ASSERT_EQ(st.uptime_seconds, 142);
+    ASSERT_EQ(st.battery_percent, 42);
+    ASSERT_EQ(st.error_code, 42);
+    ASSERT(strcmp(node.node_id, "dev_a") == 0);
+    ASSERT(node.online);
+    ASSERT(!node.eviction_pending);
+    ASSERT_EQ(node.last_seen_ms, g_sensor.status_slots[0].last_seen_ms);
+
+    ASSERT(sds_read_node_status(&g_sensor, "SensorData", "dev_b", &st, sizeof(st), NULL));
+    ASSERT_EQ(st.uptime_seconds, 7);
+}
+
+TEST(read_unknown_device_fails) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, 0), SDS_OK);
+
+    inject_sensor_status("dev_a", 1);
+
+    SensorDataStatus st;
+    ASSERT(!sds_read_node_status(&g_sensor, "SensorData", "dev_z", &st, sizeof(st), NULL));
+    ASSERT(!sds_read_node_status(&g_sensor, "Unknown", "dev_a", &st, sizeof(st), NULL));
+    ASSERT(!sds_read_node_status(NULL, "SensorData", "dev_a", &st, sizeof(st), NULL));
+    ASSERT(!sds_read_node_status(&g_sensor, "SensorData", NULL, &st, sizeof(st), NULL));
+}
+
+TEST(read_truncates_to_status_size) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, 0), SDS_OK);
+
+    inject_sensor_status("dev_a", 55);
+
+    uint8_t out[4] = { 0xEE, 0xEE, 0xEE, 0xEE };
+    ASSERT(sds_read_node_status(&g_sensor, "SensorData", "dev_a", out, 1, NULL));
+    ASSERT_EQ(out[0], 55);
+    ASSERT_EQ(out[1], 0xEE);
+
+    /* Header only */
+    SdsSnapshotRow node;
+    ASSERT(sds_read_node_status(&g_sensor, "SensorData", "dev_a", NULL, 0, &node));
+    ASSERT(strcmp(node.node_id, "dev_a") == 0);
+}
+
+TEST(read_reports_lwt_and_eviction) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, TEST_EVICTION_GRACE_MS), SDS_OK);
+
+    inject_sensor_status("dev_a", 3);
+    inject_lwt("dev_a");
+
+    SdsSnapshotRow node;
+    ASSERT(sds_read_node_status(&g_sensor, "SensorData", "dev_a", NULL, 0, &node));
+    ASSERT(!node.online);
+    ASSERT(node.eviction_pending);
+
+    sds_mock_advance_time(TEST_EVICTION_GRACE_MS + 10);
+    sds_loop();
+    ASSERT(!sds_read_node_status(&g_sensor, "SensorData", "dev_a", NULL, 0, &node));
+}
+
+/* ============== Counter Tests ============== */
+
+TEST(per_slot_counters_track_their_device) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, 0), SDS_OK);
+    ASSERT_EQ(sds_set_owner_slot_seqlocks("SensorData", g_seqlocks, SDS_GENERATED_MAX_NODES), SDS_OK);
+
+    inject_sensor_status("dev_a", 1);
+    inject_sensor_status("dev_b", 2);
+    uint32_t a = g_seqlocks[0];
+    uint32_t b = g_seqlocks[1];
+    ASSERT(a > 0 && a % 2 == 0);
+    ASSERT(b > 0 && b % 2 == 0);
+
+    inject_sensor_status("dev_a", 3);
+    ASSERT(g_seqlocks[0] > a);
+    ASSERT_EQ(g_seqlocks[0] % 2, 0);
+    ASSERT_EQ(g_seqlocks[1], b);
+
+    SensorDataStatus st;
+    ASSERT(sds_read_node_status(&g_sensor, "SensorData", "dev_a", &st, sizeof(st), NULL));
+    ASSERT_EQ(st.uptime_seconds, 3);
+}
+
+TEST(seqlocks_reject_bad_config) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, 0), SDS_OK);
+
+    ASSERT_EQ(sds_set_owner_slot_seqlocks("SensorData", g_seqlocks, 0), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_owner_slot_seqlocks("Unknown", g_seqlocks, 4), SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT_EQ(sds_set_owner_slot_seqlocks("SensorData", NULL, 0), SDS_OK);
+
+    /* Fewer counters than slots: the rest share the table counter */
+    ASSERT_EQ(sds_set_owner_slot_seqlocks("SensorData", g_seqlocks, 1), SDS_OK);
+    inject_sensor_status("dev_a", 1);
+    inject_sensor_status("dev_b", 2);
+    SensorDataStatus st;
+    ASSERT(sds_read_node_status(&g_sensor, "SensorData", "dev_b", &st, sizeof(st), NULL));
+    ASSERT_EQ(st.uptime_seconds, 2);
+}
+
+TEST(seqlocks_reject_device_table) {
+    ASSERT_EQ(init_node("device1", SDS_ROLE_DEVICE, 0), SDS_OK);
+
+    ASSERT_EQ(sds_set_owner_slot_seqlocks("SensorData", g_seqlocks, 4), SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT(!sds_read_node_status(&g_device, "SensorData", "dev_a", NULL, 0, NULL));
+}
+
+/* ============== Iteration Tests ============== */
+
+typedef struct {
+    uint32_t count;
+    uint32_t uptime_sum;
+    bool consistent;
+} CopyTally;
+
+static void tally_copy(const SdsSnapshotRow* node, const void* status, void* user_data) {
+    CopyTally* t = (CopyTally*)user_data;
+    const SensorDataStatus* st = (const SensorDataStatus*)status;
+    t->count++;
+    t->uptime_sum += st->uptime_seconds;
+    if (node->node_id[0] == '\0' || !status_consistent(st)) t->consistent = false;
+}
+
+TEST(foreach_copy_visits_every_device) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, 0), SDS_OK);
+
+    inject_sensor_status("dev_a", 10);
+    inject_sensor_status("dev_b", 20);
+    inject_sensor_status("dev_c", 30);
+
+    CopyTally t = { .consistent = true };
+    ASSERT_EQ(sds_foreach_node_copy(&g_sensor, "SensorData", tally_copy, &t), 3);
+    ASSERT_EQ(t.count, 3);
+    ASSERT_EQ(t.uptime_sum, 60);
+    ASSERT(t.consistent);
+
+    ASSERT_EQ(sds_foreach_node_copy(&g_sensor, "Unknown", tally_copy, &t), 0);
+    ASSERT_EQ(sds_foreach_node_copy(&g_sensor, "SensorData", NULL, &t), 0);
+}
+
+TEST(foreach_copy_reads_other_buffers) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, 0), SDS_OK);
+
+    inject_sensor_status("dev_a", 10);
+    inject_sensor_status("dev_b", 20);
+
+    static SensorDataOwnerTable copy;
+    memcpy(&copy, &g_sensor, sizeof(copy));
+    inject_sensor_status("dev_c", 30);
+
+    CopyTally t = { .consistent = true };
+    ASSERT_EQ(sds_foreach_node_copy(&copy, "SensorData", tally_copy, &t), 2);
+    ASSERT_EQ(t.uptime_sum, 30);
+
+    SensorDataStatus st;
+    ASSERT(sds_read_node_status(&copy, "SensorData", "dev_b", &st, sizeof(st), NULL));
+    ASSERT_EQ(st.uptime_seconds, 20);
+    ASSERT(!sds_read_node_status(&copy, "SensorData", "dev_c", &st, sizeof(st), NULL));
+}
+
+/* ============== Concurrency Tests ============== */
+
+#define RACE_ITERATIONS 20000
+#define RACE_DEVICES 4
+
+static atomic_bool g_race_done;
+static atomic_uint g_race_reads;
+static atomic_uint g_race_torn;
+
+static void* race_reader(void* arg) {
+    (void)arg;
+    char node_id[16];
+    uint32_t n = 0;
+    while (!atomic_load(&g_race_done)) {
+        snprintf(node_id, sizeof(node_id), "dev_%u", (unsigned)(n++ % RACE_DEVICES));
+        SensorDataStatus st;
+        SdsSnapshotRow node;
+        if (sds_read_node_status(&g_sensor, "SensorData", node_id, &st, sizeof(st), &node)) {
+            atomic_fetch_add(&g_race_reads, 1);
+            if (!status_consistent(&st) || strcmp(node.node_id, node_id) != 0) {
+                atomic_fetch_add(&g_race_torn, 1);
+            }
+        }
+
+        CopyTally t = { .consistent = true };
+        sds_foreach_node_copy(&g_sensor, "SensorData", tally_copy, &t);
+        if (!t.consistent) atomic_fetch_add(&g_race_torn, 1);
+    }
+    return NULL;
+}
+
+static bool run_race(void) {
+    char node_id[16];
+    for (uint32_t d = 0; d < RACE_DEVICES; d++) {
+        snprintf(node_id, sizeof(node_id), "dev_%u", (unsigned)d);
+        inject_sensor_status(node_id, d);
+    }
+
+    atomic_store(&g_race_done, false);
+    atomic_store(&g_race_reads, 0);
+    atomic_store(&g_race_torn, 0);
+
+    pthread_t reader;
+    pthread_create(&reader, NULL, race_reader, NULL);
+    for (uint32_t i = 0; i < RACE_ITERATIONS; i++) {
+        snprintf(node_id, sizeof(node_id), "dev_%u", (unsigned)(i % RACE_DEVICES));
+        inject_sensor_status(node_id, i * 7 + 3);
+    }
+    atomic_store(&g_race_done, true);
+    pthread_join(reader, NULL);
+
+    return atomic_load(&g_race_torn) == 0;
+}
+
+TEST(concurrent_reads_never_torn_table_counter) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, 0), SDS_OK);
+    ASSERT(run_race());
+}
+
+TEST(concurrent_reads_never_torn_slot_counters) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, 0), SDS_OK);
+    ASSERT_EQ(sds_set_owner_slot_seqlocks("SensorData", g_seqlocks, SDS_GENERATED_MAX_NODES), SDS_OK);
+    ASSERT(run_race());
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║          SDS Slot Seqlock Tests                              ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n");
+
+    printf("\n─── Single Reads ───\n");
+    RUN_TEST(read_copies_status_and_header);
+    RUN_TEST(read_unknown_device_fails);
+    RUN_TEST(read_truncates_to_status_size);
+    RUN_TEST(read_reports_lwt_and_eviction);
+
+    printf("\n─── Counters ───\n");
+    RUN_TEST(per_slot_counters_track_their_device);
+    RUN_TEST(seqlocks_reject_bad_config);
+    RUN_TEST(seqlocks_reject_device_table);
+
+    printf("\n─── Iteration ───\n");
+    RUN_TEST(foreach_copy_visits_every_device);
+    RUN_TEST(foreach_copy_reads_other_buffers);
+
+    printf("\n─── Concurrency ───\n");
+    RUN_TEST(concurrent_reads_never_torn_table_counter);
+    RUN_TEST(concurrent_reads_never_torn_slot_counters);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -0,0 +1,317 @@
+/*
+ * test_snapshot.c - Status Snapshot Tests
+ *
+ * Tests the owner-side bulk snapshot API with the mock platform:
+ * - Buffer sizing for row and column layouts
+ * - Row export: header fields and raw status struct per device
+ * - Column export: one contiguous array per field
+ * - Liveness flags after LWT
+ * - Argument and table checks
+ *
+ * Build:
+ *   gcc -I../include -o test_snapshot test_snapshot.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_snapshot
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+static SensorDataOwnerTable g_sensor;
+static SensorDataTable g_device;
+
+/* Large enough for either layout of SensorData */
+static uint8_t g_buffer[4096] __attribute__((aligned(8)));
+
+static SdsError init_node(const char* node_id, SdsRole role) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+    };
+
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_sensor, 0, sizeof(g_sensor));
+    memset(&g_device, 0, sizeof(g_device));
+    memset(g_buffer, 0xAA, sizeof(g_buffer));
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    if (role == SDS_ROLE_OWNER) {
+        return sds_register_table(&g_sensor, "SensorData", SDS_ROLE_OWNER, &opts);
+    }
+    return sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, &opts);
+}
+
+static void inject_sensor_status(const char* node, int battery, int uptime) {
+    char topic[64];
+    char payload[128];
+    snprintf(topic, sizeof(topic), "sds/SensorData/status/%s", node);
+    snprintf(payload, sizeof(payload),
+             "{\"ts\":1,\"online\":true,\"error_code\":%d,\"battery_percent\":%d,\"uptime_seconds\":%d}",
+             battery / 10, battery, uptime);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+static const SdsSnapshotRow* row_at(const SdsSnapshotInfo* info, uint32_t i) {
+    return (const SdsSnapshotRow*)(g_buffer + (size_t)i * info->row_size);
+}
+
+static const SensorDataStatus* row_status(const SdsSnapshotInfo* info, uint32_t i) {
+    return (const SensorDataStatus*)((const uint8_t*)row_at(info, i) + SDS_SNAPSHOT_STATUS_OFFSET);
+}
+
+/* ============== Sizing Tests ============== */
+
+TEST(size_covers_all_slots) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    size_t rows = sds_snapshot_size("SensorData", SDS_SNAPSHOT_ROWS);
+    size_t cols = sds_snapshot_size("SensorData", SDS_SNAPSHOT_COLUMNS);
+
+    ASSERT(rows >= SDS_GENERATED_MAX_NODES * (SDS_SNAPSHOT_STATUS_OFFSET + sizeof(SensorDataStatus)));
+    ASSERT(cols >= SDS_GENERATED_MAX_NODES *
+                   (SDS_MAX_NODE_ID_LEN + sizeof(uint32_t) + 2 * sizeof(bool) + 1 + 1 + 4));
+    ASSERT(rows <= sizeof(g_buffer));
+    ASSERT(cols <= sizeof(g_buffer));
+}
+
+TEST(size_zero_for_device_or_unknown_table) {
+    ASSERT_EQ(init_node("device1", SDS_ROLE_DEVICE), SDS_OK);
+
+    ASSERT_EQ(sds_snapshot_size("SensorData", SDS_SNAPSHOT_ROWS), 0);
+    ASSERT_EQ(sds_snapshot_size("Unknown", SDS_SNAPSHOT_COLUMNS), 0);
+    ASSERT_EQ(sds_snapshot_size(NULL, SDS_SNAPSHOT_ROWS), 0);
+}
+
+/* ============== Row Layout Tests ============== */
+
+TEST(rows_empty_table) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    SdsSnapshotInfo info = { .rows = 99 };
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, "SensorData", SDS_SNAPSHOT_ROWS,
+                                  g_buffer, sizeof(g_buffer), &info), SDS_OK);
+    ASSERT_EQ(info.rows, 0);
+    ASSERT(info.row_size >= SDS_SNAPSHOT_STATUS_OFFSET + sizeof(SensorDataStatus));
+    ASSERT_EQ(info.row_size % 8, 0);
+}
+
+TEST(rows_copy_header_and_status) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    inject_sensor_status("dev_b", 55, 200);
+
+    SdsSnapshotInfo info;
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, "SensorData", SDS_SNAPSHOT_ROWS,
+                                  g_buffer, sizeof(g_buffer), &info), SDS_OK);
+    ASSERT_EQ(info.rows, 2);
+
+    ASSERT(strcmp(row_at(&info, 0)->node_id, "dev_a") == 0);
+    ASSERT(row_at(&info, 0)->online);
+    ASSERT(!row_at(&info, 0)->eviction_pending);
+    ASSERT_EQ(row_status(&info, 0)->battery_percent, 80);
+    ASSERT_EQ(row_status(&info, 0)->error_code, 8);
+    ASSERT_EQ(row_status(&info, 0)->uptime_seconds, 100);
+
+    ASSERT(strcmp(row_at(&info, 1)->node_id, "dev_b") == 0);
+    ASSERT_EQ(row_status(&info, 1)->battery_percent, 55);
+    ASSERT_EQ(row_status(&info, 1)->uptime_seconds, 200);
+}
+
+TEST(rows_match_status_slots) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    sds_mock_advance_time(1234);
+    inject_sensor_status("dev_a", 42, 7);
+
+    SdsSnapshotInfo info;
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, "SensorData", SDS_SNAPSHOT_ROWS,
+                                  g_buffer, sizeof(g_buffer), &info), SDS_OK);
+    ASSERT_EQ(info.rows, 1);
+    ASSERT_EQ(row_at(&info, 0)->last_seen_ms, g_sensor.status_slots[0].last_seen_ms);
+    ASSERT(memcmp(row_status(&info, 0), &g_sensor.status_slots[0].status,
+                  sizeof(SensorDataStatus)) == 0);
+}
+
+TEST(rows_report_offline_after_lwt) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    sds_mock_inject_message_str("sds/lwt/dev_a", "{\"online\":false,\"node\":\"dev_a\",\"ts\":0}");
+
+    SdsSnapshotInfo info;
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, "SensorData", SDS_SNAPSHOT_ROWS,
+                                  g_buffer, sizeof(g_buffer), &info), SDS_OK);
+    ASSERT_EQ(info.rows, 1);
+    ASSERT(!row_at(&info, 0)->online);
+}
+
+/* ============== Column Layout Tests ============== */
+
+TEST(columns_hold_contiguous_arrays) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    inject_sensor_status("dev_b", 55, 200);
+    inject_sensor_status("dev_c", 30, 300);
+
+    SdsSnapshotInfo info;
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, "SensorData", SDS_SNAPSHOT_COLUMNS,
+                                  g_buffer, sizeof(g_buffer), &info), SDS_OK);
+    ASSERT_EQ(info.rows, 3);
+
+    const char* ids = sds_snapshot_column(g_buffer, "SensorData", SDS_SNAPSHOT_COL_NODE_ID);
+    const bool* online = sds_snapshot_column(g_buffer, "SensorData", SDS_SNAPSHOT_COL_ONLINE);
+    const uint8_t* battery = sds_snapshot_column(g_buffer, "SensorData", SDS_SNAPSHOT_COL_FIELDS + 1);
+    const uint32_t* uptime = sds_snapshot_column(g_buffer, "SensorData", SDS_SNAPSHOT_COL_FIELDS + 2);
+    ASSERT(ids && online && battery && uptime);
+
+    ASSERT(strcmp(ids, "dev_a") == 0);
+    ASSERT(strcmp(ids + 2 * SDS_MAX_NODE_ID_LEN, "dev_c") == 0);
+    ASSERT(online[0] && online[1] && online[2]);
+    ASSERT_EQ(battery[0], 80);
+    ASSERT_EQ(battery[1], 55);
+    ASSERT_EQ(battery[2], 30);
+    ASSERT_EQ(uptime[0], 100);
+    ASSERT_EQ(uptime[2], 300);
+}
+
+TEST(columns_are_aligned) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    for (uint16_t c = 0; c < SDS_SNAPSHOT_COL_FIELDS + SDS_SENSOR_DATA_STATUS_FIELD_COUNT; c++) {
+        const uint8_t* col = sds_snapshot_column(g_buffer, "SensorData", c);
+        ASSERT(col != NULL);
+        ASSERT_EQ((size_t)(col - g_buffer) % 8, 0);
+        ASSERT((size_t)(col - g_buffer) < sds_snapshot_size("SensorData", SDS_SNAPSHOT_COLUMNS));
+    }
+    ASSERT(sds_snapshot_column(g_buffer, "SensorData",
+                               SDS_SNAPSHOT_COL_FIELDS + SDS_SENSOR_DATA_STATUS_FIELD_COUNT) == NULL);
+}
+
+/* ============== Error Tests ============== */
+
+TEST(rejects_small_buffer) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    size_t need = sds_snapshot_size("SensorData", SDS_SNAPSHOT_ROWS);
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, "SensorData", SDS_SNAPSHOT_ROWS,
+                                  g_buffer, need - 1, NULL), SDS_ERR_BUFFER_FULL);
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, "SensorData", SDS_SNAPSHOT_ROWS,
+                                  g_buffer, need, NULL), SDS_OK);
+}
+
+TEST(rejects_bad_arguments) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    ASSERT_EQ(sds_snapshot_status(NULL, "SensorData", SDS_SNAPSHOT_ROWS,
+                                  g_buffer, sizeof(g_buffer), NULL), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, NULL, SDS_SNAPSHOT_ROWS,
+                                  g_buffer, sizeof(g_buffer), NULL), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, "SensorData", SDS_SNAPSHOT_ROWS,
+                                  NULL, sizeof(g_buffer), NULL), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_snapshot_status(&g_sensor, "Unknown", SDS_SNAPSHOT_ROWS,
+                                  g_buffer, sizeof(g_buffer), NULL), SDS_ERR_TABLE_NOT_FOUND);
+}
+
+TEST(rejects_device_table) {
+    ASSERT_EQ(init_node("device1", SDS_ROLE_DEVICE), SDS_OK);
+
+    ASSERT_EQ(sds_snapshot_status(&g_device, "SensorData", SDS_SNAPSHOT_ROWS,
+                                  g_buffer, sizeof(g_buffer), NULL), SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT(sds_snapshot_column(g_buffer, "SensorData", SDS_SNAPSHOT_COL_NODE_ID) == NULL);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║              Status Snapshot Tests (Mock Platform)           ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Sizing Tests ───\n");
+    RUN_TEST(size_covers_all_slots);
+    RUN_TEST(size_zero_for_device_or_unknown_table);
+
+    printf("\n─── Row Layout Tests ───\n");
+    RUN_TEST(rows_empty_table);
+    RUN_TEST(rows_copy_header_and_status);
+    RUN_TEST(rows_match_status_slots);
+    RUN_TEST(rows_report_offline_after_lwt);
+
+    printf("\n─── Column Layout Tests ───\n");
+    RUN_TEST(columns_hold_contiguous_arrays);
+    RUN_TEST(columns_are_aligned);
+
+    printf("\n─── Error Tests ───\n");
+    RUN_TEST(rejects_small_buffer);
+    RUN_TEST(rejects_bad_arguments);
+    RUN_TEST(rejects_device_table);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -0,0 +1,375 @@
+/*
+ * test_status_history.c - Status History Tests
+ *
+ * Tests the owner-side per-device status history with the mock platform:
+ * - Storage sizing and attach checks
+ * - Samples recorded per device, oldest first, ring wrap-around
+ * - Age filter on owner receive time
+ * - Column export: timestamps and one contiguous array per field
+ * - Rings kept across LWT, cleared when a slot is reused
+ *
+ * Build:
+ *   gcc -I../include -o test_status_history test_status_history.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_status_history
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* ============== Helper Functions ============== */
+
+#define HISTORY_DEPTH 4
+#define GRACE_MS 1000
+
+static SensorDataOwnerTable g_sensor;
+static SensorDataTable g_device;
+
+static uint32_t g_history[SDS_STATUS_HISTORY_BYTES(sizeof(SensorDataStatus),
+                                                   SDS_GENERATED_MAX_NODES, HISTORY_DEPTH) / 4];
+static uint8_t g_columns[256] __attribute__((aligned(8)));
+
+static SdsError init_node(const char* node_id, SdsRole role) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+    sds_mock_set_time(10000);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .eviction_grace_ms = GRACE_MS,
+    };
+
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_sensor, 0, sizeof(g_sensor));
+    memset(&g_device, 0, sizeof(g_device));
+    memset(g_history, 0xAA, sizeof(g_history));
+    memset(g_columns, 0xAA, sizeof(g_columns));
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000 };
+    if (role == SDS_ROLE_OWNER) {
+        return sds_register_table(&g_sensor, "SensorData", SDS_ROLE_OWNER, &opts);
+    }
+    return sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, &opts);
+}
+
+static SdsError init_owner_with_history(void) {
+    SdsError err = init_node("owner1", SDS_ROLE_OWNER);
+    if (err != SDS_OK) return err;
+    return sds_set_owner_status_history("SensorData", g_history, sizeof(g_history), HISTORY_DEPTH);
+}
+
+static void inject_sensor_status(const char* node, int battery, int uptime) {
+    char topic[64];
+    char payload[128];
+    snprintf(topic, sizeof(topic), "sds/SensorData/status/%s", node);
+    snprintf(payload, sizeof(payload),
+             "{\"ts\":1,\"online\":true,\"error_code\":%d,\"battery_percent\":%d,\"uptime_seconds\":%d}",
+             battery / 10, battery, uptime);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+typedef struct {
+    uint32_t count;
+    uint32_t timestamps[8];
+    uint32_t uptimes[8];
+} SampleLog;
+
+static void on_sample(uint32_t timestamp_ms, const void* status, void* user_data) {
+    SampleLog* log = (SampleLog*)user_data;
+    const SensorDataStatus* s = (const SensorDataStatus*)status;
+    if (log->count < 8) {
+        log->timestamps[log->count] = timestamp_ms;
+        log->uptimes[log->count] = s->uptime_seconds;
+    }
+    log->count++;
+}
+
+/* ============== Storage Tests ============== */
+
+TEST(size_matches_macro) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    ASSERT_EQ(sds_status_history_size("SensorData", HISTORY_DEPTH), sizeof(g_history));
+    ASSERT_EQ(sds_status_history_size("SensorData", 0), 0);
+    ASSERT_EQ(sds_status_history_size("Unknown", HISTORY_DEPTH), 0);
+}
+
+TEST(attach_checks_arguments) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    ASSERT_EQ(sds_set_owner_status_history("Unknown", g_history, sizeof(g_history), HISTORY_DEPTH),
+              SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT_EQ(sds_set_owner_status_history("SensorData", g_history, sizeof(g_history), 0),
+              SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_owner_status_history("SensorData", (uint8_t*)g_history + 1,
+                                           sizeof(g_history) - 4, 1), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_owner_status_history("SensorData", g_history, sizeof(g_history) - 1,
+                                           HISTORY_DEPTH), SDS_ERR_BUFFER_FULL);
+    ASSERT_EQ(sds_set_owner_status_history("SensorData", g_history, sizeof(g_history), HISTORY_DEPTH),
+              SDS_OK);
+    ASSERT_EQ(sds_set_owner_status_history("SensorData", NULL, 0, 0), SDS_OK);
+}
+
+TEST(attach_rejects_device_table) {
+    ASSERT_EQ(init_node("device1", SDS_ROLE_DEVICE), SDS_OK);
+
+    ASSERT_EQ(sds_status_history_size("SensorData", HISTORY_DEPTH), 0);
+    ASSERT_EQ(sds_set_owner_status_history("SensorData", g_history, sizeof(g_history), HISTORY_DEPTH),
+              SDS_ERR_TABLE_NOT_FOUND);
+}
+
+/* ============== Recording Tests ============== */
+
+TEST(records_samples_oldest_first) {
+    ASSERT_EQ(init_owner_with_history(), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    sds_mock_advance_time(500);
+    inject_sensor_status("dev_b", 55, 900);
+    inject_sensor_status("dev_a", 79, 101);
+
+    SampleLog log = {0};
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_a", 0, on_sample, &log), 2);
+    ASSERT_EQ(log.count, 2);
+    ASSERT_EQ(log.timestamps[0], 10000);
+    ASSERT_EQ(log.uptimes[0], 100);
+    ASSERT_EQ(log.timestamps[1], 10500);
+    ASSERT_EQ(log.uptimes[1], 101);
+
+    memset(&log, 0, sizeof(log));
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_b", 0, on_sample, &log), 1);
+    ASSERT_EQ(log.uptimes[0], 900);
+}
+
+TEST(ring_keeps_latest_depth_samples) {
+    ASSERT_EQ(init_owner_with_history(), SDS_OK);
+
+    for (int i = 0; i < HISTORY_DEPTH + 3; i++) {
+        inject_sensor_status("dev_a", 50, 100 + i);
+        sds_mock_advance_time(100);
+    }
+
+    SampleLog log = {0};
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_a", 0, on_sample, &log), HISTORY_DEPTH);
+    for (uint32_t i = 0; i < HISTORY_DEPTH; i++) {
+        ASSERT_EQ(log.uptimes[i], 103 + i);
+        ASSERT_EQ(log.timestamps[i], 10300 + 100 * i);
+    }
+}
+
+TEST(max_age_filters_old_samples) {
+    ASSERT_EQ(init_owner_with_history(), SDS_OK);
+
+    inject_sensor_status("dev_a", 50, 1);
+    sds_mock_advance_time(1000);
+    inject_sensor_status("dev_a", 50, 2);
+    sds_mock_advance_time(1000);
+    inject_sensor_status("dev_a", 50, 3);
+
+    SampleLog log = {0};
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_a", 1000, on_sample, &log), 2);
+    ASSERT_EQ(log.uptimes[0], 2);
+    ASSERT_EQ(log.uptimes[1], 3);
+
+    sds_mock_advance_time(5000);
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_a", 1000, on_sample, &log), 0);
+}
+
+TEST(no_samples_without_history) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+
+    SampleLog log = {0};
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_a", 0, on_sample, &log), 0);
+    ASSERT_EQ(g_sensor.status_count, 1);
+    ASSERT_EQ(sds_status_history_columns_size("SensorData"), 0);
+}
+
+TEST(unknown_device_has_no_samples) {
+    ASSERT_EQ(init_owner_with_history(), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+
+    SampleLog log = {0};
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_x", 0, on_sample, &log), 0);
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", NULL, 0, on_sample, &log), 0);
+    ASSERT_EQ(log.count, 0);
+}
+
+/* ============== Lifecycle Tests ============== */
+
+TEST(history_kept_after_lwt) {
+    ASSERT_EQ(init_owner_with_history(), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    sds_mock_inject_message_str("sds/lwt/dev_a", "{\"online\":false,\"node\":\"dev_a\",\"ts\":0}");
+
+    SampleLog log = {0};
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_a", 0, on_sample, &log), 1);
+    ASSERT_EQ(log.uptimes[0], 100);
+}
+
+TEST(reused_slot_starts_empty_ring) {
+    ASSERT_EQ(init_owner_with_history(), SDS_OK);
+
+    inject_sensor_status("dev_a", 80, 100);
+    inject_sensor_status("dev_a", 80, 101);
+    sds_mock_inject_message_str("sds/lwt/dev_a", "{\"online\":false,\"node\":\"dev_a\",\"ts\":0}");
+    sds_mock_advance_time(GRACE_MS + 10);
+    sds_loop();
+    ASSERT_EQ(g_sensor.status_count, 0);
+
+    /* dev_b takes dev_a's slot */
+    inject_sensor_status("dev_b", 40, 7);
+    ASSERT(strcmp(g_sensor.status_slots[0].node_id, "dev_b") == 0);
+
+    SampleLog log = {0};
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_b", 0, on_sample, &log), 1);
+    ASSERT_EQ(log.uptimes[0], 7);
+    ASSERT_EQ(sds_foreach_status_sample("SensorData", "dev_a", 0, on_sample, &log), 0);
+}
+
+/* ============== Column Tests ============== */
+
+TEST(columns_hold_contiguous_arrays) {
+    ASSERT_EQ(init_owner_with_history(), SDS_OK);
+
+    size_t need = sds_status_history_columns_size("SensorData");
+    ASSERT(need >= HISTORY_DEPTH * (sizeof(uint32_t) + 1 + 1 + 4));
+    ASSERT(need <= sizeof(g_columns));
+
+    inject_sensor_status("dev_a", 80, 100);
+    sds_mock_advance_time(250);
+    inject_sensor_status("dev_a", 70, 200);
+
+    uint32_t count = 99;
+    ASSERT_EQ(sds_status_history_columns("SensorData", "dev_a", 0, g_columns, need, &count), SDS_OK);
+    ASSERT_EQ(count, 2);
+
+    const uint32_t* ts = sds_status_history_column(g_columns, "SensorData", SDS_HISTORY_COL_TIMESTAMP);
+    const uint8_t* battery = sds_status_history_column(g_columns, "SensorData", SDS_HISTORY_COL_FIELDS + 1);
+    const uint32_t* uptime = sds_status_history_column(g_columns, "SensorData", SDS_HISTORY_COL_FIELDS + 2);
+    ASSERT(ts && battery && uptime);
+    ASSERT_EQ((size_t)((const uint8_t*)uptime - g_columns) % 8, 0);
+
+    ASSERT_EQ(ts[0], 10000);
+    ASSERT_EQ(ts[1], 10250);
+    ASSERT_EQ(battery[0], 80);
+    ASSERT_EQ(battery[1], 70);
+    ASSERT_EQ(uptime[0], 100);
+    ASSERT_EQ(uptime[1], 200);
+    ASSERT(sds_status_history_column(g_columns, "SensorData",
+                                     SDS_HISTORY_COL_FIELDS + SDS_SENSOR_DATA_STATUS_FIELD_COUNT) == NULL);
+}
+
+TEST(columns_check_arguments) {
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER), SDS_OK);
+
+    uint32_t count = 99;
+    ASSERT_EQ(sds_status_history_columns("SensorData", "dev_a", 0, g_columns, sizeof(g_columns), &count),
+              SDS_ERR_INVALID_TABLE);
+    ASSERT_EQ(sds_status_history_columns("Unknown", "dev_a", 0, g_columns, sizeof(g_columns), &count),
+              SDS_ERR_TABLE_NOT_FOUND);
+    ASSERT_EQ(sds_status_history_columns("SensorData", NULL, 0, g_columns, sizeof(g_columns), &count),
+              SDS_ERR_INVALID_CONFIG);
+
+    ASSERT_EQ(sds_set_owner_status_history("SensorData", g_history, sizeof(g_history), HISTORY_DEPTH),
+              SDS_OK);
+    size_t need = sds_status_history_columns_size("SensorData");
+    ASSERT_EQ(sds_status_history_columns("SensorData", "dev_a", 0, g_columns, need - 1, &count),
+              SDS_ERR_BUFFER_FULL);
+    ASSERT_EQ(sds_status_history_columns("SensorData", "dev_a", 0, g_columns, need, &count), SDS_OK);
+    ASSERT_EQ(count, 0);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║              Status History Tests (Mock Platform)            ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Storage Tests ───\n");
+    RUN_TEST(size_matches_macro);
+    RUN_TEST(attach_checks_arguments);
+    RUN_TEST(attach_rejects_device_table);
+
+    printf("\n─── Recording Tests ───\n");
+    RUN_TEST(records_samples_oldest_first);
+    RUN_TEST(ring_keeps_latest_depth_samples);
+    RUN_TEST(max_age_filters_old_samples);
+    RUN_TEST(no_samples_without_history);
+    RUN_TEST(unknown_device_has_no_samples);
+
+    printf("\n─── Lifecycle Tests ───\n");
+    RUN_TEST(history_kept_after_lwt);
+    RUN_TEST(reused_slot_starts_empty_ring);
+
+    printf("\n─── Column Tests ───\n");
+    RUN_TEST(columns_hold_contiguous_arrays);
+    RUN_TEST(columns_check_arguments);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
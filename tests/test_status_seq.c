@@ -0,0 +1,457 @@
+/*
+ * test_status_seq.c - Status Sequence Tests
+ *
+ * Tests sequence-numbered status deltas with the mock platform:
+ * - Devices send a keyframe first, then numbered deltas and field-less pings
+ * - Periodic keyframes every keyframe_interval status messages
+ * - Owners follow the sequence per slot and request a resync on a gap
+ * - Devices answer a resync request with a keyframe
+ * - JSON and binary wire formats
+ *
+ * Build:
+ *   gcc -I../include -o test_status_seq test_status_seq.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_status_seq
+ */
+
+#include "sds.h"
+#include "sds_types.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_STR_CONTAINS(haystack, needle) ASSERT(strstr((haystack), (needle)) != NULL)
+#define ASSERT_STR_NOT_CONTAINS(haystack, needle) ASSERT(strstr((haystack), (needle)) == NULL)
+
+/* ============== Helper Functions ============== */
+
+#define STATUS_TOPIC "sds/SensorData/status/dev1"
+#define RESYNC_TOPIC "sds/SensorData/resync/dev1"
+
+static SensorDataOwnerTable g_sensor;
+static SensorDataTable g_device;
+
+typedef struct {
+    uint8_t payload[SDS_MOCK_MAX_PAYLOAD_LEN];
+    size_t len;
+} Captured;
+
+static SdsError init_node(const char* node_id, SdsRole role, bool delta_sync,
+                          uint16_t keyframe_interval, SdsWireFormat wire) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+    sds_mock_set_time(10000);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_delta_sync = delta_sync,
+        .keyframe_interval = keyframe_interval,
+    };
+
+    SdsError err = sds_init(&config);
+    if (err != SDS_OK) return err;
+
+    memset(&g_sensor, 0, sizeof(g_sensor));
+    memset(&g_device, 0, sizeof(g_device));
+
+    SdsTableOptions opts = { .sync_interval_ms = 1000, .wire_format = wire };
+    if (role == SDS_ROLE_OWNER) {
+        return sds_register_table(&g_sensor, "SensorData", SDS_ROLE_OWNER, &opts);
+    }
+    return sds_register_table(&g_device, "SensorData", SDS_ROLE_DEVICE, &opts);
+}
+
+static SdsError init_device(bool delta_sync, uint16_t keyframe_interval) {
+    return init_node("dev1", SDS_ROLE_DEVICE, delta_sync, keyframe_interval, SDS_WIRE_JSON);
+}
+
+static SdsError init_owner(void) {
+    return init_node("owner1", SDS_ROLE_OWNER, true, 0, SDS_WIRE_JSON);
+}
+
+/* Run one sync interval and return the device's status message, if one went out */
+static const char* next_status(void) {
+    sds_mock_clear_publishes();
+    sds_mock_advance_time(1000);
+    sds_loop();
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(STATUS_TOPIC);
+    return msg ? (const char*)msg->payload : NULL;
+}
+
+static bool capture_status(Captured* out) {
+    sds_mock_clear_publishes();
+    sds_mock_advance_time(1000);
+    sds_loop();
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(STATUS_TOPIC);
+    if (!msg) return false;
+    memcpy(out->payload, msg->payload, msg->payload_len);
+    out->len = msg->payload_len;
+    return true;
+}
+
+static void inject_status(const char* seq_field, int battery) {
+    char payload[160];
+    if (battery >= 0) {
+        snprintf(payload, sizeof(payload),
+                 "{\"ts\":1,\"online\":true,%s,\"battery_percent\":%d}", seq_field, battery);
+    } else {
+        snprintf(payload, sizeof(payload), "{\"ts\":1,\"online\":true,%s}", seq_field);
+    }
+    sds_mock_inject_message_str(STATUS_TOPIC, payload);
+}
+
+static size_t count_publishes(const char* topic) {
+    size_t count = 0;
+    for (size_t i = 0; i < sds_mock_get_publish_count(); i++) {
+        const SdsMockPublishedMessage* msg = sds_mock_get_publish(i);
+        if (msg && strcmp(msg->topic, topic) == 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Publish the owner's queued resync requests */
+static size_t flush_resync_requests(void) {
+    sds_mock_clear_publishes();
+    sds_loop();
+    return count_publishes(RESYNC_TOPIC);
+}
+
+/* ============== Device Tests ============== */
+
+TEST(first_status_is_keyframe) {
+    ASSERT_EQ(init_device(true, 0), SDS_OK);
+    g_device.status.battery_percent = 80;
+
+    const char* payload = next_status();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"kf\":1");
+    ASSERT_STR_CONTAINS(payload, "\"error_code\"");
+    ASSERT_STR_CONTAINS(payload, "\"uptime_seconds\"");
+}
+
+TEST(changes_send_numbered_deltas) {
+    ASSERT_EQ(init_device(true, 0), SDS_OK);
+    g_device.status.battery_percent = 80;
+    ASSERT(next_status() != NULL);
+
+    g_device.status.battery_percent = 70;
+    const char* payload = next_status();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"sq\":2");
+    ASSERT_STR_CONTAINS(payload, "\"battery_percent\":70");
+    ASSERT_STR_NOT_CONTAINS(payload, "uptime_seconds");
+
+    g_device.status.uptime_seconds = 5;
+    payload = next_status();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"sq\":3");
+}
+
+TEST(idle_heartbeat_is_a_ping) {
+    ASSERT_EQ(init_device(true, 0), SDS_OK);
+    g_device.status.battery_percent = 80;
+    ASSERT(next_status() != NULL);
+
+    /* Nothing until the liveness interval, then a heartbeat without fields */
+    ASSERT(next_status() == NULL);
+    ASSERT(next_status() == NULL);
+    const char* payload = next_status();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"online\":true");
+    ASSERT_STR_CONTAINS(payload, "\"hb\":1");
+    ASSERT_STR_NOT_CONTAINS(payload, "battery_percent");
+    ASSERT_STR_NOT_CONTAINS(payload, "error_code");
+}
+
+TEST(keyframe_interval_sends_full_status) {
+    ASSERT_EQ(init_device(true, 3), SDS_OK);
+    g_device.status.battery_percent = 80;
+    ASSERT(next_status() != NULL);
+
+    g_device.status.battery_percent = 70;
+    ASSERT_STR_CONTAINS(next_status(), "\"sq\":2");
+    g_device.status.battery_percent = 60;
+    ASSERT_STR_CONTAINS(next_status(), "\"sq\":3");
+
+    g_device.status.battery_percent = 50;
+    const char* payload = next_status();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"kf\":4");
+    ASSERT_STR_CONTAINS(payload, "\"uptime_seconds\"");
+}
+
+TEST(unsequenced_without_delta_sync) {
+    ASSERT_EQ(init_device(false, 0), SDS_OK);
+    ASSERT(!sds_mock_is_subscribed(RESYNC_TOPIC));
+    g_device.status.battery_percent = 80;
+
+    const char* payload = next_status();
+    ASSERT(payload != NULL);
+    ASSERT_STR_NOT_CONTAINS(payload, "\"kf\"");
+    ASSERT_STR_NOT_CONTAINS(payload, "\"sq\"");
+
+    /* Heartbeats stay full */
+    next_status();
+    next_status();
+    payload = next_status();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"battery_percent\":80");
+    ASSERT_STR_NOT_CONTAINS(payload, "\"hb\"");
+}
+
+TEST(resync_request_answered_with_keyframe) {
+    ASSERT_EQ(init_device(true, 0), SDS_OK);
+    ASSERT(sds_mock_is_subscribed(RESYNC_TOPIC));
+    g_device.status.battery_percent = 80;
+    ASSERT(next_status() != NULL);
+    g_device.status.battery_percent = 70;
+    ASSERT(next_status() != NULL);
+
+    sds_mock_inject_message_str(RESYNC_TOPIC, "{\"ts\":1,\"from\":\"owner1\"}");
+
+    const char* payload = next_status();
+    ASSERT(payload != NULL);
+    ASSERT_STR_CONTAINS(payload, "\"kf\":3");
+    ASSERT_STR_CONTAINS(payload, "\"battery_percent\":70");
+    ASSERT_STR_CONTAINS(payload, "\"uptime_seconds\"");
+    ASSERT_EQ(sds_get_stats()->resync_keyframes, 1);
+
+    /* Answered once */
+    ASSERT(next_status() == NULL);
+}
+
+TEST(resync_for_other_node_ignored) {
+    ASSERT_EQ(init_device(true, 0), SDS_OK);
+    g_device.status.battery_percent = 80;
+    ASSERT(next_status() != NULL);
+
+    sds_mock_inject_message_str("sds/SensorData/resync/dev2", "{\"ts\":1,\"from\":\"owner1\"}");
+
+    ASSERT(next_status() == NULL);
+    ASSERT_EQ(sds_get_stats()->resync_keyframes, 0);
+}
+
+/* ============== Owner Tests ============== */
+
+TEST(owner_follows_in_order_stream) {
+    ASSERT_EQ(init_owner(), SDS_OK);
+
+    inject_status("\"kf\":1", 80);
+    inject_status("\"sq\":2", 70);
+    inject_status("\"hb\":2", -1);
+    inject_status("\"sq\":3", 60);
+
+    ASSERT_EQ(flush_resync_requests(), 0);
+    ASSERT_EQ(sds_get_stats()->seq_gaps, 0);
+    ASSERT_EQ(g_sensor.status_slots[0].status_seq, 3);
+    ASSERT_EQ(g_sensor.status_slots[0].status.battery_percent, 60);
+}
+
+TEST(owner_requests_resync_on_gap) {
+    ASSERT_EQ(init_owner(), SDS_OK);
+
+    inject_status("\"kf\":1", 80);
+    inject_status("\"sq\":3", 50);
+
+    /* The delta still applies; the owner asks for the rest */
+    ASSERT_EQ(g_sensor.status_slots[0].status.battery_percent, 50);
+    ASSERT_EQ(sds_get_stats()->seq_gaps, 1);
+    ASSERT_EQ(flush_resync_requests(), 1);
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(RESYNC_TOPIC);
+    ASSERT(!msg->retained);
+    ASSERT_STR_CONTAINS((const char*)msg->payload, "\"from\":\"owner1\"");
+
+    /* The keyframe restores the stream */
+    inject_status("\"kf\":4", 50);
+    inject_status("\"sq\":5", 40);
+    ASSERT_EQ(flush_resync_requests(), 0);
+    ASSERT_EQ(g_sensor.status_slots[0].status_seq, 5);
+}
+
+TEST(owner_detects_gap_from_ping) {
+    ASSERT_EQ(init_owner(), SDS_OK);
+
+    inject_status("\"kf\":1", 80);
+    inject_status("\"hb\":2", -1);   /* Delta 2 never arrived */
+
+    ASSERT_EQ(sds_get_stats()->seq_gaps, 1);
+    ASSERT_EQ(flush_resync_requests(), 1);
+}
+
+TEST(owner_asks_unknown_stream_for_keyframe) {
+    ASSERT_EQ(init_owner(), SDS_OK);
+
+    /* Owner started mid-stream: not a gap, but the slot needs a keyframe */
+    inject_status("\"sq\":7", 80);
+    inject_status("\"sq\":8", 70);
+    ASSERT_EQ(sds_get_stats()->seq_gaps, 0);
+    ASSERT_EQ(flush_resync_requests(), 1);  /* One request for both */
+
+    inject_status("\"kf\":9", 70);
+    inject_status("\"sq\":10", 60);
+    ASSERT_EQ(flush_resync_requests(), 0);
+}
+
+TEST(unsequenced_status_never_requests) {
+    ASSERT_EQ(init_owner(), SDS_OK);
+
+    sds_mock_inject_message_str(STATUS_TOPIC, "{\"ts\":1,\"online\":true,\"battery_percent\":80}");
+    sds_mock_inject_message_str(STATUS_TOPIC, "{\"ts\":2,\"online\":true,\"battery_percent\":70}");
+
+    ASSERT_EQ(flush_resync_requests(), 0);
+    ASSERT_EQ(g_sensor.status_slots[0].status_seq, 0);
+}
+
+TEST(gap_detection_off_without_seq_offset) {
+    ASSERT_EQ(init_owner(), SDS_OK);
+    sds_set_owner_seq_offset("SensorData", 0);
+
+    inject_status("\"kf\":1", 80);
+    inject_status("\"sq\":3", 50);
+
+    ASSERT_EQ(sds_get_stats()->seq_gaps, 0);
+    ASSERT_EQ(flush_resync_requests(), 0);
+    ASSERT_EQ(g_sensor.status_slots[0].status.battery_percent, 50);
+}
+
+/* ============== End-to-End Tests ============== */
+
+TEST(lost_binary_delta_detected) {
+    Captured keyframe, lost, delta, ping;
+
+    ASSERT_EQ(init_node("dev1", SDS_ROLE_DEVICE, true, 0, SDS_WIRE_BINARY), SDS_OK);
+    g_device.status.battery_percent = 80;
+    ASSERT(capture_status(&keyframe));
+    g_device.status.battery_percent = 70;
+    ASSERT(capture_status(&lost));
+    g_device.status.uptime_seconds = 42;
+    ASSERT(capture_status(&delta));
+    ASSERT(!capture_status(&ping));
+    ASSERT(!capture_status(&ping));
+    ASSERT(capture_status(&ping));
+    sds_shutdown();
+
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, 0, SDS_WIRE_BINARY), SDS_OK);
+    sds_mock_inject_message(STATUS_TOPIC, keyframe.payload, keyframe.len);
+    sds_mock_inject_message(STATUS_TOPIC, delta.payload, delta.len);
+
+    ASSERT_EQ(g_sensor.status_slots[0].status.battery_percent, 80);
+    ASSERT_EQ(g_sensor.status_slots[0].status.uptime_seconds, 42);
+    ASSERT_EQ(sds_get_stats()->seq_gaps, 1);
+    ASSERT_EQ(flush_resync_requests(), 1);
+}
+
+TEST(binary_stream_in_order) {
+    Captured msgs[4];
+
+    ASSERT_EQ(init_node("dev1", SDS_ROLE_DEVICE, true, 0, SDS_WIRE_BINARY), SDS_OK);
+    g_device.status.battery_percent = 80;
+    ASSERT(capture_status(&msgs[0]));
+    g_device.status.battery_percent = 70;
+    ASSERT(capture_status(&msgs[1]));
+    ASSERT(!capture_status(&msgs[2]));
+    ASSERT(!capture_status(&msgs[2]));
+    ASSERT(capture_status(&msgs[2]));   /* Ping */
+    g_device.status.error_code = 3;
+    ASSERT(capture_status(&msgs[3]));
+    sds_shutdown();
+
+    ASSERT_EQ(init_node("owner1", SDS_ROLE_OWNER, true, 0, SDS_WIRE_BINARY), SDS_OK);
+    for (int i = 0; i < 4; i++) {
+        sds_mock_inject_message(STATUS_TOPIC, msgs[i].payload, msgs[i].len);
+    }
+
+    ASSERT_EQ(sds_get_stats()->seq_gaps, 0);
+    ASSERT_EQ(flush_resync_requests(), 0);
+    ASSERT_EQ(g_sensor.status_slots[0].status_seq, 3);
+    ASSERT_EQ(g_sensor.status_slots[0].status.battery_percent, 70);
+    ASSERT_EQ(g_sensor.status_slots[0].status.error_code, 3);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║              SDS Status Sequence Tests                       ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n");
+
+    printf("\n─── Device ───\n");
+    RUN_TEST(first_status_is_keyframe);
+    RUN_TEST(changes_send_numbered_deltas);
+    RUN_TEST(idle_heartbeat_is_a_ping);
+    RUN_TEST(keyframe_interval_sends_full_status);
+    RUN_TEST(unsequenced_without_delta_sync);
+    RUN_TEST(resync_request_answered_with_keyframe);
+    RUN_TEST(resync_for_other_node_ignored);
+
+    printf("\n─── Owner ───\n");
+    RUN_TEST(owner_follows_in_order_stream);
+    RUN_TEST(owner_requests_resync_on_gap);
+    RUN_TEST(owner_detects_gap_from_ping);
+    RUN_TEST(owner_asks_unknown_stream_for_keyframe);
+    RUN_TEST(unsequenced_status_never_requests);
+    RUN_TEST(gap_detection_off_without_seq_offset);
+
+    printf("\n─── End to End ───\n");
+    RUN_TEST(lost_binary_delta_detected);
+    RUN_TEST(binary_stream_in_order);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}
@@ -470,7 +470,7 @@ TEST(device_publishes_state_on_change) {
     const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/TestTable/state");
     ASSERT(msg != NULL);
     ASSERT_STR_CONTAINS((char*)msg->payload, "temperature");
-    ASSERT_STR_CONTAINS((char*)msg->payload, "25.0");
+    ASSERT_STR_CONTAINS((char*)msg->payload, "\"temperature\":25");
 }
 
 TEST(device_publishes_status_on_change) {
@@ -946,6 +946,8 @@ TEST(handles_wrong_topic_prefix) {
     
     /* Message should still be counted but ignored */
     /* (or not, depending on implementation) */
+    ASSERT(stats->messages_received >= initial);
+    ASSERT_EQ(table.config.mode, 0);
 }
 
 TEST(handles_unknown_table) {
@@ -1279,6 +1281,739 @@ TEST(eviction_disabled_when_grace_zero) {
     ASSERT_EQ(table.status_count, 1);
 }
 
+/* ============================================================================
+ * STATUS SLOT INDEX TESTS
+ * ============================================================================ */
+
+#define INDEX_TEST_MAX_NODES 180  /* Fits the built-in index */
+
+typedef struct {
+    TestConfig config;
+    TestState state;
+    TestStatusSlot status_slots[INDEX_TEST_MAX_NODES];
+    uint8_t status_count;
+} IndexTestOwnerTable;
+
+static IndexTestOwnerTable g_index_table;
+
+static SdsError register_index_owner_table(IndexTestOwnerTable* table, const char* type) {
+    SdsError err = sds_register_table_ex(
+        table, type, SDS_ROLE_OWNER, NULL,
+        offsetof(IndexTestOwnerTable, config), sizeof(TestConfig),
+        offsetof(IndexTestOwnerTable, state), sizeof(TestState),
+        0, 0,
+        serialize_test_config, NULL,
+        NULL, deserialize_test_state,
+        NULL, deserialize_test_status
+    );
+    
+    if (err == SDS_OK) {
+        sds_set_owner_status_slots(
+            type,
+            offsetof(IndexTestOwnerTable, status_slots),
+            sizeof(TestStatusSlot),
+            offsetof(TestStatusSlot, status),
+            offsetof(IndexTestOwnerTable, status_count),
+            INDEX_TEST_MAX_NODES
+        );
+        sds_set_owner_slot_offsets(
+            type,
+            offsetof(TestStatusSlot, valid),
+            offsetof(TestStatusSlot, online),
+            offsetof(TestStatusSlot, last_seen_ms)
+        );
+        sds_set_owner_eviction_offsets(
+            type,
+            offsetof(TestStatusSlot, eviction_pending),
+            offsetof(TestStatusSlot, eviction_deadline)
+        );
+    }
+    
+    return err;
+}
+
+static void inject_index_status(const char* node, int battery) {
+    char topic[64];
+    char payload[96];
+    snprintf(topic, sizeof(topic), "sds/IndexTable/status/%s", node);
+    snprintf(payload, sizeof(payload), "{\"online\":true,\"error_code\":0,\"battery_level\":%d}", battery);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+TEST(slot_index_many_devices_lookup) {
+    init_sds_with_mock("owner_node");
+    memset(&g_index_table, 0, sizeof(g_index_table));
+    ASSERT_EQ(register_index_owner_table(&g_index_table, "IndexTable"), SDS_OK);
+    
+    char node[16];
+    for (int i = 0; i < INDEX_TEST_MAX_NODES; i++) {
+        snprintf(node, sizeof(node), "dev%d", i);
+        inject_index_status(node, i % 100);
+    }
+    ASSERT_EQ(g_index_table.status_count, INDEX_TEST_MAX_NODES);
+    
+    /* Repeat messages land in the same slot */
+    inject_index_status("dev7", 55);
+    ASSERT_EQ(g_index_table.status_count, INDEX_TEST_MAX_NODES);
+    
+    for (int i = 0; i < INDEX_TEST_MAX_NODES; i++) {
+        snprintf(node, sizeof(node), "dev%d", i);
+        const TestStatus* st = (const TestStatus*)sds_find_node_status(&g_index_table, "IndexTable", node);
+        ASSERT(st != NULL);
+        ASSERT_EQ(st->battery_level, (i == 7) ? 55 : i % 100);
+        ASSERT(sds_is_device_online(&g_index_table, "IndexTable", node, 1000));
+    }
+    ASSERT(sds_find_node_status(&g_index_table, "IndexTable", "dev180") == NULL);
+}
+
+TEST(slot_index_consistent_after_eviction) {
+    init_sds_with_mock_eviction("owner_node", TEST_EVICTION_GRACE_MS);
+    memset(&g_index_table, 0, sizeof(g_index_table));
+    ASSERT_EQ(register_index_owner_table(&g_index_table, "IndexTable"), SDS_OK);
+    
+    char node[16];
+    char topic[64];
+    for (int i = 0; i < 100; i++) {
+        snprintf(node, sizeof(node), "dev%d", i);
+        inject_index_status(node, 1);
+    }
+    
+    /* Every third device goes offline and is evicted */
+    for (int i = 0; i < 100; i += 3) {
+        snprintf(topic, sizeof(topic), "sds/lwt/dev%d", i);
+        sds_mock_inject_message_str(topic, "{\"online\":false,\"ts\":0}");
+    }
+    sds_mock_advance_time(TEST_EVICTION_GRACE_MS + 10);
+    sds_loop();
+    ASSERT_EQ(g_index_table.status_count, 100 - 34);
+    
+    /* Survivors are still found, evicted devices are gone */
+    for (int i = 0; i < 100; i++) {
+        snprintf(node, sizeof(node), "dev%d", i);
+        const void* st = sds_find_node_status(&g_index_table, "IndexTable", node);
+        ASSERT((i % 3 == 0) ? st == NULL : st != NULL);
+    }
+    
+    /* Evicted devices reconnect into fresh slots without duplicates */
+    for (int i = 0; i < 100; i += 3) {
+        snprintf(node, sizeof(node), "dev%d", i);
+        inject_index_status(node, 2);
+    }
+    ASSERT_EQ(g_index_table.status_count, 100);
+    
+    int found = 0;
+    for (int i = 0; i < INDEX_TEST_MAX_NODES; i++) {
+        if (g_index_table.status_slots[i].valid &&
+            strcmp(g_index_table.status_slots[i].node_id, "dev0") == 0) {
+            found++;
+        }
+    }
+    ASSERT_EQ(found, 1);
+    
+    const TestStatus* st = (const TestStatus*)sds_find_node_status(&g_index_table, "IndexTable", "dev99");
+    ASSERT(st != NULL);
+    ASSERT_EQ(st->battery_level, 2);
+}
+
+TEST(slot_index_reuses_lowest_free_slot) {
+    init_sds_with_mock_eviction("owner_node", TEST_EVICTION_GRACE_MS);
+    memset(&g_index_table, 0, sizeof(g_index_table));
+    ASSERT_EQ(register_index_owner_table(&g_index_table, "IndexTable"), SDS_OK);
+    
+    char node[16];
+    for (int i = 0; i < INDEX_TEST_MAX_NODES; i++) {
+        snprintf(node, sizeof(node), "dev%d", i);
+        inject_index_status(node, 1);
+    }
+    inject_index_status("late0", 1);
+    ASSERT_EQ(g_index_table.status_count, INDEX_TEST_MAX_NODES);
+    ASSERT(sds_find_node_status(&g_index_table, "IndexTable", "late0") == NULL);
+    
+    sds_mock_inject_message_str("sds/lwt/dev120", "{\"online\":false,\"ts\":0}");
+    sds_mock_inject_message_str("sds/lwt/dev50", "{\"online\":false,\"ts\":0}");
+    sds_mock_advance_time(TEST_EVICTION_GRACE_MS + 10);
+    sds_loop();
+    ASSERT_EQ(g_index_table.status_count, INDEX_TEST_MAX_NODES - 2);
+    
+    /* Freed slots are taken lowest first, then the table is full again */
+    inject_index_status("late1", 1);
+    inject_index_status("late2", 1);
+    inject_index_status("late3", 1);
+    ASSERT(strcmp(g_index_table.status_slots[50].node_id, "late1") == 0);
+    ASSERT(strcmp(g_index_table.status_slots[120].node_id, "late2") == 0);
+    ASSERT(sds_find_node_status(&g_index_table, "IndexTable", "late3") == NULL);
+    ASSERT_EQ(g_index_table.status_count, INDEX_TEST_MAX_NODES);
+}
+
+TEST(slot_index_lwt_marks_offline) {
+    init_sds_with_mock("owner_node");
+    memset(&g_index_table, 0, sizeof(g_index_table));
+    ASSERT_EQ(register_index_owner_table(&g_index_table, "IndexTable"), SDS_OK);
+    
+    inject_index_status("alpha", 10);
+    inject_index_status("beta", 20);
+    
+    sds_mock_inject_message_str("sds/lwt/beta", "{\"online\":false,\"ts\":0}");
+    ASSERT(sds_is_device_online(&g_index_table, "IndexTable", "alpha", 1000));
+    ASSERT(!sds_is_device_online(&g_index_table, "IndexTable", "beta", 1000));
+    
+    /* Coming back online reuses the indexed slot */
+    inject_index_status("beta", 30);
+    ASSERT_EQ(g_index_table.status_count, 2);
+    ASSERT(sds_is_device_online(&g_index_table, "IndexTable", "beta", 1000));
+}
+
+TEST(slot_index_rebuilt_on_reconnect) {
+    init_sds_with_mock("owner_node");
+    memset(&g_index_table, 0, sizeof(g_index_table));
+    ASSERT_EQ(register_index_owner_table(&g_index_table, "IndexTable"), SDS_OK);
+    
+    inject_index_status("alpha", 10);
+    
+    /* Application restores a slot directly while disconnected */
+    TestStatusSlot* slot = &g_index_table.status_slots[5];
+    strcpy(slot->node_id, "restored");
+    slot->valid = true;
+    slot->online = true;
+    slot->status.battery_level = 77;
+    g_index_table.status_count++;
+    
+    sds_mock_simulate_disconnect();
+    sds_loop();
+    sds_mock_simulate_reconnect();
+    sds_mock_advance_time(2000);
+    sds_loop();
+    ASSERT(sds_get_stats()->reconnect_count >= 1);
+    
+    const TestStatus* st = (const TestStatus*)sds_find_node_status(&g_index_table, "IndexTable", "restored");
+    ASSERT(st != NULL);
+    ASSERT_EQ(st->battery_level, 77);
+    ASSERT(sds_find_node_status(&g_index_table, "IndexTable", "alpha") != NULL);
+}
+
+/* ============================================================================
+ * WIDE SLOT MODE TESTS
+ * ============================================================================ */
+
+#define WIDE_TEST_MAX_NODES 5000
+#define WIDE_TEST_INDEX_SIZE 8192
+
+/* Owner table with externally allocated slots and a 16-bit count */
+typedef struct {
+    TestConfig config;
+    TestState state;
+    TestStatusSlot* status_slots;
+    uint16_t status_count;
+} WideOwnerTable;
+
+static uint32_t g_wide_index[WIDE_TEST_INDEX_SIZE];
+
+static SdsError register_wide_owner_table(WideOwnerTable* table, uint32_t max_slots, bool with_index) {
+    SdsError err = sds_register_table_ex(
+        table, "WideTable", SDS_ROLE_OWNER, NULL,
+        offsetof(WideOwnerTable, config), sizeof(TestConfig),
+        offsetof(WideOwnerTable, state), sizeof(TestState),
+        0, 0,
+        serialize_test_config, NULL,
+        NULL, deserialize_test_state,
+        NULL, deserialize_test_status
+    );
+    if (err != SDS_OK) return err;
+    
+    sds_set_owner_slot_offsets(
+        "WideTable",
+        offsetof(TestStatusSlot, valid),
+        offsetof(TestStatusSlot, online),
+        offsetof(TestStatusSlot, last_seen_ms)
+    );
+    sds_set_owner_eviction_offsets(
+        "WideTable",
+        offsetof(TestStatusSlot, eviction_pending),
+        offsetof(TestStatusSlot, eviction_deadline)
+    );
+    err = sds_set_owner_status_slots_wide(
+        "WideTable", SDS_SLOTS_EXTERNAL,
+        offsetof(WideOwnerTable, status_slots),
+        sizeof(TestStatusSlot),
+        offsetof(TestStatusSlot, status),
+        offsetof(WideOwnerTable, status_count), sizeof(uint16_t),
+        max_slots
+    );
+    if (err != SDS_OK) return err;
+    
+    if (with_index) {
+        err = sds_set_owner_slot_index("WideTable", g_wide_index, WIDE_TEST_INDEX_SIZE);
+    }
+    return err;
+}
+
+static void inject_wide_status(const char* node, int battery) {
+    char topic[64];
+    char payload[96];
+    snprintf(topic, sizeof(topic), "sds/WideTable/status/%s", node);
+    snprintf(payload, sizeof(payload), "{\"online\":true,\"error_code\":0,\"battery_level\":%d}", battery);
+    sds_mock_inject_message_str(topic, payload);
+}
+
+TEST(wide_slots_external_thousands_of_devices) {
+    sds_set_log_level(SDS_LOG_WARN);
+    init_sds_with_mock_eviction("owner_node", TEST_EVICTION_GRACE_MS);
+    
+    WideOwnerTable table = {0};
+    table.status_slots = calloc(WIDE_TEST_MAX_NODES, sizeof(TestStatusSlot));
+    ASSERT(table.status_slots != NULL);
+    SdsError err = register_wide_owner_table(&table, WIDE_TEST_MAX_NODES, true);
+    
+    char node[16];
+    for (int i = 0; i < WIDE_TEST_MAX_NODES; i++) {
+        snprintf(node, sizeof(node), "sensor%d", i);
+        inject_wide_status(node, i % 100);
+    }
+    int count_after_fill = table.status_count;
+    
+    /* Slots are full: one more device is dropped */
+    inject_wide_status("sensor_extra", 1);
+    int count_after_extra = table.status_count;
+    
+    const TestStatus* st = (const TestStatus*)sds_find_node_status(&table, "WideTable", "sensor4321");
+    int battery = st ? st->battery_level : -1;
+    bool extra_missing = sds_find_node_status(&table, "WideTable", "sensor_extra") == NULL;
+    
+    /* Evict 1000 devices */
+    char topic[64];
+    for (int i = 0; i < 1000; i++) {
+        snprintf(topic, sizeof(topic), "sds/lwt/sensor%d", i * 5);
+        sds_mock_inject_message_str(topic, "{\"online\":false,\"ts\":0}");
+    }
+    sds_mock_advance_time(TEST_EVICTION_GRACE_MS + 10);
+    sds_loop();
+    int count_after_evict = table.status_count;
+    bool evicted_gone = sds_find_node_status(&table, "WideTable", "sensor10") == NULL;
+    bool survivor_found = sds_find_node_status(&table, "WideTable", "sensor11") != NULL;
+    
+    sds_shutdown();
+    free(table.status_slots);
+    sds_set_log_level(SDS_LOG_INFO);
+    
+    ASSERT_EQ(err, SDS_OK);
+    ASSERT_EQ(count_after_fill, WIDE_TEST_MAX_NODES);
+    ASSERT_EQ(count_after_extra, WIDE_TEST_MAX_NODES);
+    ASSERT_EQ(battery, 21);
+    ASSERT(extra_missing);
+    ASSERT_EQ(count_after_evict, WIDE_TEST_MAX_NODES - 1000);
+    ASSERT(evicted_gone);
+    ASSERT(survivor_found);
+}
+
+TEST(wide_slots_linear_fallback_without_index) {
+    init_sds_with_mock("owner_node");
+    
+    WideOwnerTable table = {0};
+    table.status_slots = calloc(400, sizeof(TestStatusSlot));
+    ASSERT(table.status_slots != NULL);
+    SdsError err = register_wide_owner_table(&table, 400, false);
+    
+    char node[16];
+    for (int i = 0; i < 300; i++) {
+        snprintf(node, sizeof(node), "dev%d", i);
+        inject_wide_status(node, 3);
+    }
+    inject_wide_status("dev299", 4);
+    
+    int count = table.status_count;
+    const TestStatus* st = (const TestStatus*)sds_find_node_status(&table, "WideTable", "dev299");
+    int battery = st ? st->battery_level : -1;
+    bool online = sds_is_device_online(&table, "WideTable", "dev150", 1000);
+    
+    sds_shutdown();
+    free(table.status_slots);
+    
+    ASSERT_EQ(err, SDS_OK);
+    ASSERT_EQ(count, 300);
+    ASSERT_EQ(battery, 4);
+    ASSERT(online);
+}
+
+TEST(wide_slots_reject_invalid_config) {
+    init_sds_with_mock("owner_node");
+    
+    WideOwnerTable table = {0};
+    TestStatusSlot slots[4];
+    memset(slots, 0, sizeof(slots));
+    table.status_slots = slots;
+    ASSERT_EQ(register_wide_owner_table(&table, 4, false), SDS_OK);
+    
+    /* Count width must be 1, 2 or 4 bytes */
+    ASSERT_EQ(sds_set_owner_status_slots_wide(
+        "WideTable", SDS_SLOTS_EXTERNAL, offsetof(WideOwnerTable, status_slots),
+        sizeof(TestStatusSlot), offsetof(TestStatusSlot, status),
+        offsetof(WideOwnerTable, status_count), 3, 4), SDS_ERR_INVALID_CONFIG);
+    
+    /* 300 slots do not fit a uint8_t count */
+    ASSERT_EQ(sds_set_owner_status_slots_wide(
+        "WideTable", SDS_SLOTS_EXTERNAL, offsetof(WideOwnerTable, status_slots),
+        sizeof(TestStatusSlot), offsetof(TestStatusSlot, status),
+        offsetof(WideOwnerTable, status_count), 1, 300), SDS_ERR_INVALID_CONFIG);
+    
+    /* Index buckets must be a power of two */
+    ASSERT_EQ(sds_set_owner_slot_index("WideTable", g_wide_index, 1000), SDS_ERR_INVALID_CONFIG);
+    ASSERT_EQ(sds_set_owner_slot_index("Missing", g_wide_index, 1024), SDS_ERR_TABLE_NOT_FOUND);
+    
+    /* Still usable after rejected reconfiguration */
+    inject_wide_status("dev1", 9);
+    ASSERT_EQ(table.status_count, 1);
+    ASSERT_STR_EQ(slots[0].node_id, "dev1");
+}
+
+/* ============================================================================
+ * MESSAGE ROUTING TESTS
+ * ============================================================================ */
+
+TEST(routing_distinguishes_prefix_table_names) {
+    init_sds_with_mock("owner_node");
+    
+    TestOwnerTable short_table = {0};
+    TestOwnerTable long_table = {0};
+    ASSERT_EQ(register_owner_table(&short_table, "Sensor"), SDS_OK);
+    ASSERT_EQ(register_owner_table(&long_table, "SensorX"), SDS_OK);
+    
+    sds_mock_inject_message_str("sds/SensorX/state",
+        "{\"ts\":1,\"node\":\"dev1\",\"reading_count\":7}");
+    ASSERT_EQ(long_table.state.reading_count, 7);
+    ASSERT_EQ(short_table.state.reading_count, 0);
+    
+    sds_mock_inject_message_str("sds/Sensor/state",
+        "{\"ts\":1,\"node\":\"dev1\",\"reading_count\":3}");
+    ASSERT_EQ(short_table.state.reading_count, 3);
+    ASSERT_EQ(long_table.state.reading_count, 7);
+}
+
+TEST(routing_ignores_unknown_sections) {
+    init_sds_with_mock("owner_node");
+    
+    TestOwnerTable table = {0};
+    register_owner_table(&table, "TestTable");
+    
+    sds_mock_inject_message_str("sds/TestTable/statex",
+        "{\"node\":\"dev1\",\"reading_count\":7}");
+    sds_mock_inject_message_str("sds/TestTable/status/",
+        "{\"error_code\":1}");
+    sds_mock_inject_message_str("sds/TestTable",
+        "{\"node\":\"dev1\",\"reading_count\":7}");
+    
+    ASSERT_EQ(table.state.reading_count, 0);
+    ASSERT_EQ(table.status_count, 0);
+}
+
+TEST(routing_follows_unregister_and_reregister) {
+    init_sds_with_mock("device_node");
+    
+    TestDeviceTable first = {0};
+    TestDeviceTable second = {0};
+    ASSERT_EQ(register_device_table(&first, "TestTable"), SDS_OK);
+    ASSERT_EQ(sds_unregister_table("TestTable"), SDS_OK);
+    
+    sds_mock_inject_message_str("sds/TestTable/config", "{\"mode\":4}");
+    ASSERT_EQ(first.config.mode, 0);
+    
+    ASSERT_EQ(register_device_table(&second, "TestTable"), SDS_OK);
+    sds_mock_inject_message_str("sds/TestTable/config", "{\"mode\":5}");
+    ASSERT_EQ(first.config.mode, 0);
+    ASSERT_EQ(second.config.mode, 5);
+}
+
+static uint8_t g_seen_index_state = SDS_JSON_INDEX_NONE;
+
+static void deserialize_recording_state(void* section, SdsJsonReader* r) {
+    g_seen_index_state = r->index_state;
+    deserialize_test_state(section, r);
+}
+
+TEST(routing_passes_pre_tokenized_reader) {
+    init_sds_with_mock("owner_node");
+    g_seen_index_state = SDS_JSON_INDEX_NONE;
+    
+    TestOwnerTable table = {0};
+    ASSERT_EQ(sds_register_table_ex(
+        &table, "TestTable", SDS_ROLE_OWNER, NULL,
+        offsetof(TestOwnerTable, config), sizeof(TestConfig),
+        offsetof(TestOwnerTable, state), sizeof(TestState),
+        0, 0,
+        serialize_test_config, NULL,
+        NULL, deserialize_recording_state,
+        NULL, NULL), SDS_OK);
+    
+    sds_mock_inject_message_str("sds/TestTable/state",
+        "{\"ts\":1,\"node\":\"dev1\",\"reading_count\":9}");
+    
+    ASSERT_EQ(g_seen_index_state, SDS_JSON_INDEX_COMPLETE);
+    ASSERT_EQ(table.state.reading_count, 9);
+}
+
+/* ============================================================================
+ * DEADLINE SCHEDULER TESTS
+ * ============================================================================ */
+
+TEST(next_deadline_tracks_sync_interval) {
+    ASSERT_EQ(sds_next_deadline_ms(), UINT32_MAX);  /* Not initialized */
+    
+    init_sds_with_mock("device_node");
+    ASSERT_EQ(sds_next_deadline_ms(), UINT32_MAX);  /* Nothing scheduled */
+    
+    TestDeviceTable table = {0};
+    register_device_table(&table, "TestTable");
+    ASSERT_EQ(sds_next_deadline_ms(), SDS_DEFAULT_SYNC_INTERVAL_MS);
+    
+    sds_mock_advance_time(400);
+    ASSERT_EQ(sds_next_deadline_ms(), SDS_DEFAULT_SYNC_INTERVAL_MS - 400);
+    
+    /* Not due yet: no publish */
+    table.state.temperature = 21.5f;
+    sds_mock_clear_publishes();
+    sds_loop();
+    ASSERT(sds_mock_find_publish_by_topic("sds/TestTable/state") == NULL);
+    
+    sds_mock_advance_time(SDS_DEFAULT_SYNC_INTERVAL_MS - 400);
+    ASSERT_EQ(sds_next_deadline_ms(), 0);
+    sds_loop();
+    ASSERT(sds_mock_find_publish_by_topic("sds/TestTable/state") != NULL);
+    
+    /* Re-armed for the next interval */
+    ASSERT_EQ(sds_next_deadline_ms(), SDS_DEFAULT_SYNC_INTERVAL_MS);
+    
+    sds_unregister_table("TestTable");
+    ASSERT_EQ(sds_next_deadline_ms(), UINT32_MAX);
+}
+
+TEST(next_deadline_picks_earliest_table) {
+    init_sds_with_mock("device_node");
+    
+    TestDeviceTable slow = {0};
+    TestDeviceTable fast = {0};
+    register_device_table(&slow, "SlowTable");
+    
+    SdsTableOptions opts = { .sync_interval_ms = 250 };
+    sds_register_table_ex(
+        &fast, "FastTable", SDS_ROLE_DEVICE, &opts,
+        offsetof(TestDeviceTable, config), sizeof(TestConfig),
+        offsetof(TestDeviceTable, state), sizeof(TestState),
+        offsetof(TestDeviceTable, status), sizeof(TestStatus),
+        NULL, deserialize_test_config,
+        serialize_test_state, NULL,
+        serialize_test_status, NULL
+    );
+    ASSERT_EQ(sds_next_deadline_ms(), 250);
+    
+    /* Fast table syncs four times before the slow one is due */
+    for (int i = 0; i < 3; i++) {
+        sds_mock_advance_time(250);
+        sds_loop();
+        ASSERT_EQ(sds_next_deadline_ms(), 250);
+    }
+    sds_mock_advance_time(250);
+    sds_loop();
+    ASSERT_EQ(sds_next_deadline_ms(), 250);
+    
+    sds_unregister_table("FastTable");
+    sds_mock_advance_time(100);
+    ASSERT_EQ(sds_next_deadline_ms(), SDS_DEFAULT_SYNC_INTERVAL_MS - 100);
+}
+
+TEST(next_deadline_includes_eviction_grace) {
+    init_sds_with_mock_eviction("owner_node", TEST_EVICTION_GRACE_MS);
+    
+    TestOwnerTable table = {0};
+    register_owner_table_with_eviction_offsets(&table, "TestTable");
+    
+    sds_mock_inject_message_str(
+        "sds/TestTable/status/device1",
+        "{\"online\":true,\"error_code\":0,\"battery_level\":90}"
+    );
+    sds_mock_inject_message_str(
+        "sds/lwt/device1",
+        "{\"online\":false,\"node\":\"device1\",\"ts\":0}"
+    );
+    
+    /* The LWT leaves the timer to sds_loop(), which arms it for the grace period */
+    ASSERT_EQ(sds_next_deadline_ms(), 0);
+    sds_loop();
+    
+    /* Grace period is shorter than the sync interval */
+    ASSERT_EQ(sds_next_deadline_ms(), TEST_EVICTION_GRACE_MS);
+    
+    sds_mock_advance_time(TEST_EVICTION_GRACE_MS - 1);
+    sds_loop();
+    ASSERT(table.status_slots[0].valid);
+    
+    sds_mock_advance_time(1);
+    sds_loop();
+    ASSERT(!table.status_slots[0].valid);
+    ASSERT_EQ(table.status_count, 0);
+    
+    /* Only the sync timer remains */
+    ASSERT_EQ(sds_next_deadline_ms(), SDS_DEFAULT_SYNC_INTERVAL_MS - TEST_EVICTION_GRACE_MS);
+}
+
+TEST(eviction_timer_rearms_for_later_devices) {
+    init_sds_with_mock_eviction("owner_node", TEST_EVICTION_GRACE_MS);
+    
+    TestOwnerTable table = {0};
+    register_owner_table_with_eviction_offsets(&table, "TestTable");
+    
+    sds_mock_inject_message_str("sds/TestTable/status/dev1", "{\"online\":true}");
+    sds_mock_inject_message_str("sds/TestTable/status/dev2", "{\"online\":true}");
+    
+    sds_mock_inject_message_str("sds/lwt/dev1", "{\"online\":false,\"node\":\"dev1\",\"ts\":0}");
+    sds_mock_advance_time(40);
+    sds_mock_inject_message_str("sds/lwt/dev2", "{\"online\":false,\"node\":\"dev2\",\"ts\":0}");
+    sds_loop();
+    ASSERT_EQ(sds_next_deadline_ms(), TEST_EVICTION_GRACE_MS - 40);
+    
+    /* First device evicted; timer re-armed for the second */
+    sds_mock_advance_time(TEST_EVICTION_GRACE_MS - 40);
+    sds_loop();
+    ASSERT_EQ(table.status_count, 1);
+    ASSERT_EQ(sds_next_deadline_ms(), 40);
+    
+    sds_mock_advance_time(40);
+    sds_loop();
+    ASSERT_EQ(table.status_count, 0);
+}
+
+/* ============================================================================
+ * TABLE ARENA TESTS
+ * ============================================================================ */
+
+#define TEST_SECTION_BYTES (sizeof(TestConfig) + sizeof(TestState) + sizeof(TestStatus))
+
+static SdsError init_sds_with_arena(void* arena, size_t size, uint8_t max_tables) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+    
+    SdsConfig config = {
+        .node_id = "arena_node",
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .table_arena = arena,
+        .table_arena_size = size,
+        .max_tables = max_tables,
+    };
+    
+    return sds_init(&config);
+}
+
+static uint8_t g_arena[40960];
+
+TEST(arena_allows_more_than_default_tables) {
+    uint8_t count = SDS_MAX_TABLES + 4;
+    size_t size = sds_table_arena_size(count, count * TEST_SECTION_BYTES);
+    ASSERT(size <= sizeof(g_arena));
+    ASSERT_EQ(init_sds_with_arena(g_arena, size, count), SDS_OK);
+    
+    static TestDeviceTable tables[SDS_MAX_TABLES + 5];
+    char name[32];
+    for (uint8_t i = 0; i < count; i++) {
+        snprintf(name, sizeof(name), "Arena%u", i);
+        ASSERT_EQ(register_device_table(&tables[i], name), SDS_OK);
+    }
+    ASSERT_EQ(sds_get_table_count(), count);
+    ASSERT_EQ(register_device_table(&tables[count], "OneTooMany"), SDS_ERR_MAX_TABLES_REACHED);
+    
+    /* The last table syncs like any other */
+    tables[count - 1].state.temperature = 7.0f;
+    sds_mock_advance_time(1100);
+    sds_loop();
+    snprintf(name, sizeof(name), "sds/Arena%u/state", count - 1);
+    ASSERT(sds_mock_find_publish_by_topic(name) != NULL);
+}
+
+TEST(arena_shadows_sized_per_table) {
+    /* Room for two tables' sections, not two full-size shadows */
+    size_t size = sds_table_arena_size(2, 2 * TEST_SECTION_BYTES);
+    ASSERT(size < sds_table_arena_size(2, 0));
+    ASSERT_EQ(init_sds_with_arena(g_arena, size, 2), SDS_OK);
+    
+    TestDeviceTable a = {0}, b = {0};
+    ASSERT_EQ(register_device_table(&a, "ArenaA"), SDS_OK);
+    ASSERT_EQ(register_device_table(&b, "ArenaB"), SDS_OK);
+}
+
+typedef struct {
+    TestConfig config;
+    uint8_t state[512];
+} ArenaBigTable;
+
+static SdsError register_big_table(ArenaBigTable* table, const char* type) {
+    return sds_register_table_ex(
+        table, type, SDS_ROLE_DEVICE, NULL,
+        offsetof(ArenaBigTable, config), sizeof(TestConfig),
+        offsetof(ArenaBigTable, state), sizeof(table->state),
+        0, 0,
+        NULL, deserialize_test_config,
+        NULL, NULL,
+        NULL, NULL
+    );
+}
+
+TEST(arena_without_index_room_uses_linear_lookup) {
+    /* Sections only: no room for the owner's built-in slot index */
+    size_t size = sds_table_arena_size(1, sizeof(TestConfig) + sizeof(TestState));
+    ASSERT_EQ(init_sds_with_arena(g_arena, size, 1), SDS_OK);
+    
+    memset(&g_index_table, 0, sizeof(g_index_table));
+    ASSERT_EQ(register_index_owner_table(&g_index_table, "IndexTable"), SDS_OK);
+    
+    char node[16];
+    for (int i = 0; i < 20; i++) {
+        snprintf(node, sizeof(node), "dev%d", i);
+        inject_index_status(node, i);
+    }
+    ASSERT_EQ(g_index_table.status_count, 20);
+    const TestStatus* st = (const TestStatus*)sds_find_node_status(&g_index_table, "IndexTable", "dev13");
+    ASSERT(st != NULL);
+    ASSERT_EQ(st->battery_level, 13);
+    
+    /* The worst-case size leaves room for every table's index */
+    ASSERT(sds_table_arena_size(1, 0) >= size + SDS_SLOT_INDEX_SIZE * sizeof(uint32_t));
+}
+
+TEST(arena_exhausted_fails_registration) {
+    size_t size = sds_table_arena_size(2, sizeof(TestConfig) + 512);
+    ASSERT_EQ(init_sds_with_arena(g_arena, size, 2), SDS_OK);
+    
+    ArenaBigTable a = {0}, b = {0};
+    ASSERT_EQ(register_big_table(&a, "ArenaA"), SDS_OK);
+    ASSERT_EQ(register_big_table(&b, "ArenaB"), SDS_ERR_SECTION_TOO_LARGE);
+    ASSERT_EQ(sds_get_table_count(), 1);
+    
+    /* An unregistered slot's shadows are reused */
+    ASSERT_EQ(sds_unregister_table("ArenaA"), SDS_OK);
+    ASSERT_EQ(register_big_table(&b, "ArenaB"), SDS_OK);
+}
+
+TEST(failed_registration_leaves_no_sync_timer) {
+    size_t size = sds_table_arena_size(1, sizeof(TestConfig));
+    ASSERT_EQ(init_sds_with_arena(g_arena, size, 1), SDS_OK);
+    ASSERT_EQ(sds_next_deadline_ms(), UINT32_MAX);
+
+    ArenaBigTable a = {0};
+    ASSERT_EQ(register_big_table(&a, "ArenaA"), SDS_ERR_SECTION_TOO_LARGE);
+    ASSERT_EQ(sds_next_deadline_ms(), UINT32_MAX);
+}
+
+TEST(arena_too_small_fails_init) {
+    ASSERT_EQ(init_sds_with_arena(g_arena, 16, 2), SDS_ERR_INVALID_CONFIG);
+    
+    /* A usable arena still works afterwards */
+    ASSERT_EQ(init_sds_with_arena(g_arena, sizeof(g_arena), 2), SDS_OK);
+}
+
 /* ============================================================================
  * LARGE SECTION TESTS (1KB Support)
  * ============================================================================ */
@@ -1303,6 +2038,11 @@ typedef struct {
     TestStatus status;
 } LargeDeviceTable;
 
+typedef struct {
+    TestConfig config;
+    LargeState state;
+} LargeOwnerTable;
+
 static void serialize_large_state(void* section, SdsJsonWriter* w) {
     LargeState* st = (LargeState*)section;
     
@@ -1384,6 +2124,35 @@ TEST(large_section_1kb_serialization) {
     ASSERT_STR_CONTAINS((char*)msg->payload, "average");
 }
 
+TEST(large_section_1kb_deserialization) {
+    init_sds_with_mock("owner_node");
+    
+    static LargeOwnerTable table;
+    memset(&table, 0, sizeof(table));
+    
+    SdsError err = sds_register_table_ex(
+        &table, "LargeTable", SDS_ROLE_OWNER, NULL,
+        offsetof(LargeOwnerTable, config), sizeof(TestConfig),
+        offsetof(LargeOwnerTable, state), sizeof(LargeState),
+        0, 0,
+        serialize_test_config, NULL,
+        NULL, deserialize_large_state,
+        NULL, NULL
+    );
+    ASSERT_EQ(err, SDS_OK);
+    
+    sds_mock_inject_message_str("sds/LargeTable/state",
+        "{\"ts\":1,\"node\":\"device_01\",\"value_0\":1.5,\"value_61\":99.5,"
+        "\"ts_61\":2000,\"description\":\"large section\",\"location\":\"Room 101\","
+        "\"sequence\":42,\"average\":50.5}");
+    
+    ASSERT(table.state.values[61] == 99.5f);
+    ASSERT_EQ(table.state.timestamps[61], 2000);
+    ASSERT(strcmp(table.state.description, "large section") == 0);
+    ASSERT(strcmp(table.state.location, "Room 101") == 0);
+    ASSERT_EQ(table.state.sequence, 42);
+}
+
 TEST(large_section_no_buffer_overflow) {
     init_sds_with_mock("device_node");
     
@@ -1837,8 +2606,41 @@ int main(void) {
     RUN_TEST(eviction_callback_invoked);
     RUN_TEST(eviction_disabled_when_grace_zero);
     
+    printf("\n─── Status Slot Index Tests ───\n");
+    RUN_TEST(slot_index_many_devices_lookup);
+    RUN_TEST(slot_index_consistent_after_eviction);
+    RUN_TEST(slot_index_reuses_lowest_free_slot);
+    RUN_TEST(slot_index_lwt_marks_offline);
+    RUN_TEST(slot_index_rebuilt_on_reconnect);
+    
+    printf("\n─── Wide Slot Mode Tests ───\n");
+    RUN_TEST(wide_slots_external_thousands_of_devices);
+    RUN_TEST(wide_slots_linear_fallback_without_index);
+    RUN_TEST(wide_slots_reject_invalid_config);
+    
+    printf("\n─── Message Routing Tests ───\n");
+    RUN_TEST(routing_distinguishes_prefix_table_names);
+    RUN_TEST(routing_ignores_unknown_sections);
+    RUN_TEST(routing_follows_unregister_and_reregister);
+    RUN_TEST(routing_passes_pre_tokenized_reader);
+    
+    printf("\n─── Deadline Scheduler Tests ───\n");
+    RUN_TEST(next_deadline_tracks_sync_interval);
+    RUN_TEST(next_deadline_picks_earliest_table);
+    RUN_TEST(next_deadline_includes_eviction_grace);
+    RUN_TEST(eviction_timer_rearms_for_later_devices);
+    
+    printf("\n─── Table Arena Tests ───\n");
+    RUN_TEST(arena_allows_more_than_default_tables);
+    RUN_TEST(arena_shadows_sized_per_table);
+    RUN_TEST(arena_without_index_room_uses_linear_lookup);
+    RUN_TEST(arena_exhausted_fails_registration);
+    RUN_TEST(failed_registration_leaves_no_sync_timer);
+    RUN_TEST(arena_too_small_fails_init);
+    
     printf("\n─── Large Section Tests (1KB Support) ───\n");
     RUN_TEST(large_section_1kb_serialization);
+    RUN_TEST(large_section_1kb_deserialization);
     RUN_TEST(large_section_no_buffer_overflow);
     
     printf("\n─── Delta Sync Tests ───\n");
@@ -0,0 +1,508 @@
+/*
+ * test_wire_format.c - Binary Wire Format Tests
+ *
+ * Tests the compact binary encoding with the mock platform:
+ * - Config/state/status round trips between device and owner
+ * - Delta bitmap carries only changed fields
+ * - JSON fallback when field metadata is missing
+ * - Mixed fleets (JSON and binary senders on one table)
+ * - Malformed binary payloads are dropped without touching the table
+ *
+ * Build:
+ *   gcc -I../include -o test_wire_format test_wire_format.c \
+ *       mock/sds_platform_mock.c ../src/sds_core.c ../src/sds_json.c -lm
+ *
+ * Run:
+ *   ./test_wire_format
+ */
+
+#include "sds.h"
+#include "sds_json.h"
+#include "mock/sds_platform_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+/* ============== Test Framework ============== */
+
+static int g_tests_passed = 0;
+static int g_tests_failed = 0;
+static const char* g_current_test = NULL;
+
+#define TEST(name) static void test_##name(void)
+
+#define RUN_TEST(name) do { \
+    g_current_test = #name; \
+    printf("  %-55s", #name); \
+    fflush(stdout); \
+    sds_mock_reset(); \
+    sds_shutdown(); \
+    test_##name(); \
+    sds_shutdown(); \
+    printf(" ✓\n"); \
+    g_tests_passed++; \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf(" ✗ FAILED\n"); \
+        printf("    Assertion failed: %s\n", #cond); \
+        printf("    At line %d in %s\n", __LINE__, g_current_test); \
+        g_tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_STR_EQ(a, b) ASSERT(strcmp((a), (b)) == 0)
+
+/* ============== Table Definitions ============== */
+
+typedef struct {
+    uint8_t mode;
+    char label[16];
+    int16_t offset;
+} WireConfig;
+
+typedef struct {
+    float temperature;
+    uint32_t reading_count;
+    bool active;
+} WireState;
+
+typedef struct {
+    uint8_t error_code;
+    uint16_t battery_mv;
+} WireStatus;
+
+typedef struct {
+    WireConfig config;
+    WireState state;
+    WireStatus status;
+} WireDeviceTable;
+
+typedef struct {
+    char node_id[SDS_MAX_NODE_ID_LEN];
+    bool valid;
+    bool online;
+    bool eviction_pending;
+    uint32_t last_seen_ms;
+    uint32_t eviction_deadline;
+    WireStatus status;
+} WireStatusSlot;
+
+#define WIRE_MAX_NODES 4
+
+typedef struct {
+    WireConfig config;
+    WireState state;
+    WireStatusSlot status_slots[WIRE_MAX_NODES];
+    uint8_t status_count;
+} WireOwnerTable;
+
+/* Field metadata (simulating what codegen would generate) */
+static const SdsFieldMeta wire_config_fields[] = {
+    { .name = "mode", .type = SDS_FIELD_UINT8, .offset = offsetof(WireConfig, mode), .size = sizeof(uint8_t) },
+    { .name = "label", .type = SDS_FIELD_STRING, .offset = offsetof(WireConfig, label), .size = 16 },
+    { .name = "offset", .type = SDS_FIELD_INT16, .offset = offsetof(WireConfig, offset), .size = sizeof(int16_t) },
+};
+
+static const SdsFieldMeta wire_state_fields[] = {
+    { .name = "temperature", .type = SDS_FIELD_FLOAT, .offset = offsetof(WireState, temperature), .size = sizeof(float) },
+    { .name = "reading_count", .type = SDS_FIELD_UINT32, .offset = offsetof(WireState, reading_count), .size = sizeof(uint32_t) },
+    { .name = "active", .type = SDS_FIELD_BOOL, .offset = offsetof(WireState, active), .size = sizeof(bool) },
+};
+
+static const SdsFieldMeta wire_status_fields[] = {
+    { .name = "error_code", .type = SDS_FIELD_UINT8, .offset = offsetof(WireStatus, error_code), .size = sizeof(uint8_t) },
+    { .name = "battery_mv", .type = SDS_FIELD_UINT16, .offset = offsetof(WireStatus, battery_mv), .size = sizeof(uint16_t) },
+};
+
+/* ============== Serialization Functions ============== */
+
+static void serialize_config(void* section, SdsJsonWriter* w) {
+    WireConfig* cfg = (WireConfig*)section;
+    sds_json_add_uint(w, "mode", cfg->mode);
+    sds_json_add_string(w, "label", cfg->label);
+    sds_json_add_int(w, "offset", cfg->offset);
+}
+
+static void deserialize_config(void* section, SdsJsonReader* r) {
+    WireConfig* cfg = (WireConfig*)section;
+    sds_json_get_uint8_field(r, "mode", &cfg->mode);
+    sds_json_get_string_field(r, "label", cfg->label, sizeof(cfg->label));
+    int32_t offset;
+    if (sds_json_get_int_field(r, "offset", &offset)) cfg->offset = (int16_t)offset;
+}
+
+static void serialize_state(void* section, SdsJsonWriter* w) {
+    WireState* st = (WireState*)section;
+    sds_json_add_float(w, "temperature", st->temperature);
+    sds_json_add_uint(w, "reading_count", st->reading_count);
+    sds_json_add_bool(w, "active", st->active);
+}
+
+static void deserialize_state(void* section, SdsJsonReader* r) {
+    WireState* st = (WireState*)section;
+    sds_json_get_float_field(r, "temperature", &st->temperature);
+    sds_json_get_uint_field(r, "reading_count", &st->reading_count);
+    sds_json_get_bool_field(r, "active", &st->active);
+}
+
+static void serialize_status(void* section, SdsJsonWriter* w) {
+    WireStatus* st = (WireStatus*)section;
+    sds_json_add_uint(w, "error_code", st->error_code);
+    sds_json_add_uint(w, "battery_mv", st->battery_mv);
+}
+
+static void deserialize_status(void* section, SdsJsonReader* r) {
+    WireStatus* st = (WireStatus*)section;
+    sds_json_get_uint8_field(r, "error_code", &st->error_code);
+    uint32_t battery_mv;
+    if (sds_json_get_uint_field(r, "battery_mv", &battery_mv)) st->battery_mv = (uint16_t)battery_mv;
+}
+
+/* ============== Helper Functions ============== */
+
+/* A published message copied out before the mock is reset */
+typedef struct {
+    uint8_t payload[SDS_MOCK_MAX_PAYLOAD_LEN];
+    size_t len;
+} CapturedPayload;
+
+static SdsError init_node(const char* node_id, bool enable_delta) {
+    SdsMockConfig mock_cfg = {
+        .init_returns_success = true,
+        .mqtt_connect_returns_success = true,
+        .mqtt_connected = true,
+        .mqtt_publish_returns_success = true,
+        .mqtt_subscribe_returns_success = true,
+    };
+    sds_mock_configure(&mock_cfg);
+
+    SdsConfig config = {
+        .node_id = node_id,
+        .mqtt_broker = "mock_broker",
+        .mqtt_port = 1883,
+        .enable_delta_sync = enable_delta,
+    };
+
+    return sds_init(&config);
+}
+
+static SdsError register_device(WireDeviceTable* table, SdsWireFormat format, bool with_fields) {
+    SdsTableOptions opts = { .sync_interval_ms = 1000, .wire_format = format };
+    SdsError err = sds_register_table_ex(
+        table, "WireTable", SDS_ROLE_DEVICE, &opts,
+        offsetof(WireDeviceTable, config), sizeof(WireConfig),
+        offsetof(WireDeviceTable, state), sizeof(WireState),
+        offsetof(WireDeviceTable, status), sizeof(WireStatus),
+        NULL, deserialize_config,
+        serialize_state, NULL,
+        serialize_status, NULL
+    );
+    if (err == SDS_OK && with_fields) {
+        err = sds_set_table_fields("WireTable",
+            wire_config_fields, 3, wire_state_fields, 3, wire_status_fields, 2);
+    }
+    return err;
+}
+
+static SdsError register_owner(WireOwnerTable* table, SdsWireFormat format) {
+    SdsTableOptions opts = { .sync_interval_ms = 1000, .wire_format = format };
+    SdsError err = sds_register_table_ex(
+        table, "WireTable", SDS_ROLE_OWNER, &opts,
+        offsetof(WireOwnerTable, config), sizeof(WireConfig),
+        offsetof(WireOwnerTable, state), sizeof(WireState),
+        0, 0,
+        serialize_config, NULL,
+        NULL, deserialize_state,
+        NULL, deserialize_status
+    );
+    if (err != SDS_OK) return err;
+
+    sds_set_owner_status_slots("WireTable",
+        offsetof(WireOwnerTable, status_slots), sizeof(WireStatusSlot),
+        offsetof(WireStatusSlot, status), offsetof(WireOwnerTable, status_count),
+        WIRE_MAX_NODES);
+    sds_set_owner_slot_offsets("WireTable",
+        offsetof(WireStatusSlot, valid), offsetof(WireStatusSlot, online),
+        offsetof(WireStatusSlot, last_seen_ms));
+
+    return sds_set_table_fields("WireTable",
+        wire_config_fields, 3, wire_state_fields, 3, wire_status_fields, 2);
+}
+
+static bool capture(const char* topic, CapturedPayload* out) {
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic(topic);
+    if (!msg) return false;
+    memcpy(out->payload, msg->payload, msg->payload_len);
+    out->len = msg->payload_len;
+    return true;
+}
+
+/* Publish the device's state and status as "dev1" and capture both payloads */
+static bool publish_from_device(const WireDeviceTable* src, SdsWireFormat format, bool delta,
+                                CapturedPayload* state, CapturedPayload* status) {
+    WireDeviceTable table = {0};
+    init_node("dev1", delta);
+    register_device(&table, format, true);
+    table.state = src->state;
+    table.status = src->status;
+
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    bool ok = capture("sds/WireTable/state", state) &&
+              capture("sds/WireTable/status/dev1", status);
+    sds_shutdown();
+    sds_mock_reset();
+    return ok;
+}
+
+/* ============== Encoding Tests ============== */
+
+TEST(binary_payload_has_magic_and_is_smaller) {
+    WireDeviceTable src = {0};
+    src.state.temperature = 23.25f;
+    src.state.reading_count = 123456;
+    src.state.active = true;
+    src.status.error_code = 3;
+    src.status.battery_mv = 3700;
+
+    CapturedPayload json_state, json_status, bin_state, bin_status;
+    ASSERT(publish_from_device(&src, SDS_WIRE_JSON, false, &json_state, &json_status));
+    ASSERT(publish_from_device(&src, SDS_WIRE_BINARY, false, &bin_state, &bin_status));
+
+    ASSERT_EQ(json_state.payload[0], '{');
+    ASSERT_EQ(bin_state.payload[0], 0xB5);
+    ASSERT_EQ(bin_status.payload[0], 0xB5);
+
+    /* 3 header bytes + ts + "dev1" + float + u32 + bool */
+    ASSERT_EQ(bin_state.len, 3 + 4 + 1 + 4 + 4 + 4 + 1);
+    ASSERT(bin_state.len * 3 < json_state.len);
+    ASSERT(bin_status.len * 3 < json_status.len);
+}
+
+TEST(json_fallback_without_field_metadata) {
+    init_node("dev1", false);
+
+    WireDeviceTable table = {0};
+    register_device(&table, SDS_WIRE_BINARY, false);
+    table.state.temperature = 20.0f;
+
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/WireTable/state");
+    ASSERT(msg != NULL);
+    ASSERT_EQ(msg->payload[0], '{');
+}
+
+TEST(binary_delta_carries_only_changed_fields) {
+    init_node("dev1", true);
+
+    WireDeviceTable table = {0};
+    register_device(&table, SDS_WIRE_BINARY, true);
+    table.state.temperature = 20.0f;
+    table.state.reading_count = 10;
+
+    sds_mock_advance_time(1100);
+    sds_loop();
+    sds_mock_clear_publishes();
+
+    /* Only reading_count changes: header + 1 bitmap byte + u32 */
+    table.state.reading_count = 11;
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    const SdsMockPublishedMessage* msg = sds_mock_find_publish_by_topic("sds/WireTable/state");
+    ASSERT(msg != NULL);
+    ASSERT_EQ(msg->payload_len, 3 + 4 + 1 + 4 + 1 + 4);
+    ASSERT_EQ(msg->payload[2] & 0x01, 0x01);     /* Delta flag */
+    ASSERT_EQ(msg->payload[12], 0x02);           /* Bitmap: field 1 only */
+}
+
+/* ============== Decoding Tests ============== */
+
+TEST(binary_state_and_status_decode_at_owner) {
+    WireDeviceTable src = {0};
+    src.state.temperature = -4.5f;
+    src.state.reading_count = 4000000000u;
+    src.state.active = true;
+    src.status.error_code = 7;
+    src.status.battery_mv = 3300;
+
+    CapturedPayload state, status;
+    ASSERT(publish_from_device(&src, SDS_WIRE_BINARY, false, &state, &status));
+
+    init_node("owner", false);
+    WireOwnerTable owner = {0};
+    ASSERT_EQ(register_owner(&owner, SDS_WIRE_JSON), SDS_OK);
+
+    sds_mock_inject_message("sds/WireTable/state", state.payload, state.len);
+    ASSERT_EQ(owner.state.temperature, -4.5f);
+    ASSERT_EQ(owner.state.reading_count, 4000000000u);
+    ASSERT(owner.state.active);
+
+    sds_mock_inject_message("sds/WireTable/status/dev1", status.payload, status.len);
+    ASSERT_EQ(owner.status_count, 1);
+    ASSERT_STR_EQ(owner.status_slots[0].node_id, "dev1");
+    ASSERT(owner.status_slots[0].online);
+    ASSERT_EQ(owner.status_slots[0].status.error_code, 7);
+    ASSERT_EQ(owner.status_slots[0].status.battery_mv, 3300);
+}
+
+TEST(binary_delta_preserves_other_fields) {
+    init_node("owner", false);
+    WireOwnerTable owner = {0};
+    register_owner(&owner, SDS_WIRE_JSON);
+    owner.state.temperature = 19.0f;
+    owner.state.reading_count = 5;
+
+    /* Delta with only "active" (field 2) set */
+    const uint8_t delta[] = {
+        0xB5, 0x01, 0x01, 0x10, 0x00, 0x00, 0x00,
+        0x04, 'd', 'e', 'v', '2',
+        0x04,
+        0x01
+    };
+    sds_mock_inject_message("sds/WireTable/state", delta, sizeof(delta));
+
+    ASSERT(owner.state.active);
+    ASSERT_EQ(owner.state.temperature, 19.0f);
+    ASSERT_EQ(owner.state.reading_count, 5);
+}
+
+TEST(binary_config_decodes_at_device) {
+    init_node("owner", false);
+    WireOwnerTable owner = {0};
+    register_owner(&owner, SDS_WIRE_BINARY);
+    owner.config.mode = 2;
+    strcpy(owner.config.label, "north-wing");
+    owner.config.offset = -120;
+
+    sds_loop();  /* Register starts the sync timer; nothing due yet */
+    sds_mock_advance_time(1100);
+    sds_loop();
+
+    CapturedPayload config;
+    ASSERT(capture("sds/WireTable/config", &config));
+    ASSERT_EQ(config.payload[0], 0xB5);
+    sds_shutdown();
+    sds_mock_reset();
+
+    init_node("dev1", false);
+    WireDeviceTable table = {0};
+    register_device(&table, SDS_WIRE_JSON, true);
+
+    sds_mock_inject_message("sds/WireTable/config", config.payload, config.len);
+    ASSERT_EQ(table.config.mode, 2);
+    ASSERT_STR_EQ(table.config.label, "north-wing");
+    ASSERT_EQ(table.config.offset, -120);
+}
+
+TEST(mixed_fleet_json_and_binary_senders) {
+    WireDeviceTable src = {0};
+    src.state.reading_count = 1;
+    src.status.error_code = 1;
+    src.status.battery_mv = 3900;
+
+    CapturedPayload state, status;
+    ASSERT(publish_from_device(&src, SDS_WIRE_BINARY, false, &state, &status));
+
+    init_node("owner", false);
+    WireOwnerTable owner = {0};
+    register_owner(&owner, SDS_WIRE_JSON);
+
+    sds_mock_inject_message_str("sds/WireTable/status/legacy",
+        "{\"online\":true,\"error_code\":2,\"battery_mv\":3500}");
+    sds_mock_inject_message("sds/WireTable/status/dev1", status.payload, status.len);
+
+    ASSERT_EQ(owner.status_count, 2);
+    const WireStatus* legacy = sds_find_node_status(&owner, "WireTable", "legacy");
+    const WireStatus* dev1 = sds_find_node_status(&owner, "WireTable", "dev1");
+    ASSERT(legacy != NULL && dev1 != NULL);
+    ASSERT_EQ(legacy->battery_mv, 3500);
+    ASSERT_EQ(dev1->battery_mv, 3900);
+}
+
+TEST(malformed_binary_is_dropped) {
+    init_node("owner", false);
+    WireOwnerTable owner = {0};
+    register_owner(&owner, SDS_WIRE_JSON);
+    owner.state.reading_count = 42;
+
+    const uint8_t full[] = {
+        0xB5, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x04, 'd', 'e', 'v', '3',
+        0x00, 0x00, 0xA0, 0x41,      /* 20.0f */
+        0x07, 0x00, 0x00, 0x00,      /* 7 */
+        0x01,                        /* true */
+        0xEE                         /* trailing byte */
+    };
+
+    /* Trailing garbage */
+    sds_mock_inject_message("sds/WireTable/state", full, sizeof(full));
+    ASSERT_EQ(owner.state.reading_count, 42);
+
+    /* Truncated mid-field */
+    sds_mock_inject_message("sds/WireTable/state", full, 18);
+    ASSERT_EQ(owner.state.reading_count, 42);
+
+    /* Unknown version */
+    uint8_t bad_version[sizeof(full) - 1];
+    memcpy(bad_version, full, sizeof(bad_version));
+    bad_version[1] = 0x02;
+    sds_mock_inject_message("sds/WireTable/state", bad_version, sizeof(bad_version));
+    ASSERT_EQ(owner.state.reading_count, 42);
+
+    /* Delta bitmap naming a field this schema lacks */
+    const uint8_t unknown_field[] = {
+        0xB5, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x04, 'd', 'e', 'v', '3',
+        0x08, 0x00
+    };
+    sds_mock_inject_message("sds/WireTable/state", unknown_field, sizeof(unknown_field));
+    ASSERT_EQ(owner.state.reading_count, 42);
+
+    /* The well-formed prefix still decodes */
+    sds_mock_inject_message("sds/WireTable/state", full, sizeof(full) - 1);
+    ASSERT_EQ(owner.state.reading_count, 7);
+}
+
+/* ============== Main ============== */
+
+int main(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║          Binary Wire Format Tests (Mock Platform)            ║\n");
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    printf("─── Encoding Tests ───\n");
+    RUN_TEST(binary_payload_has_magic_and_is_smaller);
+    RUN_TEST(json_fallback_without_field_metadata);
+    RUN_TEST(binary_delta_carries_only_changed_fields);
+
+    printf("\n─── Decoding Tests ───\n");
+    RUN_TEST(binary_state_and_status_decode_at_owner);
+    RUN_TEST(binary_delta_preserves_other_fields);
+    RUN_TEST(binary_config_decodes_at_device);
+    RUN_TEST(mixed_fleet_json_and_binary_senders);
+    RUN_TEST(malformed_binary_is_dropped);
+
+    printf("\n");
+    printf("══════════════════════════════════════════════════════════════\n");
+    printf("  Results: %d passed, %d failed\n", g_tests_passed, g_tests_failed);
+    printf("══════════════════════════════════════════════════════════════\n");
+
+    if (g_tests_failed > 0) {
+        printf("\n  ✗ TESTS FAILED\n\n");
+        return 1;
+    }
+
+    printf("\n  ✓ ALL TESTS PASSED\n\n");
+    return 0;
+}